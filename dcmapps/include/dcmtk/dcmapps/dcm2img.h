@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1996-2025, OFFIS e.V.
+ *  Copyright (C) 1996-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -561,6 +561,27 @@ static DicomImage *performScaling(
     return di;
 }
 
+static Uint16 getPreviewDecompressionScale(
+  DcmDataset *dataset,
+  int scaleType,
+  OFCmdUnsignedInt scale_size,
+  int rotateDegree)
+{
+    Uint16 scale = 1;
+    Uint16 rows = 0;
+    Uint16 columns = 0;
+    if (dataset->findAndGetUint16(DCM_Rows, rows).good() && dataset->findAndGetUint16(DCM_Columns, columns).good())
+    {
+        /* the image is rotated before it is scaled */
+        const OFBool rotated = (rotateDegree == 90) || (rotateDegree == 270);
+        const unsigned long size = ((scaleType == 3) != rotated) ? columns : rows;
+        /* use the smallest resolution that is not below the requested size */
+        while ((scale < 8) && ((size + 2 * scale - 1) / (2 * scale) >= scale_size))
+            scale = OFstatic_cast(Uint16, scale * 2);
+    }
+    return scale;
+}
+
 static const char *getDefaultExtension(
   DicomImage *di,
   E_FileType fileType)
@@ -700,6 +721,8 @@ int main(int argc, char *argv[])
                         /* 1 = X-factor, 2 = Y-factor, 3=X-size, 4=Y-size */
     OFCmdFloat          opt_scale_factor = 1.0;
     OFCmdUnsignedInt    opt_scale_size = 1;
+    OFCmdUnsignedInt    opt_decompressionScale = 1;       /* default: decompress JPEG at full resolution */
+    OFBool              opt_decompressionPreview = OFFalse;
     int                 opt_windowType = 0;               /* default: no windowing */
                         /* 1=Wi, 2=Wl, 3=Wm, 4=Wh, 5=Ww, 6=Wn, 7=Wr */
     OFCmdUnsignedInt    opt_windowParameter = 0;
@@ -770,6 +793,9 @@ int main(int argc, char *argv[])
     int                 opt_suppressOutput = 0;           /* default: create output */
     E_FileType          opt_fileType = EFT_default;       /* default: auto */
     OFCmdUnsignedInt    opt_fileBits = 0;                 /* default: 0 */
+#ifdef WITH_THREADS
+    OFCmdUnsignedInt    opt_renderThreads = 1;            /* default: no additional threads */
+#endif
     const char *        opt_ifname = NULL;
     const char *        opt_ofname = NULL;
 
@@ -826,7 +852,7 @@ int main(int argc, char *argv[])
       cmd.addOption("--recognize-aspect",   "+a",      "recognize pixel aspect ratio when scaling (def.)");
       cmd.addOption("--ignore-aspect",      "-a",      "ignore pixel aspect ratio when scaling");
       cmd.addOption("--interpolate",        "+i",   1, "[n]umber of algorithm: integer",
-                                                       "use interpolation when scaling (1..4, def: 1)");
+                                                       "use interpolation when scaling (1..6, def: 1)");
       cmd.addOption("--no-interpolation",   "-i",      "no interpolation when scaling");
       cmd.addOption("--no-scaling",         "-S",      "no scaling, ignore pixel aspect ratio (default)");
       cmd.addOption("--scale-x-factor",     "+Sxf", 1, "[f]actor: float",
@@ -837,6 +863,9 @@ int main(int argc, char *argv[])
                                                        "scale x axis to n pixels, auto-compute y axis");
       cmd.addOption("--scale-y-size",       "+Syv", 1, "[n]umber: integer",
                                                        "scale y axis to n pixels, auto-compute x axis");
+      cmd.addOption("--decode-reduced",     "+dr",  1, "[f]actor: integer (2, 4 or 8)",
+                                                       "decompress lossy JPEG images at 1/f of the\nresolution (fast, e.g. for previews)");
+      cmd.addOption("--decode-preview",     "+dp",     "decompress lossy JPEG images at the lowest\nresolution sufficient for scaling to n pixels");
 
      cmd.addSubGroup("color space conversion (JPEG compressed images only):");
       cmd.addOption("--conv-photometric",   "+cp",     "convert if YCbCr photometric interpr. (default)");
@@ -984,6 +1013,12 @@ int main(int argc, char *argv[])
       cmd.addOption("--change-polarity",    "+P",      "change polarity (invert pixel output)");
       cmd.addOption("--clip-region",        "+C",   4, "[l]eft [t]op [w]idth [h]eight: integer",
                                                        "clip image region (l, t, w, h)");
+#ifdef WITH_THREADS
+
+     cmd.addSubGroup("multi-threading:");
+      cmd.addOption("--render-threads",     "+rt",  1, "[n]umber: integer (default: 1)",
+                                                       "process pixel data of large images using\nn threads");
+#endif
 
     cmd.addGroup("output options:");
      cmd.addSubGroup("general:");
@@ -1141,6 +1176,10 @@ int main(int argc, char *argv[])
             app.checkValue(cmd.getValue(opt_height));
             opt_useClip = 1;
         }
+#ifdef WITH_THREADS
+        if (cmd.findOption("--render-threads"))
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_renderThreads, 1, 1024));
+#endif
 
         /* image processing options: rotation */
 
@@ -1175,7 +1214,7 @@ int main(int argc, char *argv[])
 
         cmd.beginOptionBlock();
         if (cmd.findOption("--interpolate"))
-            app.checkValue(cmd.getValueAndCheckMinMax(opt_useInterpolation, 1, 4));
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_useInterpolation, 1, 6));
         if (cmd.findOption("--no-interpolation"))
             opt_useInterpolation = 0;
         cmd.endOptionBlock();
@@ -1205,6 +1244,21 @@ int main(int argc, char *argv[])
         }
         cmd.endOptionBlock();
 
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--decode-reduced"))
+        {
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_decompressionScale, 2, 8));
+            if ((opt_decompressionScale != 2) && (opt_decompressionScale != 4) && (opt_decompressionScale != 8))
+                app.printError("invalid value for option --decode-reduced (2, 4 or 8 expected)");
+        }
+        if (cmd.findOption("--decode-preview"))
+        {
+            app.checkDependence("--decode-preview", "--scale-x-size or --scale-y-size", (opt_scaleType == 3) || (opt_scaleType == 4));
+            app.checkConflict("--decode-preview", "--clip-region", opt_useClip);
+            opt_decompressionPreview = OFTrue;
+        }
+        cmd.endOptionBlock();
+
         /* image processing options: color space conversion */
 
         cmd.beginOptionBlock();
@@ -1455,6 +1509,8 @@ int main(int argc, char *argv[])
             app.checkConflict("--scale-y-factor", "--true-lossless", opt_scaleType == 2);
             app.checkConflict("--scale-x-size", "--true-lossless", opt_scaleType == 3);
             app.checkConflict("--scale-y-size", "--true-lossless", opt_scaleType == 4);
+            app.checkConflict("--decode-reduced", "--true-lossless", opt_decompressionScale > 1);
+            app.checkConflict("--decode-preview", "--true-lossless", opt_decompressionPreview);
             app.checkConflict("--use-window", "--true-lossless", opt_windowType == 1);
             app.checkConflict("--use-voi-lut", "--true-lossless", opt_windowType == 2);
             app.checkConflict("--min-max-window", "--true-lossless", opt_windowType == 3);
@@ -1658,11 +1714,6 @@ int main(int argc, char *argv[])
     // register RLE decompression codec
     DcmRLEDecoderRegistration::registerCodecs();
 
-    // register JPEG decompression codecs
-    DJDecoderRegistration::registerCodecs(opt_decompCSconversion, EUC_default,
-        EPC_default, opt_predictor6WorkaroundEnable, opt_cornellWorkaroundEnable,
-        opt_forceSingleFragmentPerFrame, opt_preserveBitsStored);
-
     // register JPEG-LS decompression codecs
     DJLSDecoderRegistration::registerCodecs();
 
@@ -1705,6 +1756,16 @@ int main(int argc, char *argv[])
     dataset = dfile->getDataset();
     xfer = dataset->getOriginalXfer();
 
+    if (opt_decompressionPreview)
+        opt_decompressionScale = getPreviewDecompressionScale(dataset, opt_scaleType, opt_scale_size, opt_rotateDegree);
+    if (opt_decompressionScale > 1)
+        OFLOG_INFO(dcm2imgLogger, "decompressing lossy JPEG images at reduced resolution (1/" << opt_decompressionScale << ")");
+
+    // register JPEG decompression codecs (after loading the file since the resolution may depend on the image size)
+    DJDecoderRegistration::registerCodecs(opt_decompCSconversion, EUC_default,
+        EPC_default, opt_predictor6WorkaroundEnable, opt_cornellWorkaroundEnable,
+        opt_forceSingleFragmentPerFrame, opt_preserveBitsStored, OFstatic_cast(Uint16, opt_decompressionScale));
+
     Sint32 frameCount;
     if (dataset->findAndGetSint32(DCM_NumberOfFrames, frameCount).bad())
         frameCount = 1;
@@ -1719,6 +1780,9 @@ int main(int argc, char *argv[])
         opt_compatibilityMode |= CIF_UsePartialAccessToPixelData;
     }
 
+#ifdef WITH_THREADS
+    DicomImageClass::setNumberOfThreads(OFstatic_cast(unsigned int, opt_renderThreads));
+#endif
     di = new DicomImage(dfile, xfer, opt_compatibilityMode, opt_frame - 1, opt_frameCount);
     if (di == NULL)
     {
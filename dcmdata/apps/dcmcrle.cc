@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2024, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -61,6 +61,7 @@ int main(int argc, char *argv[])
   // RLE options
   E_TransferSyntax opt_oxfer = EXS_RLELossless;
   OFCmdUnsignedInt opt_fragmentSize = 0; // 0=unlimited
+  OFCmdUnsignedInt opt_threads = 1;
   OFBool           opt_createOffsetTable = OFTrue;
   OFBool           opt_uidcreation = OFFalse;
   OFBool           opt_secondarycapture = OFFalse;
@@ -95,6 +96,11 @@ int main(int argc, char *argv[])
       cmd.addOption("--fragment-per-frame",  "+ff",    "encode each frame as one fragment (default)");
       cmd.addOption("--fragment-size",       "+fs", 1, "[s]ize: integer",
                                                        "limit fragment size to s kbytes (non-standard)");
+#ifdef WITH_THREADS
+    cmd.addSubGroup("multi-frame compression:");
+      cmd.addOption("--threads",             "+th", 1, "[n]umber: integer (default: 1)",
+                                                       "compress frames concurrently using n threads");
+#endif
     cmd.addSubGroup("basic offset table encoding:");
       cmd.addOption("--offset-table-create", "+ot",    "create offset table (default)");
       cmd.addOption("--offset-table-empty",  "-ot",    "leave offset table empty");
@@ -189,6 +195,13 @@ int main(int argc, char *argv[])
       }
       cmd.endOptionBlock();
 
+#ifdef WITH_THREADS
+      if (cmd.findOption("--threads"))
+      {
+        app.checkValue(cmd.getValueAndCheckMinMax(opt_threads, OFstatic_cast(OFCmdUnsignedInt, 1), OFstatic_cast(OFCmdUnsignedInt, 1024)));
+      }
+#endif
+
       cmd.beginOptionBlock();
       if (cmd.findOption("--offset-table-create")) opt_createOffsetTable = OFTrue;
       if (cmd.findOption("--offset-table-empty")) opt_createOffsetTable = OFFalse;
@@ -237,7 +250,8 @@ int main(int argc, char *argv[])
 
     // register RLE compression codec
     DcmRLEEncoderRegistration::registerCodecs(opt_uidcreation,
-      OFstatic_cast(Uint32, opt_fragmentSize), opt_createOffsetTable, opt_secondarycapture);
+      OFstatic_cast(Uint32, opt_fragmentSize), opt_createOffsetTable, opt_secondarycapture,
+      OFstatic_cast(Uint32, opt_threads));
 
     /* make sure data dictionary is loaded */
     if (!dcmDataDict.isDictionaryLoaded())
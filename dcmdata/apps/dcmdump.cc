@@ -190,6 +190,9 @@ DCMTK_MAIN_FUNCTION
         cmd.addOption("--load-short",          "-M",     "do not load very long values (e.g. pixel data)");
         cmd.addOption("--max-read-length",     "+R",  1, "[k]bytes: integer (4..4194302, default: 4)",
                                                          "set threshold for long values to k kbytes");
+      cmd.addSubGroup("file access:");
+        cmd.addOption("--read-file-io",        "-mm",    "read input files with standard file I/O (default)");
+        cmd.addOption("--memory-map",          "+mm",    "map input files into memory (if supported)");
       cmd.addSubGroup("parsing of file meta information:");
         cmd.addOption("--use-meta-length",     "+ml",    "use file meta information group length (default)");
         cmd.addOption("--ignore-meta-length",  "-ml",    "ignore file meta information group length");
@@ -365,6 +368,11 @@ DCMTK_MAIN_FUNCTION
       if (cmd.findOption("--load-short")) loadIntoMemory = OFFalse;
       cmd.endOptionBlock();
 
+      cmd.beginOptionBlock();
+      if (cmd.findOption("--read-file-io")) dcmUseMemoryMappedFileInput.set(OFFalse);
+      if (cmd.findOption("--memory-map")) dcmUseMemoryMappedFileInput.set(OFTrue);
+      cmd.endOptionBlock();
+
       cmd.beginOptionBlock();
       if (cmd.findOption("--use-meta-length"))
       {
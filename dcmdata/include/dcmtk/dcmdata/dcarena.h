@@ -0,0 +1,230 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: DcmArena and DcmArenaScope,
+ *    block allocation of DICOM object trees
+ *
+ */
+
+#ifndef DCARENA_H
+#define DCARENA_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftypes.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/dcmdata/dcdefine.h"
+
+#ifdef HAVE_CXX11
+#include <atomic>
+#endif
+#include <new>
+
+/// default size of the memory blocks allocated by class DcmArena
+#define DcmArenaDefaultBlockSize 65536
+
+/** maximum length of an attribute value (in bytes) that is allocated from
+ *  an arena. Longer values (e.g. pixel data) are always allocated on the
+ *  heap, so that their memory can be returned as soon as they are deleted.
+ */
+#define DcmArenaMaxValueSize 1024
+
+/** class that allocates memory for the objects of a DICOM object tree
+ *  (DcmObject and derived classes, list nodes and small attribute values)
+ *  from a few large blocks instead of individual heap allocations.
+ *  Memory allocated from an arena is never returned to the arena
+ *  individually; instead, all blocks are freed in one step when the last
+ *  object allocated from the arena has been deleted.
+ *  An arena is only used for allocations while it is active in the current
+ *  thread, see class DcmArenaScope. Objects allocated from an arena may be
+ *  deleted in any thread and may live longer than the object tree they were
+ *  created for (e.g. after being removed from a dataset), since each of them
+ *  holds a reference to the arena.
+ *  The class maintains a thread-safe reference counter, and when this counter
+ *  is decreased to zero, frees all blocks and deletes the object itself.
+ */
+class DCMTK_DCMDATA_EXPORT DcmArena
+{
+public:
+
+  /** static method that permits creation of instances of
+   *  this class (only) on the heap, never on the stack.
+   *  A newly created instance always has a reference counter of 1.
+   *  @param blockSize size of the memory blocks to be allocated (in bytes)
+   *  @return pointer to new instance
+   */
+  static DcmArena *newInstance(size_t blockSize = DcmArenaDefaultBlockSize);
+
+  /// increase reference counter for this object
+  void increaseRefCount();
+
+  /** decreases reference counter for this object and frees
+   *  all blocks and deletes this object if the reference counter becomes zero.
+   */
+  void decreaseRefCount();
+
+  /** allocates the given number of bytes from the arena. The memory is
+   *  aligned for any of the basic data types used by dcmdata.
+   *  This method must only be called by the thread in which the arena is
+   *  active and does not modify the reference counter.
+   *  @param size number of bytes to be allocated
+   *  @return pointer to allocated memory, never NULL
+   *    (throws std::bad_alloc if no memory is available)
+   */
+  void *allocate(size_t size);
+
+  /** returns the arena that is active in the current thread
+   *  @return pointer to active arena, NULL if none
+   */
+  static DcmArena *current();
+
+  /** allocates memory for an object from the arena that is active in the
+   *  current thread or, if there is none, from the heap. Used to implement
+   *  operator new of the classes that support arena allocation.
+   *  The memory must be released with releaseObject().
+   *  @param size size of the object in bytes
+   *  @param nothrow if true, return NULL instead of throwing std::bad_alloc
+   *    if no memory is available
+   *  @return pointer to allocated memory
+   */
+  static void *allocateObject(size_t size, OFBool nothrow = OFFalse);
+
+  /** releases memory allocated with allocateObject(). Memory allocated from
+   *  an arena is only freed when the arena is deleted.
+   *  @param ptr pointer to memory, may be NULL
+   */
+  static void releaseObject(void *ptr);
+
+  /** returns the total number of bytes in the blocks of this arena
+   *  @return number of bytes allocated from the heap
+   */
+  size_t getBlockBytes() const { return blockBytes_; }
+
+private:
+
+  /** private constructor.
+   *  Instances of this class are always created through newInstance().
+   *  @param blockSize size of the memory blocks to be allocated (in bytes)
+   */
+  DcmArena(size_t blockSize);
+
+  /** private destructor. Instances of this class
+   *  are always deleted through the reference counting methods
+   */
+  virtual ~DcmArena();
+
+  /// private undefined copy constructor
+  DcmArena(const DcmArena& arg);
+
+  /// private undefined copy assignment operator
+  DcmArena& operator=(const DcmArena& arg);
+
+  friend class DcmArenaScope;
+
+  /** makes the given arena the active one in the current thread
+   *  @param arena pointer to arena, may be NULL
+   */
+  static void setCurrent(DcmArena *arena);
+
+#ifdef HAVE_CXX11
+  /// number of references to the arena (including one per allocated object)
+  std::atomic<size_t> refCount_;
+#else
+  /** number of references to the arena (including one per allocated object).
+   *  Default initialized to 1 upon construction of this object
+   */
+  size_t refCount_;
+
+#ifdef WITH_THREADS
+  /// mutex for MT-safe reference counting
+  /// @remark this member is only available if DCMTK is compiled with thread
+  /// support enabled.
+  OFMutex mutex_;
+#endif
+#endif
+
+  /// size of a regular block
+  size_t blockSize_;
+
+  /// all blocks allocated by this arena
+  OFVector<Uint8 *> blocks_;
+
+  /// next free byte in the current block
+  Uint8 *next_;
+
+  /// end of the current block
+  Uint8 *end_;
+
+  /// total number of bytes in all blocks
+  size_t blockBytes_;
+};
+
+
+/** helper class that makes an arena the active one in the current thread
+ *  for the lifetime of the object, i.e.\ objects of the classes supporting
+ *  arena allocation that are created in the meantime are allocated from
+ *  the arena. The scope holds a reference to the arena, i.e.\ the arena
+ *  is not deleted before the scope ends. The previously active arena is
+ *  restored by the destructor. Scopes may be nested, but must be destroyed
+ *  in the reverse order of creation.
+ */
+class DCMTK_DCMDATA_EXPORT DcmArenaScope
+{
+public:
+
+  /** constructor
+   *  @param arena pointer to arena to be activated. If NULL, no arena is
+   *    used within this scope.
+   */
+  DcmArenaScope(DcmArena *arena);
+
+  /// destructor, restores the previously active arena and releases the reference
+  ~DcmArenaScope();
+
+private:
+
+  /// private undefined copy constructor
+  DcmArenaScope(const DcmArenaScope& arg);
+
+  /// private undefined copy assignment operator
+  DcmArenaScope& operator=(const DcmArenaScope& arg);
+
+  /// arena activated by this scope, may be NULL
+  DcmArena *arena_;
+
+  /// arena that was active before this scope
+  DcmArena *previous_;
+};
+
+
+#ifdef HAVE_CXX11
+#define DCMTK_DCMDATA_ARENA_NOTHROW noexcept
+#else
+#define DCMTK_DCMDATA_ARENA_NOTHROW throw()
+#endif
+
+/** declares operator new and delete for a class so that its instances are
+ *  allocated from the arena that is active in the current thread, if any.
+ */
+#define DCMTK_DCMDATA_ARENA_ALLOCATION \
+    static void *operator new(size_t size) { return DcmArena::allocateObject(size); } \
+    static void *operator new(size_t size, const std::nothrow_t &) DCMTK_DCMDATA_ARENA_NOTHROW { return DcmArena::allocateObject(size, OFTrue); } \
+    static void operator delete(void *ptr) { DcmArena::releaseObject(ptr); } \
+    static void operator delete(void *ptr, const std::nothrow_t &) DCMTK_DCMDATA_ARENA_NOTHROW { DcmArena::releaseObject(ptr); }
+
+#endif
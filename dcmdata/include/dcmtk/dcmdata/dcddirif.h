@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2025, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,6 +26,7 @@
 #include "dcmtk/config/osconfig.h"
 
 #include "dcmtk/dcmdata/dcdicdir.h"
+#include "dcmtk/ofstd/oflist.h"
 
 
 /*------------------------------------*
@@ -243,6 +244,8 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
 
     /** write the current DICOMDIR object to file.
      *  NB: The filename has already been specified for the object creation (see above).
+     *  If the incremental write mode is enabled (see enableIncrementalWriteMode()), new
+     *  records are appended to an existing DICOMDIR file (if possible).
      *  @param encodingType flag, specifying the encoding with undefined or explicit length
      *  @param groupLength flag, specifying how to handle the group length tags
      *  @return EC_Normal upon success, an error code otherwise
@@ -301,6 +304,34 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
     OFCondition addDicomFile(const OFFilename &filename,
                              const OFFilename &directory = OFFilename());
 
+    /** add specified DICOM files to the current DICOMDIR.
+     *  The result is the same as calling addDicomFile() for each file in the order of
+     *  the list, i.e. the directory records are always created in this order, and a
+     *  file that cannot be added only stops the processing if the "abort on first error"
+     *  mode is enabled (see enableAbortMode()).  However, if more than one thread is
+     *  used, the time-consuming part of adding a file (i.e. loading and checking the
+     *  file as well as creating the icon image, if required) is performed by a number
+     *  of worker threads concurrently.  At most a few files per thread are kept in
+     *  memory at the same time.  Please note that the image plugin (if any) has to
+     *  support being called by multiple threads in this case.
+     *  @param filenames names of the DICOM files to be added
+     *  @param directory directory where the DICOM files are stored (optional, see
+     *    addDicomFile() for details)
+     *  @param badFiles names of the files that could not be added are appended to this
+     *    list (in the order of 'filenames')
+     *  @param goodFiles returns the number of files that have been added successfully
+     *  @param numThreads number of threads used for loading and checking the files
+     *    (default: 1, i.e. all files are processed by the calling thread). Ignored if
+     *    DCMTK is compiled without thread support.
+     *  @return EC_Normal upon success, an error code otherwise (e.g. the reason why the
+     *    first bad file could not be added in case the abort mode is enabled)
+     */
+    OFCondition addDicomFiles(const OFList<OFFilename> &filenames,
+                              const OFFilename &directory,
+                              OFList<OFFilename> &badFiles,
+                              size_t &goodFiles,
+                              const unsigned int numThreads = 1);
+
     /** set the file-set descriptor file ID and character set.
      *  Prior to any internal modification both 'filename' and 'charset' are checked
      *  using the above checking routines.  Existence of 'filename' is not checked.
@@ -404,6 +435,15 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
         return BackupMode;
     }
 
+    /** get current status of the "incremental write" mode.
+     *  See enableIncrementalWriteMode() for more details.
+     *  @return OFTrue if mode is enabled, OFFalse otherwise
+     */
+    OFBool incrementalWriteMode() const
+    {
+        return IncrementalWriteMode;
+    }
+
     /** get current status of the "pixel encoding check" mode.
      *  See disableEncodingCheck() for more details.
      *  @return OFTrue if check is enabled, OFFalse otherwise
@@ -516,6 +556,22 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
      */
     OFBool disableBackupMode(const OFBool newMode = OFFalse);
 
+    /** enable/disable the "incremental write" mode.
+     *  If this mode is enabled, writeDicomDir() appends new directory records to the
+     *  end of an existing DICOMDIR file (see appendToDicomDir() and updateDicomDir())
+     *  and only overwrites those parts of the file that have actually changed, e.g.
+     *  the offsets to the next and lower-level directory records, instead of writing
+     *  the complete file again.  If this is not possible, e.g. because the size of an
+     *  existing record has changed, the complete file is written as usual.
+     *  Please note that in this mode, the existing file is modified directly, i.e.
+     *  without creating a temporary copy first (see DcmDicomDir::writeIncremental()).
+     *  So, the backup mode (see disableBackupMode()) should not be disabled.
+     *  Default: off, always write the complete DICOMDIR file
+     *  @param newMode enable mode if OFTrue, disable if OFFalse
+     *  @return previously stored value
+     */
+    OFBool enableIncrementalWriteMode(const OFBool newMode = OFTrue);
+
     /** disable/enable the "pixel encoding check".
      *  If this mode is disabled, the pixel encoding is not check for compliance
      *  with the selected application profile.
@@ -614,6 +670,36 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
                                       DcmFileFormat &fileformat,
                                       const OFBool checkFilename = OFTrue);
 
+    /** load DICOM file, check whether it is suitable for a DICOMDIR of the specified
+     *  application profile and create the icon image of the corresponding image record
+     *  (if required).  This is the part of adding a file that does not modify the
+     *  DICOMDIR, i.e. it may be called by multiple threads concurrently.
+     *  @param filename name of the DICOM file to be loaded
+     *  @param directory directory where the DICOM file is stored (optional)
+     *  @param fileformat object in which the loaded data is stored
+     *  @param iconPixel returns the pixel data of the icon image (allocated with new[],
+     *    has to be deleted by the caller) or NULL if no icon image is required
+     *  @param iconSize returns the resolution of the icon image (width and height)
+     *  @return EC_Normal upon success, an error code otherwise
+     */
+    OFCondition prepareDicomFile(const OFFilename &filename,
+                                 const OFFilename &directory,
+                                 DcmFileFormat &fileformat,
+                                 Uint8 *&iconPixel,
+                                 unsigned int &iconSize);
+
+    /** add the directory records for a DICOM file to the current DICOMDIR.
+     *  The file should have been loaded and checked with loadAndCheckDicomFile()
+     *  or prepareDicomFile().
+     *  @param filename name of the DICOM file to be added
+     *  @param directory directory where the DICOM file is stored (optional)
+     *  @param fileformat DICOM dataset of the file to be added
+     *  @return EC_Normal upon success, an error code otherwise
+     */
+    OFCondition addDicomFileRecords(const OFFilename &filename,
+                                    const OFFilename &directory,
+                                    DcmFileFormat &fileformat);
+
     /** check SOP class and transfer syntax for compliance with current profile
      *  @param metainfo object where the DICOM file meta information is stored
      *  @param dataset object where the DICOM dataset is stored
@@ -1196,6 +1282,27 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
                               const unsigned int width,
                               const unsigned int height);
 
+    /** determine whether icon images are created for image records of the current
+     *  application profile, and in which resolution
+     *  @param required set to OFTrue if the icon image is required by the profile
+     *  @return resolution of the icon images (width and height), 0 if none are created
+     */
+    unsigned int getIconImageSize(OFBool &required) const;
+
+    /** create the pixel data of an icon image, either from an external PGM file (see
+     *  setIconPrefix()) or from the DICOM dataset.  If both fail, the default icon (if
+     *  any) or a black image is used.
+     *  @param dataset DICOM dataset from which the icon image is possibly created
+     *  @param size resolution of the icon image to be created (width and height)
+     *  @param sourceFilename name of the source DICOM file
+     *  @param pixel pointer to memory buffer of 'size' * 'size' bytes where the pixel
+     *    data are to be stored
+     */
+    void createIconPixelData(DcmItem *dataset,
+                             const unsigned int size,
+                             const OFFilename &sourceFilename,
+                             Uint8 *pixel);
+
     /** add icon image sequence to directory record.
      *  If the icon image cannot be created from the DICOM dataset and there is no
      *  PGM file specified (neither for the particular image not a default one) a
@@ -1623,6 +1730,8 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
     OFBool IconImageMode;
     /// update existing file-set
     OFBool FilesetUpdateMode;
+    /// append new records to existing DICOMDIR file
+    OFBool IncrementalWriteMode;
 
     /// name of the DICOMDIR backup file
     OFFilename BackupFilename;
@@ -1658,6 +1767,14 @@ class DCMTK_DCMDATA_EXPORT DicomDirInterface
     /// current curve number used to invent missing attribute values
     unsigned long AutoCurveNumber;
 
+    /// icon image pixel data created in advance for the current file (NULL if none)
+    const Uint8 *PreparedIconPixel;
+    /// resolution of the icon image created in advance
+    unsigned int PreparedIconSize;
+
+    /// the worker threads of addDicomFiles() call prepareDicomFile()
+    friend class DicomDirInterfaceBatchJob;
+
     /// private undefined copy constructor
     DicomDirInterface(const DicomDirInterface &obj);
 
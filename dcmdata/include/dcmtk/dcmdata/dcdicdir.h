@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2019, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -45,6 +45,26 @@ typedef struct
 } ItemOffset;
 
 
+/** helper structure describing the layout of a DICOMDIR file as far as it is
+ *  needed for appending new directory records to the file (see writeIncremental())
+ */
+typedef struct
+{
+    /// size of the file in bytes, 0 if the layout is unknown
+    offile_off_t fileSize;
+    /// offset of the first data element of the dataset
+    Uint32 datasetStart;
+    /// offset of the value of the directory record sequence, i.e.\ the first item
+    Uint32 sequenceStart;
+    /// offset of the end of the last item in the directory record sequence
+    Uint32 sequenceEnd;
+    /// number of directory records stored in the file
+    unsigned long numberOfRecords;
+    /// OFTrue if the directory record sequence is encoded with undefined length
+    OFBool undefinedLength;
+} DicomDirFileLayout;
+
+
 /** this class implements support for DICOMDIR files, which are special DICOM files
  *  containing a list of directory records, with a logical tree structure being
  *  implemented through references between records as byte offsets in file.
@@ -123,6 +143,29 @@ public:
       const E_EncodingType enctype = EET_UndefinedLength,
       const E_GrpLenEncoding glenc = EGL_withoutGL );
 
+    /** writes DICOMDIR to file incrementally, i.e.\ new directory records are appended
+     *  to the end of the directory record sequence in the existing file and only those
+     *  parts of the file are overwritten (in place) that have actually changed, usually
+     *  the offsets of the next and lower-level directory records as well as the offset
+     *  of the last directory record of the root directory entity.  This is much faster
+     *  than writing a new file if only a few records are added to a large DICOMDIR.
+     *  Existing records are never moved within the file.  If the size of an existing
+     *  record or of the data elements preceding the directory record sequence has
+     *  changed, the file has been modified by another application since it was read
+     *  or written, or the DICOMDIR has not been read from file at all, write() is
+     *  called instead, i.e.\ the complete file is written again.
+     *  Please note that the Media Storage SOP Instance UID (and other attributes of the
+     *  file meta information) are not updated and that the existing file is modified
+     *  directly, i.e.\ no temporary backup copy is created.
+     *  @param enctype encoding type for new directory records
+     *  @param glenc encoding type for group lengths.  EGL_withGL is not supported for
+     *    incremental writing, i.e.\ in this case, write() is always called.
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition writeIncremental(
+      const E_EncodingType enctype = EET_UndefinedLength,
+      const E_GrpLenEncoding glenc = EGL_withoutGL );
+
     /** check the currently stored element value
      *  @param autocorrect correct value length if OFTrue
      *  @return status, EC_Normal if value length is correct, an error code otherwise
@@ -165,6 +208,8 @@ public:
                                      Uint32 beginOfFileSet,          // in
                                      E_TransferSyntax oxfer,         // in
                                      E_EncodingType enctype );       // in
+    OFCondition convertRecordPointer( DcmDataset &dset,              // inout
+                                      DcmSequenceOfItems &recSeq );  // inout
     OFCondition copyRecordPtrToSQ(   DcmDirectoryRecord *record,     // in
                                      DcmSequenceOfItems &toDirSQ,    // inout
                                      DcmDirectoryRecord **firstRec,  // out
@@ -184,7 +229,16 @@ public:
                                      E_TransferSyntax oxfer,        // in
                                      E_EncodingType enctype,        // in
                                      E_GrpLenEncoding glenc,        // in
-                                     DcmSequenceOfItems &unresRecs);// inout
+                                     DcmSequenceOfItems &unresRecs, // inout
+                                     OFBool keepOffsets = OFFalse );// in
+
+    // determine the layout of the DICOMDIR file that has just been read
+    void determineFileLayout();
+
+    // append new records to the DICOMDIR file and patch modified parts in place
+    OFBool appendRecordsToFile(      DcmDataset &dset,              // inout
+                                     DcmSequenceOfItems &recSeq,    // inout
+                                     E_EncodingType enctype );      // in
 
   private:
 
@@ -220,6 +274,9 @@ public:
 
     /// container in which all MRDR (multi-reference directory records) for this DICOMDIR are kept
     DcmSequenceOfItems * MRDRSeq;
+
+    /// layout of the DICOMDIR file as read or last written, used by writeIncremental()
+    DicomDirFileLayout fileLayout;
 };
 
 #endif // DCDICDIR_H
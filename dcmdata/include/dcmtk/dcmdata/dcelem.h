@@ -31,6 +31,7 @@
 
 // forward declarations
 class DcmInputStreamFactory;
+class DcmFileMapping;
 class DcmJsonFormat;
 class DcmFileCache;
 class DcmItem;
@@ -488,7 +489,9 @@ class DCMTK_DCMDATA_EXPORT DcmElement
      *  over the element value, especially the value must be deleted from the
      *  heap after use. The DICOM element remains a copy of the value if the
      *  copy parameter is OFTrue; otherwise the value is erased in the DICOM
-     *  element.
+     *  element. Values that reference a memory-mapped file (see
+     *  dcmUseMemoryMappedFileInput) or that have been allocated from an arena
+     *  (see DcmFileFormat::setArenaAllocation()) cannot be detached.
      *  @param copy if true, copy value field before detaching; if false, do not
      *    retain a copy.
      *  @return EC_Normal upon success, an error code otherwise
@@ -1023,6 +1026,15 @@ class DCMTK_DCMDATA_EXPORT DcmElement
      */
     virtual Uint8 *newValueField();
 
+    /** allocates a value field of the given size, either from the arena
+     *  that is active in the current thread (for short values, see DcmArena)
+     *  or from the heap. Used by newValueField() for the actual allocation,
+     *  the result must be assigned to the value field.
+     *  @param numBytes size of the value field in bytes
+     *  @return pointer to allocated value field, NULL if out of memory
+     */
+    Uint8 *allocateValueField(const size_t numBytes);
+
     /** swaps the content of the value field (if loaded) from big-endian to
      *  little-endian or back
      *  @param valueWidth width (in bytes) of each element value
@@ -1071,6 +1083,11 @@ class DCMTK_DCMDATA_EXPORT DcmElement
 
   private:
 
+    /** deletes the value field (or releases the reference to the memory-mapped
+     *  file or arena it points into) and sets the value field pointer to NULL
+     */
+    void freeValueField();
+
     /// current byte order of attribute value in memory
     E_ByteOrder fByteOrder;
 
@@ -1079,6 +1096,16 @@ class DCMTK_DCMDATA_EXPORT DcmElement
 
     /// value of the element
     Uint8 *fValue;
+
+    /** memory-mapped file referenced by fValue, NULL if fValue is allocated
+     *  on the heap. If not NULL, the element holds a reference to the mapping.
+     */
+    DcmFileMapping *fMapping;
+
+    /** arena from which fValue has been allocated, NULL if fValue is allocated
+     *  on the heap. If not NULL, the element holds a reference to the arena.
+     */
+    DcmArena *fArena;
 };
 
 /** Checks whether left hand side element is smaller than right hand side
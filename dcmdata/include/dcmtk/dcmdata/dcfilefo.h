@@ -525,6 +525,9 @@ class DCMTK_DCMDATA_EXPORT DcmFileFormat
     /// (0 = compile-time default DCMTK_MAX_SEQUENCE_NESTING, -1 = unlimited)
     Sint32 MaxNestingDepth;
 
+    /// flag indicating whether loadFile() allocates the object tree from an arena
+    OFBool ArenaAllocation;
+
   public:
 
     /** set the maximum permitted sequence nesting depth for parsing.
@@ -549,6 +552,25 @@ class DCMTK_DCMDATA_EXPORT DcmFileFormat
      *    (0 = compile-time default DCMTK_MAX_SEQUENCE_NESTING, -1 = unlimited)
      */
     Sint32 getMaxNestingDepth() const { return MaxNestingDepth; }
+
+    /** enable or disable arena allocation for subsequent calls of loadFile()
+     *  and loadFileUntilTag(). If enabled, the objects created while parsing
+     *  a file (elements, items, sequences, list nodes and short values) are
+     *  allocated from a new DcmArena, i.e.\ from a few large memory blocks,
+     *  which are freed in one step when the last of these objects is deleted.
+     *  This reduces the time needed for loading and deleting datasets with many
+     *  elements. Values allocated from an arena cannot be detached from their
+     *  element (see DcmElement::detachValueField()), and memory of objects that
+     *  are deleted or replaced is only reclaimed with the whole arena.
+     *  Default is OFFalse.
+     *  @param enable enable arena allocation if OFTrue, disable otherwise
+     */
+    void setArenaAllocation(OFBool enable) { ArenaAllocation = enable; }
+
+    /** return whether arena allocation is enabled for loadFile()
+     *  @return OFTrue if arena allocation is enabled, OFFalse otherwise
+     */
+    OFBool getArenaAllocation() const { return ArenaAllocation; }
 };
 
 
@@ -0,0 +1,111 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: base class for encoders compressing multiple frames concurrently
+ *
+ */
+
+#ifndef DCFRMENC_H
+#define DCFRMENC_H
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/dcmdata/dcpixseq.h"
+#include "dcmtk/ofstd/ofcond.h"
+
+/** abstract base class for encoders that compress the frames of a
+ *  multi-frame image independently of each other. Derived classes implement
+ *  the compression of a single frame, this class distributes the frames over
+ *  a number of worker threads and stores the compressed frames in a pixel
+ *  sequence in frame order, i.e. the result (including the offset list) is
+ *  identical to sequential compression.
+ *  If DCMTK is compiled without thread support, all frames are compressed
+ *  sequentially by the calling thread.
+ */
+class DCMTK_DCMDATA_EXPORT DcmConcurrentFrameEncoder
+{
+public:
+
+  /** constructor
+   *  @param numThreads number of threads to be used for compression. Values
+   *    0 and 1 select sequential compression by the calling thread.
+   *    The calling thread always participates in the compression, i.e.
+   *    numThreads - 1 additional threads are created.
+   */
+  DcmConcurrentFrameEncoder(Uint32 numThreads);
+
+  /// destructor
+  virtual ~DcmConcurrentFrameEncoder();
+
+  /** compresses the given number of frames and appends them to the pixel
+   *  sequence in frame order, one item per fragment.
+   *  Compression stops with the first error.
+   *  @param numFrames number of frames to compress
+   *  @param pixelSequence pixel sequence to which the compressed frames are appended
+   *  @param offsetList list of offsets, one entry per frame is appended
+   *  @param fragmentSize maximum fragment size (in kbytes), 0 for unlimited
+   *  @param compressedSize upon return, the total number of compressed bytes
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  OFCondition encodeFrames(
+    Uint32 numFrames,
+    DcmPixelSequence *pixelSequence,
+    DcmOffsetList &offsetList,
+    Uint32 fragmentSize,
+    size_t &compressedSize);
+
+  /** returns the number of threads used for compression, which is the
+   *  number of distinct thread numbers passed to encodeFrame().
+   *  @return number of threads, always >= 1
+   */
+  Uint32 getNumberOfThreads() const
+  {
+    return numThreads_;
+  }
+
+protected:
+
+  /** compresses a single frame. This method is called concurrently for
+   *  different frames, but never concurrently with the same thread number,
+   *  so that derived classes can keep per-thread resources indexed by thread number.
+   *  @param frameNo number of the frame to compress, starting with 0
+   *  @param threadNo number of the calling thread, 0 <= threadNo < getNumberOfThreads()
+   *  @param compressedData upon success, points to the compressed frame, which
+   *    must have been allocated with new[]. Ownership is transferred to the caller.
+   *  @param compressedLen upon success, the length of the compressed frame in bytes
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  virtual OFCondition encodeFrame(
+    Uint32 frameNo,
+    Uint32 threadNo,
+    Uint8 *&compressedData,
+    Uint32 &compressedLen) = 0;
+
+private:
+
+  friend class DcmConcurrentFrameEncoderJob;
+
+  /// private undefined copy constructor
+  DcmConcurrentFrameEncoder(const DcmConcurrentFrameEncoder&);
+
+  /// private undefined copy assignment operator
+  DcmConcurrentFrameEncoder& operator=(const DcmConcurrentFrameEncoder&);
+
+  /// number of threads used for compression
+  Uint32 numThreads_;
+};
+
+#endif
@@ -29,6 +29,7 @@
 #include "dcmtk/dcmdata/dcxfer.h"   /* for E_StreamCompression */
 
 class DcmInputStream;
+class DcmFileMapping;
 
 /** pure virtual abstract base class for producers, i.e. the initial node
  *  of a filter chain in an input stream.
@@ -87,6 +88,30 @@ public:
    */
   virtual void putback(offile_off_t num) = 0;
 
+  /** returns a pointer to the next num bytes of the stream if the producer
+   *  keeps them in a memory-mapped file, and skips over them. This permits
+   *  attribute values to reference the file content without copying.
+   *  The default implementation does not support this and returns NULL.
+   *  @param num number of bytes requested
+   *  @param mapping upon success, pointer to the file mapping the block
+   *    belongs to. The reference counter is not increased by this call.
+   *  @return pointer to the block if successful, NULL otherwise
+   */
+  virtual Uint8 *mapBlock(offile_off_t /* num */, DcmFileMapping *& /* mapping */)
+  {
+    return NULL;
+  }
+
+  /** checks whether the producer permits putback operations of arbitrary
+   *  length, i.e.\ back to the start of the stream, as is the case for
+   *  producers reading from a file.  The default implementation returns false.
+   *  @return true if arbitrary putback operations are possible, false otherwise
+   */
+  virtual OFBool isSeekable() const
+  {
+    return OFFalse;
+  }
+
 };
 
 
@@ -119,7 +144,10 @@ enum DcmInputStreamFactoryType
   DFT_DcmInputFileStreamFactory,
 
   /// class DcmInputTempFileStreamFactory
-  DFT_DcmInputTempFileStreamFactory
+  DFT_DcmInputTempFileStreamFactory,
+
+  /// class DcmInputMappedFileStreamFactory
+  DFT_DcmInputMappedFileStreamFactory
 };
 
 /** pure virtual abstract base class for input stream factories,
@@ -199,11 +227,38 @@ public:
    */
   virtual offile_off_t skip(offile_off_t skiplen);
 
+  /** returns a pointer to the next num bytes of the stream if these are
+   *  available in a memory-mapped file, and skips over them. Not supported
+   *  when a compression filter is active.
+   *  @param num number of bytes requested
+   *  @param mapping upon success, pointer to the file mapping the block
+   *    belongs to. The reference counter is not increased by this call.
+   *  @return pointer to the block if successful, NULL otherwise
+   */
+  virtual Uint8 *mapBlock(offile_off_t num, DcmFileMapping *&mapping);
+
   /** returns the total number of bytes read from the stream so far
    *  @return total number of bytes read from the stream
    */
   virtual offile_off_t tell() const;
 
+  /** checks whether the read position of the stream can be set to any
+   *  position, including positions that have already been passed.
+   *  This requires a seekable producer and no compression filter.
+   *  @return true if the stream is seekable, false otherwise
+   */
+  virtual OFBool isSeekable() const;
+
+  /** sets the read position of the stream, i.e.\ the value returned by
+   *  tell(), to the given number of bytes from the start of the stream.
+   *  Positions before the current one can only be reached if the stream is
+   *  seekable (see isSeekable()), otherwise the bytes up to the requested
+   *  position are skipped.
+   *  @param pos new read position, relative to the start of the stream
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  virtual OFCondition seek(offile_off_t pos);
+
   /** installs a compression filter for the given stream compression type,
    *  which should be neither ESC_none nor ESC_unsupported. Once a compression
    *  filter is active, it cannot be deactivated or replaced during the
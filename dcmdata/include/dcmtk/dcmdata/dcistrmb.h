@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2011, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -27,6 +27,30 @@
 #include "dcmtk/dcmdata/dcistrma.h"
 
 
+/** abstract class for objects that can deliver the next block of data of
+ *  a DcmBufferProducer directly into memory provided by the reader, e.g.
+ *  by receiving it from a network connection. This avoids copying large
+ *  attribute values through an intermediate buffer.
+ */
+class DCMTK_DCMDATA_EXPORT DcmBufferSource
+{
+public:
+  /// destructor
+  virtual ~DcmBufferSource() {}
+
+  /** reads the next block of data of the stream into the given memory block
+   *  if the complete block of data fits into it. Otherwise, nothing is read
+   *  and the block of data must be passed to the producer with setBuffer().
+   *  @param buf pointer to memory block, must not be NULL
+   *  @param buflen length of memory block
+   *  @param eos set to true if the block of data read was the last one
+   *    of the stream, unchanged otherwise
+   *  @return number of bytes actually read
+   */
+  virtual offile_off_t readDirect(void *buf, offile_off_t buflen, OFBool &eos) = 0;
+};
+
+
 /** producer class that reads data from a buffer provided by the caller.
  *  Used for DICOM network communication.
  */
@@ -105,6 +129,15 @@ public:
    */
   virtual void setEos();
 
+  /** sets the source that is asked to deliver further data directly into
+   *  the memory block passed to read() when both the backup buffer and the
+   *  user buffer have been read completely. Data read directly cannot be
+   *  put back.
+   *  @param source source object, NULL to disable direct reading.
+   *    Must remain valid until it is reset or the producer is destroyed.
+   */
+  virtual void setSource(DcmBufferSource *source);
+
 private:
 
   /// private unimplemented copy constructor
@@ -137,6 +170,9 @@ private:
   /// true if setEos has been called before
   OFBool eosflag_;
 
+  /// source for reading data directly into the caller's memory, may be NULL
+  DcmBufferSource *source_;
+
 };
 
 
@@ -184,6 +220,14 @@ public:
    */
   virtual void setEos();
 
+  /** sets the source that is asked to deliver further data directly into
+   *  the memory provided by the reader (e.g. the value field of an element)
+   *  when the current buffer has been read completely.
+   *  @param source source object, NULL to disable direct reading.
+   *    Must remain valid until it is reset or the stream is destroyed.
+   */
+  virtual void setSource(DcmBufferSource *source);
+
 private:
 
   /// private unimplemented copy constructor
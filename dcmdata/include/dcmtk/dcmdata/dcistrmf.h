@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2020, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -25,6 +25,95 @@
 
 #include "dcmtk/config/osconfig.h"
 #include "dcmtk/dcmdata/dcistrma.h"
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/ofvector.h"
+
+/** class that manages the open handles of a plain file that is read by
+ *  one or more input streams.  All streams and stream factories created for
+ *  attribute values of a loaded file share a single instance of this class,
+ *  so that a value that is accessed after loading does not require the file
+ *  to be opened again.  Released handles are kept open for reuse, up to the
+ *  number given by the global flag dcmFileHandlePoolSize.
+ *  The class maintains a thread-safe reference counter, and when this counter
+ *  is decreased to zero, closes all handles and deletes the object itself.
+ */
+class DCMTK_DCMDATA_EXPORT DcmFileHandlePool
+{
+public:
+
+  /** static method that permits creation of instances of
+   *  this class (only) on the heap, never on the stack.
+   *  A newly created instance always has a reference counter of 1.
+   *  @param filename name of file (may contain wide chars if support enabled)
+   *  @return pointer to new instance
+   */
+  static DcmFileHandlePool *newInstance(const OFFilename &filename);
+
+  /** returns a handle for reading the file, either a previously released
+   *  one or a newly opened one. The handle must be returned with release().
+   *  The current position of the returned handle is undefined.
+   *  @param status upon return, contains the status of the operation
+   *  @return pointer to file handle if successful, NULL otherwise
+   */
+  OFFile *acquire(OFCondition &status);
+
+  /** returns a handle obtained with acquire() to the pool. The handle is
+   *  either kept open for reuse or closed and deleted.
+   *  @param file pointer to file handle, may be NULL
+   */
+  void release(OFFile *file);
+
+  /// increase reference counter for this object
+  void increaseRefCount();
+
+  /** decreases reference counter for this object and closes all handles
+   *  and deletes this object if the reference counter becomes zero.
+   */
+  void decreaseRefCount();
+
+  /** returns the name of the file
+   *  @return name of the file
+   */
+  const OFFilename &getFilename() const { return filename_; }
+
+private:
+
+  /** private constructor.
+   *  Instances of this class are always created through newInstance().
+   *  @param filename name of file
+   */
+  DcmFileHandlePool(const OFFilename &filename);
+
+  /** private destructor. Instances of this class
+   *  are always deleted through the reference counting methods
+   */
+  virtual ~DcmFileHandlePool();
+
+  /// private undefined copy constructor
+  DcmFileHandlePool(const DcmFileHandlePool& arg);
+
+  /// private undefined copy assignment operator
+  DcmFileHandlePool& operator=(const DcmFileHandlePool& arg);
+
+  /** number of references to the pool.
+   *  Default initialized to 1 upon construction of this object
+   */
+  size_t refCount_;
+
+#ifdef WITH_THREADS
+  /// mutex for MT-safe reference counting and access to the idle handles
+  /// @remark this member is only available if DCMTK is compiled with thread
+  /// support enabled.
+  OFMutex mutex_;
+#endif
+
+  /// name of the file
+  OFFilename filename_;
+
+  /// open handles that are currently not used by any stream
+  OFVector<OFFile *> idle_;
+};
+
 
 /** producer class that reads data from a plain file.
  */
@@ -38,7 +127,14 @@ public:
    */
   DcmFileProducer(const OFFilename &filename, offile_off_t offset = 0);
 
-  /// destructor
+  /** constructor. Uses a handle from the given pool.
+   *  @param pool pointer to file handle pool, must not be NULL.
+   *    Reference counter of the pool is increased by this operation.
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmFileProducer(DcmFileHandlePool *pool, offile_off_t offset = 0);
+
+  /// destructor, returns the file handle to the pool
   virtual ~DcmFileProducer();
 
   /** returns the status of the producer. Unless the status is good,
@@ -86,6 +182,17 @@ public:
    */
   virtual void putback(offile_off_t num);
 
+  /** checks whether the producer permits putback operations of arbitrary
+   *  length, which is always the case for a plain file.
+   *  @return always true
+   */
+  virtual OFBool isSeekable() const { return OFTrue; }
+
+  /** returns the file handle pool used by this producer
+   *  @return pointer to file handle pool, never NULL
+   */
+  DcmFileHandlePool *getPool() const { return pool_; }
+
 private:
 
   /// private unimplemented copy constructor
@@ -94,8 +201,17 @@ private:
   /// private unimplemented copy assignment operator
   DcmFileProducer& operator=(const DcmFileProducer&);
 
-  /// the file we're actually reading from
-  OFFile file_;
+  /** opens the file (i.e. obtains a handle from the pool) and
+   *  moves to the given offset
+   *  @param offset byte offset from the start of file
+   */
+  void open(offile_off_t offset);
+
+  /// the pool the file handle belongs to
+  DcmFileHandlePool *pool_;
+
+  /// the file we're actually reading from, may be NULL
+  OFFile *file_;
 
   /// status
   OFCondition status_;
@@ -118,6 +234,14 @@ public:
    */
   DcmInputFileStreamFactory(const OFFilename &filename, offile_off_t offset);
 
+  /** constructor. The streams created by this factory use handles from
+   *  the given pool.
+   *  @param pool pointer to file handle pool, must not be NULL.
+   *    Reference counter of the pool is increased by this operation.
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputFileStreamFactory(DcmFileHandlePool *pool, offile_off_t offset);
+
   /** copy constructor
    * @param arg the factory to copy
    */
@@ -173,6 +297,9 @@ private:
   /// offset in file
   offile_off_t offset_;
 
+  /// file handle pool, may be NULL
+  DcmFileHandlePool *pool_;
+
 };
 
 
@@ -188,6 +315,13 @@ public:
    */
   DcmInputFileStream(const OFFilename &filename, offile_off_t offset = 0);
 
+  /** constructor. Uses a handle from the given pool.
+   *  @param pool pointer to file handle pool, must not be NULL.
+   *    Reference counter of the pool is increased by this operation.
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputFileStream(DcmFileHandlePool *pool, offile_off_t offset = 0);
+
   /// destructor
   virtual ~DcmInputFileStream();
 
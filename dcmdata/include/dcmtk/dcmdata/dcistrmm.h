@@ -0,0 +1,365 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: DcmInputMappedFileStream and related classes,
+ *    implements streamed input from memory-mapped files.
+ *
+ */
+
+#ifndef DCISTRMM_H
+#define DCISTRMM_H
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/dcmdata/dcistrma.h"
+#include "dcmtk/ofstd/ofthread.h"
+
+/** minimum length of an attribute value (in bytes) for which a reference
+ *  into a memory-mapped file is used instead of a copy on the heap.
+ *  Shorter values are always copied since the bookkeeping would cost
+ *  more than the copy itself.
+ */
+#define DcmMappedFileMinBlockSize 4096
+
+/** class that manages the life cycle of a memory-mapped file.
+ *  The file is mapped privately ("copy-on-write"), i.e. modifications of
+ *  the mapped pages are never written back to the file but cause the
+ *  operating system to create a private copy of the affected pages.
+ *  The class maintains a thread-safe reference counter, and when this counter
+ *  is decreased to zero, unmaps the file and deletes the object itself.
+ *  Memory mapping is currently only supported on systems providing mmap().
+ */
+class DCMTK_DCMDATA_EXPORT DcmFileMapping
+{
+public:
+
+  /** static method that permits creation of instances of
+   *  this class (only) on the heap, never on the stack.
+   *  A newly created instance always has a reference counter of 1.
+   *  @param filename name of file to be mapped (may contain wide chars
+   *    if support enabled)
+   *  @param status upon return, contains the status of the operation
+   *  @return pointer to new instance if successful, NULL otherwise
+   */
+  static DcmFileMapping *newInstance(const OFFilename &filename, OFCondition &status);
+
+  /** checks whether memory-mapped file input is supported on this platform
+   *  @return OFTrue if supported, OFFalse otherwise
+   */
+  static OFBool isSupported();
+
+  /// increase reference counter for this object
+  void increaseRefCount();
+
+  /** decreases reference counter for this object and unmaps
+   *  the file and deletes this object if the reference counter becomes zero.
+   */
+  void decreaseRefCount();
+
+  /** returns pointer to the first byte of the mapped file
+   *  @return pointer to mapped file content, never NULL
+   */
+  Uint8 *data() const { return data_; }
+
+  /** returns the size of the mapped file
+   *  @return size of the mapped file in bytes
+   */
+  offile_off_t size() const { return size_; }
+
+  /** returns the name of the mapped file
+   *  @return name of the mapped file
+   */
+  const OFFilename &getFilename() const { return filename_; }
+
+private:
+
+  /** private constructor.
+   *  Instances of this class are always created through newInstance().
+   *  @param filename name of the mapped file
+   *  @param data pointer to the mapped file content
+   *  @param size size of the mapped file in bytes
+   */
+  DcmFileMapping(const OFFilename &filename, Uint8 *data, offile_off_t size);
+
+  /** private destructor. Instances of this class
+   *  are always deleted through the reference counting methods
+   */
+  virtual ~DcmFileMapping();
+
+  /// private undefined copy constructor
+  DcmFileMapping(const DcmFileMapping& arg);
+
+  /// private undefined copy assignment operator
+  DcmFileMapping& operator=(const DcmFileMapping& arg);
+
+  /** number of references to the mapping.
+   *  Default initialized to 1 upon construction of this object
+   */
+  size_t refCount_;
+
+#ifdef WITH_THREADS
+  /// mutex for MT-safe reference counting
+  /// @remark this member is only available if DCMTK is compiled with thread
+  /// support enabled.
+  OFMutex mutex_;
+#endif
+
+  /// name of the mapped file
+  OFFilename filename_;
+
+  /// pointer to the mapped file content
+  Uint8 *data_;
+
+  /// number of bytes mapped
+  offile_off_t size_;
+};
+
+
+/** producer class that reads data from a memory-mapped file.
+ *  In addition to the usual copying read operation, this producer
+ *  permits attribute values to reference the mapped pages directly.
+ */
+class DCMTK_DCMDATA_EXPORT DcmMappedFileProducer: public DcmProducer
+{
+public:
+  /** constructor. Creates a new mapping of the given file.
+   *  @param filename name of file to be mapped (may contain wide chars
+   *    if support enabled)
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmMappedFileProducer(const OFFilename &filename, offile_off_t offset = 0);
+
+  /** constructor. Uses an existing mapping.
+   *  @param mapping pointer to file mapping, must not be NULL.
+   *    Reference counter of the mapping is increased by this operation.
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmMappedFileProducer(DcmFileMapping *mapping, offile_off_t offset = 0);
+
+  /// destructor, decreases reference counter of the file mapping
+  virtual ~DcmMappedFileProducer();
+
+  /** returns the status of the producer. Unless the status is good,
+   *  the producer will not permit any operation.
+   *  @return status, true if good
+   */
+  virtual OFBool good() const;
+
+  /** returns the status of the producer as an OFCondition object.
+   *  Unless the status is good, the producer will not permit any operation.
+   *  @return status, EC_Normal if good
+   */
+  virtual OFCondition status() const;
+
+  /** returns true if the producer is at the end of stream.
+   *  @return true if end of stream, false otherwise
+   */
+  virtual OFBool eos();
+
+  /** returns the minimum number of bytes that can be read with the
+   *  next call to read(). The DcmObject read methods rely on avail
+   *  to return a value > 0 if there is no I/O suspension since certain
+   *  data such as tag and length are only read "en bloc", i.e. all
+   *  or nothing.
+   *  @return minimum of data available in producer
+   */
+  virtual offile_off_t avail();
+
+  /** reads as many bytes as possible into the given block.
+   *  @param buf pointer to memory block, must not be NULL
+   *  @param buflen length of memory block
+   *  @return number of bytes actually read.
+   */
+  virtual offile_off_t read(void *buf, offile_off_t buflen);
+
+  /** skips over the given number of bytes (or less)
+   *  @param skiplen number of bytes to skip
+   *  @return number of bytes actually skipped.
+   */
+  virtual offile_off_t skip(offile_off_t skiplen);
+
+  /** resets the stream to the position by the given number of bytes.
+   *  @param num number of bytes to putback. If the putback operation
+   *    fails, the producer status becomes bad.
+   */
+  virtual void putback(offile_off_t num);
+
+  /** returns a pointer to the next num bytes in the mapped file and
+   *  skips over them. The block remains valid as long as the reference
+   *  to the returned mapping is held.
+   *  @param num number of bytes requested
+   *  @param mapping upon success, pointer to the file mapping the block
+   *    belongs to. The reference counter is not increased by this call.
+   *  @return pointer to the block, NULL if less than num bytes are available
+   */
+  virtual Uint8 *mapBlock(offile_off_t num, DcmFileMapping *&mapping);
+
+  /** checks whether the producer permits putback operations of arbitrary
+   *  length, which is always the case for a memory-mapped file.
+   *  @return always true
+   */
+  virtual OFBool isSeekable() const { return OFTrue; }
+
+  /** returns the file mapping used by this producer
+   *  @return pointer to file mapping, may be NULL
+   */
+  DcmFileMapping *getMapping() const { return mapping_; }
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmMappedFileProducer(const DcmMappedFileProducer&);
+
+  /// private unimplemented copy assignment operator
+  DcmMappedFileProducer& operator=(const DcmMappedFileProducer&);
+
+  /** sets the current position to the given offset, or the
+   *  producer status to bad if the offset is beyond the end of file
+   *  @param offset byte offset from the start of file
+   */
+  void seek(offile_off_t offset);
+
+  /// the file mapping we're reading from
+  DcmFileMapping *mapping_;
+
+  /// status
+  OFCondition status_;
+
+  /// current read position
+  offile_off_t pos_;
+};
+
+
+/** input stream factory for memory-mapped files
+ */
+class DCMTK_DCMDATA_EXPORT DcmInputMappedFileStreamFactory: public DcmInputStreamFactory
+{
+public:
+
+  /** constructor
+   *  @param mapping pointer to file mapping, must not be NULL.
+   *    Reference counter of the mapping is increased by this operation.
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputMappedFileStreamFactory(DcmFileMapping *mapping, offile_off_t offset);
+
+  /** copy constructor
+   * @param arg the factory to copy
+   */
+  DcmInputMappedFileStreamFactory(const DcmInputMappedFileStreamFactory &arg);
+
+  /// destructor, decreases reference counter of the file mapping
+  virtual ~DcmInputMappedFileStreamFactory();
+
+  /** create a new input stream object
+   *  @return pointer to new input stream object
+   */
+  virtual DcmInputStream *create() const;
+
+  /** returns a pointer to a copy of this object
+   */
+  virtual DcmInputStreamFactory *clone() const
+  {
+    return new DcmInputMappedFileStreamFactory(*this);
+  }
+
+  /** returns an enum describing the class to which this instance belongs
+   *  @return class to which this instance belongs
+   */
+  virtual DcmInputStreamFactoryType ident() const
+  {
+    return DFT_DcmInputMappedFileStreamFactory;
+  }
+
+  /** returns name of the file
+   *  @return name of file
+   */
+  virtual OFFilename const & getFilename() const
+  {
+      return mapping_->getFilename();
+  }
+
+  /** returns offset of the data in the file
+   *  @return offset of the data in the file
+   */
+  virtual offile_off_t getOffset() const
+  {
+      return offset_;
+  }
+
+private:
+
+  /// private unimplemented copy assignment operator
+  DcmInputMappedFileStreamFactory& operator=(const DcmInputMappedFileStreamFactory&);
+
+  /// file mapping
+  DcmFileMapping *mapping_;
+
+  /// offset in file
+  offile_off_t offset_;
+
+};
+
+
+/** input stream that reads from a memory-mapped file.
+ *  Attribute values read from this stream may directly reference the
+ *  mapped file content instead of being copied into heap buffers,
+ *  see DcmElement::loadValue().
+ */
+class DCMTK_DCMDATA_EXPORT DcmInputMappedFileStream: public DcmInputStream
+{
+public:
+  /** constructor. Creates a new mapping of the given file.
+   *  @param filename name of file to be opened (may contain wide chars
+   *    if support enabled)
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputMappedFileStream(const OFFilename &filename, offile_off_t offset = 0);
+
+  /** constructor. Uses an existing mapping.
+   *  @param mapping pointer to file mapping, must not be NULL.
+   *    Reference counter of the mapping is increased by this operation.
+   *  @param offset byte offset to skip from the start of file
+   */
+  DcmInputMappedFileStream(DcmFileMapping *mapping, offile_off_t offset = 0);
+
+  /// destructor
+  virtual ~DcmInputMappedFileStream();
+
+  /** creates a new factory object for the current stream
+   *  and stream position.  When activated, the factory will be
+   *  able to create new DcmInputStream delivering the same
+   *  data as the current stream.  Used to defer loading of
+   *  value fields until accessed.
+   *  If no factory object can be created (e.g. because the
+   *  stream is not seekable), returns NULL.
+   *  @return pointer to new factory object if successful, NULL otherwise.
+   */
+  virtual DcmInputStreamFactory *newFactory() const;
+
+private:
+
+  /// private unimplemented copy constructor
+  DcmInputMappedFileStream(const DcmInputMappedFileStream&);
+
+  /// private unimplemented copy assignment operator
+  DcmInputMappedFileStream& operator=(const DcmInputMappedFileStream&);
+
+  /// the final producer of the filter chain
+  DcmMappedFileProducer producer_;
+};
+
+#endif
@@ -1563,6 +1563,25 @@ class DCMTK_DCMDATA_EXPORT DcmItem
                                   DcmStack &resultStack,         // inout
                                   OFBool searchIntoSub );        // in
 
+    /** helper function that determines the position of the given tag in elementList
+     *  by binary search. This relies on elementList being sorted by ascending tag,
+     *  which is guaranteed by insert(). Makes use of the constant time random access
+     *  provided by DcmList::seek_to(). The current position of elementList is undefined
+     *  after calling this function.
+     *  @param tag tag key to be searched
+     *  @return index of the first element in elementList whose tag is not less than
+     *    the given tag, or the number of elements if there is no such element
+     */
+    unsigned long findPosition(const DcmTagKey &tag);
+
+    /** helper function that searches elementList (non-recursively) for the element
+     *  with the given tag by binary search, see findPosition().
+     *  @param tag tag key to be searched
+     *  @return pointer to element if found (in which case it also becomes the current
+     *    element of elementList), NULL otherwise
+     */
+    DcmObject *findElement(const DcmTagKey &tag);
+
     /** helper function that interprets the given pointer as a pointer to an
      *  array of two characters and checks whether these two characters form
      *  a valid standard DICOM VR.
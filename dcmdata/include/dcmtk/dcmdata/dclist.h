@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2025, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -26,6 +26,7 @@
 
 #include "dcmtk/ofstd/ofcast.h"
 #include "dcmtk/ofstd/oftypes.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 #include "dcmtk/dcmdata/dcobject.h"
 
@@ -46,6 +47,9 @@ public:
     /// destructor
     ~DcmListNode();
 
+    /// list nodes are allocated from the active arena, if any (see DcmArena)
+    DCMTK_DCMDATA_ARENA_ALLOCATION
+
     /// return pointer to object maintained by this list node
     inline DcmObject *value() { return objNodeValue; }
 
@@ -91,6 +95,10 @@ typedef enum
 /** double-linked list class that maintains pointers to DcmObject instances.
  *  The remove operation does not delete the object pointed to, however, the
  *  destructor will delete all elements the list points to.
+ *  In order to permit random access in constant time, the list maintains an
+ *  index of all list nodes, which is created on the first call of seek_to()
+ *  that cannot be answered by moving the current position by a single step,
+ *  and which is kept up to date by all subsequent insert and remove operations.
  */
 class DCMTK_DCMDATA_EXPORT DcmList
 {
@@ -101,6 +109,9 @@ public:
     /// destructor
     ~DcmList();
 
+    /// lists are allocated from the active arena, if any (see DcmArena)
+    DCMTK_DCMDATA_ARENA_ALLOCATION
+
     /** insert object at end of list
      *  @param obj pointer to object
      *  @return pointer to object, or NULL if object cannot be inserted
@@ -140,12 +151,19 @@ public:
     DcmObject *seek(const E_ListPos pos = ELP_next);
 
     /** seek within element in list to given element index
-     *  (i.e. set current element to given index)
+     *  (i.e. set current element to given index).
+     *  Takes constant time once the node index has been created.
      *  @param absolute_position position index < card()
      *  @return pointer to new current object
      */
     DcmObject *seek_to(const unsigned long absolute_position);
 
+    /** return the index of the current element in the list
+     *  @return index of current element, DCM_EndOfListIndex if there is
+     *    no current element
+     */
+    unsigned long tell() const;
+
     /** remove and delete all elements from list. Thus, the elements' memory
      *  is also freed by this operation. The list is empty after calling this
      *  function.
@@ -179,6 +197,21 @@ private:
     /// number of elements in list
     unsigned long cardinality;
 
+    /// pointers to all nodes in list order, only used if nodeIndexValid is true
+    OFVector<DcmListNode *> nodeIndex;
+
+    /// true if nodeIndex is complete and up to date
+    OFBool nodeIndexValid;
+
+    /// creates the node index from the current content of the list
+    void buildNodeIndex();
+
+    /** inserts the given node into the node index (if present) at the given position
+     *  @param position index of the new node in the list
+     *  @param node pointer to new list node
+     */
+    void addToNodeIndex(const unsigned long position, DcmListNode *node);
+
     /// private undefined copy constructor
     DcmList &operator=(const DcmList &);
 
@@ -32,6 +32,7 @@
 #include "dcmtk/dcmdata/dcxfer.h"
 #include "dcmtk/dcmdata/dctag.h"
 #include "dcmtk/dcmdata/dcstack.h"
+#include "dcmtk/dcmdata/dcarena.h"
 
 
 // forward declarations
@@ -239,6 +240,34 @@ extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmConvertVOILUTSequenceOWtoSQ; /*
  */
 extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmUseExplLengthPixDataForEncTS; /* default OFFalse */
 
+/** This flag enables the use of memory-mapped files when loading DICOM files
+ *  with DcmFileFormat::loadFile() or DcmDataset::loadFile().  If enabled,
+ *  large binary attribute values (e.g. uncompressed Pixel Data) are not copied
+ *  into heap buffers but reference the mapped file content directly, which
+ *  reduces load time and memory consumption for read-mostly applications.
+ *  The file is mapped privately, i.e. modifying such a value in memory never
+ *  affects the file.  The file must not be truncated or overwritten while it
+ *  is mapped, i.e. as long as any loaded value references it; in particular,
+ *  the loaded object must not be saved to the same file.
+ *  If memory mapping is not supported on the current platform or the file
+ *  cannot be mapped, the file is read in the conventional way.
+ *  Default is OFFalse.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<OFBool> dcmUseMemoryMappedFileInput; /* default OFFalse */
+
+/** This value defines the maximum number of open file handles that are kept
+ *  for reuse when attribute values that were not loaded into memory during
+ *  DcmFileFormat::loadFile() or DcmDataset::loadFile() (see parameter
+ *  maxReadLength) are accessed later, e.g. using getPartialValue().  The
+ *  handles are shared by all such values of a loaded file and remain open as
+ *  long as any of these values exists, so that subsequent accesses only need
+ *  to seek instead of opening the file again.  Applications that keep many
+ *  loaded objects at the same time should consider the per-process limit of
+ *  open files.  A value of 0 closes the file after each access.
+ *  Default is 0.
+ */
+extern DCMTK_DCMDATA_EXPORT OFGlobal<Uint32> dcmFileHandlePoolSize; /* default 0 */
+
 /** Abstract base class for most classes in module dcmdata. As a rule of thumb,
  *  everything that is either a dataset or that can be identified with a DICOM
  *  attribute tag is derived from class DcmObject.
@@ -262,6 +291,9 @@ class DCMTK_DCMDATA_EXPORT DcmObject
     /// destructor
     virtual ~DcmObject();
 
+    /// objects are allocated from the active arena, if any (see DcmArena)
+    DCMTK_DCMDATA_ARENA_ALLOCATION
+
     /** clone method
      *  @return deep copy of this object
      */
@@ -745,6 +777,18 @@ class DCMTK_DCMDATA_EXPORT DcmObject
                                           const E_TransferSyntax oxfer, // in
                                           Uint32 &writtenBytes) const;  // out
 
+    /** encode tag, VR and length field into the given buffer, as written by
+     *  writeTagAndLength(). Derived classes that need a different encoding
+     *  should override this method rather than writeTagAndLength().
+     *  @param buffer buffer of at least DCM_TagInfoLength bytes
+     *  @param oxfer transfer syntax for encoding
+     *  @param encodedBytes number of bytes stored in the buffer returned in this parameter
+     *  @return EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition encodeTagAndLength(Uint8 *buffer,
+                                           const E_TransferSyntax oxfer,
+                                           Uint32 &encodedBytes) const;
+
     /** return the number of bytes needed to serialize the
      *  tag, VR and length information of the current object using the given
      *  transfer syntax.
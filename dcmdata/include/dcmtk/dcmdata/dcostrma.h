@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2011, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,18 @@
 #include "dcmtk/dcmdata/dcxfer.h"   /* for E_StreamCompression */
 #include "dcmtk/ofstd/offile.h"   /* for offile_off_t */
 
+/** descriptor of a memory block that is part of a gathered write operation,
+ *  see DcmConsumer::writeBlocks() and DcmOutputStream::writeBlocks().
+ */
+struct DcmOutputBlock
+{
+  /// pointer to the memory block, must not be NULL unless length is 0
+  const void *data;
+
+  /// length of the memory block in bytes
+  offile_off_t length;
+};
+
 /** pure virtual abstract base class for consumers, i.e. the final node
  *  of a filter chain in an output stream.
  */
@@ -75,6 +87,19 @@ public:
    */
   virtual offile_off_t write(const void *buf, offile_off_t buflen) = 0;
 
+  /** processes as many bytes as possible from the given list of memory
+   *  blocks, in the given order ("gather" write). The blocks are processed
+   *  as if they formed one contiguous block, i.e. a block is only started
+   *  after the previous one has been processed completely.
+   *  The default implementation calls write() for each block, consumers
+   *  that can hand multiple blocks to the operating system at once (such
+   *  as DcmFileConsumer) should override this method.
+   *  @param blocks array of memory block descriptors, must not be NULL
+   *  @param numBlocks number of entries in the array
+   *  @return number of bytes actually processed.
+   */
+  virtual offile_off_t writeBlocks(const DcmOutputBlock *blocks, size_t numBlocks);
+
   /** instructs the consumer to flush its internal content until
    *  either the consumer becomes "flushed" or I/O suspension occurs.
    *  After a call to flush(), a call to write() will produce undefined
@@ -151,6 +176,16 @@ public:
    */
   virtual offile_off_t write(const void *buf, offile_off_t buflen);
 
+  /** processes as many bytes as possible from the given list of memory
+   *  blocks, in the given order ("gather" write). This permits, for example,
+   *  the header and the value of an element to be written without copying
+   *  them into a common buffer first.
+   *  @param blocks array of memory block descriptors, must not be NULL
+   *  @param numBlocks number of entries in the array
+   *  @return number of bytes actually processed.
+   */
+  virtual offile_off_t writeBlocks(const DcmOutputBlock *blocks, size_t numBlocks);
+
   /** instructs the stream to flush its internal content until
    *  either the stream becomes "flushed" or I/O suspension occurs.
    *  After a call to flush(), a call to write() will produce undefined
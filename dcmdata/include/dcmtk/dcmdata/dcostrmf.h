@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2024, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,18 @@
 
 class OFFile;
 
+/** size of the stdio buffer used for files opened by DcmFileConsumer, in bytes.
+ *  A large buffer reduces the number of system calls needed for writing the
+ *  many small elements (and element headers) of a typical dataset.
+ */
+#define DcmFileConsumerBufferSize 262144
+
+/** minimum total size of the memory blocks passed to
+ *  DcmFileConsumer::writeBlocks() that are written with a single call to
+ *  writev() instead of being copied into the stdio buffer, in bytes
+ */
+#define DcmFileConsumerGatherThreshold 65536
+
 /** consumer class that stores data in a plain file.
  */
 class DCMTK_DCMDATA_EXPORT DcmFileConsumer: public DcmConsumer
@@ -89,6 +101,17 @@ public:
    */
   virtual offile_off_t write(const void *buf, offile_off_t buflen);
 
+  /** processes as many bytes as possible from the given list of memory
+   *  blocks, in the given order. If the total size of the blocks is large
+   *  (see DcmFileConsumerGatherThreshold) and the system supports writev(),
+   *  the blocks are passed to the operating system at once, bypassing the
+   *  stdio buffer. Otherwise, write() is called for each block.
+   *  @param blocks array of memory block descriptors, must not be NULL
+   *  @param numBlocks number of entries in the array
+   *  @return number of bytes actually processed.
+   */
+  virtual offile_off_t writeBlocks(const DcmOutputBlock *blocks, size_t numBlocks);
+
   /** instructs the consumer to flush its internal content until
    *  either the consumer becomes "flushed" or I/O suspension occurs.
    *  After a call to flush(), a call to write() will produce undefined
@@ -116,6 +139,9 @@ private:
   /// Points to file_container_ in most, but not all cases
   OFFile& file_;
 
+  /// stdio buffer for files opened by this object, NULL otherwise
+  char *buffer_;
+
   /// status
   OFCondition status_;
 };
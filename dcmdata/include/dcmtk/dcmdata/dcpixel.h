@@ -688,6 +688,44 @@ public:
         OFString& decompressedColorModel,
         DcmFileCache *cache=NULL);
 
+    /** access a range of consecutive frames without decompressing or loading a
+     *  complete multi-frame object. The frames are copied into the buffer passed
+     *  by the caller, one after the other. If the pixel data is compressed and
+     *  more than one thread is requested, the frames are decompressed concurrently
+     *  by a pool of worker threads, each of which decodes a complete frame from a
+     *  private copy of its compressed fragments. This requires that the first
+     *  fragment of each frame can be determined, i.e. that there is either one
+     *  fragment per frame or a valid basic offset table. Otherwise, and if DCMTK
+     *  is compiled without thread support, the frames are decompressed one after
+     *  the other on the calling thread, as with getUncompressedFrame().
+     *  @param dataset pointer to DICOM dataset in which this pixel data object is
+     *    located. Used to access rows, columns, samples per pixel etc.
+     *  @param firstFrame number of the first frame to be accessed, starting with 0
+     *  @param numFrames number of frames to be accessed, must not be 0
+     *  @param buffer pointer to buffer allocated by the caller. The buffer must be
+     *    large enough for numFrames * bufSize bytes. Frame number firstFrame + i
+     *    is stored at byte offset i * bufSize, in the same format that is also
+     *    produced by getUncompressedFrame().
+     *  @param bufSize size of the buffer for a single frame, in bytes. This number
+     *    must be even so that the data can properly be converted to a different
+     *    endianness.
+     *  @param decompressedColorModel upon successful return, the color model
+     *    of the decompressed image (which may be different from the one used
+     *    in the compressed images) is returned in this parameter.
+     *  @param numThreads maximum number of threads used for decompression.
+     *    A value of 0 or 1 disables concurrent decompression.
+     *  @return EC_Normal if successful, an error code otherwise. In case of an
+     *    error, the content of the buffer is undefined.
+     */
+    virtual OFCondition getUncompressedFrames(
+        DcmItem *dataset,
+        Uint32 firstFrame,
+        Uint32 numFrames,
+        void *buffer,
+        Uint32 bufSize,
+        OFString& decompressedColorModel,
+        Uint32 numThreads);
+
     /** determine color model of the decompressed image
      *  @param dataset pointer to DICOM dataset in which this pixel data object
      *    is located. Used to access photometric interpretation.
@@ -156,15 +156,16 @@ class DCMTK_DCMDATA_EXPORT DcmPixelItem : public DcmOtherByteOtherWord
 
   protected:
 
-    /** write tag, VR and length field to the given output stream
-     *  @param outStream output stream
-     *  @param oxfer transfer syntax for writing
-     *  @param writtenBytes number of bytes written to stream returned in this parameter
+    /** encode tag and length field into the given buffer. Pixel items
+     *  never have a VR field.
+     *  @param buffer buffer of at least DCM_TagInfoLength bytes
+     *  @param oxfer transfer syntax for encoding
+     *  @param encodedBytes number of bytes stored in the buffer returned in this parameter
      *  @return EC_Normal if successful, an error code otherwise
      */
-    virtual OFCondition writeTagAndLength(DcmOutputStream &outStream,
-                                          const E_TransferSyntax oxfer,
-                                          Uint32 &writtenBytes) const;
+    virtual OFCondition encodeTagAndLength(Uint8 *buffer,
+                                           const E_TransferSyntax oxfer,
+                                           Uint32 &encodedBytes) const;
 
 };
 
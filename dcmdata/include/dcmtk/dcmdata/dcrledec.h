@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2011, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -24,6 +24,7 @@
 
 #include "dcmtk/config/osconfig.h"
 #include "dcmtk/dcmdata/dcerror.h"
+#include <cstring>
 
 /** this class implements an RLE decompressor conforming to the DICOM standard.
  *  The class is loosely based on an implementation by Phil Norman <forrey@eh.org>
@@ -210,7 +211,8 @@ private:
        nbytes = OFstatic_cast(unsigned char, outputBufferSize_ - offset_);
      }
 
-     while (nbytes--) outputBuffer_[offset_++] = ch;
+     memset(outputBuffer_ + offset_, ch, nbytes);
+     offset_ += nbytes;
   }
 
 
@@ -227,7 +229,8 @@ private:
        nbytes = OFstatic_cast(unsigned char, outputBufferSize_ - offset_);
      }
 
-     while (nbytes--) outputBuffer_[offset_++] = *cp++;
+     memcpy(outputBuffer_ + offset_, cp, nbytes);
+     offset_ += nbytes;
   }
 
   /* member variables */
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2024, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -172,9 +172,21 @@ public:
    */
   inline void add(const unsigned char *buf, size_t bufcount)
   {
-    if (buf)
+    if (buf && (! fail_))
     {
-      while (bufcount--) add(*buf++);
+      const unsigned char *end = buf + bufcount;
+      while (buf < end)
+      {
+        // determine the length of the run of identical bytes starting here.
+        // Adding the first byte of the run is handled by add(), each further
+        // byte would only increase the repeat counter
+        const unsigned char ch = *buf;
+        const unsigned char *next = buf + 1;
+        while ((next < end) && (*next == ch)) ++next;
+        add(ch);
+        RLE_pcount_ += OFstatic_cast(int, next - buf - 1);
+        buf = next;
+      }
     }
   }
 
@@ -351,7 +363,12 @@ private:
           break;    // exit while loop
         }
       }
-      currentBlock_[offset_++] = RLE_buff_[i++];
+      // copy as many bytes as fit into the current block
+      size_t count = numberOfBytes - i;
+      if (count > DcmRLEEncoder_BLOCKSIZE - offset_) count = DcmRLEEncoder_BLOCKSIZE - offset_;
+      memcpy(currentBlock_ + offset_, RLE_buff_ + i, count);
+      offset_ += count;
+      i += count;
     }
   }
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2022, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -51,6 +51,40 @@ DCMTK_DCMDATA_EXPORT void swapBytes(
   const Uint32 byteLength,
   const size_t valWidth);
 
+/** copy block of data and swap it from big-endian to little-endian or back
+ *  if necessary. If no swapping is needed, the data is copied unchanged.
+ *  @param newByteOrder desired byte order of data block
+ *  @param oldByteOrder current byte order of data block
+ *  @param source pointer to block of data to be copied
+ *  @param target pointer to buffer receiving the data, may be identical to
+ *    source (in-place swapping) but shall not overlap with it otherwise
+ *  @param byteLength size of data block in bytes
+ *  @param valWidth size of each value in the data block, in bytes
+ *  @return EC_Normal if successful, an error code otherwise
+ */
+DCMTK_DCMDATA_EXPORT OFCondition swapIfNecessary(
+  const E_ByteOrder newByteOrder,
+  const E_ByteOrder oldByteOrder,
+  const void * source,
+  void * target,
+  const Uint32 byteLength,
+  const size_t valWidth);
+
+/** copy block of data and swap it from big-endian to little-endian or back.
+ *  Bytes of a trailing value that is only partially contained in the block
+ *  are copied unchanged.
+ *  @param source pointer to block of data to be swapped
+ *  @param target pointer to buffer receiving the swapped data, may be
+ *    identical to source but shall not overlap with it otherwise
+ *  @param byteLength size of data block in bytes
+ *  @param valWidth size of each value in the data block, in bytes
+ */
+DCMTK_DCMDATA_EXPORT void swapBytes(
+  const void * source,
+  void * target,
+  const Uint32 byteLength,
+  const size_t valWidth);
+
 /** swap an Uint16 number from big-endian to little-endian or back
  *  @param toSwap number to be swapped
  *  @return swapped number
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2007-2011, OFFIS e.V.
+ *  Copyright (C) 2007-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -31,14 +31,19 @@
 class DcmElement;
 class DcmOutputStream;
 
-#define DcmWriteCacheBufsize 65536    /* buffer size, in bytes */
+#define DcmWriteCacheBufsize 65536       /* minimum buffer size, in bytes */
+#define DcmWriteCacheMaxBufsize 1048576  /* maximum buffer size, in bytes */
 
 /** This class implements a buffering mechanism that is used when writing large
  *  elements that reside in file into an output stream. DcmElement::getPartialValue
  *  is used to fill the buffer maintained by this class, and the buffer content
  *  is then copied to the output stream. The intermediate buffer is necessary
  *  because both DcmElement::getPartialValue and DcmOutputStream::write expect
- *  a buffer to write to and read from, respectively.
+ *  a buffer to write to and read from, respectively. Elements whose value
+ *  resides in memory are written directly and do not use this class.
+ *  The buffer grows with the size of the elements (between DcmWriteCacheBufsize
+ *  and DcmWriteCacheMaxBufsize bytes), so that large values are read from file
+ *  in a few large blocks.
  */
 class DCMTK_DCMDATA_EXPORT DcmWriteCache
 {
@@ -0,0 +1,241 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: DcmArena and DcmArenaScope,
+ *    block allocation of DICOM object trees
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+#include "dcmtk/dcmdata/dcarena.h"
+
+
+/* header stored in front of each object allocated with allocateObject(),
+ * identifies the arena the object belongs to (NULL for heap allocations).
+ * The double member makes sure that the object itself is properly aligned.
+ */
+union DcmArenaObjectHeader
+{
+  DcmArena *arena;
+  double alignment;
+};
+
+/* alignment of the memory returned by DcmArena::allocate() */
+#define DCMARENA_ALIGNMENT sizeof(DcmArenaObjectHeader)
+
+
+/* ======================================================================= */
+
+#if defined(WITH_THREADS) && defined(HAVE_CXX11)
+
+/* the arena that is active in the current thread */
+static thread_local DcmArena *currentArena = NULL;
+
+DcmArena *DcmArena::current()
+{
+  return currentArena;
+}
+
+void DcmArena::setCurrent(DcmArena *arena)
+{
+  currentArena = arena;
+}
+
+#elif defined(WITH_THREADS)
+
+/* returns the key for the arena that is active in the current thread */
+static OFThreadSpecificData& currentArenaKey()
+{
+  static OFThreadSpecificData key;
+  return key;
+}
+
+DcmArena *DcmArena::current()
+{
+  void *arena = NULL;
+  if (currentArenaKey().get(arena) != 0) return NULL;
+  return OFstatic_cast(DcmArena *, arena);
+}
+
+void DcmArena::setCurrent(DcmArena *arena)
+{
+  currentArenaKey().set(arena);
+}
+
+#else
+
+/* the arena that is active (single-threaded case) */
+static DcmArena *currentArena = NULL;
+
+DcmArena *DcmArena::current()
+{
+  return currentArena;
+}
+
+void DcmArena::setCurrent(DcmArena *arena)
+{
+  currentArena = arena;
+}
+
+#endif
+
+
+/* ======================================================================= */
+
+DcmArena::DcmArena(size_t blockSize)
+: refCount_(1)
+#if defined(WITH_THREADS) && !defined(HAVE_CXX11)
+, mutex_()
+#endif
+, blockSize_(blockSize)
+, blocks_()
+, next_(NULL)
+, end_(NULL)
+, blockBytes_(0)
+{
+}
+
+DcmArena::~DcmArena()
+{
+  for (size_t i = 0; i < blocks_.size(); ++i)
+    delete[] blocks_[i];
+}
+
+DcmArena *DcmArena::newInstance(size_t blockSize)
+{
+  return new DcmArena(blockSize);
+}
+
+void DcmArena::increaseRefCount()
+{
+#ifdef HAVE_CXX11
+  refCount_.fetch_add(1, std::memory_order_relaxed);
+#else
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  ++refCount_;
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+#endif
+}
+
+void DcmArena::decreaseRefCount()
+{
+#ifdef HAVE_CXX11
+  const size_t result = refCount_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+#else
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  const size_t result = --refCount_;
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+#endif
+  if (result == 0) delete this;
+}
+
+void *DcmArena::allocate(size_t size)
+{
+  // round up to the next multiple of the alignment
+  size = (size + DCMARENA_ALIGNMENT - 1) & ~(DCMARENA_ALIGNMENT - 1);
+  if (OFstatic_cast(size_t, end_ - next_) < size)
+  {
+    // large requests get a block of their own, so that the remaining
+    // space in the current block can still be used
+    if (size > blockSize_ / 4)
+    {
+      Uint8 *block = new Uint8[size];
+      blocks_.push_back(block);
+      blockBytes_ += size;
+      return block;
+    }
+    next_ = new Uint8[blockSize_];
+    end_ = next_ + blockSize_;
+    blocks_.push_back(next_);
+    blockBytes_ += blockSize_;
+  }
+  void *result = next_;
+  next_ += size;
+  return result;
+}
+
+void *DcmArena::allocateObject(size_t size, OFBool nothrow)
+{
+  DcmArena *arena = current();
+  DcmArenaObjectHeader *header;
+  if (arena)
+  {
+    if (nothrow)
+    {
+      try
+      {
+        header = OFstatic_cast(DcmArenaObjectHeader *, arena->allocate(sizeof(DcmArenaObjectHeader) + size));
+      }
+      catch (const std::bad_alloc &)
+      {
+        return NULL;
+      }
+    }
+    else
+      header = OFstatic_cast(DcmArenaObjectHeader *, arena->allocate(sizeof(DcmArenaObjectHeader) + size));
+    arena->increaseRefCount();
+  }
+  else
+  {
+    if (nothrow)
+    {
+      header = OFstatic_cast(DcmArenaObjectHeader *, ::operator new(sizeof(DcmArenaObjectHeader) + size, std::nothrow));
+      if (header == NULL) return NULL;
+    }
+    else
+      header = OFstatic_cast(DcmArenaObjectHeader *, ::operator new(sizeof(DcmArenaObjectHeader) + size));
+  }
+  header->arena = arena;
+  return header + 1;
+}
+
+void DcmArena::releaseObject(void *ptr)
+{
+  if (ptr)
+  {
+    DcmArenaObjectHeader *header = OFstatic_cast(DcmArenaObjectHeader *, ptr) - 1;
+    if (header->arena)
+      header->arena->decreaseRefCount();
+    else
+      ::operator delete(header);
+  }
+}
+
+
+/* ======================================================================= */
+
+DcmArenaScope::DcmArenaScope(DcmArena *arena)
+: arena_(arena)
+, previous_(DcmArena::current())
+{
+  if (arena_) arena_->increaseRefCount();
+  DcmArena::setCurrent(arena_);
+}
+
+DcmArenaScope::~DcmArenaScope()
+{
+  DcmArena::setCurrent(previous_);
+  if (arena_) arena_->decreaseRefCount();
+}
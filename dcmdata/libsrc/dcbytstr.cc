@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2025, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -643,7 +643,7 @@ Uint8 *DcmByteString::newValueField()
         // we want to use a non-throwing new here if available.
         // If the allocation fails, we report an EC_MemoryExhausted error
         // back to the caller.
-        value = new (std::nothrow) Uint8[lengthField + 2];
+        value = allocateValueField(OFstatic_cast(size_t, lengthField) + 2);
 
         /* terminate string after real length */
         if (value != NULL)
@@ -665,7 +665,7 @@ Uint8 *DcmByteString::newValueField()
         // we want to use a non-throwing new here if available.
         // If the allocation fails, we report an EC_MemoryExhausted error
         // back to the caller.
-        value = new (std::nothrow) Uint8[lengthField + 1];
+        value = allocateValueField(OFstatic_cast(size_t, lengthField) + 1);
     }
     /* make sure that the string is properly terminated by a 0 byte */
     if (value != NULL)
@@ -34,6 +34,7 @@
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/dcmdata/dcistrma.h"    /* for class DcmInputStream */
 #include "dcmtk/dcmdata/dcistrmf.h"    /* for class DcmInputFileStream */
+#include "dcmtk/dcmdata/dcistrmm.h"    /* for class DcmInputMappedFileStream */
 #include "dcmtk/dcmdata/dcistrms.h"    /* for class DcmStdinStream */
 #include "dcmtk/dcmdata/dcostrma.h"    /* for class DcmOutputStream */
 #include "dcmtk/dcmdata/dcostrmf.h"    /* for class DcmOutputFileStream */
@@ -671,14 +672,25 @@ OFCondition DcmDataset::loadFileUntilTag(const OFFilename &fileName,
             }
 
         } else {
-            /* open file for input */
-            DcmInputFileStream fileStream(fileName);
+            /* open file for input, use a memory-mapped file if requested and possible */
+            DcmInputStream *fileStream = NULL;
+            if (dcmUseMemoryMappedFileInput.get() && DcmFileMapping::isSupported())
+            {
+                fileStream = new DcmInputMappedFileStream(fileName);
+                if (fileStream->status().bad())
+                {
+                    delete fileStream;
+                    fileStream = NULL;
+                }
+            }
+            if (fileStream == NULL)
+                fileStream = new DcmInputFileStream(fileName);
             /* apply configured nesting depth limit */
             if (getMaxNestingDepth() > 0)
-                fileStream.setMaxNestingDepth(getMaxNestingDepth());
+                fileStream->setMaxNestingDepth(getMaxNestingDepth());
 
             /* check stream status */
-            l_error = fileStream.status();
+            l_error = fileStream->status();
 
             if (l_error.good())
             {
@@ -688,11 +700,11 @@ OFCondition DcmDataset::loadFileUntilTag(const OFFilename &fileName,
                 {
                     /* read data from file */
                     transferInit();
-                    l_error = readUntilTag(fileStream, readXfer, groupLength, maxReadLength, stopParsingAtElement);
+                    l_error = readUntilTag(*fileStream, readXfer, groupLength, maxReadLength, stopParsingAtElement);
                     transferEnd();
                 }
             }
-
+            delete fileStream;
         }
     }
     return l_error;
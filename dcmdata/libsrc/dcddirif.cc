@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2025, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -38,6 +38,8 @@
 #include "dcmtk/ofstd/ofstream.h"
 #include "dcmtk/ofstd/ofbmanip.h"     /* for class OFBitmanipTemplate */
 #include "dcmtk/ofstd/ofcast.h"
+#include "dcmtk/ofstd/ofthread.h"     /* for class OFThread */
+#include "dcmtk/ofstd/ofvector.h"
 
 
 /*-------------------------*
@@ -1181,6 +1183,7 @@ DicomDirInterface::DicomDirInterface()
     ConsistencyCheck(OFTrue),
     IconImageMode(OFFalse),
     FilesetUpdateMode(OFFalse),
+    IncrementalWriteMode(OFFalse),
     BackupFilename(),
     BackupCreated(OFFalse),
     IconSize(64),
@@ -1195,7 +1198,9 @@ DicomDirInterface::DicomDirInterface()
     AutoInstanceNumber(1),
     AutoOverlayNumber(1),
     AutoLutNumber(1),
-    AutoCurveNumber(1)
+    AutoCurveNumber(1),
+    PreparedIconPixel(NULL),
+    PreparedIconSize(0)
 {
     /* check whether (possibly required) RLE/JPEG/JP2K decoders are registered */
     RLESupport  = DcmCodecList::canChangeCoding(EXS_RLELossless, EXS_LittleEndianExplicit);
@@ -1418,7 +1423,10 @@ OFCondition DicomDirInterface::writeDicomDir(const E_EncodingType encodingType,
     {
         DCMDATA_INFO("writing file: " << DicomDir->getDirFileName());
         /* write DICOMDIR as Little Endian Explicit as required by the standard */
-        result = DicomDir->write(DICOMDIR_DEFAULT_TRANSFERSYNTAX, encodingType, groupLength);
+        if (IncrementalWriteMode)
+            result = DicomDir->writeIncremental(encodingType, groupLength);
+        else
+            result = DicomDir->write(DICOMDIR_DEFAULT_TRANSFERSYNTAX, encodingType, groupLength);
         /* delete backup copy in case the new file could be written without any errors */
         if (result.good())
             deleteDicomDirBackup();
@@ -4340,10 +4348,9 @@ DcmDirectoryRecord *DicomDirInterface::buildImageRecord(DcmDirectoryRecord *reco
         if (record->error().good())
         {
             DcmDataset *dataset = fileformat->getDataset();
-            OFBool iconImage = IconImageMode;
-            unsigned int iconSize = (IconSize == 0) ? 64 : IconSize;
             /* Icon Image Sequence required for particular profiles */
             OFBool iconRequired = OFFalse;
+            const unsigned int iconSize = getIconImageSize(iconRequired);
             /* copy attribute values from dataset to image record */
             copyElementType1(dataset, DCM_InstanceNumber, record, sourceFilename);
             /* application profile specific attributes */
@@ -4406,10 +4413,6 @@ DcmDirectoryRecord *DicomDirInterface::buildImageRecord(DcmDirectoryRecord *reco
                         }
                         /* additional type 2 keys specified by specific profiles (type 3 in image IOD) */
                         copyStringWithDefault(dataset, DCM_CalibrationImage, record, sourceFilename);
-                        /* icon images */
-                        iconImage = OFTrue;
-                        iconRequired = OFTrue;
-                        iconSize = 128;
                     }
                     break;
                 case AP_CTandMR:
@@ -4420,16 +4423,14 @@ DcmDirectoryRecord *DicomDirInterface::buildImageRecord(DcmDirectoryRecord *reco
                     copyElementType1C(dataset, DCM_ImageOrientationPatient, record, sourceFilename);
                     copyElementType1C(dataset, DCM_FrameOfReferenceUID, record, sourceFilename);
                     copyElementType1C(dataset, DCM_PixelSpacing, record, sourceFilename);
-                    /* icon images */
-                    iconImage = OFTrue;
-                    iconSize = 64;
                     break;
                 default:
                     /* no additional keys */
                     break;
             }
-            /* create icon images */
-            if (iconImage)
+            /* create icon images (icons are required for cardiac profiles, 128 x 128 pixels, */
+            /* and always created for the CT/MR profile, see getIconImageSize()) */
+            if (iconSize > 0)
             {
                 OFCondition status = addIconImage(record, dataset, iconSize, sourceFilename);
                 if (status.bad())
@@ -4562,6 +4563,63 @@ OFBool DicomDirInterface::getIconFromDataset(DcmItem *dataset,
 }
 
 
+// determine whether and in which resolution icon images are created for image records
+unsigned int DicomDirInterface::getIconImageSize(OFBool &required) const
+{
+    required = OFFalse;
+    switch (ApplicationProfile)
+    {
+        case AP_XrayAngiographic:
+        case AP_XrayAngiographicDVD:
+        case AP_BasicCardiac:
+            /* icon images required, fixed size */
+            required = OFTrue;
+            return 128;
+        case AP_CTandMR:
+            /* icon images always created, fixed size */
+            return 64;
+        default:
+            /* icon images only created on request */
+            if (IconImageMode)
+                return (IconSize == 0) ? 64 : IconSize;
+            break;
+    }
+    return 0;
+}
+
+
+// create pixel data of icon image from external PGM file or DICOM dataset
+void DicomDirInterface::createIconPixelData(DcmItem *dataset,
+                                            const unsigned int size,
+                                            const OFFilename &sourceFilename,
+                                            Uint8 *pixel)
+{
+    const unsigned int width = size;
+    const unsigned int height = size;
+    const unsigned long count = width * height;
+    OFBool iconOk = OFFalse;
+    /* prefix for external icons specified? */
+    if (!IconPrefix.isEmpty())
+    {
+        /* try to load external pgm icon */
+        OFFilename filename;
+        OFStandard::appendFilenameExtension(filename, IconPrefix, sourceFilename);
+        iconOk = getIconFromFile(filename, pixel, count, width, height);
+    } else {
+        /* try to create icon from dataset */
+        iconOk = getIconFromDataset(dataset, pixel, count, width, height);
+        if (!iconOk)
+            DCMDATA_WARN("cannot create monochrome icon from image file, using default");
+    }
+    /* could not create icon so far: use default icon (if specified) */
+    if (!iconOk && !DefaultIcon.isEmpty())
+        iconOk = getIconFromFile(DefaultIcon, pixel, count, width, height);
+    /* default not available: use black image */
+    if (!iconOk)
+        OFBitmanipTemplate<Uint8>::zeroMem(pixel, count);
+}
+
+
 // add icon image sequence to record
 OFCondition DicomDirInterface::addIconImage(DcmDirectoryRecord *record,
                                             DcmItem *dataset,
@@ -4590,35 +4648,22 @@ OFCondition DicomDirInterface::addIconImage(DcmDirectoryRecord *record,
             ditem->putAndInsertUint16(DCM_HighBit, 7);
             ditem->putAndInsertUint16(DCM_PixelRepresentation, 0);
             /* Pixel Data */
-            Uint8 *pixel = new Uint8[count];
-            if (pixel != NULL)
+            if ((PreparedIconPixel != NULL) && (PreparedIconSize == size))
             {
-                OFBool iconOk = OFFalse;
-                /* prefix for external icons specified? */
-                if (!IconPrefix.isEmpty())
+                /* use icon image created in advance (see addDicomFiles) */
+                result = ditem->putAndInsertUint8Array(DCM_PixelData, PreparedIconPixel, count);
+            } else {
+                Uint8 *pixel = new Uint8[count];
+                if (pixel != NULL)
                 {
-                    /* try to load external pgm icon */
-                    OFFilename filename;
-                    OFStandard::appendFilenameExtension(filename, IconPrefix, sourceFilename);
-                    iconOk = getIconFromFile(filename, pixel, count, width, height);
-                } else {
-                    /* try to create icon from dataset */
-                    iconOk = getIconFromDataset(dataset, pixel, count, width, height);
-                    if (!iconOk)
-                        DCMDATA_WARN("cannot create monochrome icon from image file, using default");
-                }
-                /* could not create icon so far: use default icon (if specified) */
-                if (!iconOk && !DefaultIcon.isEmpty())
-                    iconOk = getIconFromFile(DefaultIcon, pixel, count, width, height);
-                /* default not available: use black image */
-                if (!iconOk)
-                    OFBitmanipTemplate<Uint8>::zeroMem(pixel, count);
-                /* create Pixel Data element and set pixel data */
-                result = ditem->putAndInsertUint8Array(DCM_PixelData, pixel, count);
-                /* free pixel data after it has been copied */
-                delete[] pixel;
-            } else
-                result = EC_MemoryExhausted;
+                    createIconPixelData(dataset, size, sourceFilename, pixel);
+                    /* create Pixel Data element and set pixel data */
+                    result = ditem->putAndInsertUint8Array(DCM_PixelData, pixel, count);
+                    /* free pixel data after it has been copied */
+                    delete[] pixel;
+                } else
+                    result = EC_MemoryExhausted;
+            }
             /* remove entire icon image sequence in case of error */
             if (result.bad())
                 record->findAndDeleteElement(DCM_IconImageSequence);
@@ -4975,97 +5020,444 @@ OFCondition DicomDirInterface::addDicomFile(const OFFilename &filename,
     /* first, make sure that a DICOMDIR object exists */
     if (DicomDir != NULL)
     {
-        /* create fully qualified pathname of the DICOM file to be added */
-        OFFilename pathname;
-        OFStandard::combineDirAndFilename(pathname, directory, filename, OFTrue /*allowEmptyDirName*/);
         /* then check the file name, load the file and check the content */
         DcmFileFormat fileformat;
         result = loadAndCheckDicomFile(filename, directory, fileformat, OFTrue /*checkFilename*/);
+        /* finally, add the directory records */
         if (result.good())
+            result = addDicomFileRecords(filename, directory, fileformat);
+    }
+    return result;
+}
+
+
+// load and check DICOM file, create icon image in advance (if required)
+OFCondition DicomDirInterface::prepareDicomFile(const OFFilename &filename,
+                                                const OFFilename &directory,
+                                                DcmFileFormat &fileformat,
+                                                Uint8 *&iconPixel,
+                                                unsigned int &iconSize)
+{
+    iconPixel = NULL;
+    iconSize = 0;
+    OFCondition result = loadAndCheckDicomFile(filename, directory, fileformat, OFTrue /*checkFilename*/);
+    if (result.good())
+    {
+        OFBool iconRequired = OFFalse;
+        const unsigned int size = getIconImageSize(iconRequired);
+        /* icon images are only added to image records (see buildImageRecord) */
+        OFString sopClass;
+        fileformat.getMetaInfo()->findAndGetOFString(DCM_MediaStorageSOPClassUID, sopClass);
+        if ((size > 0) && (sopClassToRecordType(sopClass) == ERT_Image))
         {
-            DCMDATA_INFO("adding file: " << pathname);
-            /* start creating the DICOMDIR directory structure */
-            DcmDirectoryRecord *rootRecord = &(DicomDir->getRootRecord());
-            DcmMetaInfo *metainfo = fileformat.getMetaInfo();
-            /* massage filename into DICOM format (DOS conventions for path separators, uppercase) */
-            OFString fileID;
-            hostToDicomFilename(OFSTRING_GUARD(filename.getCharPointer()), fileID);
-            /* what kind of object (SOP Class) is stored in the file */
-            OFString sopClass;
-            metainfo->findAndGetOFString(DCM_MediaStorageSOPClassUID, sopClass);
-            /* if hanging protocol, palette or implant file then attach it to the root record and stop */
-            if (compare(sopClass, UID_HangingProtocolStorage))
-            {
-                /* add a hanging protocol record below the root */
-                if (addRecord(rootRecord, ERT_HangingProtocol, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            }
-            else if (compare(sopClass, UID_ColorPaletteStorage))
-            {
-                /* add a palette record below the root */
-                if (addRecord(rootRecord, ERT_Palette, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            }
-            else if (compare(sopClass, UID_GenericImplantTemplateStorage))
+            iconPixel = new (std::nothrow) Uint8[size * size];
+            if (iconPixel != NULL)
             {
-                /* add an implant record below the root */
-                if (addRecord(rootRecord, ERT_Implant, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
+                OFFilename pathname;
+                OFStandard::combineDirAndFilename(pathname, directory, filename, OFTrue /*allowEmptyDirName*/);
+                createIconPixelData(fileformat.getDataset(), size, pathname, iconPixel);
+                iconSize = size;
             }
-            else if (compare(sopClass, UID_ImplantAssemblyTemplateStorage))
-            {
-                /* add an implant group record below the root */
-                if (addRecord(rootRecord, ERT_ImplantGroup, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            }
-            else if (compare(sopClass, UID_ImplantTemplateGroupStorage))
-            {
-                /* add an implant assy record below the root */
-                if (addRecord(rootRecord, ERT_ImplantAssy, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            }
-            else if (compare(sopClass, UID_InventoryStorage))
+        }
+    }
+    return result;
+}
+
+
+// add directory records for a loaded and checked DICOM file
+OFCondition DicomDirInterface::addDicomFileRecords(const OFFilename &filename,
+                                                   const OFFilename &directory,
+                                                   DcmFileFormat &fileformat)
+{
+    OFCondition result = EC_IllegalParameter;
+    /* first, make sure that a DICOMDIR object exists */
+    if (DicomDir != NULL)
+    {
+        /* create fully qualified pathname of the DICOM file to be added */
+        OFFilename pathname;
+        OFStandard::combineDirAndFilename(pathname, directory, filename, OFTrue /*allowEmptyDirName*/);
+        result = EC_Normal;
+        DCMDATA_INFO("adding file: " << pathname);
+        /* start creating the DICOMDIR directory structure */
+        DcmDirectoryRecord *rootRecord = &(DicomDir->getRootRecord());
+        DcmMetaInfo *metainfo = fileformat.getMetaInfo();
+        /* massage filename into DICOM format (DOS conventions for path separators, uppercase) */
+        OFString fileID;
+        hostToDicomFilename(OFSTRING_GUARD(filename.getCharPointer()), fileID);
+        /* what kind of object (SOP Class) is stored in the file */
+        OFString sopClass;
+        metainfo->findAndGetOFString(DCM_MediaStorageSOPClassUID, sopClass);
+        /* if hanging protocol, palette or implant file then attach it to the root record and stop */
+        if (compare(sopClass, UID_HangingProtocolStorage))
+        {
+            /* add a hanging protocol record below the root */
+            if (addRecord(rootRecord, ERT_HangingProtocol, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ColorPaletteStorage))
+        {
+            /* add a palette record below the root */
+            if (addRecord(rootRecord, ERT_Palette, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_GenericImplantTemplateStorage))
+        {
+            /* add an implant record below the root */
+            if (addRecord(rootRecord, ERT_Implant, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ImplantAssemblyTemplateStorage))
+        {
+            /* add an implant group record below the root */
+            if (addRecord(rootRecord, ERT_ImplantGroup, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_ImplantTemplateGroupStorage))
+        {
+            /* add an implant assy record below the root */
+            if (addRecord(rootRecord, ERT_ImplantAssy, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        }
+        else if (compare(sopClass, UID_InventoryStorage))
+        {
+            /* add an inventory record below the root */
+            if (addRecord(rootRecord, ERT_Inventory, &fileformat, fileID, pathname) == NULL)
+                result = EC_CorruptedData;
+        } else {
+            /* add a patient record below the root */
+            DcmDirectoryRecord *patientRecord = addRecord(rootRecord, ERT_Patient, &fileformat, fileID, pathname);
+            if (patientRecord != NULL)
             {
-                /* add an inventory record below the root */
-                if (addRecord(rootRecord, ERT_Inventory, &fileformat, fileID, pathname) == NULL)
-                    result = EC_CorruptedData;
-            } else {
-                /* add a patient record below the root */
-                DcmDirectoryRecord *patientRecord = addRecord(rootRecord, ERT_Patient, &fileformat, fileID, pathname);
-                if (patientRecord != NULL)
+                /* if patient management file then attach it to patient record and stop */
+                if (compare(sopClass, UID_RETIRED_DetachedPatientManagementMetaSOPClass))
                 {
-                    /* if patient management file then attach it to patient record and stop */
-                    if (compare(sopClass, UID_RETIRED_DetachedPatientManagementMetaSOPClass))
+                    result = patientRecord->assignToSOPFile(fileID.c_str(), pathname);
+                    DCMDATA_ERROR(result.text() << ": cannot assign patient record to file: " << pathname);
+                } else {
+                    /* add a study record below the current patient record */
+                    DcmDirectoryRecord *studyRecord = addRecord(patientRecord, ERT_Study, &fileformat, fileID, pathname);;
+                    if (studyRecord != NULL)
                     {
-                        result = patientRecord->assignToSOPFile(fileID.c_str(), pathname);
-                        DCMDATA_ERROR(result.text() << ": cannot assign patient record to file: " << pathname);
-                    } else {
-                        /* add a study record below the current patient record */
-                        DcmDirectoryRecord *studyRecord = addRecord(patientRecord, ERT_Study, &fileformat, fileID, pathname);;
-                        if (studyRecord != NULL)
+                        /* add a series record below the current study record */
+                        DcmDirectoryRecord *seriesRecord = addRecord(studyRecord, ERT_Series, &fileformat, fileID, pathname);;
+                        if (seriesRecord != NULL)
                         {
-                            /* add a series record below the current study record */
-                            DcmDirectoryRecord *seriesRecord = addRecord(studyRecord, ERT_Series, &fileformat, fileID, pathname);;
-                            if (seriesRecord != NULL)
-                            {
-                                /* add one of the instance record below the current series record */
-                                if (addRecord(seriesRecord, sopClassToRecordType(sopClass), &fileformat, fileID, pathname) == NULL)
-                                    result = EC_CorruptedData;
-                            } else
+                            /* add one of the instance record below the current series record */
+                            if (addRecord(seriesRecord, sopClassToRecordType(sopClass), &fileformat, fileID, pathname) == NULL)
                                 result = EC_CorruptedData;
                         } else
                             result = EC_CorruptedData;
+                    } else
+                        result = EC_CorruptedData;
+                }
+            } else
+                result = EC_CorruptedData;
+            /* invent missing attributes on all levels or PatientID only */
+            if (InventMode)
+                inventMissingAttributes(rootRecord);
+            else if (InventPatientIDMode)
+                inventMissingAttributes(rootRecord, OFFalse /*recurse*/);
+        }
+    }
+    return result;
+}
+
+
+#ifdef WITH_THREADS
+
+/* state shared by all threads that load and check files for
+ * DicomDirInterface::addDicomFiles()
+ */
+class DicomDirInterfaceBatchJob
+{
+public:
+    DicomDirInterfaceBatchJob(DicomDirInterface &ddir,
+                              const OFList<OFFilename> &filenames,
+                              const OFFilename &directory,
+                              OFList<OFFilename> &badFiles,
+                              const unsigned int maxPendingFiles)
+      : ddir_(ddir)
+      , filenames_()
+      , directory_(directory)
+      , badFiles_(badFiles)
+      , pendingFiles_(maxPendingFiles)
+      , mutex_()
+      , nextFile_(0)
+      , mergeMutex_()
+      , entries_(filenames.size())
+      , nextFileToMerge_(0)
+      , goodFiles_(0)
+      , result_(EC_Normal)
+    {
+        filenames_.reserve(filenames.size());
+        OFListConstIterator(OFFilename) iter = filenames.begin();
+        while (iter != filenames.end())
+            filenames_.push_back(*iter++);
+    }
+
+    ~DicomDirInterfaceBatchJob()
+    {
+        // files that have been prepared but not merged because of an error
+        for (size_t i = nextFileToMerge_; i < entries_.size(); ++i)
+        {
+            delete entries_[i].fileformat;
+            delete[] entries_[i].iconPixel;
+        }
+    }
+
+    /* loads and checks files until all files have been processed or an error
+     * has occurred (in abort mode). Called by each thread.
+     */
+    void processFiles()
+    {
+        size_t index = 0;
+        while (nextFile(index))
+        {
+            DcmFileFormat *fileformat = new DcmFileFormat();
+            Uint8 *iconPixel = NULL;
+            unsigned int iconSize = 0;
+            OFCondition result = ddir_.prepareDicomFile(filenames_[index], directory_, *fileformat, iconPixel, iconSize);
+            mergeMutex_.lock();
+            Entry &entry = entries_[index];
+            entry.fileformat = fileformat;
+            entry.iconPixel = iconPixel;
+            entry.iconSize = iconSize;
+            entry.result = result;
+            entry.prepared = OFTrue;
+            mergeFiles();
+            mergeMutex_.unlock();
+        }
+    }
+
+    /* returns the result of the processing */
+    OFCondition result() const { return result_; }
+
+    /* returns the number of files added to the DICOMDIR */
+    size_t goodFiles() const { return goodFiles_; }
+
+private:
+
+    /* a file that is processed by a worker thread */
+    struct Entry
+    {
+        Entry()
+          : fileformat(NULL)
+          , iconPixel(NULL)
+          , iconSize(0)
+          , result(EC_Normal)
+          , prepared(OFFalse)
+        {
+        }
+
+        /* the loaded file */
+        DcmFileFormat *fileformat;
+        /* the icon image created in advance, NULL if none */
+        Uint8 *iconPixel;
+        /* resolution of the icon image */
+        unsigned int iconSize;
+        /* result of loading and checking the file */
+        OFCondition result;
+        /* flag indicating whether the file has been prepared */
+        OFBool prepared;
+    };
+
+    /* private undefined copy constructor */
+    DicomDirInterfaceBatchJob(const DicomDirInterfaceBatchJob &);
+
+    /* private undefined copy assignment operator */
+    DicomDirInterfaceBatchJob &operator=(const DicomDirInterfaceBatchJob &);
+
+    /* determines the next file to be processed. Blocks as long as the maximum
+     * number of files are prepared but not yet merged.
+     */
+    OFBool nextFile(size_t &index)
+    {
+        pendingFiles_.wait();
+        mutex_.lock();
+        const OFBool result = (nextFile_ < filenames_.size());
+        if (result) index = nextFile_++;
+        mutex_.unlock();
+        // pass the resource on to the other threads that are about to finish
+        if (!result) pendingFiles_.post();
+        return result;
+    }
+
+    /* adds all consecutive files that have been prepared to the DICOMDIR,
+     * in the order of the list of files. Called with mergeMutex_ locked.
+     */
+    void mergeFiles()
+    {
+        while ((nextFileToMerge_ < entries_.size()) && entries_[nextFileToMerge_].prepared)
+        {
+            Entry &entry = entries_[nextFileToMerge_];
+            // after an error (in abort mode), the remaining files are only discarded
+            if (result_.good())
+            {
+                OFCondition result = entry.result;
+                if (result.good())
+                {
+                    ddir_.PreparedIconPixel = entry.iconPixel;
+                    ddir_.PreparedIconSize = entry.iconSize;
+                    result = ddir_.addDicomFileRecords(filenames_[nextFileToMerge_], directory_, *entry.fileformat);
+                    ddir_.PreparedIconPixel = NULL;
+                    ddir_.PreparedIconSize = 0;
+                }
+                if (result.good())
+                    ++goodFiles_;
+                else
+                {
+                    badFiles_.push_back(filenames_[nextFileToMerge_]);
+                    if (ddir_.abortMode())
+                    {
+                        // stop all threads, and report the error
+                        result_ = result;
+                        mutex_.lock();
+                        nextFile_ = filenames_.size();
+                        mutex_.unlock();
                     }
-                } else
-                    result = EC_CorruptedData;
-                /* invent missing attributes on all levels or PatientID only */
-                if (InventMode)
-                    inventMissingAttributes(rootRecord);
-                else if (InventPatientIDMode)
-                    inventMissingAttributes(rootRecord, OFFalse /*recurse*/);
+                }
             }
+            delete entry.fileformat;
+            entry.fileformat = NULL;
+            delete[] entry.iconPixel;
+            entry.iconPixel = NULL;
+            ++nextFileToMerge_;
+            pendingFiles_.post();
         }
     }
+
+    /* the DICOMDIR interface to which the files are added */
+    DicomDirInterface &ddir_;
+
+    /* names of the files to be added */
+    OFVector<OFFilename> filenames_;
+
+    /* directory where the files are stored */
+    const OFFilename directory_;
+
+    /* names of the files that could not be added */
+    OFList<OFFilename> &badFiles_;
+
+    /* number of files that may be prepared before being merged */
+    OFSemaphore pendingFiles_;
+
+    /* mutex protecting nextFile_ */
+    OFMutex mutex_;
+
+    /* next file to be prepared */
+    size_t nextFile_;
+
+    /* mutex protecting the following members and the DICOMDIR */
+    OFMutex mergeMutex_;
+
+    /* state of all files */
+    OFVector<Entry> entries_;
+
+    /* next file to be added to the DICOMDIR */
+    size_t nextFileToMerge_;
+
+    /* number of files added to the DICOMDIR */
+    size_t goodFiles_;
+
+    /* result of the processing */
+    OFCondition result_;
+};
+
+
+/* worker thread for DicomDirInterface::addDicomFiles() */
+class DicomDirInterfaceBatchThread: public OFThread
+{
+public:
+    DicomDirInterfaceBatchThread(DicomDirInterfaceBatchJob &job)
+      : OFThread()
+      , job_(job)
+    {
+    }
+
+protected:
+
+    virtual void run()
+    {
+        job_.processFiles();
+    }
+
+private:
+
+    /* private undefined copy constructor */
+    DicomDirInterfaceBatchThread(const DicomDirInterfaceBatchThread &);
+
+    /* private undefined copy assignment operator */
+    DicomDirInterfaceBatchThread &operator=(const DicomDirInterfaceBatchThread &);
+
+    /* the job this thread is working on */
+    DicomDirInterfaceBatchJob &job_;
+};
+
+#endif
+
+
+// add specified DICOM files to the DICOMDIR, possibly using multiple threads
+OFCondition DicomDirInterface::addDicomFiles(const OFList<OFFilename> &filenames,
+                                             const OFFilename &directory,
+                                             OFList<OFFilename> &badFiles,
+                                             size_t &goodFiles,
+                                             const unsigned int numThreads)
+{
+    goodFiles = 0;
+    /* first, make sure that a DICOMDIR object exists */
+    if (DicomDir == NULL)
+        return EC_IllegalParameter;
+#ifdef WITH_THREADS
+    if ((numThreads > 1) && (filenames.size() > 1))
+    {
+        const unsigned int threadCount = (numThreads > filenames.size()) ? OFstatic_cast(unsigned int, filenames.size()) : numThreads;
+        DCMDATA_DEBUG("adding " << filenames.size() << " files using " << threadCount << " threads");
+        /* limit the number of files kept in memory */
+        DicomDirInterfaceBatchJob job(*this, filenames, directory, badFiles, 2 * threadCount);
+        OFVector<DicomDirInterfaceBatchThread *> threads;
+        for (unsigned int i = 1; i < threadCount; ++i)
+        {
+            DicomDirInterfaceBatchThread *thread = new DicomDirInterfaceBatchThread(job);
+            if (thread->start() == 0)
+                threads.push_back(thread);
+            else
+            {
+                /* continue with the threads started so far */
+                DCMDATA_WARN("cannot create thread, continuing with " << threads.size() + 1 << " threads");
+                delete thread;
+                break;
+            }
+        }
+        /* the calling thread participates in the processing */
+        job.processFiles();
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i]->join();
+            delete threads[i];
+        }
+        goodFiles = job.goodFiles();
+        return job.result();
+    }
+#else
+    OFstatic_cast(void, numThreads);
+#endif
+    OFCondition result = EC_Normal;
+    OFListConstIterator(OFFilename) iter = filenames.begin();
+    OFListConstIterator(OFFilename) last = filenames.end();
+    /* iterate over all filenames */
+    while ((iter != last) && result.good())
+    {
+        result = addDicomFile(*iter, directory);
+        if (result.bad())
+        {
+            badFiles.push_back(*iter);
+            /* ignore inconsistent file unless in abort mode */
+            if (!AbortMode)
+                result = EC_Normal;
+        } else
+            ++goodFiles;
+        ++iter;
+    }
     return result;
 }
 
@@ -5234,6 +5626,18 @@ OFBool DicomDirInterface::disableBackupMode(const OFBool newMode)
 }
 
 
+// enable/disable incremental write mode, i.e. whether to append new records to the file
+OFBool DicomDirInterface::enableIncrementalWriteMode(const OFBool newMode)
+{
+    /* save current mode */
+    OFBool oldMode = IncrementalWriteMode;
+    /* set new mode */
+    IncrementalWriteMode = newMode;
+    /* return old mode */
+    return oldMode;
+}
+
+
 // enable/disable pixel encoding check, i.e. whether the pixel encoding is checked
 // for particular application profiles
 OFBool DicomDirInterface::disableEncodingCheck(const OFBool newMode)
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2024, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -30,6 +30,7 @@
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/dcmdata/dcostrma.h"    /* for class DcmOutputStream */
 #include "dcmtk/dcmdata/dcostrmf.h"    /* for class DcmOutputFileStream */
+#include "dcmtk/dcmdata/dcostrmb.h"    /* for class DcmOutputBufferStream */
 #include "dcmtk/dcmdata/dcistrmf.h"    /* for class DcmInputFileStream */
 #include "dcmtk/dcmdata/dcvrcs.h"
 #include "dcmtk/dcmdata/dcvrus.h"
@@ -37,6 +38,7 @@
 #include "dcmtk/ofstd/ofstd.h"
 #include "dcmtk/dcmdata/dcwcache.h"    /* for class DcmWriteCache */
 #include "dcmtk/dcmdata/dcvrui.h"      /* for class DcmUniqueIdentifier */
+#include "dcmtk/ofstd/offile.h"        /* for class OFFile */
 
 #ifndef O_BINARY
 #define O_BINARY 0                     /* only Windows has O_BINARY */
@@ -53,7 +55,8 @@ DcmDicomDir::DcmDicomDir()
     mustCreateNewDir(OFFalse),
     DirFile(new DcmFileFormat()),
     RootRec(NULL),
-    MRDRSeq(NULL)
+    MRDRSeq(NULL),
+    fileLayout()
 {
     dicomDirFileName.set(DEFAULT_DICOMDIR_NAME);
 
@@ -64,6 +67,8 @@ DcmDicomDir::DcmDicomDir()
         DirFile = new DcmFileFormat();
         mustCreateNewDir = OFTrue;
     }
+    else
+        determineFileLayout();
 
     createNewElements( "" );      // create missing data elements
     RootRec = new DcmDirectoryRecord( ERT_root, NULL, OFFilename());
@@ -84,7 +89,8 @@ DcmDicomDir::DcmDicomDir(const OFFilename &fileName, const char *fileSetID)
     mustCreateNewDir(OFFalse),
     DirFile(new DcmFileFormat()),
     RootRec(NULL),
-    MRDRSeq(NULL)
+    MRDRSeq(NULL),
+    fileLayout()
 {
     if ( fileName.isEmpty() )
         dicomDirFileName.set(DEFAULT_DICOMDIR_NAME);
@@ -98,6 +104,8 @@ DcmDicomDir::DcmDicomDir(const OFFilename &fileName, const char *fileSetID)
       DirFile = new DcmFileFormat();
       mustCreateNewDir = OFTrue;
     }
+    else
+      determineFileLayout();
 
     createNewElements( fileSetID );   // create missing data elements
     RootRec = new DcmDirectoryRecord( ERT_root, NULL, OFFilename());
@@ -120,7 +128,8 @@ DcmDicomDir::DcmDicomDir( const DcmDicomDir & old )
     mustCreateNewDir(old.mustCreateNewDir),
     DirFile(new DcmFileFormat(*old.DirFile)),
     RootRec(new DcmDirectoryRecord(*old.RootRec)),
-    MRDRSeq(new DcmSequenceOfItems(*old.MRDRSeq))
+    MRDRSeq(new DcmSequenceOfItems(*old.MRDRSeq)),
+    fileLayout()
 {
 }
 
@@ -183,6 +192,57 @@ OFCondition DcmDicomDir::createNewElements( const char* fileSetID )
 }
 
 
+// ********************************
+
+/*
+   determines the layout of the DICOMDIR file that has just been read,
+   which is needed for writing the file incrementally. Only called by
+   the constructors (before any data element is added to the dataset).
+*/
+
+void DcmDicomDir::determineFileLayout()
+{
+    fileLayout.fileSize = 0;        // layout unknown
+    DcmDataset &dset = getDataset();    // guaranteed to exist
+    const unsigned long numElements = dset.card();
+    // the directory record sequence has to be the last element of the dataset
+    if ( numElements > 0 && dset.getOriginalXfer() == DICOMDIR_DEFAULT_TRANSFERSYNTAX )
+    {
+        DcmObject *lastElem = dset.getElement( numElements - 1 );
+        if ( lastElem->ident() == EVR_SQ && lastElem->getTag() == DCM_DirectoryRecordSequence )
+        {
+            DcmSequenceOfItems *recSeq = OFstatic_cast(DcmSequenceOfItems *, lastElem);
+            const offile_off_t fileSize = OFstatic_cast(offile_off_t, OFStandard::getFileSize( dicomDirFileName ));
+            const offile_off_t prefixLength = lengthUntilSQ( dset, DICOMDIR_DEFAULT_TRANSFERSYNTAX, EET_ExplicitLength );
+            const Uint32 seqLength = recSeq->getLengthField();
+            const OFBool undefinedLength = ( seqLength == DCM_UndefinedLength );
+            offile_off_t seqStart, seqEnd;
+            if ( undefinedLength )
+            {
+                // the sequence is terminated by a sequence delimitation item
+                seqEnd = fileSize - 8;
+                if ( recSeq->card() > 0 )
+                    seqStart = OFstatic_cast(DcmDirectoryRecord *, recSeq->getItem( 0 ))->getFileOffset();
+                else
+                    seqStart = seqEnd;
+            } else {
+                seqEnd = fileSize;
+                seqStart = fileSize - seqLength;
+            }
+            if ( fileSize <= OFstatic_cast(offile_off_t, 0xffffffff) && seqStart >= prefixLength && seqStart <= seqEnd )
+            {
+                fileLayout.fileSize = fileSize;
+                fileLayout.datasetStart = OFstatic_cast(Uint32, seqStart - prefixLength);
+                fileLayout.sequenceStart = OFstatic_cast(Uint32, seqStart);
+                fileLayout.sequenceEnd = OFstatic_cast(Uint32, seqEnd);
+                fileLayout.numberOfRecords = recSeq->card();
+                fileLayout.undefinedLength = undefinedLength;
+            }
+        }
+    }
+}
+
+
 // ********************************
 
 
@@ -596,7 +656,6 @@ OFCondition DcmDicomDir::convertAllPointer( DcmDataset &dset,          // inout
                                             E_TransferSyntax oxfer,    // in
                                             E_EncodingType enctype )   // in
 {
-    OFCondition l_error = EC_Normal;
     DcmObject *obj = NULL;
     DcmDirectoryRecord *rec = NULL;
     DcmSequenceOfItems &localDirRecSeq = getDirRecSeq( dset );
@@ -612,13 +671,24 @@ OFCondition DcmDicomDir::convertAllPointer( DcmDataset &dset,          // inout
         item_pos = lengthOfRecord( rec, oxfer, enctype ) + item_pos;
     }
 
-    /* calling convertGivenPointer() requires that the above for-loop has been run through */
+    /* calling convertRecordPointer() requires that the above for-loop has been run through */
+    return convertRecordPointer( dset, localDirRecSeq );
+}
+
+
+// ********************************
+
+
+OFCondition DcmDicomDir::convertRecordPointer( DcmDataset &dset,              // inout
+                                               DcmSequenceOfItems &recSeq )  // inout
+{
+    OFCondition l_error = EC_Normal;
     OFCondition e1 = convertGivenPointer( &dset, DCM_OffsetOfTheFirstDirectoryRecordOfTheRootDirectoryEntity );
     OFCondition e2 = convertGivenPointer( &dset, DCM_OffsetOfTheLastDirectoryRecordOfTheRootDirectoryEntity );
 
-    OFCondition e3 = convertGivenPointer( &localDirRecSeq, DCM_OffsetOfTheNextDirectoryRecord );
-    OFCondition e4 = convertGivenPointer( &localDirRecSeq, DCM_OffsetOfReferencedLowerLevelDirectoryEntity );
-    OFCondition e5 = convertGivenPointer( &localDirRecSeq, DCM_RETIRED_MRDRDirectoryRecordOffset );
+    OFCondition e3 = convertGivenPointer( &recSeq, DCM_OffsetOfTheNextDirectoryRecord );
+    OFCondition e4 = convertGivenPointer( &recSeq, DCM_OffsetOfReferencedLowerLevelDirectoryEntity );
+    OFCondition e5 = convertGivenPointer( &recSeq, DCM_RETIRED_MRDRDirectoryRecordOffset );
 
     if ( e1 == EC_InvalidVR || e2 == EC_InvalidVR || e3 == EC_InvalidVR || e4 == EC_InvalidVR || e5 == EC_InvalidVR )
         l_error = EC_InvalidVR;
@@ -707,7 +777,8 @@ OFCondition DcmDicomDir::convertTreeToLinear(Uint32 beginOfDataSet,
                                              E_TransferSyntax oxfer,
                                              E_EncodingType enctype,
                                              E_GrpLenEncoding glenc,
-                                             DcmSequenceOfItems &unresRecs )
+                                             DcmSequenceOfItems &unresRecs,
+                                             OFBool keepOffsets )
 {
     OFCondition l_error = EC_Normal;
     DcmDataset &dset = getDataset();    // guaranteed to exist
@@ -748,6 +819,10 @@ OFCondition DcmDicomDir::convertTreeToLinear(Uint32 beginOfDataSet,
     // compute group lengths before computing byte offsets
     dset.computeGroupLengthAndPadding(glenc, EPD_noChange, oxfer, enctype);
 
+    // the byte offsets are computed by the caller (see appendRecordsToFile())
+    if ( keepOffsets )
+        return l_error;
+
     // convert maximum twice
     if ( convertAllPointer( dset, beginOfDataSet, oxfer, enctype ) == EC_InvalidVR )
         if ( convertAllPointer( dset, beginOfDataSet, oxfer, enctype ) == EC_InvalidVR )
@@ -1038,6 +1113,21 @@ OFCondition DcmDicomDir::write(const E_TransferSyntax oxfer,
         // do not calculate GroupLength and Padding twice!
         dset.write(*outStream, outxfer, enctype, &wcache, EGL_noChange);
         dset.transferEnd();
+
+        // remember the layout of the new file (needed for writeIncremental)
+        fileLayout.fileSize = 0;
+        const unsigned long numElements = dset.card();
+        const offile_off_t fileSize = outStream->tell();
+        if ( numElements > 0 && dset.getElement( numElements - 1 ) == &localDirRecSeq &&
+             fileSize <= OFstatic_cast(offile_off_t, 0xffffffff) )
+        {
+            fileLayout.fileSize = fileSize;
+            fileLayout.datasetStart = beginOfDataset;
+            fileLayout.sequenceStart = beginOfDataset + lengthUntilSQ( dset, outxfer, enctype );
+            fileLayout.undefinedLength = ( enctype == EET_UndefinedLength );
+            fileLayout.sequenceEnd = OFstatic_cast(Uint32, fileSize) - ( fileLayout.undefinedLength ? 8 : 0 );
+            fileLayout.numberOfRecords = localDirRecSeq.card();
+        }
     }
 
     // outStream is closed here
@@ -1079,7 +1169,8 @@ OFCondition DcmDicomDir::write(const E_TransferSyntax oxfer,
     if (errorFlag == EC_Normal) {
         // remove temporary backup (if any)
         OFStandard::deleteFile(backupFilename);
-    }
+    } else
+        fileLayout.fileSize = 0;
 
     // remove all records from sequence localDirRecSeq
     while (localDirRecSeq.card() > 0)
@@ -1100,6 +1191,392 @@ OFCondition DcmDicomDir::write(const E_TransferSyntax oxfer,
 // ********************************
 
 
+/* encodes the given DICOM object (data element or item) to the given output
+ * stream using the default transfer syntax for DICOMDIR files
+ */
+static OFCondition encodeObject(DcmObject *object,
+                                DcmOutputStream &outStream,
+                                const E_EncodingType enctype,
+                                DcmWriteCache &wcache)
+{
+    object->transferInit();
+    OFCondition result = object->write(outStream, DICOMDIR_DEFAULT_TRANSFERSYNTAX, enctype, &wcache);
+    object->transferEnd();
+    return result;
+}
+
+
+/* reads the given number of bytes from the given position of a file */
+static OFBool readFromFile(OFFile &file,
+                           const offile_off_t position,
+                           Uint8 *buffer,
+                           const size_t length)
+{
+    return (file.fseek(position, SEEK_SET) == 0) && (file.fread(buffer, 1, length) == length);
+}
+
+
+/* writes the given number of bytes to the given position of a file */
+static OFBool writeToFile(OFFile &file,
+                          const offile_off_t position,
+                          const Uint8 *buffer,
+                          const size_t length)
+{
+    return (file.fseek(position, SEEK_SET) == 0) && (file.fwrite(buffer, 1, length) == length);
+}
+
+
+/* stores the given 32-bit value in little endian byte order */
+static void storeUint32LE(Uint8 *buffer,
+                          const Uint32 value)
+{
+    buffer[0] = OFstatic_cast(Uint8, value);
+    buffer[1] = OFstatic_cast(Uint8, value >> 8);
+    buffer[2] = OFstatic_cast(Uint8, value >> 16);
+    buffer[3] = OFstatic_cast(Uint8, value >> 24);
+}
+
+
+/* part of a DICOMDIR file that is to be overwritten */
+struct DcmDicomDirFilePatch
+{
+    /// file offset of the data to be written
+    Uint32 offset;
+    /// data to be written (allocated with new[])
+    Uint8 *data;
+    /// number of bytes to be written
+    Uint32 length;
+};
+
+
+// ********************************
+
+
+OFBool DcmDicomDir::appendRecordsToFile(DcmDataset &dset,
+                                        DcmSequenceOfItems &recSeq,
+                                        E_EncodingType enctype)
+{
+    const E_TransferSyntax oxfer = DICOMDIR_DEFAULT_TRANSFERSYNTAX;
+    const char *reason = NULL;      // reason why records cannot be appended
+    OFMap<Uint32, DcmDirectoryRecord *> storedRecs;
+    OFList<DcmDirectoryRecord *> storedList;
+    OFList<DcmDirectoryRecord *> newList;
+    OFList<DcmDicomDirFilePatch> patches;
+    OFListIterator(DcmDirectoryRecord *) it;
+    Uint8 *appendData = NULL;
+    Uint8 *fileData = NULL;
+    Uint8 *prefixData = NULL;
+    size_t fileDataSize = 0;
+    offile_off_t endOfRecords = fileLayout.sequenceEnd;
+    offile_off_t newFileSize = 0;
+
+    // separate the records that are already stored in the file from new records
+    DcmObject *obj = NULL;
+    const unsigned long num = recSeq.card();
+    for (unsigned long i = 0; i < num && reason == NULL; i++ )
+    {
+        obj = recSeq.nextInContainer(obj);
+        DcmDirectoryRecord *rec = OFstatic_cast(DcmDirectoryRecord *, obj);
+        const Uint32 offset = rec->getFileOffset();
+        if ( offset == 0 )
+            newList.push_back( rec );
+        else if ( offset < fileLayout.sequenceStart || offset >= fileLayout.sequenceEnd ||
+                  storedRecs.find( offset ) != storedRecs.end() )
+            reason = "unexpected offset of existing record";
+        else
+            storedRecs[ offset ] = rec;
+    }
+    if ( reason == NULL && storedRecs.size() != fileLayout.numberOfRecords )
+        reason = "existing records have been removed";
+
+    // the existing records must still fill the directory record sequence without any gaps,
+    // i.e. the size of the records (encoded as before) must not have changed
+    offile_off_t pos = fileLayout.sequenceStart;
+    while ( reason == NULL && pos < fileLayout.sequenceEnd )
+    {
+        OFMap<Uint32, DcmDirectoryRecord *>::iterator mapIt = storedRecs.find( OFstatic_cast(Uint32, pos) );
+        if ( mapIt == storedRecs.end() )
+            reason = "size of existing record has changed";
+        else
+        {
+            DcmDirectoryRecord *rec = mapIt->second;
+            const E_EncodingType itemEnc = ( rec->getLengthField() == DCM_UndefinedLength ) ? EET_UndefinedLength : EET_ExplicitLength;
+            storedList.push_back( rec );
+            pos += lengthOfRecord( rec, oxfer, itemEnc );
+        }
+    }
+    if ( reason == NULL && pos != fileLayout.sequenceEnd )
+        reason = "size of existing record has changed";
+
+    // new records are appended to the end of the directory record sequence
+    if ( reason == NULL )
+    {
+        for ( it = newList.begin(); it != newList.end(); ++it )
+        {
+            ( *it )->setFileOffset( OFstatic_cast(Uint32, endOfRecords) );
+            endOfRecords += lengthOfRecord( *it, oxfer, enctype );
+        }
+        newFileSize = endOfRecords + ( fileLayout.undefinedLength ? 8 : 0 );
+        if ( newFileSize > OFstatic_cast(offile_off_t, 0xffffffff) )
+            reason = "file size exceeds 4 GB";
+        else if ( convertRecordPointer( dset, recSeq ) == EC_InvalidVR )
+            reason = "offsets cannot be converted";
+    }
+
+    // compare the current encoding with the content of the file (which is not modified yet)
+    OFFile file;
+    if ( reason == NULL && !file.fopen( dicomDirFileName, "rb" ) )
+        reason = "cannot open file for reading";
+    DcmWriteCache wcache;
+    if ( reason == NULL )
+    {
+        // check header of the directory record sequence and sequence delimitation item (if any)
+        Uint8 expected[12] = { 0x04, 0x00, 0x20, 0x12, 'S', 'Q', 0x00, 0x00 };
+        Uint8 buffer[12];
+        storeUint32LE( expected + 8, fileLayout.undefinedLength ? DCM_UndefinedLength : fileLayout.sequenceEnd - fileLayout.sequenceStart );
+        if ( !readFromFile( file, fileLayout.sequenceStart - 12, buffer, 12 ) || memcmp( buffer, expected, 12 ) != 0 )
+            reason = "unexpected header of directory record sequence";
+        else if ( fileLayout.undefinedLength )
+        {
+            const Uint8 delimiter[8] = { 0xfe, 0xff, 0xdd, 0xe0, 0x00, 0x00, 0x00, 0x00 };
+            if ( !readFromFile( file, fileLayout.sequenceEnd, buffer, 8 ) || memcmp( buffer, delimiter, 8 ) != 0 )
+                reason = "unexpected end of directory record sequence";
+        }
+    }
+    if ( reason == NULL )
+    {
+        // the data elements preceding the directory record sequence (including the offsets
+        // of the first and last root directory record) must have the same tags and size
+        const Uint32 prefixLength = fileLayout.sequenceStart - 12 - fileLayout.datasetStart;
+        if ( lengthUntilSQ( dset, oxfer, enctype ) != prefixLength + 12 )
+            reason = "size of general directory information has changed";
+        else
+        {
+            prefixData = new Uint8[ prefixLength ];
+            fileData = new Uint8[ prefixLength ];
+            fileDataSize = prefixLength;
+            OFList<offile_off_t> tagPositions;
+            DcmOutputBufferStream outStream( prefixData, prefixLength );
+            for ( unsigned long i = 0; i < dset.card() && reason == NULL; i++ )
+            {
+                DcmObject *dO = dset.getElement( i );
+                if ( dO == &recSeq )
+                    break;
+                tagPositions.push_back( outStream.tell() );
+                if ( encodeObject( dO, outStream, enctype, wcache ).bad() )
+                    reason = "cannot encode general directory information";
+            }
+            outStream.flush();
+            void *filledData = NULL;
+            offile_off_t filledLength = 0;
+            outStream.flushBuffer( filledData, filledLength );
+            if ( reason == NULL && filledLength != OFstatic_cast(offile_off_t, prefixLength) )
+                reason = "cannot encode general directory information";
+            else if ( reason == NULL && !readFromFile( file, fileLayout.datasetStart, fileData, prefixLength ) )
+                reason = "cannot read general directory information";
+            OFListIterator(offile_off_t) posIt = tagPositions.begin();
+            while ( reason == NULL && posIt != tagPositions.end() )
+            {
+                if ( *posIt + 4 > OFstatic_cast(offile_off_t, prefixLength) || memcmp( prefixData + *posIt, fileData + *posIt, 4 ) != 0 )
+                    reason = "unexpected encoding of general directory information";
+                ++posIt;
+            }
+            if ( reason == NULL && memcmp( prefixData, fileData, prefixLength ) != 0 )
+            {
+                DcmDicomDirFilePatch patch = { fileLayout.datasetStart, prefixData, prefixLength };
+                patches.push_back( patch );
+                prefixData = NULL;
+            }
+        }
+    }
+    // existing records only need to be overwritten if their encoding has changed
+    for ( it = storedList.begin(); it != storedList.end() && reason == NULL; ++it )
+    {
+        DcmDirectoryRecord *rec = *it;
+        const E_EncodingType itemEnc = ( rec->getLengthField() == DCM_UndefinedLength ) ? EET_UndefinedLength : EET_ExplicitLength;
+        const Uint32 length = lengthOfRecord( rec, oxfer, itemEnc );
+        if ( fileDataSize < length )
+        {
+            delete[] fileData;
+            fileData = new Uint8[ length ];
+            fileDataSize = length;
+        }
+        Uint8 *recordData = new Uint8[ length ];
+        DcmOutputBufferStream outStream( recordData, length );
+        OFCondition status = encodeObject( rec, outStream, itemEnc, wcache );
+        outStream.flush();
+        void *filledData = NULL;
+        offile_off_t filledLength = 0;
+        outStream.flushBuffer( filledData, filledLength );
+        if ( status.bad() || filledLength != OFstatic_cast(offile_off_t, length) )
+            reason = "cannot encode existing record";
+        else if ( !readFromFile( file, rec->getFileOffset(), fileData, length ) )
+            reason = "cannot read existing record";
+        else if ( memcmp( recordData, fileData, 8 ) != 0 )
+            reason = "unexpected encoding of existing record";
+        else if ( memcmp( recordData, fileData, length ) != 0 )
+        {
+            // make sure that values that have not been loaded yet are read from the unmodified file
+            rec->loadAllDataIntoMemory();
+            DcmDicomDirFilePatch patch = { rec->getFileOffset(), recordData, length };
+            patches.push_back( patch );
+            recordData = NULL;
+        }
+        delete[] recordData;
+    }
+    file.fclose();
+
+    // encode the new records (and the sequence delimitation item, if required)
+    if ( reason == NULL && newFileSize > fileLayout.sequenceEnd )
+    {
+        const Uint32 appendLength = OFstatic_cast(Uint32, newFileSize - fileLayout.sequenceEnd);
+        appendData = new Uint8[ appendLength ];
+        DcmOutputBufferStream outStream( appendData, appendLength );
+        for ( it = newList.begin(); it != newList.end() && reason == NULL; ++it )
+        {
+            if ( encodeObject( *it, outStream, enctype, wcache ).bad() )
+                reason = "cannot encode new record";
+        }
+        outStream.flush();
+        void *filledData = NULL;
+        offile_off_t filledLength = 0;
+        outStream.flushBuffer( filledData, filledLength );
+        if ( reason == NULL && filledLength != OFstatic_cast(offile_off_t, endOfRecords - fileLayout.sequenceEnd) )
+            reason = "cannot encode new record";
+        else if ( reason == NULL && fileLayout.undefinedLength )
+        {
+            const Uint8 delimiter[8] = { 0xfe, 0xff, 0xdd, 0xe0, 0x00, 0x00, 0x00, 0x00 };
+            memcpy( appendData + filledLength, delimiter, 8 );
+        }
+    }
+
+    OFBool appended = OFFalse;
+    if ( reason == NULL )
+    {
+        // new records are written first, existing parts of the file are overwritten at last
+        if ( !file.fopen( dicomDirFileName, "r+b" ) )
+            reason = "cannot open file for writing";
+        else
+        {
+            if ( appendData != NULL && !writeToFile( file, fileLayout.sequenceEnd, appendData, OFstatic_cast(size_t, newFileSize - fileLayout.sequenceEnd) ) )
+                reason = "cannot write new records";
+            if ( reason == NULL && !fileLayout.undefinedLength )
+            {
+                Uint8 length[4];
+                storeUint32LE( length, OFstatic_cast(Uint32, endOfRecords - fileLayout.sequenceStart) );
+                if ( !writeToFile( file, fileLayout.sequenceStart - 4, length, 4 ) )
+                    reason = "cannot write length of directory record sequence";
+            }
+            OFListIterator(DcmDicomDirFilePatch) patchIt = patches.begin();
+            while ( reason == NULL && patchIt != patches.end() )
+            {
+                if ( !writeToFile( file, patchIt->offset, patchIt->data, patchIt->length ) )
+                    reason = "cannot overwrite existing record";
+                ++patchIt;
+            }
+            if ( file.fclose() != 0 && reason == NULL )
+                reason = "cannot close file";
+        }
+        if ( reason == NULL )
+        {
+            DCMDATA_DEBUG("DcmDicomDir::writeIncremental() Appended " << newList.size() << " records to file "
+                << dicomDirFileName << ", " << patches.size() << " parts of the file overwritten");
+            fileLayout.fileSize = newFileSize;
+            fileLayout.sequenceEnd = OFstatic_cast(Uint32, endOfRecords);
+            fileLayout.numberOfRecords += newList.size();
+            appended = OFTrue;
+        } else {
+            // the file might be corrupted now, but it is written completely anyway
+            DCMDATA_WARN("DcmDicomDir: " << reason << " in file " << dicomDirFileName);
+            fileLayout.fileSize = 0;
+        }
+    }
+    if ( reason != NULL )
+    {
+        DCMDATA_DEBUG("DcmDicomDir::writeIncremental() Cannot append records to file " << dicomDirFileName
+            << " (" << reason << "), writing complete DICOMDIR");
+    }
+
+    OFListIterator(DcmDicomDirFilePatch) patchIt = patches.begin();
+    while ( patchIt != patches.end() )
+    {
+        delete[] patchIt->data;
+        ++patchIt;
+    }
+    delete[] appendData;
+    delete[] prefixData;
+    delete[] fileData;
+    return appended;
+}
+
+
+// ********************************
+
+
+OFCondition DcmDicomDir::writeIncremental(const E_EncodingType enctype,
+                                          const E_GrpLenEncoding glenc)
+{
+    errorFlag = EC_Normal;
+    OFBool appended = OFFalse;
+    if (fileLayout.fileSize == 0)
+    {
+        DCMDATA_DEBUG("DcmDicomDir::writeIncremental() Layout of file " << dicomDirFileName
+            << " unknown, writing complete DICOMDIR");
+    }
+    else if (glenc == EGL_withGL)
+    {
+        DCMDATA_DEBUG("DcmDicomDir::writeIncremental() Group length elements not supported, writing complete DICOMDIR");
+    }
+    else if (OFstatic_cast(offile_off_t, OFStandard::getFileSize(dicomDirFileName)) != fileLayout.fileSize)
+    {
+        DCMDATA_DEBUG("DcmDicomDir::writeIncremental() File " << dicomDirFileName
+            << " has been modified, writing complete DICOMDIR");
+    } else {
+        DcmDataset &dset = getDataset(); // guaranteed to exist
+        DcmSequenceOfItems &localDirRecSeq = getDirRecSeq(dset);
+        DcmTag unresSeqTag(DCM_DirectoryRecordSequence);
+        DcmSequenceOfItems localUnresRecs(unresSeqTag);
+
+        // convert to writable format, but keep the byte offsets of existing records
+        errorFlag = convertTreeToLinear(0, DICOMDIR_DEFAULT_TRANSFERSYNTAX, enctype, glenc, localUnresRecs, OFTrue /*keepOffsets*/);
+        if (errorFlag.good())
+        {
+            // records to which no pointer exists are not written (see write())
+            if (localUnresRecs.card() > 0)
+            {
+                DCMDATA_DEBUG("DcmDicomDir::writeIncremental() File " << dicomDirFileName
+                    << " contains unreferenced records, writing complete DICOMDIR");
+            } else
+                appended = appendRecordsToFile(dset, localDirRecSeq, enctype);
+        }
+
+        // remove all records from sequence localDirRecSeq
+        while (localDirRecSeq.card() > 0)
+            localDirRecSeq.remove(OFstatic_cast(unsigned long, 0));
+
+        // move records to which no pointer exists back
+        while (localUnresRecs.card() > 0)
+        {
+            DcmItem *unresRecord =
+                localUnresRecs.remove(OFstatic_cast(unsigned long, 0));
+            localDirRecSeq.insert(unresRecord);
+        }
+    }
+    if (appended)
+    {
+        modified = OFFalse;
+        return errorFlag;
+    }
+    if (errorFlag.bad())
+        return errorFlag;
+    return write(DICOMDIR_DEFAULT_TRANSFERSYNTAX, enctype, glenc);
+}
+
+
+// ********************************
+// ********************************
+
+
 OFCondition DcmDicomDir::countMRDRRefs( DcmDirectoryRecord *startRec,
                                         ItemOffset *refCounter,
                                         const unsigned long numCounters )
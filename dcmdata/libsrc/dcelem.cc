@@ -31,6 +31,7 @@
 #include "dcmtk/dcmdata/dcobject.h"
 #include "dcmtk/dcmdata/dcswap.h"
 #include "dcmtk/dcmdata/dcistrma.h"    /* for class DcmInputStream */
+#include "dcmtk/dcmdata/dcistrmm.h"    /* for class DcmFileMapping */
 #include "dcmtk/dcmdata/dcostrma.h"    /* for class DcmOutputStream */
 #include "dcmtk/dcmdata/dcfcache.h"    /* for class DcmFileCache */
 #include "dcmtk/dcmdata/dcwcache.h"    /* for class DcmWriteCache */
@@ -52,7 +53,9 @@ DcmElement::DcmElement(const DcmTag &tag,
   : DcmObject(tag, len),
     fByteOrder(gLocalByteOrder),
     fLoadValue(NULL),
-    fValue(NULL)
+    fValue(NULL),
+    fMapping(NULL),
+    fArena(NULL)
 {
 }
 
@@ -61,7 +64,9 @@ DcmElement::DcmElement(const DcmElement &elem)
   : DcmObject(elem),
     fByteOrder(elem.fByteOrder),
     fLoadValue(NULL),
-    fValue(NULL)
+    fValue(NULL),
+    fMapping(NULL),
+    fArena(NULL)
 {
     if (elem.fValue)
     {
@@ -110,12 +115,9 @@ DcmElement &DcmElement::operator=(const DcmElement &obj)
 {
   if (this != &obj)
   {
-    // if created with the nothrow version it must also be deleted with
-    // the nothrow version else memory error.
-    operator delete[] (fValue, std::nothrow);
+    freeValueField();
     delete fLoadValue;
     fLoadValue = NULL;
-    fValue = NULL;
 
     DcmObject::operator=(obj);
     fByteOrder = obj.fByteOrder;
@@ -205,9 +207,7 @@ OFCondition DcmElement::copyFrom(const DcmObject& rhs)
 
 DcmElement::~DcmElement()
 {
-    // if created with the nothrow version it must also be deleted with
-    // the nothrow version else memory error.
-    operator delete[] (fValue, std::nothrow);
+    freeValueField();
     delete fLoadValue;
 }
 
@@ -218,10 +218,7 @@ DcmElement::~DcmElement()
 OFCondition DcmElement::clear()
 {
     errorFlag = EC_Normal;
-    // if created with the nothrow version it must also be deleted with
-    // the nothrow version else memory error.
-    operator delete[] (fValue, std::nothrow);
-    fValue = NULL;
+    freeValueField();
     delete fLoadValue;
     fLoadValue = NULL;
     setLengthField(0);
@@ -290,7 +287,11 @@ OFBool DcmElement::canWriteXfer(const E_TransferSyntax newXfer,
 OFCondition DcmElement::detachValueField(OFBool copy)
 {
     OFCondition l_error = EC_Normal;
-    if (getLengthField() != 0)
+    // a value that references a memory-mapped file or an arena is not owned
+    // by this element and can therefore not be handed over to the caller
+    if (fMapping || fArena)
+        l_error = EC_IllegalCall;
+    else if (getLengthField() != 0)
     {
         if (copy)
         {
@@ -608,6 +609,35 @@ OFCondition DcmElement::loadValue(DcmInputStream *inStream)
             /* if we did not encounter the end of the stream and no error occurred so far, go ahead */
             else if (errorFlag.good())
             {
+                /* if the stream is backed by a memory-mapped file, try to reference the value */
+                /* in the mapped file instead of copying it. Private mappings are copy-on-write, */
+                /* i.e. modifying the value later on never affects the file. Values with odd */
+                /* length and strings are excluded, since these require padding or termination. */
+                if (!fValue && (getTransferredBytes() == 0) && (getLengthField() >= DcmMappedFileMinBlockSize) &&
+                    !(getLengthField() & 1) && !getTag().getVR().isaString())
+                {
+                    DcmFileMapping *mapping = NULL;
+                    Uint8 *block = readStream->mapBlock(getLengthField(), mapping);
+                    if (block)
+                    {
+                        const size_t valueWidth = getTag().getVR().getValueWidth();
+                        /* the value field is accessed as an array of the VR's data type */
+                        if ((valueWidth > 1) && (OFreinterpret_cast(size_t, block) % valueWidth != 0))
+                        {
+                            /* misaligned block, copy it instead */
+                            fValue = newValueField();
+                            if (fValue)
+                                memcpy(fValue, block, size_t(getLengthField()));
+                        } else {
+                            fValue = block;
+                            fMapping = mapping;
+                            fMapping->increaseRefCount();
+                        }
+                        /* the block has been consumed from the stream */
+                        if (fValue)
+                            setTransferredBytes(getLengthField());
+                    }
+                }
                 /* if the object which holds this element's value does not yet exist, create it */
                 if (!fValue)
                     fValue = newValueField(); /* also set errorFlag in case of error */
@@ -686,7 +716,7 @@ Uint8 *DcmElement::newValueField()
         // we want to use a non-throwing new here if available.
         // If the allocation fails, we report an EC_MemoryExhausted error
         // back to the caller.
-        value = new (std::nothrow) Uint8[lengthField + 1];    // protocol error: odd value length
+        value = allocateValueField(OFstatic_cast(size_t, lengthField) + 1);    // protocol error: odd value length
 
         /* if creation was successful, set last byte to 0 (in order to initialize this byte) */
         /* (no value will be assigned to this byte later, since Length was odd) */
@@ -705,7 +735,7 @@ Uint8 *DcmElement::newValueField()
         // we want to use a non-throwing new here if available.
         // If the allocation fails, we report an EC_MemoryExhausted error
         // back to the caller.
-        value = new (std::nothrow) Uint8[lengthField];
+        value = allocateValueField(lengthField);
     }
 
     /* if creation was not successful set member error flag correspondingly */
@@ -719,6 +749,58 @@ Uint8 *DcmElement::newValueField()
 // ********************************
 
 
+Uint8 *DcmElement::allocateValueField(const size_t numBytes)
+{
+    /* short values are allocated from the active arena (if any), provided
+     * that no other value field is currently referenced by this element
+     */
+    DcmArena *arena = DcmArena::current();
+    if (arena && (numBytes <= DcmArenaMaxValueSize) && !fValue && !fMapping && !fArena)
+    {
+        try
+        {
+            Uint8 *value = OFstatic_cast(Uint8 *, arena->allocate(numBytes));
+            fArena = arena;
+            fArena->increaseRefCount();
+            return value;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return NULL;
+        }
+    }
+    // if created with the nothrow version it must also be deleted with
+    // the nothrow version else memory error.
+    return new (std::nothrow) Uint8[numBytes];
+}
+
+
+// ********************************
+
+
+void DcmElement::freeValueField()
+{
+    if (fMapping)
+    {
+        // the value references a memory-mapped file, release the mapping
+        fMapping->decreaseRefCount();
+        fMapping = NULL;
+    } else if (fArena) {
+        // the value has been allocated from an arena, release the arena
+        fArena->decreaseRefCount();
+        fArena = NULL;
+    } else {
+        // if created with the nothrow version it must also be deleted with
+        // the nothrow version else memory error.
+        operator delete[] (fValue, std::nothrow);
+    }
+    fValue = NULL;
+}
+
+
+// ********************************
+
+
 void DcmElement::postLoadValue()
 {
     if (dcmEnableAutomaticInputDataCorrection.get())
@@ -774,9 +856,7 @@ OFCondition DcmElement::changeValue(const void *value,
                     memcpy(newValue, fValue, size_t(getLengthField()));
                     // copy value passed as a parameter to the end
                     memcpy(&newValue[getLengthField()], OFstatic_cast(const Uint8 *, value), size_t(num));
-                    // if created with the nothrow version it must also be deleted with
-                    // the nothrow version else memory error.
-                    operator delete[] (fValue, std::nothrow);
+                    freeValueField();
                     fValue = newValue;
                     setLengthField(getLengthField() + num);
                 } else
@@ -973,13 +1053,7 @@ OFCondition DcmElement::putValue(const void * newValue,
 {
     errorFlag = EC_Normal;
 
-    if (fValue)
-    {
-        // if created with the nothrow version it must also be deleted with
-        // the nothrow version else memory error.
-        operator delete[] (fValue, std::nothrow);
-    }
-    fValue = NULL;
+    freeValueField();
 
     if (fLoadValue)
         delete fLoadValue;
@@ -1032,13 +1106,7 @@ OFCondition DcmElement::createUint16Array(const Uint32 /*numWords*/,
 OFCondition DcmElement::createEmptyValue(const Uint32 length)
 {
     errorFlag = EC_Normal;
-    if (fValue)
-    {
-        // if created with the nothrow version it must also be deleted with
-        // the nothrow version else memory error.
-        operator delete[] (fValue, std::nothrow);
-    }
-    fValue = NULL;
+    freeValueField();
     if (fLoadValue)
         delete fLoadValue;
     fLoadValue = NULL;
@@ -1156,9 +1224,7 @@ OFCondition DcmElement::read(DcmInputStream &inStream,
                     }
                 }
                 /* if there is already a value for this element, delete this value */
-                // if created with the nothrow version it must also be deleted with
-                // the nothrow version else memory error.
-                operator delete[] (fValue, std::nothrow);
+                freeValueField();
                 /* set the transfer state to ERW_inWork */
                 setTransferState(ERW_inWork);
             }
@@ -1327,16 +1393,47 @@ OFCondition DcmElement::write(DcmOutputStream &outStream,
                     /* remember how many bytes have been written to the stream, currently none so far */
                     Uint32 writtenBytes = 0;
 
-                    /* write tag and length information (and possibly also data type information) to the stream, */
-                    /* mind the transfer syntax and remember the amount of bytes that have been written */
-                    errorFlag = writeTagAndLength(outStream, oxfer, writtenBytes);
-
-                    /* if the writing was successful, set this element's transfer */
-                    /* state to ERW_inWork and the amount of transferred bytes to 0 */
-                    if (errorFlag.good())
+                    if (value)
                     {
-                        setTransferState(ERW_inWork);
-                        setTransferredBytes(0);
+                        /* the value resides in memory (in the output byte order): write tag and length */
+                        /* information and the value with a single gathered write operation. This passes */
+                        /* the value to the stream without copying it into an intermediate buffer. */
+                        Uint8 header[DCM_TagInfoLength];
+                        errorFlag = encodeTagAndLength(header, oxfer, writtenBytes);
+                        if (errorFlag.good())
+                        {
+                            DcmOutputBlock blocks[2];
+                            blocks[0].data = header;
+                            blocks[0].length = writtenBytes;
+                            blocks[1].data = value;
+                            blocks[1].length = getLengthField();
+                            const offile_off_t len = outStream.writeBlocks(blocks, 2);
+
+                            /* tag and length are always written "en bloc" (see avail() check above), */
+                            /* remember how many bytes of the value have been written as well */
+                            setTransferState(ERW_inWork);
+                            setTransferredBytes((len > OFstatic_cast(offile_off_t, writtenBytes)) ? OFstatic_cast(Uint32, len - writtenBytes) : 0);
+                            errorFlag = outStream.status();
+                        }
+                        else if (writtenBytes > 0)
+                        {
+                            /* write the incomplete header nevertheless (see writeTagAndLength()) */
+                            outStream.write(header, writtenBytes);
+                        }
+                    }
+                    else
+                    {
+                        /* write tag and length information (and possibly also data type information) to the stream, */
+                        /* mind the transfer syntax and remember the amount of bytes that have been written */
+                        errorFlag = writeTagAndLength(outStream, oxfer, writtenBytes);
+
+                        /* if the writing was successful, set this element's transfer */
+                        /* state to ERW_inWork and the amount of transferred bytes to 0 */
+                        if (errorFlag.good())
+                        {
+                            setTransferState(ERW_inWork);
+                            setTransferredBytes(0);
+                        }
                     }
                 } else errorFlag = EC_StreamNotifyClient;
             }
@@ -1350,14 +1447,17 @@ OFCondition DcmElement::write(DcmOutputStream &outStream,
                 {
                     /* write as many bytes as possible to the stream starting at value[getTransferredBytes()] */
                     /* (note that the bytes value[0] to value[getTransferredBytes()-1] have already been */
-                    /* written to the stream) */
-                    len = OFstatic_cast(Uint32, outStream.write(&value[getTransferredBytes()], getLengthField() - getTransferredBytes()));
+                    /* written to the stream, possibly together with tag and length information) */
+                    if (getTransferredBytes() < getLengthField())
+                    {
+                        len = OFstatic_cast(Uint32, outStream.write(&value[getTransferredBytes()], getLengthField() - getTransferredBytes()));
 
-                    /* increase the amount of bytes which have been transferred correspondingly */
-                    incTransferredBytes(len);
+                        /* increase the amount of bytes which have been transferred correspondingly */
+                        incTransferredBytes(len);
 
-                    /* see if there is something fishy with the stream */
-                    errorFlag = outStream.status();
+                        /* see if there is something fishy with the stream */
+                        errorFlag = outStream.status();
+                    }
                 }
                 else
                 {
@@ -1686,19 +1786,68 @@ OFCondition DcmElement::getPartialValue(void *targetBuffer,
   if (valueLoaded())
   {
     // the attribute value is already in memory.
-    // change internal byte order of the attribute value to the desired byte order.
-    // This should only happen once for multiple calls to this method since the
-    // caller will hopefully always request the same byte order.
-    char *value = OFstatic_cast(char *, getValue(byteOrder));
-    if (value)
+    // this should never happen because valueLoaded() returned true, but
+    // we don't want to dereference a NULL pointer anyway
+    if ((fValue == NULL) || (byteOrder == EBO_unknown)) return EC_IllegalCall;
+
+    const size_t valueWidth = getTag().getVR().getValueWidth();
+    if ((byteOrder == fByteOrder) || (valueWidth <= 1))
     {
-      memcpy(targetBuffer, value + offset, numBytes);
+      memcpy(targetBuffer, fValue + offset, numBytes);
     }
     else
     {
-      // this should never happen because valueLoaded() returned true, but
-      // we don't want to dereference a NULL pointer anyway
-      return EC_IllegalCall;
+      // copy the requested bytes to the target buffer and swap them to the
+      // desired byte order on the way. This leaves the byte order of the
+      // attribute value unchanged and avoids swapping the complete value
+      // in memory for each change of the requested byte order.
+      unsigned char swapBuffer[SWAPBUFFER_SIZE];
+      if (valueWidth > SWAPBUFFER_SIZE) return EC_IllegalCall;
+
+      Uint8 *targetBufferChar = OFreinterpret_cast(Uint8 *, targetBuffer);
+      Uint32 position = offset;
+
+      // the bytes of a value at the end of the value field that is only
+      // partially contained in it are never swapped (see swapIfNecessary())
+      const Uint32 swapLimit = OFstatic_cast(Uint32, getLengthField() - getLengthField() % valueWidth);
+
+      // check if the first few bytes we want to copy are "in the middle" of
+      // one value of a multi-valued attribute. In that case we need to swap
+      // the complete value and then copy only the last bytes.
+      const Uint32 partialoffset = OFstatic_cast(Uint32, offset % valueWidth);
+      if ((partialoffset > 0) && (position - partialoffset + valueWidth <= swapLimit))
+      {
+        swapBytes(fValue + position - partialoffset, swapBuffer, OFstatic_cast(Uint32, valueWidth), valueWidth);
+        Uint32 partialvalue = OFstatic_cast(Uint32, valueWidth - partialoffset);
+        if (partialvalue > numBytes) partialvalue = numBytes;
+        memcpy(targetBufferChar, &swapBuffer[partialoffset], partialvalue);
+        targetBufferChar += partialvalue;
+        position += partialvalue;
+        numBytes -= partialvalue;
+      }
+
+      // now swap the main block of complete values directly into the target buffer
+      if ((numBytes > 0) && (position < swapLimit))
+      {
+        Uint32 bytesToSwap = swapLimit - position;
+        if (bytesToSwap > numBytes) bytesToSwap = numBytes;
+        bytesToSwap -= OFstatic_cast(Uint32, bytesToSwap % valueWidth);
+        swapBytes(fValue + position, targetBufferChar, bytesToSwap, valueWidth);
+        targetBufferChar += bytesToSwap;
+        position += bytesToSwap;
+        numBytes -= bytesToSwap;
+      }
+
+      // check if the last few bytes we want to copy are only a partial value.
+      // In that case we need to swap the complete value and then copy only
+      // the first few bytes.
+      if ((numBytes > 0) && (position + valueWidth <= swapLimit))
+      {
+        swapBytes(fValue + position, swapBuffer, OFstatic_cast(Uint32, valueWidth), valueWidth);
+        memcpy(targetBufferChar, swapBuffer, numBytes);
+      }
+      else if (numBytes > 0)
+        memcpy(targetBufferChar, fValue + position, numBytes);
     }
   }
   else
@@ -1740,11 +1889,13 @@ OFCondition DcmElement::getPartialValue(void *targetBuffer,
     {
       readStream = cache->getStream();
 
-      // since we cannot seek back in the stream (only forward), check if the stream
-      // is already past our needed start position
+      // check if the stream is already past our needed start position.
+      // If the stream cannot seek back (e.g. because it is compressed),
+      // a new stream has to be created.
       if (readStream->tell() - cache->getOffset() > seekoffset)
       {
-        readStream = NULL;
+        if (!readStream->isSeekable() || readStream->seek(cache->getOffset() + seekoffset).bad())
+          readStream = NULL;
       }
     }
 
@@ -1896,8 +2047,7 @@ void DcmElement::compact()
   {
     DCMDATA_DEBUG("DcmElement::compact() removed element value of " << getTag()
         << " with " << getTransferredBytes() << " bytes");
-    delete[] fValue;
-    fValue = NULL;
+    freeValueField();
     setTransferredBytes(0);
   }
 }
@@ -1909,10 +2059,7 @@ OFCondition DcmElement::createValueFromTempFile(DcmInputStreamFactory *factory,
 {
     if (factory && !(length & 1))
     {
-        // if created with the nothrow version it must also be deleted with
-        // the nothrow version else memory error.
-        operator delete[] (fValue, std::nothrow);
-        fValue = 0;
+        freeValueField();
         delete fLoadValue;
         fLoadValue = factory;
         fByteOrder = byteOrder;
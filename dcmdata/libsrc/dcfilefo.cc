@@ -39,6 +39,7 @@
 #include "dcmtk/dcmdata/dcuid.h"
 #include "dcmtk/dcmdata/dcistrma.h"    /* for class DcmInputStream */
 #include "dcmtk/dcmdata/dcistrmf.h"    /* for class DcmInputFileStream */
+#include "dcmtk/dcmdata/dcistrmm.h"    /* for class DcmInputMappedFileStream */
 #include "dcmtk/dcmdata/dcistrms.h"    /* for class DcmStdinStream */
 #include "dcmtk/dcmdata/dcostrma.h"    /* for class DcmOutputStream */
 #include "dcmtk/dcmdata/dcostrmf.h"    /* for class DcmOutputFileStream */
@@ -55,7 +56,8 @@ DcmFileFormat::DcmFileFormat()
     FileReadMode(ERM_autoDetect),
     ImplementationClassUID(OFFIS_IMPLEMENTATION_CLASS_UID),
     ImplementationVersionName(OFFIS_DTK_IMPLEMENTATION_VERSION_NAME),
-    MaxNestingDepth(0)
+    MaxNestingDepth(0),
+    ArenaAllocation(OFFalse)
 {
     DcmMetaInfo *MetaInfo = new DcmMetaInfo();
     DcmSequenceOfItems::itemList->insert(MetaInfo);
@@ -73,7 +75,8 @@ DcmFileFormat::DcmFileFormat(DcmDataset *dataset,
     FileReadMode(ERM_autoDetect),
     ImplementationClassUID(OFFIS_IMPLEMENTATION_CLASS_UID),
     ImplementationVersionName(OFFIS_DTK_IMPLEMENTATION_VERSION_NAME),
-    MaxNestingDepth(0)
+    MaxNestingDepth(0),
+    ArenaAllocation(OFFalse)
 {
     DcmMetaInfo *MetaInfo = new DcmMetaInfo();
     if (DcmSequenceOfItems::itemList->insert(MetaInfo))
@@ -108,7 +111,8 @@ DcmFileFormat::DcmFileFormat(const DcmFileFormat &old)
     FileReadMode(old.FileReadMode),
     ImplementationClassUID(old.ImplementationClassUID),
     ImplementationVersionName(old.ImplementationVersionName),
-    MaxNestingDepth(old.MaxNestingDepth)
+    MaxNestingDepth(old.MaxNestingDepth),
+    ArenaAllocation(old.ArenaAllocation)
 {
 }
 
@@ -138,6 +142,7 @@ DcmFileFormat &DcmFileFormat::operator=(const DcmFileFormat &obj)
         ImplementationClassUID = obj.ImplementationClassUID;
         ImplementationVersionName = obj.ImplementationVersionName;
         MaxNestingDepth = obj.MaxNestingDepth;
+        ArenaAllocation = obj.ArenaAllocation;
     }
     return *this;
 }
@@ -955,6 +960,13 @@ OFCondition DcmFileFormat::loadFileUntilTag(
                                     const E_FileReadMode readMode,
                                     const DcmTagKey &stopParsingAtElement)
 {
+    /* if requested, allocate the objects created while parsing from a new arena, */
+    /* which is kept alive by these objects, i.e. freed together with the last of them */
+    DcmArena *arena = ArenaAllocation ? DcmArena::newInstance() : NULL;
+    DcmArenaScope arenaScope(arena);
+    if (arena)
+        arena->decreaseRefCount();  /* now referenced by the scope only */
+
     if (readMode == ERM_dataset)
         return getDataset()->loadFileUntilTag(fileName, readXfer, groupLength, maxReadLength, stopParsingAtElement);
 
@@ -997,14 +1009,25 @@ OFCondition DcmFileFormat::loadFileUntilTag(
             }
 
         } else {
-            /* open file for output */
-            DcmInputFileStream fileStream(fileName);
+            /* open file for input, use a memory-mapped file if requested and possible */
+            DcmInputStream *fileStream = NULL;
+            if (dcmUseMemoryMappedFileInput.get() && DcmFileMapping::isSupported())
+            {
+                fileStream = new DcmInputMappedFileStream(fileName);
+                if (fileStream->status().bad())
+                {
+                    delete fileStream;
+                    fileStream = NULL;
+                }
+            }
+            if (fileStream == NULL)
+                fileStream = new DcmInputFileStream(fileName);
             /* apply configured nesting depth limit */
             if (MaxNestingDepth > 0)
-                fileStream.setMaxNestingDepth(MaxNestingDepth);
+                fileStream->setMaxNestingDepth(MaxNestingDepth);
 
             /* check stream status */
-            l_error = fileStream.status();
+            l_error = fileStream->status();
             if (l_error.good())
             {
                 /* clear this object */
@@ -1016,12 +1039,13 @@ OFCondition DcmFileFormat::loadFileUntilTag(
                     FileReadMode = readMode;
                     /* read data from file */
                     transferInit();
-                    l_error = readUntilTag(fileStream, readXfer, groupLength, maxReadLength, stopParsingAtElement);
+                    l_error = readUntilTag(*fileStream, readXfer, groupLength, maxReadLength, stopParsingAtElement);
                     transferEnd();
                     /* restore old value */
                     FileReadMode = oldMode;
                 }
             }
+            delete fileStream;
         }
     }
     return l_error;
@@ -0,0 +1,274 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: base class for encoders compressing multiple frames concurrently
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/dcmdata/dcfrmenc.h"
+#include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/ofvector.h"
+
+
+#ifdef WITH_THREADS
+
+/* state shared by all threads that compress frames for
+ * DcmConcurrentFrameEncoder::encodeFrames()
+ */
+class DcmConcurrentFrameEncoderJob
+{
+public:
+    DcmConcurrentFrameEncoderJob(
+        DcmConcurrentFrameEncoder &encoder,
+        Uint32 numFrames,
+        DcmPixelSequence *pixelSequence,
+        DcmOffsetList &offsetList,
+        Uint32 fragmentSize)
+      : encoder_(encoder)
+      , numFrames_(numFrames)
+      , pixelSequence_(pixelSequence)
+      , offsetList_(offsetList)
+      , fragmentSize_(fragmentSize)
+      , mutex_()
+      , nextFrame_(0)
+      , nextFrameToStore_(0)
+      , compressedFrames_(numFrames, OFstatic_cast(Uint8 *, NULL))
+      , compressedLengths_(numFrames, 0)
+      , compressedSize_(0)
+      , result_(EC_Normal)
+    {
+    }
+
+    ~DcmConcurrentFrameEncoderJob()
+    {
+        // frames that have not been stored because of an error
+        for (Uint32 i = nextFrameToStore_; i < numFrames_; ++i)
+            delete[] compressedFrames_[i];
+    }
+
+    /* compresses frames until all frames have been processed or an error
+     * has occurred. Called by each thread with a distinct thread number.
+     */
+    void encodeFrames(Uint32 threadNo)
+    {
+        Uint32 frame = 0;
+        while (nextFrame(frame))
+        {
+            Uint8 *compressedData = NULL;
+            Uint32 compressedLen = 0;
+            OFCondition result = encoder_.encodeFrame(frame, threadNo, compressedData, compressedLen);
+            if (result.good() && (compressedData == NULL)) result = EC_IllegalCall;
+            mutex_.lock();
+            if (result.good() && result_.good())
+            {
+                compressedFrames_[frame] = compressedData;
+                compressedLengths_[frame] = compressedLen;
+                // store all consecutive frames that are available, in frame order
+                while (result_.good() && (nextFrameToStore_ < numFrames_) && (compressedFrames_[nextFrameToStore_] != NULL))
+                {
+                    result_ = pixelSequence_->storeCompressedFrame(offsetList_, compressedFrames_[nextFrameToStore_],
+                        compressedLengths_[nextFrameToStore_], fragmentSize_);
+                    compressedSize_ += compressedLengths_[nextFrameToStore_];
+                    delete[] compressedFrames_[nextFrameToStore_];
+                    compressedFrames_[nextFrameToStore_++] = NULL;
+                }
+            }
+            else
+            {
+                // stop all threads, and report the first error encountered
+                delete[] compressedData;
+                if (result_.good()) result_ = result;
+            }
+            if (result_.bad()) nextFrame_ = numFrames_;
+            mutex_.unlock();
+        }
+    }
+
+    /* returns the result of the compression */
+    OFCondition result() const { return result_; }
+
+    /* returns the total number of compressed bytes stored */
+    size_t compressedSize() const { return compressedSize_; }
+
+private:
+
+    /* private undefined copy constructor */
+    DcmConcurrentFrameEncoderJob(const DcmConcurrentFrameEncoderJob &);
+
+    /* private undefined copy assignment operator */
+    DcmConcurrentFrameEncoderJob &operator=(const DcmConcurrentFrameEncoderJob &);
+
+    /* determines the next frame to be processed */
+    OFBool nextFrame(Uint32 &frame)
+    {
+        mutex_.lock();
+        const OFBool result = (nextFrame_ < numFrames_);
+        if (result) frame = nextFrame_++;
+        mutex_.unlock();
+        return result;
+    }
+
+    /* the encoder compressing the individual frames */
+    DcmConcurrentFrameEncoder &encoder_;
+
+    /* number of frames to be compressed */
+    const Uint32 numFrames_;
+
+    /* pixel sequence to which the compressed frames are appended */
+    DcmPixelSequence *pixelSequence_;
+
+    /* list of offsets, one entry per stored frame */
+    DcmOffsetList &offsetList_;
+
+    /* maximum fragment size (in kbytes), 0 for unlimited */
+    const Uint32 fragmentSize_;
+
+    /* mutex protecting the following members and the pixel sequence */
+    OFMutex mutex_;
+
+    /* next frame to be compressed */
+    Uint32 nextFrame_;
+
+    /* next frame to be stored in the pixel sequence */
+    Uint32 nextFrameToStore_;
+
+    /* compressed frames that have not yet been stored, NULL otherwise */
+    OFVector<Uint8 *> compressedFrames_;
+
+    /* lengths of the compressed frames */
+    OFVector<Uint32> compressedLengths_;
+
+    /* total number of compressed bytes stored */
+    size_t compressedSize_;
+
+    /* result of the compression */
+    OFCondition result_;
+};
+
+
+/* worker thread for DcmConcurrentFrameEncoder::encodeFrames() */
+class DcmConcurrentFrameEncoderThread: public OFThread
+{
+public:
+    DcmConcurrentFrameEncoderThread(DcmConcurrentFrameEncoderJob &job, Uint32 threadNo)
+      : OFThread()
+      , job_(job)
+      , threadNo_(threadNo)
+    {
+    }
+
+protected:
+
+    virtual void run()
+    {
+        job_.encodeFrames(threadNo_);
+    }
+
+private:
+
+    /* private undefined copy constructor */
+    DcmConcurrentFrameEncoderThread(const DcmConcurrentFrameEncoderThread &);
+
+    /* private undefined copy assignment operator */
+    DcmConcurrentFrameEncoderThread &operator=(const DcmConcurrentFrameEncoderThread &);
+
+    /* the job this thread is working on */
+    DcmConcurrentFrameEncoderJob &job_;
+
+    /* number of this thread */
+    const Uint32 threadNo_;
+};
+
+#endif
+
+
+DcmConcurrentFrameEncoder::DcmConcurrentFrameEncoder(Uint32 numThreads)
+: numThreads_(numThreads > 1 ? numThreads : 1)
+{
+#ifndef WITH_THREADS
+    // without thread support, all frames are compressed by the calling thread
+    numThreads_ = 1;
+#endif
+}
+
+
+DcmConcurrentFrameEncoder::~DcmConcurrentFrameEncoder()
+{
+}
+
+
+OFCondition DcmConcurrentFrameEncoder::encodeFrames(
+    Uint32 numFrames,
+    DcmPixelSequence *pixelSequence,
+    DcmOffsetList &offsetList,
+    Uint32 fragmentSize,
+    size_t &compressedSize)
+{
+    compressedSize = 0;
+    if (pixelSequence == NULL) return EC_IllegalCall;
+
+    OFCondition result = EC_Normal;
+#ifdef WITH_THREADS
+    if ((numThreads_ > 1) && (numFrames > 1))
+    {
+        const Uint32 numThreads = (numThreads_ > numFrames) ? numFrames : numThreads_;
+        DCMDATA_DEBUG("DcmConcurrentFrameEncoder: compressing " << numFrames << " frames using " << numThreads << " threads");
+        DcmConcurrentFrameEncoderJob job(*this, numFrames, pixelSequence, offsetList, fragmentSize);
+        OFVector<DcmConcurrentFrameEncoderThread *> threads;
+        for (Uint32 i = 1; i < numThreads; ++i)
+        {
+            DcmConcurrentFrameEncoderThread *thread = new DcmConcurrentFrameEncoderThread(job, i);
+            if (thread->start() == 0)
+                threads.push_back(thread);
+            else
+            {
+                // continue with the threads started so far
+                DCMDATA_WARN("DcmConcurrentFrameEncoder: cannot create thread, continuing with " << threads.size() + 1 << " threads");
+                delete thread;
+                break;
+            }
+        }
+        // the calling thread participates as thread number 0
+        job.encodeFrames(0);
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i]->join();
+            delete threads[i];
+        }
+        compressedSize = job.compressedSize();
+        return job.result();
+    }
+#endif
+
+    Uint8 *compressedData = NULL;
+    Uint32 compressedLen = 0;
+    for (Uint32 frame = 0; (frame < numFrames) && result.good(); ++frame)
+    {
+        compressedData = NULL;
+        compressedLen = 0;
+        result = encodeFrame(frame, 0, compressedData, compressedLen);
+        if (result.good())
+        {
+            result = pixelSequence->storeCompressedFrame(offsetList, compressedData, compressedLen, fragmentSize);
+            compressedSize += compressedLen;
+        }
+        delete[] compressedData;
+    }
+    return result;
+}
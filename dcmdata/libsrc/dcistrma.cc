@@ -75,11 +75,41 @@ offile_off_t DcmInputStream::skip(offile_off_t skiplen)
   return result;
 }
 
+Uint8 *DcmInputStream::mapBlock(offile_off_t num, DcmFileMapping *&mapping)
+{
+  Uint8 *result = current_->mapBlock(num, mapping);
+  if (result) tell_ += num;
+  return result;
+}
+
 offile_off_t DcmInputStream::tell() const
 {
   return tell_;
 }
 
+OFBool DcmInputStream::isSeekable() const
+{
+  return (compressionFilter_ == NULL) && current_->isSeekable();
+}
+
+OFCondition DcmInputStream::seek(offile_off_t pos)
+{
+  if (pos < 0) return EC_IllegalCall;
+  if (pos < tell_)
+  {
+    // moving backwards requires a producer that permits arbitrary putback
+    if (! isSeekable()) return EC_IllegalCall;
+    current_->putback(tell_ - pos);
+    if (current_->good()) tell_ = pos;
+    return current_->status();
+  }
+  while (tell_ < pos)
+  {
+    if (skip(pos - tell_) == 0) return EC_InvalidStream;
+  }
+  return EC_Normal;
+}
+
 void DcmInputStream::mark()
 {
   mark_ = tell_;
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2010, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -36,6 +36,7 @@ DcmBufferProducer::DcmBufferProducer()
 , backupStart_(DCMBUFFERPRODUCER_BUFSIZE)
 , status_(EC_Normal)
 , eosflag_(OFFalse)
+, source_(NULL)
 {
   if (!backup_) status_ = EC_MemoryExhausted;
 }
@@ -103,6 +104,35 @@ offile_off_t DcmBufferProducer::read(void *buf, offile_off_t buflen)
       memcpy(target, buffer_ + bufIndex_, OFstatic_cast(size_t, numbytes));
       bufIndex_ += numbytes;
       result += numbytes;
+      target += numbytes;
+      buflen -= numbytes;
+    }
+
+    if (buflen && source_ && !eosflag_)
+    {
+      // both buffers have been read completely, let the source deliver
+      // further data directly into the caller's memory block
+      OFBool direct = OFFalse;
+      while (buflen && !eosflag_)
+      {
+        offile_off_t numbytes = source_->readDirect(target, buflen, eosflag_);
+        if ((numbytes == 0) && !eosflag_) break;
+        direct = OFTrue;
+        result += numbytes;
+        target += numbytes;
+        buflen -= numbytes;
+      }
+
+      if (direct)
+      {
+        // the content of both buffers precedes the data read directly,
+        // i.e. it cannot be used for putback operations any more
+        buffer_ = NULL;
+        bufSize_ = 0;
+        bufIndex_ = 0;
+        backupIndex_ = DCMBUFFERPRODUCER_BUFSIZE;
+        backupStart_ = DCMBUFFERPRODUCER_BUFSIZE;
+      }
     }
   }
   return result;
@@ -281,6 +311,11 @@ void DcmBufferProducer::setEos()
   eosflag_ = OFTrue;
 }
 
+void DcmBufferProducer::setSource(DcmBufferSource *source)
+{
+  source_ = source;
+}
+
 /* ======================================================================= */
 
 DcmInputBufferStream::DcmInputBufferStream()
@@ -324,3 +359,8 @@ void DcmInputBufferStream::setEos()
 {
   producer_.setEos();
 }
+
+void DcmInputBufferStream::setSource(DcmBufferSource *source)
+{
+  producer_.setSource(source);
+}
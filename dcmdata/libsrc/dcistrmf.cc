@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2025, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -24,6 +24,7 @@
 #include "dcmtk/dcmdata/dcistrmf.h"
 #include "dcmtk/dcmdata/dcistrmb.h"
 #include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/dcmdata/dcobject.h"  /* for dcmFileHandlePoolSize */
 
 BEGIN_EXTERN_C
 #include <fcntl.h>
@@ -32,34 +33,147 @@ BEGIN_EXTERN_C
 #endif
 END_EXTERN_C
 
+DcmFileHandlePool::DcmFileHandlePool(const OFFilename &filename)
+#ifdef WITH_THREADS
+: refCount_(1), mutex_(), filename_(filename), idle_()
+#else
+: refCount_(1), filename_(filename), idle_()
+#endif
+{
+}
+
+DcmFileHandlePool::~DcmFileHandlePool()
+{
+  for (size_t i = 0; i < idle_.size(); ++i) delete idle_[i];
+}
+
+DcmFileHandlePool *DcmFileHandlePool::newInstance(const OFFilename &filename)
+{
+  return new DcmFileHandlePool(filename);
+}
+
+OFFile *DcmFileHandlePool::acquire(OFCondition &status)
+{
+  OFFile *file = NULL;
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  if (!idle_.empty())
+  {
+    file = idle_.back();
+    idle_.pop_back();
+  }
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+  status = EC_Normal;
+  if (file == NULL)
+  {
+    file = new OFFile();
+    if (!file->fopen(filename_, "rb"))
+    {
+      OFString s("(unknown error code)");
+      file->getLastErrorString(s);
+      status = makeOFCondition(OFM_dcmdata, 18, OF_error, s.c_str());
+      delete file;
+      file = NULL;
+    }
+  }
+  return file;
+}
+
+void DcmFileHandlePool::release(OFFile *file)
+{
+  if (file)
+  {
+    OFBool keep = OFFalse;
+    if (file->open() && !file->error())
+    {
+      // reset a possible end-of-file indicator before the handle is reused
+      file->clearerr();
+#ifdef WITH_THREADS
+      mutex_.lock();
+#endif
+      if (idle_.size() < dcmFileHandlePoolSize.get())
+      {
+        idle_.push_back(file);
+        keep = OFTrue;
+      }
+#ifdef WITH_THREADS
+      mutex_.unlock();
+#endif
+    }
+    if (!keep) delete file;
+  }
+}
+
+void DcmFileHandlePool::increaseRefCount()
+{
+#ifdef WITH_THREADS
+    mutex_.lock();
+#endif
+    ++refCount_;
+#ifdef WITH_THREADS
+    mutex_.unlock();
+#endif
+}
+
+void DcmFileHandlePool::decreaseRefCount()
+{
+#ifdef WITH_THREADS
+    mutex_.lock();
+#endif
+    size_t result = --refCount_;
+#ifdef WITH_THREADS
+    mutex_.unlock();
+#endif
+    if (result == 0) delete this;
+}
+
+/* ======================================================================= */
+
 DcmFileProducer::DcmFileProducer(const OFFilename &filename, offile_off_t offset)
 : DcmProducer()
-, file_()
+, pool_(DcmFileHandlePool::newInstance(filename))
+, file_(NULL)
 , status_(EC_Normal)
 , size_(0)
 {
-  if (file_.fopen(filename, "rb"))
+  open(offset);
+}
+
+DcmFileProducer::DcmFileProducer(DcmFileHandlePool *pool, offile_off_t offset)
+: DcmProducer()
+, pool_(pool)
+, file_(NULL)
+, status_(EC_Normal)
+, size_(0)
+{
+  pool_->increaseRefCount();
+  open(offset);
+}
+
+void DcmFileProducer::open(offile_off_t offset)
+{
+  file_ = pool_->acquire(status_);
+  if (file_)
   {
      // Get number of bytes in file
-     file_.fseek(0L, SEEK_END);
-     size_ =  file_.ftell();
-     if (0 != file_.fseek(offset, SEEK_SET))
+     file_->fseek(0L, SEEK_END);
+     size_ =  file_->ftell();
+     if (0 != file_->fseek(offset, SEEK_SET))
      {
        OFString s("(unknown error code)");
-       file_.getLastErrorString(s);
+       file_->getLastErrorString(s);
        status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, s.c_str());
      }
   }
-  else
-  {
-    OFString s("(unknown error code)");
-    file_.getLastErrorString(s);
-    status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, s.c_str());
-  }
 }
 
 DcmFileProducer::~DcmFileProducer()
 {
+  pool_->release(file_);
+  pool_->decreaseRefCount();
 }
 
 OFBool DcmFileProducer::good() const
@@ -74,24 +188,24 @@ OFCondition DcmFileProducer::status() const
 
 OFBool DcmFileProducer::eos()
 {
-  if (file_.open())
+  if (file_ && file_->open())
   {
-    return (file_.eof() || (size_ == file_.ftell()));
+    return (file_->eof() || (size_ == file_->ftell()));
   }
   else return OFTrue;
 }
 
 offile_off_t DcmFileProducer::avail()
 {
-  if (file_.open()) return size_ - file_.ftell(); else return 0;
+  if (file_ && file_->open()) return size_ - file_->ftell(); else return 0;
 }
 
 offile_off_t DcmFileProducer::read(void *buf, offile_off_t buflen)
 {
   offile_off_t result = 0;
-  if (status_.good() && file_.open() && buf && buflen)
+  if (status_.good() && file_ && file_->open() && buf && buflen)
   {
-    result = OFstatic_cast(offile_off_t, file_.fread(buf, 1, OFstatic_cast(size_t, buflen)));
+    result = OFstatic_cast(offile_off_t, file_->fread(buf, 1, OFstatic_cast(size_t, buflen)));
   }
   return result;
 }
@@ -99,14 +213,14 @@ offile_off_t DcmFileProducer::read(void *buf, offile_off_t buflen)
 offile_off_t DcmFileProducer::skip(offile_off_t skiplen)
 {
   offile_off_t result = 0;
-  if (status_.good() && file_.open() && skiplen)
+  if (status_.good() && file_ && file_->open() && skiplen)
   {
-    offile_off_t pos = file_.ftell();
+    offile_off_t pos = file_->ftell();
     result = (size_ - pos < skiplen) ? (size_ - pos) : skiplen;
-    if (file_.fseek(result, SEEK_CUR))
+    if (file_->fseek(result, SEEK_CUR))
     {
       OFString s("(unknown error code)");
-      file_.getLastErrorString(s);
+      file_->getLastErrorString(s);
       status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, s.c_str());
     }
   }
@@ -115,15 +229,15 @@ offile_off_t DcmFileProducer::skip(offile_off_t skiplen)
 
 void DcmFileProducer::putback(offile_off_t num)
 {
-  if (status_.good() && file_.open() && num)
+  if (status_.good() && file_ && file_->open() && num)
   {
-    offile_off_t pos = file_.ftell();
+    offile_off_t pos = file_->ftell();
     if (num <= pos)
     {
-      if (file_.fseek(-num, SEEK_CUR))
+      if (file_->fseek(-num, SEEK_CUR))
       {
         OFString s("(unknown error code)");
-        file_.getLastErrorString(s);
+        file_->getLastErrorString(s);
         status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, s.c_str());
       }
     }
@@ -138,22 +252,36 @@ DcmInputFileStreamFactory::DcmInputFileStreamFactory(const OFFilename &filename,
 : DcmInputStreamFactory()
 , filename_(filename)
 , offset_(offset)
+, pool_(NULL)
+{
+}
+
+DcmInputFileStreamFactory::DcmInputFileStreamFactory(DcmFileHandlePool *pool, offile_off_t offset)
+: DcmInputStreamFactory()
+, filename_(pool->getFilename())
+, offset_(offset)
+, pool_(pool)
 {
+  pool_->increaseRefCount();
 }
 
 DcmInputFileStreamFactory::DcmInputFileStreamFactory(const DcmInputFileStreamFactory& arg)
 : DcmInputStreamFactory(arg)
 , filename_(arg.filename_)
 , offset_(arg.offset_)
+, pool_(arg.pool_)
 {
+  if (pool_) pool_->increaseRefCount();
 }
 
 DcmInputFileStreamFactory::~DcmInputFileStreamFactory()
 {
+  if (pool_) pool_->decreaseRefCount();
 }
 
 DcmInputStream *DcmInputFileStreamFactory::create() const
 {
+  if (pool_) return new DcmInputFileStream(pool_, offset_);
   return new DcmInputFileStream(filename_, offset_);
 }
 
@@ -166,6 +294,13 @@ DcmInputFileStream::DcmInputFileStream(const OFFilename &filename, offile_off_t
 {
 }
 
+DcmInputFileStream::DcmInputFileStream(DcmFileHandlePool *pool, offile_off_t offset)
+: DcmInputStream(&producer_) // safe because DcmInputStream only stores pointer
+, producer_(pool, offset)
+, filename_(pool->getFilename())
+{
+}
+
 DcmInputFileStream::~DcmInputFileStream()
 {
 }
@@ -176,7 +311,7 @@ DcmInputStreamFactory *DcmInputFileStream::newFactory() const
   if (currentProducer() == &producer_)
   {
     // no filter installed, can create factory object
-    result = new DcmInputFileStreamFactory(filename_, tell());
+    result = new DcmInputFileStreamFactory(producer_.getPool(), tell());
   }
   return result;
 }
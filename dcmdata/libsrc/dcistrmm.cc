@@ -0,0 +1,309 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: DcmInputMappedFileStream and related classes,
+ *    implements streamed input from memory-mapped files.
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"
+#include "dcmtk/dcmdata/dcistrmm.h"
+#include "dcmtk/dcmdata/dcerror.h"
+#include "dcmtk/ofstd/ofstd.h"
+
+#include <cerrno>
+
+BEGIN_EXTERN_C
+#include <fcntl.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+END_EXTERN_C
+
+#ifdef HAVE_SYS_MMAN_H
+/* helper function that creates an error condition from the current value of errno */
+static OFCondition makeMappingError()
+{
+  char buf[256];
+  return makeOFCondition(OFM_dcmdata, 18, OF_error, OFStandard::strerror(errno, buf, sizeof(buf)));
+}
+#endif
+
+DcmFileMapping::DcmFileMapping(const OFFilename &filename, Uint8 *data, offile_off_t size)
+#ifdef WITH_THREADS
+: refCount_(1), mutex_(), filename_(filename), data_(data), size_(size)
+#else
+: refCount_(1), filename_(filename), data_(data), size_(size)
+#endif
+{
+}
+
+DcmFileMapping::~DcmFileMapping()
+{
+#ifdef HAVE_SYS_MMAN_H
+  munmap(data_, OFstatic_cast(size_t, size_));
+#endif
+}
+
+OFBool DcmFileMapping::isSupported()
+{
+#ifdef HAVE_SYS_MMAN_H
+  return OFTrue;
+#else
+  return OFFalse;
+#endif
+}
+
+DcmFileMapping *DcmFileMapping::newInstance(const OFFilename &filename, OFCondition &status)
+{
+  DcmFileMapping *result = NULL;
+#ifdef HAVE_SYS_MMAN_H
+  const char *fname = filename.getCharPointer();
+  if (fname == NULL)
+  {
+    status = EC_InvalidFilename;
+    return NULL;
+  }
+  int fd = open(fname, O_RDONLY);
+  if (fd < 0)
+  {
+    status = makeMappingError();
+    return NULL;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+    status = makeMappingError();
+  else if (st.st_size <= 0 || OFstatic_cast(Uint64, st.st_size) > OFstatic_cast(Uint64, OFstatic_cast(size_t, -1)))
+  {
+    // empty files cannot be mapped, and files larger than the address space
+    // cannot be mapped as a whole
+    status = EC_InvalidStream;
+  }
+  else
+  {
+    // map the file privately so that modifications of attribute values that
+    // reference the mapping (e.g. byte swapping) never reach the file
+    void *data = mmap(NULL, OFstatic_cast(size_t, st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+      status = makeMappingError();
+    else
+    {
+#ifdef MADV_SEQUENTIAL
+      // the parser reads the file front to back
+      (void) madvise(data, OFstatic_cast(size_t, st.st_size), MADV_SEQUENTIAL);
+#endif
+      result = new DcmFileMapping(filename, OFstatic_cast(Uint8 *, data), OFstatic_cast(offile_off_t, st.st_size));
+      status = EC_Normal;
+    }
+  }
+  // the mapping remains valid after the file descriptor is closed
+  close(fd);
+#else
+  (void) filename;
+  status = EC_IllegalCall;
+#endif
+  return result;
+}
+
+void DcmFileMapping::increaseRefCount()
+{
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  ++refCount_;
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+}
+
+void DcmFileMapping::decreaseRefCount()
+{
+#ifdef WITH_THREADS
+  mutex_.lock();
+#endif
+  size_t result = --refCount_;
+#ifdef WITH_THREADS
+  mutex_.unlock();
+#endif
+  if (result == 0) delete this;
+}
+
+/* ======================================================================= */
+
+DcmMappedFileProducer::DcmMappedFileProducer(const OFFilename &filename, offile_off_t offset)
+: DcmProducer()
+, mapping_(NULL)
+, status_(EC_Normal)
+, pos_(0)
+{
+  mapping_ = DcmFileMapping::newInstance(filename, status_);
+  if (mapping_) seek(offset);
+}
+
+DcmMappedFileProducer::DcmMappedFileProducer(DcmFileMapping *mapping, offile_off_t offset)
+: DcmProducer()
+, mapping_(mapping)
+, status_(EC_Normal)
+, pos_(0)
+{
+  if (mapping_)
+  {
+    mapping_->increaseRefCount();
+    seek(offset);
+  }
+  else status_ = EC_InvalidStream;
+}
+
+DcmMappedFileProducer::~DcmMappedFileProducer()
+{
+  if (mapping_) mapping_->decreaseRefCount();
+}
+
+void DcmMappedFileProducer::seek(offile_off_t offset)
+{
+  if (offset >= 0 && offset <= mapping_->size())
+    pos_ = offset;
+  else
+    status_ = makeOFCondition(OFM_dcmdata, 18, OF_error, "Invalid argument");
+}
+
+OFBool DcmMappedFileProducer::good() const
+{
+  return status_.good();
+}
+
+OFCondition DcmMappedFileProducer::status() const
+{
+  return status_;
+}
+
+OFBool DcmMappedFileProducer::eos()
+{
+  if (mapping_) return (pos_ == mapping_->size()); else return OFTrue;
+}
+
+offile_off_t DcmMappedFileProducer::avail()
+{
+  if (mapping_) return mapping_->size() - pos_; else return 0;
+}
+
+offile_off_t DcmMappedFileProducer::read(void *buf, offile_off_t buflen)
+{
+  offile_off_t result = 0;
+  if (status_.good() && mapping_ && buf && buflen)
+  {
+    result = (mapping_->size() - pos_ < buflen) ? (mapping_->size() - pos_) : buflen;
+    memcpy(buf, mapping_->data() + pos_, OFstatic_cast(size_t, result));
+    pos_ += result;
+  }
+  return result;
+}
+
+offile_off_t DcmMappedFileProducer::skip(offile_off_t skiplen)
+{
+  offile_off_t result = 0;
+  if (status_.good() && mapping_ && skiplen)
+  {
+    result = (mapping_->size() - pos_ < skiplen) ? (mapping_->size() - pos_) : skiplen;
+    pos_ += result;
+  }
+  return result;
+}
+
+void DcmMappedFileProducer::putback(offile_off_t num)
+{
+  if (status_.good() && mapping_ && num)
+  {
+    if (num <= pos_) pos_ -= num;
+    else status_ = EC_PutbackFailed; // tried to putback before start of file
+  }
+}
+
+Uint8 *DcmMappedFileProducer::mapBlock(offile_off_t num, DcmFileMapping *&mapping)
+{
+  Uint8 *result = NULL;
+  if (status_.good() && mapping_ && num > 0 && (mapping_->size() - pos_ >= num))
+  {
+    result = mapping_->data() + pos_;
+    mapping = mapping_;
+    pos_ += num;
+  }
+  return result;
+}
+
+/* ======================================================================= */
+
+DcmInputMappedFileStreamFactory::DcmInputMappedFileStreamFactory(DcmFileMapping *mapping, offile_off_t offset)
+: DcmInputStreamFactory()
+, mapping_(mapping)
+, offset_(offset)
+{
+  mapping_->increaseRefCount();
+}
+
+DcmInputMappedFileStreamFactory::DcmInputMappedFileStreamFactory(const DcmInputMappedFileStreamFactory& arg)
+: DcmInputStreamFactory(arg)
+, mapping_(arg.mapping_)
+, offset_(arg.offset_)
+{
+  mapping_->increaseRefCount();
+}
+
+DcmInputMappedFileStreamFactory::~DcmInputMappedFileStreamFactory()
+{
+  mapping_->decreaseRefCount();
+}
+
+DcmInputStream *DcmInputMappedFileStreamFactory::create() const
+{
+  return new DcmInputMappedFileStream(mapping_, offset_);
+}
+
+/* ======================================================================= */
+
+DcmInputMappedFileStream::DcmInputMappedFileStream(const OFFilename &filename, offile_off_t offset)
+: DcmInputStream(&producer_) // safe because DcmInputStream only stores pointer
+, producer_(filename, offset)
+{
+}
+
+DcmInputMappedFileStream::DcmInputMappedFileStream(DcmFileMapping *mapping, offile_off_t offset)
+: DcmInputStream(&producer_) // safe because DcmInputStream only stores pointer
+, producer_(mapping, offset)
+{
+}
+
+DcmInputMappedFileStream::~DcmInputMappedFileStream()
+{
+}
+
+DcmInputStreamFactory *DcmInputMappedFileStream::newFactory() const
+{
+  DcmInputStreamFactory *result = NULL;
+  if ((currentProducer() == &producer_) && producer_.getMapping())
+  {
+    // no filter installed, can create factory object
+    result = new DcmInputMappedFileStreamFactory(producer_.getMapping(), tell());
+  }
+  return result;
+}
@@ -1827,7 +1827,24 @@ OFCondition DcmItem::insert(DcmElement *elem,
     {
         DcmElement *dE;
         E_ListPos seekmode = ELP_last;
-        /* iterate through elementList (from the last element to the first) */
+        /* elements are usually appended at the end (e.g. while reading), otherwise */
+        /* determine the insert position by binary search instead of a linear scan */
+        if (elementList->card() > 1)
+        {
+            dE = OFstatic_cast(DcmElement *, elementList->seek(ELP_last));
+            if (elem->getTag() < dE->getTag().getTagKey())
+            {
+                /* find the first element whose tag is not less than the new one */
+                unsigned long pos = findPosition(elem->getTag());
+                /* start with the element before that position (if any), or with the */
+                /* element at that position if it has the same tag as the new one */
+                if ((pos > 0) && (elem->getTag() != elementList->seek_to(pos)->getTag().getTagKey()))
+                    --pos;
+                elementList->seek_to(pos);
+                seekmode = ELP_atpos;
+            }
+        }
+        /* iterate through elementList (from the current element to the first) */
         do {
             /* get current element from elementList */
             dE = OFstatic_cast(DcmElement *, elementList->seek(seekmode));
@@ -1989,7 +2006,8 @@ DcmObject *DcmItem::nextInContainer(const DcmObject *obj)
         return elementList->get(ELP_first);
     else
     {
-        if (elementList->get() != obj)
+        /* try to locate the object by its tag first */
+        if ((elementList->get() != obj) && (findElement(obj->getTag()) != obj))
         {
             for(DcmObject * search_obj = elementList->seek(ELP_first);
                 search_obj && search_obj != obj;
@@ -2069,7 +2087,14 @@ DcmElement *DcmItem::remove(const unsigned long num)
 DcmElement *DcmItem::remove(DcmObject *elem)
 {
     errorFlag = EC_IllegalCall;
-    if (!elementList->empty() && elem != NULL)
+    if (elem != NULL && findElement(elem->getTag()) == elem)
+    {
+        /* object found by its tag, which is the usual case */
+        elementList->remove();     // removes element from list but does not delete it
+        elem->setParent(NULL);     // forget about the parent
+        errorFlag = EC_Normal;
+    }
+    else if (!elementList->empty() && elem != NULL)
     {
         DcmObject *dO;
         elementList->seek(ELP_first);
@@ -2097,20 +2122,12 @@ DcmElement *DcmItem::remove(DcmObject *elem)
 DcmElement *DcmItem::remove(const DcmTagKey &tag)
 {
     errorFlag = EC_TagNotFound;
-    DcmObject *dO = NULL;
-    if (!elementList->empty())
+    DcmObject *dO = findElement(tag);
+    if (dO != NULL)
     {
-        elementList->seek(ELP_first);
-        do {
-            dO = elementList->get();
-            if (dO->getTag() == tag)
-            {
-                elementList->remove();     // removes element from list but does not delete it
-                dO->setParent(NULL);       // forget about the parent
-                errorFlag = EC_Normal;
-                break;
-            }
-        } while (elementList->seek(ELP_next));
+        elementList->remove();     // removes element from list but does not delete it
+        dO->setParent(NULL);       // forget about the parent
+        errorFlag = EC_Normal;
     }
 
     if (errorFlag == EC_TagNotFound)
@@ -2178,7 +2195,18 @@ OFCondition DcmItem::searchSubFromHere(const DcmTagKey &tag,
 {
     DcmObject *dO;
     OFCondition l_error = EC_TagNotFound;
-    if (!elementList->empty())
+    if (!searchIntoSub)
+    {
+        /* non-recursive search, the element list is sorted by tag */
+        dO = findElement(tag);
+        if (dO != NULL)
+        {
+            resultStack.push(dO);
+            l_error = EC_Normal;
+            DCMDATA_TRACE("DcmItem::searchSubFromHere() Element " << tag << " found");
+        }
+    }
+    else if (!elementList->empty())
     {
         elementList->seek(ELP_first);
         do {
@@ -2212,6 +2240,42 @@ OFCondition DcmItem::searchSubFromHere(const DcmTagKey &tag,
 // ********************************
 
 
+unsigned long DcmItem::findPosition(const DcmTagKey &tag)
+{
+    /* binary search (lower bound) on the sorted element list */
+    unsigned long first = 0;
+    unsigned long count = elementList->card();
+    while (count > 0)
+    {
+        const unsigned long step = count / 2;
+        if (elementList->seek_to(first + step)->getTag() < tag)
+        {
+            first += step + 1;
+            count -= step + 1;
+        } else
+            count = step;
+    }
+    return first;
+}
+
+
+DcmObject *DcmItem::findElement(const DcmTagKey &tag)
+{
+    DcmObject *dO = NULL;
+    const unsigned long pos = findPosition(tag);
+    if (pos < elementList->card())
+    {
+        dO = elementList->seek_to(pos);
+        if (dO->getTag() != tag)
+            dO = NULL;
+    }
+    return dO;
+}
+
+
+// ********************************
+
+
 OFCondition DcmItem::search(const DcmTagKey &tag,
                             DcmStack &resultStack,
                             E_SearchMode mode,
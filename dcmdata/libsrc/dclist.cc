@@ -64,7 +64,9 @@ DcmList::DcmList()
     lastNode(NULL),
     currentNode(NULL),
     currentPosition(invalidListPosition),
-    cardinality(0)
+    cardinality(0),
+    nodeIndex(),
+    nodeIndexValid(OFFalse)
 {
 }
 
@@ -100,6 +102,7 @@ DcmObject *DcmList::append(DcmObject *obj)
         {
             currentNode = firstNode = lastNode = new DcmListNode(obj);
             currentPosition = cardinality;
+            addToNodeIndex(currentPosition, currentNode);
             cardinality++;
         }
         // check whether object can be inserted
@@ -110,6 +113,7 @@ DcmObject *DcmList::append(DcmObject *obj)
             node->prevNode = lastNode;
             currentNode = lastNode = node;
             currentPosition = cardinality;
+            addToNodeIndex(currentPosition, node);
             cardinality++;
         } else {
             DCMDATA_DEBUG("DcmList::append() cannot insert object, maximum number of entries reached");
@@ -131,6 +135,7 @@ DcmObject *DcmList::prepend(DcmObject *obj)
         {
             currentNode = firstNode = lastNode = new DcmListNode(obj);
             currentPosition = 0;
+            addToNodeIndex(currentPosition, currentNode);
             cardinality++;
         }
         // check whether object can be inserted
@@ -141,6 +146,7 @@ DcmObject *DcmList::prepend(DcmObject *obj)
             firstNode->prevNode = node;
             currentNode = firstNode = node;
             currentPosition = 0;
+            addToNodeIndex(currentPosition, node);
             cardinality++;
         } else {
             DCMDATA_DEBUG("DcmList::prepend() cannot insert object, maximum number of entries reached");
@@ -162,6 +168,7 @@ DcmObject *DcmList::insert(DcmObject *obj, const E_ListPos pos)
         {
             currentNode = firstNode = lastNode = new DcmListNode(obj);
             currentPosition = 0;
+            addToNodeIndex(currentPosition, currentNode);
             cardinality++;
         }
         // check whether object can be inserted
@@ -187,6 +194,7 @@ DcmObject *DcmList::insert(DcmObject *obj, const E_ListPos pos)
                 currentNode->prevNode = node;
                 currentNode = node;
                 // NB: no need to update currentPosition
+                addToNodeIndex(currentPosition, node);
                 cardinality++;
             }
             else // (pos == ELP_next || pos == ELP_atpos)
@@ -202,6 +210,7 @@ DcmObject *DcmList::insert(DcmObject *obj, const E_ListPos pos)
                 currentNode->nextNode = node;
                 currentNode = node;
                 currentPosition++;
+                addToNodeIndex(currentPosition, node);
                 cardinality++;
             }
         } else {
@@ -243,6 +252,13 @@ DcmObject *DcmList::remove()
         tempobj = tempnode->value();
         delete tempnode;
         // NB: no need to update currentPosition
+        if (nodeIndexValid)
+        {
+            if (currentPosition < nodeIndex.size())
+                nodeIndex.erase(nodeIndex.begin() + currentPosition);
+            else
+                nodeIndexValid = OFFalse;
+        }
         cardinality--;
         return tempobj;
     }
@@ -328,6 +344,13 @@ DcmObject *DcmList::seek_to(const unsigned long absolute_position)
         // last item in the list
         return seek(ELP_last);
     }
+    else if (nodeIndexValid)
+    {
+        // constant time access through the node index
+        currentNode = nodeIndex[absolute_position];
+        currentPosition = absolute_position;
+        return currentNode->value();
+    }
     else if (currentPosition != invalidListPosition)
     {
         // determine distance between current and requested position
@@ -341,7 +364,7 @@ DcmObject *DcmList::seek_to(const unsigned long absolute_position)
          // let's start iterating from the current position. Often, the position we want
          // is simply the next position (or maybe the previous one). Let's make those
          // use cases be O(1), and not O(n).
-        if ((distance <= absolute_position) && (distance < cardinality - absolute_position))
+        if ((distance <= 1) && (DcmList::valid()))
         {
             if (currentPosition <= absolute_position)
             {
@@ -357,23 +380,50 @@ DcmObject *DcmList::seek_to(const unsigned long absolute_position)
         }
     }
 
-    // iterate from the start...
-    if (absolute_position < cardinality / 2)
-    {
-        /* iterate over first half of the list */
-        seek(ELP_first);
-        for (unsigned long i = 0; i < absolute_position; i++)
-            seek(ELP_next);
-    }
-    else // ... or the end of the list
+    // create the node index, which is maintained by all further operations
+    buildNodeIndex();
+    currentNode = nodeIndex[absolute_position];
+    currentPosition = absolute_position;
+    return currentNode->value();
+}
+
+
+// ********************************
+
+
+unsigned long DcmList::tell() const
+{
+    return DcmList::valid() ? currentPosition : DCM_EndOfListIndex;
+}
+
+
+// ********************************
+
+
+void DcmList::buildNodeIndex()
+{
+    nodeIndex.clear();
+    nodeIndex.reserve(cardinality);
+    for (DcmListNode *node = firstNode; node != NULL; node = node->nextNode)
+        nodeIndex.push_back(node);
+    nodeIndexValid = OFTrue;
+}
+
+
+// ********************************
+
+
+void DcmList::addToNodeIndex(const unsigned long position, DcmListNode *node)
+{
+    if (nodeIndexValid)
     {
-        assert(absolute_position < cardinality);
-        // iterate over second half of the list (starting from the end)
-        seek(ELP_last);
-        for (unsigned long i = absolute_position + 1; i < cardinality; i++)
-            seek(ELP_prev);
+        if (position < nodeIndex.size())
+            nodeIndex.insert(nodeIndex.begin() + position, node);
+        else if (position == nodeIndex.size())
+            nodeIndex.push_back(node);
+        else
+            nodeIndexValid = OFFalse;
     }
-    return get(ELP_atpos);
 }
 
 
@@ -408,4 +458,6 @@ void DcmList::deleteAllElements()
     currentNode = NULL;
     currentPosition = invalidListPosition;
     cardinality = 0;
+    nodeIndex.clear();
+    nodeIndexValid = OFFalse;
 }
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -54,6 +54,8 @@ OFGlobal<OFBool>    dcmReplaceWrongDelimitationItem(OFFalse);
 OFGlobal<OFBool>    dcmConvertUndefinedLengthOBOWtoSQ(OFFalse);
 OFGlobal<OFBool>    dcmConvertVOILUTSequenceOWtoSQ(OFFalse);
 OFGlobal<OFBool>    dcmUseExplLengthPixDataForEncTS(OFFalse);
+OFGlobal<OFBool>    dcmUseMemoryMappedFileInput(OFFalse);
+OFGlobal<Uint32>    dcmFileHandlePoolSize(0);
 
 // ****** public methods **********************************
 
@@ -481,11 +483,8 @@ OFCondition DcmObject::writeTagAndLength(DcmOutputStream &outStream,
                                          Uint32 &writtenBytes) const
     /*
      * This function writes this DICOM object's tag and length information to the stream. When
-     * writing information, the transfer syntax which was passed is accounted for. If the transfer
-     * syntax shows an explicit value representation, the data type of this object is also written
-     * to the stream. In general, this function follows the rules which are specified in the DICOM
-     * standard (see DICOM standard part 5, section 7) concerning the encoding of a data set which
-     * shall be transmitted.
+     * writing information, the transfer syntax which was passed is accounted for. The information
+     * is encoded by encodeTagAndLength() and written to the stream with a single call.
      *
      * Parameters:
      *   outStream    - [out] The stream that the information will be written to.
@@ -495,107 +494,133 @@ OFCondition DcmObject::writeTagAndLength(DcmOutputStream &outStream,
 {
     /* check the error status of the stream. If it is not ok, nothing can be done */
     OFCondition l_error = outStream.status();
-    if (l_error.bad())
+    writtenBytes = 0;
+    if (l_error.good())
     {
-        writtenBytes = 0;
-    } else {
-        /* if the stream is ok, we need to do something */
+        Uint8 buffer[DCM_TagInfoLength];
+        l_error = encodeTagAndLength(buffer, oxfer, writtenBytes);
+        /* the encoded header may be incomplete in case of an error, write it nevertheless */
+        if (writtenBytes > 0)
+            outStream.write(buffer, writtenBytes);
+    }
+    /* return result */
+    return l_error;
+}
 
-        /* write the tag information (a total of 4 bytes, group number and element */
-        /* number) to the stream. Mind the transfer syntax's byte ordering. */
-        l_error = writeTag(outStream, getTag(), oxfer);
-        writtenBytes = 4;
 
-        /* create an object which represents the transfer syntax */
-        DcmXfer oxferSyn(oxfer);
+OFCondition DcmObject::encodeTagAndLength(Uint8 *buffer,
+                                          const E_TransferSyntax oxfer,
+                                          Uint32 &encodedBytes) const
+    /*
+     * This function encodes this DICOM object's tag and length information into the given buffer.
+     * When encoding information, the transfer syntax which was passed is accounted for. If the transfer
+     * syntax shows an explicit value representation, the data type of this object is also encoded.
+     * In general, this function follows the rules which are specified in the DICOM standard (see
+     * DICOM standard part 5, section 7) concerning the encoding of a data set which shall be transmitted.
+     *
+     * Parameters:
+     *   buffer       - [out] The buffer (at least DCM_TagInfoLength bytes) that receives the information.
+     *   oxfer        - [in] The transfer syntax which shall be used.
+     *   encodedBytes - [out] Contains in the end the amount of bytes which have been stored in the buffer.
+     */
+{
+    OFCondition l_error = EC_Normal;
+    encodedBytes = 0;
 
-        /* determine the byte ordering */
-        const E_ByteOrder oByteOrder = oxferSyn.getByteOrder();
+    /* create an object which represents the transfer syntax */
+    DcmXfer oxferSyn(oxfer);
 
-        /* if the byte ordering is unknown, this is an illegal call (return error) */
-        if (oByteOrder == EBO_unknown)
-            return EC_IllegalCall;
+    /* determine the byte ordering */
+    const E_ByteOrder oByteOrder = oxferSyn.getByteOrder();
 
-        /* if the transfer syntax is one with explicit value representation */
-        /* this value's data type also has to be written to the stream. Do so */
-        /* and also write the length information to the stream. */
-        if (oxferSyn.isExplicitVR())
-        {
-            /* Create an object that represents this object's data type */
-            DcmVR myvr(getVR());
+    /* if the byte ordering is unknown, this is an illegal call (return error) */
+    if (oByteOrder == EBO_unknown)
+        return EC_IllegalCall;
 
-            /* getValidEVR() will convert datatype "UN" to "OB" if generation of "UN" is disabled */
-            DcmEVR vr = myvr.getValidEVR();
-            myvr.setVR(vr);
+    /* encode the tag information (a total of 4 bytes, group number and element */
+    /* number). Mind the transfer syntax's byte ordering. */
+    Uint16 tagValue[2];
+    tagValue[0] = Tag.getGTag();
+    tagValue[1] = Tag.getETag();
+    swapIfNecessary(oByteOrder, gLocalByteOrder, tagValue, 4, 2);
+    memcpy(buffer, tagValue, 4);
+    encodedBytes = 4;
+
+    /* if the transfer syntax is one with explicit value representation */
+    /* this value's data type also has to be encoded, followed by the */
+    /* length information. */
+    if (oxferSyn.isExplicitVR())
+    {
+        /* Create an object that represents this object's data type */
+        DcmVR myvr(getVR());
 
-            if (Length > 0xffff && (!myvr.usesExtendedLengthEncoding()))
-            {
-                /* Attribute length is larger than 64 kBytes. */
-                /* We need to encode this as UN (or OB, if generation of UN is disabled */
-                if (dcmEnableUnknownVRGeneration.get()) vr = EVR_UN; else vr = EVR_OB;
-                myvr.setVR(vr);
-                /* output debug information to the logger */
-                DCMDATA_DEBUG("DcmObject::writeTagAndLength() Length of element " << Tag
-                    << " exceeds maximum of 16-bit length field, changing VR to " << myvr.getVRName());
-            }
+        /* getValidEVR() will convert datatype "UN" to "OB" if generation of "UN" is disabled */
+        DcmEVR vr = myvr.getValidEVR();
+        myvr.setVR(vr);
 
-            /* get name of data type */
-            const char *vrname = myvr.getValidVRName();
+        if (Length > 0xffff && (!myvr.usesExtendedLengthEncoding()))
+        {
+            /* Attribute length is larger than 64 kBytes. */
+            /* We need to encode this as UN (or OB, if generation of UN is disabled */
+            if (dcmEnableUnknownVRGeneration.get()) vr = EVR_UN; else vr = EVR_OB;
+            myvr.setVR(vr);
+            /* output debug information to the logger */
+            DCMDATA_DEBUG("DcmObject::writeTagAndLength() Length of element " << Tag
+                << " exceeds maximum of 16-bit length field, changing VR to " << myvr.getVRName());
+        }
 
-            /* write data type name to the stream (a total of 2 bytes) */
-            outStream.write(vrname, 2);
-            writtenBytes += 2;
+        /* get name of data type and encode it (a total of 2 bytes) */
+        const char *vrname = myvr.getValidVRName();
+        memcpy(buffer + encodedBytes, vrname, 2);
+        encodedBytes += 2;
 
-            /* create another data type object on the basis of the above created object */
-            DcmVR outvr(vr);
+        /* create another data type object on the basis of the above created object */
+        DcmVR outvr(vr);
 
-            /* in case we are dealing with a transfer syntax with explicit VR (see if above) */
-            /* and the actual VR uses extended length encoding (see DICOM standard part 5, */
-            /* section 7.1.2) we have to add 2 reserved bytes (set to a value of 00H) to the */
-            /* data type field and the actual length field is 4 bytes wide. Write the */
-            /* corresponding information to the stream. */
-            if (outvr.usesExtendedLengthEncoding())
-            {
-                Uint16 reserved = 0;
-                outStream.write(&reserved, 2);                                      // write 2 reserved bytes to stream
-                Uint32 valueLength = Length;                                        // determine length
-                swapIfNecessary(oByteOrder, gLocalByteOrder, &valueLength, 4, 4);   // mind transfer syntax
-                outStream.write(&valueLength, 4);                                   // write length, 4 bytes wide
-                writtenBytes += 6;                                                  // remember that 6 bytes were written in total
-            }
-            /* in case that we are dealing with a transfer syntax with explicit VR (see if above) and */
-            /* the actual VR does not use extended length encoding (see DICOM standard part 5, section */
-            /* 7.1.2) we do not have to add reserved bytes to the data type field and the actual length */
-            /* is 2 bytes wide. Write the corresponding information to the stream. But, make sure that */
-            /* the length really fits into the 2-byte field ... */
-            else if (Length <= 0xffff)
-            {
-                Uint16 valueLength = OFstatic_cast(Uint16, Length);                 // determine length (cast to 16 bit)
-                swapIfNecessary(oByteOrder, gLocalByteOrder, &valueLength, 2, 2);   // mind transfer syntax
-                outStream.write(&valueLength, 2);                                   // write length, 2 bytes wide
-                writtenBytes += 2;                                                  // remember that 2 bytes were written in total
-            }
-            /* ... if not, report an error message and return an error code.
-             * This should never happen because we automatically convert such
-             * elements to UN/OB, but just in case, we leave the check in here.
-             */
-            else {
-                DcmTag tag(Tag);
-                DCMDATA_ERROR("DcmObject: Length of element " << tag.getTagName() << " " << tag
-                    << " exceeds maximum of 16-bit length field");
-                l_error = EC_ElemLengthExceeds16BitField;
-            }
-         }
-         /* if the transfer syntax is one with implicit value representation this value's data type */
-         /* does not have to be written to the stream. Only the length information has to be written */
-         /* to the stream. According to the DICOM standard the length field is in this case always 4 */
-         /* byte wide. (see DICOM standard part 5, section 7.1.2) */
-         else {
-            Uint32 valueLength = Length;                                          // determine length
-            swapIfNecessary(oByteOrder, gLocalByteOrder, &valueLength, 4, 4);     // mind transfer syntax
-            outStream.write(&valueLength, 4);                                     // write length, 4 bytes wide
-            writtenBytes += 4;                                                    // remember that 4 bytes were written in total
-         }
+        /* in case we are dealing with a transfer syntax with explicit VR (see if above) */
+        /* and the actual VR uses extended length encoding (see DICOM standard part 5, */
+        /* section 7.1.2) we have to add 2 reserved bytes (set to a value of 00H) to the */
+        /* data type field and the actual length field is 4 bytes wide. */
+        if (outvr.usesExtendedLengthEncoding())
+        {
+            Uint16 reserved = 0;
+            memcpy(buffer + encodedBytes, &reserved, 2);                        // 2 reserved bytes
+            Uint32 valueLength = Length;                                        // determine length
+            swapIfNecessary(oByteOrder, gLocalByteOrder, &valueLength, 4, 4);   // mind transfer syntax
+            memcpy(buffer + encodedBytes + 2, &valueLength, 4);                 // length, 4 bytes wide
+            encodedBytes += 6;                                                  // 6 bytes in total
+        }
+        /* in case that we are dealing with a transfer syntax with explicit VR (see if above) and */
+        /* the actual VR does not use extended length encoding (see DICOM standard part 5, section */
+        /* 7.1.2) we do not have to add reserved bytes to the data type field and the actual length */
+        /* is 2 bytes wide. But, make sure that the length really fits into the 2-byte field ... */
+        else if (Length <= 0xffff)
+        {
+            Uint16 valueLength = OFstatic_cast(Uint16, Length);                 // determine length (cast to 16 bit)
+            swapIfNecessary(oByteOrder, gLocalByteOrder, &valueLength, 2, 2);   // mind transfer syntax
+            memcpy(buffer + encodedBytes, &valueLength, 2);                     // length, 2 bytes wide
+            encodedBytes += 2;                                                  // 2 bytes in total
+        }
+        /* ... if not, report an error message and return an error code.
+         * This should never happen because we automatically convert such
+         * elements to UN/OB, but just in case, we leave the check in here.
+         */
+        else {
+            DcmTag tag(Tag);
+            DCMDATA_ERROR("DcmObject: Length of element " << tag.getTagName() << " " << tag
+                << " exceeds maximum of 16-bit length field");
+            l_error = EC_ElemLengthExceeds16BitField;
+        }
+    }
+    /* if the transfer syntax is one with implicit value representation this value's data type */
+    /* does not have to be encoded. Only the length information is needed. According to the DICOM */
+    /* standard the length field is in this case always 4 byte wide. (see DICOM standard part 5, */
+    /* section 7.1.2) */
+    else {
+        Uint32 valueLength = Length;                                          // determine length
+        swapIfNecessary(oByteOrder, gLocalByteOrder, &valueLength, 4, 4);     // mind transfer syntax
+        memcpy(buffer + encodedBytes, &valueLength, 4);                       // length, 4 bytes wide
+        encodedBytes += 4;                                                    // 4 bytes in total
     }
 
     /* return result */
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2010, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -24,6 +24,26 @@
 #include "dcmtk/dcmdata/dcostrmz.h" /* for DcmZLibOutputFilter */
 #include "dcmtk/dcmdata/dcerror.h"  /* for EC_IllegalCall */
 
+offile_off_t DcmConsumer::writeBlocks(const DcmOutputBlock *blocks, size_t numBlocks)
+{
+  offile_off_t result = 0;
+  offile_off_t written;
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    if (blocks[i].length > 0)
+    {
+      written = write(blocks[i].data, blocks[i].length);
+      result += written;
+
+      // stop if the block could not be processed completely (I/O suspension or error)
+      if (written < blocks[i].length) break;
+    }
+  }
+  return result;
+}
+
+/* ======================================================================= */
+
 DcmOutputStream::DcmOutputStream(DcmConsumer *initial)
 : current_(initial)
 , compressionFilter_(NULL)
@@ -92,6 +112,13 @@ offile_off_t DcmOutputStream::write(const void *buf, offile_off_t buflen)
   return result;
 }
 
+offile_off_t DcmOutputStream::writeBlocks(const DcmOutputBlock *blocks, size_t numBlocks)
+{
+  offile_off_t result = current_->writeBlocks(blocks, numBlocks);
+  tell_ += result;
+  return result;
+}
+
 void DcmOutputStream::flush()
 {
   current_->flush();
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2025, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -30,13 +30,24 @@ BEGIN_EXTERN_C
 #ifdef HAVE_IO_H
 #include <io.h>
 #endif
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h>     /* for writev() */
+#endif
 END_EXTERN_C
 
+#ifdef HAVE_SYS_UIO_H
+#include <cerrno>
+#endif
+
+/* maximum number of memory blocks passed to a single call of writev() */
+#define DcmFileConsumer_MAX_IOVEC 16
+
 
 DcmFileConsumer::DcmFileConsumer(const OFFilename &filename)
 : DcmConsumer()
 , file_container_()
 , file_(file_container_)
+, buffer_(NULL)
 , status_(EC_Normal)
 {
   if (!file_.fopen(filename, "wb"))
@@ -44,12 +55,20 @@ DcmFileConsumer::DcmFileConsumer(const OFFilename &filename)
     OFString buffer = OFStandard::getLastSystemErrorCode().message();
     status_ = makeOFCondition(OFM_dcmdata, 19, OF_error, buffer.c_str());
   }
+  else
+  {
+    // use a larger buffer than the stdio default, which is typically only a few kBytes.
+    // Files passed by the caller keep the buffering chosen by the caller.
+    buffer_ = new char[DcmFileConsumerBufferSize];
+    file_.setvbuf(buffer_, _IOFBF, DcmFileConsumerBufferSize);
+  }
 }
 
 DcmFileConsumer::DcmFileConsumer(FILE *file)
 : DcmConsumer()
 , file_container_(file)
 , file_(file_container_)
+, buffer_(NULL)
 , status_(EC_Normal)
 {
 }
@@ -58,13 +77,16 @@ DcmFileConsumer::DcmFileConsumer(OFFile &file)
 : DcmConsumer()
 , file_container_()
 , file_(file)
+, buffer_(NULL)
 , status_(EC_Normal)
 {
 }
 
 DcmFileConsumer::~DcmFileConsumer()
 {
+  // the buffer must not be deleted before the file is closed
   file_.fclose();
+  delete[] buffer_;
 }
 
 OFBool DcmFileConsumer::good() const
@@ -127,6 +149,71 @@ offile_off_t DcmFileConsumer::write(const void *buf, offile_off_t buflen)
   return result;
 }
 
+offile_off_t DcmFileConsumer::writeBlocks(const DcmOutputBlock *blocks, size_t numBlocks)
+{
+#ifdef HAVE_SYS_UIO_H
+  offile_off_t total = 0;
+  for (size_t i = 0; i < numBlocks; ++i) total += blocks[i].length;
+
+  // small blocks are better collected in the stdio buffer. Large blocks are
+  // passed to the operating system directly (after flushing the stdio buffer),
+  // which avoids copying them and writes all blocks with a single system call.
+  if ((total >= DcmFileConsumerGatherThreshold) && status_.good() && file_.open() && (file_.fflush() == 0))
+  {
+    const int fd = file_.fileNo();
+    struct iovec iov[DcmFileConsumer_MAX_IOVEC];
+    offile_off_t result = 0;
+    size_t next = 0;          // index of the next block to be written
+    offile_off_t skip = 0;    // number of bytes of this block already written
+    while (next < numBlocks)
+    {
+      int count = 0;
+      for (size_t i = next; (i < numBlocks) && (count < DcmFileConsumer_MAX_IOVEC); ++i)
+      {
+        const offile_off_t offset = (i == next) ? skip : 0;
+        if (blocks[i].length > offset)
+        {
+          iov[count].iov_base = OFconst_cast(char *, OFstatic_cast(const char *, blocks[i].data)) + offset;
+          iov[count].iov_len = OFstatic_cast(size_t, blocks[i].length - offset);
+          ++count;
+        }
+      }
+      if (count == 0) break;
+
+      const ssize_t written = ::writev(fd, iov, count);
+      if (written < 0)
+      {
+        if (errno == EINTR) continue;
+        OFString buffer = OFStandard::getLastSystemErrorCode().message();
+        status_ = makeOFCondition(OFM_dcmdata, 19, OF_error, buffer.c_str());
+        break;
+      }
+      if (written == 0) break;
+      result += written;
+
+      // skip the blocks (or the part of a block) that have been written
+      offile_off_t remaining = written;
+      while ((remaining > 0) && (next < numBlocks))
+      {
+        if (remaining >= blocks[next].length - skip)
+        {
+          remaining -= blocks[next].length - skip;
+          skip = 0;
+          ++next;
+        }
+        else
+        {
+          skip += remaining;
+          remaining = 0;
+        }
+      }
+    }
+    return result;
+  }
+#endif
+  return DcmConsumer::writeBlocks(blocks, numBlocks);
+}
+
 void DcmFileConsumer::flush()
 {
   // nothing to flush
@@ -27,6 +27,10 @@
 #include "dcmtk/dcmdata/dcitem.h"
 #include "dcmtk/dcmdata/dcpxitem.h"
 #include "dcmtk/dcmdata/dcjson.h"
+#include "dcmtk/dcmdata/dcfcache.h"
+#include "dcmtk/dcmdata/dcswap.h"
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 //
 // class DcmRepresentationEntry
@@ -1229,6 +1233,373 @@ OFCondition DcmPixelData::getUncompressedFrame(
 }
 
 
+/* determines the index of the first fragment of each frame of an encapsulated
+ * multi-frame image, either from the number of fragments or from the basic
+ * offset table. Upon success, startFragments contains numberOfFrames + 1
+ * entries, the last one being the number of fragments, and fragments contains
+ * all items of the pixel sequence (including the offset table).
+ */
+static OFCondition determineFrameFragments(
+    DcmPixelSequence *pixSeq,
+    Uint32 numberOfFrames,
+    OFVector<DcmPixelItem *> &fragments,
+    OFVector<Uint32> &startFragments)
+{
+    const Uint32 numberOfFragments = OFstatic_cast(Uint32, pixSeq->card());
+    if (numberOfFragments <= numberOfFrames) return EC_CannotChangeRepresentation;
+
+    OFCondition result = EC_Normal;
+    DcmPixelItem *pixItem = NULL;
+    fragments.clear();
+    fragments.reserve(numberOfFragments);
+    for (Uint32 idx = 0; (idx < numberOfFragments) && result.good(); ++idx)
+    {
+        result = pixSeq->getItem(pixItem, idx);
+        if (result.good()) fragments.push_back(pixItem);
+    }
+    if (result.bad()) return result;
+
+    startFragments.clear();
+    startFragments.reserve(numberOfFrames + 1);
+    if (numberOfFrames == 1)
+    {
+        // single-frame image: all fragments except the offset table
+        startFragments.push_back(1);
+    }
+    else if (numberOfFragments == numberOfFrames + 1)
+    {
+        // standard case: there is one fragment per frame
+        for (Uint32 frame = 0; frame < numberOfFrames; ++frame)
+            startFragments.push_back(frame + 1);
+    }
+    else
+    {
+        // multiple fragments per frame, consult the offset table
+        Uint8 *rawOffsetTable = NULL;
+        const Uint32 tableLength = fragments[0]->getLength();
+        if (tableLength == 0)
+            return makeOFCondition(OFM_dcmdata, EC_CODE_CannotDetermineStartFragment, OF_error, "Cannot determine start fragment: basic offset table is empty");
+        if (tableLength != 4 * numberOfFrames)
+            return makeOFCondition(OFM_dcmdata, EC_CODE_CannotDetermineStartFragment, OF_error, "Cannot determine start fragment: basic offset table has wrong size");
+        result = fragments[0]->getUint8Array(rawOffsetTable);
+        if (result.bad() || (rawOffsetTable == NULL))
+            return makeOFCondition(OFM_dcmdata, EC_CODE_CannotDetermineStartFragment, OF_error, "Cannot determine start fragment: cannot access content of basic offset table");
+
+        // walk through all fragments once and compare their offsets with the table
+        Uint32 counter = 0;
+        Uint32 offset = 0;
+        for (Uint32 idx = 1; (idx < numberOfFragments) && (startFragments.size() < numberOfFrames); ++idx)
+        {
+            // the offset table is always in little endian byte order, don't modify it in place
+            memcpy(&offset, rawOffsetTable + 4 * startFragments.size(), sizeof(Uint32));
+            swapIfNecessary(gLocalByteOrder, EBO_LittleEndian, &offset, sizeof(Uint32), sizeof(Uint32));
+            if (counter == offset) startFragments.push_back(idx);
+            // add pixel item length plus 8 bytes overhead for the item tag and length field
+            counter += fragments[idx]->getLength() + 8;
+        }
+        if (startFragments.size() < numberOfFrames)
+            return makeOFCondition(OFM_dcmdata, EC_CODE_CannotDetermineStartFragment, OF_error, "Cannot determine start fragment: possibly wrong value in basic offset table");
+    }
+    startFragments.push_back(numberOfFragments);
+    return EC_Normal;
+}
+
+
+#ifdef WITH_THREADS
+
+/* state shared by all threads that decompress frames for
+ * DcmPixelData::getUncompressedFrames()
+ */
+class DcmFrameDecompressionJob
+{
+public:
+    DcmFrameDecompressionJob(
+        E_TransferSyntax repType,
+        const DcmRepresentationParameter *repParam,
+        const OFVector<DcmPixelItem *> &fragments,
+        const OFVector<Uint32> &startFragments,
+        Uint32 firstFrame,
+        Uint32 numFrames,
+        Uint8 *buffer,
+        Uint32 bufSize)
+      : repType_(repType)
+      , repParam_(repParam)
+      , fragments_(fragments)
+      , startFragments_(startFragments)
+      , firstFrame_(firstFrame)
+      , numFrames_(numFrames)
+      , buffer_(buffer)
+      , bufSize_(bufSize)
+      , mutex_()
+      , nextFrame_(0)
+      , result_(EC_Normal)
+      , colorModel_()
+    {
+    }
+
+    /* decompresses frames until all frames have been processed or an error
+     * has occurred. Called by each thread, with its own copy of the dataset.
+     */
+    void decompressFrames(DcmItem &dataset)
+    {
+        Uint32 frame = 0;
+        OFString colorModel;
+        while (nextFrame(frame))
+        {
+            OFCondition result = decompressFrame(dataset, frame, colorModel);
+            mutex_.lock();
+            if (result.bad())
+            {
+                // stop all threads, and report the first error encountered
+                if (result_.good()) result_ = result;
+                nextFrame_ = numFrames_;
+            }
+            else if (frame == 0) colorModel_ = colorModel;
+            mutex_.unlock();
+        }
+    }
+
+    /* returns the result of the decompression */
+    OFCondition result() const { return result_; }
+
+    /* returns the color model of the first decompressed frame */
+    const OFString &colorModel() const { return colorModel_; }
+
+private:
+
+    /* private undefined copy constructor */
+    DcmFrameDecompressionJob(const DcmFrameDecompressionJob &);
+
+    /* private undefined copy assignment operator */
+    DcmFrameDecompressionJob &operator=(const DcmFrameDecompressionJob &);
+
+    /* determines the next frame (relative to the first frame) to be processed */
+    OFBool nextFrame(Uint32 &frame)
+    {
+        mutex_.lock();
+        const OFBool result = (nextFrame_ < numFrames_);
+        if (result) frame = nextFrame_++;
+        mutex_.unlock();
+        return result;
+    }
+
+    /* decompresses a single frame. The compressed fragments of the frame are
+     * copied into a private pixel sequence, and the frame is then decompressed
+     * like a single-frame image, so that the codec never touches any object
+     * that is shared with another thread.
+     */
+    OFCondition decompressFrame(DcmItem &dataset, Uint32 frame, OFString &colorModel) const
+    {
+        DcmPixelSequence pixSeq(DCM_PixelSequenceTag);
+        // empty offset table
+        OFCondition result = pixSeq.insert(new DcmPixelItem(DCM_PixelItemTag));
+        const Uint32 lastFragment = startFragments_[firstFrame_ + frame + 1];
+        for (Uint32 idx = startFragments_[firstFrame_ + frame]; (idx < lastFragment) && result.good(); ++idx)
+            result = pixSeq.insert(new DcmPixelItem(*fragments_[idx]));
+        if (result.good())
+        {
+            Uint32 startFragment = 1;
+            result = DcmCodecList::decodeFrame(repType_, repParam_, &pixSeq, &dataset, 0 /* frameNo */,
+                startFragment, buffer_ + OFstatic_cast(size_t, frame) * bufSize_, bufSize_, colorModel);
+        }
+        return result;
+    }
+
+    /* transfer syntax of the compressed representation */
+    const DcmXfer repType_;
+
+    /* representation parameter of the compressed representation, may be NULL */
+    const DcmRepresentationParameter *repParam_;
+
+    /* all fragments of the pixel sequence (including the offset table) */
+    const OFVector<DcmPixelItem *> &fragments_;
+
+    /* index of the first fragment of each frame of the image, plus the number of fragments */
+    const OFVector<Uint32> &startFragments_;
+
+    /* number of the first frame to be decompressed */
+    const Uint32 firstFrame_;
+
+    /* number of frames to be decompressed */
+    const Uint32 numFrames_;
+
+    /* buffer for the decompressed frames */
+    Uint8 *buffer_;
+
+    /* size of the buffer for a single frame */
+    const Uint32 bufSize_;
+
+    /* mutex protecting the following members */
+    OFMutex mutex_;
+
+    /* next frame (relative to the first frame) to be processed */
+    Uint32 nextFrame_;
+
+    /* result of the decompression */
+    OFCondition result_;
+
+    /* color model of the first decompressed frame */
+    OFString colorModel_;
+};
+
+
+/* worker thread for DcmPixelData::getUncompressedFrames() */
+class DcmFrameDecompressionThread: public OFThread
+{
+public:
+    DcmFrameDecompressionThread(DcmFrameDecompressionJob &job, DcmItem *dataset)
+      : OFThread()
+      , job_(job)
+      , dataset_(dataset)
+    {
+    }
+
+    virtual ~DcmFrameDecompressionThread()
+    {
+        delete dataset_;
+    }
+
+protected:
+
+    virtual void run()
+    {
+        job_.decompressFrames(*dataset_);
+    }
+
+private:
+
+    /* private undefined copy constructor */
+    DcmFrameDecompressionThread(const DcmFrameDecompressionThread &);
+
+    /* private undefined copy assignment operator */
+    DcmFrameDecompressionThread &operator=(const DcmFrameDecompressionThread &);
+
+    /* the job this thread is working on */
+    DcmFrameDecompressionJob &job_;
+
+    /* private copy of the dataset attributes, owned by this thread */
+    DcmItem *dataset_;
+};
+
+
+/* creates a copy of those attributes of the given dataset that a codec needs
+ * in order to decompress a single frame of the image, i.e. of all top-level
+ * elements except for sequences and the pixel data itself. Since each frame
+ * is decompressed like a single-frame image, NumberOfFrames is set to 1.
+ */
+static DcmItem *createFrameDataset(DcmItem *dataset)
+{
+    DcmItem *result = new DcmItem();
+    DcmElement *elem = NULL;
+    const unsigned long count = dataset->card();
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        elem = dataset->getElement(i);
+        if ((elem != NULL) && (elem->ident() != EVR_SQ) && (elem->getTag() != DCM_PixelData))
+            result->insert(OFstatic_cast(DcmElement *, elem->clone()));
+    }
+    result->putAndInsertString(DCM_NumberOfFrames, "1");
+    return result;
+}
+
+#endif
+
+
+OFCondition DcmPixelData::getUncompressedFrames(
+    DcmItem *dataset,
+    Uint32 firstFrame,
+    Uint32 numFrames,
+    void *buffer,
+    Uint32 bufSize,
+    OFString& decompressedColorModel,
+    Uint32 numThreads)
+{
+    if ((dataset == NULL) || (buffer == NULL) || (numFrames == 0)) return EC_IllegalCall;
+
+    Sint32 numberOfFrames = 1;
+    dataset->findAndGetSint32(DCM_NumberOfFrames, numberOfFrames); // don't fail if absent
+    if (numberOfFrames < 1) numberOfFrames = 1;
+
+    // check frame range
+    if ((firstFrame >= OFstatic_cast(Uint32, numberOfFrames)) || (numFrames > OFstatic_cast(Uint32, numberOfFrames) - firstFrame))
+        return EC_IllegalCall;
+
+    Uint8 *frameBuffer = OFstatic_cast(Uint8 *, buffer);
+    OFCondition result = EC_Normal;
+    OFVector<DcmPixelItem *> fragments;
+    OFVector<Uint32> startFragments;
+
+    if (!existUnencapsulated && (original != repListEnd) && (numFrames > 1))
+    {
+        // determine the first fragment of each frame, so that the frames can be decompressed independently
+        result = determineFrameFragments((*original)->pixSeq, OFstatic_cast(Uint32, numberOfFrames), fragments, startFragments);
+        if (result.bad())
+        {
+            DCMDATA_DEBUG("DcmPixelData: " << result.text() << ", decompressing frames one after the other");
+            startFragments.clear();
+        }
+#ifdef WITH_THREADS
+        else if (numThreads > 1)
+        {
+            // check the buffer size here since the codecs only check against the frame size
+            Uint32 frameSize;
+            result = getUncompressedFrameSize(dataset, frameSize, OFFalse);
+            if (result.bad()) return result;
+            if (bufSize < frameSize + (frameSize & 1)) return EC_IllegalCall;
+
+            if (numThreads > numFrames) numThreads = numFrames;
+            DCMDATA_DEBUG("DcmPixelData: decompressing " << numFrames << " frames using " << numThreads << " threads");
+            DcmFrameDecompressionJob job((*original)->repType, (*original)->repParam, fragments, startFragments,
+                firstFrame, numFrames, frameBuffer, bufSize);
+            // all copies of the dataset are created here since reading an item is not thread-safe
+            DcmItem *frameDataset = createFrameDataset(dataset);
+            OFVector<DcmFrameDecompressionThread *> threads;
+            threads.reserve(numThreads - 1);
+            for (Uint32 i = 1; i < numThreads; ++i)
+            {
+                DcmFrameDecompressionThread *thread = new DcmFrameDecompressionThread(job, OFstatic_cast(DcmItem *, frameDataset->clone()));
+                if (thread->start() == 0)
+                    threads.push_back(thread);
+                else
+                {
+                    DCMDATA_WARN("DcmPixelData: cannot start thread for decompressing frames");
+                    delete thread;
+                }
+            }
+            // the calling thread takes part in the decompression
+            job.decompressFrames(*frameDataset);
+            for (size_t j = 0; j < threads.size(); ++j)
+            {
+                threads[j]->join();
+                delete threads[j];
+            }
+            delete frameDataset;
+            result = job.result();
+            if (result.good()) decompressedColorModel = job.colorModel();
+            return result;
+        }
+#endif
+    }
+#ifndef WITH_THREADS
+    (void) numThreads;
+#endif
+
+    // decompress (or copy) frames one after the other
+    DcmFileCache cache;
+    Uint32 startFragment = 0;
+    OFString colorModel;
+    result = EC_Normal;
+    for (Uint32 i = 0; (i < numFrames) && result.good(); ++i)
+    {
+        if (!startFragments.empty()) startFragment = startFragments[firstFrame + i];
+        result = getUncompressedFrame(dataset, firstFrame + i, startFragment,
+            frameBuffer + OFstatic_cast(size_t, i) * bufSize, bufSize, colorModel, &cache);
+        if (i == 0) decompressedColorModel = colorModel;
+    }
+    return result;
+}
+
+
 OFCondition DcmPixelData::getDecompressedColorModel(
     DcmItem *dataset,
     OFString &decompressedColorModel)
@@ -144,32 +144,30 @@ Uint32 DcmPixelItem::calcElementLength(const E_TransferSyntax xfer,
 // ********************************
 
 
-OFCondition DcmPixelItem::writeTagAndLength(DcmOutputStream &outStream,
-                                            const E_TransferSyntax oxfer,
-                                            Uint32 &writtenBytes) const
+OFCondition DcmPixelItem::encodeTagAndLength(Uint8 *buffer,
+                                             const E_TransferSyntax oxfer,
+                                             Uint32 &encodedBytes) const
 {
-    OFCondition l_error = outStream.status();
-    if (l_error.good())
+    encodedBytes = 0;
+    DcmXfer outXfer(oxfer);
+    /* check byte-ordering */
+    const E_ByteOrder oByteOrder = outXfer.getByteOrder();
+    if (oByteOrder == EBO_unknown)
     {
-        /* write tag information */
-        l_error = writeTag(outStream, getTag(), oxfer);
-        writtenBytes = 4;
-        /* prepare to write the value field */
-        Uint32 valueLength = getLengthField();
-        DcmXfer outXfer(oxfer);
-        /* check byte-ordering */
-        const E_ByteOrder oByteOrder = outXfer.getByteOrder();
-        if (oByteOrder == EBO_unknown)
-        {
-            return EC_IllegalCall;
-        }
-        swapIfNecessary(oByteOrder, gLocalByteOrder, &valueLength, 4, 4);
-        // availability of four bytes space in output buffer
-        // has been checked by caller.
-        writtenBytes += OFstatic_cast(Uint32, outStream.write(&valueLength, 4));
-    } else
-        writtenBytes = 0;
-    return l_error;
+        return EC_IllegalCall;
+    }
+    /* encode tag information */
+    Uint16 tagValue[2];
+    tagValue[0] = getTag().getGTag();
+    tagValue[1] = getTag().getETag();
+    swapIfNecessary(oByteOrder, gLocalByteOrder, tagValue, 4, 2);
+    memcpy(buffer, tagValue, 4);
+    /* encode length of the value field */
+    Uint32 valueLength = getLengthField();
+    swapIfNecessary(oByteOrder, gLocalByteOrder, &valueLength, 4, 4);
+    memcpy(buffer + 4, &valueLength, 4);
+    encodedBytes = 8;
+    return EC_Normal;
 }
 
 
@@ -22,6 +22,8 @@
 #include "dcmtk/config/osconfig.h"
 #include "dcmtk/dcmdata/dcrleccd.h"
 #include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/ofthread.h"    /* for class OFThread */
+#include "dcmtk/ofstd/ofvector.h"    /* for class OFVector */
 
 // dcmdata includes
 #include "dcmtk/dcmdata/dcrlecp.h"   /* for class DcmRLECodecParameter */
@@ -34,6 +36,479 @@
 #include "dcmtk/dcmdata/dcswap.h"    /* for swapIfNecessary() */
 #include "dcmtk/dcmdata/dcuid.h"     /* for dcmGenerateUniqueIdentifer()*/
 
+/* SSE2 is part of the x86-64 instruction set, i.e. the vectorized merging of
+ * RLE segments does not need any runtime detection of processor capabilities.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define DCRLECCD_SSE2
+#include <emmintrin.h>
+#endif
+
+
+// =======================================================================
+
+/* merges the given RLE segments (one byte per segment and pixel) into the
+ * output buffer, i.e. dst[i * numberOfSegments + j] = src[j][i].
+ * Specialized versions exist for the common cases: 16-bit monochrome images
+ * and color planes (two segments), 8-bit RGB images (three segments) and
+ * 32-bit monochrome images or 8-bit RGBA images (four segments).
+ */
+static void interleaveSegments(
+    const Uint8 * const *src,
+    Uint32 numberOfSegments,
+    Uint8 *dst,
+    size_t count)
+{
+  size_t i = 0;
+  switch (numberOfSegments)
+  {
+    case 1:
+      memcpy(dst, src[0], count);
+      break;
+    case 2:
+      {
+        const Uint8 *s0 = src[0];
+        const Uint8 *s1 = src[1];
+#ifdef DCRLECCD_SSE2
+        for (; i + 16 <= count; i += 16)
+        {
+          const __m128i a = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, s0 + i));
+          const __m128i b = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, s1 + i));
+          _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst + 2 * i), _mm_unpacklo_epi8(a, b));
+          _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst + 2 * i + 16), _mm_unpackhi_epi8(a, b));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+          dst[2 * i] = s0[i];
+          dst[2 * i + 1] = s1[i];
+        }
+      }
+      break;
+    case 3:
+      {
+        const Uint8 *s0 = src[0];
+        const Uint8 *s1 = src[1];
+        const Uint8 *s2 = src[2];
+        for (; i < count; ++i)
+        {
+          dst[0] = s0[i];
+          dst[1] = s1[i];
+          dst[2] = s2[i];
+          dst += 3;
+        }
+      }
+      break;
+    case 4:
+      {
+        const Uint8 *s0 = src[0];
+        const Uint8 *s1 = src[1];
+        const Uint8 *s2 = src[2];
+        const Uint8 *s3 = src[3];
+#ifdef DCRLECCD_SSE2
+        for (; i + 16 <= count; i += 16)
+        {
+          const __m128i a = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, s0 + i));
+          const __m128i b = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, s1 + i));
+          const __m128i c = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, s2 + i));
+          const __m128i d = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, s3 + i));
+          const __m128i ab0 = _mm_unpacklo_epi8(a, b);
+          const __m128i ab1 = _mm_unpackhi_epi8(a, b);
+          const __m128i cd0 = _mm_unpacklo_epi8(c, d);
+          const __m128i cd1 = _mm_unpackhi_epi8(c, d);
+          _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst + 4 * i), _mm_unpacklo_epi16(ab0, cd0));
+          _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst + 4 * i + 16), _mm_unpackhi_epi16(ab0, cd0));
+          _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst + 4 * i + 32), _mm_unpacklo_epi16(ab1, cd1));
+          _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst + 4 * i + 48), _mm_unpackhi_epi16(ab1, cd1));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+          dst[4 * i] = s0[i];
+          dst[4 * i + 1] = s1[i];
+          dst[4 * i + 2] = s2[i];
+          dst[4 * i + 3] = s3[i];
+        }
+      }
+      break;
+    default:
+      for (Uint32 j = 0; j < numberOfSegments; ++j)
+      {
+        const Uint8 *s = src[j];
+        Uint8 *d = dst + j;
+        for (i = 0; i < count; ++i)
+        {
+          *d = s[i];
+          d += numberOfSegments;
+        }
+      }
+      break;
+  }
+}
+
+
+/* helper class that decompresses the RLE segments of a frame into separate
+ * buffers, one per segment, and then merges all segments into the frame in
+ * a single pass. This is considerably faster than distributing each segment
+ * over the frame with a stride of several bytes.
+ */
+class DcmRLEFrameDecompressor
+{
+public:
+
+  DcmRLEFrameDecompressor(
+    Uint16 rows,
+    Uint16 columns,
+    Uint16 samplesPerPixel,
+    Uint16 bytesAllocated,
+    Uint16 planarConfiguration,
+    OFBool reverseByteOrder)
+  : bytesPerStripe_(OFstatic_cast(size_t, columns) * OFstatic_cast(size_t, rows))
+  , numberOfStripes_(OFstatic_cast(Uint32, bytesAllocated) * samplesPerPixel)
+  , samplesPerPixel_(samplesPerPixel)
+  , bytesAllocated_(bytesAllocated)
+  , planarConfiguration_(planarConfiguration)
+  , reverseByteOrder_(reverseByteOrder)
+  , decoders_()
+  , fail_(OFFalse)
+  {
+    // an RLE stripe set has at most 15 stripes, a larger number is rejected
+    // when the RLE header is checked
+    const Uint32 stripes = (numberOfStripes_ > 15) ? 15 : numberOfStripes_;
+    if (stripes == 0) fail_ = OFTrue;
+    for (Uint32 i = 0; i < stripes; ++i)
+    {
+      DcmRLEDecoder *decoder = new DcmRLEDecoder(bytesPerStripe_);
+      decoders_.push_back(decoder);
+      if (decoder->fail()) fail_ = OFTrue;
+    }
+  }
+
+  ~DcmRLEFrameDecompressor()
+  {
+    for (size_t i = 0; i < decoders_.size(); ++i) delete decoders_[i];
+  }
+
+  /* returns true if one of the RLE decoders failed to initialize */
+  OFBool fail() const
+  {
+    return fail_;
+  }
+
+  /* returns the RLE decoder for the given stripe */
+  DcmRLEDecoder &decoder(Uint32 stripe)
+  {
+    return *decoders_[stripe];
+  }
+
+  /* fills the remainder of a stripe that ended prematurely with copies of
+   * the last decoded value
+   */
+  void fillStripe(Uint32 stripe)
+  {
+    DcmRLEDecoder *decoder = decoders_[stripe];
+    Uint8 *buffer = OFstatic_cast(Uint8 *, decoder->getOutputBuffer());
+    const size_t size = decoder->size();
+    if (size < bytesPerStripe_)
+      memset(buffer + size, (size > 0) ? buffer[size - 1] : 0, bytesPerStripe_ - size);
+  }
+
+  /* merges the decompressed stripes into the given frame, in little endian byte order */
+  void copyToFrame(Uint8 *frame)
+  {
+    const Uint8 *src[15];
+    Uint32 position;
+    if (planarConfiguration_ == 0)
+    {
+      // color-by-pixel: all stripes are merged into one array of pixels
+      for (position = 0; position < numberOfStripes_; ++position)
+        src[position] = stripeForPosition(position / bytesAllocated_, position % bytesAllocated_);
+      interleaveSegments(src, numberOfStripes_, frame, bytesPerStripe_);
+    }
+    else
+    {
+      // color-by-plane: the stripes of each sample are merged into a separate plane
+      for (Uint32 sample = 0; sample < samplesPerPixel_; ++sample)
+      {
+        for (position = 0; position < bytesAllocated_; ++position)
+          src[position] = stripeForPosition(sample, position);
+        interleaveSegments(src, bytesAllocated_, frame + sample * bytesAllocated_ * bytesPerStripe_, bytesPerStripe_);
+      }
+    }
+  }
+
+  /* decompresses a frame that is completely contained in a single fragment */
+  OFCondition decompress(Uint8 *rleData, Uint32 fragmentLength, Uint8 *frame)
+  {
+    Uint32 rleHeader[16];
+
+    if (fragmentLength < 64)
+    {
+      DCMDATA_ERROR("Pixel item shorter than 64 bytes, RLE header incomplete.");
+      return EC_CannotChangeRepresentation;
+    }
+
+    // copy RLE header to buffer and adjust byte order
+    memcpy(rleHeader, rleData, 64);
+    swapIfNecessary(gLocalByteOrder, EBO_LittleEndian, rleHeader, OFstatic_cast(Uint32, 16*sizeof(Uint32)), sizeof(Uint32));
+
+    // determine number of stripes.
+    const Uint32 numberOfStripes = rleHeader[0];
+
+    // check that number of stripes in RLE header matches our expectation
+    if ((numberOfStripes < 1) || (numberOfStripes > 15) || (numberOfStripes != numberOfStripes_))
+    {
+      DCMDATA_ERROR("Number of stripes in RLE header incorrect: found " << numberOfStripes << ", expected " << numberOfStripes_);
+      return EC_CannotChangeRepresentation;
+    }
+
+    OFCondition result = EC_Normal;
+    Uint32 byteOffset = 0;
+    OFBool lastStripe = OFFalse;
+    OFBool lastStripeOfColor = OFFalse;
+    size_t bytesToDecode;
+
+    // for each stripe in stripe set
+    for (Uint32 stripeIndex = 0; stripeIndex < numberOfStripes; ++stripeIndex)
+    {
+      DcmRLEDecoder& rledecoder = decoder(stripeIndex);
+
+      // reset RLE codec
+      rledecoder.clear();
+
+      // adjust start point for RLE stripe
+      byteOffset = rleHeader[stripeIndex + 1];
+
+      // byteOffset now points to the first byte of the new RLE stripe
+      // check if the current stripe is the last one for this frame
+      if (stripeIndex + 1 == numberOfStripes) lastStripe = OFTrue; else lastStripe = OFFalse;
+
+      if (lastStripe)
+      {
+        // the last stripe is decompressed until the end of the fragment
+        if (fragmentLength < byteOffset)
+        {
+          DCMDATA_ERROR("Byte offset in RLE header is wrong.");
+          return EC_CannotChangeRepresentation;
+        }
+        bytesToDecode = OFstatic_cast(size_t, fragmentLength - byteOffset);
+      }
+      else
+      {
+        // not the last stripe. We can use the offset table to determine
+        // the number of bytes to feed to the RLE codec.
+        if (rleHeader[stripeIndex + 2] < rleHeader[stripeIndex + 1])
+        {
+          DCMDATA_ERROR("Byte offset in RLE header is wrong.");
+          return EC_CannotChangeRepresentation;
+        }
+        bytesToDecode = OFstatic_cast(size_t, rleHeader[stripeIndex + 2] - rleHeader[stripeIndex + 1]);
+      }
+
+      // make sure we don't overshoot the buffer size in case of an incorrect byte offset
+      if (fragmentLength < byteOffset + bytesToDecode)
+      {
+        DCMDATA_ERROR("Byte offset in RLE header is wrong.");
+        return EC_CannotChangeRepresentation;
+      }
+
+      result = rledecoder.decompress(rleData + byteOffset, bytesToDecode);
+
+      // special handling for zero pad byte at the end of the RLE stream
+      // which results in an EC_StreamNotifyClient return code
+      // or trailing garbage data which results in EC_CorruptedData
+      if (rledecoder.size() == bytesPerStripe_) result = EC_Normal;
+
+      // make sure the RLE decoder has produced the right amount of data
+      lastStripeOfColor = lastStripe || ((planarConfiguration_ == 1) && ((stripeIndex + 1) % bytesAllocated_ == 0));
+      if (lastStripeOfColor && (rledecoder.size() < bytesPerStripe_))
+      {
+        // stripe ended prematurely? report a warning and continue
+        DCMDATA_WARN("RLE decoder is finished but has produced insufficient data for this stripe, filling remaining pixels");
+        fillStripe(stripeIndex);
+        result = EC_Normal;
+      }
+      else if (rledecoder.size() != bytesPerStripe_)
+      {
+        DCMDATA_ERROR("RLE decoder is finished but has produced insufficient data for this stripe");
+        return EC_CannotChangeRepresentation;
+      }
+    }
+
+    // distribute decompressed bytes into output image array
+    copyToFrame(frame);
+    return result;
+  }
+
+private:
+
+  /* returns the decompressed stripe that contains the byte at the given
+   * position (0 = least significant byte) of the given sample
+   */
+  const Uint8 *stripeForPosition(Uint32 sample, Uint32 position)
+  {
+    // RLE segments are ordered from the most to the least significant byte,
+    // unless the incorrect LSB to MSB order produced by some tools is assumed
+    const Uint32 byte = reverseByteOrder_ ? position : bytesAllocated_ - position - 1;
+    return OFstatic_cast(const Uint8 *, decoders_[sample * bytesAllocated_ + byte]->getOutputBuffer());
+  }
+
+  /// private undefined copy constructor
+  DcmRLEFrameDecompressor(const DcmRLEFrameDecompressor&);
+
+  /// private undefined copy assignment operator
+  DcmRLEFrameDecompressor& operator=(const DcmRLEFrameDecompressor&);
+
+  /// number of bytes per stripe, i.e. number of pixels per frame
+  const size_t bytesPerStripe_;
+
+  /// number of stripes per frame
+  const Uint32 numberOfStripes_;
+
+  /// samples per pixel
+  const Uint32 samplesPerPixel_;
+
+  /// bytes allocated per sample
+  const Uint32 bytesAllocated_;
+
+  /// planar configuration
+  const Uint16 planarConfiguration_;
+
+  /// true if the RLE segments are in LSB to MSB order
+  const OFBool reverseByteOrder_;
+
+  /// RLE decoders, one per stripe
+  OFVector<DcmRLEDecoder *> decoders_;
+
+  /// true if one of the RLE decoders failed to initialize
+  OFBool fail_;
+};
+
+
+#ifdef WITH_THREADS
+
+/* state shared by all threads that decompress the frames of an image
+ * concurrently. Each frame must be contained in a single fragment.
+ */
+class DcmRLEFrameDecompressionJob
+{
+public:
+
+  DcmRLEFrameDecompressionJob(
+    const OFVector<Uint8 *>& fragments,
+    const OFVector<Uint32>& fragmentLengths,
+    Uint8 *imageData,
+    Uint32 frameSize)
+  : fragments_(fragments)
+  , fragmentLengths_(fragmentLengths)
+  , imageData_(imageData)
+  , frameSize_(frameSize)
+  , nextFrame_(0)
+  , result_(EC_Normal)
+  , mutex_()
+  {
+  }
+
+  /* decompresses frames until all frames are done or an error has occurred */
+  void process(DcmRLEFrameDecompressor& decompressor)
+  {
+    size_t frame;
+    while (nextFrame(frame))
+    {
+      OFCondition cond = decompressor.decompress(fragments_[frame], fragmentLengths_[frame], imageData_ + frame * frameSize_);
+      if (cond.bad()) setResult(cond);
+    }
+  }
+
+  /* records an error, which stops all threads */
+  void setResult(const OFCondition& cond)
+  {
+    mutex_.lock();
+    if (result_.good()) result_ = cond;
+    mutex_.unlock();
+  }
+
+  /* returns the first error that occurred, EC_Normal otherwise */
+  OFCondition result() const
+  {
+    return result_;
+  }
+
+private:
+
+  OFBool nextFrame(size_t& frame)
+  {
+    OFBool found = OFFalse;
+    mutex_.lock();
+    if (result_.good() && (nextFrame_ < fragments_.size()))
+    {
+      frame = nextFrame_++;
+      found = OFTrue;
+    }
+    mutex_.unlock();
+    return found;
+  }
+
+  /// private undefined copy constructor
+  DcmRLEFrameDecompressionJob(const DcmRLEFrameDecompressionJob&);
+
+  /// private undefined copy assignment operator
+  DcmRLEFrameDecompressionJob& operator=(const DcmRLEFrameDecompressionJob&);
+
+  const OFVector<Uint8 *>& fragments_;
+  const OFVector<Uint32>& fragmentLengths_;
+  Uint8 *imageData_;
+  const Uint32 frameSize_;
+  size_t nextFrame_;
+  OFCondition result_;
+  OFMutex mutex_;
+};
+
+
+/* worker thread for the concurrent decompression of frames */
+class DcmRLEFrameDecompressionThread: public OFThread
+{
+public:
+
+  DcmRLEFrameDecompressionThread(
+    DcmRLEFrameDecompressionJob& job,
+    Uint16 rows,
+    Uint16 columns,
+    Uint16 samplesPerPixel,
+    Uint16 bytesAllocated,
+    Uint16 planarConfiguration,
+    OFBool reverseByteOrder)
+  : OFThread()
+  , job_(job)
+  , decompressor_(rows, columns, samplesPerPixel, bytesAllocated, planarConfiguration, reverseByteOrder)
+  {
+  }
+
+protected:
+
+  virtual void run()
+  {
+    if (decompressor_.fail()) job_.setResult(EC_MemoryExhausted);
+    else job_.process(decompressor_);
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DcmRLEFrameDecompressionThread(const DcmRLEFrameDecompressionThread&);
+
+  /// private undefined copy assignment operator
+  DcmRLEFrameDecompressionThread& operator=(const DcmRLEFrameDecompressionThread&);
+
+  DcmRLEFrameDecompressionJob& job_;
+  DcmRLEFrameDecompressor decompressor_;
+};
+
+#endif
+
+
+// =======================================================================
+
 
 DcmRLECodecDecoder::DcmRLECodecDecoder()
 : DcmCodec()
@@ -141,8 +616,8 @@ OFCondition DcmRLECodecDecoder::decode(
       Uint8 * rleData = NULL;
       const size_t bytesPerStripe = OFstatic_cast(size_t, imageColumns) * OFstatic_cast(size_t, imageRows);
 
-      DcmRLEDecoder rledecoder(bytesPerStripe);
-      if (rledecoder.fail()) result = EC_MemoryExhausted;  // RLE decoder failed to initialize
+      DcmRLEFrameDecompressor decompressor(imageRows, imageColumns, imageSamplesPerPixel, imageBytesAllocated, imagePlanarConfiguration, enableReverseByteOrder);
+      if (decompressor.fail()) result = EC_MemoryExhausted;  // RLE decoder failed to initialize
       else
       {
         // compute size of uncompressed frame, in bytes
@@ -176,6 +651,63 @@ OFCondition DcmRLECodecDecoder::decode(
         {
           Uint8 *imageData8 = OFreinterpret_cast(Uint8 *, imageData16);
 
+#ifdef WITH_THREADS
+          // if each frame is contained in a single fragment, as required by DICOM,
+          // the frames can be decompressed concurrently
+          Uint32 numThreads = djcp->getNumberOfThreads();
+          if ((numThreads > 1) && (imageFrames > 1) && (pixSeq->card() == OFstatic_cast(unsigned long, imageFrames) + 1))
+          {
+            OFVector<Uint8 *> fragments;
+            OFVector<Uint32> fragmentLengths;
+            // accessing the pixel items (which may load their value from file) is not thread-safe
+            for (Uint32 item = 1; (item <= OFstatic_cast(Uint32, imageFrames)) && result.good(); ++item)
+            {
+              result = pixSeq->getItem(pixItem, item);
+              if (result.good()) result = pixItem->getUint8Array(rleData);
+              if (result.good())
+              {
+                fragments.push_back(rleData);
+                fragmentLengths.push_back(pixItem->getLength());
+              }
+            }
+            if (result.good())
+            {
+              if (numThreads > OFstatic_cast(Uint32, imageFrames)) numThreads = OFstatic_cast(Uint32, imageFrames);
+              DCMDATA_DEBUG("RLE decoder processes " << imageFrames << " frames using " << numThreads << " threads");
+              DcmRLEFrameDecompressionJob job(fragments, fragmentLengths, imageData8, frameSize);
+              OFVector<DcmRLEFrameDecompressionThread *> threads;
+              for (Uint32 i = 1; i < numThreads; ++i)
+              {
+                DcmRLEFrameDecompressionThread *thread = new DcmRLEFrameDecompressionThread(job,
+                  imageRows, imageColumns, imageSamplesPerPixel, imageBytesAllocated, imagePlanarConfiguration, enableReverseByteOrder);
+                if (thread->start() == 0)
+                  threads.push_back(thread);
+                else
+                {
+                  DCMDATA_WARN("DcmRLECodecDecoder: cannot start thread for decompressing frames");
+                  delete thread;
+                  break;
+                }
+              }
+              // the calling thread takes part in the decompression
+              job.process(decompressor);
+              for (size_t j = 0; j < threads.size(); ++j)
+              {
+                threads[j]->join();
+                delete threads[j];
+              }
+              if (job.result().good()) currentFrame = imageFrames;
+              else
+              {
+                // the sequential decompression below is more tolerant towards
+                // incorrect RLE headers and fragmented frames
+                DCMDATA_DEBUG("RLE decoder could not decompress frames concurrently, decompressing them one after the other");
+              }
+            }
+            result = EC_Normal;
+          }
+#endif
+
           while ((currentFrame < imageFrames) && result.good())
           {
             DCMDATA_DEBUG("RLE decoder processes frame " << currentFrame);
@@ -229,24 +761,11 @@ OFCondition DcmRLECodecDecoder::decode(
               OFBool lastStripeOfColor = OFFalse;
               Uint32 inputBytes = 0;
 
-              // pointers for buffer copy operations
-              Uint8 *outputBuffer = NULL;
-              Uint8 *pixelPointer = NULL;
-
-              // byte offset for first sample in frame
-              Uint32 sampleOffset = 0;
-
-              // byte offset between samples
-              Uint32 offsetBetweenSamples = 0;
-
-              // temporary variables
-              Uint32 sample = 0;
-              Uint32 byte = 0;
-              Uint32 pixel = 0;
-
               // for each stripe in stripe set
               for (Uint32 stripeIndex = 0; (stripeIndex < numberOfStripes) && result.good(); ++stripeIndex)
               {
+                DcmRLEDecoder& rledecoder = decompressor.decoder(stripeIndex);
+
                 // reset RLE codec
                 rledecoder.clear();
 
@@ -388,6 +907,7 @@ OFCondition DcmRLECodecDecoder::decode(
                 {
                     // stripe ended prematurely? report a warning and continue
                     DCMDATA_WARN("DcmRLECodecDecoder: RLE decoder is finished but has produced insufficient data for this stripe, filling remaining pixels");
+                    decompressor.fillStripe(stripeIndex);
                     result = EC_Normal;
                 }
                 else if (rledecoder.size() != bytesPerStripe)
@@ -395,48 +915,10 @@ OFCondition DcmRLECodecDecoder::decode(
                     DCMDATA_ERROR("RLE decoder is finished but has produced insufficient data for this stripe");
                     result = EC_CannotChangeRepresentation;
                 }
-
-                // distribute decompressed bytes into output image array
-                if (result.good())
-                {
-                  // which sample and byte are we currently compressing?
-                  sample = stripeIndex / imageBytesAllocated;
-                  byte = stripeIndex % imageBytesAllocated;
-
-                  // raw buffer containing bytesPerStripe bytes of uncompressed data
-                  outputBuffer = OFstatic_cast(Uint8 *, rledecoder.getOutputBuffer());
-
-                  // compute byte offsets
-                  if (imagePlanarConfiguration == 0)
-                  {
-                     sampleOffset = sample * imageBytesAllocated;
-                     offsetBetweenSamples = imageSamplesPerPixel * imageBytesAllocated;
-                  }
-                  else
-                  {
-                     sampleOffset = sample * imageBytesAllocated * imageColumns * imageRows;
-                     offsetBetweenSamples = imageBytesAllocated;
-                  }
-
-                  // initialize pointer to output data
-                  if (enableReverseByteOrder)
-                  {
-                    // assume incorrect LSB to MSB order of RLE segments as produced by some tools
-                    pixelPointer = imageData8 + sampleOffset + byte;
-                  }
-                  else
-                  {
-                    pixelPointer = imageData8 + sampleOffset + imageBytesAllocated - byte - 1;
-                  }
-
-                  // loop through all pixels of the frame
-                  for (pixel = 0; pixel < bytesPerStripe; ++pixel)
-                  {
-                    *pixelPointer = *outputBuffer++;
-                    pixelPointer += offsetBetweenSamples;
-                  }
-                }
               } /* for */
+
+              // distribute decompressed bytes into output image array
+              if (result.good()) decompressor.copyToFrame(imageData8);
             }
 
             // advance by one frame
@@ -504,7 +986,6 @@ OFCondition DcmRLECodecDecoder::decodeFrame(
     Uint16 imageBitsAllocated = 0;
     Uint32 imageBytesAllocated = 0;
     Uint16 imagePlanarConfiguration = 0;
-    Uint32 rleHeader[16];
     OFString photometricInterpretation;
     DcmItem *ditem = OFstatic_cast(DcmItem *, dataset);
 
@@ -536,8 +1017,6 @@ OFCondition DcmRLECodecDecoder::decodeFrame(
 
     DcmPixelItem *pixItem = NULL;
     Uint8 * rleData = NULL;
-    const size_t bytesPerStripe = OFstatic_cast(size_t, imageColumns) * OFstatic_cast(size_t, imageRows);
-    Uint32 numberOfStripes = 0;
     Uint32 fragmentLength = 0;
     Uint32 frameSize = imageBytesAllocated * OFstatic_cast(Uint32, imageRows)
                        * OFstatic_cast(Uint32, imageColumns) * OFstatic_cast(Uint32, imageSamplesPerPixel);
@@ -551,8 +1030,9 @@ OFCondition DcmRLECodecDecoder::decodeFrame(
 
     if (frameSize > bufSize) return EC_IllegalCall;
 
-    DcmRLEDecoder rledecoder(bytesPerStripe);
-    if (rledecoder.fail()) return EC_MemoryExhausted;  // RLE decoder failed to initialize
+    DcmRLEFrameDecompressor decompressor(imageRows, imageColumns, imageSamplesPerPixel,
+      OFstatic_cast(Uint16, imageBytesAllocated), imagePlanarConfiguration, enableReverseByteOrder);
+    if (decompressor.fail()) return EC_MemoryExhausted;  // RLE decoder failed to initialize
 
     DCMDATA_DEBUG("RLE decoder processes frame " << frameNo);
 
@@ -575,175 +1055,17 @@ OFCondition DcmRLECodecDecoder::decodeFrame(
        return result;
 
     fragmentLength = pixItem->getLength();
-    if (fragmentLength < 64)
-    {
-      DCMDATA_ERROR("Pixel item shorter than 64 bytes, RLE header incomplete.");
-      return EC_CannotChangeRepresentation;
-    }
-
     result = pixItem->getUint8Array(rleData);
     if (result.bad())
        return result;
 
-    // copy RLE header to buffer and adjust byte order
-    memcpy(rleHeader, rleData, 64);
-    swapIfNecessary(gLocalByteOrder, EBO_LittleEndian, rleHeader, OFstatic_cast(Uint32, 16*sizeof(Uint32)), sizeof(Uint32));
-
-    // determine number of stripes.
-    numberOfStripes = rleHeader[0];
-
-    // check that number of stripes in RLE header matches our expectation
-    if ((numberOfStripes < 1) || (numberOfStripes > 15) || (numberOfStripes != OFstatic_cast(Uint32, imageBytesAllocated) * imageSamplesPerPixel))
-    {
-        DCMDATA_ERROR("Number of stripes in RLE header incorrect: found " << numberOfStripes << ", expected " << (OFstatic_cast(Uint32, imageBytesAllocated) * imageSamplesPerPixel));
-        return EC_CannotChangeRepresentation;
-    }
-
-    // this variable keeps the current position within the current fragment
-    Uint32 byteOffset = 0;
-
-    OFBool lastStripe = OFFalse;
-    OFBool lastStripeOfColor = OFFalse;
-    Uint32 inputBytes = 0;
-
-    // pointers for buffer copy operations
-    Uint8 *outputBuffer = NULL;
-    Uint8 *pixelPointer = NULL;
     Uint16 *imageData16 = OFreinterpret_cast(Uint16 *, buffer);
     Uint8 *imageData8 = OFreinterpret_cast(Uint8 *, buffer);
 
-    // byte offset for first sample in frame
-    Uint32 sampleOffset = 0;
-
-    // byte offset between samples
-    Uint32 offsetBetweenSamples = 0;
-
-    // temporary variables
-    Uint32 sample = 0;
-    Uint32 byte = 0;
-    Uint32 pixel = 0;
-    size_t bytesToDecode;
-
-    // for each stripe in stripe set
-    for (Uint32 stripeIndex = 0; stripeIndex < numberOfStripes; ++stripeIndex)
-    {
-        // reset RLE codec
-        rledecoder.clear();
-
-        // adjust start point for RLE stripe
-        byteOffset = rleHeader[stripeIndex + 1];
-
-        // byteOffset now points to the first byte of the new RLE stripe
-        // check if the current stripe is the last one for this frame
-        if (stripeIndex + 1 == numberOfStripes) lastStripe = OFTrue; else lastStripe = OFFalse;
-
-        if (lastStripe)
-        {
-            // the last stripe needs special handling because we cannot use the
-            // offset table to determine the number of bytes to feed to the codec
-            // if the RLE data is split in multiple fragments. We need to feed
-            // data fragment by fragment until the RLE codec has produced
-            // sufficient output.
-            if (fragmentLength < byteOffset)
-            {
-              DCMDATA_ERROR("Byte offset in RLE header is wrong.");
-              return EC_CannotChangeRepresentation;
-            }
-            bytesToDecode = OFstatic_cast(size_t, fragmentLength - byteOffset);
-        }
-        else
-        {
-            // not the last stripe. We can use the offset table to determine
-            // the number of bytes to feed to the RLE codec.
-            inputBytes = rleHeader[stripeIndex+2];
-            if (inputBytes < rleHeader[stripeIndex + 1])
-            {
-              DCMDATA_ERROR("Byte offset in RLE header is wrong.");
-              return EC_CannotChangeRepresentation;
-            }
-
-            inputBytes -= rleHeader[stripeIndex + 1]; // number of bytes to feed to codec
-
-            bytesToDecode = OFstatic_cast(size_t, inputBytes);
-        }
-
-        // make sure we don't overshoot the buffer size in case of an incorrect byte offset
-        if (fragmentLength < byteOffset + bytesToDecode)
-        {
-          DCMDATA_ERROR("Byte offset in RLE header is wrong.");
-          return EC_CannotChangeRepresentation;
-        }
-
-        result = rledecoder.decompress(rleData + byteOffset, bytesToDecode);
-
-        // special handling for zero pad byte at the end of the RLE stream
-        // which results in an EC_StreamNotifyClient return code
-        // or trailing garbage data which results in EC_CorruptedData
-        if (rledecoder.size() == bytesPerStripe) result = EC_Normal;
-
-        byteOffset += inputBytes;
-
-        // copy the decoded stuff over to the buffer here...
-        // make sure the RLE decoder has produced the right amount of data
-        lastStripeOfColor = lastStripe || ((imagePlanarConfiguration == 1) && ((stripeIndex + 1) % imageBytesAllocated == 0));
-        if (lastStripeOfColor && (rledecoder.size() < bytesPerStripe))
-        {
-            // stripe ended prematurely? report a warning and continue
-            DCMDATA_WARN("RLE decoder is finished but has produced insufficient data for this stripe, filling remaining pixels");
-            result = EC_Normal;
-        }
-        else if (rledecoder.size() != bytesPerStripe)
-        {
-            DCMDATA_ERROR("RLE decoder is finished but has produced insufficient data for this stripe");
-            return EC_CannotChangeRepresentation;
-        }
-
-        // distribute decompressed bytes into output image array
-        // which sample and byte are we currently decompressing?
-        sample = stripeIndex / imageBytesAllocated;
-        byte = stripeIndex % imageBytesAllocated;
-
-        // raw buffer containing bytesPerStripe bytes of uncompressed data
-        outputBuffer = OFstatic_cast(Uint8 *, rledecoder.getOutputBuffer());
-
-        // compute byte offsets
-        if (imagePlanarConfiguration == 0)
-        {
-            sampleOffset = sample * imageBytesAllocated;
-            offsetBetweenSamples = imageSamplesPerPixel * imageBytesAllocated;
-        }
-        else
-        {
-            sampleOffset = sample * imageBytesAllocated * imageColumns * imageRows;
-            offsetBetweenSamples = imageBytesAllocated;
-        }
-
-        // initialize pointer to output data
-        if (enableReverseByteOrder)
-        {
-            // assume incorrect LSB to MSB order of RLE segments as produced by some tools
-            pixelPointer = imageData8 + sampleOffset + byte;
-        }
-        else
-        {
-            pixelPointer = imageData8 + sampleOffset + imageBytesAllocated - byte - 1;
-        }
-
-        // copy the pixel data that was decoded
-        const size_t decoderSize = rledecoder.size();
-        for (pixel = 0; pixel < decoderSize; ++pixel)
-        {
-            *pixelPointer = *outputBuffer++;
-            pixelPointer += offsetBetweenSamples;
-        }
-        // and fill the remainder of the image with copies of the last decoded pixel
-        const Uint8 lastPixelValue = *(outputBuffer - 1);
-        for (pixel = OFstatic_cast(Uint32, decoderSize); pixel < bytesPerStripe; ++pixel)
-        {
-            *pixelPointer = lastPixelValue;
-            pixelPointer += offsetBetweenSamples;
-        }
-    }
+    // decompress all stripes and distribute them into the output buffer
+    result = decompressor.decompress(rleData, fragmentLength, imageData8);
+    if (result.bad())
+       return result;
 
     /* remove used fragment from memory */
     pixItem->compact(); // there should only be one...
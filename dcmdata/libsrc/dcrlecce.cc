@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2002-2024, OFFIS e.V.
+ *  Copyright (C) 2002-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -28,6 +28,7 @@
 #include "dcmtk/dcmdata/dcpixseq.h"  /* for class DcmPixelSequence */
 #include "dcmtk/dcmdata/dcpxitem.h"  /* for class DcmPixelItem */
 #include "dcmtk/dcmdata/dcswap.h"    /* for swapIfNecessary */
+#include "dcmtk/dcmdata/dcfrmenc.h"  /* for class DcmConcurrentFrameEncoder */
 #include "dcmtk/dcmdata/dcitem.h"
 #include "dcmtk/ofstd/ofstd.h"
 
@@ -35,6 +36,201 @@ typedef OFList<DcmRLEEncoder *> DcmRLEEncoderList;
 typedef OFListIterator(DcmRLEEncoder *) DcmRLEEncoderListIterator;
 
 
+/* compresses the frames of an image, possibly by multiple threads.
+ * The uncompressed pixel data is only read, so no per-thread state is needed.
+ */
+class DcmRLEFrameEncoder: public DcmConcurrentFrameEncoder
+{
+public:
+
+  DcmRLEFrameEncoder(
+    const DcmRLECodecParameter *djcp,
+    const Uint8 *pixelData,
+    Uint16 columns,
+    Uint16 rows,
+    Uint16 samplesPerPixel,
+    Uint16 bytesAllocated,
+    Uint16 planarConfiguration)
+  : DcmConcurrentFrameEncoder(djcp->getNumberOfThreads())
+  , pixelData_(pixelData)
+  , columns_(columns)
+  , rows_(rows)
+  , samplesPerPixel_(samplesPerPixel)
+  , bytesAllocated_(bytesAllocated)
+  , planarConfiguration_(planarConfiguration)
+  {
+  }
+
+protected:
+
+  virtual OFCondition encodeFrame(
+    Uint32 frameNo,
+    Uint32 /* threadNo */,
+    Uint8 *&compressedData,
+    Uint32 &compressedLen)
+  {
+    OFCondition result = EC_Normal;
+    DcmRLEEncoderList rleEncoderList;
+    DcmRLEEncoderListIterator first = rleEncoderList.begin();
+    DcmRLEEncoderListIterator last = rleEncoderList.end();
+    Uint32 rleHeader[16];
+    Uint32 i;
+
+    const Uint32 bytesPerStripe = columns_ * rows_;
+    const Uint32 frameSize = bytesPerStripe * samplesPerPixel_ * bytesAllocated_;
+    const Uint8 *pixelPointer = NULL;
+    Uint32 sampleOffset = 0;
+    Uint32 offsetBetweenSamples = 0;
+    Uint32 sample = 0;
+    Uint32 byte = 0;
+    Uint32 row = 0;
+    Uint32 column = 0;
+
+    DcmRLEEncoder *rleEncoder = NULL;
+    Uint32 rleSize = 0;
+    Uint8 *rleData = NULL;
+    Uint8 *rleData2 = NULL;
+
+    // the bytes of one row of a stripe are collected in this buffer
+    // unless they are stored contiguously in the pixel data
+    Uint8 *rowBuffer = new Uint8[columns_];
+
+    // compute byte offset between samples
+    if (planarConfiguration_ == 0)
+       offsetBetweenSamples = samplesPerPixel_ * bytesAllocated_;
+       else offsetBetweenSamples = bytesAllocated_;
+
+    // loop through all samples of one frame
+    for (sample = 0; (sample < samplesPerPixel_) && result.good(); sample++)
+    {
+      // compute byte offset for first sample in frame
+      if (planarConfiguration_ == 0)
+         sampleOffset = sample * bytesAllocated_;
+         else sampleOffset = sample * bytesAllocated_ * columns_ * rows_;
+
+      // loop through the bytes of one sample
+      for (byte = 0; (byte < bytesAllocated_) && result.good(); byte++)
+      {
+        pixelPointer = pixelData_ + frameSize * frameNo + sampleOffset + bytesAllocated_ - byte - 1;
+
+        // initialize new RLE codec for this stripe
+        rleEncoder = new DcmRLEEncoder(1 /* DICOM padding required */);
+        if (rleEncoder)
+        {
+          rleEncoderList.push_back(rleEncoder);
+
+          // loop through all rows of the frame
+          for (row = 0; row < rows_; ++row)
+          {
+            if (offsetBetweenSamples == 1)
+            {
+              rleEncoder->add(pixelPointer, columns_);
+              pixelPointer += columns_;
+            }
+            else
+            {
+              for (column = 0; column < columns_; ++column)
+              {
+                rowBuffer[column] = *pixelPointer;
+                pixelPointer += offsetBetweenSamples;
+              }
+              rleEncoder->add(rowBuffer, columns_);
+            }
+
+            // enforce DICOM rule that "Each row of the image shall be encoded
+            // separately and not cross a row boundary."
+            // (see DICOM part 5 section G.3.1)
+            rleEncoder->flush();
+          }
+
+          if (rleEncoder->fail()) result = EC_MemoryExhausted;
+        } else result = EC_MemoryExhausted;
+      }
+    }
+    delete[] rowBuffer;
+
+    // create compressed frame and erase RLE codec list
+    if (result.good() && (rleEncoderList.size() > 0) && (rleEncoderList.size() < 16))
+    {
+      // compute size of compressed frame including RLE header
+      // and populate RLE header
+      for (i=0; i<16; i++) rleHeader[i] = 0;
+      rleHeader[0] = OFstatic_cast(Uint32, rleEncoderList.size());
+      rleSize = 64;
+      i = 1;
+      first = rleEncoderList.begin();
+      while (first != last)
+      {
+        rleHeader[i++] = rleSize;
+        rleSize += OFstatic_cast(Uint32, (*first)->size());
+        ++first;
+      }
+
+      // allocate buffer for compressed frame
+      rleData = new Uint8[rleSize];
+
+      if (rleData)
+      {
+        // copy RLE header to compressed frame buffer
+        swapIfNecessary(EBO_LittleEndian, gLocalByteOrder, rleHeader, OFstatic_cast(Uint32, 16*sizeof(Uint32)), sizeof(Uint32));
+        memcpy(rleData, rleHeader, 64);
+
+        // store RLE stripe sets in compressed frame buffer
+        rleData2 = rleData + 64;
+        first = rleEncoderList.begin();
+        while (first != last)
+        {
+          (*first)->write(rleData2);
+          rleData2 += (*first)->size();
+          delete *first;
+          first = rleEncoderList.erase(first);
+        }
+
+        // ownership of the compressed frame is transferred to the caller
+        compressedData = rleData;
+        compressedLen = rleSize;
+      } else result = EC_MemoryExhausted;
+    }
+    else if (result.good()) result = EC_CannotChangeRepresentation;
+
+    // erase RLE codec list
+    first = rleEncoderList.begin();
+    while (first != last)
+    {
+      delete *first;
+      first = rleEncoderList.erase(first);
+    }
+    return result;
+  }
+
+private:
+
+  /* private undefined copy constructor */
+  DcmRLEFrameEncoder(const DcmRLEFrameEncoder&);
+
+  /* private undefined copy assignment operator */
+  DcmRLEFrameEncoder& operator=(const DcmRLEFrameEncoder&);
+
+  /* pointer to the uncompressed pixel data of all frames, little endian byte order */
+  const Uint8 *pixelData_;
+
+  /* width of the image */
+  Uint16 columns_;
+
+  /* height of the image */
+  Uint16 rows_;
+
+  /* number of samples per pixel */
+  Uint16 samplesPerPixel_;
+
+  /* number of bytes allocated per sample */
+  Uint16 bytesAllocated_;
+
+  /* planar configuration of the pixel data */
+  Uint16 planarConfiguration_;
+};
+
+
 // =======================================================================
 
 DcmRLECodecEncoder::DcmRLECodecEncoder()
@@ -130,14 +326,8 @@ OFCondition DcmRLECodecEncoder::encode(
   DcmStack localStack(objStack);
   (void)localStack.pop();             // pop pixel data element from stack
   DcmObject *dataset = localStack.pop(); // this is the item in which the pixel data is located
-  Uint8 *pixelData8 = OFreinterpret_cast(Uint8 *, OFconst_cast(Uint16 *, pixelData));
-  Uint8 *pixelPointer = NULL;
+  const Uint8 *pixelData8 = OFreinterpret_cast(const Uint8 *, pixelData);
   DcmOffsetList offsetList;
-  DcmRLEEncoderList rleEncoderList;
-  DcmRLEEncoderListIterator first = rleEncoderList.begin();
-  DcmRLEEncoderListIterator last = rleEncoderList.end();
-  Uint32 rleHeader[16];
-  Uint32 i;
   OFBool byteSwapped = OFFalse;  // true if we have byte-swapped the original pixel data
 
   if ((!dataset)||((dataset->ident()!= EVR_dataset) && (dataset->ident()!= EVR_item))) result = EC_InvalidTag;
@@ -212,137 +402,15 @@ OFCondition DcmRLECodecEncoder::encode(
     // create RLE stripe sets
     if (result.good())
     {
-      const Uint32 bytesPerStripe = columns * rows;
-      const Uint32 frameSize = columns * rows * samplesPerPixel * bytesAllocated;
-      Uint32 frameOffset = 0;
-      Uint32 sampleOffset = 0;
-      Uint32 offsetBetweenSamples = 0;
-      Uint32 sample = 0;
-      Uint32 byte = 0;
-      Uint32 pixel = 0;
-      Uint32 columnCounter = 0;
-
-      DcmRLEEncoder *rleEncoder = NULL;
-      Uint32 rleSize = 0;
-      Uint8 *rleData = NULL;
-      Uint8 *rleData2 = NULL;
-
       // warn about (possibly) non-standard fragmentation
       if (djcp->getFragmentSize() > 0)
          DCMDATA_WARN("DcmRLECodecEncoder: limiting the fragment size may result in non-standard conformant encoding");
 
-      // compute byte offset between samples
-      if (planarConfiguration == 0)
-         offsetBetweenSamples = samplesPerPixel * bytesAllocated;
-         else offsetBetweenSamples = bytesAllocated;
-
-      // loop through all frames of the image
-      for (Uint32 currentFrame = 0; ((currentFrame < OFstatic_cast(Uint32, numberOfFrames)) && result.good()); currentFrame++)
-      {
-        // offset to start of frame, in bytes
-        frameOffset = frameSize * currentFrame;
-
-        // loop through all samples of one frame
-        for (sample = 0; sample < samplesPerPixel; sample++)
-        {
-          // compute byte offset for first sample in frame
-          if (planarConfiguration == 0)
-             sampleOffset = sample * bytesAllocated;
-             else sampleOffset = sample * bytesAllocated * columns * rows;
-
-          // loop through the bytes of one sample
-          for (byte = 0; byte < bytesAllocated; byte++)
-          {
-            pixelPointer = pixelData8 + frameOffset + sampleOffset + bytesAllocated - byte - 1;
-
-            // initialize new RLE codec for this stripe
-            rleEncoder = new DcmRLEEncoder(1 /* DICOM padding required */);
-            if (rleEncoder)
-            {
-              rleEncoderList.push_back(rleEncoder);
-              columnCounter = columns;
-
-              // loop through all pixels of the frame
-              for (pixel = 0; pixel < bytesPerStripe; ++pixel)
-              {
-                rleEncoder->add(*pixelPointer);
-
-                // enforce DICOM rule that "Each row of the image shall be encoded
-                // separately and not cross a row boundary."
-                // (see DICOM part 5 section G.3.1)
-                if (--columnCounter == 0)
-                {
-                  rleEncoder->flush();
-                  columnCounter = columns;
-                }
-                pixelPointer += offsetBetweenSamples;
-              }
-
-              rleEncoder->flush();
-              if (rleEncoder->fail()) result = EC_MemoryExhausted;
-            } else result = EC_MemoryExhausted;
-          }
-        }
-
-        // store frame and erase RLE codec list
-        if (result.good() && (rleEncoderList.size() > 0) && (rleEncoderList.size() < 16))
-        {
-          // compute size of compressed frame including RLE header
-          // and populate RLE header
-          for (i=0; i<16; i++) rleHeader[i] = 0;
-          rleHeader[0] = OFstatic_cast(Uint32, rleEncoderList.size());
-          rleSize = 64;
-          i = 1;
-          first = rleEncoderList.begin();
-          while (first != last)
-          {
-            rleHeader[i++] = rleSize;
-            rleSize += OFstatic_cast(Uint32, (*first)->size());
-            ++first;
-          }
-
-          // allocate buffer for compressed frame
-          rleData = new Uint8[rleSize];
-
-          if (rleData)
-          {
-            // copy RLE header to compressed frame buffer
-            swapIfNecessary(EBO_LittleEndian, gLocalByteOrder, rleHeader, OFstatic_cast(Uint32, 16*sizeof(Uint32)), sizeof(Uint32));
-            memcpy(rleData, rleHeader, 64);
-
-            // store RLE stripe sets in compressed frame buffer
-            rleData2 = rleData + 64;
-            first = rleEncoderList.begin();
-            while (first != last)
-            {
-              (*first)->write(rleData2);
-              rleData2 += (*first)->size();
-              delete *first;
-              first = rleEncoderList.erase(first);
-            }
-
-            // store compressed frame, breaking into segments if necessary
-            result = pixelSequence->storeCompressedFrame(offsetList, rleData, rleSize, djcp->getFragmentSize());
-            compressedSize += rleSize;
-
-            // erase buffer for compressed frame
-            delete[] rleData;
-          } else result = EC_MemoryExhausted;
-        }
-        else
-        {
-          // erase RLE codec list
-          first = rleEncoderList.begin();
-          while (first != last)
-          {
-            delete *first;
-            first = rleEncoderList.erase(first);
-          }
-          if (result.good()) result = EC_CannotChangeRepresentation;
-        }
-
-      }
-
+      // compress all frames of the image and store them in the pixel sequence
+      DcmRLEFrameEncoder frameEncoder(djcp, pixelData8, columns, rows, samplesPerPixel, bytesAllocated, planarConfiguration);
+      size_t frameBytes = 0;
+      result = frameEncoder.encodeFrames(OFstatic_cast(Uint32, numberOfFrames), pixelSequence, offsetList, djcp->getFragmentSize(), frameBytes);
+      compressedSize = OFstatic_cast(Uint32, frameBytes);
     }
 
     // store pixel sequence if everything went well.
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2017, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -22,6 +22,103 @@
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 #include "dcmtk/dcmdata/dcswap.h"
 
+#include <cstring>                    /* for memcpy() */
+
+/* SSE2 is part of the x86-64 instruction set, i.e. the vectorized swapping
+ * does not need any runtime detection of processor capabilities. If the
+ * compiler targets a processor with SSSE3, a single byte shuffle is used.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define DCSWAP_SSE2
+#include <emmintrin.h>
+#ifdef __SSSE3__
+#define DCSWAP_SSSE3
+#include <tmmintrin.h>
+#endif
+#endif
+
+
+/* swaps count values of valWidth bytes each from source to target.
+ * Both pointers may be identical (in-place swapping), but the two blocks of
+ * data shall not overlap otherwise. The vectorized loops only handle the
+ * common value widths 2, 4 and 8, all other widths are swapped bytewise.
+ */
+static void swapValues(const Uint8 *source, Uint8 *target, size_t count, const size_t valWidth)
+{
+#ifdef DCSWAP_SSE2
+    if ((valWidth == 2) || (valWidth == 4) || (valWidth == 8))
+    {
+        size_t blocks = (count * valWidth) / 16;
+#ifdef DCSWAP_SSSE3
+        const __m128i mask = (valWidth == 2)
+            ? _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1)
+            : (valWidth == 4)
+            ? _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3)
+            : _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+#endif
+        count -= blocks * 16 / valWidth;
+        while (blocks)
+        {
+            --blocks;
+            __m128i v = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, source));
+#ifdef DCSWAP_SSSE3
+            v = _mm_shuffle_epi8(v, mask);
+#else
+            /* swap the bytes of each 16-bit word, then the words of each 32-bit
+             * value and finally the 32-bit halves of each 64-bit value
+             */
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            if (valWidth > 2)
+            {
+                v = _mm_or_si128(_mm_slli_epi32(v, 16), _mm_srli_epi32(v, 16));
+                if (valWidth > 4)
+                    v = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+            }
+#endif
+            _mm_storeu_si128(OFreinterpret_cast(__m128i *, target), v);
+            source += 16;
+            target += 16;
+        }
+    }
+#endif
+    /* swap the remaining values (all values if not vectorized) */
+    if (valWidth == 2)
+    {
+        Uint8 save;
+        while (count)
+        {
+            --count;
+            save = source[0];
+            target[0] = source[1];
+            target[1] = save;
+            source += 2;
+            target += 2;
+        }
+    }
+    else if (valWidth > 2)
+    {
+        size_t i;
+        Uint8 first, last;
+        while (count)
+        {
+            --count;
+            for (i = 0; i < valWidth / 2; ++i)
+            {
+                first = source[i];
+                last = source[valWidth - 1 - i];
+                target[i] = last;
+                target[valWidth - 1 - i] = first;
+            }
+            /* the middle byte of an odd value width remains in place */
+            if (valWidth & 1)
+                target[valWidth / 2] = source[valWidth / 2];
+            source += valWidth;
+            target += valWidth;
+        }
+    }
+}
+
+
 OFCondition swapIfNecessary(const E_ByteOrder newByteOrder,
                             const E_ByteOrder oldByteOrder,
                             void * value, const Uint32 byteLength,
@@ -79,52 +176,74 @@ void swapBytes(void * value, const Uint32 byteLength,
      *   valWidth     - [in] Specifies how many bytes shall be treated together as one element.
      */
 {
-    Uint8 save;
-
-    /* in case valWidth equals 2, swap correspondingly */
-    if (valWidth == 2)
+    /* values that are only partially contained in the array are not swapped */
+    if (valWidth > 1)
     {
-        Uint8 *first = &OFstatic_cast(Uint8*, value)[0];
-        Uint8 *second = &OFstatic_cast(Uint8*, value)[1];
-        Uint32 times = byteLength / 2;
-        while(times)
-        {
-            --times;
-            save = *first;
-            *first = *second;
-            *second = save;
-            first += 2;
-            second += 2;
-        }
+        Uint8 *base = OFstatic_cast(Uint8 *, value);
+        swapValues(base, base, byteLength / valWidth, valWidth);
     }
-    /* if valWidth is greater than 2, swap correspondingly */
-    else if (valWidth > 2)
+}
+
+
+OFCondition swapIfNecessary(const E_ByteOrder newByteOrder,
+                            const E_ByteOrder oldByteOrder,
+                            const void * source, void * target,
+                            const Uint32 byteLength,
+                            const size_t valWidth)
+    /*
+     * This function copies byteLength bytes from source to target and swaps them
+     * if newByteOrder and oldByteOrder differ from each other. In case bytes have
+     * to be swapped, these bytes are separated in valWidth elements which will be
+     * swapped separately.
+     *
+     * Parameters:
+     *   newByteOrder - [in] The new byte ordering (little or big endian).
+     *   oldByteOrder - [in] The current old byte ordering (little or big endian).
+     *   source       - [in] Array that contains the bytes to be copied.
+     *   target       - [out] Array that receives the (possibly swapped) bytes.
+     *   byteLength   - [in] Length of the above arrays.
+     *   valWidth     - [in] Specifies how many bytes shall be treated together as one element.
+     */
+{
+    /* if the two byte orderings are unknown this is an illegal call */
+    if (oldByteOrder != EBO_unknown && newByteOrder != EBO_unknown)
     {
-        size_t i;
-        const size_t halfWidth = valWidth / 2;
-        const size_t offset = valWidth - 1;
-        Uint8 *start;
-        Uint8 *end;
+        if (oldByteOrder != newByteOrder && valWidth > 1)
+            swapBytes(source, target, byteLength, valWidth);
+        else if (source != target)
+            memcpy(target, source, byteLength);
+        return EC_Normal;
+    }
+    return EC_IllegalCall;
+}
 
-        Uint32 times = OFstatic_cast(Uint32, byteLength / valWidth);
-        Uint8  *base = OFstatic_cast(Uint8 *, value);
 
-        while (times)
-        {
-            --times;
-            i = halfWidth;
-            start = base;
-            end = base+offset;
-            while (i)
-            {
-                --i;
-                save = *start;
-                *start++ = *end;
-                *end-- = save;
-            }
-            base += valWidth;
-        }
+void swapBytes(const void * source, void * target,
+               const Uint32 byteLength,
+               const size_t valWidth)
+    /*
+     * This function copies byteLength bytes from source to target and swaps them.
+     * These bytes are separated in valWidth elements which will be swapped separately.
+     *
+     * Parameters:
+     *   source       - [in] Array that contains the bytes to be swapped.
+     *   target       - [out] Array that receives the swapped bytes.
+     *   byteLength   - [in] Length of the above arrays.
+     *   valWidth     - [in] Specifies how many bytes shall be treated together as one element.
+     */
+{
+    const Uint8 *src = OFstatic_cast(const Uint8 *, source);
+    Uint8 *dst = OFstatic_cast(Uint8 *, target);
+    size_t swapped = 0;
+    if (valWidth > 1)
+    {
+        const size_t count = byteLength / valWidth;
+        swapValues(src, dst, count, valWidth);
+        swapped = count * valWidth;
     }
+    /* copy the bytes of a trailing partial value unchanged (as done by the in-place variant) */
+    if ((swapped < byteLength) && (src != dst))
+        memcpy(dst + swapped, src + swapped, byteLength - swapped);
 }
 
 
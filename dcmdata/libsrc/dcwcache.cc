@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2007-2010, OFFIS e.V.
+ *  Copyright (C) 2007-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -32,10 +32,19 @@ void DcmWriteCache::init(void *owner,
                          Uint32 bytesTransferred,
                          E_ByteOrder byteOrder)
 {
-  if (! buf_)
+  if (! buf_ || (owner != owner_))
   {
-    capacity_ = DcmWriteCacheBufsize;
-    buf_ = new Uint8[capacity_];
+    // determine the buffer size needed for the new element. The buffer
+    // content can be discarded since the previous element is complete.
+    Uint32 bufsize = DcmWriteCacheBufsize;
+    if (fieldLength > bufsize)
+      bufsize = (fieldLength < DcmWriteCacheMaxBufsize) ? fieldLength : DcmWriteCacheMaxBufsize;
+    if (bufsize > capacity_)
+    {
+      delete[] buf_;
+      capacity_ = bufsize;
+      buf_ = new Uint8[capacity_];
+    }
   }
 
   if (owner != owner_)
@@ -0,0 +1,247 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: Benchmark for loading and deleting many DICOM files (as done by
+ *    dcmdump-like tools), with and without arena allocation
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofconsol.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftimer.h"
+#include "dcmtk/dcmdata/dctk.h"
+
+
+/* creates an enhanced CT-like dataset with many small elements: the usual
+ * patient/study/series attributes and a per-frame functional groups sequence
+ * with nested sequences, but only a small pixel data element
+ */
+static void createDataset(DcmDataset &dset, const Uint32 number, const Uint32 frames)
+{
+    char buf[64];
+    dset.putAndInsertString(DCM_SOPClassUID, UID_EnhancedCTImageStorage);
+    OFStandard::snprintf(buf, sizeof(buf), "1.2.276.0.7230010.3.1.4.0.%lu", OFstatic_cast(unsigned long, number));
+    dset.putAndInsertString(DCM_SOPInstanceUID, buf);
+    dset.putAndInsertString(DCM_StudyInstanceUID, "1.2.276.0.7230010.3.1.2.0.1");
+    dset.putAndInsertString(DCM_SeriesInstanceUID, "1.2.276.0.7230010.3.1.3.0.1");
+    dset.putAndInsertString(DCM_PatientName, "Doe^John");
+    dset.putAndInsertString(DCM_PatientID, "PID-4711");
+    dset.putAndInsertString(DCM_PatientBirthDate, "19700101");
+    dset.putAndInsertString(DCM_PatientSex, "M");
+    dset.putAndInsertString(DCM_StudyDate, "20260101");
+    dset.putAndInsertString(DCM_StudyTime, "120000");
+    dset.putAndInsertString(DCM_AccessionNumber, "ACC0001");
+    dset.putAndInsertString(DCM_Modality, "CT");
+    dset.putAndInsertString(DCM_Manufacturer, "OFFIS");
+    dset.putAndInsertString(DCM_InstitutionName, "Hospital");
+    dset.putAndInsertString(DCM_ReferringPhysicianName, "Smith^Jane");
+    dset.putAndInsertString(DCM_StudyDescription, "CT Thorax");
+    dset.putAndInsertString(DCM_SeriesDescription, "Thorax 1.0 B30f");
+    dset.putAndInsertString(DCM_StudyID, "1");
+    dset.putAndInsertString(DCM_SeriesNumber, "2");
+    OFStandard::snprintf(buf, sizeof(buf), "%lu", OFstatic_cast(unsigned long, number + 1));
+    dset.putAndInsertString(DCM_InstanceNumber, buf);
+    dset.putAndInsertString(DCM_ImageType, "ORIGINAL\\PRIMARY\\AXIAL");
+    dset.putAndInsertString(DCM_FrameOfReferenceUID, "1.2.276.0.7230010.3.1.5.0.1");
+    OFStandard::snprintf(buf, sizeof(buf), "%lu", OFstatic_cast(unsigned long, frames));
+    dset.putAndInsertString(DCM_NumberOfFrames, buf);
+    DcmItem *item = NULL;
+    DcmItem *nested = NULL;
+    for (Uint32 f = 0; f < frames; ++f)
+    {
+        if (dset.findOrCreateSequenceItem(DCM_PerFrameFunctionalGroupsSequence, item, -2).good())
+        {
+            if (item->findOrCreateSequenceItem(DCM_PlanePositionSequence, nested).good())
+            {
+                OFStandard::snprintf(buf, sizeof(buf), "-250\\-250\\%lu", OFstatic_cast(unsigned long, f));
+                nested->putAndInsertString(DCM_ImagePositionPatient, buf);
+            }
+            if (item->findOrCreateSequenceItem(DCM_PlaneOrientationSequence, nested).good())
+                nested->putAndInsertString(DCM_ImageOrientationPatient, "1\\0\\0\\0\\1\\0");
+            if (item->findOrCreateSequenceItem(DCM_FrameContentSequence, nested).good())
+            {
+                nested->putAndInsertUint32(DCM_StackID, 1);
+                nested->putAndInsertUint32(DCM_InStackPositionNumber, f + 1);
+                nested->putAndInsertUint32(DCM_DimensionIndexValues, 1, 0);
+                nested->putAndInsertUint32(DCM_DimensionIndexValues, f + 1, 1);
+                nested->putAndInsertString(DCM_FrameAcquisitionDateTime, "20260101120000");
+            }
+            if (item->findOrCreateSequenceItem(DCM_FrameVOILUTSequence, nested).good())
+            {
+                nested->putAndInsertString(DCM_WindowCenter, "40");
+                nested->putAndInsertString(DCM_WindowWidth, "400");
+            }
+            if (item->findOrCreateSequenceItem(DCM_PixelValueTransformationSequence, nested).good())
+            {
+                nested->putAndInsertString(DCM_RescaleIntercept, "-1024");
+                nested->putAndInsertString(DCM_RescaleSlope, "1");
+                nested->putAndInsertString(DCM_RescaleType, "HU");
+            }
+        }
+    }
+    dset.putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2");
+    dset.putAndInsertUint16(DCM_SamplesPerPixel, 1);
+    dset.putAndInsertUint16(DCM_Rows, 16);
+    dset.putAndInsertUint16(DCM_Columns, 16);
+    dset.putAndInsertUint16(DCM_BitsAllocated, 16);
+    dset.putAndInsertUint16(DCM_BitsStored, 12);
+    dset.putAndInsertUint16(DCM_HighBit, 11);
+    dset.putAndInsertUint16(DCM_PixelRepresentation, 0);
+    Uint16 *pixels = new Uint16[16 * 16 * frames];
+    for (Uint32 i = 0; i < 16 * 16 * frames; ++i)
+        pixels[i] = OFstatic_cast(Uint16, i & 0xfff);
+    dset.putAndInsertUint16Array(DCM_PixelData, pixels, 16 * 16 * frames);
+    delete[] pixels;
+}
+
+
+/* loads and deletes all files, returns the time needed for loading and deleting */
+static OFBool loadFiles(const OFList<OFString> &files,
+                        const OFBool arena,
+                        double &loadTime,
+                        double &deleteTime,
+                        unsigned long &elements)
+{
+    loadTime = 0.0;
+    deleteTime = 0.0;
+    elements = 0;
+    OFListConstIterator(OFString) it = files.begin();
+    while (it != files.end())
+    {
+        DcmFileFormat *fileformat = new DcmFileFormat();
+        fileformat->setArenaAllocation(arena);
+        OFTimer loadTimer;
+        if (fileformat->loadFile(*it).bad())
+        {
+            CERR << "Error: cannot read file: " << *it << OFendl;
+            delete fileformat;
+            return OFFalse;
+        }
+        loadTime += loadTimer.getDiff();
+        DcmStack stack;
+        while (fileformat->nextObject(stack, OFTrue).good())
+            ++elements;
+        OFTimer deleteTimer;
+        delete fileformat;
+        deleteTime += deleteTimer.getDiff();
+        ++it;
+    }
+    return OFTrue;
+}
+
+
+int main(int argc, char *argv[])
+{
+    if ((argc < 2) || ((strcmp(argv[1], "-f") != 0) && (argc > 4)) || ((strcmp(argv[1], "-f") == 0) && (argc < 3)))
+    {
+        CERR << "Usage: parsebench count [frames [iterations]]" << OFendl
+             << "       parsebench -f file..." << OFendl
+             << "  count       number of synthetic files created in the current directory" << OFendl
+             << "  frames      number of frames (functional group items) per file (default: 20)" << OFendl
+             << "  iterations  number of measurements, the best one is reported (default: 3)" << OFendl
+             << "  file        existing DICOM files to be loaded (3 iterations)" << OFendl;
+        return 1;
+    }
+
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+        CERR << "Error: no data dictionary loaded, check environment variable: " << DCM_DICT_ENVIRONMENT_VARIABLE << OFendl;
+        return 1;
+    }
+
+    OFList<OFString> files;
+    OFBool synthetic = OFFalse;
+    Uint32 iterations = 3;
+    if (strcmp(argv[1], "-f") == 0)
+    {
+        for (int i = 2; i < argc; ++i)
+            files.push_back(argv[i]);
+    } else {
+        const Uint32 count = OFstatic_cast(Uint32, atoi(argv[1]));
+        const Uint32 frames = (argc > 2) ? OFstatic_cast(Uint32, atoi(argv[2])) : 20;
+        if (argc > 3)
+            iterations = OFstatic_cast(Uint32, atoi(argv[3]));
+        if ((count < 1) || (frames < 1) || (iterations < 1))
+        {
+            CERR << "Error: invalid parameter value" << OFendl;
+            return 1;
+        }
+        synthetic = OFTrue;
+        char filename[32];
+        for (Uint32 i = 0; i < count; ++i)
+        {
+            OFStandard::snprintf(filename, sizeof(filename), "parsebench_%05lu.dcm", OFstatic_cast(unsigned long, i));
+            files.push_back(filename);
+            DcmFileFormat fileformat;
+            createDataset(*fileformat.getDataset(), i, frames);
+            if (fileformat.saveFile(filename, EXS_LittleEndianExplicit).bad())
+            {
+                CERR << "Error: cannot write file: " << filename << OFendl;
+                return 1;
+            }
+        }
+    }
+
+    /* the first run only fills the file system cache */
+    int result = 0;
+    double loadTime[2] = { 0.0, 0.0 };
+    double deleteTime[2] = { 0.0, 0.0 };
+    unsigned long elements = 0;
+    double load, del;
+    if (!loadFiles(files, OFFalse, load, del, elements))
+        result = 1;
+    for (Uint32 i = 0; (i < iterations) && (result == 0); ++i)
+    {
+        for (int arena = 0; arena < 2; ++arena)
+        {
+            if (!loadFiles(files, arena != 0, load, del, elements))
+            {
+                result = 1;
+                break;
+            }
+            if ((i == 0) || (load < loadTime[arena]))
+                loadTime[arena] = load;
+            if ((i == 0) || (del < deleteTime[arena]))
+                deleteTime[arena] = del;
+        }
+    }
+
+    if (result == 0)
+    {
+        COUT << files.size() << " files, " << elements / files.size() << " objects per file:" << OFendl;
+        const char *name[2] = { "heap ", "arena" };
+        for (int arena = 0; arena < 2; ++arena)
+        {
+            COUT << "  " << name[arena] << "  load: " << loadTime[arena] * 1000.0 << " ms, delete: "
+                 << deleteTime[arena] * 1000.0 << " ms, total: " << (loadTime[arena] + deleteTime[arena]) * 1000.0 << " ms" << OFendl;
+        }
+    }
+
+    if (synthetic)
+    {
+        OFListIterator(OFString) it = files.begin();
+        while (it != files.end())
+        {
+            OFStandard::deleteFile(*it);
+            ++it;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,302 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: Benchmark for the RLE codec: measures compression and
+ *    decompression throughput for synthetic CT and RGB ultrasound images
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofconsol.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftimer.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcpixseq.h"
+#include "dcmtk/dcmdata/dcpxitem.h"
+#include "dcmtk/dcmdata/dcrledrg.h"
+#include "dcmtk/dcmdata/dcrleerg.h"
+
+#include <cmath>
+
+
+/* simple deterministic pseudo random number generator */
+static Uint32 randomState = 12345;
+
+static Uint32 nextRandom()
+{
+    randomState = randomState * 1103515245 + 12345;
+    return (randomState >> 16) & 0x7fff;
+}
+
+
+/* creates a CT-like image: 512x512 pixels, 16 bits signed, air outside of
+ * the body (long runs), noisy soft tissue and a bone ring (short runs)
+ */
+static void createCTImage(DcmDataset &dset, const Uint32 frames)
+{
+    const Uint32 size = 512;
+    Sint16 *pixels = new Sint16[size * size * frames];
+    Sint16 *p = pixels;
+    for (Uint32 f = 0; f < frames; ++f)
+    {
+        const double radius = 200.0 + 20.0 * sin(OFstatic_cast(double, f) / 7.0);
+        for (Uint32 y = 0; y < size; ++y)
+        {
+            for (Uint32 x = 0; x < size; ++x)
+            {
+                const double dx = OFstatic_cast(double, x) - 256.0;
+                const double dy = (OFstatic_cast(double, y) - 256.0) * 1.3;
+                const double r = sqrt(dx * dx + dy * dy);
+                Sint32 value;
+                if (r > radius)
+                    value = -1000;
+                else if (r > radius - 12.0)
+                    value = 700 + OFstatic_cast(Sint32, nextRandom() % 64);
+                else
+                    value = 40 + OFstatic_cast(Sint32, 30.0 * sin(x / 23.0) * cos(y / 17.0)) + OFstatic_cast(Sint32, nextRandom() % 17) - 8;
+                *p++ = OFstatic_cast(Sint16, value);
+            }
+        }
+    }
+    char buf[16];
+    OFStandard::snprintf(buf, sizeof(buf), "%lu", OFstatic_cast(unsigned long, frames));
+    dset.putAndInsertString(DCM_SOPClassUID, UID_EnhancedCTImageStorage);
+    dset.putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2");
+    dset.putAndInsertUint16(DCM_SamplesPerPixel, 1);
+    dset.putAndInsertUint16(DCM_Rows, OFstatic_cast(Uint16, size));
+    dset.putAndInsertUint16(DCM_Columns, OFstatic_cast(Uint16, size));
+    dset.putAndInsertUint16(DCM_BitsAllocated, 16);
+    dset.putAndInsertUint16(DCM_BitsStored, 16);
+    dset.putAndInsertUint16(DCM_HighBit, 15);
+    dset.putAndInsertUint16(DCM_PixelRepresentation, 1);
+    dset.putAndInsertString(DCM_NumberOfFrames, buf);
+    dset.putAndInsertUint16Array(DCM_PixelData, OFreinterpret_cast(Uint16 *, pixels), size * size * frames);
+    delete[] pixels;
+}
+
+
+/* creates an ultrasound-like RGB image: 640x480 pixels, color-by-pixel,
+ * black background, a gray speckle sector and a color Doppler region
+ */
+static void createRGBImage(DcmDataset &dset, const Uint32 frames)
+{
+    const Uint32 columns = 640;
+    const Uint32 rows = 480;
+    Uint8 *pixels = new Uint8[columns * rows * 3 * frames];
+    Uint8 *p = pixels;
+    for (Uint32 f = 0; f < frames; ++f)
+    {
+        for (Uint32 y = 0; y < rows; ++y)
+        {
+            for (Uint32 x = 0; x < columns; ++x)
+            {
+                const double dx = OFstatic_cast(double, x) - 320.0;
+                const double dy = OFstatic_cast(double, y) + 40.0;
+                const double r = sqrt(dx * dx + dy * dy);
+                Uint8 red = 0;
+                Uint8 green = 0;
+                Uint8 blue = 0;
+                if ((r > 60.0) && (r < 500.0) && (fabs(dx) < dy * 0.8))
+                {
+                    red = green = blue = OFstatic_cast(Uint8, 40 + (nextRandom() % 96));
+                    if ((x > 280 + f % 16) && (x < 380) && (y > 150) && (y < 260))
+                    {
+                        if ((x / 8 + y / 8 + f) % 3 == 0)
+                        {
+                            red = OFstatic_cast(Uint8, 160 + (y % 64));
+                            green = 0;
+                            blue = 0;
+                        }
+                        else if ((x / 8 + y / 8 + f) % 3 == 1)
+                        {
+                            red = 0;
+                            green = 0;
+                            blue = OFstatic_cast(Uint8, 160 + (x % 64));
+                        }
+                    }
+                }
+                *p++ = red;
+                *p++ = green;
+                *p++ = blue;
+            }
+        }
+    }
+    char buf[16];
+    OFStandard::snprintf(buf, sizeof(buf), "%lu", OFstatic_cast(unsigned long, frames));
+    dset.putAndInsertString(DCM_SOPClassUID, UID_UltrasoundMultiframeImageStorage);
+    dset.putAndInsertString(DCM_PhotometricInterpretation, "RGB");
+    dset.putAndInsertUint16(DCM_SamplesPerPixel, 3);
+    dset.putAndInsertUint16(DCM_PlanarConfiguration, 0);
+    dset.putAndInsertUint16(DCM_Rows, OFstatic_cast(Uint16, rows));
+    dset.putAndInsertUint16(DCM_Columns, OFstatic_cast(Uint16, columns));
+    dset.putAndInsertUint16(DCM_BitsAllocated, 8);
+    dset.putAndInsertUint16(DCM_BitsStored, 8);
+    dset.putAndInsertUint16(DCM_HighBit, 7);
+    dset.putAndInsertUint16(DCM_PixelRepresentation, 0);
+    dset.putAndInsertString(DCM_NumberOfFrames, buf);
+    dset.putAndInsertUint8Array(DCM_PixelData, pixels, columns * rows * 3 * frames);
+    delete[] pixels;
+}
+
+
+/* returns the uncompressed pixel data of the given dataset */
+static OFBool getPixelData(DcmDataset &dset, const Uint8 *&pixels, Uint32 &length)
+{
+    DcmElement *elem = NULL;
+    Uint8 *data = NULL;
+    if (dset.findAndGetElement(DCM_PixelData, elem).bad() || elem->getUint8Array(data).bad())
+        return OFFalse;
+    pixels = data;
+    length = elem->getLength();
+    return OFTrue;
+}
+
+
+/* measures compression, decompression and frame access, prints the best of all iterations */
+static OFBool runBenchmark(const char *name,
+                           DcmDataset &original,
+                           const Uint32 frames,
+                           const Uint32 iterations,
+                           const Uint32 threads)
+{
+    const Uint8 *originalPixels = NULL;
+    Uint32 length = 0;
+    if (!getPixelData(original, originalPixels, length))
+        return OFFalse;
+
+    double encodeTime = 0.0;
+    double decodeTime = 0.0;
+    double framesTime = 0.0;
+    size_t compressedSize = 0;
+    for (Uint32 i = 0; i < iterations; ++i)
+    {
+        /* compression */
+        DcmDataset compressed(original);
+        OFTimer encodeTimer;
+        if (compressed.chooseRepresentation(EXS_RLELossless, NULL).bad())
+        {
+            CERR << "Error: cannot compress " << name << " image" << OFendl;
+            return OFFalse;
+        }
+        double time = encodeTimer.getDiff();
+        if ((i == 0) || (time < encodeTime))
+            encodeTime = time;
+        compressed.removeAllButCurrentRepresentations();
+        DcmElement *elem = NULL;
+        compressed.findAndGetElement(DCM_PixelData, elem);
+        DcmPixelData *pixelData = OFstatic_cast(DcmPixelData *, elem);
+        DcmPixelSequence *pixSeq = NULL;
+        if ((pixelData == NULL) || pixelData->getEncapsulatedRepresentation(EXS_RLELossless, NULL, pixSeq).bad() || (pixSeq == NULL))
+            return OFFalse;
+        compressedSize = 0;
+        for (unsigned long j = 1; j < pixSeq->card(); ++j)
+        {
+            DcmPixelItem *item = NULL;
+            if (pixSeq->getItem(item, j).good())
+                compressedSize += item->getLength();
+        }
+
+        /* access to all frames through the frame-based interface */
+        Uint8 *buffer = new Uint8[length];
+        OFString colorModel;
+        OFTimer framesTimer;
+        OFCondition cond = pixelData->getUncompressedFrames(&compressed, 0, frames, buffer, length / frames, colorModel, threads);
+        time = framesTimer.getDiff();
+        if ((i == 0) || (time < framesTime))
+            framesTime = time;
+        if (cond.bad() || (memcmp(buffer, originalPixels, length) != 0))
+        {
+            CERR << "Error: frame-based decompression of " << name << " image failed" << OFendl;
+            delete[] buffer;
+            return OFFalse;
+        }
+        delete[] buffer;
+
+        /* decompression of the complete pixel data */
+        OFTimer decodeTimer;
+        if (compressed.chooseRepresentation(EXS_LittleEndianExplicit, NULL).bad())
+        {
+            CERR << "Error: cannot decompress " << name << " image" << OFendl;
+            return OFFalse;
+        }
+        time = decodeTimer.getDiff();
+        if ((i == 0) || (time < decodeTime))
+            decodeTime = time;
+        const Uint8 *pixels = NULL;
+        Uint32 decodedLength = 0;
+        if (!getPixelData(compressed, pixels, decodedLength) || (decodedLength < length) || (memcmp(pixels, originalPixels, length) != 0))
+        {
+            CERR << "Error: decompressed " << name << " image differs from the original" << OFendl;
+            return OFFalse;
+        }
+    }
+
+    const double megabytes = OFstatic_cast(double, length) / (1024.0 * 1024.0);
+    COUT << name << " (" << frames << " frames, " << megabytes << " MB, ratio "
+         << OFstatic_cast(double, length) / OFstatic_cast(double, compressedSize) << "), " << threads << " thread(s):" << OFendl
+         << "  compression:                " << encodeTime * 1000.0 << " ms (" << megabytes / encodeTime << " MB/s)" << OFendl
+         << "  decompression:              " << decodeTime * 1000.0 << " ms (" << megabytes / decodeTime << " MB/s)" << OFendl
+         << "  getUncompressedFrames():    " << framesTime * 1000.0 << " ms (" << megabytes / framesTime << " MB/s)" << OFendl;
+    return OFTrue;
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (argc > 4)
+    {
+        CERR << "Usage: rlebench [frames [iterations [threads]]]" << OFendl
+             << "  frames      number of frames per image (default: 32)" << OFendl
+             << "  iterations  number of measurements, the best one is reported (default: 3)" << OFendl
+             << "  threads     number of threads for compression and decompression (default: 1)" << OFendl;
+        return 1;
+    }
+
+    const Uint32 frames = (argc > 1) ? OFstatic_cast(Uint32, atoi(argv[1])) : 32;
+    const Uint32 iterations = (argc > 2) ? OFstatic_cast(Uint32, atoi(argv[2])) : 3;
+    const Uint32 threads = (argc > 3) ? OFstatic_cast(Uint32, atoi(argv[3])) : 1;
+    if ((frames < 1) || (iterations < 1) || (threads < 1))
+    {
+        CERR << "Error: invalid parameter value" << OFendl;
+        return 1;
+    }
+
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+        CERR << "Error: no data dictionary loaded, check environment variable: " << DCM_DICT_ENVIRONMENT_VARIABLE << OFendl;
+        return 1;
+    }
+
+    DcmRLEDecoderRegistration::registerCodecs(OFFalse, OFFalse, threads);
+    DcmRLEEncoderRegistration::registerCodecs(OFFalse, 0, OFTrue, OFFalse, threads);
+
+    int result = 0;
+    DcmDataset ct;
+    createCTImage(ct, frames);
+    if (!runBenchmark("CT 512x512x16", ct, frames, iterations, threads))
+        result = 1;
+    DcmDataset rgb;
+    createRGBImage(rgb, frames);
+    if (!runBenchmark("RGB 640x480x8", rgb, frames, iterations, threads))
+        result = 1;
+
+    DcmRLEEncoderRegistration::cleanup();
+    DcmRLEDecoderRegistration::cleanup();
+    return result;
+}
@@ -0,0 +1,113 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: test program for arena allocation of DICOM object trees
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+
+#define NUM_WORDS 4096
+
+OFTEST(dcmdata_arenaAllocation)
+{
+    Uint16 *words = new Uint16[NUM_WORDS];
+    for (Uint16 i = 0; i < NUM_WORDS; ++i)
+        words[i] = OFstatic_cast(Uint16, i * 3 + 1);
+
+    OFString tmpFile;
+    OFCHECK(OFTempFile::createFile(tmpFile, NULL /* fd_out */, O_RDWR,
+        "" /* dir */, "tarena_" /* prefix */, ".dcm" /* postfix */).good());
+    {
+        DcmFileFormat dfile;
+        DcmDataset *dset = dfile.getDataset();
+        OFCHECK(dset->putAndInsertString(DCM_PatientName, "Doe^John").good());
+        OFCHECK(dset->putAndInsertString(DCM_PatientID, "4711").good());
+        DcmItem *item = NULL;
+        for (int i = 0; i < 50; ++i)
+        {
+            OFCHECK(dset->findOrCreateSequenceItem(DCM_ReferencedImageSequence, item, -2).good());
+            OFCHECK(item->putAndInsertString(DCM_ReferencedSOPInstanceUID, "1.2.3.4").good());
+        }
+        // large values are not allocated from the arena
+        OFCHECK(dset->putAndInsertUint16Array(DCM_RWavePointer, words, NUM_WORDS).good());
+        OFCHECK(dfile.saveFile(tmpFile, EXS_LittleEndianExplicit).good());
+    }
+
+    DcmFileFormat *dfile = new DcmFileFormat;
+    OFCHECK(!dfile->getArenaAllocation());
+    dfile->setArenaAllocation(OFTrue);
+    OFCHECK(dfile->loadFile(tmpFile).good());
+    OFCHECK(DcmArena::current() == NULL);
+    DcmDataset *dset = dfile->getDataset();
+
+    OFString value;
+    OFCHECK(dset->findAndGetOFString(DCM_PatientName, value).good());
+    OFCHECK_EQUAL(value, "Doe^John");
+    OFCHECK(dset->findAndGetOFString(DCM_ReferencedSOPInstanceUID, value, 0, OFTrue).good());
+    OFCHECK_EQUAL(value, "1.2.3.4");
+    const Uint16 *values = NULL;
+    unsigned long count = 0;
+    OFCHECK(dset->findAndGetUint16Array(DCM_RWavePointer, values, &count).good());
+    OFCHECK_EQUAL(count, OFstatic_cast(unsigned long, NUM_WORDS));
+    OFCHECK(values != NULL && memcmp(values, words, NUM_WORDS * 2) == 0);
+
+    // short values allocated from the arena cannot be detached, large ones can
+    DcmElement *elem = NULL;
+    OFCHECK(dset->findAndGetElement(DCM_PatientID, elem).good());
+    OFCHECK(elem->detachValueField().bad());
+    OFCHECK(dset->findAndGetElement(DCM_RWavePointer, elem).good());
+    OFCHECK(elem->detachValueField(OFTrue).good());
+    delete[] OFconst_cast(Uint16 *, values);
+
+    // modifying values and inserting new elements (allocated on the heap) works as usual
+    OFCHECK(dset->putAndInsertString(DCM_PatientName, "Doe^Jane").good());
+    OFCHECK(dset->putAndInsertString(DCM_StudyID, "1").good());
+    OFCHECK(dset->findAndGetOFString(DCM_PatientName, value).good());
+    OFCHECK_EQUAL(value, "Doe^Jane");
+
+    // objects removed from the tree outlive the arena's owner
+    DcmElement *patientID = dset->remove(DCM_PatientID);
+    DcmItem *sequenceItem = NULL;
+    OFCHECK(dset->findAndGetSequenceItem(DCM_ReferencedImageSequence, sequenceItem, 10).good());
+    DcmSequenceOfItems *sequence = NULL;
+    OFCHECK(dset->findAndGetSequence(DCM_ReferencedImageSequence, sequence).good());
+    DcmItem *removedItem = sequence->remove(sequenceItem);
+    OFCHECK(removedItem != NULL);
+    OFCHECK(patientID != NULL);
+    delete dfile;
+    if (patientID)
+    {
+        OFCHECK(patientID->getOFString(value, 0).good());
+        OFCHECK_EQUAL(value, "4711");
+        delete patientID;
+    }
+    if (removedItem)
+    {
+        OFCHECK(removedItem->findAndGetOFString(DCM_ReferencedSOPInstanceUID, value).good());
+        OFCHECK_EQUAL(value, "1.2.3.4");
+        delete removedItem;
+    }
+
+    OFStandard::deleteFile(tmpFile);
+    delete[] words;
+}
@@ -0,0 +1,309 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: test program for adding multiple files to a DICOMDIR and for
+ *    writing a DICOMDIR incrementally
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcddirif.h"
+#include "dcmtk/dcmdata/dcdicdir.h"
+
+#define NUM_FILES 24
+
+/* creates a secondary capture image file, patients and studies are shared between files */
+static OFBool createFile(const OFString &directory, const OFString &filename, const int number)
+{
+    char buf[80];
+    DcmFileFormat fileformat;
+    DcmDataset *dset = fileformat.getDataset();
+    const int patient = number % 3;
+    const int study = number % 5;
+    dset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    OFStandard::snprintf(buf, sizeof(buf), "1.2.276.0.7230010.3.1.4.99.%d", number);
+    dset->putAndInsertString(DCM_SOPInstanceUID, buf);
+    OFStandard::snprintf(buf, sizeof(buf), "Patient^%d", patient);
+    dset->putAndInsertString(DCM_PatientName, buf);
+    OFStandard::snprintf(buf, sizeof(buf), "PID%d", patient);
+    dset->putAndInsertString(DCM_PatientID, buf);
+    OFStandard::snprintf(buf, sizeof(buf), "1.2.276.0.7230010.3.1.2.99.%d.%d", patient, study);
+    dset->putAndInsertString(DCM_StudyInstanceUID, buf);
+    OFStandard::snprintf(buf, sizeof(buf), "1.2.276.0.7230010.3.1.3.99.%d.%d", patient, study);
+    dset->putAndInsertString(DCM_SeriesInstanceUID, buf);
+    dset->putAndInsertString(DCM_StudyDate, "20260101");
+    dset->putAndInsertString(DCM_StudyTime, "120000");
+    dset->putAndInsertString(DCM_StudyID, "1");
+    dset->putAndInsertString(DCM_AccessionNumber, "");
+    dset->putAndInsertString(DCM_Modality, "OT");
+    dset->putAndInsertString(DCM_SeriesNumber, "1");
+    OFStandard::snprintf(buf, sizeof(buf), "%d", number + 1);
+    dset->putAndInsertString(DCM_InstanceNumber, buf);
+    dset->putAndInsertUint16(DCM_SamplesPerPixel, 1);
+    dset->putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2");
+    dset->putAndInsertUint16(DCM_Rows, 16);
+    dset->putAndInsertUint16(DCM_Columns, 16);
+    dset->putAndInsertUint16(DCM_BitsAllocated, 8);
+    dset->putAndInsertUint16(DCM_BitsStored, 8);
+    dset->putAndInsertUint16(DCM_HighBit, 7);
+    dset->putAndInsertUint16(DCM_PixelRepresentation, 0);
+    Uint8 pixels[16 * 16];
+    for (int i = 0; i < 16 * 16; ++i)
+        pixels[i] = OFstatic_cast(Uint8, i + number);
+    dset->putAndInsertUint8Array(DCM_PixelData, pixels, 16 * 16);
+    OFFilename pathname;
+    OFStandard::combineDirAndFilename(pathname, directory, filename);
+    return fileformat.saveFile(pathname, EXS_LittleEndianExplicit).good();
+}
+
+/* creates a DICOMDIR for the given files and returns the dump of its dataset */
+static OFCondition createDicomDir(const OFString &dicomdir,
+                                  const OFString &directory,
+                                  const OFList<OFFilename> &filenames,
+                                  const unsigned int numThreads,
+                                  const OFBool abortMode,
+                                  OFString &badFiles,
+                                  size_t &goodFiles,
+                                  OFString &dump)
+{
+    DicomDirInterface ddir;
+    ddir.enableAbortMode(abortMode);
+    ddir.disableBackupMode();
+    OFCHECK(ddir.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dicomdir).good());
+    OFList<OFFilename> badFileList;
+    const OFCondition result = ddir.addDicomFiles(filenames, directory, badFileList, goodFiles, numThreads);
+    badFiles.clear();
+    OFListIterator(OFFilename) iter = badFileList.begin();
+    while (iter != badFileList.end())
+    {
+        badFiles += OFSTRING_GUARD(iter->getCharPointer());
+        badFiles += ";";
+        ++iter;
+    }
+    OFCHECK(ddir.writeDicomDir().good());
+    DcmFileFormat fileformat;
+    OFCHECK(fileformat.loadFile(dicomdir).good());
+    OFOStringStream stream;
+    fileformat.getDataset()->print(stream);
+    stream << OFStringStream_ends;
+    OFSTRINGSTREAM_GETOFSTRING(stream, tmpString)
+    dump = tmpString;
+    return result;
+}
+
+OFTEST(dcmdata_dicomDirInterface_addDicomFiles)
+{
+    OFString directory;
+    OFTempFile::getTempPath(directory);
+    char filename[16];
+    const long pid = OFStandard::getProcessID() % 10000;
+    OFList<OFFilename> filenames;
+    for (int i = 0; i < NUM_FILES; ++i)
+    {
+        OFStandard::snprintf(filename, sizeof(filename), "TD%04ld%02d", pid, i);
+        filenames.push_back(filename);
+        /* file number 7 does not exist, i.e. cannot be added */
+        if (i != 7)
+            OFCHECK(createFile(directory, filename, i));
+    }
+    OFString dicomdir1, dicomdir2;
+    OFCHECK(OFTempFile::createFile(dicomdir1, NULL /* fd_out */, O_RDWR,
+        "" /* dir */, "tddirif_" /* prefix */, ".dcm" /* postfix */).good());
+    OFCHECK(OFTempFile::createFile(dicomdir2, NULL /* fd_out */, O_RDWR,
+        "" /* dir */, "tddirif_" /* prefix */, ".dcm" /* postfix */).good());
+
+    /* records are created in the same order, no matter how many threads are used */
+    OFString badFiles1, badFiles2;
+    size_t goodFiles1 = 0, goodFiles2 = 0;
+    OFString dump1, dump2;
+    OFCHECK(createDicomDir(dicomdir1, directory, filenames, 1, OFFalse, badFiles1, goodFiles1, dump1).good());
+    OFCHECK(createDicomDir(dicomdir2, directory, filenames, 4, OFFalse, badFiles2, goodFiles2, dump2).good());
+    OFStandard::snprintf(filename, sizeof(filename), "TD%04ld07;", pid);
+    OFCHECK_EQUAL(badFiles1, filename);
+    OFCHECK_EQUAL(badFiles2, filename);
+    OFCHECK_EQUAL(goodFiles1, NUM_FILES - 1);
+    OFCHECK_EQUAL(goodFiles2, NUM_FILES - 1);
+    OFCHECK(!dump1.empty());
+    OFCHECK(dump1 == dump2);
+
+    /* in abort mode, only the files before the bad one are added */
+    OFCondition result1 = createDicomDir(dicomdir1, directory, filenames, 1, OFTrue, badFiles1, goodFiles1, dump1);
+    OFCondition result2 = createDicomDir(dicomdir2, directory, filenames, 4, OFTrue, badFiles2, goodFiles2, dump2);
+    OFCHECK(result1.bad());
+    OFCHECK(result1 == result2);
+    OFCHECK_EQUAL(badFiles1, filename);
+    OFCHECK_EQUAL(badFiles2, filename);
+    OFCHECK_EQUAL(goodFiles1, 7);
+    OFCHECK_EQUAL(goodFiles2, 7);
+    OFCHECK(dump1 == dump2);
+
+    OFListIterator(OFFilename) iter = filenames.begin();
+    while (iter != filenames.end())
+    {
+        OFFilename pathname;
+        OFStandard::combineDirAndFilename(pathname, directory, *iter++);
+        OFStandard::deleteFile(pathname);
+    }
+    OFStandard::deleteFile(dicomdir1);
+    OFStandard::deleteFile(dicomdir2);
+}
+
+
+/* adds the given files to a new (mode 0) or existing DICOMDIR (mode 1 = append, 2 = update) */
+static void addFiles(const OFString &dicomdir,
+                     const OFString &directory,
+                     const OFList<OFFilename> &filenames,
+                     const int mode,
+                     const E_EncodingType enctype,
+                     const OFBool incremental)
+{
+    DicomDirInterface ddir;
+    ddir.disableBackupMode();
+    ddir.enableIncrementalWriteMode(incremental);
+    if (mode == 0)
+        OFCHECK(ddir.createNewDicomDir(DicomDirInterface::AP_GeneralPurpose, dicomdir).good());
+    else if (mode == 1)
+        OFCHECK(ddir.appendToDicomDir(DicomDirInterface::AP_GeneralPurpose, dicomdir).good());
+    else
+        OFCHECK(ddir.updateDicomDir(DicomDirInterface::AP_GeneralPurpose, dicomdir).good());
+    OFList<OFFilename> badFiles;
+    size_t goodFiles = 0;
+    OFCHECK(ddir.addDicomFiles(filenames, directory, badFiles, goodFiles).good());
+    OFCHECK(badFiles.empty());
+    OFCHECK(ddir.writeDicomDir(enctype).good());
+}
+
+/* describes the given record and its subordinate records (without any offsets),
+ * the file offsets of the image records are stored separately
+ */
+static void describeRecords(DcmDirectoryRecord *record,
+                            OFString &description,
+                            OFMap<OFString, Uint32> &imageOffsets)
+{
+    OFString value;
+    const unsigned long count = record->cardSub();
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        DcmDirectoryRecord *subRecord = record->getSub(i);
+        if (subRecord->findAndGetOFString(DCM_DirectoryRecordType, value).good())
+            description += value;
+        if (subRecord->findAndGetOFString(DCM_PatientID, value).good())
+            description += " " + value;
+        if (subRecord->findAndGetOFString(DCM_StudyInstanceUID, value).good())
+            description += " " + value;
+        if (subRecord->findAndGetOFString(DCM_SeriesInstanceUID, value).good())
+            description += " " + value;
+        if (subRecord->findAndGetOFStringArray(DCM_ReferencedFileID, value).good())
+        {
+            description += " " + value;
+            imageOffsets[value] = subRecord->getFileOffset();
+        }
+        description += " (";
+        describeRecords(subRecord, description, imageOffsets);
+        description += ") ";
+    }
+}
+
+/* loads the given DICOMDIR and describes its records */
+static void describeDicomDir(const OFString &dicomdir,
+                             OFString &description,
+                             OFMap<OFString, Uint32> &imageOffsets)
+{
+    DcmDicomDir dicomDir(dicomdir);
+    OFCHECK(dicomDir.error().good());
+    description.clear();
+    imageOffsets.clear();
+    describeRecords(&dicomDir.getRootRecord(), description, imageOffsets);
+}
+
+OFTEST(dcmdata_dicomDirInterface_incrementalWrite)
+{
+    OFString directory;
+    OFTempFile::getTempPath(directory);
+    char filename[16];
+    const long pid = OFStandard::getProcessID() % 10000;
+    OFList<OFFilename> filenames[3];
+    for (int i = 0; i < NUM_FILES; ++i)
+    {
+        OFStandard::snprintf(filename, sizeof(filename), "TI%04ld%02d", pid, i);
+        /* the first half of the files is used for creating the DICOMDIR */
+        filenames[(i < NUM_FILES / 2) ? 0 : ((i < NUM_FILES * 3 / 4) ? 1 : 2)].push_back(filename);
+        OFCHECK(createFile(directory, filename, i));
+    }
+    OFString dicomdir1, dicomdir2;
+    OFCHECK(OFTempFile::createFile(dicomdir1, NULL /* fd_out */, O_RDWR,
+        "" /* dir */, "tddirif_" /* prefix */, ".dcm" /* postfix */).good());
+    OFCHECK(OFTempFile::createFile(dicomdir2, NULL /* fd_out */, O_RDWR,
+        "" /* dir */, "tddirif_" /* prefix */, ".dcm" /* postfix */).good());
+
+    for (int enc = 0; enc < 2; ++enc)
+    {
+        const E_EncodingType enctype = (enc == 0) ? EET_ExplicitLength : EET_UndefinedLength;
+        OFString description0, description1, description2;
+        OFMap<OFString, Uint32> offsets0, offsets1, offsets2;
+        addFiles(dicomdir1, directory, filenames[0], 0 /* create */, enctype, OFFalse);
+        OFCHECK(OFStandard::copyFile(dicomdir1, dicomdir2));
+        describeDicomDir(dicomdir1, description0, offsets0);
+        OFCHECK_EQUAL(offsets0.size(), OFstatic_cast(size_t, NUM_FILES / 2));
+
+        /* append the remaining files in two steps, the second DICOMDIR is written incrementally */
+        for (int step = 1; step < 3; ++step)
+        {
+            addFiles(dicomdir1, directory, filenames[step], 1 /* append */, enctype, OFFalse);
+            addFiles(dicomdir2, directory, filenames[step], 1 /* append */, enctype, OFTrue);
+        }
+        OFCHECK_EQUAL(OFStandard::getFileSize(dicomdir1), OFStandard::getFileSize(dicomdir2));
+        describeDicomDir(dicomdir1, description1, offsets1);
+        describeDicomDir(dicomdir2, description2, offsets2);
+        OFCHECK_EQUAL(offsets2.size(), OFstatic_cast(size_t, NUM_FILES));
+        OFCHECK(description1 == description2);
+        OFCHECK(description0 != description2);
+
+        /* existing records are not moved within the file */
+        OFMap<OFString, Uint32>::iterator iter = offsets0.begin();
+        while (iter != offsets0.end())
+        {
+            OFCHECK_EQUAL(offsets2[iter->first], iter->second);
+            ++iter;
+        }
+
+        /* updating existing records does not change the size of the file */
+        const size_t fileSize = OFStandard::getFileSize(dicomdir2);
+        addFiles(dicomdir2, directory, filenames[1], 2 /* update */, enctype, OFTrue);
+        OFCHECK_EQUAL(OFStandard::getFileSize(dicomdir2), fileSize);
+        describeDicomDir(dicomdir2, description2, offsets2);
+        OFCHECK(description1 == description2);
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+        OFListIterator(OFFilename) iter = filenames[i].begin();
+        while (iter != filenames[i].end())
+        {
+            OFFilename pathname;
+            OFStandard::combineDirAndFilename(pathname, directory, *iter++);
+            OFStandard::deleteFile(pathname);
+        }
+    }
+    OFStandard::deleteFile(dicomdir1);
+    OFStandard::deleteFile(dicomdir2);
+}
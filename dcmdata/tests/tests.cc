@@ -24,6 +24,7 @@
 #include "dcmtk/ofstd/oftest.h"
 
 OFTEST_REGISTER(dcmdata_partialElementAccess);
+OFTEST_REGISTER(dcmdata_partialElementAccess_frames);
 OFTEST_REGISTER(dcmdata_i2d_bmp);
 OFTEST_REGISTER(dcmdata_checkStringValue);
 OFTEST_REGISTER(dcmdata_determineVM);
@@ -97,6 +98,7 @@ OFTEST_REGISTER(dcmdata_sequenceInsert);
 OFTEST_REGISTER(dcmdata_pixelSequenceInsert);
 OFTEST_REGISTER(dcmdata_findAndGetSequenceItem);
 OFTEST_REGISTER(dcmdata_findAndGetUint16Array);
+OFTEST_REGISTER(dcmdata_insertAndFindElementsUnordered);
 OFTEST_REGISTER(dcmdata_parser_missingDelimitationItems);
 OFTEST_REGISTER(dcmdata_parser_missingSequenceDelimitationItem_1);
 OFTEST_REGISTER(dcmdata_parser_missingSequenceDelimitationItem_2);
@@ -134,6 +136,19 @@ OFTEST_REGISTER(dcmdata_nestingDepthLimit_customLimit);
 OFTEST_REGISTER(dcmdata_nestingDepthLimit_disabled);
 OFTEST_REGISTER(dcmdata_nestingDepthLimit_datasetAPI);
 OFTEST_REGISTER(dcmdata_nestingDepthLimit_fileFormatAPI);
+OFTEST_REGISTER(dcmdata_memoryMappedInput);
+OFTEST_REGISTER(dcmdata_memoryMappedInput_fallback);
+OFTEST_REGISTER(dcmdata_arenaAllocation);
+OFTEST_REGISTER(dcmdata_swapBytes);
+OFTEST_REGISTER(dcmdata_getPartialValue_swapped);
+OFTEST_REGISTER(dcmdata_outputStream_writeBlocks);
+OFTEST_REGISTER(dcmdata_outputStream_writeDataset);
+OFTEST_REGISTER(dcmdata_dicomDirInterface_addDicomFiles);
+OFTEST_REGISTER(dcmdata_dicomDirInterface_incrementalWrite);
+OFTEST_REGISTER(dcmdata_getUncompressedFrames);
+OFTEST_REGISTER(dcmdata_getUncompressedFrames_offsetTable);
+OFTEST_REGISTER(dcmdata_RLECodec_threads);
+OFTEST_REGISTER(dcmdata_concurrentFrameEncoder);
 OFTEST_REGISTER(dcmdata_condition_existence);
 OFTEST_REGISTER(dcmdata_condition_US);
 OFTEST_REGISTER(dcmdata_condition_SS);
@@ -0,0 +1,228 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: test program for decompression of multiple frames
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcpixseq.h"
+#include "dcmtk/dcmdata/dcpxitem.h"
+#include "dcmtk/dcmdata/dcrledrg.h"
+#include "dcmtk/dcmdata/dcrleerg.h"
+
+#define NUM_FRAMES 24
+#define ROWS 19
+#define COLUMNS 23
+#define FRAME_SIZE (ROWS * COLUMNS * 2)
+
+/* creates an RLE compressed multi-frame image with 16 bits per pixel */
+static void createRLEImage(DcmDataset &dset, Uint16 *pixels)
+{
+    for (unsigned long i = 0; i < NUM_FRAMES * ROWS * COLUMNS; ++i)
+        pixels[i] = OFstatic_cast(Uint16, (i * 13) ^ (i / (ROWS * COLUMNS)));
+    OFCHECK(dset.putAndInsertString(DCM_SOPClassUID, UID_MultiframeGrayscaleWordSecondaryCaptureImageStorage).good());
+    OFCHECK(dset.putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2").good());
+    OFCHECK(dset.putAndInsertUint16(DCM_SamplesPerPixel, 1).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Rows, ROWS).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Columns, COLUMNS).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_BitsAllocated, 16).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_BitsStored, 16).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_HighBit, 15).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_PixelRepresentation, 0).good());
+    OFCHECK(dset.putAndInsertString(DCM_NumberOfFrames, "24").good());
+    OFCHECK(dset.putAndInsertUint16Array(DCM_PixelData, pixels, NUM_FRAMES * ROWS * COLUMNS).good());
+    OFCHECK(dset.chooseRepresentation(EXS_RLELossless, NULL).good());
+    dset.removeAllButCurrentRepresentations();
+}
+
+/* checks the decompression of all frames and of a range of frames */
+static void checkFrames(DcmDataset &dset, const Uint16 *pixels, const Uint32 numThreads)
+{
+    DcmElement *elem = NULL;
+    OFCHECK(dset.findAndGetElement(DCM_PixelData, elem).good());
+    DcmPixelData *pixelData = OFstatic_cast(DcmPixelData *, elem);
+    if (pixelData == NULL) return;
+
+    Uint8 *buffer = new Uint8[NUM_FRAMES * (FRAME_SIZE + 2)];
+    OFString colorModel;
+    OFCHECK(pixelData->getUncompressedFrames(&dset, 0, NUM_FRAMES, buffer, FRAME_SIZE, colorModel, numThreads).good());
+    OFCHECK_EQUAL(colorModel, "MONOCHROME2");
+    OFCHECK(memcmp(buffer, pixels, NUM_FRAMES * FRAME_SIZE) == 0);
+
+    // a range of frames with a buffer size larger than the frame size
+    memset(buffer, 0, NUM_FRAMES * (FRAME_SIZE + 2));
+    OFCHECK(pixelData->getUncompressedFrames(&dset, 5, 11, buffer, FRAME_SIZE + 2, colorModel, numThreads).good());
+    for (Uint32 i = 0; i < 11; ++i)
+        OFCHECK(memcmp(buffer + i * (FRAME_SIZE + 2), pixels + (i + 5) * ROWS * COLUMNS, FRAME_SIZE) == 0);
+
+    // invalid frame ranges and buffer sizes
+    OFCHECK(pixelData->getUncompressedFrames(&dset, 0, 0, buffer, FRAME_SIZE, colorModel, numThreads).bad());
+    OFCHECK(pixelData->getUncompressedFrames(&dset, 20, 5, buffer, FRAME_SIZE, colorModel, numThreads).bad());
+    OFCHECK(pixelData->getUncompressedFrames(&dset, NUM_FRAMES, 1, buffer, FRAME_SIZE, colorModel, numThreads).bad());
+    OFCHECK(pixelData->getUncompressedFrames(&dset, 0, 2, buffer, FRAME_SIZE - 2, colorModel, numThreads).bad());
+    delete[] buffer;
+}
+
+OFTEST(dcmdata_getUncompressedFrames)
+{
+    DcmRLEDecoderRegistration::registerCodecs();
+    DcmRLEEncoderRegistration::registerCodecs();
+
+    Uint16 *pixels = new Uint16[NUM_FRAMES * ROWS * COLUMNS];
+    DcmDataset dset;
+    createRLEImage(dset, pixels);
+    checkFrames(dset, pixels, 1);
+    checkFrames(dset, pixels, 4);
+    checkFrames(dset, pixels, NUM_FRAMES + 1);
+    delete[] pixels;
+
+    DcmRLEEncoderRegistration::cleanup();
+    DcmRLEDecoderRegistration::cleanup();
+}
+
+OFTEST(dcmdata_getUncompressedFrames_offsetTable)
+{
+    DcmRLEDecoderRegistration::registerCodecs();
+    DcmRLEEncoderRegistration::registerCodecs();
+
+    Uint16 *pixels = new Uint16[NUM_FRAMES * ROWS * COLUMNS];
+    DcmDataset dset;
+    createRLEImage(dset, pixels);
+
+    // create a pixel sequence with two fragments per frame, the second of which
+    // is ignored by the RLE decoder, and a basic offset table
+    DcmElement *elem = NULL;
+    DcmPixelSequence *pixSeq = NULL;
+    OFCHECK(dset.findAndGetElement(DCM_PixelData, elem).good());
+    DcmPixelData *pixelData = OFstatic_cast(DcmPixelData *, elem);
+    OFCHECK(pixelData != NULL && pixelData->getEncapsulatedRepresentation(EXS_RLELossless, NULL, pixSeq).good());
+    if (pixSeq == NULL) return;
+    OFCHECK_EQUAL(pixSeq->card(), OFstatic_cast(unsigned long, NUM_FRAMES + 1));
+
+    DcmPixelSequence *newPixSeq = new DcmPixelSequence(DCM_PixelSequenceTag);
+    DcmPixelItem *offsetTable = new DcmPixelItem(DCM_PixelItemTag);
+    OFCHECK(newPixSeq->insert(offsetTable).good());
+    DcmOffsetList offsetList;
+    const Uint8 padding[2] = { 0, 0 };
+    for (unsigned long i = 1; i <= NUM_FRAMES; ++i)
+    {
+        DcmPixelItem *fragment = NULL;
+        OFCHECK(pixSeq->getItem(fragment, i).good());
+        DcmPixelItem *extraFragment = new DcmPixelItem(DCM_PixelItemTag);
+        OFCHECK(extraFragment->putUint8Array(padding, 2).good());
+        OFCHECK(newPixSeq->insert(new DcmPixelItem(*fragment)).good());
+        OFCHECK(newPixSeq->insert(extraFragment).good());
+        offsetList.push_back(fragment->getLength() + 8 + 2 + 8);
+    }
+    OFCHECK(offsetTable->createOffsetTable(offsetList).good());
+    pixelData->putOriginalRepresentation(EXS_RLELossless, NULL, newPixSeq);
+
+    checkFrames(dset, pixels, 1);
+    checkFrames(dset, pixels, 3);
+
+    delete[] pixels;
+
+    DcmRLEEncoderRegistration::cleanup();
+    DcmRLEDecoderRegistration::cleanup();
+}
+
+/* compresses and decompresses an image with the given number of threads,
+ * returns the compressed frames (concatenated)
+ */
+static OFString checkRLECodec(const Uint8 *pixels, const Uint16 samplesPerPixel, const Uint16 bitsAllocated, const Uint32 numThreads)
+{
+    DcmRLEDecoderRegistration::registerCodecs(OFFalse, OFFalse, numThreads);
+    DcmRLEEncoderRegistration::registerCodecs(OFFalse, 0, OFTrue, OFFalse, numThreads);
+
+    const Uint32 length = NUM_FRAMES * ROWS * COLUMNS * samplesPerPixel * (bitsAllocated / 8);
+    DcmDataset dset;
+    OFCHECK(dset.putAndInsertString(DCM_PhotometricInterpretation, (samplesPerPixel == 3) ? "RGB" : "MONOCHROME2").good());
+    OFCHECK(dset.putAndInsertUint16(DCM_SamplesPerPixel, samplesPerPixel).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_PlanarConfiguration, 0).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Rows, ROWS).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Columns, COLUMNS).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_BitsAllocated, bitsAllocated).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_BitsStored, bitsAllocated).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_HighBit, OFstatic_cast(Uint16, bitsAllocated - 1)).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_PixelRepresentation, 0).good());
+    OFCHECK(dset.putAndInsertString(DCM_NumberOfFrames, "24").good());
+    if (bitsAllocated == 8)
+        OFCHECK(dset.putAndInsertUint8Array(DCM_PixelData, pixels, length).good());
+    else
+        OFCHECK(dset.putAndInsertUint16Array(DCM_PixelData, OFreinterpret_cast(const Uint16 *, pixels), length / 2).good());
+    OFCHECK(dset.chooseRepresentation(EXS_RLELossless, NULL).good());
+    dset.removeAllButCurrentRepresentations();
+
+    // collect the compressed frames
+    OFString compressed;
+    DcmElement *elem = NULL;
+    DcmPixelSequence *pixSeq = NULL;
+    OFCHECK(dset.findAndGetElement(DCM_PixelData, elem).good());
+    DcmPixelData *pixelData = OFstatic_cast(DcmPixelData *, elem);
+    OFCHECK(pixelData != NULL && pixelData->getEncapsulatedRepresentation(EXS_RLELossless, NULL, pixSeq).good());
+    if (pixSeq != NULL)
+    {
+        OFCHECK_EQUAL(pixSeq->card(), OFstatic_cast(unsigned long, NUM_FRAMES + 1));
+        for (unsigned long i = 1; i < pixSeq->card(); ++i)
+        {
+            DcmPixelItem *item = NULL;
+            Uint8 *data = NULL;
+            OFCHECK(pixSeq->getItem(item, i).good());
+            if (item != NULL && item->getUint8Array(data).good() && data != NULL)
+                compressed.append(OFreinterpret_cast(const char *, data), item->getLength());
+        }
+    }
+
+    // decompress all frames at once
+    Uint8 *decompressed = NULL;
+    OFCHECK(dset.chooseRepresentation(EXS_LittleEndianExplicit, NULL).good());
+    OFCHECK(dset.findAndGetElement(DCM_PixelData, elem).good());
+    OFCHECK(elem != NULL && elem->getLength() == length);
+    OFCHECK(elem != NULL && elem->getUint8Array(decompressed).good());
+    OFCHECK(decompressed != NULL && memcmp(decompressed, pixels, length) == 0);
+
+    DcmRLEEncoderRegistration::cleanup();
+    DcmRLEDecoderRegistration::cleanup();
+    return compressed;
+}
+
+OFTEST(dcmdata_RLECodec_threads)
+{
+    // pixel data with runs and literals of different lengths
+    const Uint32 length = NUM_FRAMES * ROWS * COLUMNS * 6;
+    Uint8 *pixels = new Uint8[length];
+    for (Uint32 i = 0; i < length; ++i)
+        pixels[i] = OFstatic_cast(Uint8, (i % 97 < 40) ? (i / 300) : (i * 13) ^ (i >> 7));
+
+    // monochrome and RGB images with 8 and 16 bits per sample
+    for (Uint16 samplesPerPixel = 1; samplesPerPixel <= 3; samplesPerPixel += 2)
+    {
+        for (Uint16 bitsAllocated = 8; bitsAllocated <= 16; bitsAllocated += 8)
+        {
+            const OFString sequential = checkRLECodec(pixels, samplesPerPixel, bitsAllocated, 1);
+            OFCHECK(!sequential.empty());
+            OFCHECK(checkRLECodec(pixels, samplesPerPixel, bitsAllocated, 4) == sequential);
+            OFCHECK(checkRLECodec(pixels, samplesPerPixel, bitsAllocated, NUM_FRAMES + 1) == sequential);
+        }
+    }
+    delete[] pixels;
+}
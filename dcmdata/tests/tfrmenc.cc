@@ -0,0 +1,101 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: test program for class DcmConcurrentFrameEncoder
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmdata/dcfrmenc.h"
+#include "dcmtk/dcmdata/dcpxitem.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcerror.h"
+
+#define NUM_FRAMES 37
+
+/* "compresses" frame n into n+1 bytes with value n, fails for a given frame */
+class TestFrameEncoder: public DcmConcurrentFrameEncoder
+{
+public:
+    TestFrameEncoder(Uint32 numThreads, Uint32 failingFrame)
+    : DcmConcurrentFrameEncoder(numThreads)
+    , failingFrame_(failingFrame)
+    , threadNumbersValid_(OFTrue)
+    {
+    }
+
+    OFBool threadNumbersValid() const { return threadNumbersValid_; }
+
+protected:
+    virtual OFCondition encodeFrame(Uint32 frameNo, Uint32 threadNo, Uint8 *&compressedData, Uint32 &compressedLen)
+    {
+        if (threadNo >= getNumberOfThreads()) threadNumbersValid_ = OFFalse;
+        if (frameNo == failingFrame_) return EC_CorruptedData;
+        compressedLen = frameNo + 1;
+        compressedData = new Uint8[compressedLen];
+        memset(compressedData, OFstatic_cast(int, frameNo), compressedLen);
+        return EC_Normal;
+    }
+
+private:
+    Uint32 failingFrame_;
+    OFBool threadNumbersValid_;
+};
+
+static void checkEncodeFrames(Uint32 numThreads)
+{
+    TestFrameEncoder encoder(numThreads, NUM_FRAMES);
+    DcmPixelSequence pixSeq(DCM_PixelSequenceTag);
+    DcmOffsetList offsetList;
+    size_t compressedSize = 0;
+    OFCHECK(encoder.encodeFrames(NUM_FRAMES, &pixSeq, offsetList, 0, compressedSize).good());
+    OFCHECK(encoder.threadNumbersValid());
+    OFCHECK_EQUAL(compressedSize, OFstatic_cast(size_t, NUM_FRAMES * (NUM_FRAMES + 1) / 2));
+    OFCHECK_EQUAL(pixSeq.card(), OFstatic_cast(unsigned long, NUM_FRAMES));
+    OFCHECK_EQUAL(offsetList.size(), OFstatic_cast(size_t, NUM_FRAMES));
+
+    // the frames must be stored in frame order
+    DcmOffsetList::const_iterator offset = offsetList.begin();
+    for (Uint32 i = 0; i < NUM_FRAMES; ++i, ++offset)
+    {
+        DcmPixelItem *item = NULL;
+        Uint8 *data = NULL;
+        OFCHECK(pixSeq.getItem(item, i).good());
+        if (item == NULL) continue;
+        OFCHECK_EQUAL(item->getLength(), i + 1 + ((i + 1) & 1));
+        OFCHECK(item->getUint8Array(data).good());
+        OFCHECK(data != NULL && data[0] == i && data[i] == i);
+        OFCHECK_EQUAL(*offset, OFstatic_cast(Uint32, i + 1 + 8 + ((i + 1) & 1)));
+    }
+
+    // a failing frame must stop the compression and report the error
+    TestFrameEncoder failingEncoder(numThreads, 17);
+    DcmPixelSequence failedPixSeq(DCM_PixelSequenceTag);
+    offsetList.clear();
+    OFCHECK(failingEncoder.encodeFrames(NUM_FRAMES, &failedPixSeq, offsetList, 0, compressedSize) == EC_CorruptedData);
+    OFCHECK(failedPixSeq.card() <= 17);
+}
+
+OFTEST(dcmdata_concurrentFrameEncoder)
+{
+    checkEncodeFrames(1);
+    checkEncodeFrames(4);
+    checkEncodeFrames(NUM_FRAMES + 3);
+}
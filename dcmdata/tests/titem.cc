@@ -48,3 +48,53 @@ OFTEST(dcmdata_findAndGetUint16Array)
     OFCHECK(item.findAndGetUint16Array(DCM_FrameIncrementPointer, uintVals, &numUints).good());
     OFCHECK_EQUAL(numUints, 2);
 }
+
+
+OFTEST(dcmdata_insertAndFindElementsUnordered)
+{
+    DcmItem item;
+    const Uint16 numElements = 500;
+    /* insert elements in a "random" order (0x0011 is coprime to 500) */
+    for (Uint16 i = 0; i < numElements; ++i)
+    {
+        const Uint16 elemNo = OFstatic_cast(Uint16, (i * 0x0011) % numElements + 1);
+        DcmElement *elem = new DcmUnsignedShort(DcmTag(0x0009, elemNo, EVR_US));
+        OFCHECK(elem->putUint16(elemNo).good());
+        OFCHECK(item.insert(elem).good());
+    }
+    OFCHECK_EQUAL(item.card(), numElements);
+    /* replacing and inserting an existing tag twice */
+    DcmElement *newElem = new DcmUnsignedShort(DcmTag(0x0009, 0x0100, EVR_US));
+    OFCHECK(newElem->putUint16(0x0100).good());
+    OFCHECK(item.insert(newElem, OFTrue).good());
+    DcmElement *dupElem = new DcmUnsignedShort(DcmTag(0x0009, 0x0100, EVR_US));
+    OFCHECK(item.insert(dupElem, OFFalse).bad());
+    delete dupElem;
+    OFCHECK_EQUAL(item.card(), numElements);
+    /* the element list must be sorted by tag and each element must be found */
+    for (unsigned long j = 0; j < item.card(); ++j)
+    {
+        DcmElement *elem = item.getElement(j);
+        OFCHECK(elem != NULL && elem->getTag() == DcmTagKey(0x0009, OFstatic_cast(Uint16, j + 1)));
+    }
+    Uint16 value = 0;
+    for (Uint16 k = 1; k <= numElements; ++k)
+    {
+        OFCHECK(item.findAndGetUint16(DcmTagKey(0x0009, k), value).good());
+        OFCHECK_EQUAL(value, k);
+    }
+    OFCHECK(item.findAndGetUint16(DcmTagKey(0x0009, 0x0000), value).bad());
+    OFCHECK(item.findAndGetUint16(DcmTagKey(0x0009, numElements + 1), value).bad());
+    /* remove elements by tag, by pointer and by position */
+    OFCHECK(item.findAndDeleteElement(DcmTagKey(0x0009, 0x0002)).good());
+    DcmElement *elem = NULL;
+    OFCHECK(item.findAndGetElement(DcmTagKey(0x0009, 0x0004), elem).good());
+    delete item.remove(elem);
+    delete item.remove(OFstatic_cast(unsigned long, 0));
+    OFCHECK_EQUAL(item.card(), numElements - 3);
+    OFCHECK(!item.tagExists(DcmTagKey(0x0009, 0x0001)));
+    OFCHECK(!item.tagExists(DcmTagKey(0x0009, 0x0002)));
+    OFCHECK(item.tagExists(DcmTagKey(0x0009, 0x0003)));
+    OFCHECK(!item.tagExists(DcmTagKey(0x0009, 0x0004)));
+    OFCHECK(item.getElement(1)->getTag() == DcmTagKey(0x0009, 0x0005));
+}
@@ -0,0 +1,118 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: test program for memory-mapped file input
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcistrmm.h"
+
+#define NUM_WORDS 16384
+
+static void createTestFile(OFString &tmpFile, const E_TransferSyntax xfer, const Uint16 *words)
+{
+    OFCHECK(OFTempFile::createFile(tmpFile, NULL /* fd_out */, O_RDWR,
+        "" /* dir */, "tmapfile_" /* prefix */, ".dcm" /* postfix */).good());
+    DcmFileFormat dfile;
+    DcmDataset *dset = dfile.getDataset();
+    OFCHECK(dset->putAndInsertString(DCM_PatientName, "Doe^John").good());
+    OFCHECK(dset->putAndInsertUint8Array(DCM_EncapsulatedDocument, OFreinterpret_cast(const Uint8 *, words), NUM_WORDS * 2).good());
+    OFCHECK(dset->putAndInsertUint16Array(DCM_RWavePointer, words, NUM_WORDS).good());
+    OFCHECK(dfile.saveFile(tmpFile, xfer).good());
+}
+
+static void checkMappedFile(const E_TransferSyntax xfer, const Uint32 maxReadLength)
+{
+    Uint16 *words = new Uint16[NUM_WORDS];
+    for (Uint16 i = 0; i < NUM_WORDS; ++i)
+        words[i] = OFstatic_cast(Uint16, i * 7 + 1);
+    OFString tmpFile;
+    createTestFile(tmpFile, xfer, words);
+
+    dcmUseMemoryMappedFileInput.set(OFTrue);
+    DcmFileFormat *dfile = new DcmFileFormat;
+    OFCHECK(dfile->loadFile(tmpFile, EXS_Unknown, EGL_noChange, maxReadLength).good());
+    dcmUseMemoryMappedFileInput.set(OFFalse);
+
+    OFString name;
+    OFCHECK(dfile->getDataset()->findAndGetOFString(DCM_PatientName, name).good());
+    OFCHECK_EQUAL(name, "Doe^John");
+
+    const Uint8 *bytes = NULL;
+    OFCHECK(dfile->getDataset()->findAndGetUint8Array(DCM_EncapsulatedDocument, bytes).good());
+    OFCHECK(bytes != NULL && memcmp(bytes, words, NUM_WORDS * 2) == 0);
+
+    // accessing the value may swap it in place (big endian), which must not affect the file
+    const Uint16 *values = NULL;
+    unsigned long count = 0;
+    OFCHECK(dfile->getDataset()->findAndGetUint16Array(DCM_RWavePointer, values, &count).good());
+    OFCHECK_EQUAL(count, OFstatic_cast(unsigned long, NUM_WORDS));
+    OFCHECK(values != NULL && memcmp(values, words, NUM_WORDS * 2) == 0);
+
+    // modify the value in place and by appending, both must leave the file unchanged
+    DcmElement *elem = NULL;
+    OFCHECK(dfile->getDataset()->findAndGetElement(DCM_RWavePointer, elem).good());
+    OFCHECK(elem->putUint16(0xffff, 0).good());
+    OFCHECK(elem->putUint16(0xffff, NUM_WORDS).good());
+    Uint16 value = 0;
+    OFCHECK(elem->getUint16(value, 0).good());
+    OFCHECK_EQUAL(value, 0xffff);
+    OFCHECK_EQUAL(elem->getVM(), OFstatic_cast(unsigned long, NUM_WORDS + 1));
+
+    // an element copy must not depend on the mapping
+    DcmElement *copy = OFstatic_cast(DcmElement *, elem->clone());
+    delete dfile;
+    OFCHECK(copy->getUint16(value, 1).good());
+    OFCHECK_EQUAL(value, words[1]);
+    delete copy;
+
+    DcmFileFormat reread;
+    OFCHECK(reread.loadFile(tmpFile).good());
+    values = NULL;
+    OFCHECK(reread.getDataset()->findAndGetUint16Array(DCM_RWavePointer, values, &count).good());
+    OFCHECK_EQUAL(count, OFstatic_cast(unsigned long, NUM_WORDS));
+    OFCHECK(values != NULL && memcmp(values, words, NUM_WORDS * 2) == 0);
+
+    OFStandard::deleteFile(tmpFile);
+    delete[] words;
+}
+
+OFTEST(dcmdata_memoryMappedInput)
+{
+    if (!DcmFileMapping::isSupported())
+        return;
+
+    checkMappedFile(EXS_LittleEndianExplicit, DCM_MaxReadLength);
+    checkMappedFile(EXS_BigEndianExplicit, DCM_MaxReadLength);
+    // values loaded on first access are read through a mapped stream as well
+    checkMappedFile(EXS_LittleEndianExplicit, 1024);
+}
+
+OFTEST(dcmdata_memoryMappedInput_fallback)
+{
+    // a file that cannot be mapped (here: does not exist) must report the usual error
+    dcmUseMemoryMappedFileInput.set(OFTrue);
+    DcmFileFormat dfile;
+    OFCHECK(dfile.loadFile("tmapfile_nonexisting.dcm").bad());
+    dcmUseMemoryMappedFileInput.set(OFFalse);
+}
@@ -0,0 +1,198 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: test program for gathered writes to output streams
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/oftempf.h"
+#include "dcmtk/ofstd/offile.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcostrmb.h"
+#include "dcmtk/dcmdata/dcostrmf.h"
+#include "dcmtk/dcmdata/dcwcache.h"
+
+#define LARGE_SIZE 200000
+
+
+/* reads the complete content of the given file */
+static OFBool readFile(const OFString &filename, OFVector<Uint8> &content)
+{
+    OFFile file;
+    if (!file.fopen(filename, "rb")) return OFFalse;
+    Uint8 buf[4096];
+    size_t len;
+    content.clear();
+    while ((len = file.fread(buf, 1, sizeof(buf))) > 0)
+        content.insert(content.end(), buf, buf + len);
+    file.fclose();
+    return OFTrue;
+}
+
+
+/* compares the content of two byte vectors */
+static OFBool sameContent(const OFVector<Uint8> &a, const OFVector<Uint8> &b)
+{
+    return (a.size() == b.size()) && (a.empty() || (memcmp(&a[0], &b[0], a.size()) == 0));
+}
+
+
+/* writes the dataset into an output buffer stream of the given size, which is
+ * emptied whenever the stream reports that it is full (as done for network
+ * transmission), and returns the complete encoding
+ */
+static OFCondition writeDataset(DcmDataset &dset, const E_TransferSyntax xfer, const offile_off_t bufSize, OFVector<Uint8> &content)
+{
+    Uint8 *buf = new Uint8[OFstatic_cast(size_t, bufSize)];
+    DcmOutputBufferStream outStream(buf, bufSize);
+    DcmWriteCache wcache;
+    OFCondition cond = EC_StreamNotifyClient;
+    void *data = NULL;
+    offile_off_t length = 0;
+    content.clear();
+    dset.transferInit();
+    while (cond == EC_StreamNotifyClient)
+    {
+        cond = dset.write(outStream, xfer, EET_ExplicitLength, &wcache);
+        if (cond == EC_Normal) outStream.flush();
+        outStream.flushBuffer(data, length);
+        content.insert(content.end(), OFstatic_cast(Uint8 *, data), OFstatic_cast(Uint8 *, data) + length);
+    }
+    dset.transferEnd();
+    delete[] buf;
+    return cond;
+}
+
+
+OFTEST(dcmdata_outputStream_writeBlocks)
+{
+    Uint8 *large = new Uint8[LARGE_SIZE];
+    for (Uint32 i = 0; i < LARGE_SIZE; ++i)
+        large[i] = OFstatic_cast(Uint8, i * 11 + 7);
+    const char *small1 = "0123456";
+    const char *small2 = "abcde";
+
+    DcmOutputBlock blocks[4];
+    blocks[0].data = small1;
+    blocks[0].length = 7;
+    blocks[1].data = large;
+    blocks[1].length = LARGE_SIZE;
+    blocks[2].data = NULL;
+    blocks[2].length = 0;
+    blocks[3].data = small2;
+    blocks[3].length = 5;
+
+    OFVector<Uint8> expected;
+    expected.insert(expected.end(), small2, small2 + 5);
+    expected.insert(expected.end(), small1, small1 + 7);
+    expected.insert(expected.end(), large, large + LARGE_SIZE);
+    expected.insert(expected.end(), small2, small2 + 5);
+    expected.insert(expected.end(), small2, small2 + 5);
+    expected.insert(expected.end(), small1, small1 + 7);
+    expected.insert(expected.end(), small2, small2 + 5);
+
+    /* file stream: the large gathered write bypasses the stdio buffer, the
+     * small one is buffered. The order of the data must be preserved.
+     */
+    OFString tmpFile;
+    OFCHECK(OFTempFile::createFile(tmpFile, NULL /* fd_out */, O_RDWR,
+        "" /* dir */, "tostrm_" /* prefix */, ".bin" /* postfix */).good());
+    {
+        DcmOutputFileStream outStream(tmpFile);
+        OFCHECK(outStream.good());
+        OFCHECK_EQUAL(outStream.write(small2, 5), 5);
+        OFCHECK_EQUAL(outStream.writeBlocks(blocks, 4), LARGE_SIZE + 12);
+        OFCHECK_EQUAL(outStream.writeBlocks(&blocks[2], 2), 5);
+        OFCHECK_EQUAL(outStream.writeBlocks(blocks, 1), 7);
+        OFCHECK_EQUAL(outStream.write(small2, 5), 5);
+        OFCHECK_EQUAL(outStream.tell(), OFstatic_cast(offile_off_t, expected.size()));
+        OFCHECK(outStream.fclose().good());
+    }
+    OFVector<Uint8> content;
+    OFCHECK(readFile(tmpFile, content));
+    OFCHECK(sameContent(content, expected));
+    OFStandard::deleteFile(tmpFile);
+
+    /* buffer stream: a gathered write stops when the buffer is full */
+    Uint8 buf[1000];
+    DcmOutputBufferStream bufStream(buf, sizeof(buf));
+    OFCHECK_EQUAL(bufStream.writeBlocks(blocks, 4), 1000);
+    OFCHECK(memcmp(buf, small1, 7) == 0);
+    OFCHECK(memcmp(buf + 7, large, 993) == 0);
+
+    delete[] large;
+}
+
+
+OFTEST(dcmdata_outputStream_writeDataset)
+{
+    /* a dataset with small elements and large values in memory */
+    DcmDataset dset;
+    OFCHECK(dset.putAndInsertString(DCM_PatientName, "Doe^John").good());
+    OFCHECK(dset.putAndInsertString(DCM_PatientID, "4711").good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Rows, 256).good());
+    Float32 *floats = new Float32[LARGE_SIZE / 4];
+    for (Uint32 i = 0; i < LARGE_SIZE / 4; ++i)
+        floats[i] = OFstatic_cast(Float32, i) * 0.5f;
+    OFCHECK(dset.putAndInsertFloat32Array(DCM_FloatPixelData, floats, LARGE_SIZE / 4).good());
+    Uint8 *bytes = new Uint8[LARGE_SIZE + 1];
+    for (Uint32 i = 0; i <= LARGE_SIZE; ++i)
+        bytes[i] = OFstatic_cast(Uint8, i * 7 + 5);
+    OFCHECK(dset.putAndInsertUint8Array(DCM_EncapsulatedDocument, bytes, LARGE_SIZE + 1).good());
+    OFCHECK(dset.putAndInsertString(DCM_StudyDescription, "Test").good());
+
+    const E_TransferSyntax xfers[3] = { EXS_LittleEndianExplicit, EXS_LittleEndianImplicit, EXS_BigEndianExplicit };
+    for (size_t x = 0; x < 3; ++x)
+    {
+        /* the encoding must not depend on I/O suspension (small buffer) */
+        OFVector<Uint8> reference;
+        OFVector<Uint8> suspended;
+        OFCHECK(writeDataset(dset, xfers[x], 4 * LARGE_SIZE, reference).good());
+        OFCHECK(writeDataset(dset, xfers[x], 4096, suspended).good());
+        OFCHECK(sameContent(reference, suspended));
+
+        /* a file written with gathered writes has the same content */
+        OFString tmpFile;
+        OFCHECK(OFTempFile::createFile(tmpFile, NULL /* fd_out */, O_RDWR,
+            "" /* dir */, "tostrm_" /* prefix */, ".dcm" /* postfix */).good());
+        OFCHECK(dset.saveFile(tmpFile, xfers[x], EET_ExplicitLength).good());
+        OFVector<Uint8> content;
+        OFCHECK(readFile(tmpFile, content));
+        OFCHECK(sameContent(content, reference));
+
+        /* and can be read again */
+        DcmDataset dset2;
+        OFCHECK(dset2.loadFile(tmpFile, xfers[x]).good());
+        const Float32 *values = NULL;
+        unsigned long count = 0;
+        OFCHECK(dset2.findAndGetFloat32Array(DCM_FloatPixelData, values, &count).good());
+        OFCHECK_EQUAL(count, OFstatic_cast(unsigned long, LARGE_SIZE / 4));
+        OFCHECK(values != NULL && memcmp(values, floats, LARGE_SIZE) == 0);
+        OFString value;
+        OFCHECK(dset2.findAndGetOFString(DCM_StudyDescription, value).good());
+        OFCHECK_EQUAL(value, "Test");
+        OFStandard::deleteFile(tmpFile);
+    }
+
+    delete[] floats;
+    delete[] bytes;
+}
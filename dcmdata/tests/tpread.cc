@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2021, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -406,3 +406,90 @@ OFTEST(dcmdata_partialElementAccess)
 #endif
     delete[] buffer;
 }
+
+#define FRAME_ROWS 32
+#define FRAME_COLUMNS 48
+#define FRAME_COUNT 10
+
+static void checkRandomFrameAccess(const char *filename, const Uint16 *pixels)
+{
+    DcmFileFormat dfile;
+    OFCondition cond = dfile.loadFile(filename);
+    if (cond.bad()) { OFCHECK_FAIL(cond.text()); return; }
+
+    DcmDataset *dset = dfile.getDataset();
+    DcmElement *delem = NULL;
+    OFCHECK(dset->findAndGetElement(DCM_PixelData, delem).good());
+    if (delem == NULL) return;
+    DcmPixelData *pixData = OFstatic_cast(DcmPixelData *, delem);
+
+    // the pixel data must not have been loaded into memory
+    OFCHECK(!pixData->valueLoaded());
+
+    const Uint32 frameSize = FRAME_ROWS * FRAME_COLUMNS * OFstatic_cast(Uint32, sizeof(Uint16));
+    Uint16 frame[FRAME_ROWS * FRAME_COLUMNS];
+    const Uint32 frameOrder[] = { 9, 2, 7, 0, 0, 5, 1, 8, 3, 6, 4, 9, 0 };
+    DcmFileCache cache;
+    OFString colorModel;
+    for (size_t i = 0; i < sizeof(frameOrder) / sizeof(frameOrder[0]); ++i)
+    {
+        // access frames with and without a file cache
+        Uint32 startFragment = 0;
+        cond = pixData->getUncompressedFrame(dset, frameOrder[i], startFragment, frame, frameSize,
+            colorModel, (i & 1) ? NULL : &cache);
+        OFCHECK(cond.good());
+        OFCHECK(memcmp(frame, pixels + frameOrder[i] * FRAME_ROWS * FRAME_COLUMNS, frameSize) == 0);
+    }
+
+    // accessing the frames must not have loaded the pixel data either
+    OFCHECK(!pixData->valueLoaded());
+}
+
+OFTEST(dcmdata_partialElementAccess_frames)
+{
+    /* make sure data dictionary is loaded */
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+      OFCHECK_FAIL("no data dictionary loaded, check environment variable: " DCM_DICT_ENVIRONMENT_VARIABLE);
+      return;
+    }
+
+    const unsigned long count = FRAME_ROWS * FRAME_COLUMNS * FRAME_COUNT;
+    Uint16 *pixels = new Uint16[count];
+    OFRandom rnd;
+    for (unsigned long i = 0; i < count; ++i)
+      pixels[i] = OFstatic_cast(Uint16, rnd.getRND32());
+
+    DcmFileFormat dfile;
+    DcmDataset *dset = dfile.getDataset();
+    dset->putAndInsertUint16(DCM_Rows, FRAME_ROWS);
+    dset->putAndInsertUint16(DCM_Columns, FRAME_COLUMNS);
+    dset->putAndInsertUint16(DCM_SamplesPerPixel, 1);
+    dset->putAndInsertUint16(DCM_BitsAllocated, 16);
+    dset->putAndInsertUint16(DCM_BitsStored, 16);
+    dset->putAndInsertUint16(DCM_HighBit, 15);
+    dset->putAndInsertUint16(DCM_PixelRepresentation, 0);
+    dset->putAndInsertOFStringArray(DCM_PhotometricInterpretation, "MONOCHROME2");
+    dset->putAndInsertOFStringArray(DCM_NumberOfFrames, "10");
+    dset->putAndInsertUint16Array(DCM_PixelData, pixels, count);
+
+    OFCondition cond = dfile.saveFile("test_frames_le.dcm", EXS_LittleEndianExplicit);
+    if (cond.bad()) { OFCHECK_FAIL(cond.text()); }
+    cond = dfile.saveFile("test_frames_be.dcm", EXS_BigEndianExplicit);
+    if (cond.bad()) { OFCHECK_FAIL(cond.text()); }
+
+    // random frame access, closing the file after each access
+    checkRandomFrameAccess("test_frames_le.dcm", pixels);
+    checkRandomFrameAccess("test_frames_be.dcm", pixels);
+
+    // random frame access, keeping file handles open for reuse
+    const Uint32 poolSize = dcmFileHandlePoolSize.get();
+    dcmFileHandlePoolSize.set(2);
+    checkRandomFrameAccess("test_frames_le.dcm", pixels);
+    checkRandomFrameAccess("test_frames_be.dcm", pixels);
+    dcmFileHandlePoolSize.set(poolSize);
+
+    unlink("test_frames_le.dcm");
+    unlink("test_frames_be.dcm");
+    delete[] pixels;
+}
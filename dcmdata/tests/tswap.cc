@@ -0,0 +1,140 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmdata
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: test program for the (vectorized) byte swapping functions
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmdata/dcswap.h"
+
+#define BUFSIZE 1031  /* not a multiple of any value width */
+
+
+/* swaps the given buffer bytewise, bytes of a trailing partial value remain unchanged */
+static void referenceSwap(const Uint8 *source, Uint8 *target, const Uint32 byteLength, const size_t valWidth)
+{
+    memcpy(target, source, byteLength);
+    for (Uint32 i = 0; i + valWidth <= byteLength; i += OFstatic_cast(Uint32, valWidth))
+    {
+        for (size_t j = 0; j < valWidth; ++j)
+            target[i + j] = source[i + valWidth - 1 - j];
+    }
+}
+
+
+OFTEST(dcmdata_swapBytes)
+{
+    Uint8 *source = new Uint8[BUFSIZE + 1];
+    Uint8 *expected = new Uint8[BUFSIZE];
+    Uint8 *target = new Uint8[BUFSIZE + 1];
+    for (Uint32 i = 0; i <= BUFSIZE; ++i)
+        source[i] = OFstatic_cast(Uint8, i * 7 + 3);
+
+    const size_t widths[] = { 2, 3, 4, 8, 16 };
+    for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); ++w)
+    {
+        const size_t valWidth = widths[w];
+        /* check all lengths up to a few vector blocks, then the complete buffer */
+        for (Uint32 length = 0; length <= BUFSIZE; length = (length < 80) ? length + 1 : BUFSIZE)
+        {
+            /* use an unaligned source buffer for odd lengths */
+            const Uint8 *src = source + (length & 1);
+            referenceSwap(src, expected, length, valWidth);
+
+            memset(target, 0, BUFSIZE + 1);
+            swapBytes(src, target, length, valWidth);
+            OFCHECK(memcmp(target, expected, length) == 0);
+            OFCHECK_EQUAL(target[length], 0);
+
+            memcpy(target, src, length);
+            swapBytes(target, length, valWidth);
+            OFCHECK(memcmp(target, expected, length) == 0);
+
+            memcpy(target, src, length);
+            OFCHECK(swapIfNecessary(EBO_BigEndian, EBO_LittleEndian, target, target, length, valWidth).good());
+            OFCHECK(memcmp(target, expected, length) == 0);
+            if (length == BUFSIZE) break;
+        }
+    }
+
+    /* no swapping needed: the data is just copied */
+    memset(target, 0, BUFSIZE);
+    OFCHECK(swapIfNecessary(EBO_LittleEndian, EBO_LittleEndian, source, target, BUFSIZE, 4).good());
+    OFCHECK(memcmp(target, source, BUFSIZE) == 0);
+    memset(target, 0, BUFSIZE);
+    OFCHECK(swapIfNecessary(EBO_BigEndian, EBO_LittleEndian, source, target, BUFSIZE, 1).good());
+    OFCHECK(memcmp(target, source, BUFSIZE) == 0);
+    OFCHECK(swapIfNecessary(EBO_unknown, EBO_LittleEndian, source, target, BUFSIZE, 2).bad());
+
+    delete[] source;
+    delete[] expected;
+    delete[] target;
+}
+
+
+OFTEST(dcmdata_getPartialValue_swapped)
+{
+    Uint8 *buffer = new Uint8[BUFSIZE];
+    Uint8 *expected = new Uint8[BUFSIZE];
+    Uint8 *target = new Uint8[BUFSIZE];
+    for (Uint32 i = 0; i < BUFSIZE; ++i)
+        buffer[i] = OFstatic_cast(Uint8, i * 13 + 5);
+
+    /* the values are stored in local byte order (in memory) */
+    const Uint32 length = BUFSIZE - BUFSIZE % 8;
+    DcmElement *elements[3];
+    elements[0] = new DcmOtherByteOtherWord(DcmTag(DCM_RedPaletteColorLookupTableData, EVR_OW));
+    OFCHECK(elements[0]->putUint16Array(OFreinterpret_cast(Uint16 *, buffer), length / 2).good());
+    elements[1] = new DcmUnsignedLong(DCM_TableOfPixelValues);
+    OFCHECK(elements[1]->putUint32Array(OFreinterpret_cast(Uint32 *, buffer), length / 4).good());
+    elements[2] = new DcmFloatingPointDouble(DCM_TableOfYBreakPoints);
+    OFCHECK(elements[2]->putFloat64Array(OFreinterpret_cast(Float64 *, buffer), length / 8).good());
+    const E_ByteOrder otherByteOrder = (gLocalByteOrder == EBO_LittleEndian) ? EBO_BigEndian : EBO_LittleEndian;
+    for (size_t e = 0; e < 3; ++e)
+    {
+        DcmElement *elem = elements[e];
+        const size_t valWidth = elem->getTag().getVR().getValueWidth();
+        referenceSwap(buffer, expected, length, valWidth);
+
+        /* read the value in pieces of all sizes and alignments in the other byte order */
+        for (Uint32 size = 1; size <= 19; ++size)
+        {
+            for (Uint32 offset = 0; offset < length; offset += size)
+            {
+                const Uint32 numBytes = (offset + size > length) ? length - offset : size;
+                OFCHECK(elem->getPartialValue(target, offset, numBytes, NULL, otherByteOrder).good());
+                OFCHECK(memcmp(target, expected + offset, numBytes) == 0);
+            }
+        }
+        OFCHECK(elem->getPartialValue(target, 0, length, NULL, otherByteOrder).good());
+        OFCHECK(memcmp(target, expected, length) == 0);
+
+        /* reading in local byte order still works without any swapping */
+        OFCHECK(elem->getPartialValue(target, 3, length - 3, NULL, gLocalByteOrder).good());
+        OFCHECK(memcmp(target, buffer + 3, length - 3) == 0);
+        delete elem;
+    }
+
+    delete[] buffer;
+    delete[] expected;
+    delete[] target;
+}
@@ -140,7 +140,7 @@ int main(int argc, char *argv[])
       cmd.addOption("--recognize-aspect",    "+a",      "recognize pixel aspect ratio when scaling (def)");
       cmd.addOption("--ignore-aspect",       "-a",      "ignore pixel aspect ratio when scaling");
       cmd.addOption("--interpolate",         "+i",   1, "[n]umber of algorithm: integer",
-                                                        "use interpolation when scaling (1..4, def: 1)");
+                                                        "use interpolation when scaling (1..6, def: 1)");
       cmd.addOption("--no-interpolation",    "-i",      "no interpolation when scaling");
       cmd.addOption("--no-scaling",          "-S",      "no scaling, ignore pixel aspect ratio (default)");
       cmd.addOption("--scale-x-factor",      "+Sxf", 1, "[f]actor: float",
@@ -276,7 +276,7 @@ int main(int argc, char *argv[])
 
       cmd.beginOptionBlock();
       if (cmd.findOption("--interpolate"))
-          app.checkValue(cmd.getValueAndCheckMinMax(opt_useInterpolation, 1, 4));
+          app.checkValue(cmd.getValueAndCheckMinMax(opt_useInterpolation, 1, 6));
       if (cmd.findOption("--no-interpolation"))
           opt_useInterpolation = 0;
       cmd.endOptionBlock();
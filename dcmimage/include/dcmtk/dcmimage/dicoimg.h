@@ -153,7 +153,8 @@ class DCMTK_DCMIMAGE_EXPORT DiColorImage
      *  @param  interpolate   specifies whether scaling algorithm should use interpolation (if necessary).
      *                        default: no interpolation (0), preferred interpolation algorithm (if applicable):
      *                          1 = pbmplus algorithm, 2 = c't algorithm, 3 = bilinear magnification,
-     *                          4 = bicubic magnification
+     *                          4 = bicubic magnification, 5 = box filter resampling (area averaging),
+     *                          6 = Lanczos filter resampling
      *  @param  aspect        specifies whether pixel aspect ratio should be taken into consideration
      *                        (if true, width OR height should be 0, i.e. this component will be calculated
      *                         automatically)
@@ -361,7 +362,8 @@ class DCMTK_DCMIMAGE_EXPORT DiColorImage
      *  @param  interpolate  specifies whether scaling algorithm should use interpolation (if necessary).
      *                       default: no interpolation (0), preferred interpolation algorithm (if applicable):
      *                         1 = pbmplus algorithm, 2 = c't algorithm, 3 = bilinear magnification,
-     *                         4 = bicubic magnification
+     *                         4 = bicubic magnification, 5 = box filter resampling (area averaging),
+     *                         6 = Lanczos filter resampling
      *  @param  aspect       specifies whether pixel aspect ratio should be taken into consideration
      *                       (if true, width OR height should be 0, i.e. this component will be calculated
      *                        automatically)
@@ -27,6 +27,7 @@
 
 #include "dcmtk/dcmimage/dicoopx.h"
 #include "dcmtk/dcmimage/dicopx.h"
+#include "dcmtk/dcmimage/dicosimd.h"
 #include "dcmtk/dcmimgle/dipxrept.h"
 
 #include "dcmtk/ofstd/ofbmanip.h"
@@ -341,7 +342,11 @@ class DiColorOutputPixelTemplate
                             for (i = start; i < start + Count; ++i)
                                 for (j = 0; j < 3; ++j)                         // copy inverted data
                                     *(q++) = max2 - OFstatic_cast(T2, pixel[j][i]);
-                        } else {
+                        }
+                        else if (DiColorSIMD::interleave(pixel[0] + start, pixel[1] + start, pixel[2] + start, q, Count))
+                            q += 3 * Count;                                     // copy (vectorized)
+                        else
+                        {
                             for (i = start; i < start + Count; ++i)
                                 for (j = 0; j < 3; ++j)                         // copy
                                     *(q++) = OFstatic_cast(T2, pixel[j][i]);
@@ -0,0 +1,179 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimage
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: DicomColorSIMD (Header)
+ *
+ */
+
+
+#ifndef DICOSIMD_H
+#define DICOSIMD_H
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/ofstd/oftypes.h"
+#include "dcmtk/dcmimage/dicdefin.h"
+
+
+/*---------------------*
+ *  class declaration  *
+ *---------------------*/
+
+/** Class providing vectorized (SIMD) implementations of the inner loops used
+ *  for converting color images, i.e.\ the conversion from YCbCr to RGB and the
+ *  conversion between color-by-pixel and color-by-plane organization.
+ *  The instruction set is the one selected for the monochrome rendering (see
+ *  DiSIMD::setInstructionSet()). All methods produce exactly the same output
+ *  as the corresponding scalar code. They return false for data types and
+ *  processors that are not supported, in which case the caller has to use
+ *  its scalar implementation.
+ */
+class DCMTK_DCMIMAGE_EXPORT DiColorSIMD
+{
+
+ public:
+
+    /** convert YCbCr pixel data (color-by-plane) with 8 bits per sample to RGB.
+     *  The result is identical to the table-based conversion implemented in
+     *  DiYBRPixelTemplate. Generic version for unsupported data types, always
+     *  returns false.
+     *
+     ** @param  y      pointer to the Y plane of the input pixel data
+     *  @param  cb     pointer to the Cb plane of the input pixel data
+     *  @param  cr     pointer to the Cr plane of the input pixel data
+     *  @param  red    pointer to the red plane of the output pixel data
+     *  @param  green  pointer to the green plane of the output pixel data
+     *  @param  blue   pointer to the blue plane of the output pixel data
+     *  @param  count  number of pixels to be converted
+     *
+     ** @return true if the pixel data has been processed, false otherwise
+     */
+    template<class T1, class T2>
+    static inline int convertYBRFull(const T1 * /* y */,
+                                     const T1 * /* cb */,
+                                     const T1 * /* cr */,
+                                     T2 * /* red */,
+                                     T2 * /* green */,
+                                     T2 * /* blue */,
+                                     const unsigned long /* count */)
+    {
+        return 0;
+    }
+
+    /** convert YCbCr pixel data (color-by-pixel) with 8 bits per sample to RGB.
+     *  The result is identical to the table-based conversion implemented in
+     *  DiYBRPixelTemplate. Generic version for unsupported data types, always
+     *  returns false.
+     *
+     ** @param  pixel  pointer to the input pixel data (Y, Cb, Cr, Y, ...)
+     *  @param  red    pointer to the red plane of the output pixel data
+     *  @param  green  pointer to the green plane of the output pixel data
+     *  @param  blue   pointer to the blue plane of the output pixel data
+     *  @param  count  number of pixels to be converted
+     *
+     ** @return true if the pixel data has been processed, false otherwise
+     */
+    template<class T1, class T2>
+    static inline int convertYBRFull(const T1 * /* pixel */,
+                                     T2 * /* red */,
+                                     T2 * /* green */,
+                                     T2 * /* blue */,
+                                     const unsigned long /* count */)
+    {
+        return 0;
+    }
+
+    /** convert YCbCr 4:2:2 pixel data (Y1, Y2, Cb, Cr, ...) to RGB.
+     *  The result is identical to the conversion implemented in
+     *  DiYBR422PixelTemplate. Generic version for unsupported data types,
+     *  always returns false.
+     *
+     ** @param  pixel     pointer to the input pixel data
+     *  @param  red       pointer to the red plane of the output pixel data
+     *  @param  green     pointer to the green plane of the output pixel data
+     *  @param  blue      pointer to the blue plane of the output pixel data
+     *  @param  pairs     number of pixel pairs to be converted
+     *  @param  maxvalue  maximum value of the RGB samples
+     *
+     ** @return true if the pixel data has been processed, false otherwise
+     */
+    template<class T1, class T2>
+    static inline int convertYBR422(const T1 * /* pixel */,
+                                    T2 * /* red */,
+                                    T2 * /* green */,
+                                    T2 * /* blue */,
+                                    const unsigned long /* pairs */,
+                                    const T2 /* maxvalue */)
+    {
+        return 0;
+    }
+
+    /** convert color-by-pixel to color-by-plane pixel data, i.e.\ split
+     *  the triples of the input pixel data into three planes.
+     *  Generic version for unsupported data types, always returns false.
+     *
+     ** @param  src     pointer to the input pixel data
+     *  @param  plane0  pointer to the first output plane
+     *  @param  plane1  pointer to the second output plane
+     *  @param  plane2  pointer to the third output plane
+     *  @param  count   number of pixels to be converted
+     *
+     ** @return true if the pixel data has been processed, false otherwise
+     */
+    template<class T1, class T2>
+    static inline int deinterleave(const T1 * /* src */,
+                                   T2 * /* plane0 */,
+                                   T2 * /* plane1 */,
+                                   T2 * /* plane2 */,
+                                   const unsigned long /* count */)
+    {
+        return 0;
+    }
+
+    /** convert color-by-plane to color-by-pixel pixel data, i.e.\ merge
+     *  the three input planes into triples.
+     *  Generic version for unsupported data types, always returns false.
+     *
+     ** @param  plane0  pointer to the first input plane
+     *  @param  plane1  pointer to the second input plane
+     *  @param  plane2  pointer to the third input plane
+     *  @param  dst     pointer to the output pixel data
+     *  @param  count   number of pixels to be converted
+     *
+     ** @return true if the pixel data has been processed, false otherwise
+     */
+    template<class T1, class T2>
+    static inline int interleave(const T1 * /* plane0 */,
+                                 const T1 * /* plane1 */,
+                                 const T1 * /* plane2 */,
+                                 T2 * /* dst */,
+                                 const unsigned long /* count */)
+    {
+        return 0;
+    }
+
+    // --- supported data types
+
+    static int convertYBRFull(const Uint8 *y, const Uint8 *cb, const Uint8 *cr, Uint8 *red, Uint8 *green, Uint8 *blue, const unsigned long count);
+    static int convertYBRFull(const Uint8 *pixel, Uint8 *red, Uint8 *green, Uint8 *blue, const unsigned long count);
+    static int convertYBR422(const Uint8 *pixel, Uint8 *red, Uint8 *green, Uint8 *blue, const unsigned long pairs, const Uint8 maxvalue);
+    static int deinterleave(const Uint8 *src, Uint8 *plane0, Uint8 *plane1, Uint8 *plane2, const unsigned long count);
+    static int interleave(const Uint8 *plane0, const Uint8 *plane1, const Uint8 *plane2, Uint8 *dst, const unsigned long count);
+};
+
+
+#endif
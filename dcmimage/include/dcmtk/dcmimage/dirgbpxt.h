@@ -26,6 +26,7 @@
 #include "dcmtk/config/osconfig.h"
 
 #include "dcmtk/dcmimage/dicopxt.h"
+#include "dcmtk/dcmimage/dicosimd.h"
 #include "dcmtk/dcmimgle/diinpx.h"  /* gcc 3.4 needs this */
 
 
@@ -118,7 +119,7 @@ class DiRGBPixelTemplate
                     }
                 }
             }
-            else
+            else if (!DiColorSIMD::deinterleave(p, this->Data[0], this->Data[1], this->Data[2], count))
             {
                 int j;
                 unsigned long i;
@@ -27,6 +27,7 @@
 #include "dcmtk/ofstd/ofbmanip.h"
 
 #include "dcmtk/dcmimage/dicopxt.h"
+#include "dcmtk/dcmimage/dicosimd.h"
 #include "dcmtk/dcmimgle/diinpx.h"  /* gcc 3.4 needs this */
 
 
@@ -143,19 +144,31 @@ class DiYBRPixelTemplate
                             unsigned long i = count;
                             while (i != 0)
                             {
-                                /* convert a single frame */
-                                for (l = planeSize; (l != 0) && (i != 0); --l, --i, ++y, ++cb, ++cr)
+                                /* convert a single frame (vectorized if possible) */
+                                const unsigned long frameCount = (i < planeSize) ? i : planeSize;
+                                if (DiColorSIMD::convertYBRFull(y, cb, cr, r, g, b, frameCount))
                                 {
-                                    const Sint32 yValue = *y;
-                                    /* conversion to unsigned integer needed for gcc 14 on Solaris */
-                                    const unsigned int cbValue = *cb;
-                                    const unsigned int crValue = *cr;
-                                    sr = yValue + rcr_tab[crValue];
-                                    sg = yValue - gcb_tab[cbValue] - gcr_tab[crValue];
-                                    sb = yValue + bcb_tab[cbValue];
-                                    *(r++) = (sr < 0) ? 0 : (sr > OFstatic_cast(Sint32, maxvalue)) ? maxvalue : OFstatic_cast(T2, sr);
-                                    *(g++) = (sg < 0) ? 0 : (sg > OFstatic_cast(Sint32, maxvalue)) ? maxvalue : OFstatic_cast(T2, sg);
-                                    *(b++) = (sb < 0) ? 0 : (sb > OFstatic_cast(Sint32, maxvalue)) ? maxvalue : OFstatic_cast(T2, sb);
+                                    y += frameCount;
+                                    cb += frameCount;
+                                    cr += frameCount;
+                                    r += frameCount;
+                                    g += frameCount;
+                                    b += frameCount;
+                                    i -= frameCount;
+                                } else {
+                                    for (l = planeSize; (l != 0) && (i != 0); --l, --i, ++y, ++cb, ++cr)
+                                    {
+                                        const Sint32 yValue = *y;
+                                        /* conversion to unsigned integer needed for gcc 14 on Solaris */
+                                        const unsigned int cbValue = *cb;
+                                        const unsigned int crValue = *cr;
+                                        sr = yValue + rcr_tab[crValue];
+                                        sg = yValue - gcb_tab[cbValue] - gcr_tab[crValue];
+                                        sb = yValue + bcb_tab[cbValue];
+                                        *(r++) = (sr < 0) ? 0 : (sr > OFstatic_cast(Sint32, maxvalue)) ? maxvalue : OFstatic_cast(T2, sr);
+                                        *(g++) = (sg < 0) ? 0 : (sg > OFstatic_cast(Sint32, maxvalue)) ? maxvalue : OFstatic_cast(T2, sg);
+                                        *(b++) = (sb < 0) ? 0 : (sb > OFstatic_cast(Sint32, maxvalue)) ? maxvalue : OFstatic_cast(T2, sb);
+                                    }
                                 }
                                 /* jump to next frame start (skip 2 planes) */
                                 y += 2 * planeSize;
@@ -163,7 +176,7 @@ class DiYBRPixelTemplate
                                 cr += 2 * planeSize;
                             }
                         }
-                        else
+                        else if (!DiColorSIMD::convertYBRFull(pixel, r, g, b, count))
                         {
                             const T1 *p = pixel;
                             unsigned long i;
@@ -260,7 +273,7 @@ class DiYBRPixelTemplate
                             }
                         }
                     }
-                    else
+                    else if (!DiColorSIMD::deinterleave(p, this->Data[0], this->Data[1], this->Data[2], count))
                     {
                         int j;
                         unsigned long i;
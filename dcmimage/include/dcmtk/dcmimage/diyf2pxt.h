@@ -26,6 +26,7 @@
 #include "dcmtk/config/osconfig.h"
 
 #include "dcmtk/dcmimage/dicopxt.h"
+#include "dcmtk/dcmimage/dicosimd.h"
 #include "dcmtk/dcmimgle/diinpx.h"  /* gcc 3.4 needs this */
 
 
@@ -106,14 +107,18 @@ class DiYBR422PixelTemplate
             if (rgb)    /* convert to RGB model */
             {
                 const T2 maxvalue = OFstatic_cast(T2, DicomImageClass::maxval(bits));
-                for (i = count / 2; i != 0; --i)
+                /* use vectorized code if possible */
+                if (!DiColorSIMD::convertYBR422(p, r, g, b, count / 2, maxvalue))
                 {
-                    y1 = removeSign(*(p++), offset);
-                    y2 = removeSign(*(p++), offset);
-                    cb = removeSign(*(p++), offset);
-                    cr = removeSign(*(p++), offset);
-                    convertValue(*(r++), *(g++), *(b++), y1, cb, cr, maxvalue);
-                    convertValue(*(r++), *(g++), *(b++), y2, cb, cr, maxvalue);
+                    for (i = count / 2; i != 0; --i)
+                    {
+                        y1 = removeSign(*(p++), offset);
+                        y2 = removeSign(*(p++), offset);
+                        cb = removeSign(*(p++), offset);
+                        cr = removeSign(*(p++), offset);
+                        convertValue(*(r++), *(g++), *(b++), y1, cb, cr, maxvalue);
+                        convertValue(*(r++), *(g++), *(b++), y2, cb, cr, maxvalue);
+                    }
                 }
             } else {    /* retain YCbCr model: YCbCr_422_full -> YCbCr_full */
                 for (i = count / 2; i != 0; --i)
@@ -0,0 +1,561 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimage
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: DicomColorSIMD (Source)
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/ofstd/ofcast.h"
+#include "dcmtk/dcmimgle/disimd.h"
+#include "dcmtk/dcmimage/dicosimd.h"
+
+/*
+ *  The vectorized code is compiled with function specific target attributes,
+ *  see dcmimgle/libsrc/disimd.cc. The instruction set is selected there.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))))
+#define DICOSIMD_X86
+#define DICOSIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define DICOSIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (_MSC_VER >= 1800) && (defined(_M_X64) || defined(_M_IX86))
+#define DICOSIMD_X86
+#define DICOSIMD_TARGET_SSE2
+#define DICOSIMD_TARGET_AVX2
+#include <immintrin.h>
+#endif
+
+
+/*---------------*
+ *  YCbCr tables  *
+ *---------------*/
+
+/* lookup tables for the conversion of 8 bit YCbCr to RGB, same as in DiYBRPixelTemplate
+ * (32-bit entries, as required by the gather instruction)
+ */
+struct DiColorYBRTables
+{
+    DiColorYBRTables()
+    {
+        const double r_const = 0.7010 * 255.0;
+        const double g_const = 0.5291 * 255.0;
+        const double b_const = 0.8859 * 255.0;
+        for (int l = 0; l < 256; ++l)
+        {
+            RCr[l] = OFstatic_cast(Sint16, 1.4020 * OFstatic_cast(double, l) - r_const);
+            GCb[l] = OFstatic_cast(Sint16, 0.3441 * OFstatic_cast(double, l));
+            GCr[l] = OFstatic_cast(Sint16, 0.7141 * OFstatic_cast(double, l) - g_const);
+            BCb[l] = OFstatic_cast(Sint16, 1.7720 * OFstatic_cast(double, l) - b_const);
+        }
+    }
+
+    Sint32 RCr[256];
+    Sint32 GCb[256];
+    Sint32 GCr[256];
+    Sint32 BCb[256];
+};
+
+static const DiColorYBRTables YBRTables;
+
+
+/*------------------*
+ *  scalar versions  *
+ *------------------*/
+
+/* used for the remaining pixels that do not fill a complete vector */
+
+static inline Uint8 clipYBR(const Sint32 value)
+{
+    return (value < 0) ? 0 : (value > 255) ? 255 : OFstatic_cast(Uint8, value);
+}
+
+
+static void convertYBRFullScalar(const Uint8 *y,
+                                 const Uint8 *cb,
+                                 const Uint8 *cr,
+                                 Uint8 *red,
+                                 Uint8 *green,
+                                 Uint8 *blue,
+                                 const unsigned long count)
+{
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        const Sint32 yValue = y[i];
+        red[i] = clipYBR(yValue + YBRTables.RCr[cr[i]]);
+        green[i] = clipYBR(yValue - YBRTables.GCb[cb[i]] - YBRTables.GCr[cr[i]]);
+        blue[i] = clipYBR(yValue + YBRTables.BCb[cb[i]]);
+    }
+}
+
+
+static inline Uint8 clipYBR422(const double value,
+                               const Uint8 maxvalue)
+{
+    return (value < 0.0) ? 0 : (value > OFstatic_cast(double, maxvalue)) ? maxvalue : OFstatic_cast(Uint8, value);
+}
+
+
+static void convertYBR422Scalar(const Uint8 *pixel,
+                                Uint8 *red,
+                                Uint8 *green,
+                                Uint8 *blue,
+                                const unsigned long pairs,
+                                const Uint8 maxvalue)
+{
+    /* same computation as DiYBR422PixelTemplate::convertValue() */
+    const double max = OFstatic_cast(double, maxvalue);
+    for (unsigned long i = 0; i < 2 * pairs; i += 2, pixel += 4)
+    {
+        const double cb = OFstatic_cast(double, pixel[2]);
+        const double cr = OFstatic_cast(double, pixel[3]);
+        for (int j = 0; j < 2; ++j)
+        {
+            const double y = OFstatic_cast(double, pixel[j]);
+            red[i + j] = clipYBR422(y + 1.4020 * cr - 0.7010 * max, maxvalue);
+            green[i + j] = clipYBR422(y - 0.3441 * cb - 0.7141 * cr + 0.5291 * max, maxvalue);
+            blue[i + j] = clipYBR422(y + 1.7720 * cb - 0.8859 * max, maxvalue);
+        }
+    }
+}
+
+
+static void deinterleaveScalar(const Uint8 *src,
+                               Uint8 *plane0,
+                               Uint8 *plane1,
+                               Uint8 *plane2,
+                               const unsigned long count)
+{
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        plane0[i] = *(src++);
+        plane1[i] = *(src++);
+        plane2[i] = *(src++);
+    }
+}
+
+
+static void interleaveScalar(const Uint8 *plane0,
+                             const Uint8 *plane1,
+                             const Uint8 *plane2,
+                             Uint8 *dst,
+                             const unsigned long count)
+{
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        *(dst++) = plane0[i];
+        *(dst++) = plane1[i];
+        *(dst++) = plane2[i];
+    }
+}
+
+
+#ifdef DICOSIMD_X86
+
+/* shuffle masks for moving the samples of 16 pixels (three 128-bit vectors) between
+ * color-by-pixel and color-by-plane organization (0x80 = set byte to zero)
+ */
+struct DiColorShuffleMasks
+{
+    DiColorShuffleMasks()
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                for (int k = 0; k < 16; ++k)
+                {
+                    /* sample 'k' of plane 'i' taken from input vector 'j' */
+                    const int pos = 3 * k + i;
+                    Deinterleave[i][j][k] = OFstatic_cast(Uint8, (pos / 16 == j) ? pos % 16 : 0x80);
+                    /* byte 'k' of output vector 'i' taken from plane 'j' */
+                    const int index = 16 * i + k;
+                    Interleave[i][j][k] = OFstatic_cast(Uint8, (index % 3 == j) ? index / 3 : 0x80);
+                }
+            }
+        }
+    }
+
+    Uint8 Deinterleave[3][3][16];
+    Uint8 Interleave[3][3][16];
+};
+
+static const DiColorShuffleMasks ShuffleMasks;
+
+
+/*----------------*
+ *  SSE2 versions  *
+ *----------------*/
+
+/* clip two values to the range [0, max] and truncate them to 32-bit integers */
+
+DICOSIMD_TARGET_SSE2 static inline __m128i clipSSE2(const __m128d value,
+                                                    const __m128d max)
+{
+    return _mm_cvttpd_epi32(_mm_min_pd(_mm_max_pd(value, _mm_setzero_pd()), max));
+}
+
+DICOSIMD_TARGET_SSE2 static void convertYBR422SSE2(const Uint8 *pixel,
+                                                   Uint8 *red,
+                                                   Uint8 *green,
+                                                   Uint8 *blue,
+                                                   const unsigned long pairs,
+                                                   const Uint8 maxvalue)
+{
+    const double maxval = OFstatic_cast(double, maxvalue);
+    const __m128d max = _mm_set1_pd(maxval);
+    const __m128d rcr = _mm_set1_pd(1.4020);
+    const __m128d gcb = _mm_set1_pd(0.3441);
+    const __m128d gcr = _mm_set1_pd(0.7141);
+    const __m128d bcb = _mm_set1_pd(1.7720);
+    const __m128d r_const = _mm_set1_pd(0.7010 * maxval);
+    const __m128d g_const = _mm_set1_pd(0.5291 * maxval);
+    const __m128d b_const = _mm_set1_pd(0.8859 * maxval);
+    const __m128i mask = _mm_set1_epi32(0xff);
+    unsigned long i = 0;
+    for (; i + 4 <= pairs; i += 4)
+    {
+        /* each 32-bit value contains Y1, Y2, Cb and Cr of a pixel pair */
+        const __m128i v = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, pixel + 4 * i));
+        const __m128i vy[2] = { _mm_and_si128(v, mask), _mm_and_si128(_mm_srli_epi32(v, 8), mask) };
+        const __m128i vcb = _mm_and_si128(_mm_srli_epi32(v, 16), mask);
+        const __m128i vcr = _mm_srli_epi32(v, 24);
+        __m128i r[2], g[2], b[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            /* two halves of two pixel pairs each */
+            const int shuffle = (k == 0) ? _MM_SHUFFLE(1, 0, 1, 0) : _MM_SHUFFLE(3, 2, 3, 2);
+            const __m128d cb = _mm_cvtepi32_pd(_mm_shuffle_epi32(vcb, shuffle));
+            const __m128d cr = _mm_cvtepi32_pd(_mm_shuffle_epi32(vcr, shuffle));
+            const __m128d rc = _mm_mul_pd(rcr, cr);
+            const __m128d gb = _mm_mul_pd(gcb, cb);
+            const __m128d gr = _mm_mul_pd(gcr, cr);
+            const __m128d bb = _mm_mul_pd(bcb, cb);
+            __m128i rv[2], gv[2], bv[2];
+            for (int j = 0; j < 2; ++j)
+            {
+                const __m128d y = _mm_cvtepi32_pd(_mm_shuffle_epi32(vy[j], shuffle));
+                rv[j] = clipSSE2(_mm_sub_pd(_mm_add_pd(y, rc), r_const), max);
+                gv[j] = clipSSE2(_mm_add_pd(_mm_sub_pd(_mm_sub_pd(y, gb), gr), g_const), max);
+                bv[j] = clipSSE2(_mm_sub_pd(_mm_add_pd(y, bb), b_const), max);
+            }
+            /* Y1 and Y2 are adjacent in the output */
+            r[k] = _mm_unpacklo_epi32(rv[0], rv[1]);
+            g[k] = _mm_unpacklo_epi32(gv[0], gv[1]);
+            b[k] = _mm_unpacklo_epi32(bv[0], bv[1]);
+        }
+        const __m128i rp = _mm_packs_epi32(r[0], r[1]);
+        const __m128i gp = _mm_packs_epi32(g[0], g[1]);
+        const __m128i bp = _mm_packs_epi32(b[0], b[1]);
+        _mm_storel_epi64(OFreinterpret_cast(__m128i *, red + 2 * i), _mm_packus_epi16(rp, rp));
+        _mm_storel_epi64(OFreinterpret_cast(__m128i *, green + 2 * i), _mm_packus_epi16(gp, gp));
+        _mm_storel_epi64(OFreinterpret_cast(__m128i *, blue + 2 * i), _mm_packus_epi16(bp, bp));
+    }
+    convertYBR422Scalar(pixel + 4 * i, red + 2 * i, green + 2 * i, blue + 2 * i, pairs - i, maxvalue);
+}
+
+
+/*----------------*
+ *  AVX2 versions  *
+ *----------------*/
+
+/* store two vectors of 32-bit integers as 16 unsigned bytes (with saturation) */
+
+DICOSIMD_TARGET_AVX2 static inline void storeAVX2(Uint8 *dst,
+                                                  const __m256i value[2])
+{
+    /* packing works within each 128-bit lane, so the order has to be restored */
+    const __m256i v = _mm256_permute4x64_epi64(_mm256_packs_epi32(value[0], value[1]), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst), _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+
+DICOSIMD_TARGET_AVX2 static void convertYBRFullAVX2(const Uint8 *y,
+                                                    const Uint8 *cb,
+                                                    const Uint8 *cr,
+                                                    Uint8 *red,
+                                                    Uint8 *green,
+                                                    Uint8 *blue,
+                                                    const unsigned long count)
+{
+    unsigned long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i r[2], g[2], b[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            const __m256i yValue = _mm256_cvtepu8_epi32(_mm_loadl_epi64(OFreinterpret_cast(const __m128i *, y + i + 8 * j)));
+            const __m256i cbValue = _mm256_cvtepu8_epi32(_mm_loadl_epi64(OFreinterpret_cast(const __m128i *, cb + i + 8 * j)));
+            const __m256i crValue = _mm256_cvtepu8_epi32(_mm_loadl_epi64(OFreinterpret_cast(const __m128i *, cr + i + 8 * j)));
+            r[j] = _mm256_add_epi32(yValue, _mm256_i32gather_epi32(OFreinterpret_cast(const int *, YBRTables.RCr), crValue, 4));
+            g[j] = _mm256_sub_epi32(_mm256_sub_epi32(yValue, _mm256_i32gather_epi32(OFreinterpret_cast(const int *, YBRTables.GCb), cbValue, 4)),
+                                    _mm256_i32gather_epi32(OFreinterpret_cast(const int *, YBRTables.GCr), crValue, 4));
+            b[j] = _mm256_add_epi32(yValue, _mm256_i32gather_epi32(OFreinterpret_cast(const int *, YBRTables.BCb), cbValue, 4));
+        }
+        storeAVX2(red + i, r);
+        storeAVX2(green + i, g);
+        storeAVX2(blue + i, b);
+    }
+    convertYBRFullScalar(y + i, cb + i, cr + i, red + i, green + i, blue + i, count - i);
+}
+
+/* clip four values to the range [0, max] and truncate them to 32-bit integers */
+
+DICOSIMD_TARGET_AVX2 static inline __m128i clipAVX2(const __m256d value,
+                                                    const __m256d max)
+{
+    return _mm256_cvttpd_epi32(_mm256_min_pd(_mm256_max_pd(value, _mm256_setzero_pd()), max));
+}
+
+DICOSIMD_TARGET_AVX2 static void convertYBR422AVX2(const Uint8 *pixel,
+                                                   Uint8 *red,
+                                                   Uint8 *green,
+                                                   Uint8 *blue,
+                                                   const unsigned long pairs,
+                                                   const Uint8 maxvalue)
+{
+    const double maxval = OFstatic_cast(double, maxvalue);
+    const __m256d max = _mm256_set1_pd(maxval);
+    const __m256d rcr = _mm256_set1_pd(1.4020);
+    const __m256d gcb = _mm256_set1_pd(0.3441);
+    const __m256d gcr = _mm256_set1_pd(0.7141);
+    const __m256d bcb = _mm256_set1_pd(1.7720);
+    const __m256d r_const = _mm256_set1_pd(0.7010 * maxval);
+    const __m256d g_const = _mm256_set1_pd(0.5291 * maxval);
+    const __m256d b_const = _mm256_set1_pd(0.8859 * maxval);
+    const __m128i mask = _mm_set1_epi32(0xff);
+    unsigned long i = 0;
+    for (; i + 4 <= pairs; i += 4)
+    {
+        /* each 32-bit value contains Y1, Y2, Cb and Cr of a pixel pair */
+        const __m128i v = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, pixel + 4 * i));
+        const __m256d cb = _mm256_cvtepi32_pd(_mm_and_si128(_mm_srli_epi32(v, 16), mask));
+        const __m256d cr = _mm256_cvtepi32_pd(_mm_srli_epi32(v, 24));
+        const __m256d rc = _mm256_mul_pd(rcr, cr);
+        const __m256d gb = _mm256_mul_pd(gcb, cb);
+        const __m256d gr = _mm256_mul_pd(gcr, cr);
+        const __m256d bb = _mm256_mul_pd(bcb, cb);
+        __m128i r[2], g[2], b[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            const __m256d y = _mm256_cvtepi32_pd(_mm_and_si128(_mm_srli_epi32(v, 8 * j), mask));
+            r[j] = clipAVX2(_mm256_sub_pd(_mm256_add_pd(y, rc), r_const), max);
+            g[j] = clipAVX2(_mm256_add_pd(_mm256_sub_pd(_mm256_sub_pd(y, gb), gr), g_const), max);
+            b[j] = clipAVX2(_mm256_sub_pd(_mm256_add_pd(y, bb), b_const), max);
+        }
+        /* Y1 and Y2 are adjacent in the output */
+        const __m128i rp = _mm_packs_epi32(_mm_unpacklo_epi32(r[0], r[1]), _mm_unpackhi_epi32(r[0], r[1]));
+        const __m128i gp = _mm_packs_epi32(_mm_unpacklo_epi32(g[0], g[1]), _mm_unpackhi_epi32(g[0], g[1]));
+        const __m128i bp = _mm_packs_epi32(_mm_unpacklo_epi32(b[0], b[1]), _mm_unpackhi_epi32(b[0], b[1]));
+        _mm_storel_epi64(OFreinterpret_cast(__m128i *, red + 2 * i), _mm_packus_epi16(rp, rp));
+        _mm_storel_epi64(OFreinterpret_cast(__m128i *, green + 2 * i), _mm_packus_epi16(gp, gp));
+        _mm_storel_epi64(OFreinterpret_cast(__m128i *, blue + 2 * i), _mm_packus_epi16(bp, bp));
+    }
+    convertYBR422Scalar(pixel + 4 * i, red + 2 * i, green + 2 * i, blue + 2 * i, pairs - i, maxvalue);
+}
+
+/* the byte shuffle instruction (SSSE3) is available on all processors supporting AVX2 */
+
+DICOSIMD_TARGET_AVX2 static void deinterleaveAVX2(const Uint8 *src,
+                                                  Uint8 *plane0,
+                                                  Uint8 *plane1,
+                                                  Uint8 *plane2,
+                                                  const unsigned long count)
+{
+    __m128i mask[3][3];
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            mask[i][j] = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, ShuffleMasks.Deinterleave[i][j]));
+    Uint8 *plane[3] = { plane0, plane1, plane2 };
+    unsigned long i = 0;
+    for (; i + 16 <= count; i += 16, src += 48)
+    {
+        const __m128i v0 = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, src));
+        const __m128i v1 = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, src + 16));
+        const __m128i v2 = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, src + 32));
+        for (int j = 0; j < 3; ++j)
+        {
+            const __m128i v = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, mask[j][0]), _mm_shuffle_epi8(v1, mask[j][1])),
+                                           _mm_shuffle_epi8(v2, mask[j][2]));
+            _mm_storeu_si128(OFreinterpret_cast(__m128i *, plane[j] + i), v);
+        }
+    }
+    deinterleaveScalar(src, plane0 + i, plane1 + i, plane2 + i, count - i);
+}
+
+DICOSIMD_TARGET_AVX2 static void interleaveAVX2(const Uint8 *plane0,
+                                                const Uint8 *plane1,
+                                                const Uint8 *plane2,
+                                                Uint8 *dst,
+                                                const unsigned long count)
+{
+    __m128i mask[3][3];
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            mask[i][j] = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, ShuffleMasks.Interleave[i][j]));
+    unsigned long i = 0;
+    for (; i + 16 <= count; i += 16, dst += 48)
+    {
+        const __m128i v0 = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, plane0 + i));
+        const __m128i v1 = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, plane1 + i));
+        const __m128i v2 = _mm_loadu_si128(OFreinterpret_cast(const __m128i *, plane2 + i));
+        for (int j = 0; j < 3; ++j)
+        {
+            const __m128i v = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, mask[j][0]), _mm_shuffle_epi8(v1, mask[j][1])),
+                                           _mm_shuffle_epi8(v2, mask[j][2]));
+            _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst + 16 * j), v);
+        }
+    }
+    interleaveScalar(plane0 + i, plane1 + i, plane2 + i, dst, count - i);
+}
+
+#endif
+
+
+/*--------------*
+ *  dispatching  *
+ *--------------*/
+
+int DiColorSIMD::convertYBRFull(const Uint8 *y,
+                                const Uint8 *cb,
+                                const Uint8 *cr,
+                                Uint8 *red,
+                                Uint8 *green,
+                                Uint8 *blue,
+                                const unsigned long count)
+{
+#ifdef DICOSIMD_X86
+    /* without a gather instruction, the scalar code (using lookup tables) is faster */
+    if (DiSIMD::getInstructionSet() == DiSIMD::IS_AVX2)
+    {
+        convertYBRFullAVX2(y, cb, cr, red, green, blue, count);
+        return 1;
+    }
+#else
+    OFstatic_cast(void, y);
+    OFstatic_cast(void, cb);
+    OFstatic_cast(void, cr);
+    OFstatic_cast(void, red);
+    OFstatic_cast(void, green);
+    OFstatic_cast(void, blue);
+    OFstatic_cast(void, count);
+#endif
+    return 0;
+}
+
+
+int DiColorSIMD::convertYBRFull(const Uint8 *pixel,
+                                Uint8 *red,
+                                Uint8 *green,
+                                Uint8 *blue,
+                                const unsigned long count)
+{
+    if (DiSIMD::getInstructionSet() != DiSIMD::IS_AVX2)
+        return 0;
+    /* split the input data into small blocks of planes (kept in the cache) and convert them */
+    const unsigned long blockSize = 1024;
+    Uint8 y[blockSize];
+    Uint8 cb[blockSize];
+    Uint8 cr[blockSize];
+    for (unsigned long i = 0; i < count; i += blockSize)
+    {
+        const unsigned long n = (count - i < blockSize) ? count - i : blockSize;
+        deinterleave(pixel + 3 * i, y, cb, cr, n);
+        convertYBRFull(y, cb, cr, red + i, green + i, blue + i, n);
+    }
+    return 1;
+}
+
+
+int DiColorSIMD::convertYBR422(const Uint8 *pixel,
+                               Uint8 *red,
+                               Uint8 *green,
+                               Uint8 *blue,
+                               const unsigned long pairs,
+                               const Uint8 maxvalue)
+{
+#ifdef DICOSIMD_X86
+    const DiSIMD::E_InstructionSet set = DiSIMD::getInstructionSet();
+    if (set == DiSIMD::IS_AVX2)
+    {
+        convertYBR422AVX2(pixel, red, green, blue, pairs, maxvalue);
+        return 1;
+    }
+    if (set == DiSIMD::IS_SSE2)
+    {
+        convertYBR422SSE2(pixel, red, green, blue, pairs, maxvalue);
+        return 1;
+    }
+#else
+    OFstatic_cast(void, pixel);
+    OFstatic_cast(void, red);
+    OFstatic_cast(void, green);
+    OFstatic_cast(void, blue);
+    OFstatic_cast(void, pairs);
+    OFstatic_cast(void, maxvalue);
+#endif
+    return 0;
+}
+
+
+int DiColorSIMD::deinterleave(const Uint8 *src,
+                              Uint8 *plane0,
+                              Uint8 *plane1,
+                              Uint8 *plane2,
+                              const unsigned long count)
+{
+#ifdef DICOSIMD_X86
+    /* SSE2 has no byte shuffle instruction, the scalar code is about as fast */
+    if (DiSIMD::getInstructionSet() == DiSIMD::IS_AVX2)
+    {
+        deinterleaveAVX2(src, plane0, plane1, plane2, count);
+        return 1;
+    }
+#else
+    OFstatic_cast(void, src);
+    OFstatic_cast(void, plane0);
+    OFstatic_cast(void, plane1);
+    OFstatic_cast(void, plane2);
+    OFstatic_cast(void, count);
+#endif
+    return 0;
+}
+
+
+int DiColorSIMD::interleave(const Uint8 *plane0,
+                            const Uint8 *plane1,
+                            const Uint8 *plane2,
+                            Uint8 *dst,
+                            const unsigned long count)
+{
+#ifdef DICOSIMD_X86
+    if (DiSIMD::getInstructionSet() == DiSIMD::IS_AVX2)
+    {
+        interleaveAVX2(plane0, plane1, plane2, dst, count);
+        return 1;
+    }
+#else
+    OFstatic_cast(void, plane0);
+    OFstatic_cast(void, plane1);
+    OFstatic_cast(void, plane2);
+    OFstatic_cast(void, dst);
+    OFstatic_cast(void, count);
+#endif
+    return 0;
+}
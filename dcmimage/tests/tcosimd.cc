@@ -0,0 +1,145 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimage
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: test program for the vectorized color conversion (DiColorSIMD)
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/ofstd/ofstream.h"
+#include "dcmtk/dcmdata/dcdatset.h"
+#include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmimgle/dcmimage.h"
+#include "dcmtk/dcmimgle/disimd.h"
+#include "dcmtk/dcmimage/diregist.h"  /* include to support color images */
+
+#include <cstring>
+
+
+/* image size chosen so that the vectorized code also has to process some remaining pixels */
+static const Uint16 Columns = 66;
+static const Uint16 Rows = 31;
+static const unsigned long Frames = 2;
+
+
+/* create an image with pseudo-random pixel data (covering all combinations of sample values) */
+static void createImage(DcmDataset &dset,
+                        const char *photometricInterpretation,
+                        const Uint16 planarConfiguration)
+{
+    /* YBR_FULL_422 uses two samples per pixel (on average) */
+    const unsigned long samples = (strcmp(photometricInterpretation, "YBR_FULL_422") == 0) ? 2 : 3;
+    const unsigned long length = OFstatic_cast(unsigned long, Columns) * Rows * samples * Frames;
+    Uint8 *pixel = new Uint8[length];
+    Uint32 seed = 4711;
+    for (unsigned long i = 0; i < length; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        pixel[i] = OFstatic_cast(Uint8, seed >> 16);
+    }
+    /* make sure that the extreme values are used */
+    for (unsigned long j = 0; j < 12; ++j)
+        pixel[j] = (j & 1) ? 255 : 0;
+    OFCHECK(dset.putAndInsertUint16(DCM_SamplesPerPixel, 3).good());
+    OFCHECK(dset.putAndInsertString(DCM_PhotometricInterpretation, photometricInterpretation).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_PlanarConfiguration, planarConfiguration).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Rows, Rows).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_Columns, Columns).good());
+    OFCHECK(dset.putAndInsertString(DCM_NumberOfFrames, "2").good());
+    OFCHECK(dset.putAndInsertUint16(DCM_BitsAllocated, 8).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_BitsStored, 8).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_HighBit, 7).good());
+    OFCHECK(dset.putAndInsertUint16(DCM_PixelRepresentation, 0).good());
+    OFCHECK(dset.putAndInsertUint8Array(DCM_PixelData, pixel, length).good());
+    delete[] pixel;
+}
+
+
+/* render all frames of the image (color-by-pixel and color-by-plane) */
+static void renderImage(DcmDataset &dset,
+                        const unsigned long flags,
+                        const DiSIMD::E_InstructionSet set,
+                        Uint8 *buffer,
+                        const unsigned long size)
+{
+    DiSIMD::setInstructionSet(set);
+    DicomImage image(&dset, EXS_LittleEndianExplicit, flags, 0UL, Frames);
+    OFCHECK(image.getStatus() == EIS_Normal);
+    OFCHECK_EQUAL(image.getOutputDataSize(8), size / (2 * Frames));
+    for (unsigned long frame = 0; frame < Frames; ++frame)
+    {
+        for (int planar = 0; planar < 2; ++planar)
+        {
+            const unsigned long offset = (2 * frame + planar) * size / (2 * Frames);
+            OFCHECK(image.getOutputData(buffer + offset, size / (2 * Frames), 8, frame, planar) != 0);
+        }
+    }
+}
+
+
+/* compare the output of the scalar and the vectorized implementation */
+static void checkImage(const char *photometricInterpretation,
+                       const Uint16 planarConfiguration,
+                       const unsigned long flags)
+{
+    DcmDataset dset;
+    createImage(dset, photometricInterpretation, planarConfiguration);
+    const unsigned long size = OFstatic_cast(unsigned long, Columns) * Rows * 3 * 2 * Frames;
+    Uint8 *expected = new Uint8[size];
+    Uint8 *result = new Uint8[size];
+    const DiSIMD::E_InstructionSet supported = DiSIMD::getSupportedInstructionSet();
+    renderImage(dset, flags, DiSIMD::IS_None, expected, size);
+    /* check all instruction sets supported by the current processor */
+    for (int set = DiSIMD::IS_SSE2; set <= supported; ++set)
+    {
+        renderImage(dset, flags, OFstatic_cast(DiSIMD::E_InstructionSet, set), result, size);
+        OFOStringStream details;
+        details << photometricInterpretation << " (planar configuration " << planarConfiguration << ", flags "
+                << flags << ") using " << DiSIMD::getInstructionSetName(OFstatic_cast(DiSIMD::E_InstructionSet, set)) << OFStringStream_ends;
+        OFSTRINGSTREAM_GETOFSTRING(details, message)
+        OFCHECK_MSG(memcmp(expected, result, size) == 0, message);
+    }
+    DiSIMD::setInstructionSet(supported);
+    delete[] expected;
+    delete[] result;
+}
+
+
+OFTEST(dcmimage_simd_rgb)
+{
+    checkImage("RGB", 0, 0);
+    checkImage("RGB", 1, 0);
+}
+
+
+OFTEST(dcmimage_simd_ybr_full)
+{
+    checkImage("YBR_FULL", 0, 0);
+    checkImage("YBR_FULL", 1, 0);
+    checkImage("YBR_FULL", 0, CIF_KeepYCbCrColorModel);
+    checkImage("YBR_FULL", 1, CIF_KeepYCbCrColorModel);
+}
+
+
+OFTEST(dcmimage_simd_ybr_full_422)
+{
+    checkImage("YBR_FULL_422", 0, 0);
+    checkImage("YBR_FULL_422", 0, CIF_KeepYCbCrColorModel);
+}
@@ -1376,7 +1376,8 @@ class DCMTK_DCMIMGLE_EXPORT DicomImage
      *  @param  interpolate  specifies whether scaling algorithm should use interpolation (if necessary).
      *                       default: no interpolation (0), preferred interpolation algorithm (if applicable):
      *                         1 = pbmplus algorithm, 2 = c't algorithm, 3 = bilinear magnification,
-     *                         4 = bicubic magnification
+     *                         4 = bicubic magnification, 5 = box filter resampling (area averaging),
+     *                         6 = Lanczos filter resampling
      *  @param  aspect       specifies whether pixel aspect ratio should be taken into consideration
      *                       (if true, width OR height should be 0, i.e. this component will be calculated
      *                        automatically)
@@ -1396,7 +1397,8 @@ class DCMTK_DCMIMGLE_EXPORT DicomImage
      *  @param  interpolate  specifies whether scaling algorithm should use interpolation (if necessary).
      *                       default: no interpolation (0), preferred interpolation algorithm (if applicable):
      *                         1 = pbmplus algorithm, 2 = c't algorithm, 3 = bilinear magnification,
-     *                         4 = bicubic magnification
+     *                         4 = bicubic magnification, 5 = box filter resampling (area averaging),
+     *                         6 = Lanczos filter resampling
      *  @param  aspect       specifies whether pixel aspect ratio should be taken into consideration
      *                       (if true, width OR height should be 0, i.e. this component will be calculated
      *                        automatically)
@@ -1422,7 +1424,8 @@ class DCMTK_DCMIMGLE_EXPORT DicomImage
      *  @param  interpolate   specifies whether scaling algorithm should use interpolation (if necessary).
      *                        default: no interpolation (0), preferred interpolation algorithm (if applicable):
      *                          1 = pbmplus algorithm, 2 = c't algorithm, 3 = bilinear magnification,
-     *                          4 = bicubic magnification
+     *                          4 = bicubic magnification, 5 = box filter resampling (area averaging),
+     *                          6 = Lanczos filter resampling
      *  @param  aspect        specifies whether pixel aspect ratio should be taken into consideration
      *                        (if true, width OR height should be 0, i.e. this component will be calculated
      *                         automatically)
@@ -1454,7 +1457,8 @@ class DCMTK_DCMIMGLE_EXPORT DicomImage
      *  @param  interpolate  specifies whether scaling algorithm should use interpolation (if necessary).
      *                       default: no interpolation (0), preferred interpolation algorithm (if applicable):
      *                         1 = pbmplus algorithm, 2 = c't algorithm, 3 = bilinear magnification,
-     *                         4 = bicubic magnification
+     *                         4 = bicubic magnification, 5 = box filter resampling (area averaging),
+     *                         6 = Lanczos filter resampling
      *  @param  aspect       specifies whether pixel aspect ratio should be taken into consideration
      *                       (if true, width OR height should be 0, i.e. this component will be calculated
      *                        automatically)
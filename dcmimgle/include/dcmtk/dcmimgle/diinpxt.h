@@ -33,6 +33,7 @@
 #include "dcmtk/dcmimgle/diinpx.h"
 #include "dcmtk/dcmimgle/didocu.h"
 #include "dcmtk/dcmimgle/dipxrept.h"
+#include "dcmtk/dcmimgle/distripe.h"
 
 
 /*--------------------*
@@ -347,6 +348,35 @@ class DiInputPixelTemplate
 
  private:
 
+    /** function object: copy pixel value (case 1a)
+     */
+    struct CopyPixel
+    {
+        inline T2 operator()(const T1 value) const
+        {
+            return OFstatic_cast(T2, value);
+        }
+    };
+
+    /** function object: shift and mask pixel value, expand sign (case 1b/1c)
+     */
+    struct MaskPixel
+    {
+        MaskPixel(const Uint16 shift,
+                  const T1 mask,
+                  const T2 sign,
+                  const T2 smask)
+          : Shift(shift), Mask(mask), Sign(sign), SignMask(smask) {}
+        inline T2 operator()(const T1 value) const
+        {
+            return expandSign(OFstatic_cast(T2, (value >> Shift) & Mask), Sign, SignMask);
+        }
+        const Uint16 Shift;
+        const T1 Mask;
+        const T2 Sign;
+        const T2 SignMask;
+    };
+
     /** convert pixel data from DICOM dataset to input representation
      *
      ** @param  document       pointer to DICOM image object
@@ -462,8 +492,7 @@ class DiInputPixelTemplate
                     if (bitsStored == bitsAllocated)
                     {
                         DCMIMGLE_DEBUG("convert input pixel data: case 1a (single copy)");
-                        for (i = Count; i != 0; --i)
-                            *(q++) = OFstatic_cast(T2, *(p++));
+                        DiPixelStripeTask<T1, T2, CopyPixel>::apply(p, q, Count, CopyPixel());
                     }
                     else /* bitsStored < bitsAllocated */
                     {
@@ -476,17 +505,10 @@ class DiInputPixelTemplate
                             smask |= OFstatic_cast(T2, 1 << i);
                         const Uint16 shift = OFstatic_cast(Uint16, highBit + 1 - bitsStored);
                         if (shift == 0)
-                        {
                             DCMIMGLE_DEBUG("convert input pixel data: case 1b (mask & sign)");
-                            for (i = length_T1; i != 0; --i)
-                                *(q++) = expandSign(OFstatic_cast(T2, *(p++) & mask), sign, smask);
-                        }
                         else /* shift > 0 */
-                        {
                             DCMIMGLE_DEBUG("convert input pixel data: case 1c (shift & mask & sign)");
-                            for (i = length_T1; i != 0; --i)
-                                *(q++) = expandSign(OFstatic_cast(T2, (*(p++) >> shift) & mask), sign, smask);
-                        }
+                        DiPixelStripeTask<T1, T2, MaskPixel>::apply(p, q, length_T1, MaskPixel(shift, mask, sign, smask));
                     }
                 }
                 else if ((bitsof_T1 > bitsAllocated) && (bitsof_T1 % bitsAllocated == 0))   // case 2: divisor of 8/16 bit
@@ -32,6 +32,7 @@
 
 #include "dcmtk/dcmimgle/dimopxt.h"
 #include "dcmtk/dcmimgle/diinpx.h"
+#include "dcmtk/dcmimgle/distripe.h"
 
 
 /*---------------------*
@@ -95,6 +96,83 @@ class DiMonoInputPixelTemplate
 
  private:
 
+    /** function object: copy pixel value
+     */
+    struct CopyPixel
+    {
+        inline T3 operator()(const T1 value) const
+        {
+            return OFstatic_cast(T3, value);
+        }
+    };
+
+    /** function object: rescale pixel value (intercept only)
+     */
+    struct RescaleIntercept
+    {
+        RescaleIntercept(const double intercept)
+          : Intercept(intercept) {}
+        inline T3 operator()(const T1 value) const
+        {
+            return OFstatic_cast(T3, OFstatic_cast(double, value) + Intercept);
+        }
+        const double Intercept;
+    };
+
+    /** function object: rescale pixel value (slope only)
+     */
+    struct RescaleSlope
+    {
+        RescaleSlope(const double slope)
+          : Slope(slope) {}
+        inline T3 operator()(const T1 value) const
+        {
+            return OFstatic_cast(T3, OFstatic_cast(double, value) * Slope);
+        }
+        const double Slope;
+    };
+
+    /** function object: rescale pixel value (slope and intercept)
+     */
+    struct RescaleSlopeIntercept
+    {
+        RescaleSlopeIntercept(const double slope,
+                              const double intercept)
+          : Slope(slope), Intercept(intercept) {}
+        inline T3 operator()(const T1 value) const
+        {
+            return OFstatic_cast(T3, OFstatic_cast(double, value) * Slope + Intercept);
+        }
+        const double Slope;
+        const double Intercept;
+    };
+
+    /** function object: apply modality LUT to pixel value
+     */
+    struct ModalityLUT
+    {
+        ModalityLUT(const DiLookupTable *mlut,
+                    const T2 firstentry,
+                    const T2 lastentry,
+                    const T3 firstvalue,
+                    const T3 lastvalue)
+          : Table(mlut), FirstEntry(firstentry), LastEntry(lastentry), FirstValue(firstvalue), LastValue(lastvalue) {}
+        inline T3 operator()(const T1 pixel) const
+        {
+            const T2 value = OFstatic_cast(T2, pixel);
+            if (value <= FirstEntry)
+                return FirstValue;
+            else if (value >= LastEntry)
+                return LastValue;
+            return OFstatic_cast(T3, Table->getValue(value));
+        }
+        const DiLookupTable *Table;
+        const T2 FirstEntry;
+        const T2 LastEntry;
+        const T3 FirstValue;
+        const T3 LastValue;
+    };
+
 #include DCMTK_DIAGNOSTIC_PUSH
 #include DCMTK_DIAGNOSTIC_IGNORE_CONST_EXPRESSION_WARNING
 
@@ -111,7 +189,7 @@ class DiMonoInputPixelTemplate
         int result = 0;
         if ((sizeof(T1) <= 2) && (this->InputCount > 3 * ocnt))               // optimization criteria
         {                                                                     // use LUT for optimization
-            lut = new T3[ocnt];
+            lut = new T3[ocnt + DiSIMD::LUTPadding];                          // padding for vectorized access
             if (lut != NULL)
             {
                 DCMIMGLE_DEBUG("using optimized routine with additional LUT");
@@ -156,6 +234,8 @@ class DiMonoInputPixelTemplate
                     unsigned long i;
                     T3 *lut = NULL;
                     const unsigned long ocnt = OFstatic_cast(unsigned long, input->getAbsMaxRange());  // number of LUT entries
+                    /* the input buffer is re-used with an offset, i.e. it has to be processed sequentially */
+                    const unsigned long minStripe = (useInputBuffer && (input->getPixelStart() > 0)) ? this->InputCount : DiStripeTask::MinPixelStripe;
                     if (initOptimizationLUT(lut, ocnt))
                     {                                                                     // use LUT for optimization
                         const T2 absmin = OFstatic_cast(T2, input->getAbsMinimum());
@@ -170,23 +250,13 @@ class DiMonoInputPixelTemplate
                             else
                                 *(q++) = OFstatic_cast(T3, mlut->getValue(value));
                         }
-                        const T3 *lut0 = lut - OFstatic_cast(T2, absmin);                 // points to 'zero' entry
-                        q = this->Data;
-                        for (i = this->InputCount; i != 0; --i)                           // apply LUT
-                            *(q++) = *(lut0 + (*(p++)));
+                        DiLookupStripeTask<T1, T3> task(p, this->Data, lut, OFstatic_cast(Sint32, absmin));
+                        task.run(this->InputCount, minStripe);                            // apply LUT
                     }
                     if (lut == NULL)                                                      // use "normal" transformation
                     {
-                        for (i = this->InputCount; i != 0; --i)
-                        {
-                            value = OFstatic_cast(T2, *(p++));
-                            if (value <= firstentry)
-                                *(q++) = firstvalue;
-                            else if (value >= lastentry)
-                                *(q++) = lastvalue;
-                            else
-                                *(q++) = OFstatic_cast(T3, mlut->getValue(value));
-                        }
+                        DiPixelStripeTask<T1, T3, ModalityLUT> task(p, q, ModalityLUT(mlut, firstentry, lastentry, firstvalue, lastvalue));
+                        task.run(this->InputCount, minStripe);
                     }
                     delete[] lut;
                 }
@@ -225,8 +295,8 @@ class DiMonoInputPixelTemplate
                     {
                         DCMIMGLE_DEBUG("copying pixel data from input buffer");
                         const T1 *p = pixel + input->getPixelStart();
-                        for (i = this->InputCount; i != 0; --i)   // copy pixel data: can't use copyMem because T1 isn't always equal to T3
-                            *(q++) = OFstatic_cast(T3, *(p++));
+                        // copy pixel data: can't use copyMem because T1 isn't always equal to T3
+                        DiPixelStripeTask<T1, T3, CopyPixel>::apply(p, q, this->InputCount, CopyPixel());
                     }
                 } else {
                     DCMIMGLE_DEBUG("applying modality transformation with rescale slope = " << slope << ", intercept = " << intercept);
@@ -251,27 +321,16 @@ class DiMonoInputPixelTemplate
                                     *(q++) = OFstatic_cast(T3, (OFstatic_cast(double, i) + absmin) * slope + intercept);
                             }
                         }
-                        const T3 *lut0 = lut - OFstatic_cast(T2, absmin);                 // points to 'zero' entry
-                        q = this->Data;
-                        for (i = this->InputCount; i != 0; --i)                           // apply LUT
-                            *(q++) = *(lut0 + (*(p++)));
+                        DiLookupStripeTask<T1, T3>::apply(p, this->Data, this->InputCount, lut, OFstatic_cast(Sint32, OFstatic_cast(T2, absmin)));
                     }
                     if (lut == NULL)                                                      // use "normal" transformation
                     {
                         if (slope == 1.0)
-                        {
-                            for (i = this->InputCount; i != 0; --i)
-                                *(q++) = OFstatic_cast(T3, OFstatic_cast(double, *(p++)) + intercept);
-                        } else {
-                            if (intercept == 0.0)
-                            {
-                                for (i = this->InputCount; i != 0; --i)
-                                    *(q++) = OFstatic_cast(T3, OFstatic_cast(double, *(p++)) * slope);
-                            } else {
-                                for (i = this->InputCount; i != 0; --i)
-                                    *(q++) = OFstatic_cast(T3, OFstatic_cast(double, *(p++)) * slope + intercept);
-                            }
-                        }
+                            DiPixelStripeTask<T1, T3, RescaleIntercept>::apply(p, q, this->InputCount, RescaleIntercept(intercept));
+                        else if (intercept == 0.0)
+                            DiPixelStripeTask<T1, T3, RescaleSlope>::apply(p, q, this->InputCount, RescaleSlope(slope));
+                        else
+                            DiPixelStripeTask<T1, T3, RescaleSlopeIntercept>::apply(p, q, this->InputCount, RescaleSlopeIntercept(slope, intercept));
                     }
                     delete[] lut;
                 }
@@ -28,6 +28,7 @@
 #include "dcmtk/ofstd/ofcast.h"
 #include "dcmtk/ofstd/ofbmanip.h"
 #include "dcmtk/ofstd/ofdiag.h"      /* for DCMTK_DIAGNOSTIC macros */
+#include "dcmtk/ofstd/oflimits.h"
 
 #include "dcmtk/dcmimgle/dimoopx.h"
 #include "dcmtk/dcmimgle/dimopx.h"
@@ -36,6 +37,7 @@
 #include "dcmtk/dcmimgle/dipxrept.h"
 #include "dcmtk/dcmimgle/didispfn.h"
 #include "dcmtk/dcmimgle/didislut.h"
+#include "dcmtk/dcmimgle/distripe.h"
 
 #ifdef PASTEL_COLOR_OUTPUT
 #include "dimcopxt.h"
@@ -292,18 +294,22 @@ class DiMonoOutputPixelTemplate
 
     /** initialize an optimization LUT if the optimization criteria is fulfilled
      *
-     ** @param  lut   reference to storage area where the optimization LUT should be stored
-     *  @param  ocnt  number of entries for the optimization LUT (0 = never create one)
+     ** @param  lut    reference to storage area where the optimization LUT should be stored
+     *  @param  ocnt   number of entries for the optimization LUT (0 = never create one)
+     *  @param  ratio  minimum ratio between the number of pixels and the number of LUT
+     *                 entries. Should be lower than the default for transformations that
+     *                 are expensive to compute, e.g. the sigmoid function.
      *
      ** @return status, true if successful, false otherwise
      */
     inline int initOptimizationLUT(T3 *&lut,
-                                   const unsigned long ocnt)
+                                   const unsigned long ocnt,
+                                   const unsigned long ratio = 3)
     {
         int result = 0;
-        if ((sizeof(T1) <= 2) && (ocnt > 0) && (Count > 3 * ocnt))            // optimization criteria
+        if ((sizeof(T1) <= 2) && (ocnt > 0) && (Count > ratio * ocnt))        // optimization criteria
         {                                                                     // use LUT for optimization
-            lut = new T3[ocnt];
+            lut = new T3[ocnt + DiSIMD::LUTPadding];                          // padding for vectorized access
             if (lut != NULL)
             {
                 DCMIMGLE_DEBUG("using optimized routine with additional LUT (" << ocnt << " entries)");
@@ -315,6 +321,20 @@ class DiMonoOutputPixelTemplate
 
 #include DCMTK_DIAGNOSTIC_POP
 
+    /** apply an optimization LUT (created by initOptimizationLUT) to the output data.
+     *  Uses vector instructions and multiple threads if available.
+     *
+     ** @param  lut     optimization LUT, first entry corresponds to 'absmin'
+     *  @param  absmin  minimum pixel value of the intermediate representation
+     *  @param  p       pointer to the first input pixel to be processed
+     */
+    inline void applyOptimizationLUT(const T3 *lut,
+                                     const double absmin,
+                                     const T1 *p)
+    {
+        DiLookupStripeTask<T1, T3>::apply(p, Data, Count, lut, OFstatic_cast(Sint32, OFstatic_cast(T2, absmin)));
+    }
+
 #ifdef PASTEL_COLOR_OUTPUT
     void color(void *buffer,                               // create true color pastel image
                const DiMonoPixel *inter,
@@ -458,10 +478,7 @@ class DiMonoOutputPixelTemplate
                                     *(q++) = OFstatic_cast(T3, lowvalue + OFstatic_cast(double, plut->getValue(value2)) * gradient2);
                                 }
                             }
-                            const T3 *lut0 = lut - OFstatic_cast(T2, inter->getAbsMinimum());  // points to 'zero' entry
-                            q = Data;
-                            for (i = Count; i != 0; --i)                                  // apply LUT
-                                *(q++) = *(lut0 + (*(p++)));
+                            applyOptimizationLUT(lut, inter->getAbsMinimum(), p);             // apply LUT
                         }
                         if (lut == NULL)                                                  // use "normal" transformation
                         {
@@ -558,10 +575,7 @@ class DiMonoOutputPixelTemplate
                                         *(q++) = OFstatic_cast(T3, lowvalue + OFstatic_cast(double, vlut->getValue(value)) * gradient);
                                 }
                             }
-                            const T3 *lut0 = lut - OFstatic_cast(T2, inter->getAbsMinimum());   // points to 'zero' entry
-                            q = Data;
-                            for (i = Count; i != 0; --i)                                  // apply LUT
-                                *(q++) = *(lut0 + (*(p++)));
+                            applyOptimizationLUT(lut, inter->getAbsMinimum(), p);             // apply LUT
                         }
                         if (lut == NULL)                                                  // use "normal" transformation
                         {
@@ -686,10 +700,7 @@ class DiMonoOutputPixelTemplate
                                 *(q++) = OFstatic_cast(T3, lowvalue + OFstatic_cast(double, plut->getValue(value)) * gradient2);
                             }
                         }
-                        const T3 *lut0 = lut - OFstatic_cast(T2, inter->getAbsMinimum());  // points to 'zero' entry
-                        q = Data;
-                        for (i = Count; i != 0; --i)                                  // apply LUT
-                            *(q++) = *(lut0 + (*(p++)));
+                        applyOptimizationLUT(lut, inter->getAbsMinimum(), p);                 // apply LUT
                     }
                     if (lut == NULL)                                                  // use "normal" transformation
                     {
@@ -742,10 +753,7 @@ class DiMonoOutputPixelTemplate
                             for (i = 0; i < ocnt; ++i)                                // calculating LUT entries
                                 *(q++) = OFstatic_cast(T3, lowvalue + OFstatic_cast(double, i) * gradient);
                         }
-                        const T3 *lut0 = lut - OFstatic_cast(T2, inter->getAbsMinimum());  // points to 'zero' entry
-                        q = Data;
-                        for (i = Count; i != 0; --i)                                  // apply LUT
-                            *(q++) = *(lut0 + (*(p++)));
+                        applyOptimizationLUT(lut, inter->getAbsMinimum(), p);                 // apply LUT
                     }
                     if (lut == NULL)                                                  // use "normal" transformation
                     {
@@ -762,8 +770,15 @@ class DiMonoOutputPixelTemplate
                             }
                         } else {                                                      // don't use display: invalid or absent
                             DCMIMGLE_TRACE("monochrome rendering: VOI NONE #8");
-                            for (i = Count; i != 0; --i)
-                                *(q++) = OFstatic_cast(T3, lowvalue + (OFstatic_cast(double, *(p++)) - absmin) * gradient);
+                            DiSIMD::LinearTransformation trans;
+                            trans.LowerBorder = -OFnumeric_limits<double>::max();     // no clipping
+                            trans.UpperBorder = OFnumeric_limits<double>::max();
+                            trans.Shift = absmin;
+                            trans.Gradient = gradient;
+                            trans.Offset = lowvalue;
+                            trans.LowValue = lowvalue;
+                            trans.HighValue = OFstatic_cast(double, high);
+                            DiLinearStripeTask<T1, T3>::apply(p, q, Count, trans);
                         }
                     }
                 }
@@ -820,7 +835,7 @@ class DiMonoOutputPixelTemplate
                     Uint32 value2;                                                    // presentation LUT is always unsigned
                     const double plutcnt_1 = OFstatic_cast(double, plut->getCount() - 1);
                     const double plutmax_1 = OFstatic_cast(double, plut->getAbsMaxRange() - 1);
-                    if (initOptimizationLUT(lut, ocnt))
+                    if (initOptimizationLUT(lut, ocnt, 1 /* exp() is expensive */))
                     {                                                                 // use LUT for optimization
                         q = lut;
                         if (dlut != NULL)                                             // perform display transformation
@@ -845,10 +860,7 @@ class DiMonoOutputPixelTemplate
                                 *(q++) = OFstatic_cast(T3, lowvalue + OFstatic_cast(double, plut->getValue(value2)) * gradient);
                             }
                         }
-                        const T3 *lut0 = lut - OFstatic_cast(T2, absmin);             // points to 'zero' entry
-                        q = Data;
-                        for (i = Count; i != 0; --i)                                  // apply LUT
-                            *(q++) = *(lut0 + (*(p++)));
+                        applyOptimizationLUT(lut, absmin, p);                                 // apply LUT
                     }
                     if (lut == NULL)                                                  // use "normal" transformation
                     {
@@ -877,7 +889,7 @@ class DiMonoOutputPixelTemplate
                     }
                 } else {                                                              // has no presentation LUT
                     createDisplayLUT(dlut, disp, bitsof(T1));
-                    if (initOptimizationLUT(lut, ocnt))
+                    if (initOptimizationLUT(lut, ocnt, 1 /* exp() is expensive */))
                     {                                                                 // use LUT for optimization
                         q = lut;
                         if (dlut != NULL)                                             // perform display transformation
@@ -899,10 +911,7 @@ class DiMonoOutputPixelTemplate
                                 *(q++) = OFstatic_cast(T3, outrange / (1 + exp(-4 * (value - center) / width)) + lowvalue);
                             }
                         }
-                        const T3 *lut0 = lut - OFstatic_cast(T2, absmin);             // points to 'zero' entry
-                        q = Data;
-                        for (i = Count; i != 0; --i)                                  // apply LUT
-                            *(q++) = *(lut0 + (*(p++)));
+                        applyOptimizationLUT(lut, absmin, p);                                 // apply LUT
                     }
                     if (lut == NULL)                                                  // use "normal" transformation
                     {
@@ -1019,10 +1028,7 @@ class DiMonoOutputPixelTemplate
                                 *(q++) = OFstatic_cast(T3, lowvalue + OFstatic_cast(double, plut->getValue(value2)) * gradient2);
                             }
                         }
-                        const T3 *lut0 = lut - OFstatic_cast(T2, absmin);             // points to 'zero' entry
-                        q = Data;
-                        for (i = Count; i != 0; --i)                                  // apply LUT
-                            *(q++) = *(lut0 + (*(p++)));
+                        applyOptimizationLUT(lut, absmin, p);                                 // apply LUT
                     }
                     if (lut == NULL)                                                  // use "normal" transformation
                     {
@@ -1094,10 +1100,7 @@ class DiMonoOutputPixelTemplate
                                     *(q++) = OFstatic_cast(T3, offset + value * gradient);   // gray value
                             }
                         }
-                        const T3 *lut0 = lut - OFstatic_cast(T2, absmin);             // points to 'zero' entry
-                        q = Data;
-                        for (i = Count; i != 0; --i)                                  // apply LUT
-                            *(q++) = *(lut0 + (*(p++)));
+                        applyOptimizationLUT(lut, absmin, p);                                 // apply LUT
                     }
                     if (lut == NULL)                                                  // use "normal" transformation
                     {
@@ -1120,16 +1123,15 @@ class DiMonoOutputPixelTemplate
                             DCMIMGLE_TRACE("monochrome rendering: VOI LINEAR #8");
                             const double offset = (width_1 == 0) ? 0 : (high - ((center - 0.5) / width_1 + 0.5) * outrange);
                             const double gradient = (width_1 == 0) ? 0 : outrange / width_1;
-                            for (i = Count; i != 0; --i)
-                            {
-                                value = OFstatic_cast(double, *(p++));
-                                if (value <= leftBorder)
-                                    *(q++) = low;                                            // black/white
-                                else if (value > rightBorder)
-                                    *(q++) = high;                                           // white/black
-                                else
-                                    *(q++) = OFstatic_cast(T3, offset + value * gradient);   // gray value
-                            }
+                            DiSIMD::LinearTransformation trans;
+                            trans.LowerBorder = leftBorder;
+                            trans.UpperBorder = rightBorder;
+                            trans.Shift = 0;
+                            trans.Gradient = gradient;
+                            trans.Offset = offset;
+                            trans.LowValue = OFstatic_cast(double, low);
+                            trans.HighValue = OFstatic_cast(double, high);
+                            DiLinearStripeTask<T1, T3>::apply(p, q, Count, trans);   // black/white, gray value, white/black
                         }
                     }
                 }
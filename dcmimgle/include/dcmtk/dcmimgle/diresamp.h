@@ -0,0 +1,430 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: DicomResampleTemplate (Header)
+ *
+ */
+
+
+#ifndef DIRESAMP_H
+#define DIRESAMP_H
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/ofstd/ofcast.h"
+#include "dcmtk/dcmimgle/didefine.h"
+#include "dcmtk/dcmimgle/distripe.h"
+
+#include <cmath>
+
+
+/*---------------------*
+ *  class declaration  *
+ *---------------------*/
+
+/** Class computing the filter weights for resampling one dimension of an
+ *  image (i.e. the rows or the columns). For each destination pixel, the
+ *  range of contributing source pixels and their (normalized) weights are
+ *  stored, both as floating point and as fixed point values.
+ */
+class DCMTK_DCMIMGLE_EXPORT DiResampleFilter
+{
+
+ public:
+
+    /** resampling filters
+     */
+    enum E_Filter
+    {
+        /// box filter, i.e. area averaging for reduction and linear interpolation for magnification
+        F_Box,
+        /// Lanczos filter with three lobes (windowed sinc)
+        F_Lanczos3
+    };
+
+    /** constructor
+     *
+     ** @param  srcSize   number of source pixels
+     *  @param  destSize  number of destination pixels
+     *  @param  filter    resampling filter to be used
+     */
+    DiResampleFilter(const Uint16 srcSize,
+                     const Uint16 destSize,
+                     const E_Filter filter);
+
+    /** destructor
+     */
+    virtual ~DiResampleFilter();
+
+    /** check whether the filter weights have been computed successfully
+     *
+     ** @return true if valid, false otherwise
+     */
+    inline int isValid() const
+    {
+        return (Start != NULL) && (Count != NULL) && (Weights != NULL) && (FixedWeights != NULL);
+    }
+
+    /** get index of the first source pixel contributing to a destination pixel
+     *
+     ** @param  pos  index of the destination pixel
+     *
+     ** @return index of the first source pixel
+     */
+    inline unsigned long getStart(const unsigned long pos) const
+    {
+        return Start[pos];
+    }
+
+    /** get number of source pixels contributing to a destination pixel
+     *
+     ** @param  pos  index of the destination pixel
+     *
+     ** @return number of source pixels
+     */
+    inline unsigned long getCount(const unsigned long pos) const
+    {
+        return Count[pos];
+    }
+
+    /** get weights of the source pixels contributing to a destination pixel
+     *
+     ** @param  pos  index of the destination pixel
+     *
+     ** @return pointer to getCount() weights (sum is 1)
+     */
+    inline const double *getWeights(const unsigned long pos) const
+    {
+        return Weights + pos * MaxCount;
+    }
+
+    /** get weights of the source pixels contributing to a destination pixel
+     *  as fixed point values (with FixedPointBits fractional bits)
+     *
+     ** @param  pos  index of the destination pixel
+     *
+     ** @return pointer to getCount() weights (sum is 1 << FixedPointBits)
+     */
+    inline const Sint32 *getFixedWeights(const unsigned long pos) const
+    {
+        return FixedWeights + pos * MaxCount;
+    }
+
+    /// number of fractional bits of the fixed point weights.
+    /// Chosen so that 16 bit pixel values can be accumulated in 32 bit integers.
+    static const int FixedPointBits;
+
+
+ private:
+
+    /// maximum number of source pixels contributing to a destination pixel
+    unsigned long MaxCount;
+    /// index of the first contributing source pixel (for each destination pixel)
+    unsigned long *Start;
+    /// number of contributing source pixels (for each destination pixel)
+    unsigned long *Count;
+    /// weights of the contributing source pixels (MaxCount entries for each destination pixel)
+    double *Weights;
+    /// fixed point weights of the contributing source pixels
+    Sint32 *FixedWeights;
+
+ // --- declarations to avoid compiler warnings
+
+    DiResampleFilter(const DiResampleFilter &);
+    DiResampleFilter &operator=(const DiResampleFilter &);
+};
+
+
+/** Template class to resample a single plane of an image (e.g. one frame of
+ *  a color plane) using separable filters. The rows are resampled first, then
+ *  the columns. Both passes are split into stripes of rows, which are processed
+ *  in parallel (see DiStripeTask). Pixel types up to 16 bits use fixed point
+ *  arithmetic, larger ones floating point arithmetic.
+ */
+template<class T>
+class DiResampleTemplate
+{
+
+ public:
+
+    /** constructor
+     *
+     ** @param  xFilter   filter weights for the rows (source width to destination width)
+     *  @param  yFilter   filter weights for the columns (source height to destination height)
+     *  @param  srcRows   number of source rows (height of the source area)
+     *  @param  destCols  number of destination columns (width of the destination image)
+     *  @param  destRows  number of destination rows (height of the destination image)
+     *  @param  minValue  minimum pixel value (resampled values are clipped to this range)
+     *  @param  maxValue  maximum pixel value
+     */
+    DiResampleTemplate(const DiResampleFilter &xFilter,
+                       const DiResampleFilter &yFilter,
+                       const Uint16 srcRows,
+                       const Uint16 destCols,
+                       const Uint16 destRows,
+                       const double minValue,
+                       const double maxValue)
+      : XFilter(xFilter),
+        YFilter(yFilter),
+        SrcRows(srcRows),
+        DestCols(destCols),
+        DestRows(destRows),
+        MinValue(minValue),
+        MaxValue(maxValue),
+        UseFixedPoint((sizeof(T) <= 2) && (maxValue - minValue < 65536.0)),
+        MinFixed(UseFixedPoint ? OFstatic_cast(Sint32, minValue) : 0),
+        MaxFixed(UseFixedPoint ? OFstatic_cast(Sint32, maxValue) : 0),
+        Temp(new T[OFstatic_cast(unsigned long, srcRows) * OFstatic_cast(unsigned long, destCols)])
+    {
+    }
+
+    /** destructor
+     */
+    virtual ~DiResampleTemplate()
+    {
+        delete[] Temp;
+    }
+
+    /** resample a single plane
+     *
+     ** @param  src       pointer to the first pixel of the source area
+     *  @param  stride    number of pixels between two rows of the source image
+     *  @param  dest      pointer to the destination image (DestCols * DestRows pixels)
+     *  @param  parallel  process rows in parallel if true (see DiStripeTask)
+     */
+    void resample(const T *src,
+                  const unsigned long stride,
+                  T *dest,
+                  const OFBool parallel)
+    {
+        const unsigned long minRows = (DestCols > 0) ? (DiStripeTask::MinPixelStripe + DestCols - 1) / DestCols : 1;
+        RowTask rows(*this, src, stride);
+        ColumnTask columns(*this, dest);
+        if (parallel)
+        {
+            rows.run(SrcRows, minRows);
+            columns.run(DestRows, minRows);
+        } else {
+            rows.processStripe(0, SrcRows);
+            columns.processStripe(0, DestRows);
+        }
+    }
+
+
+ private:
+
+    /** resample source rows to the temporary buffer (first pass)
+     *
+     ** @param  src     pointer to the first pixel of the source area
+     *  @param  stride  number of pixels between two rows of the source image
+     *  @param  start   index of the first source row to be resampled
+     *  @param  count   number of source rows to be resampled
+     *  @param  type    dummy parameter selecting the type of the weights (fixed or floating point)
+     */
+    template<class W>
+    void resampleRows(const T *src,
+                      const unsigned long stride,
+                      const unsigned long start,
+                      const unsigned long count,
+                      const W *type) const
+    {
+        for (unsigned long y = start; y < start + count; ++y)
+        {
+            const T *s = src + y * stride;
+            T *t = Temp + y * DestCols;
+            for (Uint16 x = 0; x < DestCols; ++x)
+            {
+                const T *p = s + XFilter.getStart(x);
+                const W *w = getWeights(XFilter, x, type);
+                W sum = 0;
+                for (unsigned long k = XFilter.getCount(x); k != 0; --k)
+                    sum += OFstatic_cast(W, *(p++)) * *(w++);
+                t[x] = clipValue(sum);
+            }
+        }
+    }
+
+    /** resample columns of the temporary buffer to the destination image (second pass).
+     *  The inner loop runs along the rows, so that the compiler can vectorize it.
+     *
+     ** @param  dest   pointer to the destination image
+     *  @param  start  index of the first destination row to be computed
+     *  @param  count  number of destination rows to be computed
+     *  @param  type   dummy parameter selecting the type of the weights (fixed or floating point)
+     */
+    template<class W>
+    void resampleColumns(T *dest,
+                         const unsigned long start,
+                         const unsigned long count,
+                         const W *type) const
+    {
+        W *sum = new W[DestCols];
+        for (unsigned long y = start; y < start + count; ++y)
+        {
+            const T *t = Temp + YFilter.getStart(y) * DestCols;
+            const W *w = getWeights(YFilter, y, type);
+            Uint16 x;
+            for (x = 0; x < DestCols; ++x)
+                sum[x] = 0;
+            for (unsigned long k = YFilter.getCount(y); k != 0; --k, t += DestCols)
+            {
+                const W weight = *(w++);
+                for (x = 0; x < DestCols; ++x)
+                    sum[x] += OFstatic_cast(W, t[x]) * weight;
+            }
+            T *d = dest + y * DestCols;
+            for (x = 0; x < DestCols; ++x)
+                d[x] = clipValue(sum[x]);
+        }
+        delete[] sum;
+    }
+
+    /// get fixed point weights (for overload resolution)
+    static inline const Sint32 *getWeights(const DiResampleFilter &filter,
+                                           const unsigned long pos,
+                                           const Sint32 *)
+    {
+        return filter.getFixedWeights(pos);
+    }
+
+    /// get floating point weights (for overload resolution)
+    static inline const double *getWeights(const DiResampleFilter &filter,
+                                           const unsigned long pos,
+                                           const double *)
+    {
+        return filter.getWeights(pos);
+    }
+
+    /// round fixed point value and clip it to the pixel value range
+    inline T clipValue(const Sint32 sum) const
+    {
+        /* right shift of negative values is arithmetic on all supported platforms */
+        const Sint32 value = (sum + (1 << (DiResampleFilter::FixedPointBits - 1))) >> DiResampleFilter::FixedPointBits;
+        return (value < MinFixed) ? OFstatic_cast(T, MinFixed) : (value > MaxFixed) ? OFstatic_cast(T, MaxFixed) : OFstatic_cast(T, value);
+    }
+
+    /// round floating point value and clip it to the pixel value range
+    inline T clipValue(const double sum) const
+    {
+        const double value = floor(sum + 0.5);
+        return (value < MinValue) ? OFstatic_cast(T, MinValue) : (value > MaxValue) ? OFstatic_cast(T, MaxValue) : OFstatic_cast(T, value);
+    }
+
+    /** Helper class resampling a stripe of source rows (first pass)
+     */
+    class RowTask
+      : public DiStripeTask
+    {
+
+     public:
+
+        RowTask(const DiResampleTemplate<T> &resample,
+                const T *src,
+                const unsigned long stride)
+          : Resample(resample),
+            Source(src),
+            Stride(stride)
+        {
+        }
+
+        virtual void processStripe(const unsigned long start,
+                                   const unsigned long count)
+        {
+            if (Resample.UseFixedPoint)
+                Resample.resampleRows(Source, Stride, start, count, OFstatic_cast(const Sint32 *, NULL));
+            else
+                Resample.resampleRows(Source, Stride, start, count, OFstatic_cast(const double *, NULL));
+        }
+
+     private:
+
+        const DiResampleTemplate<T> &Resample;
+        const T *Source;
+        const unsigned long Stride;
+
+     // --- declarations to avoid compiler warnings
+
+        RowTask(const RowTask &);
+        RowTask &operator=(const RowTask &);
+    };
+
+    /** Helper class resampling a stripe of destination rows (second pass)
+     */
+    class ColumnTask
+      : public DiStripeTask
+    {
+
+     public:
+
+        ColumnTask(const DiResampleTemplate<T> &resample,
+                   T *dest)
+          : Resample(resample),
+            Dest(dest)
+        {
+        }
+
+        virtual void processStripe(const unsigned long start,
+                                   const unsigned long count)
+        {
+            if (Resample.UseFixedPoint)
+                Resample.resampleColumns(Dest, start, count, OFstatic_cast(const Sint32 *, NULL));
+            else
+                Resample.resampleColumns(Dest, start, count, OFstatic_cast(const double *, NULL));
+        }
+
+     private:
+
+        const DiResampleTemplate<T> &Resample;
+        T *Dest;
+
+     // --- declarations to avoid compiler warnings
+
+        ColumnTask(const ColumnTask &);
+        ColumnTask &operator=(const ColumnTask &);
+    };
+
+    /// filter weights for the rows
+    const DiResampleFilter &XFilter;
+    /// filter weights for the columns
+    const DiResampleFilter &YFilter;
+    /// number of source rows
+    const Uint16 SrcRows;
+    /// number of destination columns
+    const Uint16 DestCols;
+    /// number of destination rows
+    const Uint16 DestRows;
+    /// minimum pixel value
+    const double MinValue;
+    /// maximum pixel value
+    const double MaxValue;
+    /// use fixed point arithmetic (for pixel values up to 16 bits)
+    const OFBool UseFixedPoint;
+    /// minimum pixel value (fixed point arithmetic)
+    const Sint32 MinFixed;
+    /// maximum pixel value (fixed point arithmetic)
+    const Sint32 MaxFixed;
+    /// temporary buffer storing the resampled source rows (SrcRows * DestCols pixels)
+    T *Temp;
+
+ // --- declarations to avoid compiler warnings
+
+    DiResampleTemplate(const DiResampleTemplate<T> &);
+    DiResampleTemplate<T> &operator=(const DiResampleTemplate<T> &);
+};
+
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: DicomSIMD (Header)
+ *
+ */
+
+
+#ifndef DISIMD_H
+#define DISIMD_H
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/ofstd/oftypes.h"
+#include "dcmtk/dcmimgle/didefine.h"
+
+
+/*---------------------*
+ *  class declaration  *
+ *---------------------*/
+
+/** Class providing vectorized (SIMD) implementations of the inner loops used
+ *  for rendering monochrome images.
+ *  The instruction set (SSE2 or AVX2 on x86 processors) is selected at runtime
+ *  depending on the capabilities of the CPU. All methods produce exactly the
+ *  same output as the corresponding scalar code. They return false for data
+ *  types and processors that are not supported, in which case the caller has
+ *  to use its scalar implementation.
+ */
+class DCMTK_DCMIMGLE_EXPORT DiSIMD
+{
+
+ public:
+
+    /** instruction sets that can be used
+     */
+    enum E_InstructionSet
+    {
+        /// no vector instructions, scalar code only
+        IS_None = 0,
+        /// SSE2 (128 bit vectors)
+        IS_SSE2 = 1,
+        /// AVX2 (256 bit vectors)
+        IS_AVX2 = 2
+    };
+
+    /** parameters of a linear transformation with clipping:
+     *  output = (input <= LowerBorder) ? LowValue :
+     *           (input > UpperBorder) ? HighValue :
+     *           Offset + (input - Shift) * Gradient
+     *  where the last expression is truncated to an integer value.
+     */
+    struct DCMTK_DCMIMGLE_EXPORT LinearTransformation
+    {
+        /// input values less than or equal to this border are mapped to LowValue
+        double LowerBorder;
+        /// input values greater than this border are mapped to HighValue
+        double UpperBorder;
+        /// value subtracted from the input value
+        double Shift;
+        /// factor the shifted input value is multiplied with
+        double Gradient;
+        /// value added to the product
+        double Offset;
+        /// output value for input values below the window
+        double LowValue;
+        /// output value for input values above the window
+        double HighValue;
+    };
+
+    /** number of additional entries that have to be allocated at the end of
+     *  a lookup table passed to lookupTable(), since vector instructions may
+     *  read a few bytes beyond the last entry
+     */
+    static const unsigned long LUTPadding;
+
+    /** get instruction set currently used by the methods of this class
+     *
+     ** @return instruction set
+     */
+    static E_InstructionSet getInstructionSet();
+
+    /** get most powerful instruction set supported by the CPU (and this build)
+     *
+     ** @return instruction set
+     */
+    static E_InstructionSet getSupportedInstructionSet();
+
+    /** limit the instruction set used by the methods of this class, e.g.\ in
+     *  order to compare the vectorized and the scalar implementation. The
+     *  instruction set is never set to a value beyond the supported one.
+     *  This method is not thread-safe and should be called before any images
+     *  are rendered.
+     *
+     ** @param  set  instruction set to be used (IS_None = scalar code only)
+     */
+    static void setInstructionSet(const E_InstructionSet set);
+
+    /** get name of an instruction set
+     *
+     ** @param  set  instruction set
+     *
+     ** @return name of the instruction set, e.g. "AVX2"
+     */
+    static const char *getInstructionSetName(const E_InstructionSet set);
+
+    /** apply a linear transformation with clipping to the given pixel data.
+     *  Generic version for unsupported data types, always returns false.
+     *
+     ** @param  src    pointer to input pixel data
+     *  @param  dst    pointer to output pixel data
+     *  @param  count  number of pixels to be processed
+     *  @param  trans  parameters of the transformation. The result of the
+     *                 transformation must fit into the output data type.
+     *
+     ** @return true if the pixel data has been processed, false otherwise
+     */
+    template<class T1, class T3>
+    static inline int linearTransformation(const T1 * /* src */,
+                                           T3 * /* dst */,
+                                           const unsigned long /* count */,
+                                           const LinearTransformation & /* trans */)
+    {
+        return 0;
+    }
+
+    /** apply a lookup table to the given pixel data, i.e.\ output = lut[input - offset].
+     *  Generic version for unsupported data types, always returns false.
+     *
+     ** @param  src     pointer to input pixel data
+     *  @param  dst     pointer to output pixel data
+     *  @param  count   number of pixels to be processed
+     *  @param  lut     lookup table, must contain LUTPadding entries after the last entry
+     *  @param  offset  value subtracted from the input value to get the LUT index
+     *
+     ** @return true if the pixel data has been processed, false otherwise
+     */
+    template<class T1, class T3>
+    static inline int lookupTable(const T1 * /* src */,
+                                  T3 * /* dst */,
+                                  const unsigned long /* count */,
+                                  const T3 * /* lut */,
+                                  const Sint32 /* offset */)
+    {
+        return 0;
+    }
+
+    // --- supported data types for linearTransformation()
+
+    static int linearTransformation(const Uint8 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Sint8 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Uint16 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Sint16 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Sint32 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Uint8 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Sint8 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Uint16 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Sint16 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans);
+    static int linearTransformation(const Sint32 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans);
+
+    // --- supported data types for lookupTable()
+
+    static int lookupTable(const Uint8 *src, Uint8 *dst, const unsigned long count, const Uint8 *lut, const Sint32 offset);
+    static int lookupTable(const Sint8 *src, Uint8 *dst, const unsigned long count, const Uint8 *lut, const Sint32 offset);
+    static int lookupTable(const Uint16 *src, Uint8 *dst, const unsigned long count, const Uint8 *lut, const Sint32 offset);
+    static int lookupTable(const Sint16 *src, Uint8 *dst, const unsigned long count, const Uint8 *lut, const Sint32 offset);
+    static int lookupTable(const Uint8 *src, Uint16 *dst, const unsigned long count, const Uint16 *lut, const Sint32 offset);
+    static int lookupTable(const Sint8 *src, Uint16 *dst, const unsigned long count, const Uint16 *lut, const Sint32 offset);
+    static int lookupTable(const Uint16 *src, Uint16 *dst, const unsigned long count, const Uint16 *lut, const Sint32 offset);
+    static int lookupTable(const Sint16 *src, Uint16 *dst, const unsigned long count, const Uint16 *lut, const Sint32 offset);
+};
+
+
+#endif
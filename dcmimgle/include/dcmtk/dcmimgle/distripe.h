@@ -0,0 +1,327 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: DicomStripeTask (Header)
+ *
+ */
+
+
+#ifndef DISTRIPE_H
+#define DISTRIPE_H
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/ofstd/ofcast.h"
+#include "dcmtk/dcmimgle/didefine.h"
+#include "dcmtk/dcmimgle/disimd.h"
+
+
+/*---------------------*
+ *  class declaration  *
+ *---------------------*/
+
+/** Abstract base class for operations on pixel data that can be split into
+ *  independent stripes (e.g. ranges of pixels, rows or frames), which are
+ *  then processed by multiple threads. The number of threads is specified
+ *  globally by DicomImageClass::setNumberOfThreads(). By default, or if
+ *  DCMTK is compiled without thread support, all stripes are processed
+ *  sequentially by the calling thread.
+ */
+class DCMTK_DCMIMGLE_EXPORT DiStripeTask
+{
+
+ public:
+
+    /** constructor
+     */
+    DiStripeTask();
+
+    /** destructor
+     */
+    virtual ~DiStripeTask();
+
+    /** process a stripe of the data. This method is called concurrently for
+     *  disjoint stripes, i.e. it must not modify data outside the stripe.
+     *
+     ** @param  start  index of the first unit (e.g. pixel, row or frame) of the stripe
+     *  @param  count  number of units in the stripe
+     */
+    virtual void processStripe(const unsigned long start,
+                               const unsigned long count) = 0;
+
+    /** split the data into stripes and process them
+     *
+     ** @param  total      total number of units to be processed
+     *  @param  minStripe  minimum number of units per stripe. Used to avoid the
+     *                     overhead of creating threads for small amounts of data.
+     */
+    void run(const unsigned long total,
+             const unsigned long minStripe);
+
+    /** get number of stripes that are processed concurrently for the given
+     *  amount of data, i.e.\ the number of threads that are used by run()
+     *
+     ** @param  total      total number of units to be processed
+     *  @param  minStripe  minimum number of units per stripe
+     *
+     ** @return number of stripes (at least 1)
+     */
+    static unsigned long getNumberOfStripes(const unsigned long total,
+                                            const unsigned long minStripe);
+
+    /// minimum number of pixels per stripe for simple per-pixel operations
+    static const unsigned long MinPixelStripe;
+
+
+ private:
+
+    // --- declarations to avoid compiler warnings
+
+    DiStripeTask(const DiStripeTask &);
+    DiStripeTask &operator=(const DiStripeTask &);
+};
+
+
+/** Template class applying a function object to each pixel of a buffer,
+ *  i.e.\ dest[i] = func(src[i]). The function object must be thread-safe.
+ *  Source and destination buffer may be identical but must not overlap otherwise.
+ */
+template<class T1, class T2, class F>
+class DiPixelStripeTask
+  : public DiStripeTask
+{
+
+ public:
+
+    /** constructor
+     *
+     ** @param  src   pointer to source pixel data
+     *  @param  dest  pointer to destination pixel data
+     *  @param  func  function object converting a single pixel value
+     */
+    DiPixelStripeTask(const T1 *src,
+                      T2 *dest,
+                      const F &func)
+      : Source(src),
+        Dest(dest),
+        Function(func)
+    {
+    }
+
+    /** process a stripe of pixels
+     *
+     ** @param  start  index of the first pixel of the stripe
+     *  @param  count  number of pixels in the stripe
+     */
+    virtual void processStripe(const unsigned long start,
+                               const unsigned long count)
+    {
+        const T1 *p = Source + start;
+        T2 *q = Dest + start;
+        for (unsigned long i = count; i != 0; --i)
+            *(q++) = Function(*(p++));
+    }
+
+    /** apply the function object to the given number of pixels
+     *
+     ** @param  src    pointer to source pixel data
+     *  @param  dest   pointer to destination pixel data
+     *  @param  count  number of pixels to be processed
+     *  @param  func   function object converting a single pixel value
+     */
+    static void apply(const T1 *src,
+                      T2 *dest,
+                      const unsigned long count,
+                      const F &func)
+    {
+        DiPixelStripeTask<T1, T2, F> task(src, dest, func);
+        task.run(count, MinPixelStripe);
+    }
+
+
+ private:
+
+    /// pointer to source pixel data
+    const T1 *Source;
+    /// pointer to destination pixel data
+    T2 *Dest;
+    /// function object converting a single pixel value
+    const F Function;
+};
+
+
+/** Template class applying a lookup table to each pixel of a buffer,
+ *  i.e.\ dest[i] = lut[src[i] - offset]. Uses vector instructions if supported.
+ */
+template<class T1, class T3>
+class DiLookupStripeTask
+  : public DiStripeTask
+{
+
+ public:
+
+    /** constructor
+     *
+     ** @param  src     pointer to source pixel data
+     *  @param  dest    pointer to destination pixel data
+     *  @param  lut     lookup table, must contain DiSIMD::LUTPadding entries after the last entry
+     *  @param  offset  value subtracted from the pixel value to get the LUT index
+     */
+    DiLookupStripeTask(const T1 *src,
+                       T3 *dest,
+                       const T3 *lut,
+                       const Sint32 offset)
+      : Source(src),
+        Dest(dest),
+        Table(lut),
+        Offset(offset)
+    {
+    }
+
+    /** process a stripe of pixels
+     *
+     ** @param  start  index of the first pixel of the stripe
+     *  @param  count  number of pixels in the stripe
+     */
+    virtual void processStripe(const unsigned long start,
+                               const unsigned long count)
+    {
+        const T1 *p = Source + start;
+        T3 *q = Dest + start;
+        if (!DiSIMD::lookupTable(p, q, count, Table, Offset))
+        {
+            const T3 *lut0 = Table - Offset;                                  // points to 'zero' entry
+            for (unsigned long i = count; i != 0; --i)
+                *(q++) = *(lut0 + (*(p++)));
+        }
+    }
+
+    /** apply the lookup table to the given number of pixels
+     *
+     ** @param  src     pointer to source pixel data
+     *  @param  dest    pointer to destination pixel data
+     *  @param  count   number of pixels to be processed
+     *  @param  lut     lookup table, must contain DiSIMD::LUTPadding entries after the last entry
+     *  @param  offset  value subtracted from the pixel value to get the LUT index
+     */
+    static void apply(const T1 *src,
+                      T3 *dest,
+                      const unsigned long count,
+                      const T3 *lut,
+                      const Sint32 offset)
+    {
+        DiLookupStripeTask<T1, T3> task(src, dest, lut, offset);
+        task.run(count, MinPixelStripe);
+    }
+
+
+ private:
+
+    /// pointer to source pixel data
+    const T1 *Source;
+    /// pointer to destination pixel data
+    T3 *Dest;
+    /// lookup table
+    const T3 *Table;
+    /// value subtracted from the pixel value to get the LUT index
+    const Sint32 Offset;
+};
+
+
+/** Template class applying a linear transformation with clipping (see
+ *  DiSIMD::LinearTransformation) to each pixel of a buffer. Uses vector
+ *  instructions if supported.
+ */
+template<class T1, class T3>
+class DiLinearStripeTask
+  : public DiStripeTask
+{
+
+ public:
+
+    /** constructor
+     *
+     ** @param  src    pointer to source pixel data
+     *  @param  dest   pointer to destination pixel data
+     *  @param  trans  parameters of the transformation
+     */
+    DiLinearStripeTask(const T1 *src,
+                       T3 *dest,
+                       const DiSIMD::LinearTransformation &trans)
+      : Source(src),
+        Dest(dest),
+        Trans(trans)
+    {
+    }
+
+    /** process a stripe of pixels
+     *
+     ** @param  start  index of the first pixel of the stripe
+     *  @param  count  number of pixels in the stripe
+     */
+    virtual void processStripe(const unsigned long start,
+                               const unsigned long count)
+    {
+        const T1 *p = Source + start;
+        T3 *q = Dest + start;
+        if (!DiSIMD::linearTransformation(p, q, count, Trans))
+        {
+            const T3 low = OFstatic_cast(T3, Trans.LowValue);
+            const T3 high = OFstatic_cast(T3, Trans.HighValue);
+            double value;
+            for (unsigned long i = count; i != 0; --i)
+            {
+                value = OFstatic_cast(double, *(p++));
+                if (value <= Trans.LowerBorder)
+                    *(q++) = low;
+                else if (value > Trans.UpperBorder)
+                    *(q++) = high;
+                else
+                    *(q++) = OFstatic_cast(T3, Trans.Offset + (value - Trans.Shift) * Trans.Gradient);
+            }
+        }
+    }
+
+    /** apply the linear transformation to the given number of pixels
+     *
+     ** @param  src    pointer to source pixel data
+     *  @param  dest   pointer to destination pixel data
+     *  @param  count  number of pixels to be processed
+     *  @param  trans  parameters of the transformation
+     */
+    static void apply(const T1 *src,
+                      T3 *dest,
+                      const unsigned long count,
+                      const DiSIMD::LinearTransformation &trans)
+    {
+        DiLinearStripeTask<T1, T3> task(src, dest, trans);
+        task.run(count, MinPixelStripe);
+    }
+
+
+ private:
+
+    /// pointer to source pixel data
+    const T1 *Source;
+    /// pointer to destination pixel data
+    T3 *Dest;
+    /// parameters of the transformation
+    const DiSIMD::LinearTransformation Trans;
+};
+
+
+#endif
@@ -460,6 +460,23 @@ class DCMTK_DCMIMGLE_EXPORT DicomImageClass
     static EP_Representation determineRepresentation(double minvalue,
                                                      double maxvalue);
 
+    /** set number of threads used for processing the pixel data of large images,
+     *  i.e.\ input pixel conversion, modality and VOI transformation as well as
+     *  scaling. The pixel data is split into stripes of pixels or frames that are
+     *  processed concurrently, small images are always processed by a single thread.
+     *  This setting is global and should not be changed while images are rendered.
+     *  It has no effect if DCMTK is compiled without thread support.
+     *
+     ** @param  threads  number of threads (default: 1, i.e. no additional threads)
+     */
+    static void setNumberOfThreads(const unsigned int threads);
+
+    /** get number of threads used for processing the pixel data of large images
+     *
+     ** @return number of threads (at least 1)
+     */
+    static unsigned int getNumberOfThreads();
+
 };
 
 
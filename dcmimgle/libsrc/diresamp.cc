@@ -0,0 +1,141 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: DicomResampleFilter (Source)
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/dcmimgle/diresamp.h"
+
+#include <cmath>
+
+
+/*--------------------*
+ *  helper functions  *
+ *--------------------*/
+
+static inline double sinc(const double x)
+{
+    if (x == 0.0)
+        return 1.0;
+    const double px = 3.14159265358979323846 * x;
+    return sin(px) / px;
+}
+
+
+/*----------------*
+ *  constructors  *
+ *----------------*/
+
+const int DiResampleFilter::FixedPointBits = 14;
+
+
+DiResampleFilter::DiResampleFilter(const Uint16 srcSize,
+                                   const Uint16 destSize,
+                                   const E_Filter filter)
+  : MaxCount(0),
+    Start(NULL),
+    Count(NULL),
+    Weights(NULL),
+    FixedWeights(NULL)
+{
+    if ((srcSize > 0) && (destSize > 0))
+    {
+        /* the filter is stretched when reducing the image (anti-aliasing) */
+        const double scale = OFstatic_cast(double, srcSize) / OFstatic_cast(double, destSize);
+        const double filterScale = (scale > 1.0) ? scale : 1.0;
+        const double support = ((filter == F_Lanczos3) ? 3.0 : 0.5) * filterScale;
+        MaxCount = OFstatic_cast(unsigned long, ceil(support)) * 2 + 1;
+        Start = new unsigned long[destSize];
+        Count = new unsigned long[destSize];
+        Weights = new double[OFstatic_cast(unsigned long, destSize) * MaxCount];
+        FixedWeights = new Sint32[OFstatic_cast(unsigned long, destSize) * MaxCount];
+        const Sint32 one = OFstatic_cast(Sint32, 1) << FixedPointBits;
+        for (unsigned long i = 0; i < destSize; ++i)
+        {
+            /* range of source pixels covered by the filter (pixel centers are at x + 0.5) */
+            const double center = (OFstatic_cast(double, i) + 0.5) * scale;
+            double first = floor(center - support);
+            double last = ceil(center + support);
+            if (first < 0)
+                first = 0;
+            if (last > srcSize)
+                last = srcSize;
+            unsigned long start = OFstatic_cast(unsigned long, first);
+            unsigned long count = OFstatic_cast(unsigned long, last) - start;
+            if (count > MaxCount)
+                count = MaxCount;
+            double *w = Weights + i * MaxCount;
+            double total = 0;
+            unsigned long k;
+            for (k = 0; k < count; ++k)
+            {
+                const double pos = OFstatic_cast(double, start + k);
+                if (filter == F_Lanczos3)
+                {
+                    const double x = (pos + 0.5 - center) / filterScale;
+                    w[k] = (x > -3.0 && x < 3.0) ? sinc(x) * sinc(x / 3.0) : 0.0;
+                } else {
+                    /* area of the source pixel covered by the (stretched) box */
+                    const double left = (pos > center - support) ? pos : center - support;
+                    const double right = (pos + 1 < center + support) ? pos + 1 : center + support;
+                    w[k] = (right > left) ? right - left : 0.0;
+                }
+                total += w[k];
+            }
+            /* remove source pixels without contribution at both ends */
+            while ((count > 1) && (w[count - 1] == 0.0))
+                --count;
+            while ((count > 1) && (w[0] == 0.0))
+            {
+                for (k = 1; k < count; ++k)
+                    w[k - 1] = w[k];
+                ++start;
+                --count;
+            }
+            /* normalize weights and convert them to fixed point values */
+            Sint32 *fw = FixedWeights + i * MaxCount;
+            Sint32 fixedTotal = 0;
+            unsigned long maxPos = 0;
+            for (k = 0; k < count; ++k)
+            {
+                if (total != 0.0)
+                    w[k] /= total;
+                fw[k] = OFstatic_cast(Sint32, floor(w[k] * one + 0.5));
+                fixedTotal += fw[k];
+                if (w[k] > w[maxPos])
+                    maxPos = k;
+            }
+            /* make sure that the sum of the weights is exactly one, i.e. constant areas remain unchanged */
+            fw[maxPos] += one - fixedTotal;
+            Start[i] = start;
+            Count[i] = count;
+        }
+    }
+}
+
+
+DiResampleFilter::~DiResampleFilter()
+{
+    delete[] Start;
+    delete[] Count;
+    delete[] Weights;
+    delete[] FixedWeights;
+}
@@ -0,0 +1,536 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: DicomSIMD (Source)
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/ofstd/ofcast.h"
+#include "dcmtk/dcmimgle/disimd.h"
+
+#include <cstring>
+
+/*
+ *  The vectorized code is compiled with function specific target attributes,
+ *  i.e. no special compiler options are needed and the library still runs on
+ *  processors without these instruction set extensions.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))))
+#define DISIMD_X86
+#define DISIMD_GNUC
+#define DISIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define DISIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (_MSC_VER >= 1800) && (defined(_M_X64) || defined(_M_IX86))
+#define DISIMD_X86
+#define DISIMD_MSC
+#define DISIMD_TARGET_SSE2
+#define DISIMD_TARGET_AVX2
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+/*------------------------*
+ *  instruction set selection  *
+ *------------------------*/
+
+static DiSIMD::E_InstructionSet detectInstructionSet()
+{
+#if defined(DISIMD_GNUC)
+    __builtin_cpu_init();
+    /* also checks whether the operating system saves the AVX registers */
+    if (__builtin_cpu_supports("avx2"))
+        return DiSIMD::IS_AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return DiSIMD::IS_SSE2;
+#elif defined(DISIMD_MSC)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const int sse2 = (info[3] & (1 << 26)) != 0;
+    const int osxsave = (info[2] & (1 << 27)) != 0;
+    const int avx = (info[2] & (1 << 28)) != 0;
+    if (osxsave && avx && (maxLeaf >= 7) && ((_xgetbv(0) & 6) == 6))
+    {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5))
+            return DiSIMD::IS_AVX2;
+    }
+    if (sse2)
+        return DiSIMD::IS_SSE2;
+#endif
+    return DiSIMD::IS_None;
+}
+
+static const DiSIMD::E_InstructionSet SupportedInstructionSet = detectInstructionSet();
+static DiSIMD::E_InstructionSet CurrentInstructionSet = SupportedInstructionSet;
+
+const unsigned long DiSIMD::LUTPadding = 4;
+
+
+DiSIMD::E_InstructionSet DiSIMD::getInstructionSet()
+{
+    return CurrentInstructionSet;
+}
+
+
+DiSIMD::E_InstructionSet DiSIMD::getSupportedInstructionSet()
+{
+    return SupportedInstructionSet;
+}
+
+
+void DiSIMD::setInstructionSet(const E_InstructionSet set)
+{
+    CurrentInstructionSet = (set < SupportedInstructionSet) ? set : SupportedInstructionSet;
+}
+
+
+const char *DiSIMD::getInstructionSetName(const E_InstructionSet set)
+{
+    switch (set)
+    {
+        case IS_SSE2:
+            return "SSE2";
+        case IS_AVX2:
+            return "AVX2";
+        default:
+            return "none";
+    }
+}
+
+
+/*------------------*
+ *  scalar versions  *
+ *------------------*/
+
+/* used for the remaining pixels that do not fill a complete vector */
+
+template<class T1, class T3>
+static void linearTransformationScalar(const T1 *src,
+                                       T3 *dst,
+                                       const unsigned long count,
+                                       const DiSIMD::LinearTransformation &trans)
+{
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        const double value = OFstatic_cast(double, src[i]);
+        if (value <= trans.LowerBorder)
+            dst[i] = OFstatic_cast(T3, trans.LowValue);
+        else if (value > trans.UpperBorder)
+            dst[i] = OFstatic_cast(T3, trans.HighValue);
+        else
+            dst[i] = OFstatic_cast(T3, trans.Offset + (value - trans.Shift) * trans.Gradient);
+    }
+}
+
+
+template<class T1, class T3>
+static void lookupTableScalar(const T1 *src,
+                              T3 *dst,
+                              const unsigned long count,
+                              const T3 *lut,
+                              const Sint32 offset)
+{
+    for (unsigned long i = 0; i < count; ++i)
+        dst[i] = lut[OFstatic_cast(Sint32, src[i]) - offset];
+}
+
+
+#ifdef DISIMD_X86
+
+/* clipping can be skipped if the borders are outside the range of the input values */
+
+static inline int needsClipping(const DiSIMD::LinearTransformation &trans)
+{
+    return (trans.LowerBorder >= -2147483648.0) || (trans.UpperBorder < 2147483647.0);
+}
+
+
+/*----------------*
+ *  SSE2 versions  *
+ *----------------*/
+
+/* load four pixels and convert them to 32-bit integers */
+
+DISIMD_TARGET_SSE2 static inline __m128i loadSSE2(const Uint8 *src)
+{
+    int value;
+    memcpy(&value, src, sizeof(value));
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero);
+}
+
+DISIMD_TARGET_SSE2 static inline __m128i loadSSE2(const Sint8 *src)
+{
+    int value;
+    memcpy(&value, src, sizeof(value));
+    __m128i v = _mm_cvtsi32_si128(value);
+    v = _mm_unpacklo_epi8(v, v);
+    return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 24);
+}
+
+DISIMD_TARGET_SSE2 static inline __m128i loadSSE2(const Uint16 *src)
+{
+    return _mm_unpacklo_epi16(_mm_loadl_epi64(OFreinterpret_cast(const __m128i *, src)), _mm_setzero_si128());
+}
+
+DISIMD_TARGET_SSE2 static inline __m128i loadSSE2(const Sint16 *src)
+{
+    const __m128i v = _mm_loadl_epi64(OFreinterpret_cast(const __m128i *, src));
+    return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+DISIMD_TARGET_SSE2 static inline __m128i loadSSE2(const Sint32 *src)
+{
+    return _mm_loadu_si128(OFreinterpret_cast(const __m128i *, src));
+}
+
+/* store four 32-bit integers that fit into the output data type */
+
+DISIMD_TARGET_SSE2 static inline void storeSSE2(Uint8 *dst, __m128i v)
+{
+    v = _mm_packs_epi32(v, v);
+    const int value = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+    memcpy(dst, &value, sizeof(value));
+}
+
+DISIMD_TARGET_SSE2 static inline void storeSSE2(Uint16 *dst, __m128i v)
+{
+    /* SSE2 has no unsigned saturation from 32 to 16 bit, so move the values
+     * into the signed range and back again
+     */
+    v = _mm_packs_epi32(_mm_sub_epi32(v, _mm_set1_epi32(0x8000)), _mm_setzero_si128());
+    v = _mm_xor_si128(v, _mm_set1_epi16(OFstatic_cast(short, 0x8000)));
+    _mm_storel_epi64(OFreinterpret_cast(__m128i *, dst), v);
+}
+
+DISIMD_TARGET_SSE2 static inline __m128d transformSSE2(const __m128d value,
+                                                       const __m128d lower,
+                                                       const __m128d upper,
+                                                       const __m128d shift,
+                                                       const __m128d gradient,
+                                                       const __m128d offset,
+                                                       const __m128d low,
+                                                       const __m128d high,
+                                                       const int clip)
+{
+    __m128d result = _mm_add_pd(offset, _mm_mul_pd(_mm_sub_pd(value, shift), gradient));
+    if (!clip)
+        return result;
+    const __m128d above = _mm_cmpgt_pd(value, upper);
+    result = _mm_or_pd(_mm_and_pd(above, high), _mm_andnot_pd(above, result));
+    const __m128d below = _mm_cmple_pd(value, lower);
+    return _mm_or_pd(_mm_and_pd(below, low), _mm_andnot_pd(below, result));
+}
+
+template<class T1, class T3>
+DISIMD_TARGET_SSE2 static void linearTransformationSSE2(const T1 *src,
+                                                        T3 *dst,
+                                                        const unsigned long count,
+                                                        const DiSIMD::LinearTransformation &trans)
+{
+    const __m128d lower = _mm_set1_pd(trans.LowerBorder);
+    const __m128d upper = _mm_set1_pd(trans.UpperBorder);
+    const __m128d shift = _mm_set1_pd(trans.Shift);
+    const __m128d gradient = _mm_set1_pd(trans.Gradient);
+    const __m128d offset = _mm_set1_pd(trans.Offset);
+    const __m128d low = _mm_set1_pd(trans.LowValue);
+    const __m128d high = _mm_set1_pd(trans.HighValue);
+    const int clip = needsClipping(trans);
+    unsigned long i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i v = loadSSE2(src + i);
+        const __m128d v0 = transformSSE2(_mm_cvtepi32_pd(v), lower, upper, shift, gradient, offset, low, high, clip);
+        const __m128d v1 = transformSSE2(_mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(3, 2, 3, 2))), lower, upper, shift, gradient, offset, low, high, clip);
+        storeSSE2(dst + i, _mm_unpacklo_epi64(_mm_cvttpd_epi32(v0), _mm_cvttpd_epi32(v1)));
+    }
+    linearTransformationScalar(src + i, dst + i, count - i, trans);
+}
+
+
+/*----------------*
+ *  AVX2 versions  *
+ *----------------*/
+
+/* load eight pixels and convert them to 32-bit integers */
+
+DISIMD_TARGET_AVX2 static inline __m256i loadAVX2(const Uint8 *src)
+{
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(OFreinterpret_cast(const __m128i *, src)));
+}
+
+DISIMD_TARGET_AVX2 static inline __m256i loadAVX2(const Sint8 *src)
+{
+    return _mm256_cvtepi8_epi32(_mm_loadl_epi64(OFreinterpret_cast(const __m128i *, src)));
+}
+
+DISIMD_TARGET_AVX2 static inline __m256i loadAVX2(const Uint16 *src)
+{
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(OFreinterpret_cast(const __m128i *, src)));
+}
+
+DISIMD_TARGET_AVX2 static inline __m256i loadAVX2(const Sint16 *src)
+{
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(OFreinterpret_cast(const __m128i *, src)));
+}
+
+DISIMD_TARGET_AVX2 static inline __m256i loadAVX2(const Sint32 *src)
+{
+    return _mm256_loadu_si256(OFreinterpret_cast(const __m256i *, src));
+}
+
+/* store eight 32-bit integers that fit into the output data type */
+
+DISIMD_TARGET_AVX2 static inline void storeAVX2(Uint8 *dst, __m256i v)
+{
+    /* collect the lowest byte of each value in the first four bytes of each 128-bit lane */
+    const __m256i shuffle = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                             0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, shuffle), _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1));
+    _mm_storel_epi64(OFreinterpret_cast(__m128i *, dst), _mm256_castsi256_si128(v));
+}
+
+DISIMD_TARGET_AVX2 static inline void storeAVX2(Uint16 *dst, __m256i v)
+{
+    /* pack within each 128-bit lane, then move the two results together */
+    v = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), 0x08);
+    _mm_storeu_si128(OFreinterpret_cast(__m128i *, dst), _mm256_castsi256_si128(v));
+}
+
+DISIMD_TARGET_AVX2 static inline __m128i transformAVX2(const __m256d value,
+                                                       const __m256d lower,
+                                                       const __m256d upper,
+                                                       const __m256d shift,
+                                                       const __m256d gradient,
+                                                       const __m256d offset,
+                                                       const __m256d low,
+                                                       const __m256d high,
+                                                       const int clip)
+{
+    /* separate multiplication and addition (no FMA), in order to get the same results as the scalar code */
+    __m256d result = _mm256_add_pd(offset, _mm256_mul_pd(_mm256_sub_pd(value, shift), gradient));
+    if (!clip)
+        return _mm256_cvttpd_epi32(result);
+    result = _mm256_blendv_pd(result, high, _mm256_cmp_pd(value, upper, _CMP_GT_OQ));
+    result = _mm256_blendv_pd(result, low, _mm256_cmp_pd(value, lower, _CMP_LE_OQ));
+    return _mm256_cvttpd_epi32(result);
+}
+
+template<class T1, class T3>
+DISIMD_TARGET_AVX2 static void linearTransformationAVX2(const T1 *src,
+                                                        T3 *dst,
+                                                        const unsigned long count,
+                                                        const DiSIMD::LinearTransformation &trans)
+{
+    const __m256d lower = _mm256_set1_pd(trans.LowerBorder);
+    const __m256d upper = _mm256_set1_pd(trans.UpperBorder);
+    const __m256d shift = _mm256_set1_pd(trans.Shift);
+    const __m256d gradient = _mm256_set1_pd(trans.Gradient);
+    const __m256d offset = _mm256_set1_pd(trans.Offset);
+    const __m256d low = _mm256_set1_pd(trans.LowValue);
+    const __m256d high = _mm256_set1_pd(trans.HighValue);
+    const int clip = needsClipping(trans);
+    unsigned long i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i v = loadAVX2(src + i);
+        const __m128i r0 = transformAVX2(_mm256_cvtepi32_pd(_mm256_castsi256_si128(v)), lower, upper, shift, gradient, offset, low, high, clip);
+        const __m128i r1 = transformAVX2(_mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)), lower, upper, shift, gradient, offset, low, high, clip);
+        storeAVX2(dst + i, _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1));
+    }
+    linearTransformationScalar(src + i, dst + i, count - i, trans);
+}
+
+template<class T1, class T3>
+DISIMD_TARGET_AVX2 static void lookupTableAVX2(const T1 *src,
+                                               T3 *dst,
+                                               const unsigned long count,
+                                               const T3 *lut,
+                                               const Sint32 offset)
+{
+    /* the gather instruction reads 32-bit values, i.e. up to three bytes
+     * beyond the addressed LUT entry, which are masked out afterwards
+     */
+    const __m256i shift = _mm256_set1_epi32(offset);
+    const __m256i mask = _mm256_set1_epi32((sizeof(T3) == 1) ? 0xff : 0xffff);
+    const int *base = OFreinterpret_cast(const int *, lut);
+    unsigned long i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i index = _mm256_sub_epi32(loadAVX2(src + i), shift);
+        storeAVX2(dst + i, _mm256_and_si256(_mm256_i32gather_epi32(base, index, sizeof(T3)), mask));
+    }
+    lookupTableScalar(src + i, dst + i, count - i, lut, offset);
+}
+
+#endif
+
+
+/*--------------*
+ *  dispatching  *
+ *--------------*/
+
+template<class T1, class T3>
+static int linearTransformationTemplate(const T1 *src,
+                                        T3 *dst,
+                                        const unsigned long count,
+                                        const DiSIMD::LinearTransformation &trans)
+{
+#ifdef DISIMD_X86
+    if (CurrentInstructionSet == DiSIMD::IS_AVX2)
+    {
+        linearTransformationAVX2(src, dst, count, trans);
+        return 1;
+    }
+    if (CurrentInstructionSet == DiSIMD::IS_SSE2)
+    {
+        linearTransformationSSE2(src, dst, count, trans);
+        return 1;
+    }
+#else
+    OFstatic_cast(void, src);
+    OFstatic_cast(void, dst);
+    OFstatic_cast(void, count);
+    OFstatic_cast(void, trans);
+#endif
+    return 0;
+}
+
+
+template<class T1, class T3>
+static int lookupTableTemplate(const T1 *src,
+                               T3 *dst,
+                               const unsigned long count,
+                               const T3 *lut,
+                               const Sint32 offset)
+{
+#ifdef DISIMD_X86
+    /* there is no gather instruction in SSE2 */
+    if (CurrentInstructionSet == DiSIMD::IS_AVX2)
+    {
+        lookupTableAVX2(src, dst, count, lut, offset);
+        return 1;
+    }
+#else
+    OFstatic_cast(void, src);
+    OFstatic_cast(void, dst);
+    OFstatic_cast(void, count);
+    OFstatic_cast(void, lut);
+    OFstatic_cast(void, offset);
+#endif
+    return 0;
+}
+
+
+int DiSIMD::linearTransformation(const Uint8 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Sint8 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Uint16 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Sint16 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Sint32 *src, Uint8 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Uint8 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Sint8 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Uint16 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Sint16 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+int DiSIMD::linearTransformation(const Sint32 *src, Uint16 *dst, const unsigned long count, const LinearTransformation &trans)
+{
+    return linearTransformationTemplate(src, dst, count, trans);
+}
+
+
+int DiSIMD::lookupTable(const Uint8 *src, Uint8 *dst, const unsigned long count, const Uint8 *lut, const Sint32 offset)
+{
+    return lookupTableTemplate(src, dst, count, lut, offset);
+}
+
+int DiSIMD::lookupTable(const Sint8 *src, Uint8 *dst, const unsigned long count, const Uint8 *lut, const Sint32 offset)
+{
+    return lookupTableTemplate(src, dst, count, lut, offset);
+}
+
+int DiSIMD::lookupTable(const Uint16 *src, Uint8 *dst, const unsigned long count, const Uint8 *lut, const Sint32 offset)
+{
+    return lookupTableTemplate(src, dst, count, lut, offset);
+}
+
+int DiSIMD::lookupTable(const Sint16 *src, Uint8 *dst, const unsigned long count, const Uint8 *lut, const Sint32 offset)
+{
+    return lookupTableTemplate(src, dst, count, lut, offset);
+}
+
+int DiSIMD::lookupTable(const Uint8 *src, Uint16 *dst, const unsigned long count, const Uint16 *lut, const Sint32 offset)
+{
+    return lookupTableTemplate(src, dst, count, lut, offset);
+}
+
+int DiSIMD::lookupTable(const Sint8 *src, Uint16 *dst, const unsigned long count, const Uint16 *lut, const Sint32 offset)
+{
+    return lookupTableTemplate(src, dst, count, lut, offset);
+}
+
+int DiSIMD::lookupTable(const Uint16 *src, Uint16 *dst, const unsigned long count, const Uint16 *lut, const Sint32 offset)
+{
+    return lookupTableTemplate(src, dst, count, lut, offset);
+}
+
+int DiSIMD::lookupTable(const Sint16 *src, Uint16 *dst, const unsigned long count, const Uint16 *lut, const Sint32 offset)
+{
+    return lookupTableTemplate(src, dst, count, lut, offset);
+}
@@ -0,0 +1,194 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmimgle
+ *
+ *  Author:  Joerg Riesmeier
+ *
+ *  Purpose: DicomStripeTask (Source)
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"
+
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/ofvector.h"
+
+#include "dcmtk/dcmimgle/distripe.h"
+#include "dcmtk/dcmimgle/diutils.h"
+
+
+/*----------------------------*
+ *  thread support (private)  *
+ *----------------------------*/
+
+#ifdef WITH_THREADS
+
+/* distributes the stripes of a task over the threads (first come, first served) */
+class DiStripeJob
+{
+
+ public:
+
+    DiStripeJob(DiStripeTask &task,
+                const unsigned long total,
+                const unsigned long stripes)
+      : Task(task),
+        Total(total),
+        Stripes(stripes),
+        NextStripe(0),
+        Mutex()
+    {
+    }
+
+    void process()
+    {
+        unsigned long stripe;
+        while (nextStripe(stripe))
+        {
+            /* distribute the remainder evenly over the first stripes */
+            const unsigned long size = Total / Stripes;
+            const unsigned long rest = Total % Stripes;
+            const unsigned long start = stripe * size + ((stripe < rest) ? stripe : rest);
+            const unsigned long count = size + ((stripe < rest) ? 1 : 0);
+            Task.processStripe(start, count);
+        }
+    }
+
+
+ private:
+
+    OFBool nextStripe(unsigned long &stripe)
+    {
+        OFBool result = OFFalse;
+        Mutex.lock();
+        if (NextStripe < Stripes)
+        {
+            stripe = NextStripe++;
+            result = OFTrue;
+        }
+        Mutex.unlock();
+        return result;
+    }
+
+    DiStripeTask &Task;
+    const unsigned long Total;
+    const unsigned long Stripes;
+    unsigned long NextStripe;
+    OFMutex Mutex;
+
+ // --- declarations to avoid compiler warnings
+
+    DiStripeJob(const DiStripeJob &);
+    DiStripeJob &operator=(const DiStripeJob &);
+};
+
+
+class DiStripeThread
+  : public OFThread
+{
+
+ public:
+
+    DiStripeThread(DiStripeJob &job)
+      : OFThread(),
+        Job(job)
+    {
+    }
+
+ protected:
+
+    virtual void run()
+    {
+        Job.process();
+    }
+
+ private:
+
+    DiStripeJob &Job;
+
+ // --- declarations to avoid compiler warnings
+
+    DiStripeThread(const DiStripeThread &);
+    DiStripeThread &operator=(const DiStripeThread &);
+};
+
+#endif
+
+
+/*----------------*
+ *  DiStripeTask  *
+ *----------------*/
+
+const unsigned long DiStripeTask::MinPixelStripe = 65536;
+
+
+DiStripeTask::DiStripeTask()
+{
+}
+
+
+DiStripeTask::~DiStripeTask()
+{
+}
+
+
+unsigned long DiStripeTask::getNumberOfStripes(const unsigned long total,
+                                               const unsigned long minStripe)
+{
+    unsigned long stripes = DicomImageClass::getNumberOfThreads();
+    if ((minStripe > 0) && (stripes > total / minStripe))
+        stripes = total / minStripe;
+    return (stripes > 1) ? stripes : 1;
+}
+
+
+void DiStripeTask::run(const unsigned long total,
+                       const unsigned long minStripe)
+{
+#ifdef WITH_THREADS
+    const unsigned long stripes = getNumberOfStripes(total, minStripe);
+    if (stripes > 1)
+    {
+        DCMIMGLE_TRACE("processing " << total << " units in " << stripes << " stripes");
+        DiStripeJob job(*this, total, stripes);
+        OFVector<DiStripeThread *> threads;
+        for (unsigned long i = 1; i < stripes; ++i)
+        {
+            DiStripeThread *thread = new DiStripeThread(job);
+            if (thread->start() == 0)
+                threads.push_back(thread);
+            else
+            {
+                /* the remaining stripes are processed by the threads started so far */
+                DCMIMGLE_WARN("cannot create thread, continuing with " << threads.size() + 1 << " threads");
+                delete thread;
+                break;
+            }
+        }
+        /* the calling thread also processes stripes */
+        job.process();
+        for (size_t j = 0; j < threads.size(); ++j)
+        {
+            threads[j]->join();
+            delete threads[j];
+        }
+        return;
+    }
+#else
+    OFstatic_cast(void, minStripe);
+#endif
+    if (total > 0)
+        processStripe(0, total);
+}
@@ -38,6 +38,9 @@
 
 OFLogger DCM_dcmimgleLogger = OFLog::getLogger("dcmtk.dcmimgle");
 
+/* number of threads used for processing pixel data */
+static unsigned int NumberOfThreads = 1;
+
 
 /*------------------------*
  *  function definitions  *
@@ -137,3 +140,19 @@ EP_Representation DicomImageClass::determineRepresentation(double minvalue,
 #endif
     return EPR_Uint32;
 }
+
+
+void DicomImageClass::setNumberOfThreads(const unsigned int threads)
+{
+#ifdef WITH_THREADS
+    NumberOfThreads = (threads > 1) ? threads : 1;
+#else
+    OFstatic_cast(void, threads);
+#endif
+}
+
+
+unsigned int DicomImageClass::getNumberOfThreads()
+{
+    return NumberOfThreads;
+}
@@ -134,7 +134,22 @@ OFCondition IODICCProfileModule::getICCProfile(const Uint8*& value, Uint32& numB
                 // detach value pointer and set numBytes
                 value = val;
                 numBytes = elem->getLength();
-                elem->detachValueField();
+                if (elem->detachValueField().bad())
+                {
+                    // value is not owned by the element (e.g. memory-mapped), so copy it
+                    Uint8* copy = new (std::nothrow) Uint8[numBytes];
+                    if (copy)
+                    {
+                        memcpy(copy, val, numBytes);
+                        value = copy;
+                    }
+                    else
+                    {
+                        value = NULL;
+                        numBytes = 0;
+                        result = EC_MemoryExhausted;
+                    }
+                }
             }
         }
         else
@@ -83,6 +83,7 @@ int main(int argc, char *argv[])
   E_SubSampling    opt_sampleFactors = ESS_422;
   OFBool           opt_useYBR422 = OFTrue;
   OFCmdUnsignedInt opt_fragmentSize = 0; // 0=unlimited
+  OFCmdUnsignedInt opt_threads = 1;
   OFBool           opt_createOffsetTable = OFTrue;
   int              opt_windowType = 0;  /* default: no windowing; 1=Wi, 2=Wl, 3=Wm, 4=Wh, 5=Ww, 6=Wn, 7=Wr */
   OFCmdUnsignedInt opt_windowParameter = 0;
@@ -190,6 +191,11 @@ int main(int argc, char *argv[])
       cmd.addOption("--fragment-per-frame",  "+ff",    "encode each frame as one fragment (default)");
       cmd.addOption("--fragment-size",       "+fs", 1, "[s]ize: integer",
                                                        "limit fragment size to s kbytes");
+#ifdef WITH_THREADS
+    cmd.addSubGroup("multi-frame compression:");
+      cmd.addOption("--threads",             "+th", 1, "[n]umber: integer (default: 1)",
+                                                       "compress frames concurrently using n threads");
+#endif
     cmd.addSubGroup("basic offset table encoding:");
       cmd.addOption("--offset-table-create", "+ot",    "create offset table (default)");
       cmd.addOption("--offset-table-empty",  "-ot",    "leave offset table empty");
@@ -512,6 +518,14 @@ int main(int argc, char *argv[])
       }
       cmd.endOptionBlock();
 
+#ifdef WITH_THREADS
+      // multi-frame compression options
+      if (cmd.findOption("--threads"))
+      {
+        app.checkValue(cmd.getValueAndCheckMinMax(opt_threads, OFstatic_cast(OFCmdUnsignedInt, 1), OFstatic_cast(OFCmdUnsignedInt, 1024)));
+      }
+#endif
+
       cmd.beginOptionBlock();
       if (cmd.findOption("--offset-table-create")) opt_createOffsetTable = OFTrue;
       if (cmd.findOption("--offset-table-empty")) opt_createOffsetTable = OFFalse;
@@ -651,7 +665,8 @@ int main(int argc, char *argv[])
       opt_useModalityRescale,
       opt_acceptWrongPaletteTags,
       opt_acrNemaCompatibility,
-      opt_trueLossless);
+      opt_trueLossless,
+      OFstatic_cast(Uint32, opt_threads));
 
     /* make sure data dictionary is loaded */
     if (!dcmDataDict.isDictionaryLoaded())
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2024, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -117,6 +117,7 @@ DCMTK_MAIN_FUNCTION
     const char *opt_charset = DEFAULT_DESCRIPTOR_CHARSET;
     OFFilename opt_directory;
     OFFilename opt_pattern;
+    OFCmdUnsignedInt opt_threads = 1;
     DicomDirInterface::E_ApplicationProfile opt_profile = DicomDirInterface::AP_GeneralPurpose;
 
 #ifdef BUILD_DCMGPDIR_AS_DCMMKDIR
@@ -188,6 +189,11 @@ DCMTK_MAIN_FUNCTION
                                                            "use PGM image 'prefix'+'dcmfile-in' as icon\n(default: create icon from DICOM image)");
         cmd.addOption("--default-icon",          "-Xd", 1, "[f]ilename: string",
                                                            "use specified PGM image if icon cannot be\ncreated automatically (default: black image)");
+#endif
+#ifdef WITH_THREADS
+      cmd.addSubGroup("multi-threading:");
+        cmd.addOption("--threads",               "+th", 1, "[n]umber: integer (default: 1)",
+                                                           "load and check files concurrently using n\nthreads");
 #endif
     cmd.addGroup("output options:");
       cmd.addSubGroup("DICOMDIR file:");
@@ -230,6 +236,7 @@ DCMTK_MAIN_FUNCTION
         cmd.addOption("--append",                "+A",     "append to existing DICOMDIR");
         cmd.addOption("--update",                "+U",     "update existing DICOMDIR");
         cmd.addOption("--discard",               "-w",     "do not write out DICOMDIR");
+        cmd.addOption("--incremental",           "+ic",    "append new records to existing DICOMDIR file\ninstead of writing it again (if possible,\nonly with --append or --update)");
       cmd.addSubGroup("backup:");
         cmd.addOption("--create-backup",                   "create a backup of existing DICOMDIR (def.)");
         cmd.addOption("--no-backup",             "-nb",    "do not create a backup of existing DICOMDIR");
@@ -365,6 +372,11 @@ DCMTK_MAIN_FUNCTION
         }
 #endif
 
+#ifdef WITH_THREADS
+        if (cmd.findOption("--threads"))
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_threads, OFstatic_cast(OFCmdUnsignedInt, 1), OFstatic_cast(OFCmdUnsignedInt, 1024)));
+#endif
+
         /* output options */
         if (cmd.findOption("--output-file"))
             app.checkValue(cmd.getValue(opt_output));
@@ -459,6 +471,12 @@ DCMTK_MAIN_FUNCTION
         }
         cmd.endOptionBlock();
 
+        if (cmd.findOption("--incremental"))
+        {
+            app.checkDependence("--incremental", "--append or --update", opt_append || opt_update);
+            ddir.enableIncrementalWriteMode();
+        }
+
         cmd.beginOptionBlock();
         if (cmd.findOption("--create-backup"))
             ddir.disableBackupMode(OFTrue);
@@ -586,26 +604,10 @@ DCMTK_MAIN_FUNCTION
         {
             /* collect 'bad' files */
             OFList<OFFilename> badFiles;
-            unsigned int goodFiles = 0;
-            OFListIterator(OFFilename) iter = fileNames.begin();
-            OFListIterator(OFFilename) last = fileNames.end();
-            /* iterate over all input filenames */
-            while ((iter != last) && result.good())
-            {
-                /* add files to the DICOMDIR */
-                result = ddir.addDicomFile((*iter), opt_directory);
-                if (result.bad())
-                {
-                    badFiles.push_back(*iter);
-                    if (!ddir.abortMode())
-                    {
-                        /* ignore inconsistent file, just warn (already done inside "ddir") */
-                        result = EC_Normal;
-                    }
-                } else
-                    ++goodFiles;
-                ++iter;
-            }
+            size_t goodFiles = 0;
+            /* add all input files to the DICOMDIR, inconsistent files are ignored */
+            /* (just warn, already done inside "ddir") unless in abort mode */
+            result = ddir.addDicomFiles(fileNames, opt_directory, badFiles, goodFiles, OFstatic_cast(unsigned int, opt_threads));
             /* evaluate result of file checking/adding procedure */
             if (goodFiles == 0)
             {
@@ -616,8 +618,8 @@ DCMTK_MAIN_FUNCTION
             {
                 OFOStringStream oss;
                 oss << badFiles.size() << " file(s) cannot be added to DICOMDIR: ";
-                iter = badFiles.begin();
-                last = badFiles.end();
+                OFListIterator(OFFilename) iter = badFiles.begin();
+                OFListIterator(OFFilename) last = badFiles.end();
                 while (iter != last)
                 {
                     oss << OFendl << "  " << (*iter);
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2001-2024, OFFIS e.V.
+ *  Copyright (C) 2001-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -295,6 +295,19 @@ private:
   static OFBool requiresPlanarConfiguration(
     const char *sopClassUID,
     EP_Interpretation photometricInterpretation);
+
+  /** multiplies both values of a pixel spacing attribute (e.g. Pixel Spacing)
+   *  by the given factor. Used after decompression at reduced resolution.
+   *  Nothing is done if the attribute is absent or has less than two values.
+   *  @param item dataset or item containing the attribute
+   *  @param tag tag of the pixel spacing attribute
+   *  @param factor factor by which the pixel spacing is multiplied
+   *  @return EC_Normal if successful, an error code otherwise
+   */
+  static OFCondition scalePixelSpacing(
+    DcmItem *item,
+    const DcmTagKey& tag,
+    Uint16 factor);
 };
 
 #endif
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2025, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -69,6 +69,10 @@ public:
    *    (only "pseudo" lossless encoder)
    *  @param pTrueLosslessMode Enables true lossless compression (replaces old "pseudo lossless" encoder)
    *  @param setPreserveBitsStored  preserve BitsStored when decompressing even if inconsistent with J2K bitstream
+   *  @param pNumberOfThreads number of threads used for compressing the frames of a
+   *    multi-frame image concurrently, 0 or 1 for sequential compression
+   *  @param pDecompressionScale denominator of the scale factor for decompressing lossy
+   *    JPEG images at reduced resolution: 1 (full resolution), 2, 4 or 8
    */
   DJCodecParameter(
     E_CompressionColorSpaceConversion pCompressionCSConversion,
@@ -99,7 +103,9 @@ public:
     OFBool pAcceptWrongPaletteTags = OFFalse,
     OFBool pAcrNemaCompatibility = OFFalse,
     OFBool pTrueLosslessMode = OFTrue,
-    OFBool setPreserveBitsStored = OFFalse);
+    OFBool setPreserveBitsStored = OFFalse,
+    Uint32 pNumberOfThreads = 1,
+    Uint16 pDecompressionScale = 1);
 
   /// copy constructor
   DJCodecParameter(const DJCodecParameter& arg);
@@ -334,6 +340,24 @@ public:
     return setPreserveBitsStored_;
   }
 
+  /** returns the number of threads used for compressing the frames
+   *  of a multi-frame image concurrently
+   *  @return number of threads for compression, 0 or 1 for sequential compression
+   */
+  Uint32 getNumberOfThreads() const
+  {
+    return numberOfThreads;
+  }
+
+  /** returns the denominator of the scale factor for decompressing
+   *  lossy JPEG images at reduced resolution
+   *  @return 1 for full resolution, 2, 4 or 8 for 1/2, 1/4 or 1/8 of the size
+   */
+  Uint16 getDecompressionScale() const
+  {
+    return decompressionScale;
+  }
+
 private:
 
   /// private undefined copy assignment operator
@@ -441,6 +465,12 @@ private:
   /// flag indicating whether BitsStored should be preserved when decompressing even if inconsistent with the J2K bitstream
   OFBool setPreserveBitsStored_;
 
+  /// number of threads used for compressing the frames of a multi-frame image concurrently
+  Uint32 numberOfThreads;
+
+  /// denominator of the scale factor for decompressing lossy JPEG images at reduced resolution
+  Uint16 decompressionScale;
+
 };
 
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2011, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -71,6 +71,18 @@ public:
     Uint32 uncompressedFrameBufferSize,
     OFBool isSigned) = 0;
 
+  /** selects decompression at reduced resolution, i.e. the number of rows and
+   *  columns of the decompressed frame is divided by the given value (rounded up).
+   *  Must be called before the first frame is decompressed. The default
+   *  implementation only supports full resolution.
+   *  @param denominator denominator of the scale factor (1, 2, 4 or 8)
+   *  @return OFTrue if supported by this decoder, OFFalse otherwise
+   */
+  virtual OFBool setScaleDenominator(Uint16 denominator)
+  {
+    return (denominator == 1);
+  }
+
   /** returns the number of bytes per sample that will be written when decoding.
    */
   virtual Uint16 bytesPerSample() const = 0;
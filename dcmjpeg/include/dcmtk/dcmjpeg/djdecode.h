@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2025, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -53,6 +53,13 @@ public:
    *  @param pForceSingleFragmentPerFrame while decompressing a multiframe image,
    *    assume one fragment per frame even if the JPEG data for some frame is incomplete
    *  @param setPreserveBitsStored preserve BitsStored when decompressing even if inconsistent with J2K bitstream
+   *  @param pDecompressionScale decompress lossy JPEG images at reduced resolution, i.e. with
+   *    1/2, 1/4 or 1/8 of the number of rows and columns (2, 4 or 8), or at full resolution (1).
+   *    This is much faster than decompressing and scaling the image afterwards, since most
+   *    of the inverse DCT and the color space conversion is skipped, and is intended for
+   *    creating previews. Rows and Columns (as well as the pixel spacing attributes) in the
+   *    dataset are adjusted accordingly. Only used when the complete pixel data is
+   *    decompressed, frame-wise decompression (e.g. partial access) always uses full resolution.
    */
   static void registerCodecs(
     E_DecompressionColorSpaceConversion pDecompressionCSConversion = EDC_photometricInterpretation,
@@ -61,7 +68,8 @@ public:
     OFBool predictor6WorkaroundEnable = OFFalse,
     OFBool cornellWorkaroundEnable = OFFalse,
     OFBool pForceSingleFragmentPerFrame = OFFalse,
-    OFBool setPreserveBitsStored = OFFalse);
+    OFBool setPreserveBitsStored = OFFalse,
+    Uint16 pDecompressionScale = 1);
 
   /** deregisters decoders.
    *  Attention: Must not be called while other threads might still use
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2024, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -73,6 +73,13 @@ public:
     Uint32 uncompressedFrameBufferSize,
     OFBool isSigned);
 
+  /** selects decompression at reduced resolution using the scaled inverse DCT
+   *  of the IJG library. Only supported for lossy JPEG processes.
+   *  @param denominator denominator of the scale factor (1, 2, 4 or 8)
+   *  @return OFTrue if the scale factor is supported, OFFalse otherwise
+   */
+  virtual OFBool setScaleDenominator(Uint16 denominator);
+
   /** returns the number of bytes per sample that will be written when decoding.
    */
   virtual Uint16 bytesPerSample() const
@@ -123,6 +130,9 @@ private:
   /// color model after decompression
   EP_Interpretation decompressedColorModel;
 
+  /// denominator of the scale factor for decompression at reduced resolution
+  Uint16 scaleDenominator;
+
 };
 
 #endif
@@ -170,6 +170,20 @@ OFCondition DJCodecDecoder::decode(
               if (jpeg == NULL) result = EC_MemoryExhausted;
               else
               {
+                // decompress lossy JPEG at reduced resolution if requested (e.g. for previews)
+                Uint16 scale = djcp->getDecompressionScale();
+                if ((scale > 1) && (isLosslessProcess() || !jpeg->setScaleDenominator(scale)))
+                {
+                  DCMJPEG_DEBUG("decompression at reduced resolution (1/" << scale << ") not supported, using full resolution");
+                  scale = 1;
+                }
+                if (scale > 1)
+                {
+                  DCMJPEG_DEBUG("decompressing JPEG image at reduced resolution (1/" << scale << ")");
+                  imageRows = OFstatic_cast(Uint16, (imageRows + scale - 1) / scale);
+                  imageColumns = OFstatic_cast(Uint16, (imageColumns + scale - 1) / scale);
+                }
+
                 Uint32 imageBytesAllocated = (precision > 8) ? sizeof(Uint16) : sizeof(Uint8);
                 Uint32 frameSize = imageBytesAllocated * imageRows * imageColumns * imageSamplesPerPixel;
 
@@ -365,6 +379,17 @@ OFCondition DJCodecDecoder::decode(
                     result = OFreinterpret_cast(DcmItem*, dataset)->putAndInsertString(DCM_NumberOfFrames, numBuf);
                   }
 
+                  // Rows and Columns (and the physical size of the pixels) have changed in case of reduced resolution
+                  if (result.good() && (scale > 1))
+                  {
+                    DcmItem *ditem = OFreinterpret_cast(DcmItem*, dataset);
+                    result = ditem->putAndInsertUint16(DCM_Rows, imageRows);
+                    if (result.good()) result = ditem->putAndInsertUint16(DCM_Columns, imageColumns);
+                    if (result.good()) result = scalePixelSpacing(ditem, DCM_PixelSpacing, scale);
+                    if (result.good()) result = scalePixelSpacing(ditem, DCM_ImagerPixelSpacing, scale);
+                    if (result.good()) result = scalePixelSpacing(ditem, DCM_NominalScannedPixelSpacing, scale);
+                  }
+
                   // Pixel Representation could be signed if lossless JPEG. For now, we just believe what we get.
                 }
                 delete jpeg;
@@ -958,3 +983,23 @@ OFBool DJCodecDecoder::requiresPlanarConfiguration(
   }
   return OFFalse;
 }
+
+
+OFCondition DJCodecDecoder::scalePixelSpacing(
+    DcmItem *item,
+    const DcmTagKey& tag,
+    Uint16 factor)
+{
+  OFCondition result = EC_Normal;
+  DcmElement *elem = NULL;
+  if (item->findAndGetElement(tag, elem).good() && (elem->getVM() >= 2))
+  {
+    Float64 rowSpacing = 0.0;
+    Float64 columnSpacing = 0.0;
+    result = elem->getFloat64(rowSpacing, 0);
+    if (result.good()) result = elem->getFloat64(columnSpacing, 1);
+    if (result.good()) result = elem->putFloat64(rowSpacing * factor, 0);
+    if (result.good()) result = elem->putFloat64(columnSpacing * factor, 1);
+  }
+  return result;
+}
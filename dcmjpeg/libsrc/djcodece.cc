@@ -25,10 +25,13 @@
 // ofstd includes
 #include "dcmtk/ofstd/oflist.h"
 #include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 // dcmdata includes
 #include "dcmtk/dcmdata/dcdatset.h"   /* for class DcmDataset */
 #include "dcmtk/dcmdata/dcdeftag.h"   /* for tag constants */
+#include "dcmtk/dcmdata/dcfrmenc.h"   /* for class DcmConcurrentFrameEncoder */
 #include "dcmtk/dcmdata/dcovlay.h"    /* for class DcmOverlayData */
 #include "dcmtk/dcmdata/dcpixseq.h"   /* for class DcmPixelSequence */
 #include "dcmtk/dcmdata/dcpxitem.h"   /* for class DcmPixelItem */
@@ -49,6 +52,215 @@
 
 #include <cmath>
 
+
+/* base class for the compression of the frames of an image, possibly
+ * by multiple threads. Each thread uses its own DJEncoder instance.
+ */
+class DJFrameEncoder: public DcmConcurrentFrameEncoder
+{
+public:
+  DJFrameEncoder(
+    Uint32 numThreads,
+    Uint16 columns,
+    Uint16 rows,
+    EP_Interpretation interpr,
+    Uint16 samplesPerPixel)
+  : DcmConcurrentFrameEncoder(numThreads)
+  , encoders_()
+  , columns_(columns)
+  , rows_(rows)
+  , interpr_(interpr)
+  , samplesPerPixel_(samplesPerPixel)
+  {
+  }
+
+  virtual ~DJFrameEncoder()
+  {
+    for (size_t i = 0; i < encoders_.size(); ++i) delete encoders_[i];
+  }
+
+  /* adds an encoder instance, one is needed for each thread.
+   * Takes ownership of the encoder, which must not be NULL.
+   */
+  void addEncoder(DJEncoder *jpeg)
+  {
+    encoders_.push_back(jpeg);
+  }
+
+  /* returns the number of encoder instances still needed */
+  Uint32 missingEncoders() const
+  {
+    return getNumberOfThreads() - OFstatic_cast(Uint32, encoders_.size());
+  }
+
+protected:
+
+  /* compresses the given uncompressed frame with the encoder of the given thread */
+  OFCondition encodePixels(
+    Uint32 threadNo,
+    const void *frame,
+    Uint8 *&compressedData,
+    Uint32 &compressedLen)
+  {
+    DJEncoder *jpeg = encoders_[threadNo];
+    if (jpeg->bytesPerSample() == 1)
+      return jpeg->encode(columns_, rows_, interpr_, samplesPerPixel_, OFreinterpret_cast(Uint8*, OFconst_cast(void*, frame)), compressedData, compressedLen);
+    else
+      return jpeg->encode(columns_, rows_, interpr_, samplesPerPixel_, OFreinterpret_cast(Uint16*, OFconst_cast(void*, frame)), compressedData, compressedLen);
+  }
+
+private:
+
+  /* private undefined copy constructor */
+  DJFrameEncoder(const DJFrameEncoder&);
+
+  /* private undefined copy assignment operator */
+  DJFrameEncoder& operator=(const DJFrameEncoder&);
+
+  /* encoder instances, one per thread */
+  OFVector<DJEncoder *> encoders_;
+
+  /* width of the image */
+  Uint16 columns_;
+
+  /* height of the image */
+  Uint16 rows_;
+
+  /* color model of the uncompressed frames */
+  EP_Interpretation interpr_;
+
+  /* number of samples per pixel */
+  Uint16 samplesPerPixel_;
+};
+
+
+/* compresses frames that are rendered by a DicomImage object.
+ * Since DicomImage is not thread-safe, the frames are rendered one at a time
+ * into a buffer owned by the calling thread, and only compressed concurrently.
+ */
+class DJRenderedFrameEncoder: public DJFrameEncoder
+{
+public:
+  DJRenderedFrameEncoder(
+    Uint32 numThreads,
+    DicomImage &image,
+    EP_Interpretation interpr,
+    Uint16 samplesPerPixel,
+    int bitsPerSample)
+  : DJFrameEncoder(numThreads, OFstatic_cast(Uint16, image.getWidth()), OFstatic_cast(Uint16, image.getHeight()), interpr, samplesPerPixel)
+  , image_(image)
+  , bitsPerSample_(bitsPerSample)
+  , bufferSize_(image.getOutputDataSize(bitsPerSample))
+  , buffers_(getNumberOfThreads(), OFstatic_cast(Uint8 *, NULL))
+#ifdef WITH_THREADS
+  , renderMutex_()
+#endif
+  {
+  }
+
+  virtual ~DJRenderedFrameEncoder()
+  {
+    for (size_t i = 0; i < buffers_.size(); ++i) delete[] buffers_[i];
+  }
+
+protected:
+
+  virtual OFCondition encodeFrame(
+    Uint32 frameNo,
+    Uint32 threadNo,
+    Uint8 *&compressedData,
+    Uint32 &compressedLen)
+  {
+    if (buffers_[threadNo] == NULL) buffers_[threadNo] = new Uint8[bufferSize_];
+#ifdef WITH_THREADS
+    renderMutex_.lock();
+#endif
+    const int rendered = image_.getOutputData(buffers_[threadNo], bufferSize_, bitsPerSample_, frameNo, 0);
+#ifdef WITH_THREADS
+    renderMutex_.unlock();
+#endif
+    if (!rendered) return EC_MemoryExhausted;
+    return encodePixels(threadNo, buffers_[threadNo], compressedData, compressedLen);
+  }
+
+private:
+
+  /* private undefined copy constructor */
+  DJRenderedFrameEncoder(const DJRenderedFrameEncoder&);
+
+  /* private undefined copy assignment operator */
+  DJRenderedFrameEncoder& operator=(const DJRenderedFrameEncoder&);
+
+  /* the image to be compressed */
+  DicomImage &image_;
+
+  /* number of bits per sample of the rendered frames */
+  int bitsPerSample_;
+
+  /* size of a rendered frame in bytes */
+  unsigned long bufferSize_;
+
+  /* buffers for the rendered frames, one per thread */
+  OFVector<Uint8 *> buffers_;
+
+#ifdef WITH_THREADS
+  /* mutex serializing access to the DicomImage object */
+  OFMutex renderMutex_;
+#endif
+};
+
+
+/* compresses frames that are taken directly from the uncompressed pixel data */
+class DJRawFrameEncoder: public DJFrameEncoder
+{
+public:
+  DJRawFrameEncoder(
+    Uint32 numThreads,
+    Uint16 columns,
+    Uint16 rows,
+    EP_Interpretation interpr,
+    Uint16 samplesPerPixel,
+    const Uint8 *pixelData,
+    size_t frameSize)
+  : DJFrameEncoder(numThreads, columns, rows, interpr, samplesPerPixel)
+  , pixelData_(pixelData)
+  , frameSize_(frameSize)
+  {
+  }
+
+protected:
+
+  virtual OFCondition encodeFrame(
+    Uint32 frameNo,
+    Uint32 threadNo,
+    Uint8 *&compressedData,
+    Uint32 &compressedLen)
+  {
+    OFCondition result = encodePixels(threadNo, pixelData_ + frameNo * frameSize_, compressedData, compressedLen);
+    if (result.bad() || (compressedLen == 0))
+    {
+      DCMJPEG_ERROR("True lossless encoder: Error encoding frame");
+      result = EC_CannotChangeRepresentation;
+    }
+    return result;
+  }
+
+private:
+
+  /* private undefined copy constructor */
+  DJRawFrameEncoder(const DJRawFrameEncoder&);
+
+  /* private undefined copy assignment operator */
+  DJRawFrameEncoder& operator=(const DJRawFrameEncoder&);
+
+  /* pointer to the uncompressed pixel data of all frames */
+  const Uint8 *pixelData_;
+
+  /* size of an uncompressed frame in bytes */
+  size_t frameSize_;
+};
+
+
 DJCodecEncoder::DJCodecEncoder()
 : DcmCodec()
 {
@@ -381,42 +593,23 @@ OFCondition DJCodecEncoder::encodeColorImage(
       // render and compress each frame
       bitsPerSample = jpeg->bitsPerSample();
       size_t frameCount = dimage->getFrameCount();
-      unsigned short bytesPerSample = jpeg->bytesPerSample();
       unsigned short columns = OFstatic_cast(unsigned short, dimage->getWidth());
       unsigned short rows = OFstatic_cast(unsigned short, dimage->getHeight());
-      Uint8 *jpegData = NULL;
-      Uint32 jpegLen  = 0;
-      const void *frame = NULL;
 
       // compute original image size in bytes, ignoring any padding bits.
       uncompressedSize = OFstatic_cast(double, columns * rows * dimage->getDepth() * frameCount * samplesPerPixel) / 8.0;
-      for (unsigned long i=0; (i<frameCount) && (result.good()); i++)
-      {
-        frame = dimage->getOutputData(bitsPerSample, i, 0);
-        if (frame == NULL) result = EC_MemoryExhausted;
-        else
-        {
-          // compress frame
-          jpegData = NULL;
-          if (bytesPerSample == 1)
-          {
-            result = jpeg->encode(columns, rows, interpr, samplesPerPixel, OFreinterpret_cast(Uint8*, OFconst_cast(void*, frame)), jpegData, jpegLen);
-          } else {
-            result = jpeg->encode(columns, rows, interpr, samplesPerPixel, OFreinterpret_cast(Uint16*, OFconst_cast(void*, frame)), jpegData, jpegLen);
-          }
 
-          // store frame
-          if (result.good())
-          {
-            result = pixelSequence->storeCompressedFrame(offsetList, jpegData, jpegLen, cp->getFragmentSize());
-          }
-
-          // delete block of JPEG data
-          delete[] jpegData;
-          compressedSize += jpegLen;
-        }
+      // frames may be compressed concurrently, each thread needs its own encoder
+      DJRenderedFrameEncoder frameEncoder(cp->getNumberOfThreads(), *dimage, interpr, samplesPerPixel, bitsPerSample);
+      frameEncoder.addEncoder(jpeg);
+      while (frameEncoder.missingEncoders() > 0)
+      {
+        jpeg = createEncoderInstance(toRepParam, cp, OFstatic_cast(Uint8, compressedBits));
+        if (jpeg == NULL) break;
+        frameEncoder.addEncoder(jpeg);
       }
-      delete jpeg;
+      if (jpeg == NULL) result = EC_MemoryExhausted;
+      else result = frameEncoder.encodeFrames(OFstatic_cast(Uint32, frameCount), pixelSequence, offsetList, cp->getFragmentSize(), compressedSize);
     } else result = EC_MemoryExhausted;
   }
 
@@ -510,8 +703,6 @@ OFCondition DJCodecEncoder::encodeTrueLossless(
     Uint16 rows = 0;
     Sint32 numberOfFrames = 1;
     EP_Interpretation interpr = EPI_Unknown;
-    Uint8 *jpegData = NULL;
-    Uint32 jpegLen  = 0;
     OFBool byteSwapped = OFFalse;      // true if we have byte-swapped the original pixel data
     OFBool planConfSwitched = OFFalse; // true if planar configuration was toggled
     DcmOffsetList offsetList;
@@ -645,36 +836,21 @@ OFCondition DJCodecEncoder::encodeTrueLossless(
     const Uint8 *framePointer = OFreinterpret_cast(const Uint8 *, pixelData);
     size_t compressedSize = 0;
 
-    // create encoder corresponding to bit depth (8 or 16 bit)
-    DJEncoder *jpeg = createEncoderInstance(toRepParam, djcp, OFstatic_cast(Uint8, bitsAllocated));
+    // create encoders corresponding to bit depth (8 or 16 bit), one for each
+    // thread since frames may be compressed concurrently
+    DJRawFrameEncoder frameEncoder(djcp->getNumberOfThreads(), columns, rows, interpr, samplesPerPixel, framePointer, frameSize);
+    DJEncoder *jpeg = NULL;
+    while (frameEncoder.missingEncoders() > 0)
+    {
+      jpeg = createEncoderInstance(toRepParam, djcp, OFstatic_cast(Uint8, bitsAllocated));
+      if (jpeg == NULL) break;
+      frameEncoder.addEncoder(jpeg);
+    }
     if (jpeg)
     {
       // main loop for compression: compress each frame
-      for (unsigned int i = 0; i < frameCount && result.good(); i++)
-      {
-        if (bitsAllocated == 8)
-        {
-          jpeg->encode(columns, rows, interpr, samplesPerPixel, OFconst_cast(Uint8*, framePointer), jpegData, jpegLen);
-        }
-        else if (bitsAllocated == 16)
-        {
-          jpeg->encode(columns, rows, interpr, samplesPerPixel, OFreinterpret_cast(Uint16*, OFconst_cast(Uint8*, framePointer)), jpegData, jpegLen);
-        }
-        // update variables
-        compressedSize += jpegLen;
-        framePointer += frameSize;
-        if (jpegLen == 0)
-        {
-          DCMJPEG_ERROR("True lossless encoder: Error encoding frame");
-          result = EC_CannotChangeRepresentation;
-        }
-        else
-        {
-          result = pixelSequence->storeCompressedFrame(offsetList, jpegData, jpegLen, djcp->getFragmentSize());
-        }
-        // free memory
-        delete[] jpegData;
-      }
+      if (result.good())
+        result = frameEncoder.encodeFrames(OFstatic_cast(Uint32, frameCount), pixelSequence, offsetList, djcp->getFragmentSize(), compressedSize);
     }
     else
     {
@@ -688,7 +864,6 @@ OFCondition DJCodecEncoder::encodeTrueLossless(
     }
     else
       delete pixelSequence;
-    delete jpeg; // encoder no longer in use
 
     if (result.good() && djcp->getCreateOffsetTable())
     {
@@ -1202,44 +1377,25 @@ OFCondition DJCodecEncoder::encodeMonochromeImage(
 
       // render and compress each frame
       size_t frameCount = dimage.getFrameCount();
-      unsigned short bytesPerSample = jpeg->bytesPerSample();
       unsigned short columns = OFstatic_cast(unsigned short, dimage.getWidth());
       unsigned short rows = OFstatic_cast(unsigned short, dimage.getHeight());
-      Uint8 *jpegData = NULL;
-      Uint32 jpegLen  = 0;
-      const void *frame = NULL;
 
       // compute original image size in bytes, ignoring any padding bits.
       Uint16 samplesPerPixel = 0;
       if ((dataset->findAndGetUint16(DCM_SamplesPerPixel, samplesPerPixel)).bad()) samplesPerPixel = 1;
       uncompressedSize = OFstatic_cast(double, columns * rows * pixelDepth * frameCount * samplesPerPixel) / 8.0;
-      for (size_t i=0; (i<frameCount) && (result.good()); i++)
-      {
-        frame = dimage.getOutputData(bitsPerSample, OFstatic_cast(unsigned long, i), 0);
-        if (frame == NULL) result = EC_MemoryExhausted;
-        else
-        {
-          // compress frame
-          jpegData = NULL;
-          if (bytesPerSample == 1)
-          {
-            result = jpeg->encode(columns, rows, EPI_Monochrome2, 1, OFreinterpret_cast(Uint8*, OFconst_cast(void*, frame)), jpegData, jpegLen);
-          } else {
-            result = jpeg->encode(columns, rows, EPI_Monochrome2, 1, OFreinterpret_cast(Uint16*, OFconst_cast(void*, frame)), jpegData, jpegLen);
-          }
 
-          // store frame
-          if (result.good())
-          {
-            result = pixelSequence->storeCompressedFrame(offsetList, jpegData, jpegLen, cp->getFragmentSize());
-          }
-
-          // delete block of JPEG data
-          delete[] jpegData;
-          compressedSize += jpegLen;
-        }
+      // frames may be compressed concurrently, each thread needs its own encoder
+      DJRenderedFrameEncoder frameEncoder(cp->getNumberOfThreads(), dimage, EPI_Monochrome2, 1, bitsPerSample);
+      frameEncoder.addEncoder(jpeg);
+      while (frameEncoder.missingEncoders() > 0)
+      {
+        jpeg = createEncoderInstance(toRepParam, cp, OFstatic_cast(Uint8, compressedBits));
+        if (jpeg == NULL) break;
+        frameEncoder.addEncoder(jpeg);
       }
-      delete jpeg;
+      if (jpeg == NULL) result = EC_MemoryExhausted;
+      else if (result.good()) result = frameEncoder.encodeFrames(OFstatic_cast(Uint32, frameCount), pixelSequence, offsetList, cp->getFragmentSize(), compressedSize);
     } else result = EC_MemoryExhausted;
   }
 
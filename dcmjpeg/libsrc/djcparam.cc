@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2025, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -51,7 +51,9 @@ DJCodecParameter::DJCodecParameter(
     OFBool pAcceptWrongPaletteTags,
     OFBool pAcrNemaCompatibility,
     OFBool pTrueLosslessMode,
-    OFBool setPreserveBitsStored)
+    OFBool setPreserveBitsStored,
+    Uint32 pNumberOfThreads,
+    Uint16 pDecompressionScale)
 : DcmCodecParameter()
 , compressionCSConversion(pCompressionCSConversion)
 , decompressionCSConversion(pDecompressionCSConversion)
@@ -82,6 +84,8 @@ DJCodecParameter::DJCodecParameter(
 , cornellWorkaroundEnabled_(cornellWorkaroundEnable)
 , forceSingleFragmentPerFrame(pForceSingleFragmentPerFrame)
 , setPreserveBitsStored_(setPreserveBitsStored)
+, numberOfThreads(pNumberOfThreads)
+, decompressionScale(pDecompressionScale)
 {
 }
 
@@ -117,6 +121,8 @@ DJCodecParameter::DJCodecParameter(const DJCodecParameter& arg)
 , cornellWorkaroundEnabled_(arg.cornellWorkaroundEnabled_)
 , forceSingleFragmentPerFrame(arg.forceSingleFragmentPerFrame)
 , setPreserveBitsStored_(arg.setPreserveBitsStored_)
+, numberOfThreads(arg.numberOfThreads)
+, decompressionScale(arg.decompressionScale)
 {
 }
 
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1997-2025, OFFIS e.V.
+ *  Copyright (C) 1997-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -48,7 +48,8 @@ void DJDecoderRegistration::registerCodecs(
     OFBool predictor6WorkaroundEnable,
     OFBool cornellWorkaroundEnable,
     OFBool pForceSingleFragmentPerFrame,
-    OFBool setPreserveBitsStored)
+    OFBool setPreserveBitsStored,
+    Uint16 pDecompressionScale)
 {
   if (! registered)
   {
@@ -64,7 +65,9 @@ void DJDecoderRegistration::registerCodecs(
       ESS_444, OFFalse, OFFalse,
       0, 0, 0.0, 0.0, 0, 0, 0, 0,
       OFTrue, OFFalse, OFFalse, OFFalse, OFTrue,
-      setPreserveBitsStored);
+      setPreserveBitsStored,
+      1 /* number of threads, compression only */,
+      pDecompressionScale);
 
     if (cp)
     {
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2001-2024, OFFIS e.V.
+ *  Copyright (C) 2001-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -186,6 +186,7 @@ DJDecompressIJG8Bit::DJDecompressIJG8Bit(const DJCodecParameter& cp, OFBool isYB
 , jsampBuffer(NULL)
 , dicomPhotometricInterpretationIsYCbCr(isYBR)
 , decompressedColorModel(EPI_Unknown)
+, scaleDenominator(1)
 {
 }
 
@@ -194,6 +195,16 @@ DJDecompressIJG8Bit::~DJDecompressIJG8Bit()
   cleanup();
 }
 
+OFBool DJDecompressIJG8Bit::setScaleDenominator(Uint16 denominator)
+{
+  if ((denominator == 1) || (denominator == 2) || (denominator == 4) || (denominator == 8))
+  {
+    scaleDenominator = denominator;
+    return OFTrue;
+  }
+  return OFFalse;
+}
+
 #include DCMTK_DIAGNOSTIC_PUSH
 #include DCMTK_DIAGNOSTIC_IGNORE_VISUAL_STUDIO_OBJECT_DESTRUCTION_WARNING
 
@@ -396,6 +407,14 @@ OFCondition DJDecompressIJG8Bit::decode(
       cinfo->jpeg_color_space = JCS_UNKNOWN;
       cinfo->out_color_space = JCS_UNKNOWN;
     }
+
+    // decompress at reduced resolution if requested (ignored by the IJG library for lossless JPEG).
+    // The scaled inverse DCT directly computes the smaller image.
+    if (scaleDenominator > 1)
+    {
+      cinfo->scale_num = 1;
+      cinfo->scale_denom = scaleDenominator;
+    }
   }
 
   JSAMPARRAY buffer = NULL;
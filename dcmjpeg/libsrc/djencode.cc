@@ -64,7 +64,8 @@ void DJEncoderRegistration::registerCodecs(
     OFBool pUseModalityRescale,
     OFBool pAcceptWrongPaletteTags,
     OFBool pAcrNemaCompatibility,
-    OFBool pRealLossless)
+    OFBool pRealLossless,
+    Uint32 pNumberOfThreads)
 {
   if (! registered)
   {
@@ -96,7 +97,9 @@ void DJEncoderRegistration::registerCodecs(
       pUseModalityRescale,
       pAcceptWrongPaletteTags,
       pAcrNemaCompatibility,
-      pRealLossless);
+      pRealLossless,
+      OFFalse, // not relevant, used for decompression only
+      pNumberOfThreads);
     if (cp)
     {
       // baseline JPEG
@@ -80,6 +80,7 @@ int main(int argc, char *argv[])
 
   // encapsulated pixel data encoding options
   OFCmdUnsignedInt opt_fragmentSize = 0; // 0=unlimited
+  OFCmdUnsignedInt opt_threads = 1;
   OFBool           opt_createOffsetTable = OFTrue;
   JLS_UIDCreation  opt_uidcreation = EJLSUC_default;
   OFBool           opt_secondarycapture = OFFalse;
@@ -160,6 +161,11 @@ LICENSE_FILE_DECLARE_COMMAND_LINE_OPTIONS
       cmd.addOption("--fragment-per-frame",     "+ff",    "encode each frame as one fragment (default)");
       cmd.addOption("--fragment-size",          "+fs", 1, "[s]ize: integer",
                                                           "limit fragment size to s kbytes");
+#ifdef WITH_THREADS
+    cmd.addSubGroup("multi-frame compression:");
+      cmd.addOption("--threads",                "+th", 1, "[n]umber: integer (default: 1)",
+                                                          "compress frames concurrently using n threads");
+#endif
     cmd.addSubGroup("basic offset table encoding:");
       cmd.addOption("--offset-table-create",    "+ot",    "create offset table (default)");
       cmd.addOption("--offset-table-empty",     "-ot",    "leave offset table empty");
@@ -348,6 +354,14 @@ LICENSE_FILE_EVALUATE_COMMAND_LINE_OPTIONS
       }
       cmd.endOptionBlock();
 
+#ifdef WITH_THREADS
+      // multi-frame compression options
+      if (cmd.findOption("--threads"))
+      {
+        app.checkValue(cmd.getValueAndCheckMinMax(opt_threads, OFstatic_cast(OFCmdUnsignedInt, 1), OFstatic_cast(OFCmdUnsignedInt, 1024)));
+      }
+#endif
+
       // basic offset table encoding options
       cmd.beginOptionBlock();
       if (cmd.findOption("--offset-table-create")) opt_createOffsetTable = OFTrue;
@@ -408,7 +422,8 @@ LICENSE_FILE_EVALUATE_COMMAND_LINE_OPTIONS
       OFstatic_cast(Uint16, opt_t1), OFstatic_cast(Uint16, opt_t2), OFstatic_cast(Uint16, opt_t3),
       OFstatic_cast(Uint16, opt_reset),
       opt_prefer_cooked, opt_fragmentSize, opt_createOffsetTable,
-      opt_uidcreation, opt_secondarycapture, opt_interleaveMode, opt_useFFpadding);
+      opt_uidcreation, opt_secondarycapture, opt_interleaveMode, opt_useFFpadding,
+      OFstatic_cast(Uint32, opt_threads));
 
     /* make sure data dictionary is loaded */
     if (!dcmDataDict.isDictionaryLoaded())
@@ -31,6 +31,7 @@
 class DJLSRepresentationParameter;
 class DJLSCodecParameter;
 class DicomImage;
+class DJLSFrameEncoder;
 struct JlsCustomParameters;
 
 /** abstract codec class for JPEG-LS encoders.
@@ -212,6 +213,9 @@ public:
 
 private:
 
+  /// helper class for the concurrent compression of frames, needs access to the compressXXXFrame() methods
+  friend class DJLSFrameEncoder;
+
   /** returns the transfer syntax that this particular codec
    *  is able to encode
    *  @return supported transfer syntax
@@ -303,8 +307,8 @@ private:
    *  @param samplesPerPixel image samples per pixel
    *  @param planarConfiguration image planar configuration
    *  @param photometricInterpretation photometric interpretation of the DICOM dataset
-   *  @param pixelSequence object in which the compressed frame is stored
-   *  @param offsetList list of frame offsets updated in this parameter
+   *  @param compressedFrame upon success, points to the compressed frame allocated
+   *    with new[]. Ownership is transferred to the caller.
    *  @param compressedSize size of compressed frame returned in this parameter
    *  @param djcp parameters for the codec
    *  @return EC_Normal if successful, an error code otherwise
@@ -317,16 +321,17 @@ private:
     Uint16 samplesPerPixel,
     Uint16 planarConfiguration,
     const OFString& photometricInterpretation,
-    DcmPixelSequence *pixelSequence,
-    DcmOffsetList &offsetList,
-    unsigned long &compressedSize,
+    Uint8 *&compressedFrame,
+    Uint32 &compressedSize,
     const DJLSCodecParameter *djcp) const;
 
-  /** perform the lossless cooked compression of a single frame
-   *  @param pixelSequence object in which the compressed frame is stored
+  /** perform the lossless cooked compression of a single frame.
+   *  Only reads the intermediate pixel data of the DicomImage object,
+   *  and may thus be called concurrently for different frames.
    *  @param dimage DicomImage instance used to process frame
    *  @param photometricInterpretation photometric interpretation of the DICOM dataset
-   *  @param offsetList list of frame offsets updated in this parameter
+   *  @param compressedFrame upon success, points to the compressed frame allocated
+   *    with new[]. Ownership is transferred to the caller.
    *  @param compressedSize size of compressed frame returned in this parameter
    *  @param djcp parameters for the codec
    *  @param frame frame index
@@ -334,11 +339,10 @@ private:
    *  @return EC_Normal if successful, an error code otherwise
    */
   OFCondition compressCookedFrame(
-    DcmPixelSequence *pixelSequence,
     DicomImage *dimage,
     const OFString& photometricInterpretation,
-    DcmOffsetList &offsetList,
-    unsigned long &compressedSize,
+    Uint8 *&compressedFrame,
+    Uint32 &compressedSize,
     const DJLSCodecParameter *djcp,
     Uint32 frame,
     Uint16 nearLosslessDeviation) const;
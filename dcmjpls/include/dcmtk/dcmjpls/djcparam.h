@@ -65,6 +65,8 @@ public:
    *  @param ignoreOffsetTable         flag indicating whether to ignore the offset table when decompressing multiframe images
    *  @param jplsInterleaveMode        flag describing which interleave the JPEG-LS datastream should use
    *  @param useFFbitstreamPadding     flag indicating whether the JPEG-LS bitstream should be FF padded as required by DICOM.
+   *  @param numberOfThreads           number of threads used for compressing the frames of a multi-frame image
+   *                                   concurrently, 0 or 1 for sequential compression
    */
    DJLSCodecParameter(
      OFBool preferCookedEncoding,
@@ -79,7 +81,8 @@ public:
      JLS_PlanarConfiguration planarConfiguration = EJLSPC_restore,
      OFBool ignoreOffsetTable = OFFalse,
      interleaveMode jplsInterleaveMode = interleaveLine,
-     OFBool useFFbitstreamPadding = OFTrue );
+     OFBool useFFbitstreamPadding = OFTrue,
+     Uint32 numberOfThreads = 1 );
 
   /** constructor, for use with decoders. Initializes all encoder options to defaults.
    *  @param uidCreation                 mode for SOP Instance UID creation (used both for encoding and decoding)
@@ -224,6 +227,14 @@ public:
     return useFFbitstreamPadding_;
   }
 
+  /** returns the number of threads used for compressing the frames of a multi-frame image concurrently
+   *  @return number of threads for compression, 0 or 1 for sequential compression
+   */
+  Uint32 getNumberOfThreads() const
+  {
+    return numberOfThreads_;
+  }
+
 private:
 
   /// private undefined copy assignment operator
@@ -270,6 +281,9 @@ private:
    */
   OFBool useFFbitstreamPadding_;
 
+  /// number of threads used for compressing the frames of a multi-frame image concurrently
+  Uint32 numberOfThreads_;
+
   // ****************************************************
   // **** Parameters describing the decoding process ****
 
@@ -32,6 +32,7 @@
 // dcmdata includes
 #include "dcmtk/dcmdata/dcdatset.h"  /* for class DcmDataset */
 #include "dcmtk/dcmdata/dcdeftag.h"  /* for tag constants */
+#include "dcmtk/dcmdata/dcfrmenc.h"  /* for class DcmConcurrentFrameEncoder */
 #include "dcmtk/dcmdata/dcovlay.h"   /* for class DcmOverlayData */
 #include "dcmtk/dcmdata/dcpixseq.h"  /* for class DcmPixelSequence */
 #include "dcmtk/dcmdata/dcpxitem.h"  /* for class DcmPixelItem */
@@ -61,6 +62,130 @@ BEGIN_EXTERN_C
 END_EXTERN_C
 
 
+/* compresses the frames of an image, possibly by multiple threads, either
+ * directly from the uncompressed pixel data ("raw" mode) or from the
+ * intermediate representation of a DicomImage object ("cooked" mode).
+ * Both compressRawFrame() and compressCookedFrame() only read shared data,
+ * so no per-thread state is needed.
+ */
+class DJLSFrameEncoder: public DcmConcurrentFrameEncoder
+{
+public:
+
+  /* constructor for raw mode */
+  DJLSFrameEncoder(
+    const DJLSEncoderBase &codec,
+    const DJLSCodecParameter *djcp,
+    const Uint8 *pixelData,
+    unsigned long frameSize,
+    Uint16 bitsAllocated,
+    Uint16 columns,
+    Uint16 rows,
+    Uint16 samplesPerPixel,
+    Uint16 planarConfiguration,
+    const OFString& photometricInterpretation)
+  : DcmConcurrentFrameEncoder(djcp->getNumberOfThreads())
+  , codec_(codec)
+  , djcp_(djcp)
+  , pixelData_(pixelData)
+  , frameSize_(frameSize)
+  , bitsAllocated_(bitsAllocated)
+  , columns_(columns)
+  , rows_(rows)
+  , samplesPerPixel_(samplesPerPixel)
+  , planarConfiguration_(planarConfiguration)
+  , photometricInterpretation_(photometricInterpretation)
+  , dimage_(NULL)
+  , nearLosslessDeviation_(0)
+  {
+  }
+
+  /* constructor for cooked mode */
+  DJLSFrameEncoder(
+    const DJLSEncoderBase &codec,
+    const DJLSCodecParameter *djcp,
+    DicomImage *dimage,
+    const OFString& photometricInterpretation,
+    Uint16 nearLosslessDeviation)
+  : DcmConcurrentFrameEncoder(djcp->getNumberOfThreads())
+  , codec_(codec)
+  , djcp_(djcp)
+  , pixelData_(NULL)
+  , frameSize_(0)
+  , bitsAllocated_(0)
+  , columns_(0)
+  , rows_(0)
+  , samplesPerPixel_(0)
+  , planarConfiguration_(0)
+  , photometricInterpretation_(photometricInterpretation)
+  , dimage_(dimage)
+  , nearLosslessDeviation_(nearLosslessDeviation)
+  {
+  }
+
+protected:
+
+  virtual OFCondition encodeFrame(
+    Uint32 frameNo,
+    Uint32 /* threadNo */,
+    Uint8 *&compressedData,
+    Uint32 &compressedLen)
+  {
+    DCMJPLS_DEBUG("JPEG-LS encoder processes frame " << (frameNo+1));
+    if (dimage_)
+      return codec_.compressCookedFrame(dimage_, photometricInterpretation_, compressedData, compressedLen,
+        djcp_, frameNo, nearLosslessDeviation_);
+    else
+      return codec_.compressRawFrame(pixelData_ + frameNo * frameSize_, bitsAllocated_, columns_, rows_,
+        samplesPerPixel_, planarConfiguration_, photometricInterpretation_, compressedData, compressedLen, djcp_);
+  }
+
+private:
+
+  /* private undefined copy constructor */
+  DJLSFrameEncoder(const DJLSFrameEncoder&);
+
+  /* private undefined copy assignment operator */
+  DJLSFrameEncoder& operator=(const DJLSFrameEncoder&);
+
+  /* the codec performing the compression */
+  const DJLSEncoderBase &codec_;
+
+  /* parameters for the codec */
+  const DJLSCodecParameter *djcp_;
+
+  /* pointer to the uncompressed pixel data of all frames (raw mode) */
+  const Uint8 *pixelData_;
+
+  /* size of an uncompressed frame in bytes (raw mode) */
+  unsigned long frameSize_;
+
+  /* number of bits allocated per sample (raw mode) */
+  Uint16 bitsAllocated_;
+
+  /* width of the image (raw mode) */
+  Uint16 columns_;
+
+  /* height of the image (raw mode) */
+  Uint16 rows_;
+
+  /* number of samples per pixel (raw mode) */
+  Uint16 samplesPerPixel_;
+
+  /* planar configuration of the pixel data (raw mode) */
+  Uint16 planarConfiguration_;
+
+  /* photometric interpretation of the DICOM dataset */
+  OFString photometricInterpretation_;
+
+  /* image providing the intermediate pixel data (cooked mode) */
+  DicomImage *dimage_;
+
+  /* maximum deviation for near-lossless encoding (cooked mode) */
+  Uint16 nearLosslessDeviation_;
+};
+
+
 E_TransferSyntax DJLSLosslessEncoder::supportedTransferSyntax() const
 {
   return EXS_JPEGLSLossless;
@@ -505,8 +630,7 @@ OFCondition DJLSEncoderBase::losslessRawEncode(
   }
 
   DcmOffsetList offsetList;
-  unsigned long compressedSize = 0;
-  unsigned long compressedFrameSize = 0;
+  size_t compressedSize = 0;
   double uncompressedSize = 0.0;
 
   // render and compress each frame
@@ -527,17 +651,11 @@ OFCondition DJLSEncoderBase::losslessRawEncode(
     // compute original image size in bytes, ignoring any padding bits.
     uncompressedSize = columns * rows * samplesPerPixel * bitsStored * frameCount / 8.0;
 
-    for (unsigned long i=0; (i<frameCount) && (result.good()); ++i)
-    {
-      // compress frame
-      DCMJPLS_DEBUG("JPEG-LS encoder processes frame " << (i+1) << " of " << frameCount);
-      result = compressRawFrame(framePointer, bitsAllocated, columns, rows,
-          samplesPerPixel, planarConfiguration, photometricInterpretation,
-          pixelSequence, offsetList, compressedFrameSize, djcp);
-
-      compressedSize += compressedFrameSize;
-      framePointer += frameSize;
-    }
+    // compress each frame, possibly concurrently
+    DJLSFrameEncoder frameEncoder(*this, djcp, framePointer, frameSize, bitsAllocated, columns, rows,
+        samplesPerPixel, planarConfiguration, photometricInterpretation);
+    result = frameEncoder.encodeFrames(OFstatic_cast(Uint32, frameCount), pixelSequence, offsetList,
+        djcp->getFragmentSize(), compressedSize);
   }
 
   // store pixel sequence if everything went well.
@@ -649,15 +767,13 @@ OFCondition DJLSEncoderBase::compressRawFrame(
   Uint16 samplesPerPixel,
   Uint16 planarConfiguration,
   const OFString& /* photometricInterpretation */,
-  DcmPixelSequence *pixelSequence,
-  DcmOffsetList &offsetList,
-  unsigned long &compressedSize,
+  Uint8 *&compressedFrame,
+  Uint32 &compressedSize,
   const DJLSCodecParameter *djcp) const
 {
   OFCondition result = EC_Normal;
   Uint16 bytesAllocated = bitsAllocated / 8;
   Uint32 frameSize = width*height*bytesAllocated*samplesPerPixel;
-  Uint32 fragmentSize = djcp->getFragmentSize();
   JlsParameters jls_params;
   Uint8 *frameBuffer = NULL;
 
@@ -762,12 +878,13 @@ OFCondition DJLSEncoderBase::compressRawFrame(
 
     if (result.good())
     {
-      compressedSize = OFstatic_cast(unsigned long, bytesWritten);
-      fixPaddingIfNecessary(OFstatic_cast(Uint8 *, buffer), size, compressedSize, djcp->getUseFFbitstreamPadding());
-      result = pixelSequence->storeCompressedFrame(offsetList, buffer, compressedSize, fragmentSize);
+      unsigned long bufferSize = OFstatic_cast(unsigned long, bytesWritten);
+      fixPaddingIfNecessary(OFstatic_cast(Uint8 *, buffer), size, bufferSize, djcp->getUseFFbitstreamPadding());
+      // ownership of the buffer is transferred to the caller
+      compressedFrame = buffer;
+      compressedSize = OFstatic_cast(Uint32, bufferSize);
     }
-
-    delete[] buffer;
+    else delete[] buffer;
   }
 
   if (frameBuffer)
@@ -884,8 +1001,7 @@ OFCondition DJLSEncoderBase::losslessCookedEncode(
   }
 
   DcmOffsetList offsetList;
-  unsigned long compressedSize = 0;
-  unsigned long compressedFrameSize = 0;
+  size_t compressedSize = 0;
   double uncompressedSize = 0.0;
 
   // render and compress each frame
@@ -899,15 +1015,10 @@ OFCondition DJLSEncoderBase::losslessCookedEncode(
     uncompressedSize = dimage->getWidth() * dimage->getHeight() *
       bitsPerSample * frameCount * samplesPerPixel / 8.0;
 
-    for (unsigned long i=0; (i<frameCount) && (result.good()); ++i)
-    {
-      // compress frame
-      DCMJPLS_DEBUG("JPEG-LS encoder processes frame " << (i+1) << " of " << frameCount);
-      result = compressCookedFrame(pixelSequence, dimage,
-          photometricInterpretation, offsetList, compressedFrameSize, djcp, i, nearLosslessDeviation);
-
-      compressedSize += compressedFrameSize;
-    }
+    // compress each frame, possibly concurrently
+    DJLSFrameEncoder frameEncoder(*this, djcp, dimage, photometricInterpretation, nearLosslessDeviation);
+    result = frameEncoder.encodeFrames(OFstatic_cast(Uint32, frameCount), pixelSequence, offsetList,
+        djcp->getFragmentSize(), compressedSize);
   }
 
   // store pixel sequence if everything went well.
@@ -957,11 +1068,10 @@ OFCondition DJLSEncoderBase::losslessCookedEncode(
 
 
 OFCondition DJLSEncoderBase::compressCookedFrame(
-  DcmPixelSequence *pixelSequence,
   DicomImage *dimage,
   const OFString& /* photometricInterpretation */,
-  DcmOffsetList &offsetList,
-  unsigned long &compressedSize,
+  Uint8 *&compressedFrame,
+  Uint32 &compressedSize,
   const DJLSCodecParameter *djcp,
   Uint32 frame,
   Uint16 nearLosslessDeviation) const
@@ -974,8 +1084,6 @@ OFCondition DJLSEncoderBase::compressCookedFrame(
   int depth = dimage->getDepth();
   if ((depth < 1) || (depth > 16)) return EC_JLSUnsupportedBitDepth;
 
-  Uint32 fragmentSize = djcp->getFragmentSize();
-
   const DiPixel *dinter = dimage->getInterData();
   if (dinter == NULL) return EC_IllegalCall;
 
@@ -1185,13 +1293,15 @@ OFCondition DJLSEncoderBase::compressCookedFrame(
   if (result.good())
   {
     // 'compressed_buffer_size' now contains the size of the compressed data in buffer
-    compressedSize = OFstatic_cast(unsigned long, bytesWritten);
-    fixPaddingIfNecessary(OFstatic_cast(Uint8 *, compressed_buffer), compressed_buffer_size, compressedSize, djcp->getUseFFbitstreamPadding());
-    result = pixelSequence->storeCompressedFrame(offsetList, compressed_buffer, compressedSize, fragmentSize);
+    unsigned long bufferSize = OFstatic_cast(unsigned long, bytesWritten);
+    fixPaddingIfNecessary(OFstatic_cast(Uint8 *, compressed_buffer), compressed_buffer_size, bufferSize, djcp->getUseFFbitstreamPadding());
+    // ownership of the buffer is transferred to the caller
+    compressedFrame = compressed_buffer;
+    compressedSize = OFstatic_cast(Uint32, bufferSize);
   }
+  else delete[] compressed_buffer;
 
   delete[] buffer;
-  delete[] compressed_buffer;
   if (frameBuffer)
     delete[] frameBuffer;
 
@@ -153,6 +153,8 @@ int main(int argc, char *argv[])
       cmd.addSubGroup("storage mode:");
         cmd.addOption("--normal",              "-B",      "allow implicit format conversions (default)");
         cmd.addOption("--bit-preserving",      "+B",      "write dataset exactly as received");
+        cmd.addOption("--streaming",           "+Bs",     "write dataset exactly as received while\n"
+                                                          "extracting attributes needed for naming");
         cmd.addOption("--ignore",                         "ignore dataset, receive but do not store it");
 
     /* evaluate command line */
@@ -269,6 +271,8 @@ int main(int argc, char *argv[])
             app.checkConflict("--bit-preserving", "--series-date-subdir", opt_directoryGeneration == DcmStorageSCP::DGM_SeriesDate);
             opt_datasetStorage = DcmStorageSCP::DGM_StoreBitPreserving;
         }
+        if (cmd.findOption("--streaming"))
+            opt_datasetStorage = DcmStorageSCP::DSM_StoreStreaming;
         if (cmd.findOption("--ignore"))
             opt_datasetStorage = DcmStorageSCP::DSM_Ignore;
         cmd.endOptionBlock();
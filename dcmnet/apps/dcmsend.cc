@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2024, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -120,6 +120,10 @@ int main(int argc, char *argv[])
     OFCmdUnsignedInt opt_acseTimeout = 30;
     OFCmdUnsignedInt opt_maxReceivePDULength = ASC_DEFAULTMAXPDU;
     OFCmdUnsignedInt opt_maxSendPDULength = 0;
+    OFCmdUnsignedInt opt_asyncWindow = 1;
+    OFCmdUnsignedInt opt_numAssociations = 1;
+    OFCmdUnsignedInt opt_associationRetries = 0;
+    DcmStorageSCU::E_PartitionMode opt_partitionMode = DcmStorageSCU::PM_byStudy;
     T_DIMSE_BlockingMode opt_blockMode = DIMSE_BLOCKING;
 #ifdef WITH_ZLIB
     OFCmdUnsignedInt opt_compressionLevel = 0;
@@ -200,6 +204,16 @@ int main(int argc, char *argv[])
       cmd.addSubGroup("association handling:");
         cmd.addOption("--multi-associations",  "+ma",     "use multiple associations (one after the other)\nif needed to transfer the instances (default)");
         cmd.addOption("--single-association",  "-ma",     "always use a single association");
+        cmd.addOption("--async-window",        "-aw",  1, "[n]umber: integer (1..65535, default: 1)",
+                                                          "propose asynchronous operations window, i.e.\nsend up to n C-STORE requests without waiting\nfor the responses");
+#ifdef WITH_THREADS
+        cmd.addOption("--parallel-associations", "+pa", 1, "[n]umber: integer (2..64)",
+                                                          "send on up to n concurrent associations");
+        cmd.addOption("--partition-study",     "+ps",     "send all instances of a study on the same\nassociation (default, only with +pa)");
+        cmd.addOption("--partition-round-robin", "+pr",   "distribute the instances to the associations\nin turn (only with +pa)");
+        cmd.addOption("--association-retries", "+ar",  1, "[n]umber: integer (default: 0)",
+                                                          "start up to n new associations after a failed\none (only with +pa)");
+#endif
       cmd.addSubGroup("other network options:");
         cmd.addOption("--timeout",             "-to",  1, "[s]econds: integer (default: unlimited)",
                                                           "timeout for connection requests");
@@ -342,6 +356,32 @@ int main(int argc, char *argv[])
             app.checkValue(cmd.getValueAndCheckMin(opt_dimseTimeout, 1));
             opt_blockMode = DIMSE_NONBLOCKING;
         }
+        if (cmd.findOption("--async-window"))
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_asyncWindow, 1, 65535));
+#ifdef WITH_THREADS
+        if (cmd.findOption("--parallel-associations"))
+        {
+            app.checkConflict("--parallel-associations", "--single-association", !opt_multipleAssociations);
+            app.checkValue(cmd.getValueAndCheckMinMax(opt_numAssociations, 2, 64));
+        }
+        cmd.beginOptionBlock();
+        if (cmd.findOption("--partition-study"))
+        {
+            app.checkDependence("--partition-study", "--parallel-associations", opt_numAssociations > 1);
+            opt_partitionMode = DcmStorageSCU::PM_byStudy;
+        }
+        if (cmd.findOption("--partition-round-robin"))
+        {
+            app.checkDependence("--partition-round-robin", "--parallel-associations", opt_numAssociations > 1);
+            opt_partitionMode = DcmStorageSCU::PM_roundRobin;
+        }
+        cmd.endOptionBlock();
+        if (cmd.findOption("--association-retries"))
+        {
+            app.checkDependence("--association-retries", "--parallel-associations", opt_numAssociations > 1);
+            app.checkValue(cmd.getValue(opt_associationRetries));
+        }
+#endif
         if (cmd.findOption("--max-pdu"))
             app.checkValue(cmd.getValueAndCheckMinMax(opt_maxReceivePDULength, ASC_MINIMUMPDUSIZE, ASC_MAXIMUMPDUSIZE));
         if (cmd.findOption("--max-send-pdu"))
@@ -468,6 +508,7 @@ int main(int argc, char *argv[])
     storageSCU.setHaltOnUnsuccessfulStoreMode(opt_haltOnUnsuccessfulStore);
     storageSCU.setAllowIllegalProposalMode(opt_allowIllegalProposal);
     storageSCU.setProtocolVersion(opt_protocolVersion);
+    storageSCU.setAsyncOperationsWindow(OFstatic_cast(Uint16, opt_asyncWindow));
 
     /* output information on the single/multiple associations setting */
     if (opt_multipleAssociations)
@@ -477,79 +518,93 @@ int main(int argc, char *argv[])
         OFLOG_DEBUG(dcmsendLogger, "only a single associations allowed (option --single-association used)");
     }
 
-    /* add presentation contexts to be negotiated (if there are still any) */
-    while ((status = storageSCU.addPresentationContexts()).good())
+    /* send the SOP instances on concurrent associations (if requested) */
+    if (opt_numAssociations > 1)
     {
-        if (opt_multipleAssociations)
-        {
-            /* output information on the start of the new association */
-            if (dcmsendLogger.isEnabledFor(OFLogger::DEBUG_LOG_LEVEL))
-            {
-                OFLOG_DEBUG(dcmsendLogger, OFString(65, '-') << OFendl
-                    << "starting association #" << (storageSCU.getAssociationCounter() + 1));
-            } else {
-                OFLOG_INFO(dcmsendLogger, "starting association #" << (storageSCU.getAssociationCounter() + 1));
-            }
-        }
-        OFLOG_INFO(dcmsendLogger, "initializing network ...");
-        /* initialize network */
-        status = storageSCU.initNetwork();
+        OFLOG_INFO(dcmsendLogger, "sending SOP instances on up to " << opt_numAssociations << " concurrent associations ...");
+        status = storageSCU.sendSOPInstancesInParallel(OFstatic_cast(size_t, opt_numAssociations), opt_partitionMode,
+            OFstatic_cast(unsigned int, opt_associationRetries));
         if (status.bad())
         {
-            OFLOG_FATAL(dcmsendLogger, "cannot initialize network: " << status.text());
+            OFLOG_FATAL(dcmsendLogger, "cannot send SOP instances: " << status.text());
             cleanup();
-            return EXITCODE_CANNOT_INITIALIZE_NETWORK;
+            return EXITCODE_CANNOT_SEND_REQUEST;
         }
-        OFLOG_INFO(dcmsendLogger, "negotiating network association ...");
-        /* negotiate network association with peer */
-        status = storageSCU.negotiateAssociation();
-        if (status.bad())
+    } else {
+        /* add presentation contexts to be negotiated (if there are still any) */
+        while ((status = storageSCU.addPresentationContexts()).good())
         {
-            // check whether we can continue with a new association
-            if (status == NET_EC_NoAcceptablePresentationContexts)
+            if (opt_multipleAssociations)
             {
-                OFLOG_ERROR(dcmsendLogger, "cannot negotiate network association: " << status.text());
-                // check whether there are any SOP instances to be sent
-                const size_t numToBeSent = storageSCU.getNumberOfSOPInstancesToBeSent();
-                if (numToBeSent > 0)
+                /* output information on the start of the new association */
+                if (dcmsendLogger.isEnabledFor(OFLogger::DEBUG_LOG_LEVEL))
                 {
-                    OFLOG_WARN(dcmsendLogger, "trying to continue with a new association "
-                        << "in order to send the remaining " << numToBeSent << " SOP instances");
+                    OFLOG_DEBUG(dcmsendLogger, OFString(65, '-') << OFendl
+                        << "starting association #" << (storageSCU.getAssociationCounter() + 1));
+                } else {
+                    OFLOG_INFO(dcmsendLogger, "starting association #" << (storageSCU.getAssociationCounter() + 1));
                 }
-            } else {
-                OFLOG_FATAL(dcmsendLogger, "cannot negotiate network association: " << status.text());
+            }
+            OFLOG_INFO(dcmsendLogger, "initializing network ...");
+            /* initialize network */
+            status = storageSCU.initNetwork();
+            if (status.bad())
+            {
+                OFLOG_FATAL(dcmsendLogger, "cannot initialize network: " << status.text());
                 cleanup();
-                return EXITCODE_CANNOT_NEGOTIATE_ASSOCIATION;
+                return EXITCODE_CANNOT_INITIALIZE_NETWORK;
             }
-        }
-        if (status.good())
-        {
-            OFLOG_INFO(dcmsendLogger, "sending SOP instances ...");
-            /* send SOP instances to be transferred */
-            status = storageSCU.sendSOPInstances();
+            OFLOG_INFO(dcmsendLogger, "negotiating network association ...");
+            /* negotiate network association with peer */
+            status = storageSCU.negotiateAssociation();
             if (status.bad())
             {
-                OFLOG_FATAL(dcmsendLogger, "cannot send SOP instance: " << status.text());
-                // handle certain error conditions (initiated by the communication peer)
-                if (status == DUL_PEERREQUESTEDRELEASE)
+                // check whether we can continue with a new association
+                if (status == NET_EC_NoAcceptablePresentationContexts)
                 {
-                    // peer requested release (aborting)
-                    storageSCU.closeAssociation(DCMSCU_PEER_REQUESTED_RELEASE);
+                    OFLOG_ERROR(dcmsendLogger, "cannot negotiate network association: " << status.text());
+                    // check whether there are any SOP instances to be sent
+                    const size_t numToBeSent = storageSCU.getNumberOfSOPInstancesToBeSent();
+                    if (numToBeSent > 0)
+                    {
+                        OFLOG_WARN(dcmsendLogger, "trying to continue with a new association "
+                            << "in order to send the remaining " << numToBeSent << " SOP instances");
+                    }
+                } else {
+                    OFLOG_FATAL(dcmsendLogger, "cannot negotiate network association: " << status.text());
+                    cleanup();
+                    return EXITCODE_CANNOT_NEGOTIATE_ASSOCIATION;
                 }
-                else if (status == DUL_PEERABORTEDASSOCIATION)
+            }
+            if (status.good())
+            {
+                OFLOG_INFO(dcmsendLogger, "sending SOP instances ...");
+                /* send SOP instances to be transferred */
+                status = storageSCU.sendSOPInstances();
+                if (status.bad())
                 {
-                    // peer aborted the association
-                    storageSCU.closeAssociation(DCMSCU_PEER_ABORTED_ASSOCIATION);
+                    OFLOG_FATAL(dcmsendLogger, "cannot send SOP instance: " << status.text());
+                    // handle certain error conditions (initiated by the communication peer)
+                    if (status == DUL_PEERREQUESTEDRELEASE)
+                    {
+                        // peer requested release (aborting)
+                        storageSCU.closeAssociation(DCMSCU_PEER_REQUESTED_RELEASE);
+                    }
+                    else if (status == DUL_PEERABORTEDASSOCIATION)
+                    {
+                        // peer aborted the association
+                        storageSCU.closeAssociation(DCMSCU_PEER_ABORTED_ASSOCIATION);
+                    }
+                    cleanup();
+                    return EXITCODE_CANNOT_SEND_REQUEST;
                 }
-                cleanup();
-                return EXITCODE_CANNOT_SEND_REQUEST;
             }
+            /* close current network association */
+            storageSCU.releaseAssociation();
+            /* check whether multiple associations are permitted */
+            if (!opt_multipleAssociations)
+                break;
         }
-        /* close current network association */
-        storageSCU.releaseAssociation();
-        /* check whether multiple associations are permitted */
-        if (!opt_multipleAssociations)
-            break;
     }
 
     /* if anything went wrong, report it to the logger */
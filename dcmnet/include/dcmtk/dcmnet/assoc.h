@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2025, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -105,12 +105,14 @@
 
 /*
  * There have been reports that smaller PDUs work better in some environments.
- * Allow a 4K minimum and a 128K maximum. Any further extension requires
- * modifications in the DUL code.
+ * Allow a 4K minimum and a 16M maximum. Large PDUs reduce the per-PDU overhead
+ * on high-bandwidth links; the receive buffer is only allocated when needed.
+ * Any further extension requires modifications in the DUL code.
  */
 #define ASC_DEFAULTMAXPDU       16384 /* 16K is default if nothing else specified */
 #define ASC_MINIMUMPDUSIZE       4096
-#define ASC_MAXIMUMPDUSIZE     131072 /* 128K - we only handle this big */
+#define ASC_MAXIMUMPDUSIZE   16777216 /* 16M - we only handle this big */
+#define ASC_UNLIMITEDPDUSENDSIZE 131072 /* 128K are sent if the peer does not limit the PDU size */
 
 /*
 ** Type Definitions
@@ -642,6 +644,46 @@ ASC_getCopyOfIdentResponse(T_ASC_Parameters * params,
                            char*& buffer,
                            unsigned short& bufferLen);
 
+/* asynchronous operations window negotiation */
+
+/** sets the asynchronous operations window to be sent in the association
+ *  request (association requestor) or in the association acknowledgement
+ *  (association acceptor). If both values are 0, which is the default,
+ *  no asynchronous operations window sub-item is sent at all, i.e. only
+ *  synchronous operations are used. An acceptor should only respond with
+ *  a window if the requestor has proposed one, and the values should not
+ *  exceed the proposed ones.
+ *  @param params - [in/out] The association parameters to be filled
+ *  @param maxOpsInvoked - [in] Maximum number of outstanding operations that
+ *    the association requestor may invoke (0 = unlimited)
+ *  @param maxOpsPerformed - [in] Maximum number of outstanding operations that
+ *    the association requestor can perform (0 = unlimited)
+ *  @return EC_Normal if successful, an error code otherwise
+ */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_setAsyncOperationsWindow(
+    T_ASC_Parameters * params,
+    unsigned short maxOpsInvoked,
+    unsigned short maxOpsPerformed);
+
+/** returns the asynchronous operations window received from the peer, i.e.
+ *  the proposal of the association requestor or the response of the
+ *  association acceptor. If the peer did not send an asynchronous operations
+ *  window sub-item, the default of 1 (synchronous operations only) is
+ *  returned for both values.
+ *  @param params - [in] The association parameters to read from
+ *  @param maxOpsInvoked - [out] Maximum number of outstanding operations
+ *    invoked by the association requestor (0 = unlimited)
+ *  @param maxOpsPerformed - [out] Maximum number of outstanding operations
+ *    performed by the association requestor (0 = unlimited)
+ *  @return EC_Normal if successful, an error code otherwise
+ */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_getAsyncOperationsWindow(
+    T_ASC_Parameters * params,
+    unsigned short& maxOpsInvoked,
+    unsigned short& maxOpsPerformed);
+
 /* TLS/SSL */
 
 /* get peer certificate from open association */
@@ -652,6 +694,36 @@ DCMTK_DCMNET_EXPORT unsigned long ASC_getPeerCertificate(T_ASC_Association *asso
 DCMTK_DCMNET_EXPORT OFCondition
 ASC_setTransportLayer(T_ASC_Network *network, DcmTransportLayer *newLayer, int takeoverOwnership);
 
+/** sets the length of the TCP send and receive buffers (socket options SO_SNDBUF
+ *  and SO_RCVBUF) for all transport connections of the given network. Large
+ *  buffers increase the throughput on links with a high bandwidth-delay product.
+ *  For an acceptor network, the buffer lengths are also applied to the listen
+ *  socket, so that they are already effective during the TCP handshake.
+ *  @param network - [in] The network to be configured
+ *  @param sendBufferLength - [in] TCP send buffer length in bytes,
+ *    0 = environment variable TCP_BUFFER_LENGTH or system default
+ *  @param receiveBufferLength - [in] TCP receive buffer length in bytes,
+ *    0 = environment variable TCP_BUFFER_LENGTH or system default
+ *  @return EC_Normal if successful, an error code otherwise
+ */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_setTCPBufferLength(
+    T_ASC_Network *network,
+    unsigned long sendBufferLength,
+    unsigned long receiveBufferLength);
+
+/** enables or disables the socket option TCP_NODELAY (i.e. disables or enables
+ *  the Nagle algorithm) for all transport connections of the given network.
+ *  @param network - [in] The network to be configured
+ *  @param noDelay - [in] 1 = set TCP_NODELAY, 0 = do not set TCP_NODELAY,
+ *    -1 = environment variable TCP_NODELAY or compile-time default
+ *  @return EC_Normal if successful, an error code otherwise
+ */
+DCMTK_DCMNET_EXPORT OFCondition
+ASC_setTCPNoDelay(
+    T_ASC_Network *network,
+    int noDelay);
+
 enum ASC_associateType
 {
     ASC_ASSOC_RQ,
@@ -197,13 +197,15 @@ public:
    */
   static OFBool selectReadableAssociation(DcmTransportConnection *connections[], int connCount, int timeout);
 
-protected:
-
   /** returns the socket file descriptor managed by this object.
+   *  Note that for secure connections, data may be available for reading
+   *  even if the socket is not readable, see networkDataAvailable().
    *  @return socket file descriptor
    */
   DcmNativeSocketType getSocket() { return theSocket; }
 
+protected:
+
   /** set the socket file descriptor managed by this object.
    *  @param socket file descriptor
    */
@@ -91,6 +91,9 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCP
         DGM_StoreBitPreserving,
         /// receive dataset in memory, but do not store it to file
         DSM_Ignore,
+        /// receive dataset directly to file, i.e. write data exactly as received, but
+        /// extract the attributes needed for naming the file while receiving it
+        DSM_StoreStreaming,
         /// default value
         DSM_Default = DGM_StoreToFile
     };
@@ -242,13 +245,36 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCP
     virtual OFCondition generateSTORERequestFilename(const T_DIMSE_C_StoreRQ &reqMessage,
                                                      OFString &filename);
 
+    /** receive the dataset of the given C-STORE request and store it directly to a DICOM
+     *  file, i.e. exactly as received.  While the dataset is received, its beginning (up to
+     *  the Study ID (0020,0010), which covers e.g. the SOP, Study and Series Instance UIDs
+     *  as well as the various dates) is parsed incrementally, and the file is created as
+     *  soon as these attributes are available.  This way, the directory and file name can
+     *  be generated from the dataset (e.g. in mode DGM_SeriesDate) without ever keeping
+     *  more than the beginning of the dataset in memory.  This method is called by
+     *  handleIncomingCommand() if the storage mode is DSM_StoreStreaming.
+     *  @param  reqMessage  C-STORE request message data structure
+     *  @param  presInfo    additional information on the Presentation Context used
+     *  @param  filename    reference to variable that will store the name of the file
+     *                      created (with full path)
+     *  @param  metadata    reference to dataset that will contain the attributes
+     *                      extracted from the beginning of the received dataset
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition receiveAndStoreSTORERequest(T_DIMSE_C_StoreRQ &reqMessage,
+                                                    const DcmPresentationContextInfo &presInfo,
+                                                    OFString &filename,
+                                                    DcmDataset &metadata);
+
     /** notification handler that is called for each DICOM object that has been received
      *  with a C-STORE request and stored as a DICOM file
      *  @param  filename        filename (with full path) of the object stored
      *  @param  sopClassUID     SOP Class UID of the object stored
      *  @param  sopInstanceUID  SOP Instance UID of the object stored
      *  @param  dataset         pointer to dataset of the object stored (or NULL if the
-     *                          dataset has been stored directly to file).
+     *                          dataset has been stored directly to file).  In streaming
+     *                          mode, only the attributes extracted while receiving the
+     *                          dataset are available.
      *                          Please note that this dataset will be deleted by the calling
      *                          method, so do not store any references to it!
      */
@@ -298,6 +324,8 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCP
 
 private:
 
+    friend class DcmStorageSCPStreamingConsumer;
+
     /// name of the output directory that is used to store the received datasets
     OFString OutputDirectory;
     /// name of the subdirectory that might be used for the "normal" case, i.e.\ if the
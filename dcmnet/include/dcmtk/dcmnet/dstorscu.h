@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2024, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -25,6 +25,7 @@
 #include "dcmtk/config/osconfig.h"  /* make sure OS specific configuration is included first */
 
 #include "dcmtk/dcmnet/scu.h"       /* for base class DcmSCU */
+#include "dcmtk/ofstd/ofvector.h"  /* for class OFVector */
 
 
 /*---------------------*
@@ -91,6 +92,17 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCU
         HM_deleteAfterRemove
     };
 
+    /** modes for partitioning the transfer list if SOP instances are sent on concurrent
+     *  associations (see sendSOPInstancesInParallel())
+     */
+    enum E_PartitionMode
+    {
+        /// send all SOP instances of a study on the same association
+        PM_byStudy,
+        /// distribute the SOP instances to the associations in turn
+        PM_roundRobin
+    };
+
     /** default constructor
      */
     DcmStorageSCU();
@@ -335,10 +347,51 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCU
      *  The sending process can be stopped by overwriting shouldStopAfterCurrentSOPInstance()
      *  in a derived class.  The sending process can be continued with the next SOP instance
      *  by calling sendSOPInstances() again.
+     *  If an asynchronous operations window has been negotiated for the current association
+     *  (see DcmSCU::setAsyncOperationsWindow()), further C-STORE requests are sent without
+     *  waiting for the previous responses, as long as the number of outstanding requests does
+     *  not exceed the window.  The responses are matched to the SOP instances by their
+     *  message ID, and notifySOPInstanceSent() is called when the response has been received,
+     *  i.e. possibly in a different order than the SOP instances were sent.
      *  @return status, EC_Normal if successful, an error code otherwise
      */
     OFCondition sendSOPInstances();
 
+    /** send all SOP instances from the transfer list that are not yet sent to the specified
+     *  peer, using a number of concurrent associations.  The transfer list is partitioned
+     *  according to the given mode and each partition is sent by a separate thread, which
+     *  negotiates its own associations (more than one if needed, see
+     *  addPresentationContexts()) and releases them when done.  In contrast to
+     *  sendSOPInstances(), this method, therefore, handles the complete transfer process.
+     *  The network parameters of this object (e.g.\ AE titles, peer host and port, timeouts,
+     *  maximum PDU size and asynchronous operations window) are used for all associations.
+     *  The notification methods notifySOPInstanceToBeSent() and notifySOPInstanceSent() as
+     *  well as shouldStopAfterCurrentSOPInstance() are called for this object, one at a time,
+     *  i.e.\ a derived class can use them for reporting the overall progress without any
+     *  further synchronization.  The association number of the transfer entries counts the
+     *  associations of all threads.
+     *  If an association cannot be negotiated or fails while sending (e.g.\ because the peer
+     *  aborted it), a new association is started for the remaining SOP instances of this
+     *  partition, up to the given number of retries.  If the failure persists, the other
+     *  partitions are still sent unless the "halt on unsuccessful store" mode is enabled
+     *  (see setHaltOnUnsuccessfulStoreMode()).
+     *  @note Secure (TLS) connections are not supported by this method.  Also, the same
+     *    dataset must not be added to the transfer list more than once, since it might be
+     *    processed by two threads at the same time.  If the toolkit is compiled without
+     *    thread support, the partitions are sent one after the other.
+     *  @param  numAssociations  maximum number of concurrent associations (at least 1).  If
+     *                           there are fewer partitions, e.g.\ because there are fewer
+     *                           studies, the number of associations is reduced accordingly.
+     *  @param  partitionMode    mode specifying how to partition the transfer list
+     *  @param  maxRetries       maximum number of new associations that are started for a
+     *                           partition after a failed one (default: 0, i.e.\ no retry)
+     *  @return status, EC_Normal if successful, an error code otherwise.  If the transfer
+     *    failed for more than one partition, the error of the first one is returned.
+     */
+    OFCondition sendSOPInstancesInParallel(const size_t numAssociations,
+                                           const E_PartitionMode partitionMode = PM_byStudy,
+                                           const unsigned int maxRetries = 0);
+
     /** get some status information on the overall sending process.  This text can for example
      *  be output to the logger (on the level at the user's option).
      *  @param  summary  reference to a string in which the summary is stored
@@ -430,6 +483,8 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCU
         unsigned long AssociationNumber;
         /// presentation context ID to be used for sending this SOP instance
         T_ASC_PresentationContextID PresentationContextID;
+        /// message ID of the C-STORE request (only set for asynchronous operations)
+        Uint16 MessageID;
         /// flag indicating whether the C-STORE request has been sent (OFTrue = sent)
         OFBool RequestSent;
         /// DIMSE status of the C-STORE response (0x0000 = success)
@@ -513,6 +568,64 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCU
 
   private:
 
+    /// shared state of the threads sending SOP instances on concurrent associations
+    struct ParallelContext;
+    /// thread sending one partition of the transfer list (on its own associations)
+    class ParallelWorker;
+
+    /** load the dataset of the SOP instance to be sent (if needed), check it for consistency
+     *  with the transfer list and notify the user of this class that the SOP instance is to
+     *  be sent.
+     *  @param  transferEntry  reference to current transfer entry that will be processed
+     *  @param  fileformat     file format object used to load the SOP instance from file
+     *  @param  dataset        pointer to the dataset to be sent (output value)
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition prepareSOPInstance(TransferEntry &transferEntry,
+                                   DcmFileFormat &fileformat,
+                                   DcmDataset *&dataset);
+
+    /** update the transfer entry after the C-STORE response has been received (or sending
+     *  failed) and notify the user of this class that the SOP instance has been processed.
+     *  @param  transferEntry  reference to current transfer entry that has been processed
+     *  @param  status         status of the C-STORE operation.  Reset to EC_Normal if the
+     *                         error should be ignored (see setHaltOnUnsuccessfulStoreMode()).
+     */
+    void finishSOPInstance(TransferEntry &transferEntry,
+                           OFCondition &status);
+
+    /** send SOP instances using asynchronous operations, i.e.\ without waiting for the
+     *  C-STORE response before the next request is sent.  Called by sendSOPInstances() if
+     *  an asynchronous operations window has been negotiated.
+     *  @param  maxOutstanding  maximum number of outstanding requests
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition sendSOPInstancesAsync(const size_t maxOutstanding);
+
+    /** check whether the sending process should be stopped after the current SOP instance.
+     *  Calls shouldStopAfterCurrentSOPInstance() of this object or, for a partition sent on
+     *  a concurrent association, of the object that started the transfer.
+     *  @return OFTrue if sending should stop after current SOP instance, OFFalse otherwise
+     */
+    OFBool checkStopAfterCurrentSOPInstance();
+
+    /** send the SOP instances of this partition on as many associations as needed,
+     *  including negotiation and release.  Called by the threads started by
+     *  sendSOPInstancesInParallel().
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition sendPartition();
+
+    /** partition the SOP instances from the transfer list that are not yet sent
+     *  @param  numPartitions  maximum number of partitions
+     *  @param  partitionMode  mode specifying how to partition the transfer list
+     *  @param  partitions     list of partitions (output value).  Empty partitions are
+     *                         not added.
+     */
+    void partitionTransferList(const size_t numPartitions,
+                               const E_PartitionMode partitionMode,
+                               OFVector<OFList<TransferEntry *> > &partitions);
+
     /// association counter
     unsigned long AssociationCounter;
     /// presentation context counter
@@ -535,6 +648,9 @@ class DCMTK_DCMNET_EXPORT DcmStorageSCU
     OFList<TransferEntry *> TransferList;
     /// iterator pointing to the current entry in the list of SOP instances to be transferred
     OFListIterator(TransferEntry *) CurrentTransferEntry;
+    /// shared state if this object sends a partition of another object's transfer list
+    /// (NULL otherwise)
+    ParallelContext *Context;
 
     // private undefined copy constructor
     DcmStorageSCU(const DcmStorageSCU &);
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2024, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -216,6 +216,8 @@ typedef struct {
     char calledImplementationClassUID[DICOM_UI_LENGTH + 1];
     char calledImplementationVersionName[16 + 1];
     unsigned long peerMaxPDU;
+    unsigned short peerMaximumOperationsInvoked;
+    unsigned short peerMaximumOperationsPerformed;
     SOPClassExtendedNegotiationSubItemList *requestedExtNegList;
     SOPClassExtendedNegotiationSubItemList *acceptedExtNegList;
     UserIdentityNegotiationSubItemRQ *reqUserIdentNeg;
@@ -493,6 +495,18 @@ DUL_WritePDVs(DUL_ASSOCIATIONKEY ** association,
         DUL_PDVLIST * pdvList);
 DCMTK_DCMNET_EXPORT OFCondition DUL_NextPDV(DUL_ASSOCIATIONKEY ** association, DUL_PDV * pdv);
 
+/* Read the next P DATA PDU like DUL_ReadPDVs, but if it consists of a single
+** PDV whose fragment fits into the given buffer, read the fragment directly
+** from the network into that buffer and return the PDV in pdv. Otherwise,
+** the PDU is stored internally and pdv->data is set to NULL; the PDVs can then
+** be retrieved with DUL_NextPDV. Nothing is read (and EC_Normal is returned)
+** if PDVs of a previously received PDU are still pending.
+*/
+DCMTK_DCMNET_EXPORT OFCondition
+DUL_ReadPDVDirect(DUL_ASSOCIATIONKEY ** association,
+       void *buffer, unsigned long length, DUL_BLOCKOPTIONS block, int timeout,
+       DUL_PDV * pdv);
+
 
 /* Miscellaneous functions.
 */
@@ -522,6 +536,8 @@ DUL_dataWaiting(DUL_ASSOCIATIONKEY * callerAssociation, int timeout);
 
 DCMTK_DCMNET_EXPORT DcmNativeSocketType DUL_networkSocket(DUL_NETWORKKEY * callerNet);
 
+DCMTK_DCMNET_EXPORT DcmNativeSocketType DUL_associationSocket(DUL_ASSOCIATIONKEY * callerAssociation);
+
 DCMTK_DCMNET_EXPORT OFBool
 DUL_associationWaiting(DUL_NETWORKKEY * callerNet, int timeout);
 
@@ -537,6 +553,17 @@ DCMTK_DCMNET_EXPORT DcmTransportConnection *DUL_getTransportConnection(DUL_ASSOC
 /* change transport layer */
 DCMTK_DCMNET_EXPORT OFCondition DUL_setTransportLayer(DUL_NETWORKKEY *callerNetworkKey, DcmTransportLayer *newLayer, int takeoverOwnership);
 
+/* set the TCP send and receive buffer lengths (SO_SNDBUF, SO_RCVBUF) for all
+ * transport connections of the network (0 = environment variable TCP_BUFFER_LENGTH
+ * or system default)
+ */
+DCMTK_DCMNET_EXPORT OFCondition DUL_setTCPBufferLength(DUL_NETWORKKEY *callerNetworkKey, unsigned long sendBufferLength, unsigned long receiveBufferLength);
+
+/* enable (1) or disable (0) the TCP_NODELAY socket option for all transport
+ * connections of the network (-1 = environment variable TCP_NODELAY or default)
+ */
+DCMTK_DCMNET_EXPORT OFCondition DUL_setTCPNoDelay(DUL_NETWORKKEY *callerNetworkKey, int noDelay);
+
 /* activate compatibility mode and callback */
 DCMTK_DCMNET_EXPORT void DUL_activateCompatibilityMode(DUL_ASSOCIATIONKEY *dulassoc, unsigned long mode);
 DCMTK_DCMNET_EXPORT void DUL_activateCallback(DUL_ASSOCIATIONKEY *dulassoc, DUL_ModeCallback *cb);
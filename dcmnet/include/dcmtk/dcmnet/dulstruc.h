@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2017, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -102,6 +102,9 @@ typedef struct {
     int protocolState;
     int timeout;
     unsigned long options;
+    unsigned long tcpSendBufferLength;
+    unsigned long tcpReceiveBufferLength;
+    int tcpNoDelay;
     union {
   struct {
       int port;
@@ -149,8 +152,10 @@ typedef struct {
     unsigned long associatePDULength;
     DUL_PDV currentPDV;
     unsigned char *pdvPointer;
-    unsigned long fragmentBufferLength;
-    unsigned char *fragmentBuffer;
+    unsigned long fragmentBufferLength;    /* allocated size of fragmentBuffer */
+    unsigned char *fragmentBuffer;         /* allocated on demand, up to maxPDVInput + 100 bytes */
+    unsigned char *directBuffer;           /* caller's buffer for DUL_ReadPDVDirect(), NULL otherwise */
+    unsigned long directBufferLength;      /* size of directBuffer */
     DUL_ModeCallback *modeCallback;
 }   PRIVATE_ASSOCIATIONKEY;
 
@@ -243,7 +248,7 @@ typedef struct user_info {
     unsigned char rsv1;
     unsigned short length;
     DUL_MAXLENGTH maxLength;                             // 51H: maximum length
-    PRV_ASYNCOPERATIONS asyncOperations;                 // 53H: async operations (not yet implemented!)
+    PRV_ASYNCOPERATIONS asyncOperations;                 // 53H: asynchronous operations window
     DUL_SUBITEM implementationClassUID;                  // 52H: implementation class UID
     DUL_SUBITEM implementationVersionName;               // 55H: implementation version name
     LST_HEAD *SCUSCPRoleList;                            // 54H: SCP/SCU role selection
@@ -731,6 +731,38 @@ protected:
                                             const T_ASC_PresentationContextID presID,
                                             const OFString& filename);
 
+    /** Receive C-STORE request (and pass accompanying dataset to the given output stream).
+     *  The dataset is written exactly as received, i.e. without any conversions, and no
+     *  file meta information is added. This allows for processing the dataset while it
+     *  is being received, e.g. by an output stream whose consumer inspects the data and
+     *  decides on where to store it. Use createSTORERequestFile() if the dataset is to be
+     *  stored as a DICOM file.
+     *  @param reqMessage   [in] The C-STORE request message that was received
+     *  @param presID       [in] The presentation context to be used. By default, the
+     *                           presentation context of the request is used.
+     *  @param outputStream [in] The output stream the received dataset is written to
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    virtual OFCondition receiveSTORERequest(T_DIMSE_C_StoreRQ& reqMessage,
+                                            const T_ASC_PresentationContextID presID,
+                                            DcmOutputStream& outputStream);
+
+    /** Create a DICOM file for the dataset of the given C-STORE request and write the
+     *  file meta information to it. The meta information is derived from the request
+     *  message and the transfer syntax of the given presentation context, so the
+     *  dataset can be appended exactly as received.
+     *  @param reqMessage [in]  The C-STORE request message that was received
+     *  @param presID     [in]  The presentation context the request was received on
+     *  @param filename   [in]  Name of the file to be created
+     *  @param filestream [out] Output file stream for the remainder of the file, which
+     *                          has to be deleted by the caller. NULL in case of error.
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition createSTORERequestFile(const T_DIMSE_C_StoreRQ& reqMessage,
+                                       const T_ASC_PresentationContextID presID,
+                                       const OFString& filename,
+                                       DcmOutputFileStream*& filestream);
+
     /** Respond to the C-STORE request (with details from the request message)
      *  @param presID        [in] The presentation context ID to respond to
      *  @param reqMessage    [in] The C-STORE request that should be responded to
@@ -1082,6 +1114,15 @@ protected:
      */
     virtual OFCondition processAssociationRQ();
 
+    /** Negotiate an association request and either acknowledge or refuse it. In contrast to
+     *  processAssociationRQ(), incoming DIMSE commands are not handled by this function.
+     *  @param acknowledged [out] OFTrue if the association has been acknowledged, OFFalse
+     *                            if it has been refused or could not be acknowledged
+     *  @return EC_Normal if association could be processed, ASC_NULLKEY otherwise
+     *          (only if internal association structure is invalid, should never happen)
+     */
+    virtual OFCondition acknowledgeOrRefuseAssociationRQ(OFBool& acknowledged);
+
     /** This function checks all presentation contexts proposed by the SCU whether they are
      *  supported or not. It is not an error if no common presentation context could be
      *  identified with the SCU; only issues like problems in memory management etc. are
@@ -1102,6 +1143,22 @@ protected:
      */
     virtual void handleAssociation();
 
+    /** Receive a single DIMSE command on the current association and handle it by calling
+     *  handleIncomingCommand(). handleAssociation() calls this function repeatedly until
+     *  an error is returned.
+     *  @return EC_Normal if the command has been handled and the association continues,
+     *          DUL_PEERREQUESTEDRELEASE or DUL_PEERABORTEDASSOCIATION if the peer requested
+     *          the release of, or aborted, the association, another error code otherwise
+     */
+    virtual OFCondition receiveAndHandleCommand();
+
+    /** Clean up on association termination, i.e.\ acknowledge a release request, or abort
+     *  the association in case of an error, and call the corresponding notifier.
+     *  @param cond [in] The condition that terminated the association, i.e.\ the last
+     *                   result returned by receiveAndHandleCommand()
+     */
+    virtual void handleAssociationTermination(const OFCondition& cond);
+
     /** Send a DIMSE command and possibly also a dataset from a data object via network to
      *  another DICOM application
      *  @param presID          [in]  Presentation context ID to be used for message
@@ -1175,6 +1232,18 @@ protected:
                                            T_DIMSE_C_StoreRQ& reqMessage,
                                            const OFString& filename);
 
+    /** Receive one C-STORE request dataset via network from another DICOM application and
+     *  pass it to the given output stream (i.e.\ exactly as received without any conversions)
+     *  @param presID       [inout] Initially, the presentation context the C-STORE request
+     *                              was received on. Contains in the end the ID of the
+     *                              presentation context which was used in the PDVs that were
+     *                              received on the network.
+     *  @param outputStream [in]    The output stream the received dataset is written to
+     *  @return EC_Normal if dataset could be received successfully, an error code otherwise
+     */
+    OFCondition receiveSTORERequestDataset(T_ASC_PresentationContextID* presID,
+                                           DcmOutputStream& outputStream);
+
     /** Add given element to existing status detail object or create new one.
      *  @param statusDetail  The status detail to add the element to. Status detail
      *           is information additional to the DIMSE status code which can be
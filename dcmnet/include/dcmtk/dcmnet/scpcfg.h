@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2012-2025, OFFIS e.V.
+ *  Copyright (C) 2012-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -163,6 +163,35 @@ public:
    */
   void setMaxReceivePDULength(const Uint32 maxRecPDU);
 
+  /** Set the length of the TCP send and receive buffers (socket options SO_SNDBUF and
+   *  SO_RCVBUF) used for the SCP's transport connections. Large buffers (typically in
+   *  combination with a large maximum PDU size) increase the throughput on links with a
+   *  high bandwidth-delay product. DcmSCP's default is 0 for both values, i.e. the value
+   *  of the environment variable TCP_BUFFER_LENGTH or the system default is used.
+   *  @param sendBufferLength [in] TCP send buffer length in bytes (0 = default)
+   *  @param receiveBufferLength [in] TCP receive buffer length in bytes (0 = default)
+   */
+  void setTCPBufferLength(const Uint32 sendBufferLength,
+                          const Uint32 receiveBufferLength);
+
+  /** Set whether the socket option TCP_NODELAY is set for the SCP's transport
+   *  connections, i.e. whether the Nagle algorithm is disabled. DcmSCP's default is -1,
+   *  i.e. the environment variable TCP_NODELAY or the compile-time default is used.
+   *  @param noDelay [in] 1 = set TCP_NODELAY, 0 = do not set TCP_NODELAY, -1 = default
+   */
+  void setTCPNoDelay(const int noDelay);
+
+  /** Set the maximum asynchronous operations window granted to the SCU, i.e. the maximum
+   *  number of outstanding requests the SCU may invoke without waiting for the responses.
+   *  The window is only sent in the association response if the SCU has proposed one;
+   *  the smaller of both values is used then. Please note that the requests are still
+   *  processed one after the other by the SCP. DcmSCP's default is 1, i.e. only
+   *  synchronous operations are accepted.
+   *  @param maxOpsInvoked [in] Maximum number of outstanding operations invoked by the
+   *                            SCU (1 = synchronous operations only, 0 = unlimited)
+   */
+  void setAsyncOperationsWindow(const Uint16 maxOpsInvoked);
+
   /** Set whether waiting for a TCP/IP connection should be blocking or non-blocking.
    *  In non-blocking mode, the networking routines will wait for specified connection
    *  timeout, see setConnectionTimeout() function. In blocking mode, no timeout is set
@@ -265,6 +294,27 @@ public:
    */
   Uint32 getMaxReceivePDULength() const;
 
+  /** Returns the configured TCP send buffer length
+   *  @return TCP send buffer length in bytes (0 = default)
+   */
+  Uint32 getTCPSendBufferLength() const;
+
+  /** Returns the configured TCP receive buffer length
+   *  @return TCP receive buffer length in bytes (0 = default)
+   */
+  Uint32 getTCPReceiveBufferLength() const;
+
+  /** Returns the configured setting for the socket option TCP_NODELAY
+   *  @return 1 = set TCP_NODELAY, 0 = do not set TCP_NODELAY, -1 = default
+   */
+  int getTCPNoDelay() const;
+
+  /** Returns the maximum asynchronous operations window granted to the SCU
+   *  @return Maximum number of outstanding operations invoked by the SCU
+   *          (1 = synchronous operations only, 0 = unlimited)
+   */
+  Uint16 getAsyncOperationsWindow() const;
+
   /** Returns whether receiving of TCP/IP connection requests is done in blocking or
    *  unblocking mode
    *  @return DUL_BLOCK if in blocking mode, otherwise DUL_NOBLOCK
@@ -390,6 +440,22 @@ protected:
   /// association negotiation.
   Uint32 m_maxReceivePDULength;
 
+  /// TCP send buffer length in bytes (0 = environment variable TCP_BUFFER_LENGTH or
+  /// system default)
+  Uint32 m_tcpSendBufferLength;
+
+  /// TCP receive buffer length in bytes (0 = environment variable TCP_BUFFER_LENGTH or
+  /// system default)
+  Uint32 m_tcpReceiveBufferLength;
+
+  /// Setting for the socket option TCP_NODELAY (1 = set, 0 = do not set, -1 = environment
+  /// variable TCP_NODELAY or compile-time default)
+  int m_tcpNoDelay;
+
+  /// Maximum asynchronous operations window granted to the SCU (1 = synchronous operations
+  /// only, 0 = unlimited). This value is sent to the SCU during association negotiation.
+  Uint16 m_asyncOperationsWindow;
+
   /// Blocking mode for TCP/IP connection requests. If non-blocking mode is enabled, the SCP is
   /// waiting for new DIMSE data a specific (m_connectionTimeout) amount of time and then returns
   /// if not data arrives. In blocking mode, the SCP is calling the underlying operating
@@ -0,0 +1,449 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: Event-driven SCP pool that multiplexes many associations over
+ *           a small, fixed number of worker threads.
+ *
+ */
+
+#ifndef SCPEVPOOL_H
+#define SCPEVPOOL_H
+
+#include "dcmtk/config/osconfig.h"  /* make sure OS specific configuration is included first */
+
+#ifdef WITH_THREADS // Without threads this does not make sense...
+
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/oflist.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/dcmnet/scpthrd.h"
+#include "dcmtk/dcmnet/scpcfg.h"
+#include "dcmtk/dcmnet/assoc.h"
+
+#include <ctime>
+
+/** Base class for implementing an event-driven SCP pool. In contrast to
+ *  DcmBaseSCPPool, which dedicates one thread to each association, this pool
+ *  uses a single thread (the one calling listen()) that waits for incoming
+ *  connections and for incoming data on all associations at the same time,
+ *  using epoll() where available and poll() or select() otherwise. Whenever
+ *  a DIMSE message arrives on an association, the association is handed to
+ *  one of a small, fixed number of worker threads, which receives and handles
+ *  this single message and then returns the association to the waiting
+ *  thread. Thus, many (mostly idle) associations can be served by a few
+ *  threads. Each association is still handled by its own SCP object, but
+ *  subsequent messages of the same association may be handled by different
+ *  worker threads (never concurrently, though).
+ *  Please note that the DICOM upper layer protocol itself is still used in
+ *  blocking mode, i.e. receiving an association request and a single DIMSE
+ *  message (including its dataset) blocks the respective thread. The
+ *  association request is received by the waiting thread, the negotiation is
+ *  performed by a worker thread.
+ *  This base class is abstract.
+ *  @remark This class is only available if DCMTK is compiled with thread
+ *  support enabled.
+ */
+class DCMTK_DCMNET_EXPORT DcmBaseEventSCPPool
+{
+public:
+
+  /** Abstract base class for the objects handling a single association
+   *  within the event-driven pool. Instances are created by the pool
+   *  for each incoming association and deleted once the association
+   *  has been terminated.
+   */
+  class DCMTK_DCMNET_EXPORT DcmBaseEventSCPSession
+  {
+    public:
+
+      /** Virtual Destructor
+       */
+      virtual ~DcmBaseEventSCPSession();
+
+      /** Set SCP configuration that should be used by the session in order
+       *  to handle the incoming association request (presentation contexts, etc.).
+       *  @param config A DcmSharedSCPConfig object to be used by this session.
+       *  @return EC_Normal, if configuration is accepted, error code
+       *          otherwise.
+       */
+      virtual OFCondition setSharedConfig(const DcmSharedSCPConfig& config) = 0;
+
+      /** Negotiate the given association, i.e.\ acknowledge or refuse it.
+       *  @param assoc The association to be negotiated. Must not be NULL.
+       *  @param acknowledged [out] OFTrue if the association has been acknowledged
+       *  @return EC_Normal if the association request could be processed,
+       *          error code otherwise
+       */
+      virtual OFCondition startAssociation(T_ASC_Association* assoc,
+                                           OFBool& acknowledged) = 0;
+
+      /** Receive and handle the next DIMSE message on the association.
+       *  @return EC_Normal if the association continues, the condition
+       *          that terminated the association otherwise.
+       */
+      virtual OFCondition handleNextCommand() = 0;
+
+      /** Terminate the association, e.g.\ after a timeout.
+       *  @param cond The reason for the termination
+       */
+      virtual void terminateAssociation(const OFCondition& cond) = 0;
+
+      /** Drop the association and free its memory.
+       */
+      virtual void closeAssociation() = 0;
+
+    protected:
+
+      /** Protected constructor which is called by the pool's
+       *  createSession() method.
+       */
+      DcmBaseEventSCPSession();
+
+    private:
+
+      /// The pool manages the following members
+      friend class DcmBaseEventSCPPool;
+
+      /** Private undefined copy constructor. Shall never be called.
+       *  @param src Source object
+       */
+      DcmBaseEventSCPSession(const DcmBaseEventSCPSession& src);
+
+      /** Private undefined assignment operator. Shall never be called.
+       *  @param src Source object
+       *  @return Reference to this
+       */
+      DcmBaseEventSCPSession& operator=(const DcmBaseEventSCPSession& src);
+
+      /// Possible states of a session within the pool
+      enum sessionstate
+      {
+        /// Waiting for a worker to negotiate the association
+        SESSION_NEW,
+        /// Waiting for incoming data
+        SESSION_IDLE,
+        /// Waiting for a worker to handle the incoming DIMSE message
+        SESSION_READY,
+        /// Waiting for a worker to terminate the association after a timeout
+        SESSION_EXPIRED,
+        /// Handled by a worker
+        SESSION_RUNNING
+      };
+
+      /// Association handled by this session
+      T_ASC_Association* m_assoc;
+
+      /// Socket of the association
+      DcmNativeSocketType m_socket;
+
+      /// Current state of the session, guarded by the pool's mutex
+      sessionstate m_state;
+
+      /// OFTrue if the socket has been registered with epoll()
+      OFBool m_registered;
+
+      /// Point in time when the session became idle
+      time_t m_idleSince;
+  };
+
+  // Needed to keep MS VC6 happy
+  friend class DcmBaseEventSCPSession;
+
+  /** Virtual destructor, frees internal memory.
+   */
+  virtual ~DcmBaseEventSCPPool();
+
+  /** Set the number of worker threads that handle the DIMSE messages
+   *  of all associations.
+   *  @param numWorkers Number of worker threads, at least one thread is used.
+   */
+  virtual void setNumberOfWorkerThreads(const Uint16 numWorkers);
+
+  /** Get the number of worker threads that handle the DIMSE messages
+   *  of all associations.
+   *  @return Number of worker threads
+   */
+  virtual Uint16 getNumberOfWorkerThreads();
+
+  /** Set the maximum number of associations that are handled simultaneously.
+   *  Further association requests are rejected.
+   *  @param maxAssociations Maximum number of associations
+   */
+  virtual void setMaxAssociations(const Uint16 maxAssociations);
+
+  /** Get the maximum number of associations that are handled simultaneously.
+   *  @return Maximum number of associations
+   */
+  virtual Uint16 getMaxAssociations();
+
+  /** Get number of currently active associations.
+   *  @param onlyBusy Return only number of those associations that are
+   *         currently handled by a worker thread (or waiting for one)
+   *         and not idle, if OFTrue.
+   *  @return Number of associations currently handled within pool
+   */
+  virtual size_t numAssociations(const OFBool onlyBusy);
+
+  /** Listen for incoming association requests and DIMSE messages, and hand
+   *  them to the worker threads. Returns after stopAfterCurrentAssociations()
+   *  has been called and all associations have been terminated, or if
+   *  a serious error occurs.
+   *  @return EC_Normal after stopAfterCurrentAssociations(), an error code
+   *          if the network or the worker threads could not be initialized.
+   */
+  virtual OFCondition listen();
+
+  /** Return handle to the SCP configuration that is used to configure how to
+   *  handle incoming associations.
+   *  @return The SCP configuration
+   */
+  virtual DcmSCPConfig& getConfig();
+
+  /** If called, the pool does not accept any further association requests
+   *  and returns from listen() as soon as the last association has been
+   *  terminated.
+   */
+  virtual void stopAfterCurrentAssociations();
+
+protected:
+
+  /** Constructor. Initializes internal member variables.
+   */
+  DcmBaseEventSCPPool();
+
+  /** Create a session object handling a single association.
+   *  @return The session created
+   */
+  virtual DcmBaseEventSCPSession* createSession() = 0;
+
+  /** Reject association using the given reason, e.g.\ because maximum number
+   *  of associations is currently already served.
+   *  @param assoc The association to reject
+   *  @param reason The rejection reason
+   */
+  void rejectAssociation(T_ASC_Association* assoc,
+                         const T_ASC_RejectParametersReason& reason);
+
+  /** Drops association and clears internal structures to free memory
+   *  @param assoc The association to free
+   */
+  virtual void dropAndDestroyAssociation(T_ASC_Association* assoc);
+
+  /** Initialize network, i.e. create an instance of T_ASC_Network and set
+   *  transport layer if it is enabled.
+   *  @param network The T_ASC_Network pointer to create the instance
+   *  @return EC_Normal if there were no errors during initialization.
+   */
+  virtual OFCondition initializeNetwork(T_ASC_Network** network);
+
+private:
+
+  /// The worker threads call runWorker()
+  friend class DcmEventSCPPoolWorker;
+
+  /** Private undefined copy constructor. Shall never be called.
+   *  @param src Source object
+   */
+  DcmBaseEventSCPPool(const DcmBaseEventSCPPool& src);
+
+  /** Private undefined assignment operator. Shall never be called.
+   *  @param src Source object
+   *  @return Reference to this
+   */
+  DcmBaseEventSCPPool& operator=(const DcmBaseEventSCPPool& src);
+
+  /// Possible run modes of pool
+  enum runmode
+  {
+    /// Listen for new connections
+    LISTEN,
+    /// Do not accept new connections, finish current associations
+    STOP,
+    /// Not listening
+    SHUTDOWN
+  };
+
+  /** Receive an association request on the network and create a session
+   *  for it, or reject it if the maximum number of associations is reached.
+   *  @param network The network to receive the association request from
+   *  @param sharedConfig The configuration to be used by the session
+   */
+  void acceptAssociation(T_ASC_Network* network,
+                         const DcmSharedSCPConfig& sharedConfig);
+
+  /** Wait for incoming data on the idle associations and on the
+   *  network (if listenSocket is valid), and queue all sessions on which
+   *  data is available.
+   *  @param listenSocket The socket to wait for incoming connections on, or
+   *         DCMNET_INVALID_SOCKET
+   *  @return OFTrue if a connection request is waiting on listenSocket
+   */
+  OFBool waitForEvents(DcmNativeSocketType listenSocket);
+
+  /** Queue all idle sessions whose DIMSE timeout has expired, if the DIMSE
+   *  timeout is enabled (i.e.\ in non-blocking DIMSE mode).
+   */
+  void expireIdleSessions();
+
+  /** Hand a session to the worker threads. Must be called with the mutex locked.
+   *  @param session The session to queue
+   *  @param state The new state of the session, determining the worker's action
+   */
+  void queueSession(DcmBaseEventSCPSession* session,
+                    const DcmBaseEventSCPSession::sessionstate state);
+
+  /** Wait for incoming data on a session again. Must be called with the
+   *  mutex locked.
+   *  @param session The session to watch
+   */
+  void watchSession(DcmBaseEventSCPSession* session);
+
+  /** Main loop of each worker thread
+   */
+  void runWorker();
+
+  /** Perform the action determined by the given state of the session.
+   *  @param session The session to process
+   *  @param state The state of the session when it was taken from the queue
+   */
+  void processSession(DcmBaseEventSCPSession* session,
+                      const DcmBaseEventSCPSession::sessionstate state);
+
+  /// Mutex that guards the lists and the session states
+  OFMutex m_criticalSection;
+
+  /// Semaphore counting the sessions queued for the worker threads
+  OFSemaphore m_queueSemaphore;
+
+  /// List of all sessions, i.e.\ associations, handled by the pool
+  OFList<DcmBaseEventSCPSession*> m_sessions;
+
+  /// List of sessions waiting for a worker thread
+  OFList<DcmBaseEventSCPSession*> m_queue;
+
+  /// Worker threads
+  OFVector<OFThread*> m_workers;
+
+  /// SCP configuration to be used by pool and all sessions
+  DcmSCPConfig m_cfg;
+
+  /// Number of worker threads
+  Uint16 m_numWorkers;
+
+  /// Maximum number of associations handled at a time
+  Uint16 m_maxAssociations;
+
+  /// Current run mode of pool
+  volatile runmode m_runMode;
+
+  /// epoll() file descriptor, -1 if not available
+  int m_epollFd;
+};
+
+/** Implementation of an event-driven DICOM SCP server pool. The pool waits
+ *  for incoming TCP/IP connection requests and for incoming DIMSE messages on
+ *  all associations, and hands each DIMSE message to one of a fixed number of
+ *  worker threads (default 4). The maximum number of simultaneous associations
+ *  is configurable (default 100), further association requests are rejected
+ *  with the error "local limit exceeded".
+ *  @tparam SCP the service class provider to be instantiated for each
+ *    association, must be derived from DcmThreadSCP.
+ *  @tparam SCPPool the base SCP pool class to use.
+ *  @tparam BaseSCPSession the base session class to use.
+ */
+template<typename SCP = DcmThreadSCP, typename SCPPool = DcmBaseEventSCPPool, typename BaseSCPSession = OFTypename SCPPool::DcmBaseEventSCPSession>
+class DcmEventSCPPool : public SCPPool
+{
+public:
+
+    /** Default construct a DcmEventSCPPool object.
+     */
+    DcmEventSCPPool() : SCPPool()
+    {
+    }
+
+private:
+
+    /** Helper class to use any SCP derived from DcmThreadSCP as a session.
+     */
+    struct SCPSession : public BaseSCPSession
+                      , private SCP
+    {
+        /** Construct a SCPSession.
+         */
+        SCPSession()
+          : BaseSCPSession()
+          , SCP()
+        {
+        }
+
+        /** Set the shared configuration for this session.
+         *  @param config a DcmSharedSCPConfig object to be used by this session.
+         *  @return the result of the underlying SCP implementation.
+         */
+        virtual OFCondition setSharedConfig(const DcmSharedSCPConfig& config)
+        {
+            return SCP::setSharedConfig(config);
+        }
+
+        /** Negotiate the given association.
+         *  @param assoc The association to be negotiated
+         *  @param acknowledged [out] OFTrue if the association has been acknowledged
+         *  @return the result of the underlying SCP implementation.
+         */
+        virtual OFCondition startAssociation(T_ASC_Association* assoc, OFBool& acknowledged)
+        {
+            return SCP::startAssociation(assoc, acknowledged);
+        }
+
+        /** Receive and handle the next DIMSE message.
+         *  @return the result of the underlying SCP implementation.
+         */
+        virtual OFCondition handleNextCommand()
+        {
+            return SCP::handleNextCommand();
+        }
+
+        /** Terminate the association.
+         *  @param cond The reason for the termination
+         */
+        virtual void terminateAssociation(const OFCondition& cond)
+        {
+            SCP::terminateAssociation(cond);
+        }
+
+        /** Drop the association and free its memory.
+         */
+        virtual void closeAssociation()
+        {
+            SCP::dropAndDestroyAssociation();
+        }
+    };
+
+    /** Create a session to be used for handling an association.
+     *  @return a pointer to a newly created session.
+     */
+    virtual BaseSCPSession* createSession()
+    {
+        return new SCPSession;
+    }
+};
+
+
+#endif // WITH_THREADS
+
+#endif // SCPEVPOOL_H
@@ -58,6 +58,37 @@ public:
    */
   virtual OFCondition run(T_ASC_Association* incomingAssoc);
 
+  /** Negotiate an already established (on TCP/IP level) connection without
+   *  handling any DIMSE messages. This function is used by event-driven pools
+   *  that handle the DIMSE messages of the association one by one by calling
+   *  handleNextCommand() whenever data is available on the connection.
+   *  If the association is not acknowledged, the association termination
+   *  has already been notified upon return.
+   *  @param incomingAssoc the association of the connection.
+   *  @param acknowledged [out] OFTrue if the association has been acknowledged
+   *  @return If negotiation fails, e.g. because the given association is not
+   *          valid, an error is reported. In all other cases, e.g. no presentation
+   *          contexts could be negotiated with the requesting SCU, then EC_Normal
+   *          is returned.
+   */
+  virtual OFCondition startAssociation(T_ASC_Association* incomingAssoc,
+                                       OFBool& acknowledged);
+
+  /** Receive and handle the next DIMSE command on an association started with
+   *  startAssociation(). If the association is terminated (e.g. released by the
+   *  peer), the termination is handled and notified before this function returns.
+   *  @return EC_Normal if the command has been handled and the association
+   *          continues, the condition that terminated the association otherwise.
+   */
+  virtual OFCondition handleNextCommand();
+
+  /** Terminate an association started with startAssociation(), e.g.\ after
+   *  a timeout, by calling handleAssociationTermination() and notifying the
+   *  association termination.
+   *  @param cond the reason for the termination, e.g. DIMSE_NODATAAVAILABLE
+   */
+  virtual void terminateAssociation(const OFCondition& cond);
+
   /** Get access to the DcmSharedSCPConfig object. The shared configuration can be used
    *  to provide other SCPs with the same configuration without the need to copy it.
    *  @return a reference to the DcmSharedSCPConfig object used by this DcmSCP object.
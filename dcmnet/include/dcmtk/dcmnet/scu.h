@@ -401,6 +401,58 @@ public:
                                          const OFString& moveOriginatorAETitle = "",
                                          const Uint16 moveOriginatorMsgID      = 0);
 
+    /** Sends a C-STORE request on given presentation context but does not wait for the
+     *  corresponding response. This allows for sending further requests before the first
+     *  response is received, as long as the number of outstanding requests does not exceed
+     *  the negotiated asynchronous operations window (see setAsyncOperationsWindow() and
+     *  getMaxOperationsInvoked()). The responses have to be received by calling
+     *  receiveSTOREResponse() and can be matched to the requests by their message ID.
+     *  Please note that the responses may be received in a different order than the
+     *  requests were sent. The parameters are the same as for sendSTORERequest().
+     *  @param presID        [in]  The ID of the presentation context to be used. If 0 is
+     *                             given, the function tries to find an appropriate
+     *                             presentation context itself (based on SOP class and
+     *                             original transfer syntax of the 'dicomFile' or 'dataset').
+     *  @param dicomFile     [in]  The filename of the DICOM file to be sent. Alternatively, a
+     *                             dataset can be given in the next parameter. If both are given
+     *                             the dataset from the file name is used.
+     *  @param dataset       [in]  The dataset to be sent. Alternatively, a filename can be
+     *                             specified in the previous parameter. If both are given the
+     *                             dataset from the filename is used.
+     *  @param messageID     [out] The message ID of the request that has been sent
+     *  @param moveOriginatorAETitle [in] If this C-STORE is started due to a C-MOVE request,
+     *                               this parameter informs the C-STORE SCP about the C-MOVE
+     *                               client's AE title.
+     *  @param moveOriginatorMsgID   [in] If this C-STORE is started due to a C-MOVE request,
+     *                               this parameter informs the C-STORE SCP about the C-MOVE
+     *                               message ID.
+     *  @return EC_Normal if request could be sent successfully, error code otherwise
+     */
+    virtual OFCondition sendSTORERequestAsync(const T_ASC_PresentationContextID presID,
+                                              const OFFilename& dicomFile,
+                                              DcmDataset* dataset,
+                                              Uint16& messageID,
+                                              const OFString& moveOriginatorAETitle = "",
+                                              const Uint16 moveOriginatorMsgID      = 0);
+
+    /** Receives the next C-STORE response on the current association, i.e. the response
+     *  to one of the requests sent with sendSTORERequestAsync().
+     *  @param messageIDRespondedTo [out] The message ID of the request this response belongs
+     *                                    to (Message ID Being Responded To)
+     *  @param rspStatusCode        [out] The response status code received. 0 means success,
+     *                                    others can be found in the DICOM standard.
+     *  @param timeout              [in]  If this parameter is not 0, it specifies the timeout
+     *                                    (in seconds) to be used for receiving the response.
+     *                                    Otherwise, the default timeout value is used (see
+     *                                    setDIMSETimeout()).
+     *  @return EC_Normal if the response was received successfully, error code otherwise.
+     *          That means that if the receiver sends a response denoting failure of the
+     *          storage request, EC_Normal will be returned.
+     */
+    virtual OFCondition receiveSTOREResponse(Uint16& messageIDRespondedTo,
+                                             Uint16& rspStatusCode,
+                                             const Uint32 timeout = 0);
+
     /** Sends a C-MOVE Request on given presentation context and receives list of responses.
      *  The function receives the first response and then calls the function handleMOVEResponse()
      *  which gets the relevant presentation context together with the response dataset and
@@ -763,6 +815,25 @@ public:
      */
     void setMaxReceivePDULength(const Uint32 maxRecPDU);
 
+    /** Set the length of the TCP send and receive buffers (socket options SO_SNDBUF and
+     *  SO_RCVBUF) used for the SCU's transport connection. Large buffers increase the
+     *  throughput on links with a high bandwidth-delay product. The default is 0 for both
+     *  values, i.e. the environment variable TCP_BUFFER_LENGTH or the system default is
+     *  used. The setting is effective for the next call of initNetwork().
+     *  @param sendBufferLength [in] TCP send buffer length in bytes (0 = default)
+     *  @param receiveBufferLength [in] TCP receive buffer length in bytes (0 = default)
+     */
+    void setTCPBufferLength(const Uint32 sendBufferLength,
+                            const Uint32 receiveBufferLength);
+
+    /** Set whether the socket option TCP_NODELAY is set for the SCU's transport
+     *  connection, i.e. whether the Nagle algorithm is disabled. The default is -1, i.e.
+     *  the environment variable TCP_NODELAY or the compile-time default is used. The
+     *  setting is effective for the next call of initNetwork().
+     *  @param noDelay [in] 1 = set TCP_NODELAY, 0 = do not set TCP_NODELAY, -1 = default
+     */
+    void setTCPNoDelay(const int noDelay);
+
     /** Set whether to send in DIMSE blocking or non-blocking mode
      *  @param blockingMode [in] Either blocking or non-blocking mode
      */
@@ -872,6 +943,18 @@ public:
      */
     void setMaxNestingDepth(const Sint32 maxDepth);
 
+    /** Set the asynchronous operations window to be proposed during association
+     *  negotiation, i.e. the maximum number of outstanding requests that this SCU
+     *  would like to invoke without waiting for the corresponding responses. The
+     *  SCU does not perform asynchronous operations invoked by the peer.
+     *  - Value 1 (default): synchronous operations only, no window is proposed
+     *  - Value 0: unlimited number of outstanding requests
+     *  - Value > 1: use this value as the maximum number of outstanding requests
+     *  The setting takes effect for the next call of initNetwork().
+     *  @param maxOpsInvoked [in] Maximum number of outstanding operations invoked
+     */
+    void setAsyncOperationsWindow(const Uint16 maxOpsInvoked);
+
     /* Get methods */
 
     /** Get current connection status
@@ -884,6 +967,21 @@ public:
      */
     Uint32 getMaxReceivePDULength() const;
 
+    /** Returns the configured TCP send buffer length
+     *  @return TCP send buffer length in bytes (0 = default)
+     */
+    Uint32 getTCPSendBufferLength() const;
+
+    /** Returns the configured TCP receive buffer length
+     *  @return TCP receive buffer length in bytes (0 = default)
+     */
+    Uint32 getTCPReceiveBufferLength() const;
+
+    /** Returns the configured setting for the socket option TCP_NODELAY
+     *  @return 1 = set TCP_NODELAY, 0 = do not set TCP_NODELAY, -1 = default
+     */
+    int getTCPNoDelay() const;
+
     /** Returns whether DIMSE messaging is configured to be blocking or unblocking
      *  @return The blocking mode configured
      */
@@ -909,6 +1007,11 @@ public:
      */
     Uint16 getPeerPort() const;
 
+    /** Returns the IP protocol version configured
+     *  @return The IP protocol version used to connect to the SCP
+     */
+    T_ASC_ProtocolFamily getProtocolVersion() const;
+
     /** Returns DIMSE timeout in seconds for receiving data. If the blocking
      *  mode is DIMSE_NONBLOCKING the SCU will try to read data from
      *  the incoming socket stream for the number of seconds configured.
@@ -972,6 +1075,23 @@ public:
      */
     Sint32 getMaxNestingDepth() const;
 
+    /** Return the asynchronous operations window to be proposed during association
+     *  negotiation (see setAsyncOperationsWindow()).
+     *  @return maximum number of outstanding operations invoked
+     *    (1 = synchronous operations only, 0 = unlimited)
+     */
+    Uint16 getAsyncOperationsWindow() const;
+
+    /** Return the maximum number of outstanding operations that this SCU may invoke
+     *  on the current association, as negotiated with the peer. If the peer did not
+     *  accept the proposed asynchronous operations window (or none was proposed),
+     *  1 is returned, i.e. each request has to be completed before the next one is
+     *  sent.
+     *  @return maximum number of outstanding operations invoked (0 = unlimited),
+     *    1 if not connected
+     */
+    Uint16 getMaxOperationsInvoked() const;
+
     /** Returns whether SCU is configured to create a TLS connection with the SCP
      *  @return OFTrue if TLS mode has been enabled, OFFalse otherwise
      */
@@ -1231,6 +1351,16 @@ private:
     /// Maximum PDU size (default: 16384 bytes)
     Uint32 m_maxReceivePDULength;
 
+    /// TCP send buffer length (default: 0, i.e. TCP_BUFFER_LENGTH or system default)
+    Uint32 m_tcpSendBufferLength;
+
+    /// TCP receive buffer length (default: 0, i.e. TCP_BUFFER_LENGTH or system default)
+    Uint32 m_tcpReceiveBufferLength;
+
+    /// Setting for the socket option TCP_NODELAY (default: -1, i.e. TCP_NODELAY or
+    /// compile-time default)
+    int m_tcpNoDelay;
+
     /// DIMSE blocking mode (default: blocking)
     T_DIMSE_BlockingMode m_blockMode;
 
@@ -1287,6 +1417,10 @@ private:
 
     /// IP protocol version to be used
     T_ASC_ProtocolFamily m_protocolVersion;
+
+    /// Asynchronous operations window to be proposed
+    /// (1 = synchronous operations only, 0 = unlimited)
+    Uint16 m_asyncOperationsWindow;
 };
 
 #endif // SCU_H
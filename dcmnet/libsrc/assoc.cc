@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2025, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -1407,6 +1407,32 @@ void ASC_getCopyOfIdentResponse(T_ASC_Parameters * params,
 }
 
 
+OFCondition
+ASC_setAsyncOperationsWindow(T_ASC_Parameters * params,
+                             unsigned short maxOpsInvoked,
+                             unsigned short maxOpsPerformed)
+{
+    if (params == NULL)
+        return ASC_NULLKEY;
+    params->DULparams.maximumOperationsInvoked = maxOpsInvoked;
+    params->DULparams.maximumOperationsPerformed = maxOpsPerformed;
+    return EC_Normal;
+}
+
+
+OFCondition
+ASC_getAsyncOperationsWindow(T_ASC_Parameters * params,
+                             unsigned short& maxOpsInvoked,
+                             unsigned short& maxOpsPerformed)
+{
+    if (params == NULL)
+        return ASC_NULLKEY;
+    maxOpsInvoked = params->DULparams.peerMaximumOperationsInvoked;
+    maxOpsPerformed = params->DULparams.peerMaximumOperationsPerformed;
+    return EC_Normal;
+}
+
+
 OFCondition ASC_setIdentAC(
     T_ASC_Parameters * params,
     const char* response,
@@ -1563,6 +1589,21 @@ ASC_dumpParameters(OFString& str, T_ASC_Parameters * params, ASC_associateType d
         << "Their Max PDU Receive Size:  "
         << params->theirMaxPDUReceiveSize << OFendl;
 
+    if ((params->DULparams.maximumOperationsInvoked != 0) || (params->DULparams.maximumOperationsPerformed != 0))
+    {
+        outstream << "Our Async Operations Window:   invoked "
+            << params->DULparams.maximumOperationsInvoked << ", performed "
+            << params->DULparams.maximumOperationsPerformed << OFendl;
+    }
+    // the peer's values are 0 before and 1 after negotiation if no window was received
+    if ((params->DULparams.peerMaximumOperationsInvoked != params->DULparams.peerMaximumOperationsPerformed) ||
+        (params->DULparams.peerMaximumOperationsInvoked > 1))
+    {
+        outstream << "Their Async Operations Window: invoked "
+            << params->DULparams.peerMaximumOperationsInvoked << ", performed "
+            << params->DULparams.peerMaximumOperationsPerformed << OFendl;
+    }
+
     outstream << "Presentation Contexts:" << OFendl;
     for (i=0; i<ASC_countPresentationContexts(params); i++) {
         ASC_getPresentationContext(params, i, &pc);
@@ -1972,7 +2013,7 @@ ASC_requestAssociation(T_ASC_Network * network,
         sendLen = params->theirMaxPDUReceiveSize;
         if (sendLen < 1) {
             /* the length is unlimited, choose a suitable buffer len */
-            sendLen = ASC_MAXIMUMPDUSIZE;
+            sendLen = ASC_UNLIMITEDPDUSENDSIZE;
         } else if (sendLen > ASC_MAXIMUMPDUSIZE) {
             sendLen = ASC_MAXIMUMPDUSIZE;
         }
@@ -2057,7 +2098,7 @@ ASC_acknowledgeAssociation(
         sendLen = assoc->params->theirMaxPDUReceiveSize;
         if (sendLen < 1) {
             /* the length is unlimited, choose a suitable buffer len */
-            sendLen = ASC_MAXIMUMPDUSIZE;
+            sendLen = ASC_UNLIMITEDPDUSENDSIZE;
         } else if (sendLen > ASC_MAXIMUMPDUSIZE) {
             sendLen = ASC_MAXIMUMPDUSIZE;
         }
@@ -2221,6 +2262,20 @@ ASC_setTransportLayer(T_ASC_Network *network, DcmTransportLayer *newLayer, int t
   return DUL_setTransportLayer(network->network, newLayer, takeoverOwnership);
 }
 
+OFCondition
+ASC_setTCPBufferLength(T_ASC_Network *network, unsigned long sendBufferLength, unsigned long receiveBufferLength)
+{
+  if (network == NULL) return ASC_NULLKEY;
+  return DUL_setTCPBufferLength(network->network, sendBufferLength, receiveBufferLength);
+}
+
+OFCondition
+ASC_setTCPNoDelay(T_ASC_Network *network, int noDelay)
+{
+  if (network == NULL) return ASC_NULLKEY;
+  return DUL_setTCPNoDelay(network->network, noDelay);
+}
+
 unsigned long ASC_getPeerCertificateLength(T_ASC_Association *assoc)
 {
   if (assoc==NULL) return 0;
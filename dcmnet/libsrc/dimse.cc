@@ -267,6 +267,159 @@ DIMSE_readNextPDV(
     return EC_Normal;
 }
 
+/* minimum number of bytes requested by the data set parser for which an attempt
+ * is made to receive the next PDV directly into the parser's memory. Smaller
+ * blocks are not worth the additional system call for the PDV header.
+ */
+#define DIMSE_MIN_DIRECT_PDV_LENGTH 8192
+
+/* Source for the input buffer stream used when receiving a data set in memory.
+ * Once the value field of an element (e.g. Pixel Data) has been allocated and
+ * the current PDV has been parsed completely, the following PDVs are received
+ * directly into the value field, thus avoiding the copy from the PDU buffer.
+ */
+class DIMSE_DirectPDVSource : public DcmBufferSource
+{
+public:
+
+    DIMSE_DirectPDVSource(
+        T_ASC_Association *assoc,
+        T_DIMSE_BlockingMode blocking,
+        int timeout,
+        const T_ASC_PresentationContextID &presID,
+        Uint64 &pdvCount,
+        Uint64 &bytesRead,
+        DIMSE_ProgressCallback callback,
+        void *callbackData)
+    : assoc_(assoc)
+    , blocking_(blocking)
+    , timeout_(timeout)
+    , presID_(presID)
+    , pdvCount_(pdvCount)
+    , bytesRead_(bytesRead)
+    , callback_(callback)
+    , callbackData_(callbackData)
+    , status_(EC_Normal)
+    , last_(OFFalse)
+    {
+    }
+
+    virtual offile_off_t readDirect(void *buf, offile_off_t buflen, OFBool &eos)
+    {
+        if (status_.bad() || last_ || (buflen < DIMSE_MIN_DIRECT_PDV_LENGTH))
+            return 0;
+
+        /* the length of a value field never exceeds 32 bits */
+        DUL_PDV pdv;
+        const DUL_BLOCKOPTIONS blk = (blocking_ == DIMSE_BLOCKING) ? (DUL_BLOCK) : (DUL_NOBLOCK);
+        OFCondition cond = DUL_ReadPDVDirect(&assoc_->DULassociation, buf,
+            OFstatic_cast(unsigned long, buflen), blk, timeout_, &pdv);
+
+        /* the PDU has been stored in the DUL layer and is processed as usual */
+        if ((cond.good() || (cond == DUL_PDATAPDUARRIVED)) && (pdv.data == NULL))
+            return 0;
+
+        if (cond != DUL_PDATAPDUARRIVED)
+        {
+            if ((cond == DUL_READTIMEOUT) && (blocking_ == DIMSE_NONBLOCKING)) status_ = DIMSE_NODATAAVAILABLE;
+            else if (cond == DUL_NULLKEY || cond == DUL_ILLEGALKEY) status_ = DIMSE_ILLEGALASSOCIATION;
+            else if (cond == DUL_PEERREQUESTEDRELEASE || cond == DUL_PEERABORTEDASSOCIATION) status_ = cond;
+            else status_ = makeDcmnetSubCondition(DIMSEC_READPDVFAILED, OF_error, "DIMSE Read PDV failed", cond);
+            return 0;
+        }
+
+        /* perform the same checks as DIMSE_receiveDataSetInMemory() */
+        if (pdv.pdvType != DUL_DATASETPDV)
+        {
+            status_ = DIMSE_UNEXPECTEDPDVTYPE;
+            return 0;
+        }
+        if (pdv.presentationContextID != presID_)
+        {
+            char buf1[256];
+            OFStandard::snprintf(buf1, sizeof(buf1), "DIMSE: Different PresIDs inside data set: %d != %d", presID_, pdv.presentationContextID);
+            OFCondition subCond = makeDcmnetCondition(DIMSEC_INVALIDPRESENTATIONCONTEXTID, OF_error, buf1);
+            status_ = makeDcmnetSubCondition(DIMSEC_RECEIVEFAILED, OF_error, "DIMSE Failed to receive message", subCond);
+            return 0;
+        }
+        if ((pdv.fragmentLength % 2) != 0)
+        {
+            char buf2[256];
+            OFStandard::snprintf(buf2, sizeof(buf2), "DIMSE: Odd Fragment Length: %lu", pdv.fragmentLength);
+            status_ = makeDcmnetCondition(DIMSEC_RECEIVEFAILED, OF_error, buf2);
+            return 0;
+        }
+
+        bytesRead_ += pdv.fragmentLength;
+        pdvCount_++;
+        last_ = pdv.lastPDV;
+        if (last_) eos = OFTrue;
+
+        DCMNET_TRACE("DIMSE receiveDataSetInMemory: " << pdv.fragmentLength
+            << " bytes read directly (last: " << ((last_)?("YES"):("NO")) << ")");
+
+        if (callback_)
+        {
+            callback_(callbackData_, bytesRead_);
+        }
+        return pdv.fragmentLength;
+    }
+
+    /** returns the status of the last attempt to receive a PDV
+     *  @return status, EC_Normal if no error occurred
+     */
+    OFCondition status() const
+    {
+        return status_;
+    }
+
+    /** checks whether the last PDV of the data set has been received
+     *  @return OFTrue if the last PDV has been received, OFFalse otherwise
+     */
+    OFBool last() const
+    {
+        return last_;
+    }
+
+private:
+
+    /// private undefined copy constructor
+    DIMSE_DirectPDVSource(const DIMSE_DirectPDVSource&);
+
+    /// private undefined copy assignment operator
+    DIMSE_DirectPDVSource& operator=(const DIMSE_DirectPDVSource&);
+
+    /// association from which the PDVs are received
+    T_ASC_Association *assoc_;
+
+    /// blocking mode for receiving
+    T_DIMSE_BlockingMode blocking_;
+
+    /// timeout for receiving in non-blocking mode
+    int timeout_;
+
+    /// presentation context ID of the data set
+    const T_ASC_PresentationContextID &presID_;
+
+    /// number of PDVs received for the data set
+    Uint64 &pdvCount_;
+
+    /// number of bytes received for the data set
+    Uint64 &bytesRead_;
+
+    /// progress callback, may be NULL
+    DIMSE_ProgressCallback callback_;
+
+    /// callback context
+    void *callbackData_;
+
+    /// error that occurred while receiving a PDV
+    OFCondition status_;
+
+    /// true if the last PDV of the data set has been received
+    OFBool last_;
+};
+
 /*
  * Checking and Validation
  */
@@ -1554,8 +1707,11 @@ DIMSE_receiveDataSetInMemory(
         return cond;
     }
 
-    /* create a buffer variable which can be used to store the received information */
+    /* create a buffer variable which can be used to store the received information. Large */
+    /* element values are received directly into their value field where possible. */
+    DIMSE_DirectPDVSource directSource(assoc, blocking, timeout, pid, pdvCount, bytesRead, callback, callbackData);
     DcmInputBufferStream dataBuf;
+    dataBuf.setSource(&directSource);
 
     /* prepare the DcmDataset variable for transfer of data */
     dset->transferInit();
@@ -1641,7 +1797,13 @@ DIMSE_receiveDataSetInMemory(
             /* insert the information which is contained in the buffer into the DcmDataset variable. Mind the */
             /* transfer syntax which was specified through the presentation context ID of the first PDV. */
             econd = dset->read(dataBuf, xferSyntax);
-            if (econd != EC_Normal && econd != EC_StreamNotifyClient)
+            if (directSource.status().bad())
+            {
+                /* receiving a PDV directly into the data set failed */
+                cond = directSource.status();
+                last = OFTrue;
+            }
+            else if (econd != EC_Normal && econd != EC_StreamNotifyClient)
             {
                 DCMNET_WARN(DIMSE_warn_str(assoc) << "DIMSE receiveDataSetInMemory: dset->read() Failed ("
                     << econd.text() << ")");
@@ -1662,11 +1824,12 @@ DIMSE_receiveDataSetInMemory(
             pdvCount++;
 
             /* update the variable which will be evaluated at the beginning of each loop iteration. */
-            last = pdv.lastPDV;
+            /* The last PDV might also have been received directly during dset->read(). */
+            last = pdv.lastPDV || directSource.last();
 
             /* dump information if required */
             DCMNET_TRACE("DIMSE receiveDataSetInMemory: " << pdv.fragmentLength
-                << " bytes read (last: " << ((last)?("YES"):("NO")) << ")");
+                << " bytes read (last: " << ((pdv.lastPDV)?("YES"):("NO")) << ")");
 
             /* execute callback function after each received PDV */
             if (callback)
@@ -24,6 +24,8 @@
 
 #include "dcmtk/dcmnet/dstorscp.h"
 #include "dcmtk/dcmnet/diutil.h"
+#include "dcmtk/dcmdata/dcistrmb.h"
+#include "dcmtk/dcmdata/dcostrmf.h"
 #include "dcmtk/ofstd/ofstdinc.h"
 #include <ctime>
 
@@ -34,6 +36,257 @@ const char *DcmStorageSCP::DEF_StandardSubdirectory  = "data";
 const char *DcmStorageSCP::DEF_UndefinedSubdirectory = "undef";
 const char *DcmStorageSCP::DEF_FilenameExtension     = "";
 
+// maximum number of bytes kept in memory in streaming mode before the file is created
+// (even if the attributes needed for generating the filename have not yet been found)
+#define STREAMING_MAX_PENDING_BYTES (4 * 1024 * 1024)
+
+
+// helper classes for the streaming storage mode
+
+/** consumer for the dataset of a C-STORE request that is received in streaming mode.
+ *  The beginning of the dataset is parsed incrementally in order to extract the
+ *  attributes needed for generating the directory and file name.  Until the file has
+ *  been created, the received data is kept in memory; afterwards, all data is written
+ *  directly to the file, i.e. exactly as received.
+ */
+class DcmStorageSCPStreamingConsumer
+  : public DcmConsumer
+{
+  public:
+
+    DcmStorageSCPStreamingConsumer(DcmStorageSCP &scp,
+                                   const T_DIMSE_C_StoreRQ &reqMessage,
+                                   const T_ASC_PresentationContextID presID,
+                                   const E_TransferSyntax xfer,
+                                   DcmDataset &metadata)
+      : SCP(scp),
+        Request(reqMessage),
+        PresID(presID),
+        Xfer(xfer),
+        Metadata(metadata),
+        Parser(),
+        Parsing(OFTrue),
+        Pending(),
+        FileStream(NULL),
+        Filename(),
+        Status(EC_Normal)
+    {
+        Metadata.transferInit();
+    }
+
+    virtual ~DcmStorageSCPStreamingConsumer()
+    {
+        stopParsing();
+        if (FileStream != NULL)
+        {
+            // dataset has not been received completely, so delete the incomplete file
+            delete FileStream;
+            OFStandard::deleteFile(Filename);
+        }
+    }
+
+    virtual OFBool good() const
+    {
+        return Status.good();
+    }
+
+    virtual OFCondition status() const
+    {
+        return Status;
+    }
+
+    virtual OFBool isFlushed() const
+    {
+        return OFTrue;
+    }
+
+    virtual offile_off_t avail() const
+    {
+        // same as for a file consumer, we cannot report "unlimited"
+        return 2147483647L;
+    }
+
+    virtual offile_off_t write(const void *buf, offile_off_t buflen)
+    {
+        if (Status.bad() || (buf == NULL) || (buflen == 0))
+            return 0;
+        if (Parsing)
+            parse(buf, buflen);
+        if (FileStream != NULL)
+            return writeToFile(buf, buflen);
+        // file not yet created, keep the data in memory
+        const Uint8 *data = OFstatic_cast(const Uint8 *, buf);
+        Pending.insert(Pending.end(), data, data + buflen);
+        if (Parsing && (Pending.size() > STREAMING_MAX_PENDING_BYTES))
+        {
+            DCMNET_DEBUG("attributes needed for generating the filename not found within the first "
+                << Pending.size() << " bytes of the received dataset, creating file anyway");
+            stopParsing();
+        }
+        // create the file as soon as the attributes are available
+        if (!Parsing)
+            Status = createFile();
+        return Status.good() ? buflen : 0;
+    }
+
+    virtual void flush()
+    {
+        // nothing to do, all data is passed to the file immediately
+    }
+
+    /** complete the storage of the received dataset, i.e.\ create the file (if not
+     *  yet done) and close it.  In case of error, the incomplete file is deleted.
+     *  @param  filename  reference to variable that will store the name of the file
+     *  @return status, EC_Normal if successful, an error code otherwise
+     */
+    OFCondition finish(OFString &filename)
+    {
+        if (Parsing)
+        {
+            // end of dataset reached, parse what is left
+            Parser.setEos();
+            parse(NULL, 0);
+            stopParsing();
+        }
+        if (Status.good() && (FileStream == NULL))
+            Status = createFile();
+        if (FileStream != NULL)
+        {
+            if (Status.good())
+                Status = FileStream->fclose();
+            delete FileStream;
+            FileStream = NULL;
+            if (Status.good())
+                filename = Filename;
+            else {
+                DCMNET_ERROR("cannot store received object: " << Filename << ": " << Status.text());
+                OFStandard::deleteFile(Filename);
+            }
+        }
+        return Status;
+    }
+
+  private:
+
+    /// parse the given block of data (continuing where the last call stopped)
+    void parse(const void *buf, offile_off_t buflen)
+    {
+        if (buflen > 0)
+            Parser.setBuffer(buf, buflen);
+        OFCondition cond = Metadata.readUntilTag(Parser, Xfer, EGL_noChange, DCM_MaxReadLength, DCM_StudyID);
+        // make the stream remember any unread bytes
+        Parser.releaseBuffer();
+        if (cond.good())
+            stopParsing();
+        else if (cond != EC_StreamNotifyClient)
+        {
+            DCMNET_WARN("cannot parse received dataset, using the attributes extracted so far: " << cond.text());
+            stopParsing();
+        }
+    }
+
+    /// stop parsing the received data
+    void stopParsing()
+    {
+        if (Parsing)
+        {
+            Metadata.transferEnd();
+            Parsing = OFFalse;
+        }
+    }
+
+    /// write the given block of data to the file
+    offile_off_t writeToFile(const void *buf, offile_off_t buflen)
+    {
+        const offile_off_t written = FileStream->write(buf, buflen);
+        if (written != buflen)
+        {
+            Status = FileStream->status();
+            if (Status.good())
+                Status = makeDcmnetCondition(DIMSEC_OUTOFRESOURCES, OF_error, "cannot write to file");
+            DCMNET_ERROR("cannot store received object: " << Filename << ": " << Status.text());
+        }
+        return written;
+    }
+
+    /// generate the directory and file name, create the file and write all pending data
+    OFCondition createFile()
+    {
+        OFString directoryName;
+        OFString sopClassUID = Request.AffectedSOPClassUID;
+        OFString sopInstanceUID = Request.AffectedSOPInstanceUID;
+        // generate filename with full path
+        OFCondition status = SCP.generateDirAndFilename(Filename, directoryName, sopClassUID, sopInstanceUID, &Metadata);
+        if (status.good())
+        {
+            DCMNET_DEBUG("generated filename for object being received: " << Filename);
+            // create the output directory (if needed)
+            status = OFStandard::createDirectory(directoryName, SCP.OutputDirectory /* rootDir */);
+            if (status.good())
+            {
+                if (OFStandard::fileExists(Filename))
+                    DCMNET_WARN("file already exists, overwriting: " << Filename);
+                // create the file and write the meta header
+                status = SCP.createSTORERequestFile(Request, PresID, Filename, FileStream);
+                if (status.good())
+                {
+                    if (!Pending.empty() && (writeToFile(&Pending[0], Pending.size()) != OFstatic_cast(offile_off_t, Pending.size())))
+                        status = Status;
+                } else
+                    DCMNET_ERROR("cannot create file for object being received: " << Filename << ": " << status.text());
+            } else
+                DCMNET_ERROR("cannot create directory for object being received: " << directoryName << ": " << status.text());
+        } else
+            DCMNET_ERROR("cannot generate directory or file name for object being received: " << status.text());
+        // the data is not needed anymore
+        OFVector<Uint8>().swap(Pending);
+        return status;
+    }
+
+    /// storage SCP that receives the dataset
+    DcmStorageSCP &SCP;
+    /// C-STORE request message
+    const T_DIMSE_C_StoreRQ &Request;
+    /// presentation context the C-STORE request was received on
+    const T_ASC_PresentationContextID PresID;
+    /// transfer syntax of the received dataset
+    const E_TransferSyntax Xfer;
+    /// dataset storing the attributes extracted from the received dataset
+    DcmDataset &Metadata;
+    /// input stream used for parsing the beginning of the received dataset
+    DcmInputBufferStream Parser;
+    /// flag indicating whether the received data is still being parsed
+    OFBool Parsing;
+    /// data received but not yet written to file
+    OFVector<Uint8> Pending;
+    /// output stream for the file (NULL if not yet created)
+    DcmOutputFileStream *FileStream;
+    /// name of the file (with full path)
+    OFString Filename;
+    /// current status
+    OFCondition Status;
+
+    // private undefined copy constructor
+    DcmStorageSCPStreamingConsumer(const DcmStorageSCPStreamingConsumer &);
+
+    // private undefined assignment operator
+    DcmStorageSCPStreamingConsumer &operator=(const DcmStorageSCPStreamingConsumer &);
+};
+
+
+/** output stream that passes all data to a given consumer
+ */
+class DcmStorageSCPStreamingOutputStream
+  : public DcmOutputStream
+{
+  public:
+
+    DcmStorageSCPStreamingOutputStream(DcmConsumer &consumer)
+      : DcmOutputStream(&consumer)
+    {
+    }
+};
+
 
 // implementation of the main interface class
 
@@ -211,6 +464,20 @@ OFCondition DcmStorageSCP::handleIncomingCommand(T_DIMSE_Message *incomingMsg,
                         rspStatusCode = STATUS_Success;
                     }
                 }
+            }
+            // special case: streaming mode
+            else if (DatasetStorage == DSM_StoreStreaming)
+            {
+                OFString filename;
+                DcmDataset metadata;
+                // receive dataset directly to file while extracting some attributes
+                status = receiveAndStoreSTORERequest(storeReq, presInfo, filename, metadata);
+                if (status.good())
+                {
+                    // call the notification handler (default implementation outputs to the logger)
+                    notifyInstanceStored(filename, storeReq.AffectedSOPClassUID, storeReq.AffectedSOPInstanceUID, &metadata);
+                    rspStatusCode = STATUS_Success;
+                }
             } else {
                 DcmFileFormat fileformat;
                 DcmDataset *reqDataset = fileformat.getDataset();
@@ -324,6 +591,27 @@ OFCondition DcmStorageSCP::generateSTORERequestFilename(const T_DIMSE_C_StoreRQ
 }
 
 
+OFCondition DcmStorageSCP::receiveAndStoreSTORERequest(T_DIMSE_C_StoreRQ &reqMessage,
+                                                        const DcmPresentationContextInfo &presInfo,
+                                                        OFString &filename,
+                                                        DcmDataset &metadata)
+{
+    const E_TransferSyntax xfer = DcmXfer(presInfo.acceptedTransferSyntax.c_str()).getXfer();
+    DcmStorageSCPStreamingConsumer consumer(*this, reqMessage, presInfo.presentationContextID, xfer, metadata);
+    DcmStorageSCPStreamingOutputStream outputStream(consumer);
+    // receive dataset and pass it to the consumer, which creates the file when appropriate
+    OFCondition status = receiveSTORERequest(reqMessage, presInfo.presentationContextID, outputStream);
+    if (status.good())
+    {
+        status = consumer.finish(filename);
+        // make sure that a refusal due to out of resources is sent to the SCU
+        if (status.bad())
+            status = makeDcmnetCondition(DIMSEC_OUTOFRESOURCES, OF_error, status.text());
+    }
+    return status;
+}
+
+
 void DcmStorageSCP::notifyInstanceStored(const OFString &filename,
                                          const OFString & /*sopClassUID*/,
                                          const OFString & /*sopInstanceUID*/,
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2011-2024, OFFIS e.V.
+ *  Copyright (C) 2011-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -23,6 +23,8 @@
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
 #include "dcmtk/ofstd/ofdatime.h"
+#include "dcmtk/ofstd/ofmap.h"
+#include "dcmtk/ofstd/ofthread.h"
 #include "dcmtk/dcmdata/dccodec.h"
 #include "dcmtk/dcmdata/dcfilefo.h"
 #include "dcmtk/dcmdata/dcdatutl.h"
@@ -36,6 +38,10 @@
 #define STATUS_STORE_Pending_NoPresentationContext 0xffff
 #define STATUS_STORE_Pending_InvalidDatasetPointer 0xfffe
 
+// maximum number of outstanding C-STORE requests if the peer accepted an unlimited
+// asynchronous operations window (the responses are not read while sending)
+#define DCMSTORSCU_MAX_OUTSTANDING_REQUESTS 64
+
 
 // helper functions
 
@@ -61,6 +67,17 @@ static const OFString &dicomToHostFilename(const OFString &dicomFilename,
 }
 
 
+// check whether the given error concerns the association as a whole (e.g. the network
+// connection) rather than a particular SOP instance, i.e. whether a retry makes sense
+static OFBool isAssociationFailure(const OFCondition &status)
+{
+    return (status.module() == OFM_dcmnet) &&
+           (status != DIMSE_NOVALIDPRESENTATIONCONTEXTID) &&
+           (status != NET_EC_InvalidDatasetPointer) &&
+           (status != NET_EC_NoSOPInstancesToSend);
+}
+
+
 // implementation of the internal class/struct for a single transfer entry
 
 DcmStorageSCU::TransferEntry::TransferEntry(const OFFilename &filename,
@@ -80,6 +97,7 @@ DcmStorageSCU::TransferEntry::TransferEntry(const OFFilename &filename,
     DatasetSize(0),
     AssociationNumber(0),
     PresentationContextID(0),
+    MessageID(0),
     RequestSent(OFFalse),
     ResponseStatusCode(0)
 {
@@ -104,6 +122,7 @@ DcmStorageSCU::TransferEntry::TransferEntry(DcmDataset *dataset,
     DatasetSize(0),
     AssociationNumber(0),
     PresentationContextID(0),
+    MessageID(0),
     RequestSent(OFFalse),
     ResponseStatusCode(0)
 {
@@ -134,6 +153,158 @@ void DcmStorageSCU::TransferEntry::Init()
 }
 
 
+// implementation of the internal classes for sending on concurrent associations
+
+struct DcmStorageSCU::ParallelContext
+{
+    ParallelContext(DcmStorageSCU &parent,
+                    const unsigned int maxRetries)
+      : Parent(parent),
+        MaxRetries(maxRetries),
+        Mutex(),
+        AssociationCounter(parent.AssociationCounter),
+        Stopped(OFFalse)
+    {
+    }
+
+    // the notifications are passed to the object that started the transfer, one at a time
+    void notifySOPInstanceToBeSent(const TransferEntry &transferEntry)
+    {
+        Mutex.lock();
+        Parent.notifySOPInstanceToBeSent(transferEntry);
+        Mutex.unlock();
+    }
+
+    void notifySOPInstanceSent(const TransferEntry &transferEntry)
+    {
+        Mutex.lock();
+        Parent.notifySOPInstanceSent(transferEntry);
+        Mutex.unlock();
+    }
+
+    // once a thread has been asked to stop, all threads stop
+    OFBool shouldStopAfterCurrentSOPInstance()
+    {
+        Mutex.lock();
+        if (!Stopped)
+            Stopped = Parent.shouldStopAfterCurrentSOPInstance();
+        const OFBool result = Stopped;
+        Mutex.unlock();
+        return result;
+    }
+
+    void stop()
+    {
+        Mutex.lock();
+        Stopped = OFTrue;
+        Mutex.unlock();
+    }
+
+    OFBool isStopped()
+    {
+        Mutex.lock();
+        const OFBool result = Stopped;
+        Mutex.unlock();
+        return result;
+    }
+
+    // the associations of all threads are numbered consecutively
+    unsigned long nextAssociationNumber()
+    {
+        Mutex.lock();
+        const unsigned long result = ++AssociationCounter;
+        Mutex.unlock();
+        return result;
+    }
+
+    /// object that started the transfer (and owns the transfer list)
+    DcmStorageSCU &Parent;
+    /// maximum number of retries per partition
+    const unsigned int MaxRetries;
+    /// mutex protecting the parent object and the following members
+    OFMutex Mutex;
+    /// association counter shared by all threads
+    unsigned long AssociationCounter;
+    /// flag indicating whether the transfer should be stopped
+    OFBool Stopped;
+
+  private:
+
+    // private undefined copy constructor
+    ParallelContext(const ParallelContext &);
+
+    // private undefined assignment operator
+    ParallelContext &operator=(const ParallelContext &);
+};
+
+
+class DcmStorageSCU::ParallelWorker
+  : public OFThread
+{
+  public:
+
+    ParallelWorker(ParallelContext &context,
+                   const OFList<TransferEntry *> &partition)
+      : OFThread(),
+        SCU(),
+        Status(EC_Normal)
+    {
+        DcmStorageSCU &parent = context.Parent;
+        // use the same settings as the object that started the transfer
+        SCU.setAETitle(parent.getAETitle());
+        SCU.setPeerAETitle(parent.getPeerAETitle());
+        SCU.setPeerHostName(parent.getPeerHostName());
+        SCU.setPeerPort(parent.getPeerPort());
+        SCU.setProtocolVersion(parent.getProtocolVersion());
+        SCU.setMaxReceivePDULength(parent.getMaxReceivePDULength());
+        SCU.setTCPBufferLength(parent.getTCPSendBufferLength(), parent.getTCPReceiveBufferLength());
+        SCU.setTCPNoDelay(parent.getTCPNoDelay());
+        SCU.setDIMSEBlockingMode(parent.getDIMSEBlockingMode());
+        SCU.setDIMSETimeout(parent.getDIMSETimeout());
+        SCU.setACSETimeout(parent.getACSETimeout());
+        SCU.setConnectionTimeout(parent.getConnectionTimeout());
+        SCU.setVerbosePCMode(parent.getVerbosePCMode());
+        SCU.setDatasetConversionMode(parent.getDatasetConversionMode());
+        SCU.setProgressNotificationMode(parent.getProgressNotificationMode());
+        SCU.setMaxNestingDepth(parent.getMaxNestingDepth());
+        SCU.setAsyncOperationsWindow(parent.getAsyncOperationsWindow());
+        SCU.DecompressionMode = parent.DecompressionMode;
+        SCU.HaltOnUnsuccessfulStoreMode = parent.HaltOnUnsuccessfulStoreMode;
+        SCU.AllowIllegalProposalMode = parent.AllowIllegalProposalMode;
+        SCU.MoveOriginatorAETitle = parent.MoveOriginatorAETitle;
+        SCU.MoveOriginatorMsgID = parent.MoveOriginatorMsgID;
+        // the transfer entries are shared with (and owned by) the parent object
+        SCU.TransferList = partition;
+        SCU.CurrentTransferEntry = SCU.TransferList.begin();
+        SCU.Context = &context;
+    }
+
+    ~ParallelWorker()
+    {
+        // do not delete the transfer entries
+        SCU.TransferList.clear();
+    }
+
+    virtual void run()
+    {
+        Status = SCU.sendPartition();
+    }
+
+    /// storage SCU sending the SOP instances of this partition
+    DcmStorageSCU SCU;
+    /// status of the transfer
+    OFCondition Status;
+
+  private:
+
+    // private undefined copy constructor
+    ParallelWorker(const ParallelWorker &);
+
+    // private undefined assignment operator
+    ParallelWorker &operator=(const ParallelWorker &);
+};
+
+
 // implementation of the main interface class
 
 DcmStorageSCU::DcmStorageSCU()
@@ -148,7 +319,8 @@ DcmStorageSCU::DcmStorageSCU()
     MoveOriginatorAETitle(),
     MoveOriginatorMsgID(0),
     TransferList(),
-    CurrentTransferEntry()
+    CurrentTransferEntry(),
+    Context(NULL)
 {
     CurrentTransferEntry = TransferList.begin();
 }
@@ -805,8 +977,11 @@ OFCondition DcmStorageSCU::negotiateAssociation()
             ++CurrentTransferEntry;
         }
     }
-    // increase the counter by 1 for every association
-    ++AssociationCounter;
+    // increase the counter by 1 for every association (of all threads, if applicable)
+    if (Context != NULL)
+        AssociationCounter = Context->nextAssociationNumber();
+    else
+        ++AssociationCounter;
     return status;
 }
 
@@ -817,7 +992,13 @@ OFCondition DcmStorageSCU::sendSOPInstances()
     // check whether there are any instances in the transfer list
     if (!TransferList.empty())
     {
-        DcmDataset *dataset = NULL;
+        // check whether an asynchronous operations window has been negotiated
+        const Uint16 maxOpsInvoked = getMaxOperationsInvoked();
+        if (maxOpsInvoked != 1)
+        {
+            // limit the number of outstanding requests if the window is unlimited
+            return sendSOPInstancesAsync((maxOpsInvoked == 0) ? DCMSTORSCU_MAX_OUTSTANDING_REQUESTS : maxOpsInvoked);
+        }
         // iterate over the list of SOP instances to be transferred
         // (continue with next SOP instance if there already was a transmission)
         OFListConstIterator(TransferEntry *) lastEntry = TransferList.end();
@@ -827,6 +1008,7 @@ OFCondition DcmStorageSCU::sendSOPInstances()
             if (!(*CurrentTransferEntry)->RequestSent)
             {
                 DcmFileFormat fileformat;
+                DcmDataset *dataset = NULL;
                 // check whether SOP instance can be sent on this association
                 // (i.e. whether it has been negotiated for this association)
                 if ((*CurrentTransferEntry)->PresentationContextID == 0)
@@ -834,67 +1016,10 @@ OFCondition DcmStorageSCU::sendSOPInstances()
                     // exit the loop if this is not the case (will be sent in another association)
                     break;
                 }
-                // output debug information on the SOP instance to be sent
-                if ((*CurrentTransferEntry)->Filename.isEmpty())
-                {
-                    if ((*CurrentTransferEntry)->Dataset != NULL)
-                    {
-                        DCMNET_DEBUG("sending SOP instance with UID: " << (*CurrentTransferEntry)->SOPInstanceUID);
-                        dataset = (*CurrentTransferEntry)->Dataset;
-                    } else {
-                        DCMNET_ERROR("cannot send SOP instance with UID: " << (*CurrentTransferEntry)->SOPInstanceUID
-                            << ": invalid dataset pointer");
-                        // mark the SOP instance as being sent with an error that is not defined for C-STORE;
-                        // the DIMSE status indicates "pending" (see above)
-                        (*CurrentTransferEntry)->RequestSent = OFTrue;
-                        (*CurrentTransferEntry)->ResponseStatusCode = STATUS_STORE_Pending_InvalidDatasetPointer;
-                        // return with an error
-                        status = NET_EC_InvalidDatasetPointer;
-                    }
-                } else {
-                    DCMNET_DEBUG("sending SOP instance from file: " << (*CurrentTransferEntry)->Filename);
-                    // load SOP instance from DICOM file
-                    status = fileformat.loadFile((*CurrentTransferEntry)->Filename, EXS_Unknown, EGL_noChange,
-                        DCM_MaxReadLength, (*CurrentTransferEntry)->FileReadMode);
-                    if (status.good())
-                    {
-                        // do not store the dataset pointer in the transfer entry, because this pointer
-                        // will become invalid for the next iteration of this while-loop.
-                        dataset = fileformat.getDataset();
-                    } else {
-                        DCMNET_ERROR("cannot send SOP instance from file: " << (*CurrentTransferEntry)->Filename
-                            << ": " << status.text());
-                    }
-                }
+                status = prepareSOPInstance(**CurrentTransferEntry, fileformat, dataset);
                 // send SOP instance to the peer using a C-STORE request message
                 if (status.good())
                 {
-                    // check whether UIDs in dataset are consistent with transfer list
-                    if (DCM_dcmnetLogger.isEnabledFor(OFLogger::WARN_LOG_LEVEL) && (dataset != NULL))
-                    {
-                        DCMNET_DEBUG("checking whether SOP Class UID and SOP Instance UID in dataset are consistent with transfer list");
-                        OFString sopClassUID, sopInstanceUID, transferSyntaxUID;
-                        if (DcmDataUtil::getSOPInstanceFromDataset(dataset, dataset->getOriginalXfer(), sopClassUID, sopInstanceUID, transferSyntaxUID).good())
-                        {
-                            // differences are usually a result of inconsistent values in meta-header and dataset
-                            if ((*CurrentTransferEntry)->SOPClassUID != sopClassUID)
-                            {
-                                DCMNET_WARN("SOP Class UID in dataset differs from the one in the transfer list");
-                                DCMNET_DEBUG("- SOP Class UID in DICOM dataset: " << sopClassUID);
-                                DCMNET_DEBUG("- SOP Class UID in transfer list: " << (*CurrentTransferEntry)->SOPClassUID);
-                            }
-                            if ((*CurrentTransferEntry)->SOPInstanceUID != sopInstanceUID)
-                            {
-                                DCMNET_WARN("SOP Instance UID in dataset differs from the one in the transfer list");
-                                DCMNET_DEBUG("- SOP Instance UID in DICOM dataset: " << sopInstanceUID);
-                                DCMNET_DEBUG("- SOP Instance UID in transfer list: " << (*CurrentTransferEntry)->SOPInstanceUID);
-                            }
-                        }
-                    }
-                    // determine size of the dataset (in bytes) based on the original transfer syntax
-                    (*CurrentTransferEntry)->DatasetSize = dataset->calcElementLength(dataset->getOriginalXfer(), g_dimse_send_sequenceType_encoding);
-                    // notify user of this class that the current SOP instance is to be sent
-                    notifySOPInstanceToBeSent(**CurrentTransferEntry);
                     // call the inherited method from the base class doing the real work
                     status = sendSTORERequest((*CurrentTransferEntry)->PresentationContextID, "" /* filename */, dataset,
                         (*CurrentTransferEntry)->ResponseStatusCode, MoveOriginatorAETitle, MoveOriginatorMsgID);
@@ -902,56 +1027,468 @@ OFCondition DcmStorageSCU::sendSOPInstances()
                     (*CurrentTransferEntry)->AssociationNumber = AssociationCounter;
                     (*CurrentTransferEntry)->NetworkTransferSyntax = dataset->getCurrentXfer();
                 }
-                // if it was successful (i.e. even if DIMSE status is not 0x0000 = success) ...
+                finishSOPInstance(**CurrentTransferEntry, status);
+            }
+            ++CurrentTransferEntry;
+            // check whether the sending process should be stopped
+            if (checkStopAfterCurrentSOPInstance())
+                break;
+        }
+    } else {
+        // report an error to the caller
+        status = NET_EC_NoSOPInstancesToSend;
+    }
+    return status;
+}
+
+
+OFCondition DcmStorageSCU::sendSOPInstancesAsync(const size_t maxOutstanding)
+{
+    OFCondition status = EC_Normal;
+    DCMNET_DEBUG("sending SOP instances with up to " << maxOutstanding << " outstanding C-STORE requests");
+    // list of SOP instances for which the C-STORE response has not yet been received
+    OFList<TransferEntry *> outstandingEntries;
+    OFBool continueSending = OFTrue;
+    OFListConstIterator(TransferEntry *) lastEntry = TransferList.end();
+    while (OFTrue)
+    {
+        // send the next SOP instance if the asynchronous operations window permits
+        if (continueSending && status.good() && (CurrentTransferEntry != lastEntry) &&
+            (outstandingEntries.size() < maxOutstanding))
+        {
+            TransferEntry *transferEntry = *CurrentTransferEntry;
+            // check whether SOP instance has already been sent
+            if (!transferEntry->RequestSent)
+            {
+                DcmFileFormat fileformat;
+                DcmDataset *dataset = NULL;
+                // check whether SOP instance can be sent on this association
+                if (transferEntry->PresentationContextID == 0)
+                {
+                    // stop sending if this is not the case (will be sent in another association),
+                    // but still wait for the outstanding responses
+                    continueSending = OFFalse;
+                    continue;
+                }
+                status = prepareSOPInstance(*transferEntry, fileformat, dataset);
                 if (status.good())
                 {
-                    // ... remember that this SOP instance has already been sent
-                    (*CurrentTransferEntry)->RequestSent = OFTrue;
-                    // check whether we need to compact or delete the dataset
-                    if ((*CurrentTransferEntry)->Filename.isEmpty() && ((*CurrentTransferEntry)->Dataset != NULL))
+                    // send the C-STORE request but do not wait for the response
+                    status = sendSTORERequestAsync(transferEntry->PresentationContextID, "" /* filename */, dataset,
+                        transferEntry->MessageID, MoveOriginatorAETitle, MoveOriginatorMsgID);
+                    // store some further information (even in case of error)
+                    transferEntry->AssociationNumber = AssociationCounter;
+                    transferEntry->NetworkTransferSyntax = dataset->getCurrentXfer();
+                }
+                if (status.good())
+                    outstandingEntries.push_back(transferEntry);
+                else
+                    finishSOPInstance(*transferEntry, status);
+            }
+            ++CurrentTransferEntry;
+            // check whether the sending process should be stopped
+            if (checkStopAfterCurrentSOPInstance())
+                continueSending = OFFalse;
+        }
+        // otherwise, receive the next response (if any)
+        else if (!outstandingEntries.empty())
+        {
+            Uint16 messageID = 0;
+            Uint16 rspStatusCode = 0;
+            OFCondition cond = receiveSTOREResponse(messageID, rspStatusCode);
+            if (cond.bad())
+            {
+                // the SOP instances with outstanding responses are not marked as sent
+                DCMNET_ERROR("no C-STORE response received for " << outstandingEntries.size() << " SOP instance(s)");
+                if (status.good())
+                    status = cond;
+                break;
+            }
+            // find the SOP instance this response belongs to
+            OFListIterator(TransferEntry *) entry = outstandingEntries.begin();
+            while ((entry != outstandingEntries.end()) && ((*entry)->MessageID != messageID))
+                ++entry;
+            if (entry != outstandingEntries.end())
+            {
+                (*entry)->ResponseStatusCode = rspStatusCode;
+                finishSOPInstance(**entry, cond);
+                outstandingEntries.erase(entry);
+            } else {
+                DCMNET_WARN("received C-STORE response for unknown message ID " << messageID << " (ignored)");
+            }
+        } else {
+            // all SOP instances sent and all responses received
+            break;
+        }
+    }
+    return status;
+}
+
+
+OFCondition DcmStorageSCU::sendSOPInstancesInParallel(const size_t numAssociations,
+                                                      const E_PartitionMode partitionMode,
+                                                      const unsigned int maxRetries)
+{
+    // check parameters and internal state
+    if (numAssociations == 0)
+        return EC_IllegalParameter;
+    if (isConnected())
+        return NET_EC_AlreadyConnected;
+    if (TransferList.empty())
+        return NET_EC_NoSOPInstancesToSend;
+    OFVector<OFList<TransferEntry *> > partitions;
+    partitionTransferList(numAssociations, partitionMode, partitions);
+    if (partitions.empty())
+    {
+        DCMNET_DEBUG("all SOP instances have already been sent");
+        return EC_Normal;
+    }
+    DCMNET_INFO("sending " << getNumberOfSOPInstancesToBeSent() << " SOP instances on up to "
+        << partitions.size() << " concurrent associations");
+    ParallelContext context(*this, maxRetries);
+    OFVector<ParallelWorker *> workers;
+    size_t i;
+    for (i = 0; i < partitions.size(); ++i)
+        workers.push_back(new ParallelWorker(context, partitions[i]));
+#ifdef WITH_THREADS
+    // start a thread for each partition (but the last one, which is sent by this thread)
+    OFVector<OFBool> started(workers.size(), OFFalse);
+    for (i = 0; i + 1 < workers.size(); ++i)
+    {
+        started[i] = (workers[i]->start() == 0);
+        if (!started[i])
+            DCMNET_WARN("cannot start thread for sending partition " << (i + 1) << ", sending it later");
+    }
+    workers.back()->run();
+    // wait for the threads to finish and send the partitions that could not be started
+    for (i = 0; i + 1 < workers.size(); ++i)
+    {
+        if (started[i])
+            workers[i]->join();
+        else if (!context.isStopped())
+            workers[i]->run();
+    }
+#else
+    DCMNET_WARN("no thread support, sending the " << workers.size() << " partitions one after the other");
+    for (i = 0; i < workers.size(); ++i)
+    {
+        if (!context.isStopped())
+            workers[i]->run();
+    }
+#endif
+    // collect the results (the first error is returned)
+    OFCondition status = EC_Normal;
+    for (i = 0; i < workers.size(); ++i)
+    {
+        if (status.good() && workers[i]->Status.bad())
+            status = workers[i]->Status;
+        PresentationContextCounter += workers[i]->SCU.PresentationContextCounter;
+        delete workers[i];
+    }
+    AssociationCounter = context.AssociationCounter;
+    // addPresentationContexts() skips the SOP instances that have been sent
+    CurrentTransferEntry = TransferList.begin();
+    return status;
+}
+
+
+void DcmStorageSCU::partitionTransferList(const size_t numPartitions,
+                                          const E_PartitionMode partitionMode,
+                                          OFVector<OFList<TransferEntry *> > &partitions)
+{
+    partitions.clear();
+    OFVector<OFList<TransferEntry *> > lists(numPartitions);
+    OFListIterator(TransferEntry *) transferEntry = TransferList.begin();
+    OFListConstIterator(TransferEntry *) lastEntry = TransferList.end();
+    if (partitionMode == PM_roundRobin)
+    {
+        // distribute the SOP instances that are not yet sent in turn
+        size_t index = 0;
+        while (transferEntry != lastEntry)
+        {
+            if (!(*transferEntry)->RequestSent)
+            {
+                lists[index].push_back(*transferEntry);
+                index = (index + 1) % numPartitions;
+            }
+            ++transferEntry;
+        }
+    } else {
+        // determine the study of each SOP instance that is not yet sent and the size of the
+        // studies (SOP instances without Study Instance UID are handled like a study each)
+        OFList<OFString> studyUIDs;
+        OFMap<OFString, size_t> studySizes;
+        OFString studyUID;
+        while (transferEntry != lastEntry)
+        {
+            if (!(*transferEntry)->RequestSent)
+            {
+                studyUID.clear();
+                if ((*transferEntry)->Filename.isEmpty())
+                {
+                    if ((*transferEntry)->Dataset != NULL)
+                        (*transferEntry)->Dataset->findAndGetOFStringArray(DCM_StudyInstanceUID, studyUID);
+                } else {
+                    // read the file up to the Study Instance UID (but without large element values)
+                    DcmFileFormat fileformat;
+                    if (fileformat.loadFileUntilTag((*transferEntry)->Filename, EXS_Unknown, EGL_noChange,
+                        256 /* maxReadLength */, (*transferEntry)->FileReadMode, DCM_SeriesInstanceUID).good())
                     {
-                        if ((*CurrentTransferEntry)->DatasetHandlingMode == HM_compactAfterSend)
-                        {
-                            DCMNET_DEBUG("compacting dataset after successful send");
-                            (*CurrentTransferEntry)->Dataset->compactElements(256 /* maxLength */);
-                        }
-                        else if ((*CurrentTransferEntry)->DatasetHandlingMode == HM_deleteAfterSend)
-                        {
-                            DCMNET_DEBUG("deleting dataset after successful send");
-                            delete (*CurrentTransferEntry)->Dataset;
-                            // forget about this dataset (e.g. in order to avoid double deletion)
-                            (*CurrentTransferEntry)->Dataset = NULL;
-                        }
+                        fileformat.getDataset()->findAndGetOFStringArray(DCM_StudyInstanceUID, studyUID);
                     }
-                } else {
-                    // if the SOP instance could not be sent because no acceptable presentation context was found
-                    if (status == DIMSE_NOVALIDPRESENTATIONCONTEXTID)
+                }
+                if (studyUID.empty())
+                    DCMNET_DEBUG("no Study Instance UID for SOP instance with UID: " << (*transferEntry)->SOPInstanceUID);
+                studyUIDs.push_back(studyUID);
+                if (!studyUID.empty())
+                    ++studySizes[studyUID];
+            }
+            ++transferEntry;
+        }
+        // assign each study (in the order of their first occurrence) to the partition with the
+        // fewest SOP instances so far
+        OFMap<OFString, size_t> studyPartitions;
+        OFVector<size_t> partitionSizes(numPartitions, 0);
+        OFListIterator(OFString) study = studyUIDs.begin();
+        transferEntry = TransferList.begin();
+        while (transferEntry != lastEntry)
+        {
+            if (!(*transferEntry)->RequestSent)
+            {
+                size_t index = 0;
+                OFMap<OFString, size_t>::iterator partition = studyPartitions.find(*study);
+                if (study->empty() || (partition == studyPartitions.end()))
+                {
+                    for (size_t i = 1; i < numPartitions; ++i)
                     {
-                        // mark the SOP instance as being sent with an error that is not defined for C-STORE;
-                        // the DIMSE status indicates "pending" (see above)
-                        (*CurrentTransferEntry)->RequestSent = OFTrue;
-                        (*CurrentTransferEntry)->ResponseStatusCode = STATUS_STORE_Pending_NoPresentationContext;
+                        if (partitionSizes[i] < partitionSizes[index])
+                            index = i;
+                    }
+                    if (study->empty())
+                        ++partitionSizes[index];
+                    else {
+                        partitionSizes[index] += studySizes[*study];
+                        studyPartitions[*study] = index;
                     }
-                    // do not exit the loop if the error should be ignored
-                    if (!HaltOnUnsuccessfulStoreMode && (status != DIMSE_ILLEGALASSOCIATION))
-                        status = EC_Normal;
+                } else
+                    index = partition->second;
+                lists[index].push_back(*transferEntry);
+                ++study;
+            }
+            ++transferEntry;
+        }
+    }
+    // do not add empty partitions
+    for (size_t i = 0; i < numPartitions; ++i)
+    {
+        if (!lists[i].empty())
+            partitions.push_back(lists[i]);
+    }
+}
+
+
+OFCondition DcmStorageSCU::sendPartition()
+{
+    OFCondition status = EC_Normal;
+    unsigned int numRetries = 0;
+    const unsigned int maxRetries = (Context != NULL) ? Context->MaxRetries : 0;
+    // add presentation contexts for the next association (if there are still any)
+    while ((status = addPresentationContexts()).good())
+    {
+        status = initNetwork();
+        if (status.good())
+        {
+            status = negotiateAssociation();
+            if (status.good())
+            {
+                DCMNET_DEBUG("sending SOP instances on association #" << AssociationCounter);
+                status = sendSOPInstances();
+                // close the association (depending on the error condition, if any)
+                if (status.good())
+                    releaseAssociation();
+                else if (status == DUL_PEERREQUESTEDRELEASE)
+                    closeAssociation(DCMSCU_PEER_REQUESTED_RELEASE);
+                else if (status == DUL_PEERABORTEDASSOCIATION)
+                    closeAssociation(DCMSCU_PEER_ABORTED_ASSOCIATION);
+                else
+                    abortAssociation();
+            }
+            else if (status == NET_EC_NoAcceptablePresentationContexts)
+            {
+                // the SOP instances concerned have been marked, continue with the next association
+                DCMNET_ERROR("cannot negotiate association #" << AssociationCounter << ": " << status.text());
+                releaseAssociation();
+                status = EC_Normal;
+            } else {
+                // the association was rejected or could not be requested
+                freeNetwork();
+            }
+        }
+        if (status.bad())
+        {
+            // start a new association for the remaining SOP instances (if permitted)
+            if (isAssociationFailure(status) && (numRetries < maxRetries) &&
+                ((Context == NULL) || !Context->isStopped()))
+            {
+                ++numRetries;
+                DCMNET_WARN("association #" << AssociationCounter << " failed: " << status.text()
+                    << ", retrying with a new association (" << numRetries << " of " << maxRetries << ")");
+                // the presentation contexts are negotiated again
+                OFListIterator(TransferEntry *) transferEntry = TransferList.begin();
+                OFListConstIterator(TransferEntry *) lastEntry = TransferList.end();
+                while (transferEntry != lastEntry)
+                {
+                    if (!(*transferEntry)->RequestSent)
+                        (*transferEntry)->PresentationContextID = 0;
+                    ++transferEntry;
                 }
-                // notify user of this class that the current SOP instance has been processed
-                notifySOPInstanceSent(**CurrentTransferEntry);
+                CurrentTransferEntry = TransferList.begin();
+                continue;
             }
-            ++CurrentTransferEntry;
-            // check whether the sending process should be stopped
-            if (shouldStopAfterCurrentSOPInstance())
-                break;
+            DCMNET_ERROR("cannot send SOP instances on association #" << AssociationCounter << ": " << status.text());
+            // stop the other threads as well (if required)
+            if ((Context != NULL) && HaltOnUnsuccessfulStoreMode)
+                Context->stop();
+            break;
+        }
+        // check whether the sending process should be stopped
+        if ((Context != NULL) && Context->isStopped())
+            break;
+    }
+    // there are no more SOP instances to be sent
+    if (status == NET_EC_NoPresentationContextsDefined)
+        status = EC_Normal;
+    return status;
+}
+
+
+OFBool DcmStorageSCU::checkStopAfterCurrentSOPInstance()
+{
+    // for a partition, the object that started the transfer decides
+    if (Context != NULL)
+        return Context->shouldStopAfterCurrentSOPInstance();
+    return shouldStopAfterCurrentSOPInstance();
+}
+
+
+OFCondition DcmStorageSCU::prepareSOPInstance(TransferEntry &transferEntry,
+                                              DcmFileFormat &fileformat,
+                                              DcmDataset *&dataset)
+{
+    OFCondition status = EC_Normal;
+    // output debug information on the SOP instance to be sent
+    if (transferEntry.Filename.isEmpty())
+    {
+        if (transferEntry.Dataset != NULL)
+        {
+            DCMNET_DEBUG("sending SOP instance with UID: " << transferEntry.SOPInstanceUID);
+            dataset = transferEntry.Dataset;
+        } else {
+            DCMNET_ERROR("cannot send SOP instance with UID: " << transferEntry.SOPInstanceUID
+                << ": invalid dataset pointer");
+            // mark the SOP instance as being sent with an error that is not defined for C-STORE;
+            // the DIMSE status indicates "pending" (see above)
+            transferEntry.RequestSent = OFTrue;
+            transferEntry.ResponseStatusCode = STATUS_STORE_Pending_InvalidDatasetPointer;
+            // return with an error
+            status = NET_EC_InvalidDatasetPointer;
         }
     } else {
-        // report an error to the caller
-        status = NET_EC_NoSOPInstancesToSend;
+        DCMNET_DEBUG("sending SOP instance from file: " << transferEntry.Filename);
+        // load SOP instance from DICOM file
+        status = fileformat.loadFile(transferEntry.Filename, EXS_Unknown, EGL_noChange,
+            DCM_MaxReadLength, transferEntry.FileReadMode);
+        if (status.good())
+        {
+            // do not store the dataset pointer in the transfer entry, because this pointer
+            // will become invalid when the file format object is destroyed.
+            dataset = fileformat.getDataset();
+        } else {
+            DCMNET_ERROR("cannot send SOP instance from file: " << transferEntry.Filename
+                << ": " << status.text());
+        }
+    }
+    if (status.good())
+    {
+        // check whether UIDs in dataset are consistent with transfer list
+        if (DCM_dcmnetLogger.isEnabledFor(OFLogger::WARN_LOG_LEVEL) && (dataset != NULL))
+        {
+            DCMNET_DEBUG("checking whether SOP Class UID and SOP Instance UID in dataset are consistent with transfer list");
+            OFString sopClassUID, sopInstanceUID, transferSyntaxUID;
+            if (DcmDataUtil::getSOPInstanceFromDataset(dataset, dataset->getOriginalXfer(), sopClassUID, sopInstanceUID, transferSyntaxUID).good())
+            {
+                // differences are usually a result of inconsistent values in meta-header and dataset
+                if (transferEntry.SOPClassUID != sopClassUID)
+                {
+                    DCMNET_WARN("SOP Class UID in dataset differs from the one in the transfer list");
+                    DCMNET_DEBUG("- SOP Class UID in DICOM dataset: " << sopClassUID);
+                    DCMNET_DEBUG("- SOP Class UID in transfer list: " << transferEntry.SOPClassUID);
+                }
+                if (transferEntry.SOPInstanceUID != sopInstanceUID)
+                {
+                    DCMNET_WARN("SOP Instance UID in dataset differs from the one in the transfer list");
+                    DCMNET_DEBUG("- SOP Instance UID in DICOM dataset: " << sopInstanceUID);
+                    DCMNET_DEBUG("- SOP Instance UID in transfer list: " << transferEntry.SOPInstanceUID);
+                }
+            }
+        }
+        // determine size of the dataset (in bytes) based on the original transfer syntax
+        transferEntry.DatasetSize = dataset->calcElementLength(dataset->getOriginalXfer(), g_dimse_send_sequenceType_encoding);
+        // notify user of this class that the current SOP instance is to be sent
+        if (Context != NULL)
+            Context->notifySOPInstanceToBeSent(transferEntry);
+        else
+            notifySOPInstanceToBeSent(transferEntry);
     }
     return status;
 }
 
 
+void DcmStorageSCU::finishSOPInstance(TransferEntry &transferEntry,
+                                      OFCondition &status)
+{
+    // if it was successful (i.e. even if DIMSE status is not 0x0000 = success) ...
+    if (status.good())
+    {
+        // ... remember that this SOP instance has already been sent
+        transferEntry.RequestSent = OFTrue;
+        // check whether we need to compact or delete the dataset
+        if (transferEntry.Filename.isEmpty() && (transferEntry.Dataset != NULL))
+        {
+            if (transferEntry.DatasetHandlingMode == HM_compactAfterSend)
+            {
+                DCMNET_DEBUG("compacting dataset after successful send");
+                transferEntry.Dataset->compactElements(256 /* maxLength */);
+            }
+            else if (transferEntry.DatasetHandlingMode == HM_deleteAfterSend)
+            {
+                DCMNET_DEBUG("deleting dataset after successful send");
+                delete transferEntry.Dataset;
+                // forget about this dataset (e.g. in order to avoid double deletion)
+                transferEntry.Dataset = NULL;
+            }
+        }
+    } else {
+        // if the SOP instance could not be sent because no acceptable presentation context was found
+        if (status == DIMSE_NOVALIDPRESENTATIONCONTEXTID)
+        {
+            // mark the SOP instance as being sent with an error that is not defined for C-STORE;
+            // the DIMSE status indicates "pending" (see above)
+            transferEntry.RequestSent = OFTrue;
+            transferEntry.ResponseStatusCode = STATUS_STORE_Pending_NoPresentationContext;
+        }
+        // do not exit the loop if the error should be ignored
+        if (!HaltOnUnsuccessfulStoreMode && (status != DIMSE_ILLEGALASSOCIATION))
+            status = EC_Normal;
+    }
+    // notify user of this class that the current SOP instance has been processed
+    if (Context != NULL)
+        Context->notifySOPInstanceSent(transferEntry);
+    else
+        notifySOPInstanceSent(transferEntry);
+}
+
+
 void DcmStorageSCU::notifySOPInstanceToBeSent(const TransferEntry & /*transferEntry*/)
 {
     // do nothing in the default implementation
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2025, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -64,6 +64,7 @@
 **                DUL_DropAssociation
 **                DUL_WritePDVs
 **                DUL_ReadPDVs
+**                DUL_ReadPDVDirect
 ** Author, Date:  Stephen M. Moore, 14-Apr-93
 ** Intent:        This module contains the public entry points for the
 **                DICOM Upper Layer (DUL) protocol package.
@@ -120,6 +121,7 @@ END_EXTERN_C
 #include "dcmtk/ofstd/ofconsol.h"
 #include "dcmtk/ofstd/ofstd.h"
 #include "dcmtk/ofstd/ofsockad.h" /* for class OFSockAddr and SOCK_CLOEXEC */
+#include "dcmtk/ofstd/oflimits.h"  /* for OFnumeric_limits */
 
 #include "dcmtk/dcmnet/dul.h"
 #include "dcmtk/dcmnet/dulstruc.h"
@@ -172,9 +174,9 @@ get_association_parameter(void *paramAddress,
   DUL_DATA_TYPE outputType, void *outputAddress, size_t outputLength);
 
 #ifdef _WIN32
-static void setTCPBufferLength(SOCKET sock);
+static void setTCPBufferLength(SOCKET sock, PRIVATE_NETWORKKEY *network);
 #else
-static void setTCPBufferLength(int sock);
+static void setTCPBufferLength(int sock, PRIVATE_NETWORKKEY *network);
 #endif
 
 static OFCondition checkNetwork(PRIVATE_NETWORKKEY ** networkKey);
@@ -184,8 +186,9 @@ static OFString dump_uid(const char *UID, const char *indent);
 static void clearRequestorsParams(DUL_ASSOCIATESERVICEPARAMETERS * params);
 static void clearPresentationContext(LST_HEAD ** l);
 
+/* must match ASC_MINIMUMPDUSIZE and ASC_MAXIMUMPDUSIZE in assoc.h */
 #define MIN_PDU_LENGTH  4*1024
-#define MAX_PDU_LENGTH  128*1024
+#define MAX_PDU_LENGTH  16*1024*1024
 
 static OFBool processIsForkedChild = OFFalse;
 static OFBool shouldFork = OFFalse;
@@ -1276,6 +1279,70 @@ DUL_ReadPDVs(DUL_ASSOCIATIONKEY ** callerAssociation,
 }
 
 
+/* DUL_ReadPDVDirect
+**
+** Purpose:
+**      Read the next available PDU. If it is a P DATA PDU consisting of
+**      a single PDV whose data fragment fits into the caller's buffer,
+**      read the fragment directly into this buffer, thus avoiding the
+**      copy from the internal PDU buffer.
+**
+** Parameter Dictionary:
+**      callerAssociation  Caller's handle for the Association.
+**      buffer             Buffer for the PDV's data fragment.
+**      length             Length of the buffer.
+**      block              Option used for blocking/non-blocking read.
+**      timeout            Timeout interval.
+**      pdv                The PDV read into the buffer (returned to the
+**                         caller). If no PDV was read into the buffer,
+**                         pdv->data is NULL and the PDVs of the PDU (if
+**                         any) are retrieved with DUL_NextPDV.
+**
+** Return Values:
+**      EC_Normal if PDVs of the last PDU are still pending (nothing read),
+**      otherwise the same values as DUL_ReadPDVs.
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+OFCondition
+DUL_ReadPDVDirect(DUL_ASSOCIATIONKEY ** callerAssociation,
+                  void *buffer, unsigned long length,
+                  DUL_BLOCKOPTIONS block, int timeout, DUL_PDV * pdv)
+{
+    PRIVATE_ASSOCIATIONKEY
+        ** association;
+
+    /* assign the association to local variable */
+    association = (PRIVATE_ASSOCIATIONKEY **) callerAssociation;
+
+    /* check if association is valid, if not return an error */
+    OFCondition cond = checkAssociation(association);
+    if (cond.bad()) return cond;
+
+    pdv->data = NULL;
+    pdv->fragmentLength = 0;
+
+    /* PDVs of the last PDU have to be processed first */
+    if ((*association)->pdvIndex != -1) return EC_Normal;
+
+    /* let the state machine read the fragment into the caller's buffer, if possible */
+    (*association)->directBuffer = OFstatic_cast(unsigned char *, buffer);
+    (*association)->directBufferLength = length;
+    cond = DUL_ReadPDVs(callerAssociation, NULL, block, timeout);
+    (*association)->directBuffer = NULL;
+    (*association)->directBufferLength = 0;
+
+    /* if the PDV was read into the buffer, return it */
+    if ((cond == DUL_PDATAPDUARRIVED) && ((*association)->pdvIndex == 0) &&
+        ((*association)->currentPDV.data == buffer))
+    {
+        (void) DUL_NextPDV(callerAssociation, pdv);
+    }
+    return cond;
+}
+
+
 /* DUL_AssociationParameter
 **
 ** Purpose:
@@ -1932,13 +1999,14 @@ receiveTransportConnectionTCP(PRIVATE_NETWORKKEY ** network,
         OFSTRINGSTREAM_GETOFSTRING(stream, msg)
         return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
     }
-    setTCPBufferLength(sock);
+    setTCPBufferLength(sock, *network);
 
     /*
      * Disable the so-called Nagle algorithm (if requested).
      * This might provide a better network performance on some systems/environments.
      * By default, the algorithm is not disabled unless DISABLE_NAGLE_ALGORITHM is defined.
-     * The default behavior can be changed by setting the environment variable TCP_NODELAY.
+     * The default behavior can be changed by setting the environment variable TCP_NODELAY
+     * or, for a particular network, by calling DUL_setTCPNoDelay().
      */
 
 #ifdef DONT_DISABLE_NAGLE_ALGORITHM
@@ -1955,20 +2023,31 @@ receiveTransportConnectionTCP(PRIVATE_NETWORKKEY ** network,
     int tcpNoDelay = 0; // don't disable
 #endif
     char* tcpNoDelayString = NULL;
-    DCMNET_TRACE("checking whether environment variable TCP_NODELAY is set");
-    if ((tcpNoDelayString = getenv("TCP_NODELAY")) != NULL)
+    if ((*network)->tcpNoDelay >= 0)
     {
-      if (sscanf(tcpNoDelayString, "%d", &tcpNoDelay) != 1)
+      tcpNoDelay = (*network)->tcpNoDelay;
+      DCMNET_TRACE("using the TCP_NODELAY setting of the network (" << tcpNoDelay << ")");
+    }
+    else
+    {
+      DCMNET_TRACE("checking whether environment variable TCP_NODELAY is set");
+      if ((tcpNoDelayString = getenv("TCP_NODELAY")) != NULL)
       {
-        DCMNET_WARN("DUL: cannot parse environment variable TCP_NODELAY=" << tcpNoDelayString);
-      }
-    } else
-      DCMNET_TRACE("  environment variable TCP_NODELAY not set, using the default value (" << tcpNoDelay << ")");
+        if (sscanf(tcpNoDelayString, "%d", &tcpNoDelay) != 1)
+        {
+          DCMNET_WARN("DUL: cannot parse environment variable TCP_NODELAY=" << tcpNoDelayString);
+        }
+      } else
+        DCMNET_TRACE("  environment variable TCP_NODELAY not set, using the default value (" << tcpNoDelay << ")");
+    }
     if (tcpNoDelay) {
+      if ((*network)->tcpNoDelay > 0)
+        DCMNET_DEBUG("DUL: disabling Nagle algorithm as configured for the network");
+      else
 #ifdef DISABLE_NAGLE_ALGORITHM
-      DCMNET_DEBUG("DUL: disabling Nagle algorithm as defined at compilation time (DISABLE_NAGLE_ALGORITHM)");
+        DCMNET_DEBUG("DUL: disabling Nagle algorithm as defined at compilation time (DISABLE_NAGLE_ALGORITHM)");
 #else
-      DCMNET_DEBUG("DUL: disabling Nagle algorithm as requested at runtime (TCP_NODELAY=" << tcpNoDelayString << ")");
+        DCMNET_DEBUG("DUL: disabling Nagle algorithm as requested at runtime (TCP_NODELAY=" << tcpNoDelayString << ")");
 #endif
       if (setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (char*)&tcpNoDelay, sizeof(tcpNoDelay)) < 0)
       {
@@ -1978,6 +2057,8 @@ receiveTransportConnectionTCP(PRIVATE_NETWORKKEY ** network,
         OFSTRINGSTREAM_GETOFSTRING(stream, msg)
         return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
       }
+    } else if ((*network)->tcpNoDelay == 0) {
+      DCMNET_DEBUG("DUL: do not disable Nagle algorithm as configured for the network");
 #ifdef DISABLE_NAGLE_ALGORITHM
     } else {
       DCMNET_DEBUG("DUL: do not disable Nagle algorithm as requested at runtime (TCP_NODELAY=" << tcpNoDelayString << ")");
@@ -2153,6 +2234,11 @@ createNetworkKey(const char *mode,
 
     (*key)->options = opt;
 
+    /* use the system defaults or the environment variables for the socket options */
+    (*key)->tcpSendBufferLength = 0;
+    (*key)->tcpReceiveBufferLength = 0;
+    (*key)->tcpNoDelay = -1;
+
     return EC_Normal;
 }
 
@@ -2431,8 +2517,7 @@ createAssociationKey(PRIVATE_NETWORKKEY ** networkKey,
 {
     PRIVATE_ASSOCIATIONKEY *key;
 
-    key = (PRIVATE_ASSOCIATIONKEY *) malloc(
-        size_t(sizeof(PRIVATE_ASSOCIATIONKEY) + maxPDU + 100));
+    key = (PRIVATE_ASSOCIATIONKEY *) malloc(sizeof(PRIVATE_ASSOCIATIONKEY));
     if (key == NULL) return EC_MemoryExhausted;
     key->receivePDUQueue = NULL;
 
@@ -2444,12 +2529,18 @@ createAssociationKey(PRIVATE_NETWORKKEY ** networkKey,
     key->timeout = (*networkKey)->timeout;
     key->timerStart = 0;
     key->maxPDVInput = maxPDU;
-    key->fragmentBufferLength = maxPDU + 100;
-    key->fragmentBuffer = (unsigned char *) key + sizeof(*key);
+    /* the buffer for incoming P-DATA PDUs is allocated when the first one is
+     * received, since large maximum PDU sizes would otherwise waste a lot of
+     * memory for associations that never receive (much) data
+     */
+    key->fragmentBufferLength = 0;
+    key->fragmentBuffer = NULL;
+    key->directBuffer = NULL;
+    key->directBufferLength = 0;
 
     key->pdvList.count = 0;
-    key->pdvList.scratch = key->fragmentBuffer;
-    key->pdvList.scratchLength = maxPDU;
+    key->pdvList.scratch = NULL;
+    key->pdvList.scratchLength = 0;
     key->pdvList.abort.result = 0x00;
     key->pdvList.abort.source = 0x00;
     key->pdvList.abort.reason = 0x00;
@@ -2497,6 +2588,7 @@ static void
 destroyAssociationKey(PRIVATE_ASSOCIATIONKEY ** key)
 {
     if (*key && (*key)->connection) delete (*key)->connection;
+    if (*key) free((*key)->fragmentBuffer);
     free(*key);
     *key = NULL;
 }
@@ -2547,10 +2639,14 @@ get_association_parameter(void *paramAddress,
 /* setTCPBufferLength
 **
 ** Purpose:
-**      Initialize the length of the buffer.
+**      Initialize the length of the socket send and receive buffers,
+**      either to the values set for the network with
+**      DUL_setTCPBufferLength() or to the value of the environment
+**      variable TCP_BUFFER_LENGTH.
 **
 ** Parameter Dictionary:
-**      sock  Socket descriptor.
+**      sock     Socket descriptor.
+**      network  Handle to the network environment (may be NULL)
 **
 ** Return Values:
 **      None
@@ -2562,14 +2658,34 @@ get_association_parameter(void *paramAddress,
 **      Description of the algorithm (optional) and any other notes.
 */
 #ifdef _WIN32
-static void setTCPBufferLength(SOCKET sock)
+static void setTCPBufferLength(SOCKET sock, PRIVATE_NETWORKKEY *network)
 #else
-static void setTCPBufferLength(int sock)
+static void setTCPBufferLength(int sock, PRIVATE_NETWORKKEY *network)
 #endif
 {
     char *TCPBufferLength;
     int bufLen;
 
+#if defined(SO_SNDBUF) && defined(SO_RCVBUF)
+    /* explicit settings for the network take precedence over the environment variable */
+    if (network && (network->tcpSendBufferLength > 0 || network->tcpReceiveBufferLength > 0))
+    {
+        if (network->tcpSendBufferLength > 0)
+        {
+            bufLen = OFstatic_cast(int, network->tcpSendBufferLength);
+            DCMNET_DEBUG("DUL: setting TCP send buffer length to " << bufLen << " bytes");
+            (void) setsockopt(sock, SOL_SOCKET, SO_SNDBUF, (char *) &bufLen, sizeof(bufLen));
+        }
+        if (network->tcpReceiveBufferLength > 0)
+        {
+            bufLen = OFstatic_cast(int, network->tcpReceiveBufferLength);
+            DCMNET_DEBUG("DUL: setting TCP receive buffer length to " << bufLen << " bytes");
+            (void) setsockopt(sock, SOL_SOCKET, SO_RCVBUF, (char *) &bufLen, sizeof(bufLen));
+        }
+        return;
+    }
+#endif
+
     /*
      * check whether environment variable TCP_BUFFER_LENGTH is set.
      * If not, the the operating system is responsible for selecting
@@ -2962,6 +3078,38 @@ OFCondition DUL_setTransportLayer(DUL_NETWORKKEY *callerNetworkKey, DcmTransport
   return DUL_NULLKEY;
 }
 
+OFCondition DUL_setTCPBufferLength(DUL_NETWORKKEY *callerNetworkKey, unsigned long sendBufferLength, unsigned long receiveBufferLength)
+{
+  if (callerNetworkKey == NULL) return DUL_NULLKEY;
+  if ((sendBufferLength > OFstatic_cast(unsigned long, OFnumeric_limits<int>::max())) || (receiveBufferLength > OFstatic_cast(unsigned long, OFnumeric_limits<int>::max())))
+    return makeDcmnetCondition(DULC_ILLEGALPARAMETER, OF_error, "DUL Illegal parameter (TCP buffer length) in function DUL_setTCPBufferLength");
+  PRIVATE_NETWORKKEY * key = (PRIVATE_NETWORKKEY *) callerNetworkKey;
+  key->tcpSendBufferLength = sendBufferLength;
+  key->tcpReceiveBufferLength = receiveBufferLength;
+
+  /* accepted connections inherit the buffer lengths of the listen socket,
+   * which also determine the TCP window scaling negotiated with the peer
+   */
+  if ((key->applicationFunction & DICOM_APPLICATION_ACCEPTOR) &&
+#ifdef _WIN32
+      (key->networkSpecific.TCP.listenSocket != INVALID_SOCKET))
+#else
+      (key->networkSpecific.TCP.listenSocket >= 0))
+#endif
+  {
+    setTCPBufferLength(key->networkSpecific.TCP.listenSocket, key);
+  }
+  return EC_Normal;
+}
+
+OFCondition DUL_setTCPNoDelay(DUL_NETWORKKEY *callerNetworkKey, int noDelay)
+{
+  if (callerNetworkKey == NULL) return DUL_NULLKEY;
+  PRIVATE_NETWORKKEY * key = (PRIVATE_NETWORKKEY *) callerNetworkKey;
+  key->tcpNoDelay = (noDelay < 0) ? -1 : (noDelay ? 1 : 0);
+  return EC_Normal;
+}
+
 OFString& DUL_DumpConnectionParameters(OFString& str, DUL_ASSOCIATIONKEY *association)
 {
   if (association)
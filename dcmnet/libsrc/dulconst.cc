@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2024, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -93,6 +93,11 @@ static OFCondition
 constructMaxLength(unsigned long maxPDU, DUL_MAXLENGTH * max,
                    unsigned long *rtnLen);
 static OFCondition
+constructAsyncOperations(unsigned short maxOpsInvoked,
+                         unsigned short maxOpsPerformed,
+                         PRV_ASYNCOPERATIONS * async,
+                         unsigned long *rtnLen);
+static OFCondition
 constructSCUSCPRoles(unsigned char type,
                      DUL_ASSOCIATESERVICEPARAMETERS * params,
                      LST_HEAD ** lst,
@@ -114,6 +119,9 @@ streamUserInfo(DUL_USERINFO * userInfo, unsigned char *b,
 static OFCondition
 streamMaxLength(DUL_MAXLENGTH * max, unsigned char *b,
                 unsigned long *length);
+static OFCondition
+streamAsyncOperations(PRV_ASYNCOPERATIONS * async, unsigned char *b,
+                      unsigned long *length);
 static OFCondition
     streamSCUSCPList(LST_HEAD ** lst, unsigned char *b, unsigned long *length);
 static OFCondition
@@ -846,7 +854,15 @@ constructUserInfo(unsigned char type, DUL_ASSOCIATESERVICEPARAMETERS * params,
     totalUserInfoLength += length;
     *rtnLen += length;
 
-    // user info sub-item 53H (async operations) is not yet implemented!
+    // construct user info sub-item 53H: asynchronous operations window.
+    // The item is only sent if a window has been set in the parameters
+    if ((params->maximumOperationsInvoked != 0) || (params->maximumOperationsPerformed != 0)) {
+        cond = constructAsyncOperations(params->maximumOperationsInvoked,
+                params->maximumOperationsPerformed, &userInfo->asyncOperations, &length);
+        if (cond.bad()) return cond;
+        totalUserInfoLength += length;
+        *rtnLen += length;
+    }
 
     // construct user info sub-item 55H: implementation version name
     if (type == DUL_TYPEASSOCIATERQ) {
@@ -952,6 +968,41 @@ constructMaxLength(unsigned long maxPDU, DUL_MAXLENGTH * max,
 }
 
 
+/* constructAsyncOperations
+**
+** Purpose:
+**  Construct the Asynchronous Operations Window part of the PDU
+**
+** Parameter Dictionary:
+**  maxOpsInvoked    Maximum number of outstanding operations invoked
+**  maxOpsPerformed  Maximum number of outstanding operations performed
+**  async            The Asynchronous Operations Window item that is to be constructed
+**  rtnLength        Length of the item constructed.
+**
+** Return Values:
+**
+** Algorithm:
+**  Description of the algorithm (optional) and any other notes.
+*/
+
+static OFCondition
+constructAsyncOperations(unsigned short maxOpsInvoked,
+                         unsigned short maxOpsPerformed,
+                         PRV_ASYNCOPERATIONS * async,
+                         unsigned long *rtnLen)
+{
+    async->type = DUL_TYPEASYNCOPERATIONS;
+    async->rsv1 = 0;
+    async->length = 4;
+    async->maximumOperationsInvoked = maxOpsInvoked;
+    async->maximumOperationsProvided = maxOpsPerformed;
+
+    *rtnLen = 8;
+
+    return EC_Normal;
+}
+
+
 /* constructSCUSCPRoles
 **
 ** Purpose:
@@ -1305,7 +1356,14 @@ streamUserInfo(DUL_USERINFO * userInfo, unsigned char *b,
     b += subLength;
     *length += subLength;
 
-    // user info sub-item 53H (async operations) is not yet implemented!
+    // stream user info sub-item 53H: asynchronous operations window
+    if (userInfo->asyncOperations.type == DUL_TYPEASYNCOPERATIONS) {
+        cond = streamAsyncOperations(&userInfo->asyncOperations, b, &subLength);
+        if (cond.bad())
+            return cond;
+        b += subLength;
+        *length += subLength;
+    }
 
 #ifdef OLD_USER_INFO_SUB_ITEM_ORDER
     /* prior DCMTK releases did not encode user information sub items
@@ -1396,6 +1454,38 @@ streamMaxLength(DUL_MAXLENGTH * max, unsigned char *b,
     return EC_Normal;
 }
 
+/* streamAsyncOperations
+**
+** Purpose:
+**  Convert the Asynchronous Operations Window structure into stream format
+**
+** Parameter Dictionary:
+**  async     Asynchronous Operations Window structure to be converted to stream format
+**  b         The stream version (output)
+**  length    Length of the stream version
+**
+** Return Values:
+**
+** Algorithm:
+**  Description of the algorithm (optional) and any other notes.
+*/
+static OFCondition
+streamAsyncOperations(PRV_ASYNCOPERATIONS * async, unsigned char *b,
+                      unsigned long *length)
+{
+
+    *b++ = async->type;
+    *b++ = async->rsv1;
+    COPY_SHORT_BIG(async->length, b);
+    b += 2;
+    COPY_SHORT_BIG(async->maximumOperationsInvoked, b);
+    b += 2;
+    COPY_SHORT_BIG(async->maximumOperationsProvided, b);
+
+    *length = 8;
+    return EC_Normal;
+}
+
 /* streamSCUSCPList
 **
 ** Purpose:
@@ -120,6 +120,13 @@ DcmNativeSocketType DUL_networkSocket(DUL_NETWORKKEY * callerNet)
     return net->networkSpecific.TCP.listenSocket;
 }
 
+DcmNativeSocketType DUL_associationSocket(DUL_ASSOCIATIONKEY * callerAssociation)
+{
+    PRIVATE_ASSOCIATIONKEY * association = (PRIVATE_ASSOCIATIONKEY *)callerAssociation;
+    if ((association == NULL) || (association->connection == NULL)) return DCMNET_INVALID_SOCKET;
+    return association->connection->getSocket();
+}
+
 OFBool
 DUL_associationWaiting(DUL_NETWORKKEY * callerNet, int timeout)
 {
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 1994-2025, OFFIS e.V.
+ *  Copyright (C) 1994-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were partly developed by
@@ -283,6 +283,11 @@ static OFCondition
 writeDataPDU(PRIVATE_ASSOCIATIONKEY ** association,
              DUL_DATAPDU * pdu);
 static void clearPDUCache(PRIVATE_ASSOCIATIONKEY ** association);
+static OFCondition allocateFragmentBuffer(PRIVATE_ASSOCIATIONKEY ** association);
+static OFCondition
+readPDVDirect(PRIVATE_ASSOCIATIONKEY ** association,
+              unsigned char *pduType, unsigned char *pduReserved,
+              unsigned long *pduLength, OFBool& done);
 static void closeTransport(PRIVATE_ASSOCIATIONKEY ** association);
 static void closeTransportTCP(PRIVATE_ASSOCIATIONKEY ** association);
 static OFCondition
@@ -321,9 +326,9 @@ defragmentTCP(DcmTransportConnection *connection, DUL_BLOCKOPTIONS block, time_t
 static OFString dump_pdu(const char *type, void *buffer, unsigned long length);
 
 #ifdef _WIN32
-static void setTCPBufferLength(SOCKET sock);
+static void setTCPBufferLength(SOCKET sock, PRIVATE_NETWORKKEY *network);
 #else
-static void setTCPBufferLength(int sock);
+static void setTCPBufferLength(int sock, PRIVATE_NETWORKKEY *network);
 #endif
 
 OFCondition
@@ -1045,6 +1050,14 @@ AE_3_AssociateConfirmationAccept(PRIVATE_NETWORKKEY ** /*network*/,
         destroyAssociatePDUPresentationContextList(&assoc.presentationContextList);
         destroyUserInformationLists(&assoc.userInfo);
         service->peerMaxPDU = assoc.userInfo.maxLength.maxLength;
+        /* asynchronous operations window (default: no asynchronous operations) */
+        if (assoc.userInfo.asyncOperations.type == DUL_TYPEASYNCOPERATIONS) {
+            service->peerMaximumOperationsInvoked = assoc.userInfo.asyncOperations.maximumOperationsInvoked;
+            service->peerMaximumOperationsPerformed = assoc.userInfo.asyncOperations.maximumOperationsProvided;
+        } else {
+            service->peerMaximumOperationsInvoked = 1;
+            service->peerMaximumOperationsPerformed = 1;
+        }
         (*association)->maxPDV = assoc.userInfo.maxLength.maxLength;
         (*association)->maxPDVAcceptor =
             assoc.userInfo.maxLength.maxLength;
@@ -1246,6 +1259,14 @@ AE_6_ExamineAssociateRequest(PRIVATE_NETWORKKEY ** /*network*/,
         }
 
         service->peerMaxPDU = assoc.userInfo.maxLength.maxLength;
+        /* asynchronous operations window (default: no asynchronous operations) */
+        if (assoc.userInfo.asyncOperations.type == DUL_TYPEASYNCOPERATIONS) {
+            service->peerMaximumOperationsInvoked = assoc.userInfo.asyncOperations.maximumOperationsInvoked;
+            service->peerMaximumOperationsPerformed = assoc.userInfo.asyncOperations.maximumOperationsProvided;
+        } else {
+            service->peerMaximumOperationsInvoked = 1;
+            service->peerMaximumOperationsPerformed = 1;
+        }
         (*association)->maxPDV = assoc.userInfo.maxLength.maxLength;
         (*association)->maxPDVRequestor =
             assoc.userInfo.maxLength.maxLength;
@@ -1420,12 +1441,32 @@ DT_2_IndicatePData(PRIVATE_NETWORKKEY ** /*network*/,
     /* determine the finite state machine's next state */
     (*association)->protocolState = nextState;
 
-    /* read PDU body information from the incoming socket stream. In case the incoming */
-    /* PDU's header information has not yet been read, also read this information. */
-    OFCondition cond = readPDUBody(association, DUL_BLOCK, 0,
-                       (*association)->fragmentBuffer,
-                       (*association)->fragmentBufferLength,
-                       &pduType, &pduReserved, &pduLength);
+    /* if the caller provided a buffer for the next PDV (see DUL_ReadPDVDirect), */
+    /* try to read the PDV's data fragment directly into that buffer */
+    OFCondition cond = EC_Normal;
+    if ((*association)->directBuffer != NULL)
+    {
+        OFBool done = OFFalse;
+        cond = readPDVDirect(association, &pduType, &pduReserved, &pduLength, done);
+        if (cond.bad())
+            return cond;
+        if (done)
+            return DUL_PDATAPDUARRIVED;
+    }
+    else
+    {
+        /* make sure that the buffer for the PDU's PDVs is large enough */
+        cond = allocateFragmentBuffer(association);
+        if (cond.bad())
+            return cond;
+
+        /* read PDU body information from the incoming socket stream. In case the incoming */
+        /* PDU's header information has not yet been read, also read this information. */
+        cond = readPDUBody(association, DUL_BLOCK, 0,
+                           (*association)->fragmentBuffer,
+                           (*association)->fragmentBufferLength,
+                           &pduType, &pduReserved, &pduLength);
+    }
 
     /* return error if there was one */
     if (cond.bad())
@@ -2324,6 +2365,7 @@ requestAssociationTCP(PRIVATE_NETWORKKEY ** network,
     server.setPort(OFstatic_cast(unsigned short, htons(OFstatic_cast(unsigned short, port))));
 
     const Sint32 connectTimeout = params->tcpConnectTimeout;
+    PRIVATE_NETWORKKEY *networkKey = network ? *network : NULL;
 
 #ifdef HAVE_WINSOCK_H
     u_long arg = TRUE;
@@ -2357,6 +2399,10 @@ requestAssociationTCP(PRIVATE_NETWORKKEY ** network,
       return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
     }
 
+    // the receive buffer length must be set before connecting since it
+    // determines the TCP window scaling negotiated with the peer
+    setTCPBufferLength(s, networkKey);
+
     if (connectTimeout >= 0)
     {
       // user has specified a timeout, switch socket to non-blocking mode
@@ -2534,13 +2580,13 @@ requestAssociationTCP(PRIVATE_NETWORKKEY ** network,
           msg += OFStandard::getLastNetworkErrorCode().message();
           return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
         }
-        setTCPBufferLength(s);
 
         /*
          * Disable the so-called Nagle algorithm (if requested).
          * This might provide a better network performance on some systems/environments.
          * By default, the algorithm is not disabled unless DISABLE_NAGLE_ALGORITHM is defined.
-         * The default behavior can be changed by setting the environment variable TCP_NODELAY.
+         * The default behavior can be changed by setting the environment variable TCP_NODELAY
+         * or, for a particular network, by calling DUL_setTCPNoDelay().
          */
 
 #ifdef DONT_DISABLE_NAGLE_ALGORITHM
@@ -2557,20 +2603,32 @@ requestAssociationTCP(PRIVATE_NETWORKKEY ** network,
         int tcpNoDelay = 0; // don't disable
 #endif
         char* tcpNoDelayString = NULL;
-        DCMNET_TRACE("checking whether environment variable TCP_NODELAY is set");
-        if ((tcpNoDelayString = getenv("TCP_NODELAY")) != NULL)
+        const int networkNoDelay = networkKey ? networkKey->tcpNoDelay : -1;
+        if (networkNoDelay >= 0)
         {
-          if (sscanf(tcpNoDelayString, "%d", &tcpNoDelay) != 1)
+          tcpNoDelay = networkNoDelay;
+          DCMNET_TRACE("using the TCP_NODELAY setting of the network (" << tcpNoDelay << ")");
+        }
+        else
+        {
+          DCMNET_TRACE("checking whether environment variable TCP_NODELAY is set");
+          if ((tcpNoDelayString = getenv("TCP_NODELAY")) != NULL)
           {
-            DCMNET_WARN("DULFSM: cannot parse environment variable TCP_NODELAY=" << tcpNoDelayString);
-          }
-        } else
-          DCMNET_TRACE("  environment variable TCP_NODELAY not set, using the default value (" << tcpNoDelay << ")");
+            if (sscanf(tcpNoDelayString, "%d", &tcpNoDelay) != 1)
+            {
+              DCMNET_WARN("DULFSM: cannot parse environment variable TCP_NODELAY=" << tcpNoDelayString);
+            }
+          } else
+            DCMNET_TRACE("  environment variable TCP_NODELAY not set, using the default value (" << tcpNoDelay << ")");
+        }
         if (tcpNoDelay) {
+          if (networkNoDelay > 0)
+            DCMNET_DEBUG("DULFSM: disabling Nagle algorithm as configured for the network");
+          else
 #ifdef DISABLE_NAGLE_ALGORITHM
-          DCMNET_DEBUG("DULFSM: disabling Nagle algorithm as defined at compilation time (DISABLE_NAGLE_ALGORITHM)");
+            DCMNET_DEBUG("DULFSM: disabling Nagle algorithm as defined at compilation time (DISABLE_NAGLE_ALGORITHM)");
 #else
-          DCMNET_DEBUG("DULFSM: disabling Nagle algorithm as requested at runtime (TCP_NODELAY=" << tcpNoDelayString << ")");
+            DCMNET_DEBUG("DULFSM: disabling Nagle algorithm as requested at runtime (TCP_NODELAY=" << tcpNoDelayString << ")");
 #endif
           if (setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (char*)&tcpNoDelay, sizeof(tcpNoDelay)) < 0)
           {
@@ -2578,6 +2636,8 @@ requestAssociationTCP(PRIVATE_NETWORKKEY ** network,
             msg += OFStandard::getLastNetworkErrorCode().message();
             return makeDcmnetCondition(DULC_TCPINITERROR, OF_error, msg.c_str());
           }
+        } else if (networkNoDelay == 0) {
+          DCMNET_DEBUG("DULFSM: do not disable Nagle algorithm as configured for the network");
 #ifdef DISABLE_NAGLE_ALGORITHM
         } else {
           DCMNET_DEBUG("DULFSM: do not disable Nagle algorithm as requested at runtime (TCP_NODELAY=" << tcpNoDelayString << ")");
@@ -3224,6 +3284,158 @@ clearPDUCache(PRIVATE_ASSOCIATIONKEY ** association)
     (*association)->inputPDU = NO_PDU;
 }
 
+
+/* allocateFragmentBuffer()
+**
+** Purpose:
+**      Make sure that the fragment buffer of the Association is large
+**      enough for the P-DATA PDU whose header has already been read.
+**      The buffer is allocated on demand and enlarged (at least doubled)
+**      as needed, but never beyond the maximum PDU size that we accept
+**      on this Association. Larger PDUs are refused by readPDUBody().
+**
+** Parameter Dictionary:
+**
+**      association     Handle to the Association
+**
+** Return Values:
+**
+**
+** Notes:
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+
+static OFCondition
+allocateFragmentBuffer(PRIVATE_ASSOCIATIONKEY ** association)
+{
+    PRIVATE_ASSOCIATIONKEY *key = *association;
+    const unsigned long maxLength = key->maxPDVInput + 100;
+    /* if the PDU length is not yet known, use the maximum */
+    unsigned long length = (key->inputPDU == NO_PDU) ? maxLength : key->nextPDULength;
+    if ((length <= key->fragmentBufferLength) || (length > maxLength))
+        return EC_Normal;
+
+    /* avoid frequent re-allocations if the peer's PDUs grow */
+    if (length / 2 < key->fragmentBufferLength)
+        length = (key->fragmentBufferLength > maxLength / 2) ? maxLength : 2 * key->fragmentBufferLength;
+    free(key->fragmentBuffer);
+    key->fragmentBuffer = (unsigned char *) malloc(size_t(length));
+    if (key->fragmentBuffer == NULL)
+    {
+        key->fragmentBufferLength = 0;
+        return EC_MemoryExhausted;
+    }
+    key->fragmentBufferLength = length;
+    return EC_Normal;
+}
+
+/* readPDVDirect
+**
+** Purpose:
+**      Read the body of the incoming P DATA PDU. If it consists of a single
+**      PDV whose data fragment fits into the buffer provided by the caller
+**      of DUL_ReadPDVDirect, read the fragment directly into that buffer
+**      and make it the association's current PDV. Otherwise, read the PDU
+**      body into the fragment buffer.
+**
+** Parameter Dictionary:
+**      association     Handle to the Association
+**      pduType         PDU Type of the incoming PDU (returned to caller)
+**      pduReserved     Reserved field in the PDU (returned to caller)
+**      pduLength       Length of the PDU body (returned to caller)
+**      done            OFTrue if the PDV was read into the caller's buffer,
+**                      OFFalse if the PDU body was read into the fragment
+**                      buffer (returned to caller)
+**
+** Return Values:
+**
+**
+** Notes:
+**
+** Algorithm:
+**      Description of the algorithm (optional) and any other notes.
+*/
+
+static OFCondition
+readPDVDirect(PRIVATE_ASSOCIATIONKEY ** association,
+              unsigned char *pduType, unsigned char *pduReserved,
+              unsigned long *pduLength, OFBool& done)
+{
+    PRIVATE_ASSOCIATIONKEY *key = *association;
+    OFCondition cond = EC_Normal;
+    unsigned char pdvHead[6];
+    unsigned long pdvLength = 0;
+    unsigned long length;
+    done = OFFalse;
+
+    /* read the PDU header first, if not yet done */
+    if (key->inputPDU == NO_PDU)
+    {
+        cond = readPDUHead(association, key->pduHead, sizeof(key->pduHead),
+                           DUL_BLOCK, 0, &key->nextPDUType,
+                           &key->nextPDUReserved, &key->nextPDULength);
+        if (cond.bad())
+            return cond;
+    }
+    *pduType = key->nextPDUType;
+    *pduReserved = key->nextPDUReserved;
+    *pduLength = key->nextPDULength;
+
+    /* read the header of the first PDV */
+    if (*pduLength >= sizeof(pdvHead))
+    {
+        cond = defragmentTCP(key->connection, DUL_BLOCK, key->timerStart, key->timeout,
+                             pdvHead, sizeof(pdvHead), &length);
+        if (cond.bad())
+        {
+            key->inputPDU = NO_PDU;
+            return cond;
+        }
+        EXTRACT_LONG_BIG(pdvHead, pdvLength);
+
+        /* a single PDV that fits into the caller's buffer */
+        if ((pdvLength >= 2) && (pdvLength == *pduLength - 4) && (pdvLength - 2 <= key->directBufferLength))
+        {
+            cond = defragmentTCP(key->connection, DUL_BLOCK, key->timerStart, key->timeout,
+                                 key->directBuffer, pdvLength - 2, &length);
+            key->inputPDU = NO_PDU;
+            if (cond.bad())
+                return cond;
+
+            key->currentPDV.fragmentLength = pdvLength - 2;
+            key->currentPDV.presentationContextID = pdvHead[4];
+            key->currentPDV.lastPDV = (pdvHead[5] & 2) ? OFTrue : OFFalse;
+            key->currentPDV.pdvType = (pdvHead[5] & 1) ? DUL_COMMANDPDV : DUL_DATASETPDV;
+            key->currentPDV.data = key->directBuffer;
+            key->pdvPointer = NULL;
+            key->pdvCount = 1;
+            key->pdvIndex = 0;
+            done = OFTrue;
+            return EC_Normal;
+        }
+    }
+
+    /* otherwise, read the complete PDU body into the fragment buffer */
+    cond = allocateFragmentBuffer(association);
+    if (cond.good() && (*pduLength > key->fragmentBufferLength))
+        cond = DUL_ILLEGALPDULENGTH;
+    if (cond.good())
+    {
+        unsigned long offset = 0;
+        if (*pduLength >= sizeof(pdvHead))
+        {
+            memcpy(key->fragmentBuffer, pdvHead, sizeof(pdvHead));
+            offset = sizeof(pdvHead);
+        }
+        cond = defragmentTCP(key->connection, DUL_BLOCK, key->timerStart, key->timeout,
+                             key->fragmentBuffer + offset, *pduLength - offset, &length);
+    }
+    key->inputPDU = NO_PDU;
+    return cond;
+}
+
 /* PRV_NextPDUType
 **
 ** Purpose:
@@ -3812,13 +4024,16 @@ dump_pdu(const char *type, void *buffer, unsigned long length)
 /* setTCPBufferLength
 **
 ** Purpose:
-**      This routine checks for the existence of an environment
+**      This routine sets the socket SNDBUF and RCVBUF variables to the
+**      values set for the network with DUL_setTCPBufferLength(). If no
+**      values are set, it checks for the existence of an environment
 **      variable (TCP_BUFFER_LENGTH).  If that variable is defined (and
 **      is a legal integer), this routine sets the socket SNDBUF and RCVBUF
 **      variables to the value defined in TCP_BUFFER_LENGTH.
 **
 ** Parameter Dictionary:
 **      sock            Socket descriptor (identifier)
+**      network         Handle to the network environment (may be NULL)
 **
 ** Return Values:
 **      None
@@ -3830,14 +4045,34 @@ dump_pdu(const char *type, void *buffer, unsigned long length)
 */
 
 #ifdef _WIN32
-static void setTCPBufferLength(SOCKET sock)
+static void setTCPBufferLength(SOCKET sock, PRIVATE_NETWORKKEY *network)
 #else
-static void setTCPBufferLength(int sock)
+static void setTCPBufferLength(int sock, PRIVATE_NETWORKKEY *network)
 #endif
 {
     char *TCPBufferLength;
     int bufLen;
 
+#if defined(SO_SNDBUF) && defined(SO_RCVBUF)
+    /* explicit settings for the network take precedence over the environment variable */
+    if (network && (network->tcpSendBufferLength > 0 || network->tcpReceiveBufferLength > 0))
+    {
+        if (network->tcpSendBufferLength > 0)
+        {
+            bufLen = OFstatic_cast(int, network->tcpSendBufferLength);
+            DCMNET_DEBUG("DULFSM: setting TCP send buffer length to " << bufLen << " bytes");
+            (void) setsockopt(sock, SOL_SOCKET, SO_SNDBUF, (char *) &bufLen, sizeof(bufLen));
+        }
+        if (network->tcpReceiveBufferLength > 0)
+        {
+            bufLen = OFstatic_cast(int, network->tcpReceiveBufferLength);
+            DCMNET_DEBUG("DULFSM: setting TCP receive buffer length to " << bufLen << " bytes");
+            (void) setsockopt(sock, SOL_SOCKET, SO_RCVBUF, (char *) &bufLen, sizeof(bufLen));
+        }
+        return;
+    }
+#endif
+
     /*
      * check whether environment variable TCP_BUFFER_LENGTH is set.
      * If not, the the operating system is responsible for selecting
@@ -128,6 +128,15 @@ OFCondition DcmSCP::openListenPort()
       m_cfg->setPort(OFstatic_cast(Uint16, m_network->acceptorPort));
     }
 
+    cond = ASC_setTCPBufferLength(m_network, m_cfg->getTCPSendBufferLength(), m_cfg->getTCPReceiveBufferLength());
+    if (cond.good())
+      cond = ASC_setTCPNoDelay(m_network, m_cfg->getTCPNoDelay());
+    if (cond.bad())
+    {
+        DCMNET_ERROR("DcmSCP: Error setting TCP socket options: " << cond.text());
+        return cond;
+    }
+
     if (m_cfg->transportLayerEnabled())
     {
       cond = ASC_setTransportLayer(m_network, m_cfg->getTransportLayer(), OFFalse /* Do not take over ownership */);
@@ -432,8 +441,23 @@ OFCondition DcmSCP::waitForAssociationRQ(T_ASC_Network* network)
 }
 
 OFCondition DcmSCP::processAssociationRQ()
+{
+    OFBool acknowledged = OFFalse;
+    OFCondition cond = acknowledgeOrRefuseAssociationRQ(acknowledged);
+
+    // Go ahead and handle the association (i.e. handle the caller's requests) in this process
+    if (cond.good() && acknowledged)
+        handleAssociation();
+
+    return cond;
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmSCP::acknowledgeOrRefuseAssociationRQ(OFBool& acknowledged)
 {
     DcmSCPActionType desiredAction = DCMSCP_ACTION_UNDEFINED;
+    acknowledged = OFFalse;
     if ((m_assoc == NULL) || (m_assoc->params == NULL))
         return ASC_NULLKEY;
 
@@ -523,6 +547,19 @@ OFCondition DcmSCP::processAssociationRQ()
         return EC_Normal;
     }
 
+    // Respond to the asynchronous operations window proposed by the SCU (if any).
+    // We never invoke operations on the SCU ourselves.
+    unsigned short maxOpsInvoked = 1;
+    unsigned short maxOpsPerformed = 1;
+    const Uint16 ourMaxOpsInvoked = m_cfg->getAsyncOperationsWindow();
+    ASC_getAsyncOperationsWindow(m_assoc->params, maxOpsInvoked, maxOpsPerformed);
+    if ((maxOpsInvoked != 1) && (ourMaxOpsInvoked != 1))
+    {
+        if ((maxOpsInvoked == 0) || ((ourMaxOpsInvoked != 0) && (ourMaxOpsInvoked < maxOpsInvoked)))
+            maxOpsInvoked = ourMaxOpsInvoked;
+        ASC_setAsyncOperationsWindow(m_assoc->params, maxOpsInvoked, 1);
+    }
+
     // If the negotiation was successful, accept the association request
     cond = ASC_acknowledgeAssociation(m_assoc);
     if (cond.bad())
@@ -539,9 +576,7 @@ OFCondition DcmSCP::processAssociationRQ()
     else
         DCMNET_DEBUG(ASC_dumpParameters(tempStr, m_assoc->params, ASC_ASSOC_AC));
 
-    // Go ahead and handle the association (i.e. handle the caller's requests) in this process
-    handleAssociation();
-
+    acknowledged = OFTrue;
     return EC_Normal;
 }
 
@@ -597,31 +632,53 @@ void DcmSCP::handleAssociation()
         return;
     }
 
-    // Receive a DIMSE command and perform all the necessary actions. (Note that ReceiveAndHandleCommands()
-    // will always return a value 'cond' for which 'cond.bad()' will be true. This value indicates that either
-    // some kind of error occurred, or that the peer aborted the association (DUL_PEERABORTEDASSOCIATION),
-    // or that the peer requested the release of the association (DUL_PEERREQUESTEDRELEASE).) (Also note
-    // that ReceiveAndHandleCommands() will never return EC_Normal.)
+    // Receive a DIMSE command and perform all the necessary actions. (Note that receiveAndHandleCommand()
+    // will sooner or later return a value 'cond' for which 'cond.bad()' will be true. This value indicates
+    // that either some kind of error occurred, or that the peer aborted the association
+    // (DUL_PEERABORTEDASSOCIATION), or that the peer requested the release of the association
+    // (DUL_PEERREQUESTEDRELEASE).)
     OFCondition cond = EC_Normal;
-    T_DIMSE_Message message;
-    T_ASC_PresentationContextID presID;
 
     // start a loop to be able to receive more than one DIMSE command
     while (cond.good())
     {
-        // receive a DIMSE command over the network
-        cond = DIMSE_receiveCommand(
-            m_assoc, m_cfg->getDIMSEBlockingMode(), m_cfg->getDIMSETimeout(), &presID, &message, NULL);
-
-        // check if peer did release or abort, or if we have a valid message
-        if (cond.good())
-        {
-            DcmPresentationContextInfo presInfo;
-            getPresentationContextInfo(m_assoc, presID, presInfo);
-            cond = handleIncomingCommand(&message, presInfo);
-        }
+        cond = receiveAndHandleCommand();
     }
     // Clean up on association termination.
+    handleAssociationTermination(cond);
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmSCP::receiveAndHandleCommand()
+{
+    if (m_assoc == NULL)
+        return DIMSE_ILLEGALASSOCIATION;
+
+    T_DIMSE_Message message;
+    T_ASC_PresentationContextID presID;
+
+    // receive a DIMSE command over the network
+    OFCondition cond = DIMSE_receiveCommand(
+        m_assoc, m_cfg->getDIMSEBlockingMode(), m_cfg->getDIMSETimeout(), &presID, &message, NULL);
+
+    // check if peer did release or abort, or if we have a valid message
+    if (cond.good())
+    {
+        DcmPresentationContextInfo presInfo;
+        getPresentationContextInfo(m_assoc, presID, presInfo);
+        cond = handleIncomingCommand(&message, presInfo);
+    }
+    return cond;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmSCP::handleAssociationTermination(const OFCondition& cond)
+{
+    if (m_assoc == NULL)
+        return;
+
     if (cond == DUL_PEERREQUESTEDRELEASE)
     {
         notifyReleaseRequest();
@@ -837,6 +894,82 @@ OFCondition DcmSCP::receiveSTORERequest(T_DIMSE_C_StoreRQ& reqMessage,
     return cond;
 }
 
+OFCondition DcmSCP::receiveSTORERequest(T_DIMSE_C_StoreRQ& reqMessage,
+                                        const T_ASC_PresentationContextID presID,
+                                        DcmOutputStream& outputStream)
+{
+    // Do some basic validity checks
+    if (m_assoc == NULL)
+        return DIMSE_ILLEGALASSOCIATION;
+
+    OFCondition cond;
+    OFString tempStr;
+    // Use presentation context ID of the command set as a default
+    T_ASC_PresentationContextID presIDdset = presID;
+
+    // Dump debug information
+    if (DCM_dcmnetLogger.isEnabledFor(OFLogger::DEBUG_LOG_LEVEL))
+        DCMNET_INFO("Received C-STORE Request");
+    else
+        DCMNET_INFO("Received C-STORE Request (MsgID " << reqMessage.MessageID << ")");
+
+    // Check if dataset is announced correctly
+    if (reqMessage.DataSetType == DIMSE_DATASET_NULL)
+    {
+        DCMNET_DEBUG(DIMSE_dumpMessage(tempStr, reqMessage, DIMSE_INCOMING, NULL, presID));
+        DCMNET_ERROR("Received C-STORE request but no dataset announced, aborting");
+        return DIMSE_BADMESSAGE;
+    }
+
+    // Receive dataset (directly to the output stream)
+    cond = receiveSTORERequestDataset(&presIDdset, outputStream);
+    if (cond.bad())
+    {
+        DCMNET_DEBUG(DIMSE_dumpMessage(tempStr, reqMessage, DIMSE_INCOMING, NULL, presID));
+        DCMNET_ERROR("Unable to receive C-STORE dataset on presentation context "
+                     << OFstatic_cast(unsigned int, presID) << ": " << DimseCondition::dump(tempStr, cond));
+        return cond;
+    }
+
+    // Output request message only if trace level is enabled
+    DCMNET_DEBUG(DIMSE_dumpMessage(tempStr, reqMessage, DIMSE_INCOMING, NULL, presID));
+
+    // Compare presentation context ID of command and data set
+    if (presIDdset != presID)
+    {
+        DCMNET_ERROR("Presentation Context ID of command (" << OFstatic_cast(unsigned int, presID) << ") and data set ("
+                                                            << OFstatic_cast(unsigned int, presIDdset) << ") differs");
+        return makeDcmnetCondition(DIMSEC_INVALIDPRESENTATIONCONTEXTID,
+                                   OF_error,
+                                   "DIMSE: Presentation Contexts of Command and Data Set differ");
+    }
+
+    return cond;
+}
+
+OFCondition DcmSCP::createSTORERequestFile(const T_DIMSE_C_StoreRQ& reqMessage,
+                                           const T_ASC_PresentationContextID presID,
+                                           const OFString& filename,
+                                           DcmOutputFileStream*& filestream)
+{
+    filestream = NULL;
+    if (m_assoc == NULL)
+        return DIMSE_ILLEGALASSOCIATION;
+    if (filename.empty())
+        return EC_InvalidFilename;
+
+    OFCondition cond
+        = DIMSE_createFilestream(filename, &reqMessage, m_assoc, presID, OFTrue /*writeMetaheader*/, &filestream);
+    if (cond.bad() && (filestream != NULL))
+    {
+        // The meta header could not be written, so get rid of the incomplete file
+        delete filestream;
+        filestream = NULL;
+        OFStandard::deleteFile(filename);
+    }
+    return cond;
+}
+
 OFCondition DcmSCP::sendSTOREResponse(const T_ASC_PresentationContextID presID,
                                       const T_DIMSE_C_StoreRQ& reqMessage,
                                       const Uint16 rspStatusCode)
@@ -1750,26 +1883,7 @@ OFCondition DcmSCP::receiveSTORERequestDataset(T_ASC_PresentationContextID* pres
         = DIMSE_createFilestream(filename, &reqMessage, m_assoc, *presID, OFTrue /*writeMetaheader*/, &filestream);
     if (cond.good())
     {
-        if (m_cfg->getProgressNotificationMode())
-        {
-            cond = DIMSE_receiveDataSetInFile(m_assoc,
-                                              m_cfg->getDIMSEBlockingMode(),
-                                              m_cfg->getDIMSETimeout(),
-                                              presID,
-                                              filestream,
-                                              callbackRECEIVEProgress,
-                                              this /*callbackData*/);
-        }
-        else
-        {
-            cond = DIMSE_receiveDataSetInFile(m_assoc,
-                                              m_cfg->getDIMSEBlockingMode(),
-                                              m_cfg->getDIMSETimeout(),
-                                              presID,
-                                              filestream,
-                                              NULL /*callback*/,
-                                              NULL /*callbackData*/);
-        }
+        cond = receiveSTORERequestDataset(presID, *filestream);
         if (cond.good()) cond = filestream->fclose();
         delete filestream;
         if (cond.good())
@@ -1807,6 +1921,35 @@ OFCondition DcmSCP::receiveSTORERequestDataset(T_ASC_PresentationContextID* pres
 
 // ----------------------------------------------------------------------------
 
+// Receives one C-STORE request dataset via network from another DICOM application
+// (and passes it to the given output stream)
+OFCondition DcmSCP::receiveSTORERequestDataset(T_ASC_PresentationContextID* presID,
+                                               DcmOutputStream& outputStream)
+{
+    if (m_assoc == NULL)
+        return DIMSE_ILLEGALASSOCIATION;
+
+    if (m_cfg->getProgressNotificationMode())
+    {
+        return DIMSE_receiveDataSetInFile(m_assoc,
+                                          m_cfg->getDIMSEBlockingMode(),
+                                          m_cfg->getDIMSETimeout(),
+                                          presID,
+                                          &outputStream,
+                                          callbackRECEIVEProgress,
+                                          this /*callbackData*/);
+    }
+    return DIMSE_receiveDataSetInFile(m_assoc,
+                                      m_cfg->getDIMSEBlockingMode(),
+                                      m_cfg->getDIMSETimeout(),
+                                      presID,
+                                      &outputStream,
+                                      NULL /*callback*/,
+                                      NULL /*callbackData*/);
+}
+
+// ----------------------------------------------------------------------------
+
 OFBool DcmSCP::addStatusDetail(DcmDataset** statusDetail, const DcmElement* elem)
 {
     DCMNET_TRACE("Add element to status detail");
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2012-2025, OFFIS e.V.
+ *  Copyright (C) 2012-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -33,6 +33,10 @@ DcmSCPConfig::DcmSCPConfig() :
   m_aetitle("DCMTK_SCP"),
   m_refuseAssociation(OFFalse),
   m_maxReceivePDULength(ASC_DEFAULTMAXPDU),
+  m_tcpSendBufferLength(0),
+  m_tcpReceiveBufferLength(0),
+  m_tcpNoDelay(-1),
+  m_asyncOperationsWindow(1),
   m_connectionBlockingMode(DUL_BLOCK),
   m_dimseBlockingMode(DIMSE_BLOCKING),
   m_dimseTimeout(0),
@@ -62,6 +66,10 @@ DcmSCPConfig::DcmSCPConfig(const DcmSCPConfig &old) :
   m_aetitle(old.m_aetitle),
   m_refuseAssociation(old.m_refuseAssociation),
   m_maxReceivePDULength(old.m_maxReceivePDULength),
+  m_tcpSendBufferLength(old.m_tcpSendBufferLength),
+  m_tcpReceiveBufferLength(old.m_tcpReceiveBufferLength),
+  m_tcpNoDelay(old.m_tcpNoDelay),
+  m_asyncOperationsWindow(old.m_asyncOperationsWindow),
   m_connectionBlockingMode(old.m_connectionBlockingMode),
   m_dimseBlockingMode(old.m_dimseBlockingMode),
   m_dimseTimeout(old.m_dimseTimeout),
@@ -89,6 +97,10 @@ DcmSCPConfig& DcmSCPConfig::operator=(const DcmSCPConfig &obj)
     m_aetitle = obj.m_aetitle;
     m_refuseAssociation = obj.m_refuseAssociation;
     m_maxReceivePDULength = obj.m_maxReceivePDULength;
+    m_tcpSendBufferLength = obj.m_tcpSendBufferLength;
+    m_tcpReceiveBufferLength = obj.m_tcpReceiveBufferLength;
+    m_tcpNoDelay = obj.m_tcpNoDelay;
+    m_asyncOperationsWindow = obj.m_asyncOperationsWindow;
     m_connectionBlockingMode = obj.m_connectionBlockingMode;
     m_dimseBlockingMode = obj.m_dimseBlockingMode;
     m_dimseTimeout = obj.m_dimseTimeout;
@@ -125,6 +137,29 @@ void DcmSCPConfig::setMaxReceivePDULength(const Uint32 maxRecPDU)
 
 // ----------------------------------------------------------------------------
 
+void DcmSCPConfig::setTCPBufferLength(const Uint32 sendBufferLength,
+                                      const Uint32 receiveBufferLength)
+{
+  m_tcpSendBufferLength = sendBufferLength;
+  m_tcpReceiveBufferLength = receiveBufferLength;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmSCPConfig::setTCPNoDelay(const int noDelay)
+{
+  m_tcpNoDelay = noDelay;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmSCPConfig::setAsyncOperationsWindow(const Uint16 maxOpsInvoked)
+{
+  m_asyncOperationsWindow = maxOpsInvoked;
+}
+
+// ----------------------------------------------------------------------------
+
 void DcmSCPConfig::setPort(const Uint16 port)
 {
   m_port = port;
@@ -225,6 +260,34 @@ Uint32 DcmSCPConfig::getMaxReceivePDULength() const
 
 // ----------------------------------------------------------------------------
 
+Uint32 DcmSCPConfig::getTCPSendBufferLength() const
+{
+  return m_tcpSendBufferLength;
+}
+
+// ----------------------------------------------------------------------------
+
+Uint32 DcmSCPConfig::getTCPReceiveBufferLength() const
+{
+  return m_tcpReceiveBufferLength;
+}
+
+// ----------------------------------------------------------------------------
+
+int DcmSCPConfig::getTCPNoDelay() const
+{
+  return m_tcpNoDelay;
+}
+
+// ----------------------------------------------------------------------------
+
+Uint16 DcmSCPConfig::getAsyncOperationsWindow() const
+{
+  return m_asyncOperationsWindow;
+}
+
+// ----------------------------------------------------------------------------
+
 Uint16 DcmSCPConfig::getPort() const
 {
   return m_port;
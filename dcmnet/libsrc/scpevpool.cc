@@ -0,0 +1,711 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: Event-driven SCP pool that multiplexes many associations over
+ *           a small, fixed number of worker threads.
+ *
+ */
+
+#include "dcmtk/config/osconfig.h" /* make sure OS specific configuration is included first */
+
+#ifdef WITH_THREADS // Without threads pool does not make sense...
+
+#ifdef HAVE_WINDOWS_H
+// on Windows, we need Winsock2 for network functions
+#include <winsock2.h>
+#endif
+
+#include "dcmtk/dcmnet/scpevpool.h"
+#include "dcmtk/dcmnet/dcompat.h"     /* compatibility code for certain Unix dialects such as SunOS */
+#include "dcmtk/dcmnet/diutil.h"
+#include "dcmtk/dcmnet/dul.h"
+
+BEGIN_EXTERN_C
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#include <sys/types.h>
+#ifdef HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+END_EXTERN_C
+
+#ifdef DCMTK_HAVE_POLL
+#include <poll.h>
+#endif
+
+/* platform independent definition of EINTR */
+enum
+{
+#ifdef HAVE_WINSOCK_H
+    DCMNET_EINTR = WSAEINTR
+#else
+    DCMNET_EINTR = EINTR
+#endif
+};
+
+/// maximum time (in milliseconds) the listening thread waits for events
+#define EVPOOL_WAIT_TIMEOUT 1000
+
+/// maximum number of events retrieved from epoll_wait() at a time
+#define EVPOOL_MAX_EVENTS 64
+
+/* In the poll()/select() fallback, sessions that become idle are only watched
+ * from the next call to waitForEvents() on. Therefore, a much shorter timeout
+ * is used in this case.
+ */
+#define EVPOOL_FALLBACK_WAIT_TIMEOUT 20
+
+
+/* *********************************************************************** */
+/*                        DcmEventSCPPoolWorker class                      */
+/* *********************************************************************** */
+
+/** worker thread of class DcmBaseEventSCPPool
+ */
+class DcmEventSCPPoolWorker : public OFThread
+{
+public:
+  DcmEventSCPPoolWorker(DcmBaseEventSCPPool& pool)
+    : OFThread()
+    , m_pool(pool)
+  {
+  }
+
+protected:
+
+  virtual void run()
+  {
+    m_pool.runWorker();
+  }
+
+private:
+
+  /// private undefined copy constructor
+  DcmEventSCPPoolWorker(const DcmEventSCPPoolWorker&);
+
+  /// private undefined copy assignment operator
+  DcmEventSCPPoolWorker& operator=(const DcmEventSCPPoolWorker&);
+
+  /// the pool this worker belongs to
+  DcmBaseEventSCPPool& m_pool;
+};
+
+
+/* *********************************************************************** */
+/*                 DcmBaseEventSCPPool::DcmBaseEventSCPSession class       */
+/* *********************************************************************** */
+
+DcmBaseEventSCPPool::DcmBaseEventSCPSession::DcmBaseEventSCPSession()
+  : m_assoc(NULL),
+    m_socket(DCMNET_INVALID_SOCKET),
+    m_state(SESSION_NEW),
+    m_registered(OFFalse),
+    m_idleSince(0)
+{
+}
+
+// ----------------------------------------------------------------------------
+
+DcmBaseEventSCPPool::DcmBaseEventSCPSession::~DcmBaseEventSCPSession()
+{
+}
+
+
+/* *********************************************************************** */
+/*                        DcmBaseEventSCPPool class                        */
+/* *********************************************************************** */
+
+DcmBaseEventSCPPool::DcmBaseEventSCPPool()
+  : m_criticalSection(),
+    m_queueSemaphore(0),
+    m_sessions(),
+    m_queue(),
+    m_workers(),
+    m_cfg(),
+    m_numWorkers(4),
+    m_maxAssociations(100),
+    m_runMode(SHUTDOWN),
+    m_epollFd(-1)
+{
+}
+
+// ----------------------------------------------------------------------------
+
+DcmBaseEventSCPPool::~DcmBaseEventSCPPool()
+{
+  // listen() does not return before all associations are terminated
+  // and all worker threads have been joined, nothing to do here.
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::setNumberOfWorkerThreads(const Uint16 numWorkers)
+{
+  m_numWorkers = (numWorkers > 0) ? numWorkers : 1;
+}
+
+// ----------------------------------------------------------------------------
+
+Uint16 DcmBaseEventSCPPool::getNumberOfWorkerThreads()
+{
+  return m_numWorkers;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::setMaxAssociations(const Uint16 maxAssociations)
+{
+  m_maxAssociations = maxAssociations;
+}
+
+// ----------------------------------------------------------------------------
+
+Uint16 DcmBaseEventSCPPool::getMaxAssociations()
+{
+  return m_maxAssociations;
+}
+
+// ----------------------------------------------------------------------------
+
+size_t DcmBaseEventSCPPool::numAssociations(const OFBool onlyBusy)
+{
+  size_t result = 0;
+  m_criticalSection.lock();
+  if (!onlyBusy)
+  {
+    result = m_sessions.size();
+  }
+  else
+  {
+    for (OFListIterator(DcmBaseEventSCPSession*) it = m_sessions.begin(); it != m_sessions.end(); ++it)
+    {
+      if ((*it)->m_state != DcmBaseEventSCPSession::SESSION_IDLE) ++result;
+    }
+  }
+  m_criticalSection.unlock();
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+
+DcmSCPConfig& DcmBaseEventSCPPool::getConfig()
+{
+  return m_cfg;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::stopAfterCurrentAssociations()
+{
+  m_criticalSection.lock();
+  if (m_runMode == LISTEN)
+    m_runMode = STOP;
+  m_criticalSection.unlock();
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmBaseEventSCPPool::listen()
+{
+  m_runMode = LISTEN;
+
+  /* Copy the config to a shared config that is shared by all sessions. */
+  DcmSharedSCPConfig sharedConfig(m_cfg);
+
+  /* Initialize network, i.e. create an instance of T_ASC_Network*. */
+  T_ASC_Network *network = NULL;
+  OFCondition cond = initializeNetwork(&network);
+  if (cond.bad())
+  {
+    m_runMode = SHUTDOWN;
+    return cond;
+  }
+  const DcmNativeSocketType listenSocket = DUL_networkSocket(network->network);
+
+#ifdef HAVE_SYS_EPOLL_H
+  /* Register the listening socket with epoll. Sessions are registered
+   * once they have been negotiated.
+   */
+  OFBool listenSocketRegistered = OFFalse;
+  m_epollFd = epoll_create(EVPOOL_MAX_EVENTS);
+  if (m_epollFd >= 0)
+  {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    listenSocketRegistered = (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, listenSocket, &ev) == 0);
+  }
+  if (!listenSocketRegistered)
+  {
+    DCMNET_WARN("DcmBaseEventSCPPool: Cannot use epoll(), falling back to poll(): "
+      << OFStandard::getLastSystemErrorCode().message());
+    if (m_epollFd >= 0) close(m_epollFd);
+    m_epollFd = -1;
+  }
+#endif
+
+  /* Start the worker threads */
+  for (Uint16 i = 0; i < m_numWorkers; ++i)
+  {
+    DcmEventSCPPoolWorker *worker = new DcmEventSCPPoolWorker(*this);
+    if (worker->start() == 0)
+      m_workers.push_back(worker);
+    else
+    {
+      DCMNET_WARN("DcmBaseEventSCPPool: Cannot start worker thread, continuing with " << m_workers.size() << " worker threads");
+      delete worker;
+      break;
+    }
+  }
+  if (m_workers.empty())
+    cond = NET_EC_CannotStartSCPThread;
+  else
+    DCMNET_DEBUG("DcmBaseEventSCPPool: Started " << m_workers.size() << " worker threads");
+
+  /* Wait for events as long as we accept new associations, or there are associations left */
+  while (cond.good() && ((m_runMode == LISTEN) || (numAssociations(OFFalse) > 0)))
+  {
+    const OFBool listening = (m_runMode == LISTEN);
+#ifdef HAVE_SYS_EPOLL_H
+    if (!listening && listenSocketRegistered && (m_epollFd >= 0))
+    {
+      // do not wake up on incoming connections anymore
+      struct epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      epoll_ctl(m_epollFd, EPOLL_CTL_DEL, listenSocket, &ev);
+      listenSocketRegistered = OFFalse;
+    }
+#endif
+    if (waitForEvents(listening ? listenSocket : DCMNET_INVALID_SOCKET) && (m_runMode == LISTEN))
+      acceptAssociation(network, sharedConfig);
+    expireIdleSessions();
+  }
+  DCMNET_DEBUG("DcmBaseEventSCPPool: Leaving listen loop, result: " << cond.text());
+
+  /* Stop the worker threads: an empty queue makes them exit */
+  m_criticalSection.lock();
+  m_runMode = SHUTDOWN;
+  m_criticalSection.unlock();
+  for (size_t i = 0; i < m_workers.size(); ++i)
+    m_queueSemaphore.post();
+  for (size_t i = 0; i < m_workers.size(); ++i)
+  {
+    m_workers[i]->join();
+    delete m_workers[i];
+  }
+  m_workers.clear();
+
+#ifdef HAVE_SYS_EPOLL_H
+  if (m_epollFd >= 0) close(m_epollFd);
+  m_epollFd = -1;
+#endif
+
+  /* In the end, clean up the rest of the memory and drop network */
+  ASC_dropNetwork(&network);
+  return cond;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::acceptAssociation(T_ASC_Network* network,
+                                            const DcmSharedSCPConfig& sharedConfig)
+{
+  T_ASC_Association *assoc = NULL;
+
+  // A connection request is waiting, thus do not wait any longer. Note that
+  // reading the association request may block for up to the ACSE timeout.
+  OFCondition cond = ASC_receiveAssociation(
+      network,
+      &assoc,
+      m_cfg.getMaxReceivePDULength(),
+      NULL,
+      NULL,
+      m_cfg.transportLayerEnabled(),
+      DUL_NOBLOCK,
+      0,
+      m_cfg.getImplementationIdentification());
+
+  if (cond.bad())
+  {
+    if (cond == DUL_NOASSOCIATIONREQUEST)
+    {
+      ASC_destroyAssociation(&assoc);
+    }
+    else
+    {
+      dropAndDestroyAssociation(assoc);
+      DCMNET_ERROR("DcmBaseEventSCPPool: Error receiving association: " << cond.text());
+    }
+    return;
+  }
+
+  DcmBaseEventSCPSession *session = NULL;
+  m_criticalSection.lock();
+  if (m_sessions.size() >= m_maxAssociations)
+  {
+    DCMNET_DEBUG("DcmBaseEventSCPPool: Maximum number of associations reached (" << m_maxAssociations << "), cannot handle incoming association");
+    cond = NET_EC_SCPBusy;
+  }
+  else
+  {
+    session = createSession();
+    if (session == NULL)
+      cond = EC_MemoryExhausted;
+    else
+    {
+      session->m_assoc = assoc;
+      session->m_socket = DUL_associationSocket(assoc->DULassociation);
+      session->setSharedConfig(sharedConfig);
+      m_sessions.push_back(session);
+      // the association is negotiated by a worker thread
+      queueSession(session, DcmBaseEventSCPSession::SESSION_NEW);
+      DCMNET_DEBUG("DcmBaseEventSCPPool: Accepted new connection, now " << m_sessions.size() << " associations total");
+    }
+  }
+  m_criticalSection.unlock();
+
+  if (cond.bad())
+  {
+    if (cond == NET_EC_SCPBusy)
+      rejectAssociation(assoc, ASC_REASON_SP_PRES_LOCALLIMITEXCEEDED);
+    else
+      rejectAssociation(assoc, ASC_REASON_SP_PRES_TEMPORARYCONGESTION);
+    dropAndDestroyAssociation(assoc);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+OFBool DcmBaseEventSCPPool::waitForEvents(DcmNativeSocketType listenSocket)
+{
+  OFBool connectionWaiting = OFFalse;
+
+#ifdef HAVE_SYS_EPOLL_H
+  if (m_epollFd >= 0)
+  {
+    struct epoll_event events[EVPOOL_MAX_EVENTS];
+    const int nfound = epoll_wait(m_epollFd, events, EVPOOL_MAX_EVENTS, EVPOOL_WAIT_TIMEOUT);
+    if (nfound < 0)
+    {
+      if (OFStandard::getLastNetworkErrorCode().value() != DCMNET_EINTR)
+        DCMNET_ERROR("DcmBaseEventSCPPool: epoll_wait() returned with error: " << OFStandard::getLastNetworkErrorCode().message());
+      return OFFalse;
+    }
+    m_criticalSection.lock();
+    for (int i = 0; i < nfound; ++i)
+    {
+      DcmBaseEventSCPSession *session = OFstatic_cast(DcmBaseEventSCPSession *, events[i].data.ptr);
+      if (session == NULL)
+        connectionWaiting = OFTrue;
+      // sessions are registered with EPOLLONESHOT, i.e. they are disabled now
+      else if (session->m_state == DcmBaseEventSCPSession::SESSION_IDLE)
+        queueSession(session, DcmBaseEventSCPSession::SESSION_READY);
+    }
+    m_criticalSection.unlock();
+    return connectionWaiting && (listenSocket != DCMNET_INVALID_SOCKET);
+  }
+#endif
+
+  // Fallback: collect the sockets of all idle sessions
+  OFVector<DcmBaseEventSCPSession*> idleSessions;
+  m_criticalSection.lock();
+  for (OFListIterator(DcmBaseEventSCPSession*) it = m_sessions.begin(); it != m_sessions.end(); ++it)
+  {
+    if ((*it)->m_state == DcmBaseEventSCPSession::SESSION_IDLE) idleSessions.push_back(*it);
+  }
+  m_criticalSection.unlock();
+
+  // Idle sessions are only modified by this thread, i.e. the sockets remain valid
+#ifdef DCMTK_HAVE_POLL
+  OFVector<struct pollfd> pfd;
+  pfd.reserve(idleSessions.size() + 1);
+  struct pollfd pfd1 = {0, POLLIN, 0};
+  for (size_t i = 0; i < idleSessions.size(); ++i)
+  {
+    pfd1.fd = idleSessions[i]->m_socket;
+    pfd.push_back(pfd1);
+  }
+  if (listenSocket != DCMNET_INVALID_SOCKET)
+  {
+    pfd1.fd = listenSocket;
+    pfd.push_back(pfd1);
+  }
+  const int nfound = pfd.empty() ? 0 : poll(&pfd[0], pfd.size(), EVPOOL_FALLBACK_WAIT_TIMEOUT);
+  if (pfd.empty()) OFStandard::milliSleep(EVPOOL_FALLBACK_WAIT_TIMEOUT);
+#else /* DCMTK_HAVE_POLL */
+  fd_set fdset;
+  FD_ZERO(&fdset);
+  DcmNativeSocketType maxsocketfd = 0;
+  for (size_t i = 0; i <= idleSessions.size(); ++i)
+  {
+    DcmNativeSocketType socketfd = (i < idleSessions.size()) ? idleSessions[i]->m_socket : listenSocket;
+    if (socketfd == DCMNET_INVALID_SOCKET) continue;
+#ifdef __MINGW32__
+    /* on MinGW, FD_SET expects an unsigned first argument */
+    FD_SET((unsigned int)socketfd, &fdset);
+#else /* __MINGW32__ */
+    FD_SET(socketfd, &fdset);
+#endif /* __MINGW32__ */
+    if (socketfd > maxsocketfd) maxsocketfd = socketfd;
+  }
+  struct timeval t;
+  t.tv_sec = 0;
+  t.tv_usec = EVPOOL_FALLBACK_WAIT_TIMEOUT * 1000;
+  // This is safe because on Win32 the first parameter of select() is ignored anyway
+  const int nfound = select(OFstatic_cast(int, maxsocketfd + 1), &fdset, NULL, NULL, &t);
+#endif /* DCMTK_HAVE_POLL */
+
+  if (nfound <= 0)
+  {
+    if ((nfound < 0) && (OFStandard::getLastNetworkErrorCode().value() != DCMNET_EINTR))
+      DCMNET_ERROR("DcmBaseEventSCPPool: socket select returned with error: " << OFStandard::getLastNetworkErrorCode().message());
+    return OFFalse;
+  }
+
+  m_criticalSection.lock();
+  for (size_t i = 0; i < idleSessions.size(); ++i)
+  {
+#ifdef DCMTK_HAVE_POLL
+    const OFBool readable = (pfd[i].revents != 0);
+#else
+    const OFBool readable = (FD_ISSET(idleSessions[i]->m_socket, &fdset) != 0);
+#endif
+    if (readable && (idleSessions[i]->m_state == DcmBaseEventSCPSession::SESSION_IDLE))
+      queueSession(idleSessions[i], DcmBaseEventSCPSession::SESSION_READY);
+  }
+  m_criticalSection.unlock();
+
+  if (listenSocket != DCMNET_INVALID_SOCKET)
+  {
+#ifdef DCMTK_HAVE_POLL
+    connectionWaiting = (pfd.back().revents & POLLIN) != 0;
+#else
+    connectionWaiting = (FD_ISSET(listenSocket, &fdset) != 0);
+#endif
+  }
+  return connectionWaiting;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::expireIdleSessions()
+{
+  if (m_cfg.getDIMSEBlockingMode() != DIMSE_NONBLOCKING)
+    return;
+
+  const time_t now = time(NULL);
+  const time_t timeout = OFstatic_cast(time_t, m_cfg.getDIMSETimeout());
+  m_criticalSection.lock();
+  for (OFListIterator(DcmBaseEventSCPSession*) it = m_sessions.begin(); it != m_sessions.end(); ++it)
+  {
+    DcmBaseEventSCPSession *session = *it;
+    if ((session->m_state == DcmBaseEventSCPSession::SESSION_IDLE) && (now - session->m_idleSince > timeout))
+    {
+      DCMNET_DEBUG("DcmBaseEventSCPPool: DIMSE timeout on idle association, terminating association");
+#ifdef HAVE_SYS_EPOLL_H
+      if ((m_epollFd >= 0) && session->m_registered)
+      {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, session->m_socket, &ev);
+        session->m_registered = OFFalse;
+      }
+#endif
+      queueSession(session, DcmBaseEventSCPSession::SESSION_EXPIRED);
+    }
+  }
+  m_criticalSection.unlock();
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::queueSession(DcmBaseEventSCPSession* session,
+                                       const DcmBaseEventSCPSession::sessionstate state)
+{
+  session->m_state = state;
+  m_queue.push_back(session);
+  m_queueSemaphore.post();
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::watchSession(DcmBaseEventSCPSession* session)
+{
+  session->m_state = DcmBaseEventSCPSession::SESSION_IDLE;
+  session->m_idleSince = time(NULL);
+#ifdef HAVE_SYS_EPOLL_H
+  if (m_epollFd >= 0)
+  {
+    // wake up only once, the session is re-armed after the message has been handled
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = session;
+    if (epoll_ctl(m_epollFd, session->m_registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, session->m_socket, &ev) == 0)
+      session->m_registered = OFTrue;
+    else
+    {
+      // cannot watch the socket, thus handle the next message right away (which may block)
+      DCMNET_WARN("DcmBaseEventSCPPool: epoll_ctl() failed: " << OFStandard::getLastSystemErrorCode().message());
+      queueSession(session, DcmBaseEventSCPSession::SESSION_READY);
+    }
+  }
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::runWorker()
+{
+  while (m_queueSemaphore.wait() == 0)
+  {
+    m_criticalSection.lock();
+    if (m_queue.empty())
+    {
+      // an empty queue signals the end of listen()
+      m_criticalSection.unlock();
+      break;
+    }
+    DcmBaseEventSCPSession *session = m_queue.front();
+    m_queue.pop_front();
+    const DcmBaseEventSCPSession::sessionstate state = session->m_state;
+    session->m_state = DcmBaseEventSCPSession::SESSION_RUNNING;
+    m_criticalSection.unlock();
+
+    processSession(session, state);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::processSession(DcmBaseEventSCPSession* session,
+                                         const DcmBaseEventSCPSession::sessionstate state)
+{
+  OFBool active = OFFalse;
+  OFCondition cond;
+  switch (state)
+  {
+    case DcmBaseEventSCPSession::SESSION_NEW:
+      cond = session->startAssociation(session->m_assoc, active);
+      if (cond.bad())
+      {
+        DCMNET_DEBUG("DcmBaseEventSCPPool: Error processing association request: " << cond.text());
+        active = OFFalse;
+      }
+      break;
+    case DcmBaseEventSCPSession::SESSION_READY:
+      cond = session->handleNextCommand();
+      active = cond.good();
+      break;
+    default:
+      session->terminateAssociation(DIMSE_NODATAAVAILABLE);
+      break;
+  }
+
+  // The next message may already have been received in part, in which
+  // case the socket might not become readable anymore.
+  const OFBool dataWaiting = active && ASC_dataWaiting(session->m_assoc, 0);
+
+  m_criticalSection.lock();
+  if (dataWaiting)
+    queueSession(session, DcmBaseEventSCPSession::SESSION_READY);
+  else if (active)
+    watchSession(session);
+  else
+  {
+#ifdef HAVE_SYS_EPOLL_H
+    if ((m_epollFd >= 0) && session->m_registered)
+    {
+      struct epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      epoll_ctl(m_epollFd, EPOLL_CTL_DEL, session->m_socket, &ev);
+      session->m_registered = OFFalse;
+    }
+#endif
+    m_sessions.remove(session);
+    DCMNET_DEBUG("DcmBaseEventSCPPool: Association terminated, now " << m_sessions.size() << " associations total");
+  }
+  m_criticalSection.unlock();
+
+  if (!active)
+  {
+    session->closeAssociation();
+    delete session;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::rejectAssociation(T_ASC_Association *assoc,
+                                            const T_ASC_RejectParametersReason& reason)
+{
+  T_ASC_RejectParameters rej;
+  rej.result = ASC_RESULT_REJECTEDTRANSIENT;
+  rej.source = ASC_SOURCE_SERVICEPROVIDER_PRESENTATION_RELATED;
+  rej.reason = reason;
+  ASC_rejectAssociation( assoc, &rej );
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmBaseEventSCPPool::dropAndDestroyAssociation(T_ASC_Association *assoc)
+{
+  if (assoc)
+  {
+    ASC_dropAssociation( assoc );
+    ASC_destroyAssociation( &assoc );
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmBaseEventSCPPool::initializeNetwork(T_ASC_Network** network)
+{
+    OFCondition cond = ASC_initializeNetwork(NET_ACCEPTOR, OFstatic_cast(int, m_cfg.getPort()), m_cfg.getACSETimeout(), network);
+    if (cond.good())
+    {
+      cond = ASC_setTCPBufferLength(*network, m_cfg.getTCPSendBufferLength(), m_cfg.getTCPReceiveBufferLength());
+      if (cond.good())
+        cond = ASC_setTCPNoDelay(*network, m_cfg.getTCPNoDelay());
+      if (cond.bad())
+      {
+        DCMNET_ERROR("DcmBaseEventSCPPool: Error setting TCP socket options: " << cond.text());
+        ASC_dropNetwork(network);
+      }
+      else if (m_cfg.transportLayerEnabled())
+      {
+        cond = ASC_setTransportLayer(*network, m_cfg.getTransportLayer(), 0 /* Do not take over ownership */);
+        if (cond.bad())
+        {
+          DCMNET_ERROR("DcmBaseEventSCPPool: Error setting secured transport layer: " << cond.text());
+          ASC_dropNetwork(network);
+        }
+      }
+    }
+    return cond;
+}
+
+
+#endif // WITH_THREADS
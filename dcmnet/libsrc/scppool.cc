@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2012-2025, OFFIS e.V.
+ *  Copyright (C) 2012-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -335,7 +335,15 @@ OFCondition DcmBaseSCPPool::initializeNetwork(T_ASC_Network** network)
     OFCondition cond = ASC_initializeNetwork(NET_ACCEPTOR, OFstatic_cast(int, m_cfg.getPort()), m_cfg.getACSETimeout(), network);
     if (cond.good())
     {
-      if (m_cfg.transportLayerEnabled())
+      cond = ASC_setTCPBufferLength(*network, m_cfg.getTCPSendBufferLength(), m_cfg.getTCPReceiveBufferLength());
+      if (cond.good())
+        cond = ASC_setTCPNoDelay(*network, m_cfg.getTCPNoDelay());
+      if (cond.bad())
+      {
+        DCMNET_ERROR("DcmBaseSCPPool: Error setting TCP socket options: " << cond.text());
+        ASC_dropNetwork(network);
+      }
+      else if (m_cfg.transportLayerEnabled())
       {
         cond = ASC_setTransportLayer(*network, m_cfg.getTransportLayer(), 0 /* Do not take over ownership */);
         if (cond.bad())
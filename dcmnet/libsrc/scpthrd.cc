@@ -81,3 +81,46 @@ OFCondition DcmThreadSCP::run(T_ASC_Association* incomingAssoc)
   return result;
 
 }
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmThreadSCP::startAssociation(T_ASC_Association* incomingAssoc,
+                                           OFBool& acknowledged)
+{
+  acknowledged = OFFalse;
+  if (incomingAssoc == NULL)
+  {
+    DCMNET_ERROR("Illegal Association handed to DcmSCP's startAssociation(assoc) method");
+    return DIMSE_ILLEGALASSOCIATION;
+  }
+  if (isConnected())
+    return DIMSE_ILLEGALASSOCIATION;
+
+  m_assoc = incomingAssoc;
+
+  OFCondition result = acknowledgeOrRefuseAssociationRQ(acknowledged);
+  if (result.bad() || !acknowledged)
+  {
+    acknowledged = OFFalse;
+    notifyAssociationTermination();
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+
+OFCondition DcmThreadSCP::handleNextCommand()
+{
+  OFCondition result = receiveAndHandleCommand();
+  if (result.bad())
+    terminateAssociation(result);
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+
+void DcmThreadSCP::terminateAssociation(const OFCondition& cond)
+{
+  handleAssociationTermination(cond);
+  notifyAssociationTermination();
+}
@@ -54,6 +54,9 @@ DcmSCU::DcmSCU()
     , m_assocConfigFile()
     , m_openDIMSERequest(NULL)
     , m_maxReceivePDULength(ASC_DEFAULTMAXPDU)
+    , m_tcpSendBufferLength(0)
+    , m_tcpReceiveBufferLength(0)
+    , m_tcpNoDelay(-1)
     , m_blockMode(DIMSE_BLOCKING)
     , m_ourAETitle("ANY-SCU")
     , m_peer()
@@ -70,6 +73,7 @@ DcmSCU::DcmSCU()
     , m_maxNestingDepth(0)
     , m_secureConnectionEnabled(OFFalse)
     , m_protocolVersion(ASC_AF_Default)
+    , m_asyncOperationsWindow(1)
 {
     OFStandard::initializeNetwork();
 }
@@ -135,6 +139,16 @@ OFCondition DcmSCU::initNetwork()
         return cond;
     }
 
+    /* set the TCP socket options to be used for the transport connection */
+    cond = ASC_setTCPBufferLength(m_net, m_tcpSendBufferLength, m_tcpReceiveBufferLength);
+    if (cond.good())
+        cond = ASC_setTCPNoDelay(m_net, m_tcpNoDelay);
+    if (cond.bad())
+    {
+        DCMNET_ERROR(DimseCondition::dump(tempStr, cond));
+        return cond;
+    }
+
     /* initialize association parameters, i.e. create an instance of T_ASC_Parameters*. */
     cond = ASC_createAssociationParameters(&m_params, m_maxReceivePDULength, m_tcpConnectTimeout, m_implIdentification);
     if (cond.bad())
@@ -150,6 +164,11 @@ OFCondition DcmSCU::initNetwork()
     /* sets the IP protocol version */
     ASC_setProtocolFamily(m_params, m_protocolVersion);
 
+    /* propose an asynchronous operations window (if any). We never perform */
+    /* operations invoked asynchronously by the peer. */
+    if (m_asyncOperationsWindow != 1)
+        ASC_setAsyncOperationsWindow(m_params, m_asyncOperationsWindow, 1);
+
     /* Figure out the presentation addresses and copy the */
     /* corresponding values into the association parameters.*/
     DIC_NODENAME peerHost;
@@ -706,6 +725,30 @@ OFCondition DcmSCU::sendSTORERequest(const T_ASC_PresentationContextID presID,
                                      Uint16& rspStatusCode,
                                      const OFString& moveOriginatorAETitle,
                                      const Uint16 moveOriginatorMsgID)
+{
+    /* Send request and wait for the corresponding response */
+    Uint16 messageID  = 0;
+    OFCondition cond = sendSTORERequestAsync(presID, dicomFile, dataset, messageID, moveOriginatorAETitle, moveOriginatorMsgID);
+    if (cond.good())
+    {
+        Uint16 messageIDRespondedTo = 0;
+        cond = receiveSTOREResponse(messageIDRespondedTo, rspStatusCode);
+        if (cond.good() && (messageIDRespondedTo != messageID))
+        {
+            DCMNET_WARN("Received C-STORE response for message ID " << messageIDRespondedTo
+                        << " but expected response for message ID " << messageID);
+        }
+    }
+    return cond;
+}
+
+// Sends C-STORE request without waiting for the response
+OFCondition DcmSCU::sendSTORERequestAsync(const T_ASC_PresentationContextID presID,
+                                          const OFFilename& dicomFile,
+                                          DcmDataset* dataset,
+                                          Uint16& messageID,
+                                          const OFString& moveOriginatorAETitle,
+                                          const Uint16 moveOriginatorMsgID)
 {
     // Do some basic validity checks
     if (!isConnected())
@@ -714,7 +757,6 @@ OFCondition DcmSCU::sendSTORERequest(const T_ASC_PresentationContextID presID,
     OFCondition cond;
     OFString tempStr;
     T_ASC_PresentationContextID pcid = presID;
-    DcmDataset* statusDetail         = NULL;
     T_DIMSE_Message msg;
     // Make sure everything is zeroed (especially options)
     memset((char*)&msg, 0, sizeof(msg));
@@ -858,12 +900,28 @@ OFCondition DcmSCU::sendSTORERequest(const T_ASC_PresentationContextID presID,
         DCMNET_ERROR("Failed sending C-STORE request: " << DimseCondition::dump(tempStr, cond));
         return cond;
     }
+    messageID = req->MessageID;
+    return cond;
+}
+
+// Receives the next C-STORE response
+OFCondition DcmSCU::receiveSTOREResponse(Uint16& messageIDRespondedTo,
+                                         Uint16& rspStatusCode,
+                                         const Uint32 timeout)
+{
+    // Do some basic validity checks
+    if (!isConnected())
+        return DIMSE_ILLEGALASSOCIATION;
+
+    OFString tempStr;
+    T_ASC_PresentationContextID pcid = 0;
+    DcmDataset* statusDetail         = NULL;
 
     /* Receive response */
     T_DIMSE_Message rsp;
     // Make sure everything is zeroed (especially options)
     memset((char*)&rsp, 0, sizeof(rsp));
-    cond = receiveDIMSECommand(&pcid, &rsp, &statusDetail, NULL /* not interested in the command set */);
+    OFCondition cond = receiveDIMSECommand(&pcid, &rsp, &statusDetail, NULL /* not interested in the command set */, timeout);
     if (cond.bad())
     {
         DCMNET_ERROR("Failed receiving DIMSE response: " << DimseCondition::dump(tempStr, cond));
@@ -892,6 +950,7 @@ OFCondition DcmSCU::sendSTORERequest(const T_ASC_PresentationContextID presID,
         return DIMSE_BADCOMMANDTYPE;
     }
     T_DIMSE_C_StoreRSP storeRsp = rsp.msg.CStoreRSP;
+    messageIDRespondedTo        = storeRsp.MessageIDBeingRespondedTo;
     rspStatusCode               = storeRsp.DimseStatus;
     if (statusDetail != NULL)
     {
@@ -2750,6 +2809,17 @@ void DcmSCU::setMaxReceivePDULength(const Uint32 maxRecPDU)
     m_maxReceivePDULength = maxRecPDU;
 }
 
+void DcmSCU::setTCPBufferLength(const Uint32 sendBufferLength, const Uint32 receiveBufferLength)
+{
+    m_tcpSendBufferLength = sendBufferLength;
+    m_tcpReceiveBufferLength = receiveBufferLength;
+}
+
+void DcmSCU::setTCPNoDelay(const int noDelay)
+{
+    m_tcpNoDelay = noDelay;
+}
+
 void DcmSCU::setDIMSEBlockingMode(const T_DIMSE_BlockingMode blockingMode)
 {
     m_blockMode = blockingMode;
@@ -2831,6 +2901,11 @@ void DcmSCU::setMaxNestingDepth(const Sint32 maxDepth)
     m_maxNestingDepth = maxDepth;
 }
 
+void DcmSCU::setAsyncOperationsWindow(const Uint16 maxOpsInvoked)
+{
+    m_asyncOperationsWindow = maxOpsInvoked;
+}
+
 void DcmSCU::setProtocolVersion(T_ASC_ProtocolFamily protocolVersion)
 {
     m_protocolVersion = protocolVersion;
@@ -2848,6 +2923,21 @@ Uint32 DcmSCU::getMaxReceivePDULength() const
     return m_maxReceivePDULength;
 }
 
+Uint32 DcmSCU::getTCPSendBufferLength() const
+{
+    return m_tcpSendBufferLength;
+}
+
+Uint32 DcmSCU::getTCPReceiveBufferLength() const
+{
+    return m_tcpReceiveBufferLength;
+}
+
+int DcmSCU::getTCPNoDelay() const
+{
+    return m_tcpNoDelay;
+}
+
 OFBool DcmSCU::getTLSEnabled() const
 {
     return m_secureConnectionEnabled;
@@ -2878,6 +2968,11 @@ Uint16 DcmSCU::getPeerPort() const
     return m_peerPort;
 }
 
+T_ASC_ProtocolFamily DcmSCU::getProtocolVersion() const
+{
+    return m_protocolVersion;
+}
+
 Uint32 DcmSCU::getDIMSETimeout() const
 {
     return m_dimseTimeout;
@@ -2923,6 +3018,20 @@ Sint32 DcmSCU::getMaxNestingDepth() const
     return m_maxNestingDepth;
 }
 
+Uint16 DcmSCU::getAsyncOperationsWindow() const
+{
+    return m_asyncOperationsWindow;
+}
+
+Uint16 DcmSCU::getMaxOperationsInvoked() const
+{
+    Uint16 maxOpsInvoked = 1;
+    Uint16 maxOpsPerformed = 1;
+    if (isConnected())
+        ASC_getAsyncOperationsWindow(m_assoc->params, maxOpsInvoked, maxOpsPerformed);
+    return maxOpsInvoked;
+}
+
 OFCondition DcmSCU::getDatasetInfo(DcmDataset* dataset,
                                    OFString& sopClassUID,
                                    OFString& sopInstanceUID,
@@ -0,0 +1,261 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: Benchmark for the C-STORE throughput on the loopback interface
+ *    with different maximum PDU sizes and TCP socket buffer lengths
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofconsol.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftimer.h"
+#include "dcmtk/oflog/oflog.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmnet/scp.h"
+#include "dcmtk/dcmnet/scu.h"
+
+#ifdef WITH_THREADS
+
+#include "dcmtk/ofstd/ofthread.h"
+
+
+/* SCP that receives C-STORE requests into memory and discards the datasets */
+class BenchSCP : public DcmSCP, public OFThread
+{
+public:
+
+    BenchSCP(const Uint32 maxPDU, const Uint32 tcpBufferLength)
+    : DcmSCP()
+    , m_result(EC_Normal)
+    , m_port(0)
+    {
+        DcmSCPConfig& config = getConfig();
+        config.setAETitle("NETBENCH_SCP");
+        config.setPort(0);
+        config.setHostLookupEnabled(OFFalse);
+        config.setMaxReceivePDULength(maxPDU);
+        config.setTCPBufferLength(tcpBufferLength, tcpBufferLength);
+        OFList<OFString> xfers;
+        xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+        config.addPresentationContext(UID_SecondaryCaptureImageStorage, xfers);
+        m_result = openListenPort();
+        m_port = config.getPort();
+    }
+
+    virtual OFCondition handleIncomingCommand(T_DIMSE_Message* incomingMsg,
+                                              const DcmPresentationContextInfo& presInfo)
+    {
+        if (incomingMsg->CommandField == DIMSE_C_STORE_RQ)
+        {
+            DcmDataset* dataset = NULL;
+            OFCondition cond = handleSTORERequest(incomingMsg->msg.CStoreRQ,
+                presInfo.presentationContextID, dataset);
+            delete dataset;
+            return cond;
+        }
+        return DcmSCP::handleIncomingCommand(incomingMsg, presInfo);
+    }
+
+    virtual OFBool stopAfterCurrentAssociation()
+    {
+        return OFTrue;
+    }
+
+    OFCondition m_result;
+    Uint16 m_port;
+
+protected:
+
+    virtual void run()
+    {
+        m_result = acceptAssociations();
+    }
+};
+
+
+/* sends the dataset the given number of times to a new SCP with the given
+ * settings, returns the time needed (in seconds) or a negative value on error
+ */
+static double measure(DcmDataset& dataset,
+                      const unsigned long count,
+                      const Uint32 maxPDU,
+                      const Uint32 tcpBufferLength)
+{
+    BenchSCP scp(maxPDU, tcpBufferLength);
+    if (scp.m_result.bad())
+    {
+        CERR << "Error: cannot open listen port: " << scp.m_result.text() << OFendl;
+        return -1.0;
+    }
+    scp.start();
+
+    DcmSCU scu;
+    scu.setAETitle("NETBENCH_SCU");
+    scu.setPeerAETitle("NETBENCH_SCP");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(scp.m_port);
+    scu.setMaxReceivePDULength(maxPDU);
+    scu.setTCPBufferLength(tcpBufferLength, tcpBufferLength);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    scu.addPresentationContext(UID_SecondaryCaptureImageStorage, xfers);
+    OFCondition cond = scu.initNetwork();
+    if (cond.good())
+        cond = scu.negotiateAssociation();
+    double result = -1.0;
+    if (cond.good())
+    {
+        const T_ASC_PresentationContextID presID = scu.findPresentationContextID(
+            UID_SecondaryCaptureImageStorage, UID_LittleEndianExplicitTransferSyntax);
+        Uint16 rspStatus = 0;
+        OFTimer timer;
+        for (unsigned long i = 0; (i < count) && cond.good(); ++i)
+        {
+            cond = scu.sendSTORERequest(presID, "", &dataset, rspStatus);
+            if (cond.good() && (rspStatus != STATUS_Success))
+                cond = DIMSE_BADDATA;
+        }
+        if (cond.good())
+            result = timer.getDiff();
+        scu.releaseAssociation();
+    }
+    else
+    {
+        /* make sure that the SCP does not wait for an association forever */
+        scu.freeNetwork();
+        DcmSCU dummy;
+        dummy.setPeerHostName("localhost");
+        dummy.setPeerPort(scp.m_port);
+        dummy.addPresentationContext(UID_VerificationSOPClass, xfers);
+        if (dummy.initNetwork().good() && dummy.negotiateAssociation().good())
+            dummy.releaseAssociation();
+    }
+    if (cond.bad())
+        CERR << "Error: cannot send dataset: " << cond.text() << OFendl;
+    scp.join();
+    return result;
+}
+
+#endif // WITH_THREADS
+
+
+int main(int argc, char *argv[])
+{
+    if ((argc > 4) || ((argc > 1) && (argv[1][0] == '-')))
+    {
+        CERR << "Usage: netbench [size [count [iterations]]]" << OFendl
+             << "  size        size of the SOP instance in MB (default: 64)" << OFendl
+             << "  count       number of SOP instances sent per measurement (default: 8)" << OFendl
+             << "  iterations  number of measurements, the best one is reported (default: 3)" << OFendl;
+        return 1;
+    }
+
+#ifdef WITH_THREADS
+    /* suppress the informational messages of the SCP and SCU */
+    OFLog::configure(OFLogger::WARN_LOG_LEVEL);
+
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+        CERR << "Error: no data dictionary loaded, check environment variable: " << DCM_DICT_ENVIRONMENT_VARIABLE << OFendl;
+        return 1;
+    }
+
+    const unsigned long size = (argc > 1) ? OFstatic_cast(unsigned long, atol(argv[1])) : 64;
+    const unsigned long count = (argc > 2) ? OFstatic_cast(unsigned long, atol(argv[2])) : 8;
+    const unsigned long iterations = (argc > 3) ? OFstatic_cast(unsigned long, atol(argv[3])) : 3;
+    if ((size < 1) || (size > 1024) || (count < 1) || (iterations < 1))
+    {
+        CERR << "Error: invalid parameter value" << OFendl;
+        return 1;
+    }
+
+    /* a secondary capture image with 8 bit pixel data of the given size */
+    DcmDataset dataset;
+    char uid[65];
+    dataset.putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    dataset.putAndInsertString(DCM_SOPInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+    dataset.putAndInsertString(DCM_StudyInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_STUDY_UID_ROOT));
+    dataset.putAndInsertString(DCM_SeriesInstanceUID, dcmGenerateUniqueIdentifier(uid, SITE_SERIES_UID_ROOT));
+    dataset.putAndInsertString(DCM_PatientName, "Doe^John");
+    dataset.putAndInsertString(DCM_Modality, "OT");
+    dataset.putAndInsertString(DCM_PhotometricInterpretation, "MONOCHROME2");
+    dataset.putAndInsertUint16(DCM_SamplesPerPixel, 1);
+    dataset.putAndInsertUint16(DCM_Rows, OFstatic_cast(Uint16, size * 32));
+    dataset.putAndInsertUint16(DCM_Columns, 32768);
+    dataset.putAndInsertUint16(DCM_BitsAllocated, 8);
+    dataset.putAndInsertUint16(DCM_BitsStored, 8);
+    dataset.putAndInsertUint16(DCM_HighBit, 7);
+    dataset.putAndInsertUint16(DCM_PixelRepresentation, 0);
+    const unsigned long length = size * 1024 * 1024;
+    Uint8 *pixels = new Uint8[length];
+    for (unsigned long i = 0; i < length; ++i)
+        pixels[i] = OFstatic_cast(Uint8, i * 13 + 7);
+    dataset.putAndInsertUint8Array(DCM_PixelData, pixels, length);
+    delete[] pixels;
+
+    struct
+    {
+        Uint32 maxPDU;
+        Uint32 tcpBufferLength;
+    } settings[] =
+    {
+        {    16384,       0 },  // default maximum PDU size
+        {   131072,       0 },  // former maximum PDU size
+        {  1048576,       0 },
+        {  4194304,       0 },
+        {  4194304, 4194304 },
+        { 16777216,       0 },
+        { 16777216, 8388608 }
+    };
+    const size_t numSettings = sizeof(settings) / sizeof(settings[0]);
+
+    COUT << count << " SOP instances of " << size << " MB each, best of " << iterations << " measurements:" << OFendl;
+    int result = 0;
+    for (size_t s = 0; (s < numSettings) && (result == 0); ++s)
+    {
+        double best = 0.0;
+        for (unsigned long i = 0; i < iterations; ++i)
+        {
+            const double time = measure(dataset, count, settings[s].maxPDU, settings[s].tcpBufferLength);
+            if (time < 0.0)
+            {
+                result = 1;
+                break;
+            }
+            if ((i == 0) || (time < best))
+                best = time;
+        }
+        if (result == 0)
+        {
+            COUT << "  max PDU " << STD_NAMESPACE setw(8) << settings[s].maxPDU << " bytes, TCP buffers ";
+            if (settings[s].tcpBufferLength > 0)
+                COUT << STD_NAMESPACE setw(8) << settings[s].tcpBufferLength << " bytes";
+            else
+                COUT << "  (system)    ";
+            COUT << ": " << best * 1000.0 << " ms, "
+                 << (best > 0.0 ? OFstatic_cast(double, size * count) / best : 0.0) << " MB/s" << OFendl;
+        }
+    }
+    return result;
+#else
+    CERR << "Error: netbench requires DCMTK to be compiled with thread support" << OFendl;
+    return 1;
+#endif
+}
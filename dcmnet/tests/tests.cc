@@ -28,6 +28,8 @@ OFTEST_REGISTER(dcmnet_dimseStatusClass);
 
 #ifdef WITH_THREADS
 OFTEST_REGISTER(dcmnet_scp_pool);
+OFTEST_REGISTER(dcmnet_storescu_parallel_associations);
+OFTEST_REGISTER(dcmnet_scp_event_pool);
 OFTEST_REGISTER(dcmnet_scp_builtin_verification_support);
 OFTEST_REGISTER(dcmnet_scp_fail_on_invalid_association_configuration);
 OFTEST_REGISTER(dcmnet_scp_fail_on_disallowed_host);
@@ -60,6 +62,9 @@ OFTEST_REGISTER(dcmnet_scp_maxNestingDepth_getset);
 OFTEST_REGISTER(dcmnet_scu_maxNestingDepth_getset);
 OFTEST_REGISTER(dcmnet_scp_maxNestingDepth_rejects_deep);
 OFTEST_REGISTER(dcmnet_scp_maxNestingDepth_accepts_shallow);
+OFTEST_REGISTER(dcmnet_scu_async_store);
+OFTEST_REGISTER(dcmnet_storescu_async_store);
+OFTEST_REGISTER(dcmnet_scu_large_pdu);
 
 #endif // WITH_THREADS
 
@@ -0,0 +1,146 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmnet
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: Test DcmEventSCPPool class, including DcmSCP and DcmSCU interaction
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#ifdef WITH_THREADS
+
+#include "dcmtk/ofstd/oftest.h"
+#include "dcmtk/dcmnet/scpevpool.h"
+#include "dcmtk/dcmnet/scu.h"
+#include "dcmtk/ofstd/ofthread.h"
+
+
+const size_t NUM_ASSOCIATIONS = 20;
+const size_t NUM_ECHOS = 3;
+
+struct TestEventSCU : DcmSCU, OFThread
+{
+
+    TestEventSCU() : m_result()
+    {
+        m_resultMutex.lock();
+        m_result = EC_IllegalCall;
+        m_resultMutex.unlock();
+    }
+
+    void getResult(OFCondition& result)
+    {
+        m_resultMutex.lock();
+        result = m_result;
+        m_resultMutex.unlock();
+    }
+
+protected:
+
+    void run()
+    {
+        OFCondition result = negotiateAssociation();
+        // keep the association idle for a while, so that all associations
+        // are open at the same time
+        OFStandard::forceSleep(1);
+        for (size_t i = 0; (i < NUM_ECHOS) && result.good(); ++i)
+            result = sendECHORequest(0);
+        m_resultMutex.lock();
+        m_result = result;
+        m_resultMutex.unlock();
+        releaseAssociation();
+    }
+
+private:
+
+    OFCondition m_result;
+    OFMutex m_resultMutex;
+
+};
+
+struct TestEventPool : DcmEventSCPPool<>, OFThread
+{
+    OFCondition result;
+protected:
+    void run()
+    {
+        result = listen();
+    }
+};
+
+
+/* Test starts an event-driven pool with only two worker threads. All
+ * associations are configured to support C-ECHO (Verification SOP Class).
+ * 20 SCU threads are created and connect simultaneously to the pool, keep
+ * their association idle for a while, send some C-ECHO messages and
+ * release the association. A thread-per-association pool with two threads
+ * would have to reject most of these associations.
+ */
+OFTEST_FLAGS(dcmnet_scp_event_pool, EF_Slow)
+{
+    TestEventPool pool;
+    DcmSCPConfig& config = pool.getConfig();
+
+    config.setAETitle("EvPoolTestSCP");
+    config.setPort(11114);
+
+    pool.setNumberOfWorkerThreads(2);
+    pool.setMaxAssociations(NUM_ASSOCIATIONS);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+    config.addPresentationContext(UID_VerificationSOPClass, xfers);
+
+    pool.start();
+
+    OFVector<TestEventSCU*> scus(NUM_ASSOCIATIONS, NULL);
+    for (OFVector<TestEventSCU*>::iterator it1 = scus.begin(); it1 != scus.end(); ++it1)
+    {
+        *it1 = new TestEventSCU;
+        (*it1)->setAETitle("EvPoolTestSCU");
+        (*it1)->setPeerAETitle("EvPoolTestSCP");
+        (*it1)->setPeerHostName("localhost");
+        (*it1)->setPeerPort(11114);
+        (*it1)->addPresentationContext(UID_VerificationSOPClass, xfers);
+        (*it1)->initNetwork();
+    }
+
+    // "ensure" the pool is initialized before any SCU starts connecting to it
+    OFStandard::forceSleep(2);
+
+    for (OFVector<TestEventSCU*>::const_iterator it2 = scus.begin(); it2 != scus.end(); ++it2)
+        (*it2)->start();
+
+    for (OFVector<TestEventSCU*>::iterator it3 = scus.begin(); it3 != scus.end(); ++it3)
+    {
+        OFCondition scuResult;
+        (*it3)->join();
+        (*it3)->getResult(scuResult);
+        delete *it3;
+        OFCHECK(scuResult.good());
+    }
+
+    // Request shutdown, listen() returns once all associations are terminated.
+    pool.stopAfterCurrentAssociations();
+    pool.join();
+
+    OFCHECK(pool.result.good());
+    OFCHECK_EQUAL(pool.numAssociations(OFFalse), OFstatic_cast(size_t, 0));
+}
+
+#endif // WITH_THREADS
@@ -1,6 +1,6 @@
 /*
  *
- *  Copyright (C) 2013-2025, OFFIS e.V.
+ *  Copyright (C) 2013-2026, OFFIS e.V.
  *  All rights reserved.  See COPYRIGHT file for details.
  *
  *  This software and supporting documentation were developed by
@@ -27,7 +27,9 @@
 #include "dcmtk/ofstd/oftest.h"
 #include "dcmtk/dcmnet/scppool.h"
 #include "dcmtk/dcmnet/scu.h"
+#include "dcmtk/dcmnet/dstorscu.h"
 #include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/ofstd/ofmap.h"
 
 
 const size_t NUM_THREADS = 20;
@@ -168,4 +170,145 @@ OFTEST_FLAGS(dcmnet_scp_pool, EF_Slow)
     OFCHECK(pool.result.good());
 }
 
+
+/* SCP worker that accepts C-STORE requests (without storing the datasets)
+ * and counts the SOP instances received by all workers
+ */
+struct StoreSCP : DcmThreadSCP
+{
+    OFCondition handleIncomingCommand(T_DIMSE_Message* incomingMsg,
+                                      const DcmPresentationContextInfo& presInfo)
+    {
+        if (incomingMsg->CommandField == DIMSE_C_STORE_RQ)
+        {
+            DcmDataset* dataset = NULL;
+            OFCondition cond = handleSTORERequest(incomingMsg->msg.CStoreRQ,
+                presInfo.presentationContextID, dataset);
+            delete dataset;
+            if (cond.good())
+            {
+                s_mutex.lock();
+                ++s_numReceived;
+                s_mutex.unlock();
+            }
+            return cond;
+        }
+        return DcmThreadSCP::handleIncomingCommand(incomingMsg, presInfo);
+    }
+
+    static OFMutex s_mutex;
+    static size_t s_numReceived;
+};
+
+OFMutex StoreSCP::s_mutex;
+size_t StoreSCP::s_numReceived = 0;
+
+struct StorePool : DcmSCPPool<StoreSCP>, OFThread
+{
+    OFCondition result;
+protected:
+    void run()
+    {
+        result = listen();
+    }
+};
+
+/* Storage SCU that records the association used for each SOP instance */
+struct ParallelStorageSCU : DcmStorageSCU
+{
+    ParallelStorageSCU() : m_numSuccess(0), m_inNotify(OFFalse) { }
+
+    void notifySOPInstanceSent(const TransferEntry& transferEntry)
+    {
+        // the notifications of all threads are serialized
+        OFCHECK(!m_inNotify);
+        m_inNotify = OFTrue;
+        if (transferEntry.RequestSent && (transferEntry.ResponseStatusCode == STATUS_Success))
+            ++m_numSuccess;
+        m_association[transferEntry.SOPInstanceUID] = transferEntry.AssociationNumber;
+        m_inNotify = OFFalse;
+    }
+
+    size_t m_numSuccess;
+    OFBool m_inNotify;
+    OFMap<OFString, unsigned long> m_association;
+};
+
+
+/* Test sends SOP instances of three studies on concurrent associations
+ * to a pool of SCP workers: first partitioned by study, then in turn.
+ */
+OFTEST_FLAGS(dcmnet_storescu_parallel_associations, EF_Slow)
+{
+    StorePool pool;
+    DcmSCPConfig& config = pool.getConfig();
+    config.setAETitle("PoolTestSCP");
+    config.setPort(11116);
+    config.setConnectionBlockingMode(DUL_NOBLOCK);
+    config.setConnectionTimeout(1);
+    pool.setMaxThreads(4);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+    config.addPresentationContext(UID_SecondaryCaptureImageStorage, xfers);
+    pool.start();
+
+    const size_t numStudies = 3;
+    const size_t numInstances = 12;
+    ParallelStorageSCU scu;
+    scu.setAETitle("PoolTestSCU");
+    scu.setPeerAETitle("PoolTestSCP");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(11116);
+    OFVector<OFString> instanceUIDs;
+    char uid[65];
+    for (size_t i = 0; i < numInstances; ++i)
+    {
+        DcmDataset* dataset = new DcmDataset;
+        dataset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+        instanceUIDs.push_back(dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+        dataset->putAndInsertString(DCM_SOPInstanceUID, instanceUIDs.back().c_str());
+        // the studies are interleaved in the transfer list
+        OFStandard::snprintf(uid, sizeof(uid), "1.2.276.0.7230010.3.4.5.%lu", OFstatic_cast(unsigned long, i % numStudies));
+        dataset->putAndInsertString(DCM_StudyInstanceUID, uid);
+        OFCHECK(scu.addDataset(dataset, EXS_LittleEndianExplicit, DcmStorageSCU::HM_deleteAfterRemove).good());
+    }
+
+    // "ensure" the pool is initialized before the SCU starts connecting to it
+    OFStandard::forceSleep(3);
+
+    // all SOP instances of a study are sent on the same association
+    OFCondition result = scu.sendSOPInstancesInParallel(4, DcmStorageSCU::PM_byStudy);
+    OFCHECK_MSG(result.good(), result.text());
+    OFCHECK_EQUAL(scu.getAssociationCounter(), numStudies);
+    OFCHECK_EQUAL(scu.getNumberOfSOPInstancesToBeSent(), 0);
+    OFCHECK_EQUAL(scu.m_numSuccess, numInstances);
+    size_t i;
+    for (i = numStudies; i < numInstances; ++i)
+        OFCHECK_EQUAL(scu.m_association[instanceUIDs[i]], scu.m_association[instanceUIDs[i - numStudies]]);
+    OFCHECK(scu.m_association[instanceUIDs[0]] != scu.m_association[instanceUIDs[1]]);
+    OFCHECK(scu.m_association[instanceUIDs[1]] != scu.m_association[instanceUIDs[2]]);
+
+    // send them again, distributed to two associations in turn
+    scu.resetSentStatus();
+    scu.m_numSuccess = 0;
+    result = scu.sendSOPInstancesInParallel(2, DcmStorageSCU::PM_roundRobin);
+    OFCHECK_MSG(result.good(), result.text());
+    OFCHECK_EQUAL(scu.getAssociationCounter(), numStudies + 2);
+    OFCHECK_EQUAL(scu.m_numSuccess, numInstances);
+    for (i = 0; i < numInstances; ++i)
+    {
+        OFCHECK(scu.m_association[instanceUIDs[i]] > numStudies);
+        if (i >= 2)
+            OFCHECK_EQUAL(scu.m_association[instanceUIDs[i]], scu.m_association[instanceUIDs[i - 2]]);
+    }
+
+    pool.stopAfterCurrentAssociations();
+    pool.join();
+    OFCHECK(pool.result.good());
+    StoreSCP::s_mutex.lock();
+    OFCHECK_EQUAL(StoreSCP::s_numReceived, 2 * numInstances);
+    StoreSCP::s_mutex.unlock();
+}
+
 #endif // WITH_THREADS
@@ -28,6 +28,7 @@
 #include "dcmtk/ofstd/ofrand.h"
 #include "dcmtk/dcmnet/scp.h"
 #include "dcmtk/dcmnet/scu.h"
+#include "dcmtk/dcmnet/dstorscu.h"
 
 
 /** SCP derived from DcmSCP in order to test two types of virtual methods:
@@ -1473,4 +1474,350 @@ OFTEST_FLAGS(dcmnet_scp_maxNestingDepth_accepts_shallow, EF_Slow)
 }
 
 
+// Test SCP that supports asynchronous operations: the C-STORE requests are
+// collected in pairs and responded to in reverse order
+struct AsyncStoreTestSCP : TestSCP
+{
+    AsyncStoreTestSCP(Uint16 asyncWindow)
+        : TestSCP()
+        , m_numReceived(0)
+        , m_maxOutstanding(0)
+    {
+        DcmSCPConfig& config = getConfig();
+        config.setAETitle("ASYNC_SCP");
+        config.setConnectionBlockingMode(DUL_NOBLOCK);
+        config.setConnectionTimeout(10);
+        config.setHostLookupEnabled(OFFalse);
+        config.setPort(0);
+        config.setAsyncOperationsWindow(asyncWindow);
+        OFList<OFString> xfers;
+        xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+        OFCHECK(config.addPresentationContext(
+            UID_SecondaryCaptureImageStorage, xfers).good());
+        OFCHECK(openListenPort().good());
+        m_portNum = config.getPort();
+    }
+
+    OFCondition handleIncomingCommand(
+        T_DIMSE_Message* incomingMsg,
+        const DcmPresentationContextInfo& presInfo)
+    {
+        if (incomingMsg->CommandField == DIMSE_C_STORE_RQ)
+        {
+            T_DIMSE_C_StoreRQ& req = incomingMsg->msg.CStoreRQ;
+            DcmDataset* dataset = NULL;
+            OFCondition result = receiveSTORERequest(req,
+                presInfo.presentationContextID, dataset);
+            delete dataset;
+            if (result.bad())
+                return result;
+            ++m_numReceived;
+            m_pending.push_back(req);
+            if (m_pending.size() > m_maxOutstanding)
+                m_maxOutstanding = m_pending.size();
+            if (m_pending.size() == 2)
+            {
+                while (!m_pending.empty() && result.good())
+                {
+                    const T_DIMSE_C_StoreRQ& pending = m_pending.back();
+                    /* refuse every third instance */
+                    const Uint16 status = (pending.MessageID % 3 == 0)
+                        ? STATUS_STORE_Refused_OutOfResources
+                        : STATUS_Success;
+                    result = sendSTOREResponse(
+                        presInfo.presentationContextID, pending, status);
+                    m_pending.pop_back();
+                }
+            }
+            return result;
+        }
+        return DcmSCP::handleIncomingCommand(incomingMsg, presInfo);
+    }
+
+    /// Requests not yet responded to
+    OFVector<T_DIMSE_C_StoreRQ> m_pending;
+    /// Number of C-STORE requests received
+    size_t m_numReceived;
+    /// Maximum number of outstanding requests observed
+    size_t m_maxOutstanding;
+    /// Port the SCP is listening on
+    Uint16 m_portNum;
+};
+
+
+// Test asynchronous C-STORE operations: the requests are sent without
+// waiting for the responses, which arrive in a different order
+OFTEST_FLAGS(dcmnet_scu_async_store, EF_Slow)
+{
+    AsyncStoreTestSCP scp(4);
+    scp.m_set_stop_after_assoc = OFTrue;
+    scp.start();
+    OFStandard::forceSleep(1);
+
+    DcmSCU scu;
+    scu.setAETitle("ASYNC_SCU");
+    scu.setPeerAETitle("ASYNC_SCP");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(scp.m_portNum);
+    scu.setDIMSEBlockingMode(DIMSE_NONBLOCKING);
+    scu.setDIMSETimeout(10);
+    scu.setAsyncOperationsWindow(8);
+    OFCHECK_EQUAL(scu.getAsyncOperationsWindow(), 8);
+    OFCHECK_EQUAL(scu.getMaxOperationsInvoked(), 1);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianImplicitTransferSyntax);
+    OFCHECK(scu.addPresentationContext(
+        UID_SecondaryCaptureImageStorage, xfers).good());
+    OFCHECK(scu.initNetwork().good());
+    OFCHECK(scu.negotiateAssociation().good());
+    // the SCP limits the window to its own configuration
+    OFCHECK_EQUAL(scu.getMaxOperationsInvoked(), 4);
+
+    T_ASC_PresentationContextID presID = scu.findPresentationContextID(
+        UID_SecondaryCaptureImageStorage,
+        UID_LittleEndianImplicitTransferSyntax);
+    OFCHECK(presID != 0);
+    const size_t numInstances = 6;
+    OFVector<Uint16> messageIDs;
+    size_t numResponses = 0;
+    size_t numRefused = 0;
+    for (size_t i = 0; i < numInstances; ++i)
+    {
+        DcmDataset dataset;
+        char uid[65];
+        dataset.putAndInsertString(DCM_SOPClassUID,
+            UID_SecondaryCaptureImageStorage);
+        dataset.putAndInsertString(DCM_SOPInstanceUID,
+            dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+        dataset.putAndInsertString(DCM_PatientName, "Doe^John");
+        Uint16 messageID = 0;
+        OFCondition result = scu.sendSTORERequestAsync(presID, "",
+            &dataset, messageID);
+        OFCHECK_MSG(result.good(), result.text());
+        messageIDs.push_back(messageID);
+        // a pair of requests is outstanding, receive both responses
+        if (i % 2 == 1)
+        {
+            for (size_t j = 0; j < 2; ++j)
+            {
+                Uint16 respondedTo = 0;
+                Uint16 rspStatus = 0;
+                result = scu.receiveSTOREResponse(respondedTo, rspStatus);
+                OFCHECK_MSG(result.good(), result.text());
+                // responses arrive in reverse order
+                OFCHECK_EQUAL(respondedTo, messageIDs[i - j]);
+                if (rspStatus == STATUS_STORE_Refused_OutOfResources)
+                {
+                    OFCHECK(respondedTo % 3 == 0);
+                    ++numRefused;
+                }
+                else
+                    OFCHECK_EQUAL(rspStatus, STATUS_Success);
+                ++numResponses;
+            }
+        }
+    }
+    OFCHECK_EQUAL(numResponses, numInstances);
+    OFCHECK(numRefused > 0);
+    if (scu.isConnected())
+        OFCHECK(scu.releaseAssociation().good());
+    OFStandard::forceSleep(2);
+    scp.join();
+
+    OFCHECK_EQUAL(scp.m_numReceived, numInstances);
+    OFCHECK_EQUAL(scp.m_maxOutstanding, 2);
+}
+
+
+// Storage SCU that counts the C-STORE responses received
+struct CountingStorageSCU : DcmStorageSCU
+{
+    CountingStorageSCU()
+        : DcmStorageSCU()
+        , m_numSuccess(0)
+        , m_numRefused(0)
+    {
+    }
+
+    void notifySOPInstanceSent(const TransferEntry& transferEntry)
+    {
+        if (transferEntry.RequestSent)
+        {
+            if (transferEntry.ResponseStatusCode == STATUS_Success)
+                ++m_numSuccess;
+            else if (transferEntry.ResponseStatusCode == STATUS_STORE_Refused_OutOfResources)
+                ++m_numRefused;
+        }
+    }
+
+    /// Number of instances stored successfully
+    size_t m_numSuccess;
+    /// Number of instances refused by the SCP
+    size_t m_numRefused;
+};
+
+
+// Test that the storage SCU sends its transfer list asynchronously if
+// negotiated, and matches the responses to the SOP instances
+OFTEST_FLAGS(dcmnet_storescu_async_store, EF_Slow)
+{
+    AsyncStoreTestSCP scp(4);
+    scp.m_set_stop_after_assoc = OFTrue;
+    scp.start();
+    OFStandard::forceSleep(1);
+
+    CountingStorageSCU scu;
+    scu.setAETitle("ASYNC_SCU");
+    scu.setPeerAETitle("ASYNC_SCP");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(scp.m_portNum);
+    scu.setDIMSEBlockingMode(DIMSE_NONBLOCKING);
+    scu.setDIMSETimeout(10);
+    scu.setAsyncOperationsWindow(0);
+    const size_t numInstances = 6;
+    for (size_t i = 0; i < numInstances; ++i)
+    {
+        DcmDataset* dataset = new DcmDataset;
+        char uid[65];
+        dataset->putAndInsertString(DCM_SOPClassUID,
+            UID_SecondaryCaptureImageStorage);
+        dataset->putAndInsertString(DCM_SOPInstanceUID,
+            dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+        dataset->putAndInsertString(DCM_PatientName, "Doe^John");
+        OFCHECK(scu.addDataset(dataset, EXS_LittleEndianImplicit,
+            DcmStorageSCU::HM_deleteAfterRemove).good());
+    }
+    OFCHECK(scu.addPresentationContexts().good());
+    OFCHECK(scu.initNetwork().good());
+    OFCHECK(scu.negotiateAssociation().good());
+    OFCHECK_EQUAL(scu.getMaxOperationsInvoked(), 4);
+    OFCondition result = scu.sendSOPInstances();
+    OFCHECK_MSG(result.good(), result.text());
+    OFCHECK_EQUAL(scu.getNumberOfSOPInstancesToBeSent(), 0);
+    OFCHECK_EQUAL(scu.m_numSuccess + scu.m_numRefused, numInstances);
+    OFCHECK(scu.m_numRefused > 0);
+    if (scu.isConnected())
+        OFCHECK(scu.releaseAssociation().good());
+    OFStandard::forceSleep(2);
+    scp.join();
+
+    OFCHECK_EQUAL(scp.m_numReceived, numInstances);
+}
+
+
+// Test SCP that accepts PDUs larger than 128 KB and keeps the last dataset
+// received with a C-STORE request
+struct LargePDUTestSCP : TestSCP
+{
+    LargePDUTestSCP(Uint32 maxPDU)
+        : TestSCP()
+        , m_dataset(NULL)
+    {
+        DcmSCPConfig& config = getConfig();
+        config.setAETitle("LARGE_PDU_SCP");
+        config.setConnectionBlockingMode(DUL_NOBLOCK);
+        config.setConnectionTimeout(10);
+        config.setHostLookupEnabled(OFFalse);
+        config.setPort(0);
+        config.setMaxReceivePDULength(maxPDU);
+        config.setTCPBufferLength(1048576, 1048576);
+        config.setTCPNoDelay(1);
+        OFList<OFString> xfers;
+        xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+        OFCHECK(config.addPresentationContext(
+            UID_SecondaryCaptureImageStorage, xfers).good());
+        OFCHECK(openListenPort().good());
+        m_portNum = config.getPort();
+    }
+
+    ~LargePDUTestSCP()
+    {
+        delete m_dataset;
+    }
+
+    OFCondition handleIncomingCommand(
+        T_DIMSE_Message* incomingMsg,
+        const DcmPresentationContextInfo& presInfo)
+    {
+        if (incomingMsg->CommandField == DIMSE_C_STORE_RQ)
+        {
+            delete m_dataset;
+            m_dataset = NULL;
+            return handleSTORERequest(incomingMsg->msg.CStoreRQ,
+                presInfo.presentationContextID, m_dataset);
+        }
+        return DcmSCP::handleIncomingCommand(incomingMsg, presInfo);
+    }
+
+    /// Dataset received with the last C-STORE request
+    DcmDataset* m_dataset;
+    /// Port the SCP is listening on
+    Uint16 m_portNum;
+};
+
+
+// Test that a dataset is sent in PDUs larger than the former maximum of
+// 128 KB, with explicitly configured TCP socket options
+OFTEST_FLAGS(dcmnet_scu_large_pdu, EF_Slow)
+{
+    LargePDUTestSCP scp(4194304);
+    scp.m_set_stop_after_assoc = OFTrue;
+    scp.start();
+    OFStandard::forceSleep(1);
+
+    DcmSCU scu;
+    scu.setAETitle("LARGE_PDU_SCU");
+    scu.setPeerAETitle("LARGE_PDU_SCP");
+    scu.setPeerHostName("localhost");
+    scu.setPeerPort(scp.m_portNum);
+    scu.setMaxReceivePDULength(ASC_MAXIMUMPDUSIZE);
+    scu.setTCPBufferLength(1048576, 1048576);
+    scu.setTCPNoDelay(1);
+    OFCHECK_EQUAL(scu.getTCPSendBufferLength(), 1048576);
+    OFCHECK_EQUAL(scu.getTCPNoDelay(), 1);
+    OFList<OFString> xfers;
+    xfers.push_back(UID_LittleEndianExplicitTransferSyntax);
+    OFCHECK(scu.addPresentationContext(
+        UID_SecondaryCaptureImageStorage, xfers).good());
+    OFCHECK(scu.initNetwork().good());
+    OFCHECK(scu.negotiateAssociation().good());
+    T_ASC_PresentationContextID presID = scu.findPresentationContextID(
+        UID_SecondaryCaptureImageStorage,
+        UID_LittleEndianExplicitTransferSyntax);
+    OFCHECK(presID != 0);
+
+    // about 10 MB of pixel data, i.e. a few PDUs of 4 MB
+    const unsigned long numWords = 5 * 1024 * 1024 + 3;
+    Uint16* words = new Uint16[numWords];
+    for (unsigned long i = 0; i < numWords; ++i)
+        words[i] = OFstatic_cast(Uint16, i * 7 + 1);
+    DcmDataset dataset;
+    char uid[65];
+    dataset.putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    dataset.putAndInsertString(DCM_SOPInstanceUID,
+        dcmGenerateUniqueIdentifier(uid, SITE_INSTANCE_UID_ROOT));
+    dataset.putAndInsertString(DCM_PatientName, "Doe^John");
+    OFCHECK(dataset.putAndInsertUint16Array(DCM_PixelData, words, numWords).good());
+    Uint16 rspStatus = 0;
+    OFCondition result = scu.sendSTORERequest(presID, "", &dataset, rspStatus);
+    OFCHECK_MSG(result.good(), result.text());
+    OFCHECK_EQUAL(rspStatus, STATUS_Success);
+    if (scu.isConnected())
+        OFCHECK(scu.releaseAssociation().good());
+    OFStandard::forceSleep(2);
+    scp.join();
+
+    OFCHECK(scp.m_dataset != NULL);
+    if (scp.m_dataset)
+    {
+        const Uint16* values = NULL;
+        unsigned long count = 0;
+        OFCHECK(scp.m_dataset->findAndGetUint16Array(DCM_PixelData, values, &count).good());
+        OFCHECK_EQUAL(count, numWords);
+        OFCHECK(values != NULL && memcmp(values, words, numWords * sizeof(Uint16)) == 0);
+    }
+    delete[] words;
+}
+
+
 #endif // WITH_THREADS
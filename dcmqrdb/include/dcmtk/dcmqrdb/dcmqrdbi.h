@@ -28,6 +28,7 @@
 #include "dcmtk/dcmnet/dicom.h"
 #include "dcmtk/dcmnet/dimse.h"
 #include "dcmtk/ofstd/offname.h"
+#include "dcmtk/dcmqrdb/dcmqrkey.h"    /* for DB_KeyIndexType */
 
 struct StudyDescRecord;
 struct DB_Private_Handle;
@@ -292,14 +293,17 @@ public:
    */
   OFCondition DB_unlock();
 
-  /** Get next Index record that is in use (i.e. references a non-empty a filename)
+  /** Get next Index record that is in use (i.e. references a non-empty a filename).
+   *  If the loop has been restricted with DB_IdxSelectCandidates(), only the
+   *  candidate records are visited.
    *  @param idx pointer to index number, updated upon successful return
    *  @param idxRec pointer to index record structure
    *  @return EC_Normal upon success, an error code otherwise
    */
   OFCondition DB_IdxGetNext(int *idx, IdxRecord *idxRec);
 
-  /** seek to beginning of image records in index file
+  /** seek to beginning of image records in index file, subsequent calls
+   *  to DB_IdxGetNext() visit all records
    *  @param idx initialized to -1
    *  @return EC_Normal upon success, an error code otherwise
    */
@@ -398,6 +402,48 @@ private:
       DB_LEVEL        infLevel,
       DB_LEVEL        lowestLevel);
 
+  /** check whether the key index can be used after the database has been
+   *  locked, and rebuild it if necessary and possible.
+   *  @param exclusive OFTrue if the database is locked exclusively
+   */
+  void DB_KeyIndexCheck(OFBool exclusive);
+
+  /** rebuild the key index from the index file.
+   *  Requires an exclusive lock on the database.
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition DB_KeyIndexRebuild();
+
+  /** look up the records that may contain the given value using the key index
+   *  @param type attribute to be looked up
+   *  @param value value to be looked up
+   *  @param records sorted list of candidate record numbers returned here
+   *  @return OFTrue if the key index has been used, OFFalse if all records
+   *    must be examined
+   */
+  OFBool DB_KeyIndexLookup(DB_KeyIndexType type, const char *value, OFVector<int> &records);
+
+  /** restrict the loop started by DB_IdxInitLoop() to the records that
+   *  may match the current find request, if the key index can be used
+   *  for one of the keys of the request.
+   *  @param qLevel highest level of the query/retrieve model
+   */
+  void DB_IdxSelectCandidates(DB_LEVEL qLevel);
+
+  /** remember an image file that has been removed from the index while the
+   *  database is locked. The file itself is deleted by
+   *  DB_DeleteDeferredImageFiles() once the lock has been released, so that
+   *  concurrent queries and retrievals need not wait for file system operations
+   *  (and for the lock on an image file that is just being sent).
+   *  @param imgFile file name (path) of the file to be deleted
+   */
+  void DB_DeferImageFileDeletion(const char *imgFile);
+
+  /** delete all image files scheduled by DB_DeferImageFileDeletion().
+   *  Must be called after the database has been unlocked.
+   */
+  void DB_DeleteDeferredImageFiles();
+
   /// database handle
   DB_Private_Handle *handle_;
 
@@ -31,6 +31,8 @@
 #include "dcmtk/dcmdata/dcdeftag.h"
 #include "dcmtk/dcmdata/dcspchrs.h"
 #include "dcmtk/dcmqrdb/dcmqrdbi.h"
+#include "dcmtk/dcmqrdb/dcmqrkey.h"
+#include "dcmtk/ofstd/ofvector.h"
 
 BEGIN_EXTERN_C
 #ifdef HAVE_IO_H
@@ -218,6 +220,8 @@ struct DCMTK_DCMQRDB_EXPORT DB_UidList
 struct DCMTK_DCMQRDB_EXPORT DB_CounterList
 {
     int idxCounter ;
+    char SOPClassUID [UI_MAX_LENGTH+1] ;
+    char SOPInstanceUID [UI_MAX_LENGTH+1] ;
     struct DB_CounterList *next ;
 };
 
@@ -253,6 +257,13 @@ struct DCMTK_DCMQRDB_EXPORT DB_Private_Handle
     int NumberRemainOperations ;
     DB_QUERY_CLASS rootLevel ;
     DB_UidList *uidList ;
+    DcmQueryRetrieveKeyIndex keyIndex ;
+    OFBool keyIndexUsable ;
+    OFBool indexModified ;
+    OFVector<int> idxCandidates ;
+    size_t idxCandidatePos ;
+    OFBool useIdxCandidates ;
+    OFVector<OFString> deferredFileDeletions ;
 
     DB_Private_Handle()
     : pidx(0)
@@ -270,6 +281,13 @@ struct DCMTK_DCMQRDB_EXPORT DB_Private_Handle
     , NumberRemainOperations(0)
     , rootLevel(STUDY_ROOT)
     , uidList(NULL)
+    , keyIndex()
+    , keyIndexUsable(OFFalse)
+    , indexModified(OFFalse)
+    , idxCandidates()
+    , idxCandidatePos(0)
+    , useIdxCandidates(OFFalse)
+    , deferredFileDeletions()
     {
     }
 };
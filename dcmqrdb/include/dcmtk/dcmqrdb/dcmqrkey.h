@@ -0,0 +1,300 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmqrdb
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: class DcmQueryRetrieveKeyIndex
+ *
+ */
+
+#ifndef DCMQRKEY_H
+#define DCMQRKEY_H
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+#include "dcmtk/ofstd/ofcond.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/dcmqrdb/qrdefine.h"
+
+struct IdxRecord;
+
+/// name of the key index file maintained next to the index file
+#define DBKEYINDEXFILE "index.key"
+
+/** attributes of an index record for which the key index provides lookup
+ */
+enum DB_KeyIndexType
+{
+    /// Study Instance UID (single value or list of UID matching)
+    DB_KEY_StudyInstanceUID = 1,
+    /// Series Instance UID (single value or list of UID matching)
+    DB_KEY_SeriesInstanceUID = 2,
+    /// SOP Instance UID (single value or list of UID matching)
+    DB_KEY_SOPInstanceUID = 3,
+    /// Patient ID (single value matching without wildcards)
+    DB_KEY_PatientID = 4,
+    /// Study Date (single date or bounded date range)
+    DB_KEY_StudyDate = 5
+};
+
+/** this class manages the key index file ("index.key") of the index database.
+ *  The key index is an on-disk hash table that maps the values of a few
+ *  selected attributes (UIDs, Patient ID, Study Date) to the numbers of the
+ *  records in the index file containing these values, so that queries,
+ *  retrievals and duplicate checks need not read the complete index file.
+ *  The index file itself is not modified in any way; the key index is only
+ *  an accelerator that can be deleted at any time. It records size and
+ *  modification time of the index file and is rebuilt whenever it is found
+ *  to be out of date, e.g. after the index file has been modified by an older
+ *  version of this module. Since different values may share the same hash
+ *  code, lookups return a superset of the matching records and each candidate
+ *  record must still be compared with the query.
+ *  All methods of this class must only be called while the index file is
+ *  locked: a shared lock is sufficient for isInSync() and lookup(), all
+ *  other methods require an exclusive lock.
+ */
+class DCMTK_DCMQRDB_EXPORT DcmQueryRetrieveKeyIndex
+{
+public:
+
+  /// default constructor
+  DcmQueryRetrieveKeyIndex();
+
+  /// destructor, closes the key index file
+  ~DcmQueryRetrieveKeyIndex();
+
+  /** open the key index file, create it if it does not yet exist.
+   *  @param filename path to the key index file
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition open(const char *filename);
+
+  /// close the key index file
+  void close();
+
+  /// return OFTrue if the key index file is open
+  OFBool isOpen() const;
+
+  /** check whether the key index is complete and matches the current state
+   *  of the given index file
+   *  @param indexFd file descriptor of the index file
+   *  @return OFTrue if the key index can be used, OFFalse otherwise
+   */
+  OFBool isInSync(int indexFd);
+
+  /** remove all entries from the key index and prepare it for the given
+   *  number of records. The key index is marked as out of date until
+   *  synchronize() is called.
+   *  @param expectedRecords number of records expected in the index file
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition clear(int expectedRecords);
+
+  /** add the keys of a record that has been written to the index file
+   *  @param idx number of the record in the index file
+   *  @param idxRec contents of the record
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition addRecord(int idx, const IdxRecord &idxRec);
+
+  /** remove the keys of a record that has been deleted from the index file
+   *  @param idx number of the record in the index file
+   *  @param idxRec former contents of the record
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition removeRecord(int idx, const IdxRecord &idxRec);
+
+  /** set the record bookkeeping information after a rebuild
+   *  @param numRecords number of records (used or free) in the index file
+   *  @param freeRecords number of free records in the index file
+   *  @param firstFreeRecord number of the first free record
+   */
+  void setRecordCounts(int numRecords, int freeRecords, int firstFreeRecord);
+
+  /// return the number of records (used or free) in the index file
+  int numberOfRecords() const;
+
+  /// return the number of free records in the index file
+  int numberOfFreeRecords() const;
+
+  /// return a record number below which no free records exist
+  int firstFreeRecord() const;
+
+  /** store size and modification time of the index file in the key index
+   *  and mark the key index as up to date. Must be called after each
+   *  modification of the index file.
+   *  @param indexFd file descriptor of the index file
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition synchronize(int indexFd);
+
+  /** mark the key index as out of date, e.g.\ after the index file has been
+   *  modified without maintaining the key index. It will be rebuilt the next
+   *  time the database is locked exclusively.
+   */
+  void invalidate();
+
+  /** look up the records that may match the given query value.
+   *  Leading and trailing spaces are ignored. For UIDs, the value may be
+   *  a backslash separated list. For the Study Date, the value may be a
+   *  date range with both start and end date.
+   *  @param type attribute to be looked up
+   *  @param value query value, need not be NULL terminated
+   *  @param length length of the query value
+   *  @param records sorted list of candidate record numbers returned here
+   *  @return OFTrue if the lookup was performed, OFFalse if the query value
+   *    cannot be answered by the key index (e.g. universal matching,
+   *    wildcards or open date ranges) and all records must be examined.
+   */
+  OFBool lookup(DB_KeyIndexType type, const char *value, size_t length, OFVector<int> &records);
+
+private:
+
+  /// hash code and type of a key
+  struct Key
+  {
+    /// hash code of the key value
+    Uint32 hash;
+    /// key type
+    Uint32 type;
+  };
+
+  /// header of the key index file, a direct binary copy of this struct
+  struct FileHeader
+  {
+    /// magic word and version
+    char magic[8];
+    /// 1 if the key index is up to date, 0 if it is being modified
+    Uint32 valid;
+    /// number of slots in the hash table, always a power of two
+    Uint32 tableSize;
+    /// number of slots that are used or have been used (deleted)
+    Uint32 usedSlots;
+    /// number of slots that are in use
+    Uint32 liveSlots;
+    /// number of records (used or free) in the index file
+    Sint32 numRecords;
+    /// number of free records in the index file
+    Sint32 freeRecords;
+    /// there are no free records below this record number
+    Sint32 firstFreeRecord;
+    /// reserved, always zero
+    Uint32 reserved;
+    /// size of the index file at the time of the last synchronization
+    Uint64 indexFileSize;
+    /// modification time of the index file at the time of the last synchronization
+    Uint64 indexFileTime;
+  };
+
+  /// hash table slot, a direct binary copy of this struct
+  struct Slot
+  {
+    /// hash code of the key value
+    Uint32 hash;
+    /// record number, or one of the special values for empty and deleted slots
+    Sint32 record;
+    /// key type
+    Uint32 type;
+  };
+
+  /// operations performed while probing the hash table
+  enum ProbeMode
+  {
+    /// insert a key
+    PM_Insert,
+    /// delete a key
+    PM_Remove,
+    /// find all records for a key
+    PM_Find
+  };
+
+  /// private undefined copy constructor
+  DcmQueryRetrieveKeyIndex(const DcmQueryRetrieveKeyIndex& copy);
+
+  /// private undefined copy assignment operator
+  DcmQueryRetrieveKeyIndex& operator=(const DcmQueryRetrieveKeyIndex& copy);
+
+  /** compute the hash code of a key value
+   *  @param type key type
+   *  @param value key value
+   *  @param length length of key value
+   *  @return key
+   */
+  static Key makeKey(Uint32 type, const char *value, size_t length);
+
+  /** determine the keys of an index record
+   *  @param idxRec index record
+   *  @param keys keys returned here
+   */
+  static void getRecordKeys(const IdxRecord &idxRec, OFVector<Key> &keys);
+
+  /** determine the keys that have to be looked up for a query value
+   *  @param type key type
+   *  @param value query value
+   *  @param length length of the query value
+   *  @param keys keys returned here
+   *  @return OFFalse if the query cannot be answered by the key index
+   */
+  static OFBool getQueryKeys(DB_KeyIndexType type, const char *value, size_t length, OFVector<Key> &keys);
+
+  /** insert, delete or find a key in the hash table
+   *  @param key key
+   *  @param record record number for insert and delete
+   *  @param mode operation
+   *  @param records record numbers returned here for find
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition probe(const Key &key, Sint32 record, ProbeMode mode, OFVector<int> *records);
+
+  /// double the size of the hash table, discarding all deleted slots
+  OFCondition grow();
+
+  /// write the hash table from memory to the key index file
+  OFCondition writeTable(const OFVector<Slot> &table);
+
+  /// mark the key index as being modified before the first change
+  OFCondition markModified();
+
+  /// read the file header
+  OFCondition readHeader();
+
+  /// write the file header
+  OFCondition writeHeader();
+
+  /** read consecutive slots of the hash table
+   *  @param pos position of the first slot
+   *  @param count number of slots
+   *  @param slots array of at least count slots
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition readSlots(Uint32 pos, Uint32 count, Slot *slots);
+
+  /** write a single slot of the hash table
+   *  @param pos position of the slot
+   *  @param slot slot contents
+   *  @return EC_Normal upon success, an error code otherwise
+   */
+  OFCondition writeSlot(Uint32 pos, const Slot &slot);
+
+  /// file descriptor of the key index file, -1 if not open
+  int fd_;
+
+  /// copy of the file header
+  FileHeader header_;
+
+  /// true if the key index has been marked as being modified
+  OFBool modified_;
+};
+
+#endif
@@ -451,11 +451,19 @@ static OFCondition DB_IdxAdd (DB_Private_Handle *phandle, int *idx, IdxRecord *i
 
     /*** Find free place for the record
     *** A place is free if filename is empty
+    *** If the key index is available, it tells us whether there
+    *** is any free place and below which record there is none.
     **/
 
     *idx = 0 ;
+    if (phandle -> keyIndexUsable) {
+        if (phandle -> keyIndex.numberOfFreeRecords() > 0)
+            *idx = phandle -> keyIndex.firstFreeRecord() ;
+        else
+            *idx = phandle -> keyIndex.numberOfRecords() ;
+    }
 
-    DB_lseek (phandle -> pidx, OFstatic_cast(long, DBHEADERSIZE + SIZEOF_STUDYDESC), SEEK_SET) ;
+    DB_lseek (phandle -> pidx, OFstatic_cast(long, DBHEADERSIZE + SIZEOF_STUDYDESC + OFstatic_cast(long, *idx) * SIZEOF_IDXRECORD), SEEK_SET) ;
     while (read (phandle -> pidx, (char *) &rec, SIZEOF_IDXRECORD) == SIZEOF_IDXRECORD) {
         if (rec. filename [0] == '\0')
             break ;
@@ -474,6 +482,13 @@ static OFCondition DB_IdxAdd (DB_Private_Handle *phandle, int *idx, IdxRecord *i
 
     DB_lseek (phandle -> pidx, OFstatic_cast(long, DBHEADERSIZE), SEEK_SET) ;
 
+    /*** Add the keys of the new record to the key index
+    **/
+
+    phandle -> indexModified = OFTrue ;
+    if (phandle -> keyIndexUsable && (cond.bad() || phandle -> keyIndex.addRecord (*idx, *idxRec).bad()))
+        phandle -> keyIndexUsable = OFFalse ;
+
     return cond ;
 }
 
@@ -489,6 +504,7 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_StudyDescChange(StudyDescRec
     if (write (handle_ -> pidx, (char *) pStudyDesc, SIZEOF_STUDYDESC) != SIZEOF_STUDYDESC)
         cond = QR_EC_IndexDatabaseError;
     DB_lseek (handle_ -> pidx, OFstatic_cast(long, DBHEADERSIZE), SEEK_SET) ;
+    handle_ -> indexModified = OFTrue ;
     return cond ;
 }
 
@@ -500,6 +516,7 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_IdxInitLoop(int *idx)
 {
     DB_lseek (handle_ -> pidx, OFstatic_cast(long, DBHEADERSIZE + SIZEOF_STUDYDESC), SEEK_SET) ;
     *idx = -1 ;
+    handle_ -> useIdxCandidates = OFFalse ;
     return EC_Normal ;
 }
 
@@ -511,6 +528,19 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_IdxInitLoop(int *idx)
 OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_IdxGetNext(int *idx, IdxRecord *idxRec)
 {
 
+    /*** If the loop has been restricted with the key index,
+    *** only visit the candidate records (in ascending order)
+    **/
+
+    if (handle_ -> useIdxCandidates) {
+        while (handle_ -> idxCandidatePos < handle_ -> idxCandidates.size()) {
+            *idx = handle_ -> idxCandidates [handle_ -> idxCandidatePos++] ;
+            if ((DB_IdxRead (*idx, idxRec) == EC_Normal) && (idxRec -> filename [0] != '\0'))
+                return EC_Normal ;
+        }
+        return QR_EC_IndexDatabaseError ;
+    }
+
     (*idx)++ ;
     DB_lseek (handle_ -> pidx, OFstatic_cast(long, DBHEADERSIZE + SIZEOF_STUDYDESC + OFstatic_cast(long, *idx) * SIZEOF_IDXRECORD), SEEK_SET) ;
     while (read (handle_ -> pidx, (char *) idxRec, SIZEOF_IDXRECORD) == SIZEOF_IDXRECORD) {
@@ -554,8 +584,14 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_GetStudyDesc (StudyDescRecor
 OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_IdxRemove(int idx)
 {
     IdxRecord   rec ;
+    IdxRecord   oldRec ;
+    OFBool      inUse = OFFalse ;
     OFCondition cond = EC_Normal;
 
+    /* the keys of the old record have to be removed from the key index */
+    if (handle_ -> keyIndexUsable)
+        inUse = (DB_IdxRead (idx, &oldRec) == EC_Normal) && (oldRec. filename [0] != '\0') ;
+
     DB_lseek (handle_ -> pidx, OFstatic_cast(long, DBHEADERSIZE + SIZEOF_STUDYDESC + OFstatic_cast(long, idx) * SIZEOF_IDXRECORD), SEEK_SET) ;
     DB_IdxInitRecord (&rec, 0) ;
 
@@ -567,6 +603,10 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_IdxRemove(int idx)
 
     DB_lseek (handle_ -> pidx, OFstatic_cast(long, DBHEADERSIZE), SEEK_SET) ;
 
+    handle_ -> indexModified = OFTrue ;
+    if (handle_ -> keyIndexUsable && (cond.bad() || (inUse && handle_ -> keyIndex.removeRecord (idx, oldRec).bad())))
+        handle_ -> keyIndexUsable = OFFalse ;
+
     return cond ;
 }
 
@@ -583,11 +623,65 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_lock(OFBool exclusive)
         dcmtk_plockerr("DB_lock");
         return QR_EC_IndexDatabaseError;
     }
+    DB_KeyIndexCheck(exclusive);
     return EC_Normal;
 }
 
+void DcmQueryRetrieveIndexDatabaseHandle::DB_KeyIndexCheck(OFBool exclusive)
+{
+    handle_->keyIndexUsable = OFFalse;
+    if (!handle_->keyIndex.isOpen())
+        return;
+    if (handle_->keyIndex.isInSync(handle_->pidx))
+        handle_->keyIndexUsable = OFTrue;
+    else if (exclusive) {
+        DCMQRDB_INFO("rebuilding key index of " << handle_->indexFilename);
+        handle_->keyIndexUsable = DB_KeyIndexRebuild().good();
+    }
+    else
+        DCMQRDB_DEBUG("key index of " << handle_->indexFilename << " is out of date, searching all records");
+}
+
+OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_KeyIndexRebuild()
+{
+    IdxRecord   idxRec ;
+    int         idx ;
+    int         freeRecords = 0 ;
+    int         firstFreeRecord = 0 ;
+
+    long size = DB_lseek (handle_ -> pidx, 0L, SEEK_END) - OFstatic_cast(long, DBHEADERSIZE + SIZEOF_STUDYDESC) ;
+    OFCondition cond = handle_ -> keyIndex.clear ((size > 0) ? OFstatic_cast(int, size / SIZEOF_IDXRECORD) : 0) ;
+    for (idx = 0 ; cond.good() && (DB_IdxRead (idx, &idxRec) == EC_Normal) ; idx++) {
+        if (idxRec. filename [0] != '\0')
+            cond = handle_ -> keyIndex.addRecord (idx, idxRec) ;
+        else if (freeRecords++ == 0)
+            firstFreeRecord = idx ;
+    }
+    if (cond.good()) {
+        handle_ -> keyIndex.setRecordCounts (idx, freeRecords, (freeRecords > 0) ? firstFreeRecord : idx) ;
+        cond = handle_ -> keyIndex.synchronize (handle_ -> pidx) ;
+    }
+    if (cond.bad())
+        DCMQRDB_WARN("cannot rebuild key index of " << handle_ -> indexFilename << ", searching all records");
+    return cond ;
+}
+
+OFBool DcmQueryRetrieveIndexDatabaseHandle::DB_KeyIndexLookup(DB_KeyIndexType type, const char *value, OFVector<int> &records)
+{
+    return handle_ -> keyIndexUsable && handle_ -> keyIndex.lookup (type, value, strlen (value), records) ;
+}
+
 OFCondition DcmQueryRetrieveIndexDatabaseHandle::DB_unlock()
 {
+    /* record the new state of the index file in the key index,
+     * or invalidate the key index if it could not be maintained.
+     */
+    if (handle_->indexModified) {
+        if (!handle_->keyIndexUsable || handle_->keyIndex.synchronize(handle_->pidx).bad())
+            handle_->keyIndex.invalidate();
+        handle_->indexModified = OFFalse;
+    }
+    handle_->keyIndexUsable = OFFalse;
     if (dcmtk_flock(handle_->pidx, LOCK_UN) < 0) {
         dcmtk_plockerr("DB_unlock");
         return QR_EC_IndexDatabaseError;
@@ -711,6 +805,81 @@ static OFCondition DB_GetTagKeyAttr (DcmTagKey tag, DB_KEY_TYPE *keyAttr)
     return (QR_EC_IndexDatabaseError);
 }
 
+/*******************
+ *    Restrict the index record loop to the candidates found in the key index
+ */
+
+void DcmQueryRetrieveIndexDatabaseHandle::DB_IdxSelectCandidates(DB_LEVEL qLevel)
+{
+    /* attributes supported by the key index, most selective first */
+    static const struct
+    {
+        DcmTagKey tag ;
+        DB_KeyIndexType type ;
+    } indexedKeys [] = {
+        { DCM_SOPInstanceUID,    DB_KEY_SOPInstanceUID    },
+        { DCM_SeriesInstanceUID, DB_KEY_SeriesInstanceUID },
+        { DCM_StudyInstanceUID,  DB_KEY_StudyInstanceUID  },
+        { DCM_PatientID,         DB_KEY_PatientID         },
+        { DCM_StudyDate,         DB_KEY_StudyDate         }
+    } ;
+
+    DB_ElementList *plist ;
+    DB_LEVEL    level ;
+    DcmTagKey   uidTag ;
+
+    handle_ -> useIdxCandidates = OFFalse ;
+    if (! handle_ -> keyIndexUsable)
+        return ;
+
+    /*** hierarchicalCompare() fails if the unique key of a level above
+    *** the query level is missing. Leave this to the linear search.
+    **/
+
+    for (level = qLevel ; level < handle_ -> queryLevel ; level = (DB_LEVEL)(level + 1)) {
+        DB_GetUIDTag (level, &uidTag) ;
+        for (plist = handle_ -> findRequestList ; plist ; plist = plist -> next)
+            if (plist -> elem. XTag == uidTag)
+                break ;
+        if (plist == NULL)
+            return ;
+    }
+
+    for (size_t i = 0 ; i < sizeof(indexedKeys) / sizeof(indexedKeys[0]) ; i++) {
+
+        /** Only keys that are compared by hierarchicalCompare() may
+        ** restrict the search: the unique keys above the query level,
+        ** all keys at the query level and the patient keys at the
+        ** study level of the Study Root Information Model
+        */
+
+        DB_GetTagLevel (indexedKeys[i]. tag, &level) ;
+        OFBool compared = OFFalse ;
+        if (level == handle_ -> queryLevel)
+            compared = OFTrue ;
+        else if ((level >= qLevel) && (level < handle_ -> queryLevel))
+            compared = (DB_GetUIDTag (level, &uidTag) == EC_Normal) && (uidTag == indexedKeys[i]. tag) ;
+        else if ((level == PATIENT_LEVEL) && (handle_ -> queryLevel == STUDY_LEVEL) && (qLevel == STUDY_LEVEL))
+            compared = OFTrue ;
+        if (! compared)
+            continue ;
+
+        for (plist = handle_ -> findRequestList ; plist ; plist = plist -> next)
+            if (plist -> elem. XTag == indexedKeys[i]. tag)
+                break ;
+        if ((plist == NULL) || (plist -> elem. PValueField == NULL))
+            continue ;
+
+        if (handle_ -> keyIndex.lookup (indexedKeys[i]. type, plist -> elem. PValueField, plist -> elem. ValueLength, handle_ -> idxCandidates)) {
+            DCMQRDB_DEBUG("using key index for " << DcmTag(indexedKeys[i]. tag).getTagName()
+                << ", " << handle_ -> idxCandidates.size() << " candidate record(s)");
+            handle_ -> idxCandidatePos = 0 ;
+            handle_ -> useIdxCandidates = OFTrue ;
+            return ;
+        }
+    }
+}
+
 /***********************
  *    Duplicate a DICOM element
  *    dst space is supposed provided by the caller
@@ -1497,6 +1666,7 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::startFindRequest(
     DB_lock(OFFalse);
 
     DB_IdxInitLoop (&(handle_->idxCounter)) ;
+    DB_IdxSelectCandidates (qLevel) ;
     MatchFound = OFFalse ;
     cond = EC_Normal ;
 
@@ -1520,6 +1690,13 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::startFindRequest(
             break ;
     }
 
+    /**** The lock is not kept while the response is sent to the peer.
+    **** nextFindResponse() locks the database again and continues the
+    **** search with the next record.
+    ***/
+
+    DB_unlock();
+
     /**** If an error occurred in Matching function
     ****    return a failed status
     ***/
@@ -1532,9 +1709,6 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::startFindRequest(
         DCMQRDB_DEBUG("DB_startFindRequest () : STATUS_FIND_Failed_UnableToProcess");
 #endif
         status->setStatus(STATUS_FIND_Failed_UnableToProcess);
-
-        DB_unlock();
-
         return (cond) ;
     }
 
@@ -1568,9 +1742,6 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::startFindRequest(
         DCMQRDB_DEBUG("DB_startFindRequest () : STATUS_Success");
 #endif
         status->setStatus(STATUS_Success);
-
-        DB_unlock();
-
         return (EC_Normal) ;
     }
 
@@ -1603,9 +1774,6 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::nextFindResponse (
 #endif
         *findResponseIdentifiers = NULL ;
         status->setStatus(STATUS_Success);
-
-        DB_unlock();
-
         return (EC_Normal) ;
     }
 
@@ -1743,9 +1911,6 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::nextFindResponse (
             << DcmObject::PrintHelper(**findResponseIdentifiers));
 #endif
     } else {
-
-        DB_unlock();
-
         return (QR_EC_IndexDatabaseError) ;
     }
 
@@ -1761,12 +1926,17 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::nextFindResponse (
     DB_FreeElementList (handle_->findResponseList) ;
     handle_->findResponseList = NULL ;
 
-    /***** ... and find the next one
+    /***** ... and find the next one.
+    ***** The search continues after the last matching record. Records
+    ***** that have been stored in the meantime behind this position are
+    ***** found as well, records that have been removed are not returned.
     ****/
 
     MatchFound = OFFalse ;
     cond = EC_Normal ;
 
+    DB_lock(OFFalse);
+
     CharsetConsideringMatcher dbmatch(*handle_);
     while (1) {
 
@@ -1794,6 +1964,8 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::nextFindResponse (
 
     }
 
+    DB_unlock();
+
     /**** If an error occurred in Matching function
     ****    return status is pending
     ***/
@@ -1806,9 +1978,6 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::nextFindResponse (
         DCMQRDB_DEBUG("DB_nextFindResponse () : STATUS_FIND_Failed_UnableToProcess");
 #endif
         status->setStatus(STATUS_FIND_Failed_UnableToProcess);
-
-        DB_unlock();
-
         return (cond) ;
     }
 
@@ -1863,9 +2032,6 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::cancelFindRequest (DcmQueryRetr
     handle_->uidList = NULL ;
 
     status->setStatus(STATUS_FIND_Cancel_MatchingTerminatedDueToCancelRequest);
-
-    DB_unlock();
-
     return (EC_Normal) ;
 }
 
@@ -2191,6 +2357,7 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::startMoveRequest(
 
     CharsetConsideringMatcher dbmatch(*handle_);
     DB_IdxInitLoop (&(handle_->idxCounter)) ;
+    DB_IdxSelectCandidates (qLevel) ;
     while (1) {
 
         /*** Exit loop if read error (or end of file)
@@ -2208,11 +2375,14 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::startMoveRequest(
             pidxlist = (DB_CounterList *) malloc (sizeof( DB_CounterList ) ) ;
             if (pidxlist == NULL) {
                 status->setStatus(STATUS_FIND_Refused_OutOfResources);
+                DB_unlock();
                 return (QR_EC_IndexDatabaseError) ;
             }
 
             pidxlist->next = NULL ;
             pidxlist->idxCounter = handle_->idxCounter ;
+            OFStandard::strlcpy(pidxlist->SOPClassUID, idxRec. SOPClassUID, sizeof(pidxlist->SOPClassUID)) ;
+            OFStandard::strlcpy(pidxlist->SOPInstanceUID, idxRec. SOPInstanceUID, sizeof(pidxlist->SOPInstanceUID)) ;
             handle_->NumberRemainOperations++ ;
             if ( handle_->moveCounterList == NULL )
                 handle_->moveCounterList = lastidxlist = pidxlist ;
@@ -2223,6 +2393,12 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::startMoveRequest(
         }
     }
 
+    /**** The matching records are remembered, the lock is only taken
+    **** again in nextMoveResponse() while a single record is read.
+    ***/
+
+    DB_unlock();
+
     DB_FreeElementList (handle_->findRequestList) ;
     handle_->findRequestList = NULL ;
 
@@ -2249,9 +2425,6 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::startMoveRequest(
         DCMQRDB_DEBUG("DB_startMoveRequest : STATUS_Success");
 #endif
         status->setStatus(STATUS_Success);
-
-        DB_unlock();
-
         return (EC_Normal) ;
     }
 
@@ -2277,24 +2450,34 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::nextMoveResponse(
 
     if ( handle_->NumberRemainOperations <= 0 ) {
         status->setStatus(STATUS_Success);
-
-        DB_unlock();
-
         return (EC_Normal) ;
     }
 
     /**** Goto the next matching image number of Index File
     ***/
 
-    if (DB_IdxRead (handle_->moveCounterList->idxCounter, &idxRec) != EC_Normal) {
+    DB_lock(OFFalse);
+    OFCondition cond = DB_IdxRead (handle_->moveCounterList->idxCounter, &idxRec) ;
+    DB_unlock();
+
+    if (cond != EC_Normal) {
 #ifdef DEBUG
         DCMQRDB_DEBUG("DB_nextMoveResponse : STATUS_MOVE_Failed_UnableToProcess");
 #endif
         status->setStatus(STATUS_MOVE_Failed_UnableToProcess);
+        return (QR_EC_IndexDatabaseError) ;
+    }
 
-        DB_unlock();
+    /**** The image may have been removed (e.g. by the quota system) and
+    **** its record reused since the move request was started. It is still
+    **** reported, without file name, so that the sub-operation fails.
+    ***/
 
-        return (QR_EC_IndexDatabaseError) ;
+    if ((idxRec. filename [0] == '\0') || (strcmp (idxRec. SOPInstanceUID, handle_->moveCounterList->SOPInstanceUID) != 0)) {
+        DCMQRDB_WARN("DB_nextMoveResponse: image has been removed from the database: " << handle_->moveCounterList->SOPInstanceUID);
+        OFStandard::strlcpy(idxRec. SOPClassUID, handle_->moveCounterList->SOPClassUID, sizeof(idxRec. SOPClassUID)) ;
+        OFStandard::strlcpy(idxRec. SOPInstanceUID, handle_->moveCounterList->SOPInstanceUID, sizeof(idxRec. SOPInstanceUID)) ;
+        idxRec. filename [0] = '\0' ;
     }
 
     OFStandard::strlcpy(SOPClassUID, (char *) idxRec. SOPClassUID, SOPClassUIDSize) ;
@@ -2326,9 +2509,6 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::cancelMoveRequest (DcmQueryRetr
     }
 
     status->setStatus(STATUS_MOVE_Cancel_SubOperationsTerminatedDueToCancelIndication);
-
-    DB_unlock();
-
     return (EC_Normal) ;
 }
 
@@ -2390,6 +2570,22 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::deleteImageFile(char* imgFile)
     return EC_Normal;
 }
 
+void DcmQueryRetrieveIndexDatabaseHandle::DB_DeferImageFileDeletion(const char *imgFile)
+{
+    handle_ -> deferredFileDeletions.push_back(imgFile);
+}
+
+void DcmQueryRetrieveIndexDatabaseHandle::DB_DeleteDeferredImageFiles()
+{
+    OFVector<OFString> files;
+    files.swap(handle_ -> deferredFileDeletions);
+    for (OFVector<OFString>::iterator it = files.begin(); it != files.end(); ++it)
+    {
+        /* deleteImageFile() does not modify the file name */
+        deleteImageFile(OFconst_cast(char *, it->c_str()));
+    }
+}
+
 
 /*************************
 **   Delete oldest study in database
@@ -2429,7 +2625,7 @@ int DcmQueryRetrieveIndexDatabaseHandle::deleteOldestStudy(StudyDescRecord *pStu
 
     if ( ! ( strncmp(idxRec. StudyInstanceUID, pStudyDesc[oldestStudy].StudyInstanceUID, n) ) ) {
         DB_IdxRemove (idx) ;
-        deleteImageFile(idxRec.filename);
+        DB_DeferImageFileDeletion(idxRec.filename);
     }
     idx++ ;
     }
@@ -2509,7 +2705,7 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::deleteOldestImages(StudyDescRec
 #ifdef DEBUG
     DCMQRDB_DEBUG("Removing file : " << idxRemoveRec. filename);
 #endif
-    deleteImageFile(idxRemoveRec.filename);
+    DB_DeferImageFileDeletion(idxRemoveRec.filename);
 
     DB_IdxRemove (StudyArray[s]. idxCounter) ;
     pStudyDesc[StudyNum].NumberofRegistratedImages -= 1 ;
@@ -2638,6 +2834,8 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::removeDuplicateImage(
     int idx = 0;
     IdxRecord idxRec ;
     int studyIdx = 0;
+    OFVector<int> candidates;
+    size_t candidate = 0;
 
     studyIdx = matchStudyUIDInStudyDesc (pStudyDesc, (char*)StudyInstanceUID,
                         (int)(handle_ -> maxStudiesAllowed)) ;
@@ -2647,7 +2845,11 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::removeDuplicateImage(
     return EC_Normal;
     }
 
-    while (DB_IdxRead(idx, &idxRec) == EC_Normal) {
+    /* use the key index to visit only the records with this SOP Instance UID */
+    const OFBool useKeyIndex = DB_KeyIndexLookup(DB_KEY_SOPInstanceUID, SOPInstanceUID, candidates);
+    if (useKeyIndex && !candidates.empty()) idx = candidates[0];
+
+    while ((!useKeyIndex || candidate < candidates.size()) && DB_IdxRead(idx, &idxRec) == EC_Normal) {
 
     if (strcmp(idxRec.SOPInstanceUID, SOPInstanceUID) == 0) {
 
@@ -2660,13 +2862,16 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::removeDuplicateImage(
          * being entered into the database.
          */
         if (strcmp(idxRec.filename, newImageFileName) != 0) {
-            deleteImageFile(idxRec.filename);
+            DB_DeferImageFileDeletion(idxRec.filename);
         }
         /* update the study info */
         pStudyDesc[studyIdx].NumberofRegistratedImages--;
         pStudyDesc[studyIdx].StudySize -= idxRec.ImageSize;
     }
-    idx++;
+    if (!useKeyIndex)
+        idx++;
+    else if (++candidate < candidates.size())
+        idx = candidates[candidate];
     }
     /* the study record should be written to file later */
     return EC_Normal;
@@ -2826,27 +3031,28 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::storeRequest (
     DCMQRDB_DEBUG("-- END Parameters to Register in DB");
 #endif
 
-    /**** Goto the end of IndexFile, and write the record
-    ***/
+    stat(imageFileName, &stat_buf) ;
+    idxRec. ImageSize = (int)(stat_buf. st_size) ;
 
-    DB_lock(OFTrue);
+    /* we only have second accuracy */
+    idxRec. RecordedDate =  (double) time(NULL);
 
     pStudyDesc = (StudyDescRecord *)malloc (SIZEOF_STUDYDESC) ;
     if (pStudyDesc == NULL) {
       DCMQRDB_ERROR("DB_storeRequest: out of memory");
       status->setStatus(STATUS_STORE_Refused_OutOfResources);
-      DB_unlock();
       return (QR_EC_IndexDatabaseError) ;
     }
 
-    memset((char *)pStudyDesc, 0, SIZEOF_STUDYDESC);
-    DB_GetStudyDesc(pStudyDesc) ;
+    /**** Goto the end of IndexFile, and write the record.
+    **** Only index operations are performed while the database is locked,
+    **** image files removed from the index are deleted afterwards.
+    ***/
 
-    stat(imageFileName, &stat_buf) ;
-    idxRec. ImageSize = (int)(stat_buf. st_size) ;
+    DB_lock(OFTrue);
 
-    /* we only have second accuracy */
-    idxRec. RecordedDate =  (double) time(NULL);
+    memset((char *)pStudyDesc, 0, SIZEOF_STUDYDESC);
+    DB_GetStudyDesc(pStudyDesc) ;
 
     /*
      * If the image is already stored remove it from the database.
@@ -2863,6 +3069,7 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::storeRequest (
         status->setStatus(STATUS_STORE_Refused_OutOfResources);
 
         DB_unlock();
+        DB_DeleteDeferredImageFiles();
 
         return (QR_EC_IndexDatabaseError) ;
     }
@@ -2873,12 +3080,14 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::storeRequest (
     {
         status->setStatus(STATUS_Success);
         DB_unlock();
+        DB_DeleteDeferredImageFiles();
         return (EC_Normal) ;
     }
     else
     {
         status->setStatus(STATUS_STORE_Refused_OutOfResources);
         DB_unlock();
+        DB_DeleteDeferredImageFiles();
     }
     return QR_EC_IndexDatabaseError;
 }
@@ -3034,6 +3243,13 @@ OFBool DcmQueryRetrieveIndexDatabaseHandle::findSOPInstance(const char *storeAre
     handle.DB_lock(OFFalse);
 
     handle.DB_IdxInitLoop (&j) ;
+
+    /* use the key index to visit only the records with this SOP Instance UID */
+    if (handle.DB_KeyIndexLookup(DB_KEY_SOPInstanceUID, sopInstanceUID.c_str(), handle.handle_->idxCandidates)) {
+        handle.handle_->idxCandidatePos = 0;
+        handle.handle_->useIdxCandidates = OFTrue;
+    }
+
     while (1) {
         if (handle.DB_IdxGetNext(&j, &idxRec) != EC_Normal)
             break ;
@@ -3173,6 +3389,7 @@ DcmQueryRetrieveIndexDatabaseHandle::DcmQueryRetrieveIndexDatabaseHandle(
                 // then write it to the file
                 char header[DBHEADERSIZE + 1];
                 OFStandard::snprintf(header, sizeof(header), DBMAGIC "%.2X", DBVERSION );
+                handle_ -> indexModified = OFTrue;
                 if ( write( handle_ -> pidx, header, DBHEADERSIZE ) != DBHEADERSIZE )
                 {
                     DCMQRDB_ERROR(handle_->indexFilename << ": " << OFStandard::getLastSystemErrorCode().message());
@@ -3182,6 +3399,13 @@ DcmQueryRetrieveIndexDatabaseHandle::DcmQueryRetrieveIndexDatabaseHandle(
                 }
             }
 
+            // open the key index and bring it up to date while we hold the exclusive lock.
+            // An existing database without key index is migrated here.
+            char keyIndexFilename[DBC_MAXSTRING+1];
+            OFStandard::snprintf(keyIndexFilename, sizeof(keyIndexFilename), "%s%c%s", storageArea, PATH_SEPARATOR, DBKEYINDEXFILE);
+            if ( handle_ -> keyIndex.open( keyIndexFilename ).good() )
+                DB_KeyIndexCheck(OFTrue);
+
             DB_unlock();
 
             handle_ -> idxCounter = -1;
@@ -3281,6 +3505,7 @@ OFCondition DcmQueryRetrieveIndexDatabaseHandle::instanceReviewed(int idx)
       if (write(handle_->pidx, OFreinterpret_cast(char *, &record), SIZEOF_IDXRECORD) != SIZEOF_IDXRECORD)
           result = QR_EC_IndexDatabaseError;
       DB_lseek(handle_->pidx, OFstatic_cast(long, DBHEADERSIZE), SEEK_SET);
+      handle_->indexModified = OFTrue;
       DB_unlock();
     }
 
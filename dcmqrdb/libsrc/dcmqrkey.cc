@@ -0,0 +1,617 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmqrdb
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: class DcmQueryRetrieveKeyIndex
+ *
+ */
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+BEGIN_EXTERN_C
+#include <sys/stat.h>
+#include <fcntl.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_IO_H
+#include <io.h>
+#endif
+END_EXTERN_C
+
+#include "dcmtk/dcmqrdb/dcmqrkey.h"
+#include "dcmtk/dcmqrdb/dcmqridx.h"
+#include "dcmtk/dcmqrdb/dcmqropt.h"
+#include "dcmtk/dcmqrdb/dcmqrcnf.h"
+#include "dcmtk/dcmdata/dcvrda.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/ofdate.h"
+
+/* ENSURE THAT KEYINDEXMAGIC IS CHANGED WHENEVER THE FILE FORMAT IS MODIFIED */
+#define KEYINDEXMAGIC "QRDBKY01"
+
+/* special record numbers for empty and deleted hash table slots */
+#define KEYINDEX_EMPTY   (-1)
+#define KEYINDEX_DELETED (-2)
+
+/* minimum number of hash table slots */
+#define KEYINDEX_MIN_TABLESIZE 4096
+
+/* number of slots read at once while probing */
+#define KEYINDEX_PROBE_CHUNK 128
+
+/* maximum number of days of a date range that is resolved by the key index */
+#define KEYINDEX_MAX_DATE_RANGE 1000
+
+/* internal key type for records with a Patient ID that cannot be
+ * compared without character set conversion. These records are
+ * returned by every Patient ID lookup.
+ */
+#define KEYINDEX_PatientIDOther 0x100
+
+/* position of a slot in the key index file */
+#define KEYINDEX_SLOT_OFFSET(pos) (OFstatic_cast(long, sizeof(FileHeader)) + OFstatic_cast(long, pos) * OFstatic_cast(long, sizeof(Slot)))
+
+
+/* find a character in a string that need not be NULL terminated,
+ * return end if the character is not found.
+ */
+static const char *DB_findChar(const char *value, const char *end, char c)
+{
+    const char *pos = OFstatic_cast(const char *, memchr(value, c, end - value));
+    return pos ? pos : end;
+}
+
+/* compare function for qsort, a and b are pointers to record numbers */
+static int DB_compareRecords(const void *a, const void *b)
+{
+    const int ra = *OFstatic_cast(const int *, a);
+    const int rb = *OFstatic_cast(const int *, b);
+    return (ra < rb) ? -1 : ((ra > rb) ? 1 : 0);
+}
+
+/* check whether a Patient ID value consists of characters that are
+ * identical in all character sets supported by DICOM, i.e. ASCII
+ * without control characters, backslash and tilde.
+ */
+static OFBool DB_isPortablePatientID(const char *value, const char *end)
+{
+    for (; value != end; ++value)
+    {
+        const unsigned char c = OFstatic_cast(unsigned char, *value);
+        if (c < 0x20 || c >= 0x7f || c == '\\' || c == '~') return OFFalse;
+    }
+    return OFTrue;
+}
+
+/* convert a date to a key value of the form YYYYMMDD */
+static OFString DB_dateKeyValue(const OFDate &date)
+{
+    char buf[16];
+    OFStandard::snprintf(buf, sizeof(buf), "%04u%02u%02u", date.getYear(), date.getMonth(), date.getDay());
+    return buf;
+}
+
+/* advance a date by one day */
+static void DB_nextDay(OFDate &date)
+{
+    if (!date.setDate(date.getYear(), date.getMonth(), date.getDay() + 1))
+    {
+        if (!date.setDate(date.getYear(), date.getMonth() + 1, 1))
+            date.setDate(date.getYear() + 1, 1, 1);
+    }
+}
+
+
+DcmQueryRetrieveKeyIndex::DcmQueryRetrieveKeyIndex()
+: fd_(-1)
+, header_()
+, modified_(OFFalse)
+{
+    memset(&header_, 0, sizeof(header_));
+}
+
+DcmQueryRetrieveKeyIndex::~DcmQueryRetrieveKeyIndex()
+{
+    close();
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::open(const char *filename)
+{
+    close();
+#ifdef O_BINARY
+    fd_ = ::open(filename, O_RDWR | O_CREAT | O_BINARY, 0666);
+#else
+    fd_ = ::open(filename, O_RDWR | O_CREAT, 0666);
+#endif
+    if (fd_ < 0)
+    {
+        DCMQRDB_WARN(filename << ": " << OFStandard::getLastSystemErrorCode().message() << ", not using key index");
+        return QR_EC_IndexDatabaseError;
+    }
+    return EC_Normal;
+}
+
+void DcmQueryRetrieveKeyIndex::close()
+{
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    modified_ = OFFalse;
+}
+
+OFBool DcmQueryRetrieveKeyIndex::isOpen() const
+{
+    return fd_ >= 0;
+}
+
+OFBool DcmQueryRetrieveKeyIndex::isInSync(int indexFd)
+{
+    modified_ = OFFalse;
+    if (fd_ < 0 || readHeader().bad()) return OFFalse;
+    if (strncmp(header_.magic, KEYINDEXMAGIC, sizeof(header_.magic)) != 0 || !header_.valid) return OFFalse;
+
+    // the hash table must be complete and its size a power of two
+    if (header_.tableSize < KEYINDEX_MIN_TABLESIZE || (header_.tableSize & (header_.tableSize - 1)) != 0) return OFFalse;
+    struct stat keyStat;
+    if (fstat(fd_, &keyStat) != 0 || keyStat.st_size < KEYINDEX_SLOT_OFFSET(header_.tableSize)) return OFFalse;
+
+    // the index file must not have been modified since the last synchronization
+    struct stat indexStat;
+    if (fstat(indexFd, &indexStat) != 0) return OFFalse;
+    return header_.indexFileSize == OFstatic_cast(Uint64, indexStat.st_size) &&
+           header_.indexFileTime == OFstatic_cast(Uint64, indexStat.st_mtime);
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::clear(int expectedRecords)
+{
+    if (fd_ < 0) return QR_EC_IndexDatabaseError;
+
+    // up to five keys per record, keep the load factor below 1/4
+    Uint32 tableSize = KEYINDEX_MIN_TABLESIZE;
+    while (tableSize < 0x40000000UL && tableSize / 20 < OFstatic_cast(Uint32, expectedRecords))
+        tableSize <<= 1;
+
+    memset(&header_, 0, sizeof(header_));
+    memcpy(header_.magic, KEYINDEXMAGIC, sizeof(header_.magic));
+    header_.tableSize = tableSize;
+    modified_ = OFTrue;
+
+    Slot empty;
+    empty.hash = 0;
+    empty.record = KEYINDEX_EMPTY;
+    empty.type = 0;
+    return writeTable(OFVector<Slot>(tableSize, empty));
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::addRecord(int idx, const IdxRecord &idxRec)
+{
+    OFCondition cond = markModified();
+    OFVector<Key> keys;
+    getRecordKeys(idxRec, keys);
+    for (OFVector<Key>::const_iterator it = keys.begin(); cond.good() && it != keys.end(); ++it)
+        cond = probe(*it, idx, PM_Insert, NULL);
+
+    if (idx >= header_.numRecords)
+    {
+        // record has been appended to the index file
+        header_.numRecords = idx + 1;
+    }
+    else
+    {
+        // record has been stored in the first free place
+        if (header_.freeRecords > 0) --header_.freeRecords;
+        header_.firstFreeRecord = idx + 1;
+    }
+    return cond;
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::removeRecord(int idx, const IdxRecord &idxRec)
+{
+    OFCondition cond = markModified();
+    OFVector<Key> keys;
+    getRecordKeys(idxRec, keys);
+    for (OFVector<Key>::const_iterator it = keys.begin(); cond.good() && it != keys.end(); ++it)
+        cond = probe(*it, idx, PM_Remove, NULL);
+
+    ++header_.freeRecords;
+    if (idx < header_.firstFreeRecord) header_.firstFreeRecord = idx;
+    return cond;
+}
+
+void DcmQueryRetrieveKeyIndex::setRecordCounts(int numRecords, int freeRecords, int firstFreeRecord)
+{
+    header_.numRecords = numRecords;
+    header_.freeRecords = freeRecords;
+    header_.firstFreeRecord = firstFreeRecord;
+}
+
+int DcmQueryRetrieveKeyIndex::numberOfRecords() const
+{
+    return header_.numRecords;
+}
+
+int DcmQueryRetrieveKeyIndex::numberOfFreeRecords() const
+{
+    return header_.freeRecords;
+}
+
+int DcmQueryRetrieveKeyIndex::firstFreeRecord() const
+{
+    return header_.firstFreeRecord;
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::synchronize(int indexFd)
+{
+    if (fd_ < 0) return QR_EC_IndexDatabaseError;
+    struct stat indexStat;
+    if (fstat(indexFd, &indexStat) != 0) return QR_EC_IndexDatabaseError;
+    header_.indexFileSize = OFstatic_cast(Uint64, indexStat.st_size);
+    header_.indexFileTime = OFstatic_cast(Uint64, indexStat.st_mtime);
+    header_.valid = 1;
+    OFCondition cond = writeHeader();
+    if (cond.good()) modified_ = OFFalse;
+    return cond;
+}
+
+void DcmQueryRetrieveKeyIndex::invalidate()
+{
+    if (fd_ < 0) return;
+    header_.valid = 0;
+    (void) writeHeader();
+    modified_ = OFFalse;
+}
+
+OFBool DcmQueryRetrieveKeyIndex::lookup(DB_KeyIndexType type, const char *value, size_t length, OFVector<int> &records)
+{
+    records.clear();
+    OFVector<Key> keys;
+    if (fd_ < 0 || !getQueryKeys(type, value, length, keys)) return OFFalse;
+    for (OFVector<Key>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+    {
+        if (probe(*it, KEYINDEX_EMPTY, PM_Find, &records).bad())
+        {
+            records.clear();
+            return OFFalse;
+        }
+    }
+
+    // records are visited in ascending order, as during a linear search
+    if (records.empty()) return OFTrue;
+    qsort(&records[0], records.size(), sizeof(int), DB_compareRecords);
+    size_t count = 1;
+    for (size_t i = 1; i < records.size(); ++i)
+        if (records[i] != records[count - 1]) records[count++] = records[i];
+    records.resize(count);
+    return OFTrue;
+}
+
+DcmQueryRetrieveKeyIndex::Key DcmQueryRetrieveKeyIndex::makeKey(Uint32 type, const char *value, size_t length)
+{
+    // 32-bit FNV-1a hash of the key type and value
+    Uint32 hash = 2166136261UL;
+    hash = (hash ^ (type & 0xff)) * 16777619UL;
+    hash = (hash ^ (type >> 8)) * 16777619UL;
+    for (size_t i = 0; i < length; ++i)
+        hash = (hash ^ OFstatic_cast(unsigned char, value[i])) * 16777619UL;
+    Key key;
+    key.hash = hash;
+    key.type = type;
+    return key;
+}
+
+void DcmQueryRetrieveKeyIndex::getRecordKeys(const IdxRecord &idxRec, OFVector<Key> &keys)
+{
+    static const struct
+    {
+        int param;
+        DB_KeyIndexType type;
+    } recordKeys[] =
+    {
+        { RECORDIDX_StudyInstanceUID,  DB_KEY_StudyInstanceUID  },
+        { RECORDIDX_SeriesInstanceUID, DB_KEY_SeriesInstanceUID },
+        { RECORDIDX_SOPInstanceUID,    DB_KEY_SOPInstanceUID    },
+        { RECORDIDX_PatientID,         DB_KEY_PatientID         },
+        { RECORDIDX_StudyDate,         DB_KEY_StudyDate         }
+    };
+
+    keys.clear();
+    for (size_t i = 0; i < sizeof(recordKeys) / sizeof(recordKeys[0]); ++i)
+    {
+        const DB_SmallDcmElmt &elem = idxRec.param[recordKeys[i].param];
+        const char *value = elem.PValueField;
+        if (value == NULL) continue;
+        const char *end = value + elem.ValueLength;
+        // remove leading and trailing spaces and NUL bytes, as done before matching
+        OFStandard::trimString(value, end);
+
+        // records with empty values never match a non-universal query
+        if (value == end) continue;
+
+        switch (recordKeys[i].type)
+        {
+            case DB_KEY_PatientID:
+                if (DB_isPortablePatientID(value, end))
+                    keys.push_back(makeKey(DB_KEY_PatientID, value, end - value));
+                else
+                    keys.push_back(makeKey(KEYINDEX_PatientIDOther, "", 0));
+                break;
+            case DB_KEY_StudyDate:
+                {
+                    // records with an invalid date never match a date query
+                    OFDate date;
+                    if (DcmDate::getOFDateFromString(value, end - value, date).good())
+                    {
+                        const OFString dateValue = DB_dateKeyValue(date);
+                        keys.push_back(makeKey(DB_KEY_StudyDate, dateValue.c_str(), dateValue.size()));
+                    }
+                }
+                break;
+            default:
+                keys.push_back(makeKey(recordKeys[i].type, value, end - value));
+                break;
+        }
+    }
+}
+
+OFBool DcmQueryRetrieveKeyIndex::getQueryKeys(DB_KeyIndexType type, const char *value, size_t length, OFVector<Key> &keys)
+{
+    keys.clear();
+    if (value == NULL) return OFFalse;
+    const char *end = value + length;
+    OFStandard::trimString(value, end);
+
+    // universal matching
+    if (value == end) return OFFalse;
+
+    switch (type)
+    {
+        case DB_KEY_PatientID:
+            // wildcard matching and values that may need character set conversion
+            // cannot be resolved by the key index
+            if (!DB_isPortablePatientID(value, end) || DB_findChar(value, end, '*') != end || DB_findChar(value, end, '?') != end)
+                return OFFalse;
+            keys.push_back(makeKey(DB_KEY_PatientID, value, end - value));
+            keys.push_back(makeKey(KEYINDEX_PatientIDOther, "", 0));
+            return OFTrue;
+
+        case DB_KEY_StudyDate:
+            {
+                const char *separator = DB_findChar(value, end, '-');
+                OFDate first;
+                if (separator == end)
+                {
+                    // single date, an invalid date does not match any record
+                    if (DcmDate::getOFDateFromString(value, end - value, first).good())
+                    {
+                        const OFString dateValue = DB_dateKeyValue(first);
+                        keys.push_back(makeKey(DB_KEY_StudyDate, dateValue.c_str(), dateValue.size()));
+                    }
+                    return OFTrue;
+                }
+
+                // open date ranges are not resolved by the key index
+                OFDate last;
+                if (separator == value || separator + 1 == end) return OFFalse;
+                if (DcmDate::getOFDateFromString(value, separator - value, first).bad() ||
+                    DcmDate::getOFDateFromString(separator + 1, end - separator - 1, last).bad())
+                {
+                    // invalid date range, does not match any record
+                    return OFTrue;
+                }
+                for (int days = 0; first <= last; ++days, DB_nextDay(first))
+                {
+                    if (days == KEYINDEX_MAX_DATE_RANGE)
+                    {
+                        keys.clear();
+                        return OFFalse;
+                    }
+                    const OFString dateValue = DB_dateKeyValue(first);
+                    keys.push_back(makeKey(DB_KEY_StudyDate, dateValue.c_str(), dateValue.size()));
+                }
+            }
+            return OFTrue;
+
+        default:
+            // list of UID matching, look up each value separately
+            while (OFTrue)
+            {
+                const char *separator = DB_findChar(value, end, '\\');
+                if (separator == value)
+                {
+                    // an empty value in a list matches records with an empty UID
+                    keys.clear();
+                    return OFFalse;
+                }
+                keys.push_back(makeKey(type, value, separator - value));
+                if (separator == end) break;
+                value = separator + 1;
+            }
+            return OFTrue;
+    }
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::probe(const Key &key, Sint32 record, ProbeMode mode, OFVector<int> *records)
+{
+    if (fd_ < 0 || header_.tableSize == 0) return QR_EC_IndexDatabaseError;
+
+    // keep the load factor of the hash table below 1/2
+    if (mode == PM_Insert && (header_.usedSlots + 1) * 2 > header_.tableSize)
+    {
+        OFCondition cond = grow();
+        if (cond.bad()) return cond;
+    }
+
+    // linear probing, starting at the slot determined by the hash code
+    Slot slots[KEYINDEX_PROBE_CHUNK];
+    const Uint32 mask = header_.tableSize - 1;
+    Uint32 pos = key.hash & mask;
+    Uint32 visited = 0;
+    while (visited < header_.tableSize)
+    {
+        Uint32 count = header_.tableSize - pos;
+        if (count > KEYINDEX_PROBE_CHUNK) count = KEYINDEX_PROBE_CHUNK;
+        OFCondition cond = readSlots(pos, count, slots);
+        if (cond.bad()) return cond;
+        for (Uint32 i = 0; i < count; ++i, ++visited)
+        {
+            Slot &slot = slots[i];
+            if (mode == PM_Insert)
+            {
+                if (slot.record == KEYINDEX_EMPTY || slot.record == KEYINDEX_DELETED)
+                {
+                    if (slot.record == KEYINDEX_EMPTY) ++header_.usedSlots;
+                    ++header_.liveSlots;
+                    slot.hash = key.hash;
+                    slot.record = record;
+                    slot.type = key.type;
+                    return writeSlot(pos + i, slot);
+                }
+            }
+            else
+            {
+                // an empty slot terminates the probe sequence
+                if (slot.record == KEYINDEX_EMPTY) return EC_Normal;
+                if (slot.record >= 0 && slot.hash == key.hash && slot.type == key.type)
+                {
+                    if (mode == PM_Find)
+                        records->push_back(slot.record);
+                    else if (slot.record == record)
+                    {
+                        --header_.liveSlots;
+                        slot.record = KEYINDEX_DELETED;
+                        return writeSlot(pos + i, slot);
+                    }
+                }
+            }
+        }
+        pos = (pos + count) & mask;
+    }
+    return (mode == PM_Insert) ? QR_EC_IndexDatabaseError : EC_Normal;
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::grow()
+{
+    // collect all slots in use
+    OFVector<Slot> live;
+    live.reserve(header_.liveSlots);
+    Slot slots[KEYINDEX_PROBE_CHUNK];
+    for (Uint32 pos = 0; pos < header_.tableSize; pos += KEYINDEX_PROBE_CHUNK)
+    {
+        const Uint32 count = (header_.tableSize - pos < KEYINDEX_PROBE_CHUNK) ? header_.tableSize - pos : KEYINDEX_PROBE_CHUNK;
+        OFCondition cond = readSlots(pos, count, slots);
+        if (cond.bad()) return cond;
+        for (Uint32 i = 0; i < count; ++i)
+            if (slots[i].record >= 0) live.push_back(slots[i]);
+    }
+
+    // double the table size unless most slots are only deleted
+    Uint32 tableSize = header_.tableSize;
+    while (tableSize < 0x40000000UL && OFstatic_cast(Uint32, live.size()) * 4 > tableSize)
+        tableSize <<= 1;
+    if (OFstatic_cast(Uint32, live.size()) * 2 >= tableSize) return QR_EC_IndexDatabaseError;
+    DCMQRDB_DEBUG("resizing key index to " << tableSize << " slots");
+
+    // re-insert the slots in memory
+    Slot empty;
+    empty.hash = 0;
+    empty.record = KEYINDEX_EMPTY;
+    empty.type = 0;
+    OFVector<Slot> table(tableSize, empty);
+    const Uint32 mask = tableSize - 1;
+    for (OFVector<Slot>::const_iterator it = live.begin(); it != live.end(); ++it)
+    {
+        Uint32 pos = it->hash & mask;
+        while (table[pos].record != KEYINDEX_EMPTY) pos = (pos + 1) & mask;
+        table[pos] = *it;
+    }
+    header_.tableSize = tableSize;
+    header_.usedSlots = OFstatic_cast(Uint32, live.size());
+    header_.liveSlots = header_.usedSlots;
+    return writeTable(table);
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::writeTable(const OFVector<Slot> &table)
+{
+    // the key index remains invalid until synchronize() is called
+    header_.valid = 0;
+    OFCondition cond = writeHeader();
+    if (cond.bad()) return cond;
+
+    const size_t chunk = 65536;
+    for (size_t pos = 0; pos < table.size(); pos += chunk)
+    {
+        const size_t count = (table.size() - pos < chunk) ? table.size() - pos : chunk;
+        const size_t bytes = count * sizeof(Slot);
+        if (lseek(fd_, KEYINDEX_SLOT_OFFSET(pos), SEEK_SET) < 0 ||
+            write(fd_, OFreinterpret_cast(const char *, &table[pos]), OFstatic_cast(unsigned int, bytes)) != OFstatic_cast(int, bytes))
+        {
+            DCMQRDB_WARN("cannot write key index: " << OFStandard::getLastSystemErrorCode().message());
+            return QR_EC_IndexDatabaseError;
+        }
+    }
+    return EC_Normal;
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::markModified()
+{
+    if (modified_) return EC_Normal;
+    header_.valid = 0;
+    OFCondition cond = writeHeader();
+    if (cond.good()) modified_ = OFTrue;
+    return cond;
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::readHeader()
+{
+    if (lseek(fd_, 0, SEEK_SET) < 0 ||
+        read(fd_, OFreinterpret_cast(char *, &header_), sizeof(header_)) != OFstatic_cast(int, sizeof(header_)))
+    {
+        memset(&header_, 0, sizeof(header_));
+        return QR_EC_IndexDatabaseError;
+    }
+    return EC_Normal;
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::writeHeader()
+{
+    if (lseek(fd_, 0, SEEK_SET) < 0 ||
+        write(fd_, OFreinterpret_cast(const char *, &header_), sizeof(header_)) != OFstatic_cast(int, sizeof(header_)))
+    {
+        DCMQRDB_WARN("cannot write key index: " << OFStandard::getLastSystemErrorCode().message());
+        return QR_EC_IndexDatabaseError;
+    }
+    return EC_Normal;
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::readSlots(Uint32 pos, Uint32 count, Slot *slots)
+{
+    const int bytes = OFstatic_cast(int, count * sizeof(Slot));
+    if (lseek(fd_, KEYINDEX_SLOT_OFFSET(pos), SEEK_SET) < 0 ||
+        read(fd_, OFreinterpret_cast(char *, slots), OFstatic_cast(unsigned int, bytes)) != bytes)
+        return QR_EC_IndexDatabaseError;
+    return EC_Normal;
+}
+
+OFCondition DcmQueryRetrieveKeyIndex::writeSlot(Uint32 pos, const Slot &slot)
+{
+    if (lseek(fd_, KEYINDEX_SLOT_OFFSET(pos), SEEK_SET) < 0 ||
+        write(fd_, OFreinterpret_cast(const char *, &slot), sizeof(slot)) != OFstatic_cast(int, sizeof(slot)))
+    {
+        DCMQRDB_WARN("cannot write key index: " << OFStandard::getLastSystemErrorCode().message());
+        return QR_EC_IndexDatabaseError;
+    }
+    return EC_Normal;
+}
@@ -0,0 +1,344 @@
+/*
+ *
+ *  Copyright (C) 2026, OFFIS e.V.
+ *  All rights reserved.  See COPYRIGHT file for details.
+ *
+ *  This software and supporting documentation were developed by
+ *
+ *    OFFIS e.V.
+ *    R&D Division Health
+ *    Escherweg 2
+ *    D-26121 Oldenburg, Germany
+ *
+ *
+ *  Module:  dcmqrdb
+ *
+ *  Author:  Marco Eichelberg
+ *
+ *  Purpose: Benchmark for the index database: measures the latency of
+ *    C-FIND requests with and without concurrent C-STORE load
+ *
+ */
+
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+#include "dcmtk/ofstd/ofconsol.h"
+#include "dcmtk/ofstd/ofstd.h"
+#include "dcmtk/ofstd/oftimer.h"
+#include "dcmtk/ofstd/ofvector.h"
+#include "dcmtk/ofstd/ofthread.h"
+#include "dcmtk/dcmdata/dctk.h"
+#include "dcmtk/dcmqrdb/dcmqrdbi.h"
+#include "dcmtk/dcmqrdb/dcmqrdbs.h"
+#include "dcmtk/dcmqrdb/dcmqrcnf.h"
+
+
+/* number of images per study stored by the writer thread */
+#define IMAGES_PER_WRITER_STUDY 500
+
+/* maximum number of images stored by the writer thread. Each index record
+ * takes about 8 kB, and the index file should not grow beyond 32 MB.
+ */
+#define MAX_WRITER_IMAGES 2000
+
+
+/* latency statistics of a benchmark phase (in seconds) */
+struct LatencyStatistics
+{
+    OFVector<double> samples;
+
+    void add(double value) { samples.push_back(value); }
+
+    static int compare(const void *a, const void *b)
+    {
+        const double x = *OFstatic_cast(const double *, a);
+        const double y = *OFstatic_cast(const double *, b);
+        return (x < y) ? -1 : ((x > y) ? 1 : 0);
+    }
+
+    void print(const char *name)
+    {
+        if (samples.empty())
+        {
+            COUT << name << ": no samples" << OFendl;
+            return;
+        }
+        qsort(&samples[0], samples.size(), sizeof(double), compare);
+        double sum = 0.0;
+        for (size_t i = 0; i < samples.size(); ++i)
+            sum += samples[i];
+        COUT << name << ": n=" << samples.size()
+             << " min=" << samples.front() * 1000.0 << "ms"
+             << " avg=" << sum / OFstatic_cast(double, samples.size()) * 1000.0 << "ms"
+             << " median=" << samples[samples.size() / 2] * 1000.0 << "ms"
+             << " p99=" << samples[samples.size() * 99 / 100] * 1000.0 << "ms"
+             << " max=" << samples.back() * 1000.0 << "ms" << OFendl;
+    }
+};
+
+
+/* create an image file in the storage area and register it in the database */
+static OFCondition storeImage(DcmQueryRetrieveIndexDatabaseHandle &handle,
+                              const char *patientID,
+                              const char *studyUID,
+                              const char *seriesUID,
+                              const char *studyDate)
+{
+    char instanceUID[65];
+    char filename[MAXPATHLEN + 1];
+    dcmGenerateUniqueIdentifier(instanceUID, SITE_INSTANCE_UID_ROOT);
+
+    OFCondition cond = handle.makeNewStoreFileName(UID_SecondaryCaptureImageStorage, instanceUID, filename, sizeof(filename));
+    if (cond.bad())
+        return cond;
+
+    DcmFileFormat fileformat;
+    DcmDataset *dset = fileformat.getDataset();
+    dset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    dset->putAndInsertString(DCM_SOPInstanceUID, instanceUID);
+    dset->putAndInsertString(DCM_PatientName, "Benchmark^Patient");
+    dset->putAndInsertString(DCM_PatientID, patientID);
+    dset->putAndInsertString(DCM_StudyInstanceUID, studyUID);
+    dset->putAndInsertString(DCM_StudyDate, studyDate);
+    dset->putAndInsertString(DCM_StudyID, "1");
+    dset->putAndInsertString(DCM_AccessionNumber, "");
+    dset->putAndInsertString(DCM_SeriesInstanceUID, seriesUID);
+    dset->putAndInsertString(DCM_SeriesNumber, "1");
+    dset->putAndInsertString(DCM_Modality, "OT");
+    dset->putAndInsertString(DCM_InstanceNumber, "1");
+    cond = fileformat.saveFile(filename, EXS_LittleEndianExplicit);
+    if (cond.bad())
+        return cond;
+
+    DcmQueryRetrieveDatabaseStatus status;
+    return handle.storeRequest(UID_SecondaryCaptureImageStorage, instanceUID, filename, &status);
+}
+
+
+/* perform a study level C-FIND that matches all studies, simulate the time
+ * needed to send each response to the peer, and return the number of responses
+ */
+static OFCondition findAllStudies(DcmQueryRetrieveIndexDatabaseHandle &handle,
+                                  unsigned int responseDelay,
+                                  size_t &responses)
+{
+    DcmDataset query;
+    query.putAndInsertString(DCM_QueryRetrieveLevel, "STUDY");
+    query.putAndInsertString(DCM_StudyInstanceUID, "");
+    query.putAndInsertString(DCM_StudyDate, "");
+    query.putAndInsertString(DCM_PatientID, "BENCH*");
+
+    DcmQueryRetrieveDatabaseStatus status;
+    DcmQueryRetrieveCharacterSetOptions characterSetOptions;
+    OFCondition cond = handle.startFindRequest(UID_FINDStudyRootQueryRetrieveInformationModel, &query, &status);
+    responses = 0;
+    while (cond.good() && (status.status() == STATUS_Pending))
+    {
+        DcmDataset *response = NULL;
+        cond = handle.nextFindResponse(&response, &status, characterSetOptions);
+        if (response)
+        {
+            ++responses;
+            delete response;
+            if (responseDelay > 0)
+                OFStandard::milliSleep(responseDelay);
+        }
+    }
+    return cond;
+}
+
+
+/* run a number of queries and record their latencies */
+static OFBool runQueries(DcmQueryRetrieveIndexDatabaseHandle &handle,
+                         size_t queries,
+                         unsigned int responseDelay,
+                         LatencyStatistics &latencies)
+{
+    for (size_t i = 0; i < queries; ++i)
+    {
+        size_t responses = 0;
+        OFTimer timer;
+        OFCondition cond = findAllStudies(handle, responseDelay, responses);
+        if (cond.bad())
+        {
+            CERR << "Error: C-FIND failed: " << cond.text() << OFendl;
+            return OFFalse;
+        }
+        latencies.add(timer.getDiff());
+    }
+    return OFTrue;
+}
+
+
+#ifdef WITH_THREADS
+
+/* thread that stores images into the database until it is stopped */
+class StoreThread : public OFThread
+{
+public:
+
+    StoreThread(DcmQueryRetrieveIndexDatabaseHandle &handle, unsigned int storeDelay)
+    : latencies()
+    , errors(0)
+    , handle_(handle)
+    , storeDelay_(storeDelay)
+    , stopMutex_()
+    , stop_(OFFalse)
+    {
+    }
+
+    void stop()
+    {
+        stopMutex_.lock();
+        stop_ = OFTrue;
+        stopMutex_.unlock();
+    }
+
+    LatencyStatistics latencies;
+    size_t errors;
+
+protected:
+
+    OFBool stopped()
+    {
+        stopMutex_.lock();
+        OFBool result = stop_;
+        stopMutex_.unlock();
+        return result;
+    }
+
+    virtual void run()
+    {
+        char studyUID[65];
+        char seriesUID[65];
+        for (size_t count = 0; (count < MAX_WRITER_IMAGES) && !stopped(); ++count)
+        {
+            if (count % IMAGES_PER_WRITER_STUDY == 0)
+            {
+                dcmGenerateUniqueIdentifier(studyUID, SITE_STUDY_UID_ROOT);
+                dcmGenerateUniqueIdentifier(seriesUID, SITE_SERIES_UID_ROOT);
+            }
+            OFTimer timer;
+            if (storeImage(handle_, "WRITER", studyUID, seriesUID, "20260101").bad())
+                ++errors;
+            else
+                latencies.add(timer.getDiff());
+            /* simulate the time needed to receive the next image */
+            if (storeDelay_ > 0)
+                OFStandard::milliSleep(storeDelay_);
+        }
+    }
+
+private:
+
+    DcmQueryRetrieveIndexDatabaseHandle &handle_;
+    unsigned int storeDelay_;
+    OFMutex stopMutex_;
+    OFBool stop_;
+};
+
+#endif
+
+
+int main(int argc, char *argv[])
+{
+    if ((argc < 2) || (argc > 6))
+    {
+        CERR << "Usage: qrdbbench storage-area [studies [images-per-study [queries [response-delay-ms]]]]" << OFendl
+             << "  storage-area       empty directory in which the database is created" << OFendl
+             << "  studies            number of studies stored initially (default: 50)" << OFendl
+             << "  images-per-study   number of images per study (default: 20)" << OFendl
+             << "  queries            number of C-FIND requests per phase (default: 50)" << OFendl
+             << "  response-delay-ms  simulated network time for each C-FIND response and" << OFendl
+             << "                     C-STORE request (default: 1)" << OFendl;
+        return 1;
+    }
+
+    const char *storageArea = argv[1];
+    const size_t studies = (argc > 2) ? OFstatic_cast(size_t, atoi(argv[2])) : 50;
+    const size_t imagesPerStudy = (argc > 3) ? OFstatic_cast(size_t, atoi(argv[3])) : 20;
+    const size_t queries = (argc > 4) ? OFstatic_cast(size_t, atoi(argv[4])) : 50;
+    const unsigned int responseDelay = (argc > 5) ? OFstatic_cast(unsigned int, atoi(argv[5])) : 1;
+
+    if (!dcmDataDict.isDictionaryLoaded())
+    {
+        CERR << "Error: no data dictionary loaded, check environment variable: " << DCM_DICT_ENVIRONMENT_VARIABLE << OFendl;
+        return 1;
+    }
+
+    OFCondition cond;
+    DcmQueryRetrieveIndexDatabaseHandle reader(storageArea, DB_UpperMaxStudies, DB_UpperMaxBytesPerStudy, cond);
+    if (cond.bad())
+    {
+        CERR << "Error: cannot open database in " << storageArea << OFendl;
+        return 1;
+    }
+
+    /* populate the database */
+    LatencyStatistics storeLatencies;
+    OFTimer populateTimer;
+    for (size_t s = 0; s < studies; ++s)
+    {
+        char studyUID[65];
+        char seriesUID[65];
+        char patientID[32];
+        char studyDate[16];
+        dcmGenerateUniqueIdentifier(studyUID, SITE_STUDY_UID_ROOT);
+        dcmGenerateUniqueIdentifier(seriesUID, SITE_SERIES_UID_ROOT);
+        OFStandard::snprintf(patientID, sizeof(patientID), "BENCH%05lu", OFstatic_cast(unsigned long, s));
+        OFStandard::snprintf(studyDate, sizeof(studyDate), "2025%02lu%02lu", OFstatic_cast(unsigned long, s / 28 % 12 + 1), OFstatic_cast(unsigned long, s % 28 + 1));
+        for (size_t i = 0; i < imagesPerStudy; ++i)
+        {
+            OFTimer timer;
+            cond = storeImage(reader, patientID, studyUID, seriesUID, studyDate);
+            if (cond.bad())
+            {
+                CERR << "Error: cannot store image: " << cond.text() << OFendl;
+                return 1;
+            }
+            storeLatencies.add(timer.getDiff());
+        }
+    }
+    COUT << "stored " << studies * imagesPerStudy << " images in " << populateTimer << OFendl;
+    storeLatencies.print("C-STORE without concurrent C-FIND");
+
+    /* phase 1: C-FIND without concurrent stores */
+    LatencyStatistics idleLatencies;
+    if (!runQueries(reader, queries, responseDelay, idleLatencies))
+        return 1;
+    idleLatencies.print("C-FIND without concurrent C-STORE");
+
+#ifdef WITH_THREADS
+    /* phase 2: C-FIND while another database handle stores images */
+    DcmQueryRetrieveIndexDatabaseHandle writer(storageArea, DB_UpperMaxStudies, DB_UpperMaxBytesPerStudy, cond);
+    if (cond.bad())
+    {
+        CERR << "Error: cannot open database in " << storageArea << OFendl;
+        return 1;
+    }
+    StoreThread storeThread(writer, responseDelay);
+    LatencyStatistics loadLatencies;
+    OFTimer loadTimer;
+    storeThread.start();
+    OFBool ok = runQueries(reader, queries, responseDelay, loadLatencies);
+    storeThread.stop();
+    storeThread.join();
+    const double loadTime = loadTimer.getDiff();
+    if (!ok)
+        return 1;
+    loadLatencies.print("C-FIND with concurrent C-STORE   ");
+    storeThread.latencies.print("C-STORE with concurrent C-FIND   ");
+    COUT << "C-STORE throughput during C-FIND: "
+         << OFstatic_cast(double, storeThread.latencies.samples.size()) / loadTime << " images/s" << OFendl;
+    if (storeThread.errors > 0)
+    {
+        CERR << "Error: " << storeThread.errors << " C-STORE operations failed" << OFendl;
+        return 1;
+    }
+#else
+    COUT << "no thread support, C-FIND with concurrent C-STORE not measured" << OFendl;
+#endif
+
+    return 0;
+}